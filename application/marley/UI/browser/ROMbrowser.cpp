@@ -125,23 +125,14 @@ namespace MarleyApp
             m_LastGamePath = m_Path.GetPath();
             m_GamesPathView->SetText(m_Path.GetFriendlyPath().c_str());
 
-            std::list<std::string> tmpList;
-            std::list<std::string> toBeRemoved;
-            std::string strList;
-            std::list<std::string>::iterator iteratorTmpList;
-
+            std::vector<std::string> games;
             std::string pathToBeSearched = m_Path.GetPath();
 
-            Marley::m_ROMs.FindAllFiles(pathToBeSearched.c_str(),&tmpList,&toBeRemoved,false);
-            Marley::m_ROMs.StripList(&tmpList,&toBeRemoved); // strip cue file entries
-            Marley::m_ROMs.FinalizeList(&tmpList);
+            Marley::m_ROMs.FindAllFiles(pathToBeSearched, games, false);
 
-            iteratorTmpList = tmpList.begin();
-            for (int i=0;i<tmpList.size();i++)
+            for (auto& game : games)
             {
-                strList = *iteratorTmpList;
-                iteratorTmpList++;
-                gameButtons.push_back(new ROMButton(strList, new SCREEN_UI::LinearLayoutParams(SCREEN_UI::FILL_PARENT, 50.0f)));
+                gameButtons.push_back(new ROMButton(game, new SCREEN_UI::LinearLayoutParams(SCREEN_UI::FILL_PARENT, 50.0f)));
             }
 
             std::vector<File::FileInfo> fileInfo;
@@ -20,211 +20,400 @@
    TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
    SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
 
-#include <list>
 #include <fstream>
+#include <algorithm>
 #include <filesystem>
 
 #include "marley/emulation/ROM.h"
+#include "core.h"
 #include "file.h"
 
 namespace MarleyApp
 {
-    void ROM::FindAllFiles(const std::string& directory, std::list<std::string>* tmpList, std::list<std::string>* toBeRemoved, bool recursiveSearch)
+    static std::string ToLower(std::string str)
     {
+        std::transform(str.begin(), str.end(), str.begin(),
+            [](unsigned char c){ return std::tolower(c); });
+        return str;
+    }
+
+    static std::string GetFilenameWithoutPath(const std::string& filenameWithPath)
+    {
+        return filenameWithPath.substr(filenameWithPath.find_last_of("/") + 1);
+    }
+
+    void ROM::FindAllFiles(const std::string& directory, std::vector<std::string>& games, bool recursiveSearch)
+    {
+        auto start = std::chrono::steady_clock::now();
+
+        if (!m_IndexLoaded)
+        {
+            LoadIndex();
+        }
 
-        int i = 0;
+        ScanStatistics statistics;
+        std::vector<std::string> visited;
+        ScanDirectories(directory, recursiveSearch, visited, statistics);
+        std::sort(visited.begin(), visited.end());
+        PurgeIndex(directory, recursiveSearch, visited);
 
-        for (const auto& fileIterator : std::filesystem::directory_iterator(directory))
+        // files referenced by .cue files are not listed themselves
+        std::unordered_set<std::string> toBeRemoved;
+        std::vector<std::string> candidates;
+        for (auto& visitedDirectory : visited)
         {
-            std::filesystem::path path{std::filesystem::path(fileIterator)};
-            std::string filenameWithPath    = path.string();
-            std::string filenameWithoutPath = EngineCore::GetFilenameWithoutPath(path);
+            CollectGames(visitedDirectory, candidates, toBeRemoved);
+        }
 
-            if (EngineCore::IsDirectory(filenameWithPath))
+        for (auto& candidate : candidates)
+        {
+            if (!toBeRemoved.count(GetFilenameWithoutPath(candidate)))
             {
-                if (recursiveSearch)
-                {
-                    if ((filenameWithoutPath != ".") && (filenameWithoutPath != ".."))
-                    {
-                        FindAllFiles(filenameWithPath, tmpList, toBeRemoved);
-                    }
-                }
+                games.push_back(candidate);
+                m_Games.insert(candidate);
             }
-            else
-            {
-                std::string ext = EngineCore::GetFileExtension(path);
-                ext = ext.substr(ext.find_last_of(".") + 1);
+        }
+        statistics.m_Games = games.size();
+
+        if (m_IndexDirty)
+        {
+            SaveIndex();
+        }
 
-                std::transform(ext.begin(), ext.end(), ext.begin(),
-                    [](unsigned char c){ return std::tolower(c); });
+        auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+        LOG_APP_INFO("ROM search in {0}: {1} directories ({2} listed, {3} from index), {4} files, {5} games in {6} ms",
+            directory, statistics.m_Directories, statistics.m_DirectoriesListed,
+            statistics.m_Directories - statistics.m_DirectoriesListed,
+            statistics.m_Files, statistics.m_Games, duration.count());
+    }
 
-                std::string filenameWithPathLowerCase = filenameWithPath;
-                std::transform(filenameWithPathLowerCase.begin(), filenameWithPathLowerCase.end(), filenameWithPathLowerCase.begin(),
-                    [](unsigned char c){ return std::tolower(c); });
+    // Walks the search directory and, for a recursive search, everything below it.
+    void ROM::ScanDirectories(const std::string& directory, bool recursiveSearch, std::vector<std::string>& visited, ScanStatistics& statistics)
+    {
+        std::unordered_set<std::string> visitedSet;
+        std::vector<std::string> directories{directory};
 
-                for (int i=0;i<m_FileTypes.size();i++)
+        while (!directories.empty())
+        {
+            std::string work = std::move(directories.back());
+            directories.pop_back();
+
+            // symbolic links can lead to the same directory twice
+            if (!visitedSet.insert(work).second)
+            {
+                continue;
+            }
+
+            std::vector<std::string> subdirectories;
+            ScanDirectory(work, subdirectories, statistics);
+            if (recursiveSearch)
+            {
+                for (auto& subdirectory : subdirectories)
                 {
-                    if ((ext == m_FileTypes[i])  && \
-                        (filenameWithPathLowerCase.find("battlenet") ==  std::string::npos) &&\
-                        (filenameWithPathLowerCase.find("ps3") ==  std::string::npos) &&\
-                        (filenameWithPathLowerCase.find("ps4") ==  std::string::npos) &&\
-                        (filenameWithPathLowerCase.find("xbox") ==  std::string::npos) &&\
-                        (filenameWithPathLowerCase.find("bios") ==  std::string::npos) &&\
-                        (filenameWithPathLowerCase.find("firmware") ==  std::string::npos))
-                    {
-                        if (ext == "mdf")
-                        {
-                            std::string bin_file;
-                            bin_file = filenameWithPath.substr(0,filenameWithPath.find_last_of(".")) + ".bin";
-                            if (!EngineCore::FileExists(bin_file)) tmpList[0].push_back(filenameWithPath);
-                        }
-                        else if (ext == "cue")
-                        {
-                            if(CheckForCueFiles(filenameWithPath, toBeRemoved))
-                            {
-                                tmpList[0].push_back(filenameWithPath);
-                            }
-                        }
-                        else
-                        {
-                            tmpList[0].push_back(filenameWithPath);
-                        }
-                    }
+                    directories.push_back(std::move(subdirectory));
                 }
             }
         }
+
+        visited.assign(visitedSet.begin(), visitedSet.end());
     }
 
-    void ROM::StripList(std::list<std::string> *tmpList,std::list<std::string> *toBeRemoved)
+    void ROM::ScanDirectory(const std::string& directory, std::vector<std::string>& subdirectories, ScanStatistics& statistics)
     {
-        std::list<std::string>::iterator iteratorTmpList;
-        std::list<std::string>::iterator iteratorToBeRemoved;
-
-        std::string strRemove, strRemoveNoPath, strList, strListNoPath;
-        int i,j;
-
-        iteratorToBeRemoved = toBeRemoved[0].begin();
-
-        for (i=0; i < toBeRemoved[0].size(); i++)
+        std::error_code error;
+        auto directoryTime = std::filesystem::last_write_time(directory, error);
+        if (error)
         {
-            strRemove = *iteratorToBeRemoved;
-            iteratorToBeRemoved++;
-            iteratorTmpList = tmpList[0].begin();
+            if (m_Index.erase(directory))
+            {
+                m_IndexDirty = true;
+            }
+            return;
+        }
+        int64 modificationTime = directoryTime.time_since_epoch().count();
 
-            strRemoveNoPath = strRemove;
-            if(strRemoveNoPath.find("/") != std::string::npos)
+        statistics.m_Directories++;
+        IndexedDirectory previous{};
+        auto indexed = m_Index.find(directory);
+        if (indexed != m_Index.end())
+        {
+            // an unchanged directory is not listed again, its files are not checked
+            if (indexed->second.m_ModificationTime == modificationTime)
             {
-                strRemoveNoPath = strRemove.substr(strRemoveNoPath.find_last_of("/") + 1);
+                subdirectories = indexed->second.m_Subdirectories;
+                statistics.m_Files += indexed->second.m_Files.size();
+                return;
             }
+            previous = std::move(indexed->second);
+        }
+
+        // cue files that did not change don't need to be parsed again
+        std::unordered_map<std::string, IndexedFile*> previousFiles;
+        for (auto& file : previous.m_Files)
+        {
+            previousFiles[file.m_Name] = &file;
+        }
 
-            for (j=0; j<tmpList[0].size(); j++)
+        statistics.m_DirectoriesListed++;
+        IndexedDirectory indexedDirectory{modificationTime};
+        auto options = std::filesystem::directory_options::skip_permission_denied;
+        for (auto iterator = std::filesystem::directory_iterator(directory, options, error);
+             !error && (iterator != std::filesystem::directory_iterator()); iterator.increment(error))
+        {
+            const auto& entry = *iterator;
+            std::error_code entryError;
+            if (entry.is_directory(entryError))
             {
-                strList = *iteratorTmpList;
+                subdirectories.push_back(entry.path().string());
+                indexedDirectory.m_Subdirectories.push_back(entry.path().string());
+                continue;
+            }
 
-                strListNoPath = strList;
-                if(strListNoPath.find("/") != std::string::npos)
-                {
-                    strListNoPath = strListNoPath.substr(strListNoPath.find_last_of("/") + 1);
-                }
+            IndexedFile file{entry.path().filename().string()};
+            file.m_ModificationTime = entry.last_write_time(entryError).time_since_epoch().count();
+            file.m_Size = entry.file_size(entryError);
 
-                if ( strRemoveNoPath == strListNoPath )
+            if (ToLower(EngineCore::GetFileExtension(entry.path())) == ".cue")
+            {
+                auto previousFile = previousFiles.find(file.m_Name);
+                if ((previousFile != previousFiles.end()) &&
+                    (previousFile->second->m_ModificationTime == file.m_ModificationTime) &&
+                    (previousFile->second->m_Size == file.m_Size))
                 {
-                    tmpList[0].erase(iteratorTmpList++);
+                    file.m_CueFiles = std::move(previousFile->second->m_CueFiles);
                 }
                 else
                 {
-                    iteratorTmpList++;
+                    ParseCueFile(entry.path().string(), file.m_CueFiles);
                 }
             }
+            indexedDirectory.m_Files.push_back(std::move(file));
+        }
+        statistics.m_Files += indexedDirectory.m_Files.size();
+
+        m_Index[directory] = std::move(indexedDirectory);
+        m_IndexDirty = true;
+    }
+
+    // Drops directories below the search directory that were not visited,
+    // they have been removed. Only a recursive search visits all of them.
+    void ROM::PurgeIndex(const std::string& directory, bool recursiveSearch, const std::vector<std::string>& visited)
+    {
+        std::string directoryWithSlash = directory;
+        EngineCore::AddSlash(directoryWithSlash);
+
+        for (auto iterator = m_Index.begin(); iterator != m_Index.end();)
+        {
+            const std::string& indexedDirectory = iterator->first;
+            bool inSearch = (indexedDirectory == directory) ||
+                (recursiveSearch && (indexedDirectory.compare(0, directoryWithSlash.size(), directoryWithSlash) == 0));
+
+            if (inSearch && !std::binary_search(visited.begin(), visited.end(), indexedDirectory))
+            {
+                iterator = m_Index.erase(iterator);
+                m_IndexDirty = true;
+            }
+            else
+            {
+                iterator++;
+            }
         }
     }
 
-    bool ROM::CheckForCueFiles(const std::string& filenameWithPath, std::list<std::string> *toBeRemoved)
+    void ROM::ParseCueFile(const std::string& filenameWithPath, std::vector<std::string>& cueFiles)
     {
-        std::string line, name;
-        bool filesExist = false;
-        bool packageCorrupted = false;
+        std::string line;
 
         std::ifstream cueFile(filenameWithPath.c_str());
         if (!cueFile.is_open())
         {
             LOG_APP_WARN("Could not open cue file: {0}",filenameWithPath);
-            return false;
+            return;
         }
 
         while ( std::getline(cueFile, line))
         {
             if (line.find("FILE") != std::string::npos)
             {
-                filenameWithPath.substr(filenameWithPath.find_last_of(".") + 1);
-
                 int start  = line.find("\"")+1;
                 int length = line.find_last_of("\"")-start;
-                name = line.substr(start,length);
+                cueFiles.push_back(line.substr(start,length));
+            }
+        }
+    }
 
-                std::string nameWithPath = name;
-                if (filenameWithPath.find("/") != std::string::npos)
-                {
-                    nameWithPath = filenameWithPath.substr(0,filenameWithPath.find_last_of("/")+1) + name;
-                }
+    bool ROM::IsGame(const std::string& filenameWithPath, const std::string& extension)
+    {
+        if (std::find(m_FileTypes.begin(), m_FileTypes.end(), extension) == m_FileTypes.end())
+        {
+            return false;
+        }
 
-                toBeRemoved[0].push_back(name);
-                if (EngineCore::FileExists(name) || (EngineCore::FileExists(nameWithPath)))
+        std::string filenameWithPathLowerCase = ToLower(filenameWithPath);
+        for (auto excluded : {"battlenet", "ps3", "ps4", "xbox", "bios", "firmware"})
+        {
+            if (filenameWithPathLowerCase.find(excluded) != std::string::npos)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void ROM::CollectGames(const std::string& directory, std::vector<std::string>& games, std::unordered_set<std::string>& toBeRemoved)
+    {
+        auto indexedDirectory = m_Index.find(directory);
+        if (indexedDirectory == m_Index.end())
+        {
+            return;
+        }
+
+        std::string directoryWithSlash = directory;
+        EngineCore::AddSlash(directoryWithSlash);
+
+        std::unordered_set<std::string> filesInDirectory;
+        for (auto& file : indexedDirectory->second.m_Files)
+        {
+            filesInDirectory.insert(file.m_Name);
+        }
+
+        for (auto& file : indexedDirectory->second.m_Files)
+        {
+            std::string filenameWithPath = directoryWithSlash + file.m_Name;
+            size_t dot = file.m_Name.find_last_of(".");
+            if (dot == std::string::npos)
+            {
+                continue;
+            }
+            std::string ext = ToLower(file.m_Name.substr(dot + 1));
+
+            if (!IsGame(filenameWithPath, ext))
+            {
+                continue;
+            }
+
+            if (ext == "mdf")
+            {
+                std::string bin_file = file.m_Name.substr(0, dot) + ".bin";
+                if (!filesInDirectory.count(bin_file)) games.push_back(filenameWithPath);
+            }
+            else if (ext == "cue")
+            {
+                // listed if at least one file was found
+                // AND all files refrenced in the cue file are
+                // accounted for
+                bool packageCorrupted = false;
+                for (auto& name : file.m_CueFiles)
                 {
-                    filesExist = true;
+                    toBeRemoved.insert(GetFilenameWithoutPath(name));
+                    if (!filesInDirectory.count(name) && !EngineCore::FileExists(name) && !EngineCore::FileExists(directoryWithSlash + name))
+                    {
+                        LOG_APP_WARN("file '{0}' listed in cue file '{1}' missing -> incomplete ROM", name, filenameWithPath);
+                        packageCorrupted = true;
+                    }
                 }
-                else
+                if (file.m_CueFiles.size() && !packageCorrupted)
                 {
-                    LOG_APP_WARN("file '{0}' listed in cue file '{1}' missing -> incomplete ROM", filenameWithPath, nameWithPath);
-                    packageCorrupted = true;
+                    games.push_back(filenameWithPath);
                 }
             }
+            else
+            {
+                games.push_back(filenameWithPath);
+            }
         }
-        // returns true if at least one file was found
-        // AND all files refrenced in the cue file are
-        // accounted for
-        return filesExist && !packageCorrupted;
     }
 
-    bool ROM::FindInVector(std::vector<std::string>* vec, const std::string& str)
+    std::string ROM::GetIndexFilename() const
     {
+        return Engine::m_Engine->GetConfigFilePath() + "romIndex.txt";
+    }
 
-        bool ok = false;
-        std::string element;
+    // D <modification time> <directory>
+    // S <subdirectory>
+    // F <modification time> <size> <file name>
+    // C <file referenced by the preceding .cue file>
+    void ROM::LoadIndex()
+    {
+        m_IndexLoaded = true;
 
-        std::vector<std::string>::iterator it;
+        std::ifstream indexFile(GetIndexFilename());
+        if (!indexFile.is_open())
+        {
+            return;
+        }
 
-        for(it=vec[0].begin(); it < vec[0].end(); it++)
+        std::string line;
+        if (!std::getline(indexFile, line) || (line != "ROMIndex 1"))
         {
-            element = *it;
+            LOG_APP_WARN("ROM index {0} has an unknown format and will be rebuilt", GetIndexFilename());
+            return;
+        }
 
-            int constexpr EQUAL = 0;
-            if (element.compare(str) == EQUAL)
+        IndexedDirectory* indexedDirectory = nullptr;
+        while (std::getline(indexFile, line))
+        {
+            if (line.size() < 2)
             {
-                ok = true;
-                break;
+                continue;
+            }
+            char* position = &line[2];
+            switch (line[0])
+            {
+                case 'D':
+                {
+                    int64 modificationTime = std::strtoll(position, &position, 10);
+                    indexedDirectory = &m_Index[std::string(position + 1)];
+                    *indexedDirectory = {modificationTime};
+                    break;
+                }
+                case 'S':
+                    if (indexedDirectory) indexedDirectory->m_Subdirectories.push_back(line.substr(2));
+                    break;
+                case 'F':
+                {
+                    if (!indexedDirectory) break;
+                    IndexedFile file;
+                    file.m_ModificationTime = std::strtoll(position, &position, 10);
+                    file.m_Size = std::strtoull(position, &position, 10);
+                    file.m_Name = std::string(position + 1);
+                    indexedDirectory->m_Files.push_back(std::move(file));
+                    break;
+                }
+                case 'C':
+                    if (indexedDirectory && indexedDirectory->m_Files.size()) indexedDirectory->m_Files.back().m_CueFiles.push_back(line.substr(2));
+                    break;
             }
-
         }
-        return ok;
     }
 
-    void ROM::FinalizeList(std::list<std::string>* tmpList)
+    void ROM::SaveIndex()
     {
-        std::list<std::string>::iterator iteratorTmpList;
-        std::string strList;
-
-        iteratorTmpList = tmpList[0].begin();
+        std::ofstream indexFile(GetIndexFilename());
+        if (!indexFile.is_open())
+        {
+            LOG_APP_WARN("Could not write ROM index {0}", GetIndexFilename());
+            return;
+        }
 
-        for (int i=0; i < tmpList[0].size(); i++)
+        indexFile << "ROMIndex 1\n";
+        for (auto& [directory, indexedDirectory] : m_Index)
         {
-            strList = *iteratorTmpList;
-            if (!FindInVector(&m_Games, strList)) //avoid duplicates
+            indexFile << "D " << indexedDirectory.m_ModificationTime << " " << directory << "\n";
+            for (auto& subdirectory : indexedDirectory.m_Subdirectories)
             {
-                m_Games.push_back(strList);
+                indexFile << "S " << subdirectory << "\n";
+            }
+            for (auto& file : indexedDirectory.m_Files)
+            {
+                indexFile << "F " << file.m_ModificationTime << " " << file.m_Size << " " << file.m_Name << "\n";
+                for (auto& cueFile : file.m_CueFiles)
+                {
+                    indexFile << "C " << cueFile << "\n";
+                }
             }
-            iteratorTmpList++;
         }
+        m_IndexDirty = false;
     }
 
     void ROM::PushFileType(const std::string& fileType)
@@ -22,31 +22,78 @@
 
 #pragma once
 
+#include <unordered_map>
+#include <unordered_set>
+
 #include "engine.h"
 
 namespace MarleyApp
 {
 
+    // The ROM index remembers the listing of every directory searched so far,
+    // keyed on the directory's modification time. Only directories that changed
+    // since the last search are listed again, and in those .cue files are only
+    // parsed again when their modification time or size changed. Directories
+    // that disappeared are dropped. The index is kept on disk between sessions.
     class ROM
     {
 
     public:
 
-        ROM() {}
+        ROM() : m_IndexLoaded(false), m_IndexDirty(false) {}
 
-        void FindAllFiles(const std::string& directory, std::list<std::string>* tmpList, std::list<std::string>* toBeRemoved, bool recursiveSearch = true);
-        void FinalizeList(std::list<std::string>* tmpList);
-        bool FindInVector(std::vector<std::string>* vec, const std::string& str);
-        bool CheckForCueFiles(const std::string& stringWithPath, std::list<std::string> *toBeRemoved);
-        void StripList(std::list<std::string>* tmpList, std::list<std::string>* toBeRemoved);
+        void FindAllFiles(const std::string& directory, std::vector<std::string>& games, bool recursiveSearch = true);
         void PushFileType(const std::string& fileType);
 
         bool GamesFound() const { return m_Games.size(); }
 
+    private:
+
+        struct IndexedFile
+        {
+            std::string m_Name;
+            int64 m_ModificationTime;
+            uint64 m_Size;
+            // files referenced by a .cue file
+            std::vector<std::string> m_CueFiles;
+        };
+
+        struct IndexedDirectory
+        {
+            int64 m_ModificationTime;
+            std::vector<std::string> m_Subdirectories;
+            std::vector<IndexedFile> m_Files;
+        };
+
+        struct ScanStatistics
+        {
+            uint m_Directories = 0;
+            uint m_DirectoriesListed = 0;
+            uint m_Files = 0;
+            uint m_Games = 0;
+        };
+
+    private:
+
+        void ScanDirectories(const std::string& directory, bool recursiveSearch, std::vector<std::string>& visited, ScanStatistics& statistics);
+        void ScanDirectory(const std::string& directory, std::vector<std::string>& subdirectories, ScanStatistics& statistics);
+        void PurgeIndex(const std::string& directory, bool recursiveSearch, const std::vector<std::string>& visited);
+        void ParseCueFile(const std::string& filenameWithPath, std::vector<std::string>& cueFiles);
+        void CollectGames(const std::string& directory, std::vector<std::string>& games, std::unordered_set<std::string>& toBeRemoved);
+        bool IsGame(const std::string& filenameWithPath, const std::string& extension);
+
+        std::string GetIndexFilename() const;
+        void LoadIndex();
+        void SaveIndex();
+
     private:
     
         std::vector<std::string> m_FileTypes;
-        std::vector<std::string> m_Games;
+        std::unordered_set<std::string> m_Games;
+
+        std::unordered_map<std::string, IndexedDirectory> m_Index;
+        bool m_IndexLoaded;
+        bool m_IndexDirty;
 
     };
 }
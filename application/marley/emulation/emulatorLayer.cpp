@@ -40,6 +40,8 @@
 
 int mednafen_main(int argc, char* argv[]);
 bool MednafenOnUpdate();
+bool MednafenGetFrameTiming(std::chrono::steady_clock::time_point& inputTime, 
+                            std::chrono::steady_clock::time_point& publishTime);
 void MednafenShutdown();
 
 void SetPollEventCall(std::function<bool(SDL_Event*)> callback);
@@ -168,6 +170,8 @@ namespace MarleyApp
 
             mednafen_main(argc, argv);
 
+            // the first "emulator frame" interval starts here, not at the clock's epoch
+            m_LastFramePublished = std::chrono::steady_clock::now();
             m_MednafenInitialized = true;
             LOG_APP_INFO("mednafen initialized");
         }
@@ -177,6 +181,17 @@ namespace MarleyApp
         {
             PROFILE_SCOPE("MednafenOnUpdate()");
             m_EmulatorIsRunning = MednafenOnUpdate();
+            // mednafen's OpenGL driver binds textures behind the engine's back
+            Engine::m_TextureSlotManager->RestoreBindings();
+
+            // frame pacing of the emulator thread and latency from input polling to display
+            std::chrono::steady_clock::time_point inputTime, publishTime;
+            if (MednafenGetFrameTiming(inputTime, publishTime))
+            {
+                PROFILE_INTERVAL("emulator frame", m_LastFramePublished, publishTime);
+                PROFILE_INTERVAL("input-to-photon", inputTime, std::chrono::steady_clock::now());
+                m_LastFramePublished = publishTime;
+            }
         }
         if (m_EmulatorIsRunning)
         {
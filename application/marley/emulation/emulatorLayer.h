@@ -24,6 +24,7 @@
 
 #include <memory>
 #include <vector>
+#include <chrono>
 
 #include "engine.h"
 #include "layer.h"
@@ -103,5 +104,7 @@ namespace MarleyApp
         float m_SaveTimer;
         bool m_Save;
 
+        std::chrono::steady_clock::time_point m_LastFramePublished;
+
     };
 }
@@ -71,10 +71,7 @@ namespace MarleyApp
             {
                 if (m_Translation.x>1000.0f)
                 {
-                    // change to main screen
-                    m_Scene = MAIN;
-                    m_Translation.x = MAINSCREEN_SPWANPOINT.x;
-                    SceneChanged();
+                    ShowMainScreen();
                 }
                 else if (m_Translation.x>870.0f)
                 {
@@ -138,6 +135,13 @@ namespace MarleyApp
         m_EventCallback(sceneChangedEvent);
     }
 
+    void GameState::ShowMainScreen()
+    {
+        m_Scene = MAIN;
+        m_Translation.x = MAINSCREEN_SPWANPOINT.x;
+        SceneChanged();
+    }
+
     void GameState::InputIdle(bool isIdle)
     {
         if (m_InputIdle != isIdle)
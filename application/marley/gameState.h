@@ -82,6 +82,7 @@ namespace MarleyApp
         bool UserInputIsInabled() const { return m_UserInputEnabled;}
         void BiosNotFound();
         void SceneChanged();
+        void ShowMainScreen();
 
     private:
 
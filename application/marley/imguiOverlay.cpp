@@ -77,6 +77,18 @@ namespace MarleyApp
 
         ImGui::Text("Application average %.3f ms/frame (%.1f FPS)", 1000.0f / ImGui::GetIO().Framerate, ImGui::GetIO().Framerate);
         ImGui::Text("CPU time per frame: %.3f ms", gCPUtimePerFrame);
+
+        const Renderer::Statistics& statistics = Engine::m_Engine->GetRenderer()->GetStatistics();
+        ImGui::Text("Renderer: %u batches, %u quads, %u instances per frame", statistics.m_Batches, statistics.m_Quads, statistics.m_Instances);
+        ImGui::Text("Flushes: submit %u, vertex capacity %u, texture slots %u, scissor %u, instances %u",
+                    statistics.m_Flushes[Renderer::FLUSH_SUBMIT],
+                    statistics.m_Flushes[Renderer::FLUSH_VERTEX_CAPACITY],
+                    statistics.m_Flushes[Renderer::FLUSH_TEXTURE_SLOTS],
+                    statistics.m_Flushes[Renderer::FLUSH_SCISSOR],
+                    statistics.m_Flushes[Renderer::FLUSH_INSTANCES]);
+        ImGui::Text("Clipping: %u quads clipped, %u culled per frame", statistics.m_ClippedQuads, statistics.m_CulledQuads);
+        const TextureSlotManager::Statistics& textureStatistics = Engine::m_TextureSlotManager->GetStatistics();
+        ImGui::Text("Textures: %u binds, %u evictions per frame", textureStatistics.m_Binds, textureStatistics.m_Evictions);
         ImGui::End();
 
 
@@ -39,6 +39,7 @@
 #include "mouseEvent.h"
 #include "resources.h"
 #include "keyEvent.h"
+#include "coreSettings.h"
 
 namespace MarleyApp
 {
@@ -50,6 +51,12 @@ namespace MarleyApp
     Bios Marley::m_BiosFiles;
     ROM Marley::m_ROMs;
 
+    // sound effects of the user interface, decoded at start-up
+    const Marley::UISound Marley::m_UISounds[] =
+    {
+        { "/sounds/waves.ogg", IDR_WAVES, "OGG" }
+    };
+
     std::string Marley::GetConfigFilePath()
     {
         std::string configFilePath{".marley"};
@@ -62,6 +69,7 @@ namespace MarleyApp
         EngineApp::Start();
         InitSettings();
         InitCursor();
+        InitSounds();
 
         m_Application = this;
 
@@ -122,6 +130,12 @@ namespace MarleyApp
 
         m_EnableImgui = false;
 
+        // the frame time benchmark (--headless --software) measures the main screen
+        if (Engine::m_Engine->IsHeadless())
+        {
+            m_GameState->ShowMainScreen();
+        }
+
         return true;
     }
 
@@ -139,7 +153,7 @@ namespace MarleyApp
         RenderCommand::Clear();
 
         // draw new scene
-        m_Renderer->BeginScene(m_CameraController->GetCamera(), m_ShaderProg, m_VertexBuffer, m_IndexBuffer);
+        m_Renderer->BeginScene(m_CameraController->GetCamera(), m_ShaderProg, m_VertexArray);
 
         GameState::Scene scene = m_GameState->GetScene();
         m_GameState->OnUpdate();
@@ -287,7 +301,8 @@ namespace MarleyApp
                 switch(event.GetKeyCode())
                 {
                     case ENGINE_KEY_M:
-                        m_EnableImgui = !m_EnableImgui;
+                        // imgui is not available with the software renderer
+                        m_EnableImgui = !m_EnableImgui && (RendererAPI::GetAPI() == RendererAPI::OPENGL);
                         m_CameraController->SetEnable(true);
                         break;
                     case ENGINE_KEY_ESCAPE:
@@ -367,6 +382,20 @@ namespace MarleyApp
         Engine::m_Engine->ApplyAppSettings();
     }
 
+    void Marley::InitSounds()
+    {
+        if (!CoreSettings::m_EnableSystemSounds)
+        {
+            return;
+        }
+
+        // decode them now, so the first playback doesn't stall a frame
+        for (auto& sound : m_UISounds)
+        {
+            Engine::m_Engine->GetAudio()->Preload(sound.m_Path, sound.m_ResourceID, sound.m_ResourceClass);
+        }
+    }
+
     void Marley::InitCursor()
     {
         size_t fileSize;
@@ -397,7 +426,7 @@ namespace MarleyApp
     {
         m_Renderer->Submit(m_VertexArray);
         m_Renderer->EndScene();
-        m_Renderer->BeginScene(m_CameraController->GetCamera(), m_ShaderProg, m_VertexBuffer, m_IndexBuffer);
+        m_Renderer->BeginScene(m_CameraController->GetCamera(), m_ShaderProg, m_VertexArray);
     }
 
     std::chrono::time_point<std::chrono::steady_clock> Marley::GetSplashStartTime() const
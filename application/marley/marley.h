@@ -72,6 +72,7 @@ namespace MarleyApp
         void OnScroll();
         void InitCursor();
         void InitSettings();
+        void InitSounds();
         
         void ShowCursor();
         void HideCursor();
@@ -110,5 +111,13 @@ namespace MarleyApp
 
         AppSettings m_AppSettings{&Engine::m_SettingsManager};
 
+        struct UISound
+        {
+            const char* m_Path;
+            int m_ResourceID;
+            const char* m_ResourceClass;
+        };
+        static const UISound m_UISounds[];
+
     };
 }
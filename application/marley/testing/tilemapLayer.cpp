@@ -49,6 +49,18 @@ namespace MarleyApp
             "|     |"
             "|     |"
         );
+        m_Tilemap.Create(&m_MapIndex, &m_TileMap, {650.0f, 150.0f});
+
+        m_TileSheetIndex.Create(&m_TileMap);
+        m_TileSheetIndex.CreateEmptyMap(TILE_COLUMNS, TILE_ROWS);
+        m_TileSheet.Create(&m_TileSheetIndex, &m_TileMap, {-500.0f, -100.0f});
+        for (uint row = 0; row < TILE_ROWS; row++)
+        {
+            for (uint column = 0; column < TILE_COLUMNS; column++)
+            {
+                m_TileSheet.SetTile(column, row, column + row * TILE_COLUMNS);
+            }
+        }
 
         m_AtlasTexture = m_SpritesheetMarley->GetTexture();
         m_Atlas = new Sprite
@@ -80,53 +92,9 @@ namespace MarleyApp
 
                 m_Renderer->Draw(m_Atlas, position);
             }
-            {
-                m_MapIndex.BeginScene();
-                Sprite* sprite;
-
-                for (uint row = 0; row < m_MapIndex.GetRows(); row++)
-                {
-                    for (uint column = 0; column < m_MapIndex.GetColumns(); column++)
-                    {
-                        sprite = m_MapIndex.GetSprite();
-                        if (sprite)
-                        {
-                            float translationX = static_cast<float>(column * sprite->GetWidth()) + 650.0f;
-                            float translationY = 150.0f - static_cast<float>(row * sprite->GetHeight());
-
-                            glm::vec3 translation{translationX, translationY, 0.0f};
-                            glm::mat4 translationMatrix = Translate(translation);
-                            // transformed position
-                            glm::mat4 position = translationMatrix * sprite->GetScaleMatrix();
-
-                            m_Renderer->Draw(sprite, position);
-                        }
-                    }
-                }
-            }
-
-            {
-                m_TileMap.BeginScene();
-                uint spriteIndex = 0;
-
-                for (uint row = 0; row < TILE_ROWS; row++)
-                {
-                    for (uint column = 0; column < TILE_COLUMNS; column++)
-                    {
-                        Sprite* sprite = m_TileMap.GetSprite(spriteIndex);
-                        float translationX = static_cast<float>(column * sprite->GetWidth()) - 500.0f;
-                        float translationY = -100.0f - static_cast<float>(row * sprite->GetHeight());
-
-                        glm::vec3 translation{translationX, translationY, 0.0f};
-                        glm::mat4 translationMatrix = Translate(translation);
-                        // transformed position
-                        glm::mat4 position = translationMatrix * sprite->GetScaleMatrix();
-
-                        m_Renderer->Draw(sprite, position);
-                        spriteIndex++;
-                    }
-                }
-            }
+            m_TileMap.BeginScene();
+            m_Tilemap.Draw(m_Renderer);
+            m_TileSheet.Draw(m_Renderer);
         }
     }
 
@@ -31,6 +31,7 @@
 #include "core.h"
 #include "renderer.h"
 #include "mapIndex.h"
+#include "tilemap.h"
 
 namespace MarleyApp
 {
@@ -68,6 +69,11 @@ namespace MarleyApp
         Sprite* m_Atlas;
 
         MapIndex m_MapIndex;
+        Tilemap m_Tilemap;
+
+        // all tiles of the tile sheet
+        MapIndex m_TileSheetIndex;
+        Tilemap m_TileSheet;
 
     };
 }
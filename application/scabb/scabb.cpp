@@ -83,7 +83,7 @@ namespace ScabbApp
         RenderCommand::Clear();
 
         // draw new scene
-        m_Renderer->BeginScene(m_CameraController->GetCamera(), m_ShaderProg, m_VertexBuffer, m_IndexBuffer);
+        m_Renderer->BeginScene(m_CameraController->GetCamera(), m_ShaderProg, m_VertexArray);
 
         // OnUpdate layers
         m_Background->OnUpdate();
@@ -177,7 +177,7 @@ namespace ScabbApp
     {
         m_Renderer->Submit(m_VertexArray);
         m_Renderer->EndScene();
-        m_Renderer->BeginScene(m_CameraController->GetCamera(), m_ShaderProg, m_VertexBuffer, m_IndexBuffer);
+        m_Renderer->BeginScene(m_CameraController->GetCamera(), m_ShaderProg, m_VertexArray);
     }
     
     void Scabb::CreateConfigFolder()
@@ -124,6 +124,7 @@ project "mednafen_marley"
         "mednafen/NativeVFS.cpp",
         "mednafen/Stream.cpp",
         "mednafen/MemoryStream.cpp",
+        "mednafen/MappedStream.cpp",
         "mednafen/ExtMemStream.cpp",
         "mednafen/FileStream.cpp",
         "mednafen/MTStreamReader.cpp",
@@ -135,6 +136,8 @@ project "mednafen_marley"
         "mednafen/psx/gpu_polygon.cpp",
         "mednafen/psx/gpu_line.cpp",
         "mednafen/psx/gpu_sprite.cpp",
+        "mednafen/psx/gpu_timing.cpp",
+        "mednafen/psx/gpu_mt.cpp",
         "mednafen/psx/debug.cpp",
         "mednafen/psx/dis.cpp",
         "mednafen/snes_faust/msu1.cpp",
@@ -493,6 +496,7 @@ project "mednafen_marley"
         "mednafen/video/Deinterlacer.cpp",
         "mednafen/video/Deinterlacer_Simple.cpp",
         "mednafen/video/Deinterlacer_Blend.cpp",
+        "mednafen/video/blend.cpp",
         "mednafen/resampler/resample.c",
         "mednafen/cputest/cputest.c",
         "mednafen/cputest/x86_cpu.cpp",
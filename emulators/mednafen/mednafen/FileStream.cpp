@@ -279,8 +279,10 @@ uint8 *FileStream::map(void) noexcept
    mapping_size = length;
 
    #ifdef HAVE_MADVISE
-   // Should probably make this controllable via flag or somesuch.
-   madvise(mapping, mapping_size, MADV_SEQUENTIAL | MADV_WILLNEED);
+   if(map_random)
+    madvise(mapping, mapping_size, MADV_RANDOM);
+   else
+    madvise(mapping, mapping_size, MADV_SEQUENTIAL | MADV_WILLNEED);
    #endif
   }
 #endif
@@ -79,6 +79,10 @@ class FileStream : public Stream
 
  virtual int get_line(std::string &str) override;
 
+ // When true, map() advises the OS to expect random access rather than sequential access, and doesn't
+ // request read-ahead of the whole file.  Must be called before map().
+ INLINE void set_map_random_access(bool random) noexcept { map_random = random; }
+
  INLINE int get_char(void)
  {
   int ret;
@@ -108,6 +112,7 @@ class FileStream : public Stream
 
  void* mapping;
  uint64 mapping_size;
+ bool map_random = false;
 
  bool locked;
  int prev_was_write;	// -1 for no state, 0 for last op was read, 1 for last op was write(used for MODE_READ_WRITE)
@@ -0,0 +1,200 @@
+/******************************************************************************/
+/* Mednafen - Multi-system Emulator                                           */
+/******************************************************************************/
+/* MappedStream.cpp:
+**  Copyright (C) 2012-2018 Mednafen Team
+**
+** This program is free software; you can redistribute it and/or
+** modify it under the terms of the GNU General Public License
+** as published by the Free Software Foundation; either version 2
+** of the License, or (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software Foundation, Inc.,
+** 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+
+#include <mednafen/mednafen.h>
+#include "MappedStream.h"
+#include "MemoryStream.h"
+#include "FileStream.h"
+
+#if defined(HAVE_MMAP) && defined(HAVE_MADVISE)
+ #include <sys/mman.h>
+ #include <unistd.h>
+#endif
+
+namespace Mednafen
+{
+
+Stream* MappedStream::open(Stream* stream)
+{
+ try
+ {
+  FileStream* fs = dynamic_cast<FileStream*>(stream);
+
+  if(fs && !(fs->attributes() & ATTRIBUTE_WRITEABLE))
+  {
+   uint8* p;
+
+   // Disc images are read all over the place; don't let the kernel read the whole file ahead of us.
+   fs->set_map_random_access(true);
+
+   if((p = fs->map()))
+    return new MappedStream(fs, p, fs->map_size());
+  }
+ }
+ catch(...)
+ {
+  delete stream;
+  throw;
+ }
+
+ return new MemoryStream(stream);
+}
+
+MappedStream::MappedStream(Stream* stream, uint8* data, uint64 data_size) : backing(stream), data_buffer(data), data_buffer_size(data_size), position(0), hint_begin(0), hint_end(0)
+{
+
+}
+
+MappedStream::~MappedStream()
+{
+ close();
+}
+
+uint64 MappedStream::attributes(void)
+{
+ return (ATTRIBUTE_READABLE | ATTRIBUTE_SEEKABLE | ATTRIBUTE_INMEM_FAST);
+}
+
+uint8 *MappedStream::map(void) noexcept
+{
+ return data_buffer;
+}
+
+uint64 MappedStream::map_size(void) noexcept
+{
+ return data_buffer_size;
+}
+
+void MappedStream::unmap(void) noexcept
+{
+
+}
+
+uint64 MappedStream::read(void *data, uint64 count, bool error_on_eos)
+{
+ if(count > data_buffer_size || position > (data_buffer_size - count))
+ {
+  if(error_on_eos)
+   throw MDFN_Error(0, _("Unexpected EOF"));
+
+  count = (data_buffer_size > position) ? (data_buffer_size - position) : 0;
+ }
+
+ memcpy(data, &data_buffer[position], count);
+ position += count;
+
+ return count;
+}
+
+void MappedStream::write(const void *data, uint64 count)
+{
+ throw MDFN_Error(ErrnoHolder(EBADF));
+}
+
+void MappedStream::truncate(uint64 length)
+{
+ throw MDFN_Error(ErrnoHolder(EBADF));
+}
+
+void MappedStream::seek(int64 offset, int whence)
+{
+ int64 new_position;
+
+ switch(whence)
+ {
+  default:
+	throw MDFN_Error(ErrnoHolder(EINVAL));
+	break;
+
+  case SEEK_SET:
+	new_position = offset;
+	break;
+
+  case SEEK_CUR:
+	new_position = position + offset;
+	break;
+
+  case SEEK_END:
+	new_position = data_buffer_size + offset;
+	break;
+ }
+
+ if(new_position < 0)
+  throw MDFN_Error(ErrnoHolder(EINVAL));
+
+ position = new_position;
+}
+
+uint64 MappedStream::tell(void)
+{
+ return position;
+}
+
+uint64 MappedStream::size(void)
+{
+ return data_buffer_size;
+}
+
+void MappedStream::flush(void)
+{
+
+}
+
+void MappedStream::close(void)
+{
+ if(backing)
+ {
+  backing->unmap();
+  delete backing;
+  backing = nullptr;
+ }
+
+ data_buffer = nullptr;
+ data_buffer_size = 0;
+ position = 0;
+}
+
+void MappedStream::hint(uint64 offset, uint64 count) noexcept
+{
+ if(offset >= data_buffer_size)
+  return;
+
+ count = std::min<uint64>(count, data_buffer_size - offset);
+
+ // Re-issue only once reading has gone past the middle of the last hinted range, or outside of it.
+ if(offset >= hint_begin && (offset + count / 2) <= hint_end)
+  return;
+
+#if defined(HAVE_MMAP) && defined(HAVE_MADVISE)
+ {
+  static const uint64 page_size = std::max<long>(4096, sysconf(_SC_PAGESIZE));
+  const uint64 begin = offset & ~(page_size - 1);
+  const uint64 end = offset + count;
+
+  madvise(data_buffer + begin, end - begin, MADV_WILLNEED);
+ }
+#endif
+
+ hint_begin = offset;
+ hint_end = offset + count;
+}
+
+}
@@ -0,0 +1,84 @@
+/******************************************************************************/
+/* Mednafen - Multi-system Emulator                                           */
+/******************************************************************************/
+/* MappedStream.h:
+**  Copyright (C) 2012-2018 Mednafen Team
+**
+** This program is free software; you can redistribute it and/or
+** modify it under the terms of the GNU General Public License
+** as published by the Free Software Foundation; either version 2
+** of the License, or (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software Foundation, Inc.,
+** 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+
+/*
+ Notes:
+	Read-only, fast-seekable view of a stream whose contents can be memory-mapped(e.g. a FileStream opened with
+	MODE_READ).  Unlike MemoryStream(Stream*), nothing is copied up front; pages are faulted in from the OS page
+	cache as they're read, so resident memory is proportional to what is actually accessed.
+
+	hint() may be used to request asynchronous read-ahead of a range that is expected to be read soon.
+*/
+
+#ifndef __MDFN_MAPPEDSTREAM_H
+#define __MDFN_MAPPEDSTREAM_H
+
+#include "Stream.h"
+
+namespace Mednafen
+{
+
+class MappedStream : public Stream
+{
+ public:
+
+ // Returns a MappedStream for "stream" if it can be memory-mapped, and otherwise falls back to
+ // "new MemoryStream(stream)".  Takes ownership of "stream" in either case, even if it throws.
+ static Stream* open(Stream* stream);
+
+ virtual ~MappedStream() override;
+
+ virtual uint64 attributes(void) override;
+
+ virtual uint8 *map(void) noexcept override;
+ virtual uint64 map_size(void) noexcept override;
+ virtual void unmap(void) noexcept override;
+
+ virtual uint64 read(void *data, uint64 count, bool error_on_eos = true) override;
+ virtual void write(const void *data, uint64 count) override;
+ virtual void truncate(uint64 length) override;
+ virtual void seek(int64 offset, int whence) override;
+ virtual uint64 tell(void) override;
+ virtual uint64 size(void) override;
+ virtual void flush(void) override;
+ virtual void close(void) override;
+
+ // Asks the OS to start reading [offset, offset + count) into the page cache.  Ranges already covered
+ // by the previous hint are ignored, so this is cheap enough to call for every sector read.
+ void hint(uint64 offset, uint64 count) noexcept;
+
+ private:
+ MappedStream(Stream* stream, uint8* data, uint64 data_size);
+
+ MappedStream & operator=(const MappedStream &);    // Assignment operator
+ MappedStream(const MappedStream &);		// Copy constructor
+
+ Stream* backing;
+ uint8* data_buffer;
+ uint64 data_buffer_size;
+ uint64 position;
+
+ uint64 hint_begin;
+ uint64 hint_end;
+};
+
+}
+#endif
@@ -39,6 +39,11 @@ CDAccess::~CDAccess()
 
 }
 
+void CDAccess::HintReadSector(int32 lba) noexcept
+{
+
+}
+
 CDAccess* CDAccess_Open(VirtualFS* vfs, const std::string& path, bool image_memcache)
 {
  CDAccess *ret = NULL;
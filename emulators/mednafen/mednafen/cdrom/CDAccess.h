@@ -44,6 +44,15 @@ class CDAccess
 
  virtual void Read_TOC(CDUtility::TOC *toc) = 0;
 
+ // Called ahead of reads starting at "lba", so that the underlying storage can be asked to read ahead.
+ // Must be thread-safe with respect to Read_Raw_Sector(), as it's called from the same thread.
+ virtual void HintReadSector(int32 lba) noexcept;
+
+ protected:
+
+ // Number of sectors requested ahead of the hinted LBA when the image is memory-mapped.
+ enum : int32 { HintReadAheadSectors = 256 };
+
  private:
  CDAccess(const CDAccess&);	// No copy constructor.
  CDAccess& operator=(const CDAccess&); // No assignment operator.
@@ -23,6 +23,7 @@
 #include <mednafen/general.h>
 #include <mednafen/string/string.h>
 #include <mednafen/MemoryStream.h>
+#include <mednafen/MappedStream.h>
 
 #include "CDAccess_CCD.h"
 #include <trio/trio.h>
@@ -247,7 +248,7 @@ void CDAccess_CCD::Load(VirtualFS* vfs, const std::string& path, bool image_memc
 
   if(image_memcache)
   {
-   img_stream.reset(new MemoryStream(vfs->open(image_path, VirtualFS::MODE_READ)));
+   img_stream.reset(MappedStream::open(vfs->open(image_path, VirtualFS::MODE_READ)));
   }
   else
   {
@@ -385,6 +386,15 @@ void CDAccess_CCD::Read_Raw_Sector(uint8 *buf, int32 lba)
  subpw_interleave(&sub_data[lba * 96], buf + 2352);
 }
 
+void CDAccess_CCD::HintReadSector(int32 lba) noexcept
+{
+ if(lba < 0 || (size_t)lba >= img_numsectors)
+  return;
+
+ if(MappedStream* ms = dynamic_cast<MappedStream*>(img_stream.get()))
+  ms->hint((uint64)lba * 2352, HintReadAheadSectors * 2352);
+}
+
 bool CDAccess_CCD::Fast_Read_Raw_PW_TSRE(uint8* pwbuf, int32 lba) const noexcept
 {
  if(lba < 0)
@@ -37,6 +37,8 @@ class CDAccess_CCD : public CDAccess
 
  virtual void Read_TOC(CDUtility::TOC *toc);
 
+ virtual void HintReadSector(int32 lba) noexcept;
+
  private:
 
  void Load(VirtualFS* vfs, const std::string& path, bool image_memcache);
@@ -37,6 +37,7 @@
 #include <mednafen/general.h>
 #include <mednafen/string/string.h>
 #include <mednafen/MemoryStream.h>
+#include <mednafen/MappedStream.h>
 
 #include "CDAccess.h"
 #include "CDAccess_Image.h"
@@ -212,7 +213,7 @@ void CDAccess_Image::ParseTOCFileLineInfo(VirtualFS* vfs, CDRFILE_TRACK_INFO *tr
   efn = vfs->eval_fip(base_dir, filename);
 
   if(image_memcache)
-   track->fp = new MemoryStream(vfs->open(efn, VirtualFS::MODE_READ));
+   track->fp = MappedStream::open(vfs->open(efn, VirtualFS::MODE_READ));
   else
   {
    track->fp = vfs->open(efn, VirtualFS::MODE_READ);
@@ -645,7 +646,7 @@ void CDAccess_Image::ImageOpen(VirtualFS* vfs, const std::string& path, bool ima
      TmpTrack.FirstFileInstance = 1;
 
      if(image_memcache)
-      TmpTrack.fp = new MemoryStream(TmpTrack.fp);
+      TmpTrack.fp = MappedStream::open(TmpTrack.fp);
      else
       TmpTrack.fp->require_fast_seekable();
 
@@ -1140,6 +1141,27 @@ void CDAccess_Image::Read_Raw_Sector(uint8 *buf, int32 lba)
   } // end if audible part of audio track read.
 }
 
+void CDAccess_Image::HintReadSector(int32 lba) noexcept
+{
+ for(int32 track = FirstTrack; track <= LastTrack; track++)
+ {
+  CDRFILE_TRACK_INFO* ct = &Tracks[track];
+
+  if(lba >= ct->LBA && lba < (ct->LBA + ct->sectors))
+  {
+   MappedStream* ms = dynamic_cast<MappedStream*>(ct->fp);
+
+   if(ms && !ct->AReader)
+   {
+    const uint64 sector_size = DI_Size_Table[ct->DIFormat] + (ct->SubchannelMode ? 96 : 0);
+
+    ms->hint(ct->FileOffset + (uint64)(lba - ct->LBA) * sector_size, HintReadAheadSectors * sector_size);
+   }
+   break;
+  }
+ }
+}
+
 bool CDAccess_Image::Fast_Read_Raw_PW_TSRE(uint8* pwbuf, int32 lba) const noexcept
 {
  int32 track;
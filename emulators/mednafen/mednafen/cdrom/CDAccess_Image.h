@@ -75,6 +75,8 @@ class CDAccess_Image : public CDAccess
 
  virtual void Read_TOC(CDUtility::TOC *toc);
 
+ virtual void HintReadSector(int32 lba) noexcept;
+
  private:
 
  int32 NumTracks;
@@ -196,6 +196,7 @@ int CDInterface_MT::ReadThreadStart()
     }
 
     last_read_lba = new_lba;
+    disc_cdaccess->HintReadSector(new_lba);
    }
   }
 
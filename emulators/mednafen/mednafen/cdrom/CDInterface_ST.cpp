@@ -50,7 +50,10 @@ CDInterface_ST::~CDInterface_ST()
 
 void CDInterface_ST::HintReadSector(int32 lba)
 {
- // TODO: disc_cdaccess seek hint? (probably not, would require asynchronousitycamel)
+ if(UnrecoverableError)
+  return;
+
+ disc_cdaccess->HintReadSector(lba);
 }
 
 bool CDInterface_ST::ReadRawSector(uint8 *buf, int32 lba)
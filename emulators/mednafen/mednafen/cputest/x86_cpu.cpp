@@ -37,6 +37,15 @@
            "=c" (ecx), "=d" (edx)\
          : "0" (index));
 
+#define cpuid_count(index,count,eax,ebx,ecx,edx)\
+    __asm__ volatile\
+        ("mov %%" REG_b ", %%" REG_S "\n\t"\
+         "cpuid\n\t"\
+         "xchg %%" REG_b ", %%" REG_S\
+         : "=a" (eax), "=S" (ebx),\
+           "=c" (ecx), "=d" (edx)\
+         : "0" (index), "2" (count));
+
 #define xgetbv(index,eax,edx)                                   \
     __asm__ (".byte 0x0f, 0x01, 0xd0" : "=a"(eax), "=d"(edx) : "c" (index))
 
@@ -52,6 +61,16 @@ void cpuid(int index, int& eax, int& ebx, int& ecx, int& edx)
     ecx = cpuInfo[2];
     edx = cpuInfo[3];
 }
+void cpuid_count(int index, int count, int& eax, int& ebx, int& ecx, int& edx)
+{
+    int cpuInfo[4];
+
+    __cpuidex(cpuInfo, index, count);
+    eax = cpuInfo[0];
+    ebx = cpuInfo[1];
+    ecx = cpuInfo[2];
+    edx = cpuInfo[3];
+}
 //unsigned __int64 _xgetbv(unsigned int);
 void xgetbv(int index, int& eax, int& edx)
 {
@@ -138,6 +157,13 @@ int ff_get_cpu_flags_x86(void)
                   ;
     }
 
+    // Mednafen addition(avx2):
+    if ((rval & CPUTEST_FLAG_AVX) && max_std_level >= 7) {
+        cpuid_count(7, 0, eax, ebx, ecx, edx);
+        if (ebx & 0x00000020)
+            rval |= CPUTEST_FLAG_AVX2;
+    }
+
     cpuid(0x80000000, max_ext_level, ebx, ecx, edx);
 
     if(max_ext_level >= 0x80000001){
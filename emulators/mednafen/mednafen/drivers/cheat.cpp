@@ -754,11 +754,11 @@ static void DoSearch(void* data)
  static int v1=0,v2=0;
  static int method=0;
 
- const char *m[6]={"O==V1 && C==V2","O==V1 && |O-C|==V2","|O-C|==V2","O!=C","Value decreased","Value increased"};
+ const char *m[8]={"O==V1 && C==V2","O==V1 && |O-C|==V2","|O-C|==V2","O!=C","Value decreased","Value increased","Value decreased(signed)","Value increased(signed)"};
  CHEAT_puts("");
  CHEAT_printf("Search Filter:");
 
- method = ShowShortList(m,6,method);
+ method = ShowShortList(m,8,method);
 
  if(method<=1)
  {
@@ -24,6 +24,7 @@
 
 #include <trio/trio.h>
 #include <map>
+#include <atomic>
 #include "debugger.h"
 #include "gfxdebugger.h"
 #include "memdebugger.h"
@@ -53,12 +54,18 @@ static std::string ReadBreakpoints, IOReadBreakpoints, AuxReadBreakpoints;
 static std::string WriteBreakpoints, IOWriteBreakpoints, AuxWriteBreakpoints;
 static std::string OpBreakpoints;
 
-static MDFN_Surface* DebuggerSurface[2] = { NULL, NULL };
-static MDFN_Rect DebuggerRect[2];
+static MDFN_Surface* DebuggerSurface[3] = { NULL, NULL, NULL };
+static MDFN_Rect DebuggerRect[3];
 
-static int volatile DMTV_BackBuffer;
-static MDFN_Surface* volatile DMTV_Surface;
-static MDFN_Rect* volatile DMTV_Rect;
+//
+// Lock-free triple buffer, like the one for the emulated frame: the game thread draws into the back buffer and
+// publishes it in Debugger_GTR_PassBlit() by swapping it with the ready buffer(DMTV_Latest), the main thread
+// swaps the front buffer with the ready buffer when a fresh one is there.
+//
+enum { DMTV_INDEX_MASK = 0x3, DMTV_FRESH = 0x4 };
+static int DMTV_BackBuffer;		// Game thread
+static int DMTV_FrontBuffer;		// Main thread
+static std::atomic_int DMTV_Latest;
 
 //
 // Used for translating mouse coordinates and whatnot.  Doesn't really matter if it's not atomically updated, there
@@ -707,19 +714,20 @@ static DebuggerPrompt *myprompt = NULL;
 //
 void Debugger_GTR_PassBlit(void)
 {
- DMTV_Rect = &DebuggerRect[DMTV_BackBuffer];
- DMTV_Surface = DebuggerSurface[DMTV_BackBuffer];
-
- DMTV_BackBuffer ^= 1;
+ DMTV_BackBuffer = DMTV_Latest.exchange(DMTV_BackBuffer | DMTV_FRESH, std::memory_order_acq_rel) & DMTV_INDEX_MASK;
 }
 
 void Debugger_MT_DrawToScreen(const MDFN_PixelFormat& pf, signed screen_w, signed screen_h)
 {
- if(!DMTV_Rect || !DMTV_Surface || !DMTV_Rect->w || !DMTV_Rect->h)
+ if(DMTV_Latest.load(std::memory_order_acquire) & DMTV_FRESH)
+  DMTV_FrontBuffer = DMTV_Latest.exchange(DMTV_FrontBuffer, std::memory_order_acq_rel) & DMTV_INDEX_MASK;
+
+ MDFN_Surface* debsurf = DebuggerSurface[DMTV_FrontBuffer];
+ MDFN_Rect* debrect = &DebuggerRect[DMTV_FrontBuffer];
+
+ if(!debrect->w || !debrect->h || !debsurf)
   return;
 
- MDFN_Surface* debsurf = DMTV_Surface;
- MDFN_Rect* debrect = DMTV_Rect;
  MDFN_Rect zederect;
  int xm = screen_w / debrect->w;
  int ym = screen_h / debrect->h;
@@ -1172,8 +1180,8 @@ static void MDFN_COLD SetActive(bool active, unsigned which_ms)
   {
    if(!DebuggerSurface[0])
    {
-    DebuggerSurface[0] = new MDFN_Surface(NULL, 640, 480, 640, MDFN_PixelFormat(MDFN_COLORSPACE_RGB, 0, 8, 16, 24));
-    DebuggerSurface[1] = new MDFN_Surface(NULL, 640, 480, 640, MDFN_PixelFormat(MDFN_COLORSPACE_RGB, 0, 8, 16, 24));
+    for(unsigned i = 0; i < 3; i++)
+     DebuggerSurface[i] = new MDFN_Surface(NULL, 640, 480, 640, MDFN_PixelFormat(MDFN_COLORSPACE_RGB, 0, 8, 16, 24));
    }
 
    if(NeedInit)
@@ -1869,9 +1877,12 @@ void Debugger_Init(void)
 
 	//
 
+	for(unsigned i = 0; i < 3; i++)
+	 DebuggerRect[i].w = DebuggerRect[i].h = 0;
+
 	DMTV_BackBuffer = 0;
-	DMTV_Surface = NULL;
-	DMTV_Rect = NULL;
+	DMTV_Latest.store(1, std::memory_order_release);
+	DMTV_FrontBuffer = 2;
 
 	//
 	//
@@ -1894,7 +1905,7 @@ void Debugger_Kill(void)
 	 memdbg = NULL;
 	}
 
-	for(unsigned i = 0; i < 2; i++)
+	for(unsigned i = 0; i < 3; i++)
 	{
 	 if(DebuggerSurface[i] != NULL)
 	 {
@@ -40,6 +40,7 @@
 #endif
 
 #include <atomic>
+#include <chrono>
 
 #include "input.h"
 #include "Joystick.h"
@@ -67,6 +68,8 @@ static bool SuppressErrorPopups;    // Set from env variable "MEDNAFEN_NOPOPUPS"
 
 static int StateSLSTest = false;
 static int StateRCTest = false;    // Rewind consistency
+static int StateRewindBench = false;    // Rewind per-frame cost, printed when the game is closed
+static int StateSaveBench = false;    // Save state stall and write times, printed when the game is closed
 #if 0
 static int StatePCTest = false;    // Power(toggle) consistency
 #endif
@@ -240,20 +243,37 @@ void MakeDebugSettings(std::vector <MDFNSetting> &settings)
 
 static MThreading::Thread* GameThread;
 
+typedef std::chrono::steady_clock::time_point TimePoint;
+
 static struct
 {
  std::unique_ptr<MDFN_Surface> surface = nullptr;
  MDFN_Rect rect;
  std::unique_ptr<int32[]> lw = nullptr;
  int field = -1;
-} SoftFB[2];
+ unsigned rotated = 0;
+ bool ssnapshot = false;
+ TimePoint input_time;      // when the input for this frame was polled
+ TimePoint publish_time;
+} SoftFB[3];
 
-static bool SoftFB_BackBuffer = false;
+//
+// Lock-free triple buffer: the game thread emulates into the back buffer and publishes it by swapping it
+// with the ready buffer(VTLatest), the video thread swaps the front buffer with the ready buffer when a
+// fresh frame is there.  Neither side ever waits for the other.
+//
+enum { VT_INDEX_MASK = 0x3, VT_FRESH = 0x4 };
+static int SoftFB_BackBuffer = 0;        // Game thread
+static int SoftFB_LastPublished = 1;     // Game thread; only read, never written, until it becomes the back buffer again
+static int SoftFB_FrontBuffer = 2;       // Video thread
+static std::atomic_int VTLatest;
+static std::atomic_int VTReblit;         // Re-blit the front buffer(VT_REBLIT), with a screen snapshot(VT_REBLIT_SSNAPSHOT)
+enum { VT_REBLIT = 0x1, VT_REBLIT_SSNAPSHOT = 0x2 };
+static TimePoint LastInputTime;          // Game thread
+
+static bool VTNewFrame = false;          // Video thread, frame timing for the engine
+static TimePoint VTInputTime, VTPublishTime;
 
-static std::atomic_int VTReady;
-static unsigned VTRotated = 0;
-static bool VTSSnapshot = false;
-static MThreading::Sem* VTWakeupSem;
 static MThreading::Mutex *VTMutex = NULL, *EVMutex = NULL;
 static MThreading::Mutex *StdoutMutex = NULL;
 
@@ -891,6 +911,7 @@ static bool DoArgs(int argc, char *argv[], char **filename)
     int mtetest = 0;
     int swiftresamptest = 0;
     int owlresamptest = 0;
+    int alphafillbench = 0;
     #ifdef WANT_SS_EMU
     int ss_midsync;
     #endif
@@ -933,6 +954,12 @@ static bool DoArgs(int argc, char *argv[], char **filename)
      // Save state rewind consistency test.
      { "staterctest", NULL, &StateRCTest, 0, 0 },
 
+     // Save state rewind per-frame cost benchmark.
+     { "staterewindbench", NULL, &StateRewindBench, 0, 0 },
+
+     // Save state writer stall/write time benchmark.
+     { "statesavebench", NULL, &StateSaveBench, 0, 0 },
+
 #if 0
      // Save state power consistency test.
      { "statepctest", NULL, &StatePCTest, 0, 0 },
@@ -944,6 +971,9 @@ static bool DoArgs(int argc, char *argv[], char **filename)
      // OwlResampler test.
      { "owlresamptest", NULL, &owlresamptest, 0, 0 },
 
+     // OpenGL blitter alpha-fill benchmark.
+     { "alphafillbench", NULL, &alphafillbench, 0, 0 },
+
      #ifdef WANT_SS_EMU
      // Quick kludge to avoid breaking frontends and scripts due to the setting being removed.
      { "ss.midsync", NULL, 0, &ss_midsync, SUBSTYPE_INTEGER },
@@ -999,6 +1029,9 @@ static bool DoArgs(int argc, char *argv[], char **filename)
      if(owlresamptest)
       MDFN_RunOwlResamplerTest();
 
+     if(alphafillbench)
+      OpenGL_AlphaFillBenchmark();
+
      if(stream64testpath)
      {
       Stream64Test(stream64testpath);
@@ -1160,7 +1193,7 @@ static int LoadGame(const char *force_module, const char *path)
         }
 
     ffnosound = MDFN_GetSettingB("ffnosound");
-    RewindState = MDFN_GetSettingB("srwautoenable");
+    RewindState = MDFN_GetSettingB("srwautoenable") || StateRewindBench;
     if(RewindState)
     {
      MDFN_Notify(MDFN_NOTICE_STATUS, _("State rewinding functionality enabled."));
@@ -1189,9 +1222,15 @@ int CloseGame(void)
         if(soundrecfn)
          MDFNI_StopWAVRecord();
 
+    if(StateRewindBench)
+     MDFNI_PrintStateRewindStatistics();
+
     if(MDFN_GetSettingB("autosave") && !autosave_load_error)
      MDFNI_SaveState(NULL, "mca", NULL, NULL, NULL);
 
+    if(StateSaveBench)
+     MDFNI_PrintStateSaveStatistics();
+
     MDFNI_NetplayDisconnect();
 
     Debugger_Kill();
@@ -1248,7 +1287,7 @@ void DebuggerFudge(void)
  const uint32 WaitMS = 10;
  uint32 wt = Time::MonoMS() + WaitMS;
 
- MDFND_Update(SoftFB_BackBuffer ^ 1, nullptr, 0);
+ MDFND_Update(SoftFB_LastPublished, nullptr, 0);
 
  wt -= Time::MonoMS();
 
@@ -1295,6 +1334,7 @@ static int GameLoop(void *arg)
      //
      //
      SoftFB[SoftFB_BackBuffer].lw[0] = ~0;
+     SoftFB[SoftFB_BackBuffer].input_time = LastInputTime;
 
      //
      //
@@ -1387,25 +1427,23 @@ static int GameLoop(void *arg)
 
 
      {
-      bool do_flip = false;
+      bool published = false;
 
       do
       {
-        if(fskip && ((InFrameAdvance && !NeedFrameAdvance) || GameLoopPaused))
+        if((fskip || published) && ((InFrameAdvance && !NeedFrameAdvance) || GameLoopPaused))
        {
-        // If this frame was skipped, and the game loop is paused(IE cheat interface is active) or we're in frame advance, just blit the last
-        // drawn, non-skipped frame so the OSD elements actually get drawn.
-        //
-        // Needless to say, do not allow do_flip to be set to true here.
+        // If this frame was skipped(or was already published), and the game loop is paused(IE cheat interface is active) or we're in frame advance,
+        // just blit the last published frame again so the OSD elements actually get drawn.
         //
         // Possible problems with this kludgery:
         //    Will fail spectacularly if there is no previous successful frame.  BOOOOOOM.  (But there always should be, especially since we initialize some
           //   of the video buffer and rect structures during startup)
         //
-            MDFND_Update(SoftFB_BackBuffer ^ 1, sound, ssize);
+            MDFND_Update(SoftFB_LastPublished, sound, ssize);
        }
        else
-            do_flip = MDFND_Update(fskip ? -1 : SoftFB_BackBuffer, sound, ssize);
+            published = MDFND_Update(fskip ? -1 : SoftFB_BackBuffer, sound, ssize);
 
        FPS_UpdateCalc();
 
@@ -1418,7 +1456,6 @@ static int GameLoop(void *arg)
           sound[x] = 0;
        }
       } while(((InFrameAdvance && !NeedFrameAdvance) || GameLoopPaused) && GameThreadRun);
-      SoftFB_BackBuffer ^= do_flip;
      }
     }
 
@@ -1518,7 +1555,6 @@ void GT_ToggleFS(void)
  NeedVideoSync++;
  MThreading::Mutex_Unlock(VTMutex);
 
- MThreading::Sem_Post(VTWakeupSem);
  while(NeedVideoSync && GameThreadRun)
  {
   Time::SleepMS(2);
@@ -1532,7 +1568,6 @@ bool GT_ReinitVideo(void)
  NeedVideoSync++;
  MThreading::Mutex_Unlock(VTMutex);
 
- MThreading::Sem_Post(VTWakeupSem);
  while(NeedVideoSync && GameThreadRun)
  {
   Time::SleepMS(2);
@@ -2231,14 +2266,18 @@ int mednafen_main(int argc, char *argv[])
     VTMutex = MThreading::Mutex_Create();
     EVMutex = MThreading::Mutex_Create();
 
-    VTWakeupSem = MThreading::Sem_Create();
     //
     Video_Init();
     //
     JoystickManager::Init();
     JoystickManager::SetAnalogThreshold(MDFN_GetSettingF("analogthreshold") / 100);
 
-    VTReady.store(-1, std::memory_order_release);
+    SoftFB_BackBuffer = 0;
+    SoftFB_LastPublished = 1;
+    SoftFB_FrontBuffer = 2;
+    VTLatest.store(SoftFB_LastPublished, std::memory_order_release);
+    VTReblit.store(0, std::memory_order_release);
+    VTNewFrame = false;
 
     NeedExitNow = 0;
 
@@ -2265,7 +2304,7 @@ int mednafen_main(int argc, char *argv[])
         uint32 pitch32 = CurGame->fb_width; 
         MDFN_PixelFormat nf(MDFN_COLORSPACE_RGB, 0, 8, 16, 24);
 
-        for(int i = 0; i < 2; i++)
+        for(int i = 0; i < 3; i++)
         {
             std::string fbName = "SoftFB[" + std::to_string(i) + "]";
             SoftFB[i].surface.reset(new MDFN_Surface(NULL, CurGame->fb_width, CurGame->fb_height, pitch32, nf, fbName));
@@ -2303,6 +2342,36 @@ int mednafen_main(int argc, char *argv[])
 
 void MednafenShutdown();
 
+// Timing of the frame sampled by the last MednafenOnUpdate() call, for frame pacing and
+// input-to-photon statistics.  Returns false if no new frame was sampled.
+bool MednafenGetFrameTiming(TimePoint& inputTime, TimePoint& publishTime)
+{
+    inputTime = VTInputTime;
+    publishTime = VTPublishTime;
+    return VTNewFrame;
+}
+
+// Samples the newest frame published by the game thread, never waits for it.
+static bool AcquireFrame(bool& ssnapshot)
+{
+    // VTReblit first, so that a frame published before the re-blit request is seen below
+    const int reblit = VTReblit.exchange(0, std::memory_order_acquire);
+    bool blit = reblit & VT_REBLIT;
+    ssnapshot = reblit & VT_REBLIT_SSNAPSHOT;
+
+    VTNewFrame = false;
+    if(VTLatest.load(std::memory_order_acquire) & VT_FRESH)
+    {
+        SoftFB_FrontBuffer = VTLatest.exchange(SoftFB_FrontBuffer, std::memory_order_acq_rel) & VT_INDEX_MASK;
+        ssnapshot |= SoftFB[SoftFB_FrontBuffer].ssnapshot;
+        VTInputTime = SoftFB[SoftFB_FrontBuffer].input_time;
+        VTPublishTime = SoftFB[SoftFB_FrontBuffer].publish_time;
+        VTNewFrame = true;
+        blit = true;
+    }
+    return blit;
+}
+
 bool MednafenOnUpdate()
 {
     if(!NeedExitNow)
@@ -2316,7 +2385,8 @@ bool MednafenOnUpdate()
                 PumpWrap();
                 NeedVideoSync = 0;
                 NeededWMInputBehavior_Dirty = false;
-                VTReady.store(-1, std::memory_order_release);
+                bool ssnapshot;
+                AcquireFrame(ssnapshot);    // Drop it
             }
             else
             {
@@ -2337,14 +2407,12 @@ bool MednafenOnUpdate()
                 }
 
                 {
-                    const int vtr = VTReady.load(std::memory_order_acquire);
+                    bool ssnapshot;
 
-                    if(vtr >= 0)
+                    if(AcquireFrame(ssnapshot))
                     {
-                        BlitScreen(SoftFB[vtr].surface.get(), &SoftFB[vtr].rect, SoftFB[vtr].lw.get(), VTRotated, SoftFB[vtr].field, VTSSnapshot);
-
-                        // Set to -1 after we're done blitting everything(including on-screen display stuff), and NOT just the emulated system's video surface.
-                        VTReady.store(-1, std::memory_order_release);
+                        const int vtr = SoftFB_FrontBuffer;
+                        BlitScreen(SoftFB[vtr].surface.get(), &SoftFB[vtr].rect, SoftFB[vtr].lw.get(), SoftFB[vtr].rotated, SoftFB[vtr].field, ssnapshot);
                     }
                 }
             }
@@ -2368,8 +2436,6 @@ bool MednafenOnUpdate()
         }
 
         MThreading::Mutex_Unlock(VTMutex);   /* Unlock mutex */
-
-        MThreading::Sem_TimedWait(VTWakeupSem, 1);
     }
     else
     {
@@ -2384,14 +2450,12 @@ void MednafenShutdown()
 
     CloseGame();
 
-    for(int i = 0; i < 2; i++)
+    for(int i = 0; i < 3; i++)
     {
         SoftFB[i].surface.reset(nullptr);
         SoftFB[i].lw.reset(nullptr);
     }
 
-    MThreading::Sem_Destroy(VTWakeupSem);
-
     MThreading::Mutex_Destroy(VTMutex);
     MThreading::Mutex_Destroy(EVMutex);
 
@@ -2416,8 +2480,6 @@ void MednafenShutdown()
 */
 }
 
-
-static uint32 last_btime = 0;
 static void UpdateSoundSync(int16 *Buffer, uint32 Count)
 {
  if(Count)
@@ -2513,6 +2575,7 @@ void Mednafen::MDFND_MidSync(EmulateSpecStruct *espec, const unsigned flags)
  {
   GameThread_HandleEvents(); // Should be safe, but be careful about future changes.
   Input_Update(true, false);
+  LastInputTime = std::chrono::steady_clock::now();
  }
  //else
  //{
@@ -2520,39 +2583,34 @@ void Mednafen::MDFND_MidSync(EmulateSpecStruct *espec, const unsigned flags)
  //}
 }
 
+//
+// Publishes the back buffer, or requests a re-blit of the last published frame.  Never waits for the video thread,
+// if it didn't pick up the previous frame yet, that frame is dropped.
+//
 static bool PassBlit(const int WhichVideoBuffer)
 {
  if(WhichVideoBuffer < 0)
   return false;
 
- while(VTReady.load(std::memory_order_acquire) >= 0)
+ Debugger_GTR_PassBlit();    // Call before publishing
+
+ if(WhichVideoBuffer == SoftFB_BackBuffer)
  {
-  /* If it's been > 100ms since the last blit, assume that the blit
-     thread is being time-slice starved, and let it run.  This is especially necessary
-     for fast-forwarding to respond well(since keyboard updates are
-     handled in the main thread) on slower systems or when using a higher fast-forwarding speed ratio.
-  */
-  if(!GameThreadRun || ((last_btime + 100) >= Time::MonoMS() && !pending_ssnapshot))
-   return false;
-  else
-   Time::SleepMS(1);
+  SoftFB[WhichVideoBuffer].ssnapshot = pending_ssnapshot;
+  SoftFB[WhichVideoBuffer].rotated = CurGame->rotated;
+  SoftFB[WhichVideoBuffer].publish_time = std::chrono::steady_clock::now();
+  //
+  SoftFB_LastPublished = WhichVideoBuffer;
+  SoftFB_BackBuffer = VTLatest.exchange(WhichVideoBuffer | VT_FRESH, std::memory_order_acq_rel) & VT_INDEX_MASK;
  }
-
- Debugger_GTR_PassBlit();    // Call before the VTReady = WhichVideoBuffer
-
- VTSSnapshot = pending_ssnapshot;
- VTRotated = CurGame->rotated;
- //
- VTReady.store(WhichVideoBuffer, std::memory_order_release);
+ else
+  VTReblit.fetch_or(VT_REBLIT | (pending_ssnapshot ? VT_REBLIT_SSNAPSHOT : 0), std::memory_order_release);
  //
  //
  //
  pending_ssnapshot = false;
- last_btime = Time::MonoMS();
  FPS_IncBlitted();
 
- MThreading::Sem_Post(VTWakeupSem);
-
  return true;
 }
 
@@ -2568,17 +2626,6 @@ static bool MDFND_Update(int WhichVideoBuffer, int16 *Buffer, int Count)
  {
   Debugger_GT_Draw();
 
-#if 0
-  // Wait if we're re-blitting an already blitted frame, such as done while in frame advance or debugger step mode.
-  while(VTReady.load(std::memory_order_acquire) == WhichVideoBuffer)
-  {
-   puts("Reblit Wait");
-   Time::SleepMS(1);
-   if(!GameThreadRun)
-    return false;
-  }
-#endif
-
   //
   // Save any pending screen snapshots, save states, and movies before any potential calls to PassBlit().
   //
@@ -2608,6 +2655,7 @@ static bool MDFND_Update(int WhichVideoBuffer, int16 *Buffer, int Count)
 
  GameThread_HandleEvents();
  Input_Update();
+ LastInputTime = std::chrono::steady_clock::now();
 
  if(RemoteOn)
   CheckForSTDIOMessages();    // Note: This function may change settings, and disable sound.
@@ -30,6 +30,17 @@
 #include "shader.h"
 #include <iostream>
 
+#include <mednafen/cputest/cputest.h>
+
+#if defined(HAVE_SSE2_INTRINSICS)
+#include <emmintrin.h>
+#endif
+
+#if defined(ARCH_X86) && (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+#define ALPHAFILL_HAVE_AVX2 1
+#endif
+
 #define ASSERT(x) if (!(x)) std::cout << " (ASSERT on line number " << __LINE__ << " in file " << __FILE__ << ")" << std::endl;
 
 extern unsigned int mednafenWidth;
@@ -38,6 +49,142 @@ extern int mednafenTextureIDs[4];
 extern bool mednafenTextures;
 int pixelBuffer[4096 *4096];
 
+// the SSE2 and AVX2 loops cover whole vectors, the scalar loop the rest of each line
+static void AlphaFill_Scalar(uint32 *dest, const uint32 *src, uint32 w)
+{
+    for(uint32 x = 0; x < w; x++)
+    {
+        dest[x] = src[x] | 0xff000000;
+    }
+}
+
+#if defined(HAVE_SSE2_INTRINSICS)
+static void AlphaFill_SSE2(uint32 *dest, const uint32 *src, uint32 w)
+{
+    const __m128i alpha = _mm_set1_epi32((int)0xff000000);
+    uint32 x = 0;
+
+    for(; (x + 4) <= w; x += 4)
+    {
+        __m128i pixels = _mm_loadu_si128((const __m128i*)(src + x));
+        _mm_storeu_si128((__m128i*)(dest + x), _mm_or_si128(pixels, alpha));
+    }
+
+    AlphaFill_Scalar(dest + x, src + x, w - x);
+}
+#endif
+
+#if defined(ALPHAFILL_HAVE_AVX2)
+#pragma GCC push_options
+#pragma GCC target("avx2")
+static void AlphaFill_AVX2(uint32 *dest, const uint32 *src, uint32 w)
+{
+    const __m256i alpha = _mm256_set1_epi32((int)0xff000000);
+    uint32 x = 0;
+
+    for(; (x + 8) <= w; x += 8)
+    {
+        __m256i pixels = _mm256_loadu_si256((const __m256i*)(src + x));
+        _mm256_storeu_si256((__m256i*)(dest + x), _mm256_or_si256(pixels, alpha));
+    }
+
+    AlphaFill_Scalar(dest + x, src + x, w - x);
+}
+#pragma GCC pop_options
+#endif
+
+typedef void (*AlphaFill_Func)(uint32 *dest, const uint32 *src, uint32 w);
+
+// picked once at runtime, AVX2 only when the CPU has it
+static AlphaFill_Func GetAlphaFillLine(const char **name = NULL)
+{
+    static AlphaFill_Func func = NULL;
+    static const char *func_name = NULL;
+
+    if(!func)
+    {
+        func = AlphaFill_Scalar;
+        func_name = "scalar";
+
+        #if defined(HAVE_SSE2_INTRINSICS)
+        func = AlphaFill_SSE2;
+        func_name = "SSE2";
+        #endif
+
+        #if defined(ALPHAFILL_HAVE_AVX2)
+        if(cputest_get_flags() & CPUTEST_FLAG_AVX2)
+        {
+            func = AlphaFill_AVX2;
+            func_name = "AVX2";
+        }
+        #endif
+    }
+
+    if(name)
+    {
+        *name = func_name;
+    }
+    return func;
+}
+
+void OpenGL_AlphaFill(uint32 *dest, const uint32 *src, uint32 src_pitchinpix, uint32 w, uint32 h)
+{
+    const AlphaFill_Func fill_line = GetAlphaFillLine();
+
+    for(uint32 y = 0; y < h; y++)
+    {
+        fill_line(dest, src, w);
+        dest += w;
+        src += src_pitchinpix;
+    }
+}
+
+// measures the alpha-fill for common frame sizes against the former
+// scalar loop over the full pitch (-alphafillbench)
+void OpenGL_AlphaFillBenchmark(void)
+{
+    static const struct { uint32 w, h; } sizes[] = { { 256, 224 }, { 320, 240 }, { 640, 480 } };
+    const uint32 pitchinpix = 1024;
+    const uint32 iterations = 2000;
+
+    std::unique_ptr<uint32[]> src(new uint32[pitchinpix * 480]);
+    std::unique_ptr<uint32[]> dest(new uint32[pitchinpix * 480]);
+
+    for(uint32 i = 0; i < pitchinpix * 480; i++)
+    {
+        src[i] = i * 0x01010101;
+    }
+
+    const char *impl_name;
+    GetAlphaFillLine(&impl_name);
+
+    MDFN_printf(_("Alpha-fill benchmark (%s):\n"), impl_name);
+    MDFN_AutoIndent aind(1);
+
+    for(auto const& size : sizes)
+    {
+        int64 start = Time::MonoUS();
+        for(uint32 i = 0; i < iterations; i++)
+        {
+            OpenGL_AlphaFill(dest.get(), src.get(), pitchinpix, size.w, size.h);
+        }
+        const int64 fill_us = Time::MonoUS() - start;
+
+        start = Time::MonoUS();
+        for(uint32 i = 0; i < iterations; i++)
+        {
+            for(uint32 j = 0; j < pitchinpix * size.h; j++)
+            {
+                dest[j] = src[j] | 0xff000000;
+            }
+        }
+        const int64 scalar_us = Time::MonoUS() - start;
+
+        MDFN_printf(_("%ux%u: %.0f ns/frame (scalar full pitch: %.0f ns/frame)\n"), size.w, size.h,
+                    fill_us * 1000.0 / iterations, scalar_us * 1000.0 / iterations);
+    }
+}
+
 void OpenGL_Blitter::ReadPixels(MDFN_Surface *surface, const MDFN_Rect *rect)
 {
     p_glPixelStorei(GL_UNPACK_ROW_LENGTH, surface->pitchinpix);
@@ -432,15 +579,15 @@ void OpenGL_Blitter::Blit(const MDFN_Surface *src_surface, const MDFN_Rect *src_
     //}
     if ( (tex_src_rect.w > 32) && (tex_src_rect.h > 32) )
     {
-        p_glPixelStorei(GL_UNPACK_ROW_LENGTH, src_surface->pitchinpix << ShaderIlace);
-        int bufferSize = (src_surface->pitchinpix << ShaderIlace) * tex_src_rect.h;
-    
-        for (int i = 0; i < bufferSize; i++) 
+        // only the visible rectangle gets uploaded, tightly packed
+        const uint32 src_pitchinpix = src_surface->pitchinpix << ShaderIlace;
+        p_glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+
+        if(!SupportPBO || !UploadPBO(src_pixies, src_pitchinpix, tex_src_rect.w, tex_src_rect.h))
         {
-            pixelBuffer[i] = src_pixies[i] | 0xff000000;
+            OpenGL_AlphaFill((uint32*)pixelBuffer, src_pixies, src_pitchinpix, tex_src_rect.w, tex_src_rect.h);
+            p_glTexSubImage2D(GL_TEXTURE_2D, 0, tex_src_rect.x, tex_src_rect.y, tex_src_rect.w, tex_src_rect.h, PixelFormat, PixelType, pixelBuffer);
         }
-    
-        p_glTexSubImage2D(GL_TEXTURE_2D, 0, tex_src_rect.x, tex_src_rect.y, tex_src_rect.w, tex_src_rect.h, PixelFormat, PixelType, pixelBuffer);
     }
 
     //
@@ -500,6 +647,51 @@ void OpenGL_Blitter::Blit(const MDFN_Surface *src_surface, const MDFN_Rect *src_
     //}
 }
 
+// The frame is written into the next buffer of a ring of pixel unpack buffers. The texture
+// upload from that buffer runs asynchronously while the next frame gets emulated.
+bool OpenGL_Blitter::UploadPBO(const uint32 *src_pixies, uint32 src_pitchinpix, uint32 w, uint32 h)
+{
+    const GLsizeiptr size = w * h * sizeof(uint32);
+    GLbitfield access = GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT;
+
+    PBOIndex = (PBOIndex + 1) % PBO_RING_SIZE;
+    p_glBindBuffer(GL_PIXEL_UNPACK_BUFFER, PBOs[PBOIndex]);
+
+    if(PBOSizes[PBOIndex] < size)
+    {
+        p_glBufferData(GL_PIXEL_UNPACK_BUFFER, size, NULL, GL_STREAM_DRAW);
+        PBOSizes[PBOIndex] = size;
+    }
+
+    if(PBOFences[PBOIndex])
+    {
+        // the upload from this buffer was issued PBO_RING_SIZE frames ago and is normally done
+        while(p_glClientWaitSync(PBOFences[PBOIndex], GL_SYNC_FLUSH_COMMANDS_BIT, 1000000) == GL_TIMEOUT_EXPIRED);
+        p_glDeleteSync(PBOFences[PBOIndex]);
+        PBOFences[PBOIndex] = NULL;
+        access |= GL_MAP_UNSYNCHRONIZED_BIT;
+    }
+
+    uint32 *dest = (uint32 *)p_glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, size, access);
+    if(!dest)
+    {
+        p_glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        return false;
+    }
+
+    OpenGL_AlphaFill(dest, src_pixies, src_pitchinpix, w, h);
+    p_glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+
+    p_glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, w, h, PixelFormat, PixelType, (const GLvoid *)0);
+
+    if(SupportARBSync)
+    {
+        PBOFences[PBOIndex] = p_glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    }
+    p_glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    return true;
+}
+
 void OpenGL_Blitter::Cleanup(void)
 {
     if(textures[0])
@@ -517,6 +709,22 @@ void OpenGL_Blitter::Cleanup(void)
     }
     DummyBlackSize = 0;
 
+    for(unsigned i = 0; i < PBO_RING_SIZE; i++)
+    {
+        if(PBOFences[i])
+        {
+            p_glDeleteSync(PBOFences[i]);
+            PBOFences[i] = NULL;
+        }
+        PBOSizes[i] = 0;
+    }
+
+    if(PBOs[0])
+    {
+        p_glDeleteBuffers(PBO_RING_SIZE, &PBOs[0]);
+        PBOs[0] = 0;
+    }
+
     if(shader)
     {
         delete shader;
@@ -567,6 +775,7 @@ OpenGL_Blitter::OpenGL_Blitter(int scanlines, ShaderType pixshader, const Shader
         MaxTextureSize = 0;
         SupportNPOT = false;
         SupportARBSync = false;
+        SupportPBO = false;
         PixelFormat = 0;
         PixelType = 0;
 
@@ -575,6 +784,14 @@ OpenGL_Blitter::OpenGL_Blitter(int scanlines, ShaderType pixshader, const Shader
             textures[i] = 0;
         }
 
+        for(unsigned i = 0; i < PBO_RING_SIZE; i++)
+        {
+            PBOs[i] = 0;
+            PBOSizes[i] = 0;
+            PBOFences[i] = NULL;
+        }
+        PBOIndex = 0;
+
         using_scanlines = 0;
         last_w = 0;
         last_h = 0;
@@ -674,9 +891,27 @@ OpenGL_Blitter::OpenGL_Blitter(int scanlines, ShaderType pixshader, const Shader
             SupportARBSync = true;
         }
 
+        // UploadPBO() maps the buffers with glMapBufferRange()
+        if (MDFN_GetSettingB("video.glpbo") && (version_h >= 0x300 ||
+            (glewGetExtension("GL_ARB_pixel_buffer_object") && glewGetExtension("GL_ARB_map_buffer_range"))))
+        {
+            MDFN_printf(_("Using pixel unpack buffers.\n"));
+            LFG(glGenBuffers);
+            LFG(glDeleteBuffers);
+            LFG(glBindBuffer);
+            LFG(glBufferData);
+            LFG(glMapBufferRange);
+            LFG(glUnmapBuffer);
+            SupportPBO = true;
+        }
+
         MDFN_indent(-1);
 
         p_glGenTextures(4, &textures[0]);
+        if(SupportPBO)
+        {
+            p_glGenBuffers(PBO_RING_SIZE, &PBOs[0]);
+        }
         for(int i = 0; i < 4; i++)
         {
             mednafenTextureIDs[i] = textures[i];
@@ -97,6 +97,13 @@ typedef void GLAPIENTRY (*glRotated_Func)(GLdouble angle, GLdouble x, GLdouble y
 typedef void GLAPIENTRY (*glScalef_Func)(GLfloat x, GLfloat y, GLfloat z);
 typedef void GLAPIENTRY (*glReadPixels_Func)(GLint x, GLint y, GLsizei width, GLsizei height, GLenum format, GLenum type, GLvoid *data);
 
+typedef void GLAPIENTRY (*glGenBuffers_Func)(GLsizei n, GLuint *buffers);
+typedef void GLAPIENTRY (*glDeleteBuffers_Func)(GLsizei n, const GLuint *buffers);
+typedef void GLAPIENTRY (*glBindBuffer_Func)(GLenum target, GLuint buffer);
+typedef void GLAPIENTRY (*glBufferData_Func)(GLenum target, GLsizeiptr size, const GLvoid *data, GLenum usage);
+typedef GLvoid* GLAPIENTRY (*glMapBufferRange_Func)(GLenum target, GLintptr offset, GLsizeiptr length, GLbitfield access);
+typedef GLboolean GLAPIENTRY (*glUnmapBuffer_Func)(GLenum target);
+
 #ifndef GL_ARB_sync
 #define GL_ARB_sync 1
 typedef int64_t GLint64;
@@ -160,6 +167,10 @@ typedef void GLAPIENTRY (*glGetObjectParameterivARB_Func)(GLhandleARB, GLenum, G
 
 #include "shader.h"
 
+// Copies the visible w x h rectangle of a frame into a tightly packed buffer and forces alpha to 0xff.
+void OpenGL_AlphaFill(uint32 *dest, const uint32 *src, uint32 src_pitchinpix, uint32 w, uint32 h);
+void OpenGL_AlphaFillBenchmark(void);
+
 class OpenGL_Blitter
 {
     public:
@@ -182,6 +193,7 @@ class OpenGL_Blitter
     void Cleanup(void);
     void DrawQuad(float src_coords[4][2], int dest_coords[4][2]);
     void DrawLinearIP(const unsigned UsingIP, const unsigned rotated, const MDFN_Rect *tex_src_rect, const MDFN_Rect *dest_rect, const uint32 tmpwidth, const uint32 tmpheight);
+    bool UploadPBO(const uint32 *src_pixies, uint32 src_pitchinpix, uint32 w, uint32 h);
     
     glGetError_Func p_glGetError;
     glBindTexture_Func p_glBindTexture;
@@ -223,6 +235,13 @@ class OpenGL_Blitter
     glRotated_Func p_glRotated;
     glScalef_Func p_glScalef;
     glReadPixels_Func p_glReadPixels;
+
+    glGenBuffers_Func p_glGenBuffers;
+    glDeleteBuffers_Func p_glDeleteBuffers;
+    glBindBuffer_Func p_glBindBuffer;
+    glBufferData_Func p_glBufferData;
+    glMapBufferRange_Func p_glMapBufferRange;
+    glUnmapBuffer_Func p_glUnmapBuffer;
     
     glFenceSync_Func p_glFenceSync;
     glIsSync_Func p_glIsSync;
@@ -261,6 +280,7 @@ class OpenGL_Blitter
     uint32 MaxTextureSize;        // Maximum power-of-2 texture width/height(we assume they're the same, and if they're not, this is set to the lower value of the two)
     bool SupportNPOT;         // True if the OpenGL implementation supports non-power-of-2-sized textures
     bool SupportARBSync;
+    bool SupportPBO;          // True if frames are uploaded through the pixel unpack buffer ring
     GLenum PixelFormat;        // For glTexSubImage2D()
     GLenum PixelType;        // For glTexSubImage2D()
     
@@ -276,6 +296,12 @@ class OpenGL_Blitter
     
     uint32 *DummyBlack;         // Black/Zeroed image data for cleaning textures
     uint32 DummyBlackSize;
+
+    enum { PBO_RING_SIZE = 3 };
+    GLuint PBOs[PBO_RING_SIZE];          // pixel unpack buffers for the emulated fb
+    GLsizeiptr PBOSizes[PBO_RING_SIZE];
+    GLsync PBOFences[PBO_RING_SIZE];     // signaled when the texture upload from a buffer is done
+    unsigned PBOIndex;
     
     friend class OpenGL_Blitter_Shader;
 };
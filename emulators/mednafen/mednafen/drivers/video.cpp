@@ -28,6 +28,9 @@
 
 #include <trio/trio.h>
 
+#include <atomic>
+#include <thread>
+
 #include "video.h"
 #include "opengl.h"
 #include "shader.h"
@@ -111,6 +114,11 @@ static const MDFNSetting GlobalVideoSettings[] =
                       gettext_noop("Note: Additionally, if the environment variable \"__GL_SYNC_TO_VBLANK\" does not exist, then it will be created and set to the value specified for this setting.  This has the effect of forcibly enabling or disabling vblank synchronization when running under Linux with NVidia's drivers."),
                    MDFNST_BOOL, "1" },
 
+    { "video.glpbo", MDFNSF_NOFLAGS, gettext_noop("Upload emulated frames asynchronously through OpenGL pixel unpack buffers."), nullptr, MDFNST_BOOL, "1" },
+
+    { "video.special.threads", MDFNSF_NOFLAGS, gettext_noop("Number of threads to run the special video scaler on."), gettext_noop("Each frame is split into bands of lines that are scaled in parallel; the output is the same regardless of the number of threads.  \"0\" uses one thread per CPU core, up to 8."), MDFNST_UINT, "0", "0", "8" },
+    { "video.dbg_scaler_bench", MDFNSF_SUPPRESS_DOC | MDFNSF_NONPERSISTENT, gettext_noop("Time the special video scalers when video is initialized."), gettext_noop("Each scaler is run at common native resolutions with 1 up to 8 threads, and the milliseconds per frame and any difference from the single-threaded output are printed to stdout."), MDFNST_BOOL, "0" },
+
     { "video.disable_composition", MDFNSF_NOFLAGS, gettext_noop("Attempt to disable desktop composition."), gettext_noop("Currently, this setting only has an effect on Windows Vista and Windows 7(and probably the equivalent server versions as well)."), MDFNST_BOOL, "1" },
 };
 
@@ -411,14 +419,446 @@ static uint32 LastBBClearTime = 0;
 static int rotated;
 
 static MDFN_PixelFormat pf_normal;
+static uint32 real_rs, real_gs, real_bs, real_as;
 
 static INLINE void MarkNeedBBClear(void)
 {
     NeedClear = 15;
 }
 
+//
+// The special scalers are run over horizontal bands of the source rectangle, shared out between the main thread and a small
+// persistent pool.  hqNx and scaleNx clamp at the top and bottom edges of whatever they're given, so each band is scaled together
+// with the neighbouring source lines the filter reads(two for scale4x, which is two passes of scale2x) into a scratch buffer, and
+// only the band's own output lines are kept; the result is identical to scaling the whole frame at once.  The 2xSaI family reads
+// from the already-padded copy of the frame, and the nearest-neighbor scalers don't look at neighbouring lines at all, so those
+// are scaled straight into the destination.
+//
+enum { MaxScalerThreads = 8 };
+enum { ScalerMinBandLines = 16 };
+
+struct ScalerThreadS
+{
+    MThreading::Thread* Thread = nullptr;
+    MThreading::Sem* WakeupSem = nullptr;
+    std::vector<uint32> Scratch;
+};
+
+static ScalerThreadS ScalerThreads[MaxScalerThreads];    // [0] is the main thread.
+static unsigned ScalerNumThreads = 1;
+static MThreading::Sem* ScalerDoneSem = nullptr;
+static std::atomic<bool> ScalerThreadsExit;
+
+static struct
+{
+    const ScalerDefinition* scaler;
+    const MDFN_Surface* src_surface;
+    MDFN_Rect src_rect;
+    MDFN_Surface* dest_surface;
+    const uint32* sai_pixels;
+    uint32 sai_pitchinpix;
+    bool nn_fallback;
+    bool convert;
+    unsigned num_bands;
+    std::atomic<unsigned> next_band;
+} ScalerJob;
+
+static void ScaleBand(const int y0, const int y1, std::vector<uint32>* scratch)
+{
+    const ScalerDefinition* const scaler = ScalerJob.scaler;
+    const MDFN_Surface* const src_surface = ScalerJob.src_surface;
+    const MDFN_Rect& src_rect = ScalerJob.src_rect;
+    MDFN_Surface* const dest_surface = ScalerJob.dest_surface;
+    const int dest_w = src_rect.w * scaler->xscale;
+    uint32* const dest_pixies = dest_surface->pixels + y0 * scaler->yscale * dest_surface->pitchinpix;
+
+    if(ScalerJob.nn_fallback || scaler->id == NTVB_NN2X || scaler->id == NTVB_NN3X || scaler->id == NTVB_NN4X || 
+       scaler->id == NTVB_NNY2X || scaler->id == NTVB_NNY3X || scaler->id == NTVB_NNY4X)
+    {
+        const MDFN_Rect band_src_rect({src_rect.x, src_rect.y + y0, src_rect.w, y1 - y0});
+        const MDFN_Rect band_dest_rect({0, y0 * scaler->yscale, dest_w, (y1 - y0) * scaler->yscale});
+
+        if(scaler->id == NTVB_NNY2X || scaler->id == NTVB_NNY3X || scaler->id == NTVB_NNY4X)
+        {
+            nnyx(scaler->id - NTVB_NNY2X + 2, src_surface, band_src_rect, dest_surface, band_dest_rect);
+        }
+        else
+        {
+            nnx(scaler->xscale, src_surface, band_src_rect, dest_surface, band_dest_rect);
+        }
+        return;
+    }
+
+    #ifdef WANT_FANCY_SCALERS
+    if(scaler->id == NTVB_2XSAI || scaler->id == NTVB_SUPER2XSAI || scaler->id == NTVB_SUPEREAGLE)
+    {
+        uint8* saipix = (uint8*)(ScalerJob.sai_pixels + y0 * ScalerJob.sai_pitchinpix);
+        const uint32 saipitch = ScalerJob.sai_pitchinpix << 2;
+        const uint32 dest_pitch = dest_surface->pitchinpix << 2;
+
+        if(scaler->id == NTVB_2XSAI)
+        {
+            _2xSaI32(saipix, saipitch, (uint8*)dest_pixies, dest_pitch, src_rect.w, y1 - y0);
+        }
+        else if(scaler->id == NTVB_SUPER2XSAI)
+        {
+            Super2xSaI32(saipix, saipitch, (uint8*)dest_pixies, dest_pitch, src_rect.w, y1 - y0);
+        }
+        else
+        {
+            SuperEagle32(saipix, saipitch, (uint8*)dest_pixies, dest_pitch, src_rect.w, y1 - y0);
+        }
+    }
+    else
+    {
+        const int context = (scaler->id == NTVB_SCALE4X) ? 2 : 1;
+        const int cy0 = std::max<int>(0, y0 - context);
+        const int cy1 = std::min<int>(src_rect.h, y1 + context);
+        uint8* source_pixies = (uint8*)(src_surface->pixels + src_rect.x + (src_rect.y + cy0) * src_surface->pitchinpix);
+        const uint32 source_pitch = src_surface->pitchinpix * sizeof(uint32);
+        uint32* out_pixies = dest_pixies;
+        uint32 out_pitchinpix = dest_surface->pitchinpix;
+
+        if(cy0 != y0 || cy1 != y1)
+        {
+            scratch->resize((size_t)dest_w * (cy1 - cy0) * scaler->yscale);
+            out_pixies = scratch->data();
+            out_pitchinpix = dest_w;
+        }
+
+        switch(scaler->id)
+        {
+            case NTVB_HQ2X: hq2x_32(source_pixies, (uint8*)out_pixies, src_rect.w, cy1 - cy0, source_pitch, out_pitchinpix << 2); break;
+            case NTVB_HQ3X: hq3x_32(source_pixies, (uint8*)out_pixies, src_rect.w, cy1 - cy0, source_pitch, out_pitchinpix << 2); break;
+            case NTVB_HQ4X: hq4x_32(source_pixies, (uint8*)out_pixies, src_rect.w, cy1 - cy0, source_pitch, out_pitchinpix << 2); break;
+
+            case NTVB_SCALE2X:
+            case NTVB_SCALE3X:
+            case NTVB_SCALE4X:
+                scale(scaler->xscale, out_pixies, out_pitchinpix << 2, source_pixies, source_pitch, sizeof(uint32), src_rect.w, cy1 - cy0);
+                break;
+        }
+
+        if(out_pixies != dest_pixies)
+        {
+            const uint32* band_pixies = out_pixies + (y0 - cy0) * scaler->yscale * out_pitchinpix;
+
+            for(int y = 0; y < (y1 - y0) * scaler->yscale; y++)
+            {
+                memcpy(dest_pixies + y * dest_surface->pitchinpix, band_pixies + y * out_pitchinpix, dest_w * sizeof(uint32));
+            }
+        }
+    }
+
+    if(ScalerJob.convert)
+    {
+        uint32 *lineptr = dest_pixies;
+
+        unsigned int srs = dest_surface->format.Rshift;
+        unsigned int sgs = dest_surface->format.Gshift;
+        unsigned int sbs = dest_surface->format.Bshift;
+        unsigned int drs = real_rs;
+        unsigned int dgs = real_gs;
+        unsigned int dbs = real_bs;
+
+        for(int y = 0; y < (y1 - y0) * scaler->yscale; y++)
+        {
+            for(int x = 0; x < dest_w; x++)
+            {
+                uint32 pixel = lineptr[x];
+                lineptr[x] = (((pixel >> srs) & 0xFF) << drs) | (((pixel >> sgs) & 0xFF) << dgs) | (((pixel >> sbs) & 0xFF) << dbs);
+            }
+            lineptr += dest_surface->pitchinpix;
+        }
+    }
+    #endif
+}
+
+static void RunScalerBands(ScalerThreadS* st)
+{
+    const int h = ScalerJob.src_rect.h;
+    const unsigned num_bands = ScalerJob.num_bands;
+    unsigned band;
+
+    while((band = ScalerJob.next_band.fetch_add(1, std::memory_order_relaxed)) < num_bands)
+    {
+        ScaleBand(h * band / num_bands, h * (band + 1) / num_bands, &st->Scratch);
+    }
+}
+
+static int ScalerThreadEntry(void* data)
+{
+    ScalerThreadS* const st = (ScalerThreadS*)data;
+
+    for(;;)
+    {
+        MThreading::Sem_Wait(st->WakeupSem);
+
+        if(ScalerThreadsExit.load(std::memory_order_acquire))
+        {
+            break;
+        }
+
+        RunScalerBands(st);
+        MThreading::Sem_Post(ScalerDoneSem);
+    }
+
+    return 0;
+}
+
+static void ScalerThreads_Kill(void)
+{
+    ScalerThreadsExit.store(true, std::memory_order_release);
+
+    for(unsigned i = 1; i < ScalerNumThreads; i++)
+    {
+        if(ScalerThreads[i].Thread)
+        {
+            MThreading::Sem_Post(ScalerThreads[i].WakeupSem);
+            MThreading::Thread_Wait(ScalerThreads[i].Thread, nullptr);
+            ScalerThreads[i].Thread = nullptr;
+        }
+
+        if(ScalerThreads[i].WakeupSem)
+        {
+            MThreading::Sem_Destroy(ScalerThreads[i].WakeupSem);
+            ScalerThreads[i].WakeupSem = nullptr;
+        }
+    }
+
+    for(auto& st : ScalerThreads)
+    {
+        std::vector<uint32>().swap(st.Scratch);
+    }
+
+    if(ScalerDoneSem)
+    {
+        MThreading::Sem_Destroy(ScalerDoneSem);
+        ScalerDoneSem = nullptr;
+    }
+
+    ScalerNumThreads = 1;
+}
+
+static void ScalerThreads_Init(unsigned num_threads)
+{
+    if(!num_threads)
+    {
+        num_threads = std::thread::hardware_concurrency();
+    }
+
+    num_threads = std::max<unsigned>(1, std::min<unsigned>(MaxScalerThreads, num_threads));
+
+    ScalerThreadsExit.store(false, std::memory_order_release);
+    ScalerNumThreads = 1;
+
+    if(num_threads < 2)
+    {
+        return;
+    }
+
+    try
+    {
+        ScalerDoneSem = MThreading::Sem_Create();
+
+        for(unsigned i = 1; i < num_threads; i++)
+        {
+            ScalerThreads[i].WakeupSem = MThreading::Sem_Create();
+            ScalerNumThreads = i + 1;
+            ScalerThreads[i].Thread = MThreading::Thread_Create(ScalerThreadEntry, &ScalerThreads[i], "MDFN Video Scaler");
+        }
+    }
+    catch(std::exception& e)
+    {
+        // Just run with however many threads were created.
+        if(!ScalerThreads[ScalerNumThreads - 1].Thread)
+        {
+            if(ScalerThreads[ScalerNumThreads - 1].WakeupSem)
+            {
+                MThreading::Sem_Destroy(ScalerThreads[ScalerNumThreads - 1].WakeupSem);
+                ScalerThreads[ScalerNumThreads - 1].WakeupSem = nullptr;
+            }
+            ScalerNumThreads--;
+        }
+        MDFN_Notify(MDFN_NOTICE_WARNING, _("Error creating video scaler thread: %s"), e.what());
+    }
+}
+
+//
+// Scales src_rect of src_surface by scaler into the top-left of dest_surface, with up to num_threads threads of the pool.
+//
+static void ScaleFrame(const ScalerDefinition* scaler, const MDFN_Surface* src_surface, const MDFN_Rect& src_rect, MDFN_Surface* dest_surface, const bool convert, unsigned num_threads)
+{
+    std::unique_ptr<MDFN_Surface> saisrc;
+
+    num_threads = std::max<unsigned>(1, std::min<unsigned>(num_threads, ScalerNumThreads));
+
+    ScalerJob.scaler = scaler;
+    ScalerJob.src_surface = src_surface;
+    ScalerJob.src_rect = src_rect;
+    ScalerJob.dest_surface = dest_surface;
+    ScalerJob.sai_pixels = nullptr;
+    ScalerJob.sai_pitchinpix = 0;
+    ScalerJob.nn_fallback = false;
+    ScalerJob.convert = false;
+
+    #ifdef WANT_FANCY_SCALERS
+    if(scaler->id == NTVB_SCALE4X || scaler->id == NTVB_SCALE3X || scaler->id == NTVB_SCALE2X)
+    {
+        //
+        // scale2x and scale3x apparently can't handle source heights less than 2.
+        // scale4x, it's less than 4
+        //
+        // None can handle source widths less than 2.
+        //
+        ScalerJob.nn_fallback = (src_rect.w < 2 || src_rect.h < 2 || (scaler->id == NTVB_SCALE4X && src_rect.h < 4));
+    }
+    else if(scaler->id == NTVB_HQ2X || scaler->id == NTVB_HQ3X || scaler->id == NTVB_HQ4X)
+    {
+        ScalerJob.convert = convert;
+    }
+    else if(scaler->id == NTVB_2XSAI || scaler->id == NTVB_SUPER2XSAI || scaler->id == NTVB_SUPEREAGLE)
+    {
+        const uint32* source_pixies = src_surface->pixels + src_rect.x + src_rect.y * src_surface->pitchinpix;
+
+        saisrc.reset(new MDFN_Surface(nullptr, src_rect.w + 4, src_rect.h + 4, src_rect.w + 4, src_surface->format, "scalers"));
+
+        for(int y = 0; y < 2; y++)
+        {
+            memcpy(saisrc->pixels + (y * saisrc->pitchinpix) + 2, source_pixies, src_rect.w * sizeof(uint32));
+            memcpy(saisrc->pixels + ((2 + y + src_rect.h) * saisrc->pitchinpix) + 2,
+                source_pixies + (src_rect.h - 1) * src_surface->pitchinpix, src_rect.w * sizeof(uint32));
+        }
+
+        for(int y = 0; y < src_rect.h; y++)
+        {
+            memcpy(saisrc->pixels + ((2 + y) * saisrc->pitchinpix) + 2, source_pixies + y * src_surface->pitchinpix, src_rect.w * sizeof(uint32));
+            memcpy(saisrc->pixels + ((2 + y) * saisrc->pitchinpix) + (2 + src_rect.w),
+                saisrc->pixels + ((2 + y) * saisrc->pitchinpix) + (2 + src_rect.w - 1), sizeof(uint32));
+        }
+
+        ScalerJob.sai_pixels = saisrc->pixels + 2 * saisrc->pitchinpix + 2;
+        ScalerJob.sai_pitchinpix = saisrc->pitchinpix;
+        ScalerJob.convert = convert;
+    }
+    #endif
+
+    if(num_threads < 2 || src_rect.h < 2 * ScalerMinBandLines)
+    {
+        ScaleBand(0, src_rect.h, &ScalerThreads[0].Scratch);
+        return;
+    }
+
+    ScalerJob.num_bands = std::min<unsigned>(src_rect.h / ScalerMinBandLines, num_threads * 2);
+    ScalerJob.next_band.store(0, std::memory_order_relaxed);
+
+    for(unsigned i = 1; i < num_threads; i++)
+    {
+        MThreading::Sem_Post(ScalerThreads[i].WakeupSem);
+    }
+
+    RunScalerBands(&ScalerThreads[0]);
+
+    for(unsigned i = 1; i < num_threads; i++)
+    {
+        MThreading::Sem_Wait(ScalerDoneSem);
+    }
+}
+
+//
+// Times every special scaler at the common native resolutions with each number of threads up to the size of the pool, and checks
+// the output against the single-threaded output.  Results go to stdout.
+//
+static void RunScalerBench(void)
+{
+    static const struct
+    {
+        int w, h;
+    } resolutions[] =
+    {
+        { 256, 224 },
+        { 320, 240 },
+        { 352, 240 },
+        { 512, 448 },
+        { 640, 480 },
+    };
+    const unsigned frames = 20;
+    const MDFN_PixelFormat bench_pf(MDFN_COLORSPACE_RGB, 16, 8, 0, 24);
+
+    for(auto& scaler : Scalers)
+    {
+        const char* name = "?";
+
+        for(const MDFNSetting_EnumList* el = Special_List; el->string; el++)
+        {
+            if(el->number == scaler.id && el->description)
+            {
+                name = el->description;
+                break;
+            }
+        }
+
+        #ifdef WANT_FANCY_SCALERS
+        if(scaler.id == NTVB_2XSAI || scaler.id == NTVB_SUPER2XSAI || scaler.id == NTVB_SUPEREAGLE)
+        {
+            Init_2xSaI(32, 555);
+        }
+        #else
+        if(scaler.id != NTVB_NN2X && scaler.id != NTVB_NN3X && scaler.id != NTVB_NN4X && scaler.id != NTVB_NNY2X && scaler.id != NTVB_NNY3X && scaler.id != NTVB_NNY4X)
+        {
+            continue;
+        }
+        #endif
+
+        for(auto& res : resolutions)
+        {
+            MDFN_Surface src(nullptr, res.w, res.h, res.w, bench_pf, "scaler bench");
+            MDFN_Surface dest(nullptr, res.w * scaler.xscale, res.h * scaler.yscale, res.w * scaler.xscale, bench_pf, "scaler bench");
+            const MDFN_Rect src_rect({0, 0, res.w, res.h});
+            std::vector<uint32> ref;
+            uint32 lfsr = 1;
+
+            // Flat blocks with some noise, so the edge-detecting scalers take a mix of paths.
+            for(int y = 0; y < res.h; y++)
+            {
+                for(int x = 0; x < res.w; x++)
+                {
+                    lfsr = (lfsr >> 1) ^ (-(lfsr & 1) & 0xD0000001);
+                    src.pixels[y * src.pitchinpix + x] = (((x >> 2) * 0x3B + (y / 3) * 0x95) * 0x010305) ^ ((lfsr & 0x7) ? 0 : (lfsr & 0xFFFFFF));
+                }
+            }
+
+            for(unsigned num_threads = 1; num_threads <= ScalerNumThreads; num_threads++)
+            {
+                const int64 st = Time::MonoUS();
+
+                for(unsigned i = 0; i < frames; i++)
+                {
+                    ScaleFrame(&scaler, &src, src_rect, &dest, false, num_threads);
+                }
+
+                const int64 et = Time::MonoUS();
+                bool mismatch = false;
+
+                if(num_threads == 1)
+                {
+                    ref.assign(dest.pixels, dest.pixels + dest.pitchinpix * dest.h);
+                }
+                else
+                {
+                    mismatch = memcmp(ref.data(), dest.pixels, ref.size() * sizeof(uint32)) != 0;
+                }
+
+                printf("Special scaler %s, %dx%d: %u thread(s): %.3f ms/frame%s\n", name, res.w, res.h, num_threads, (double)(et - st) / frames / 1000, mismatch ? " -- MISMATCH" : "");
+            }
+        }
+    }
+}
+
 static void SyncCleanup(void)
 {
+    ScalerThreads_Kill();
+
     if(SMSurface)
     {
         delete SMSurface;
@@ -481,8 +921,6 @@ static bool GenerateFullscreenDestRect(void)
  return screen_dest_rect.w < 16384 && screen_dest_rect.h < 16384;
 }
 
-static uint32 real_rs, real_gs, real_bs, real_as;
-
 void Video_SetWMInputBehavior(const WMInputBehavior& behavior)
 {
 }
@@ -557,6 +995,18 @@ void Video_Sync(MDFNGI *gi)
     assert(video_settings.special == NTVB_NONE || CurrentScaler);
     evideoip = video_settings.videoip;
 
+    if(MDFN_GetSettingB("video.dbg_scaler_bench"))
+    {
+        ScalerThreads_Init(MaxScalerThreads);
+        RunScalerBench();
+        ScalerThreads_Kill();
+    }
+
+    if(CurrentScaler)
+    {
+        ScalerThreads_Init(MDFN_GetSettingUI("video.special.threads"));
+    }
+
 
 
     MDFN_printf(_("Driver: %s\n"), (vdriver == VDRIVER_OPENGL) ? _("OpenGL") : _("Software SDL") );
@@ -756,115 +1206,9 @@ static void SubBlit(const MDFN_Surface *source_surface, const MDFN_Rect &src_rec
     {
         MDFN_Rect boohoo_rect({0, 0, eff_src_rect.w * CurrentScaler->xscale, eff_src_rect.h * CurrentScaler->yscale});
         MDFN_Surface bah_surface(nullptr, boohoo_rect.w, boohoo_rect.h, boohoo_rect.w, eff_source_surface->format, "SubBlit", false);
-        uint8* screen_pixies = (uint8 *)bah_surface.pixels;
-        uint32 screen_pitch = bah_surface.pitch32 << 2;
+        const bool convert = (bah_surface.format.Rshift != real_rs || bah_surface.format.Gshift != real_gs || bah_surface.format.Bshift != real_bs);
 
-        if(CurrentScaler->id == NTVB_SCALE4X || CurrentScaler->id == NTVB_SCALE3X || CurrentScaler->id == NTVB_SCALE2X)
-        {
-            #ifdef WANT_FANCY_SCALERS
-            //
-            // scale2x and scale3x apparently can't handle source heights less than 2.
-            // scale4x, it's less than 4
-            //
-            // None can handle source widths less than 2.
-            //
-            if(eff_src_rect.w < 2 || eff_src_rect.h < 2 || (CurrentScaler->id == NTVB_SCALE4X && eff_src_rect.h < 4))
-            {
-                nnx(CurrentScaler->id - NTVB_SCALE2X + 2, eff_source_surface, eff_src_rect, &bah_surface, boohoo_rect);
-            }
-            else
-            {
-                uint8 *source_pixies = (uint8 *)eff_source_surface->pixels + eff_src_rect.x * sizeof(uint32) + eff_src_rect.y * eff_source_surface->pitchinpix * sizeof(uint32);
-                scale((CurrentScaler->id ==  NTVB_SCALE2X)?2:(CurrentScaler->id == NTVB_SCALE4X)?4:3, 
-                    screen_pixies, screen_pitch, source_pixies, eff_source_surface->pitchinpix * sizeof(uint32), sizeof(uint32), eff_src_rect.w, eff_src_rect.h);
-            }
-            #endif
-        }
-        else if(CurrentScaler->id == NTVB_NN2X || CurrentScaler->id == NTVB_NN3X || CurrentScaler->id == NTVB_NN4X)
-        {
-            nnx(CurrentScaler->id - NTVB_NN2X + 2, eff_source_surface, eff_src_rect, &bah_surface, boohoo_rect);
-        }
-        else if(CurrentScaler->id == NTVB_NNY2X || CurrentScaler->id == NTVB_NNY3X || CurrentScaler->id == NTVB_NNY4X)
-        {
-            nnyx(CurrentScaler->id - NTVB_NNY2X + 2, eff_source_surface, eff_src_rect, &bah_surface, boohoo_rect);
-        }
-        #ifdef WANT_FANCY_SCALERS
-        else
-        {
-            uint8 *source_pixies = (uint8 *)(eff_source_surface->pixels + eff_src_rect.x + eff_src_rect.y * eff_source_surface->pitchinpix);
-
-            if(CurrentScaler->id == NTVB_HQ2X)
-            {
-                hq2x_32(source_pixies, screen_pixies, eff_src_rect.w, eff_src_rect.h, eff_source_surface->pitchinpix * sizeof(uint32), screen_pitch);
-            }
-            else if(CurrentScaler->id == NTVB_HQ3X)
-            {
-                hq3x_32(source_pixies, screen_pixies, eff_src_rect.w, eff_src_rect.h, eff_source_surface->pitchinpix * sizeof(uint32), screen_pitch);
-            }
-            else if(CurrentScaler->id == NTVB_HQ4X)
-            {
-                hq4x_32(source_pixies, screen_pixies, eff_src_rect.w, eff_src_rect.h, eff_source_surface->pitchinpix * sizeof(uint32), screen_pitch);
-            }
-            else if(CurrentScaler->id == NTVB_2XSAI || CurrentScaler->id == NTVB_SUPER2XSAI || CurrentScaler->id == NTVB_SUPEREAGLE)
-            {
-                MDFN_Surface saisrc(nullptr, eff_src_rect.w + 4, eff_src_rect.h + 4, eff_src_rect.w + 4, eff_source_surface->format, "scalers");
-
-                for(int y = 0; y < 2; y++)
-                {
-                    memcpy(saisrc.pixels + (y * saisrc.pitchinpix) + 2, (uint32 *)source_pixies, eff_src_rect.w * sizeof(uint32));
-                    memcpy(saisrc.pixels + ((2 + y + eff_src_rect.h) * saisrc.pitchinpix) + 2,
-                        (uint32 *)source_pixies + (eff_src_rect.h - 1) * eff_source_surface->pitchinpix, eff_src_rect.w * sizeof(uint32));
-                }
-
-                for(int y = 0; y < eff_src_rect.h; y++)
-                {
-                    memcpy(saisrc.pixels + ((2 + y) * saisrc.pitchinpix) + 2, (uint32*)source_pixies + y * eff_source_surface->pitchinpix, eff_src_rect.w * sizeof(uint32));
-                    memcpy(saisrc.pixels + ((2 + y) * saisrc.pitchinpix) + (2 + eff_src_rect.w),
-                        saisrc.pixels + ((2 + y) * saisrc.pitchinpix) + (2 + eff_src_rect.w - 1), sizeof(uint32));
-                }
-
-                {
-                    uint8 *saipix = (uint8 *)(saisrc.pixels + 2 * saisrc.pitchinpix + 2);
-                    uint32 saipitch = saisrc.pitchinpix << 2;
-
-                    if(CurrentScaler->id == NTVB_2XSAI)
-                    {
-                        _2xSaI32(saipix, saipitch, screen_pixies, screen_pitch, eff_src_rect.w, eff_src_rect.h);
-                    }
-                    else if(CurrentScaler->id == NTVB_SUPER2XSAI)
-                    {
-                        Super2xSaI32(saipix, saipitch, screen_pixies, screen_pitch, eff_src_rect.w, eff_src_rect.h);
-                    }
-                    else if(CurrentScaler->id == NTVB_SUPEREAGLE)
-                    {
-                        SuperEagle32(saipix, saipitch, screen_pixies, screen_pitch, eff_src_rect.w, eff_src_rect.h);
-                    }
-                }
-            }
-
-            if(bah_surface.format.Rshift != real_rs || bah_surface.format.Gshift != real_gs || bah_surface.format.Bshift != real_bs)
-            {
-                uint32 *lineptr = bah_surface.pixels;
-
-                unsigned int srs = bah_surface.format.Rshift;
-                unsigned int sgs = bah_surface.format.Gshift;
-                unsigned int sbs = bah_surface.format.Bshift;
-                unsigned int drs = real_rs;
-                unsigned int dgs = real_gs;
-                unsigned int dbs = real_bs;
-
-                for(int y = 0; y < boohoo_rect.h; y++)
-                {
-                    for(int x = 0; x < boohoo_rect.w; x++)
-                    {
-                        uint32 pixel = lineptr[x];
-                        lineptr[x] = (((pixel >> srs) & 0xFF) << drs) | (((pixel >> sgs) & 0xFF) << dgs) | (((pixel >> sbs) & 0xFF) << dbs);
-                    }
-                    lineptr += bah_surface.pitchinpix;
-                }
-            }
-        }
-        #endif
+        ScaleFrame(CurrentScaler, eff_source_surface, eff_src_rect, &bah_surface, convert, ScalerNumThreads);
 
         if(ogl_blitter)
         {
@@ -200,6 +200,19 @@ static INLINE unsigned MDFN_tzcount64_0UD(uint64 v)
  #endif
 }
 
+static INLINE unsigned MDFN_popcount64(uint64 v)
+{
+ #if defined(__GNUC__) || defined(__clang__) || defined(__ICC) || defined(__INTEL_COMPILER)
+ return __builtin_popcountll(v);
+ #else
+ v = v - ((v >> 1) & 0x5555555555555555ULL);
+ v = (v & 0x3333333333333333ULL) + ((v >> 2) & 0x3333333333333333ULL);
+ v = (v + (v >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+
+ return (v * 0x0101010101010101ULL) >> 56;
+ #endif
+}
+
 //
 // Result is defined for all possible inputs(including 0).
 //
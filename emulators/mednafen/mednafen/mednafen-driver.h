@@ -132,6 +132,9 @@ void MDFNI_ToggleDIPView(void);
 
 bool MDFNI_EnableStateRewind(bool enable);
 
+/* Prints the per-frame cost of state rewinding for the loaded game, as measured since rewinding was enabled. */
+void MDFNI_PrintStateRewindStatistics(void);
+
 bool MDFNI_StartAVRecord(const char *path, double SoundRate) MDFN_COLD;
 void MDFNI_StopAVRecord(void) MDFN_COLD;
 
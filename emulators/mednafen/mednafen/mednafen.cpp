@@ -49,6 +49,7 @@
 #include "mempatcher.h"
 #include "tests.h"
 #include "video/tblur.h"
+#include "video/blend.h"
 #include "qtrecord.h"
 
 namespace Mednafen
@@ -98,11 +99,18 @@ static const MDFNSetting MednafenSettings[] =
   { "netplay.localplayers", MDFNSF_NOFLAGS, gettext_noop("Local player count."), gettext_noop("Number of local players for network play.  This number is advisory to the server, and the server may assign fewer players if the number of players requested is higher than the number of controllers currently available."), MDFNST_UINT, "1", "0", "16" },
   { "netplay.nick", MDFNSF_NOFLAGS, gettext_noop("Nickname."), gettext_noop("Nickname to use for network play chat."), MDFNST_STRING, "" },
   { "netplay.gamekey", MDFNSF_NOFLAGS, gettext_noop("Key to hash with the MD5 hash of the game."), NULL, MDFNST_STRING, "" },
+  { "netplay.input_delay", MDFNSF_NOFLAGS, gettext_noop("Local input delay, in frames."), gettext_noop("Local input is sent to the server this many frames ahead of when it takes effect, hiding up to that many frames of network latency(at the cost of delayed input).  Takes effect when joining a game."), MDFNST_UINT, "0", "0", "30" },
+  { "netplay.rollback", MDFNSF_NOFLAGS, gettext_noop("Enable rollback mode."), gettext_noop("Instead of waiting for remote input each frame, emulate ahead with predicted remote input, and re-emulate the frames affected when a prediction turns out to be wrong.  Requires save states to be saved and loaded quickly, and deterministically, by the emulation module.  Movie recording is not supported in this mode."), MDFNST_BOOL, "0" },
+  { "netplay.rollback.frames", MDFNSF_NOFLAGS, gettext_noop("Maximum number of frames to emulate ahead of the server in rollback mode."), NULL, MDFNST_UINT, "8", "1", "60" },
+  { "netplay.dbg_latency", MDFNSF_SUPPRESS_DOC | MDFNSF_NONPERSISTENT, gettext_noop("Simulated network latency, in milliseconds."), gettext_noop("Delays data received from the server by this amount, for testing against a local server.  Rollback statistics are printed to the netplay console upon disconnection."), MDFNST_UINT, "0", "0", "1000" },
+  { "netplay.dbg_mispredict", MDFNSF_SUPPRESS_DOC | MDFNSF_NONPERSISTENT, gettext_noop("Percentage of frames to deliberately mispredict in rollback mode."), gettext_noop("The predicted input of this percentage of predicted frames is inverted, so that each of them is rolled back and re-emulated when the server's input arrives, even with a single player against a local server."), MDFNST_UINT, "0", "0", "100" },
 
   { "srwframes", MDFNSF_NOFLAGS, gettext_noop("Number of frames to keep states for when state rewinding is enabled."), 
 	gettext_noop("WARNING: Setting this to a large value may cause excessive RAM usage in some circumstances, such as with games that stream large volumes of data off of CDs."), MDFNST_UINT, "600", "10", "99999" },
+  { "srwmemory", MDFNSF_NOFLAGS, gettext_noop("Memory budget, in MiB, for the compressed states kept when state rewinding is enabled."),
+	gettext_noop("When nonzero, the oldest states are dropped once their total compressed size exceeds this value, and \"srwframes\" is ignored.  Set to \"0\" to limit the history by frame count instead."), MDFNST_UINT, "0", "0", "65536" },
 
-  { "cd.image_memcache", MDFNSF_NOFLAGS, gettext_noop("Cache entire CD images in memory."), gettext_noop("Reads the entire CD image(s) into memory at startup(which will cause a small delay).  Can help obviate emulation hiccups due to emulated CD access.  May cause more harm than good on low memory systems, systems with swap enabled, and/or when the disc images in question are on a fast SSD."), MDFNST_BOOL, "0" },
+  { "cd.image_memcache", MDFNSF_NOFLAGS, gettext_noop("Cache entire CD images in memory."), gettext_noop("Memory-maps the CD image(s), with read-ahead driven by emulated CD access, so seeking is fast without reading the whole image at startup.  Images that can't be memory-mapped(e.g. inside archives) are read entirely into memory at startup instead(which will cause a small delay).  Can help obviate emulation hiccups due to emulated CD access."), MDFNST_BOOL, "0" },
 
   { "filesys.untrusted_fip_check", MDFNSF_NOFLAGS, gettext_noop("Enable untrusted file-inclusion path security check."),
 	gettext_noop("When this setting is set to \"1\", the default, paths to files referenced from files like CUE sheets and PSF rips are checked for certain characters that can be used in directory traversal, and if found, loading is aborted.  Set it to \"0\" if you want to allow constructs like absolute paths in CUE sheets, but only if you understand the security implications of doing so(see \"Security Issues\" section in the documentation)."), MDFNST_BOOL, "1" },
@@ -130,8 +138,11 @@ static const MDFNSetting MednafenSettings[] =
   { "qtrecord.h_double_threshold", MDFNSF_NOFLAGS, gettext_noop("Double the raw image's height if it's below this threshold."), NULL, MDFNST_UINT, "256", "0", "1073741824" },
 
   { "qtrecord.vcodec", MDFNSF_NOFLAGS, gettext_noop("Video codec to use."), NULL, MDFNST_ENUM, "cscd", NULL, NULL, NULL, NULL, VCodec_List },
+  { "qtrecord.threads", MDFNSF_NOFLAGS, gettext_noop("Number of video encoding threads."), gettext_noop("Frames are converted and compressed on these threads, and written to the file in order on one more, so that the emulation thread only has to copy each frame.  0 uses one thread per CPU core but one, up to 8."), MDFNST_UINT, "0", "0", "8" },
+  { "qtrecord.dbg_bench", MDFNSF_SUPPRESS_DOC | MDFNSF_NONPERSISTENT, gettext_noop("Print QuickTime recording stall statistics."), gettext_noop("How long the emulation thread spends handing each frame to the encoder, how often it has to wait for a free frame buffer, and the encoding and writing time per frame, are printed to stdout every 600 frames and when the recording stops."), MDFNST_BOOL, "0" },
 
   { "video.deinterlacer", MDFNSF_CAT_VIDEO, gettext_noop("Deinterlacer to use for interlaced video."), NULL, MDFNST_ENUM, "weave", NULL, NULL, NULL, SettingChanged, Deinterlacer_List },
+  { "video.dbg_blend_bench", MDFNSF_SUPPRESS_DOC | MDFNSF_NONPERSISTENT, gettext_noop("Time the blend deinterlacer and temporal blur kernels."), gettext_noop("Each kernel is run with every available implementation on synthetic frames when a game is loaded, and on a pair of consecutive frames from the game every 600 frames; the timings and any mismatch against the plain C implementation are printed to stdout."), MDFNST_BOOL, "0" },
 
   { "affinity.cd", MDFNSF_NOFLAGS, gettext_noop("CD read threads CPU affinity mask."), gettext_noop("Set to 0 to disable changing affinity."), MDFNST_UINT, "0", "0x0000000000000000", "0xFFFFFFFFFFFFFFFF" },
 
@@ -221,6 +232,7 @@ static double last_sound_rate;
 static MDFN_PixelFormat last_pixel_format;
 static bool PrevInterlaced;
 static std::unique_ptr<Deinterlacer> deint;
+static bool BlendBench;
 
 static bool FFDiscard = false; // TODO:  Setting to discard sound samples instead of increasing pitch
 
@@ -275,6 +287,8 @@ bool MDFNI_StartAVRecord(const char *path, double SoundRate)
   spec.VideoHeight = MDFNGameInfo->lcm_height;
   spec.VideoCodec = MDFN_GetSettingI("qtrecord.vcodec");
   spec.MasterClock = MDFNGameInfo->MasterClock;
+  spec.EncoderThreads = MDFN_GetSettingUI("qtrecord.threads");
+  spec.Bench = MDFN_GetSettingB("qtrecord.dbg_bench");
 
   if(spec.VideoWidth < MDFN_GetSettingUI("qtrecord.w_double_threshold"))
    spec.VideoWidth *= 2;
@@ -340,6 +354,7 @@ void MDFNI_CloseGame(void)
 
   MDFNSRW_End();
   MDFNMOV_Stop();
+  MDFNSS_StopWriter();
 
   if(MDFNGameInfo->GameType != GMT_PLAYER)
    MDFN_FlushGameCheats(0);
@@ -849,6 +864,10 @@ static MDFN_COLD void LoadCommonPost(VirtualFS* vfs, const char* path)
 
 	TBlur_Init();
 
+	BlendBench = MDFN_GetSettingB("video.dbg_blend_bench");
+	if(BlendBench)
+	 Blend_BenchSynthetic();
+
 	MDFNSRW_Begin();
 
 	LastSoundMultiplier = 1;
@@ -1772,8 +1791,61 @@ void MDFN_MidLineUpdate(EmulateSpecStruct *espec, int y)
  //MDFND_MidLineUpdate(espec, y);
 }
 
+//
+// Everything a frame goes through once its input is final.  Netplay rollback re-emulates frames through here too, so movie input and
+// state rewinding are handled the same way for them(both are inactive during rollback netplay; cheats are applied by the emulation
+// module itself).
+//
+static void EmulateFrame(EmulateSpecStruct *espec)
+{
+ MDFNMOV_ProcessInput(PortData, PortDataLen, MDFNGameInfo->PortInfo.size());
+
+ if(espec->NeedRewind)
+ {
+  if(MDFNnetplay)
+  {
+   espec->NeedRewind = false;
+   MDFN_Notify(MDFN_NOTICE_STATUS, _("Can't rewind during netplay."));
+  }
+ }
+
+ // Don't even save states with state rewinding if netplay is enabled, it will degrade netplay performance, and can cause
+ // desynchs with some emulation(IE SNES based on bsnes).
+
+ if(MDFNnetplay)
+  espec->NeedSoundReverse = false;
+ else
+  espec->NeedSoundReverse = MDFNSRW_Frame(espec->NeedRewind);
+
+ MDFNGameInfo->Emulate(espec);
+}
+
+void MDFN_EmulateSuppressed(EmulateSpecStruct *espec)
+{
+ // The sound rate stays as it is, so cores don't rebuild their resamplers for
+ // every suppressed frame; the samples go into a scratch buffer and are dropped.
+ static std::vector<int16> SoundBufScratch;
+
+ espec->skip = true;
+ espec->VideoFormatChanged = false;
+ espec->SoundFormatChanged = false;
+ if(espec->SoundRate)
+ {
+  SoundBufScratch.resize(espec->SoundBufMaxSize * MDFNGameInfo->soundchan);
+  espec->SoundBuf = SoundBufScratch.data();
+ }
+ espec->SoundBufSize = 0;
+ espec->SoundBufSize_InternalProcessed = 0;
+ espec->MasterCycles = 0;
+ espec->MasterCycles_InternalProcessed = 0;
+ espec->NeedRewind = false;
+
+ EmulateFrame(espec);
+}
+
 void MDFNI_Emulate(EmulateSpecStruct *espec)
 {
+ MDFNSS_PollPendingSaves();
 
  //
  multiplier_save = 1;
@@ -1825,9 +1897,7 @@ void MDFNI_Emulate(EmulateSpecStruct *espec)
  if(MDFNGameInfo->TransformInput)
   MDFNGameInfo->TransformInput();
 
- Netplay_Update(PortDevice, PortData, PortDataLen);
-
- MDFNMOV_ProcessInput(PortData, PortDataLen, MDFNGameInfo->PortInfo.size());
+ Netplay_Update(PortDevice, PortData, PortDataLen, espec);
 
  if(qtrecorder)
   espec->skip = 0;
@@ -1835,24 +1905,7 @@ void MDFNI_Emulate(EmulateSpecStruct *espec)
  if(TBlur_IsOn())
   espec->skip = 0;
 
- if(espec->NeedRewind)
- {
-  if(MDFNnetplay)
-  {
-   espec->NeedRewind = false;
-   MDFN_Notify(MDFN_NOTICE_STATUS, _("Can't rewind during netplay."));
-  }
- }
-
- // Don't even save states with state rewinding if netplay is enabled, it will degrade netplay performance, and can cause
- // desynchs with some emulation(IE SNES based on bsnes).
-
- if(MDFNnetplay)
-  espec->NeedSoundReverse = false;
- else
-  espec->NeedSoundReverse = MDFNSRW_Frame(espec->NeedRewind);
-
- MDFNGameInfo->Emulate(espec);
+ EmulateFrame(espec);
 
  if(MDFNnetplay)
   Netplay_PostProcess(PortDevice, PortData, PortDataLen);
@@ -1911,6 +1964,9 @@ void MDFNI_Emulate(EmulateSpecStruct *espec)
  //
  //
 
+ if(BlendBench)
+  Blend_BenchRecord(espec->surface, espec->DisplayRect);
+
  if(espec->InterlaceOn)
  {
   if(!PrevInterlaced)
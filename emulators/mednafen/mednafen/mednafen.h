@@ -64,6 +64,9 @@ enum : unsigned
 void MDFN_MidSync(EmulateSpecStruct *espec, const unsigned flags = MIDSYNC_FLAG_UPDATE_INPUT | MIDSYNC_FLAG_SYNC_TIME);
 void MDFN_MidLineUpdate(EmulateSpecStruct *espec, int y);
 
+// Emulates a frame with video and sound output suppressed, for netplay rollback; the port data must already be set.
+void MDFN_EmulateSuppressed(EmulateSpecStruct *espec);
+
 }
 
 #include "state.h"
@@ -31,6 +31,22 @@
 #include "mempatcher.h"
 #include "FileStream.h"
 #include "MemoryStream.h"
+#include "MThreading.h"
+#include <mednafen/Time.h>
+#include "cputest/cputest.h"
+
+#include <atomic>
+#include <thread>
+
+#if defined(HAVE_SSE2_INTRINSICS)
+ #include <xmmintrin.h>
+ #include <emmintrin.h>
+#endif
+
+#if defined(ARCH_X86) && (defined(__GNUC__) || defined(__clang__))
+ #include <immintrin.h>
+ #define CS_HAVE_AVX2 1
+#endif
 
 namespace Mednafen
 {
@@ -52,17 +68,12 @@ MemoryPatch::~MemoryPatch()
 static uint32 PageSize;
 static uint32 NumPages;
 
-struct CompareStruct
-{
- bool excluded = false;
- uint8 value = 0;
-};
-
 struct RAMInfoS
 {
  uint8* Ptr = NULL;
  bool UseInSearch = false;
- std::vector<CompareStruct> Comp;
+ std::vector<uint8> Orig;	// Original values for the cheat search; empty if the page isn't being searched.
+ std::vector<uint64> Cand;	// Cheat search candidates, one bit per byte offset; set if not excluded.
 };
 
 static std::vector<RAMInfoS> RAMInfo;
@@ -817,14 +828,54 @@ int MDFNI_ToggleCheat(uint32 which)
  return(cheats[which].status);
 }
 
+//
+// Cheat search
+//
+struct SearchParams
+{
+ int type;
+ unsigned len;
+ bool big_endian;
+ uint64 v1, v2;
+ uint8 ob[8];	// Bytes(least-significant first) the original value must equal(types 0 and 1)
+ uint8 cb[8];	// Bytes the current value must equal(types 0 and 1), or that are added to it(type 2)
+};
+
+static INLINE void ClearCandTail(RAMInfoS* ri)
+{
+ if(PageSize & 63)
+  ri->Cand.back() &= ((uint64)1 << (PageSize & 63)) - 1;
+}
+
+static INLINE const uint8* GetCurrentPage(const uint32 page, std::vector<uint8>* buf)
+{
+ if(RAMInfo[page].Ptr)
+  return RAMInfo[page].Ptr;
+
+ buf->resize(PageSize);
+
+ for(uint32 offs = 0; offs < PageSize; offs++)
+  (*buf)[offs] = ReadU8(page * PageSize + offs);
+
+ return buf->data();
+}
+
 void MDFNI_CheatSearchSetCurrentAsOriginal(void)
 {
  for(uint32 page = 0; page < RAMInfo.size(); page++)
  {
-  for(uint32 offs = 0; offs < RAMInfo[page].Comp.size(); offs++)
+  auto& ri = RAMInfo[page];
+
+  // Don't check for excluded offsets here, or we'll break multi-byte iterative cheat searching!
+  if(ri.Orig.size())
   {
-   // Don't check for .excluded here, or we'll break multi-byte iterative cheat searching!
-   RAMInfo[page].Comp[offs].value = ReadU8(page * PageSize + offs);
+   if(ri.Ptr)
+    memcpy(ri.Orig.data(), ri.Ptr, PageSize);
+   else
+   {
+    for(uint32 offs = 0; offs < PageSize; offs++)
+     ri.Orig[offs] = ReadU8(page * PageSize + offs);
+   }
   }
  }
 }
@@ -833,8 +884,11 @@ void MDFNI_CheatSearchShowExcluded(void)
 {
  for(auto& ri : RAMInfo)
  {
-  for(auto& cc : ri.Comp)
-   cc.excluded = false;
+  if(ri.Cand.size())
+  {
+   std::fill(ri.Cand.begin(), ri.Cand.end(), ~(uint64)0);
+   ClearCandTail(&ri);
+  }
  }
 }
 
@@ -845,8 +899,8 @@ int32 MDFNI_CheatSearchGetCount(void)
 
  for(auto& ri : RAMInfo)
  {
-  for(auto& cc : ri.Comp)
-   count += !cc.excluded;
+  for(const uint64 cw : ri.Cand)
+   count += MDFN_popcount64(cw);
  }
 
  return count;
@@ -863,7 +917,7 @@ static INLINE void Read_CCV_RAMV(const uint32 A, const unsigned len, const bool
   const uint32 cur_page = cur_addr / PageSize;
   const uint32 cur_offs = cur_addr % PageSize;
 
-  if(RAMInfo[cur_page].Comp.size() > 0)
+  if(RAMInfo[cur_page].Orig.size() > 0)
   {
    unsigned int shiftie;
 
@@ -872,7 +926,7 @@ static INLINE void Read_CCV_RAMV(const uint32 A, const unsigned len, const bool
    else
     shiftie = x * 8;
 
-   *ccval |= (uint64)RAMInfo[cur_page].Comp[cur_offs].value << shiftie;
+   *ccval |= (uint64)RAMInfo[cur_page].Orig[cur_offs] << shiftie;
    *ramval |= (uint64)ReadU8(cur_addr) << shiftie;
   }
  }
@@ -883,11 +937,13 @@ void MDFNI_CheatSearchGet(int (*callb)(uint32 a, uint64 last, uint64 current, vo
 {
  for(uint32 page = 0; page < NumPages; page++)
  {
-  for(uint32 offs = 0; offs < RAMInfo[page].Comp.size(); offs++)
+  const auto& cand = RAMInfo[page].Cand;
+
+  for(uint32 w = 0; w < cand.size(); w++)
   {
-   if(!RAMInfo[page].Comp[offs].excluded)
+   for(uint64 cw = cand[w]; cw; cw &= cw - 1)
    {
-    const uint32 A = (page * PageSize) + offs;
+    const uint32 A = (page * PageSize) + (w * 64) + MDFN_tzcount64_0UD(cw);
     uint64 ccval, ramval;
 
     Read_CCV_RAMV(A, resultsbytelen, resultsbigendian, &ccval, &ramval);
@@ -906,78 +962,444 @@ void MDFNI_CheatSearchBegin(void)
 
  for(unsigned page = 0; page < RAMInfo.size(); page++)
  {
-  if(RAMInfo[page].UseInSearch)
+  auto& ri = RAMInfo[page];
+
+  if(ri.UseInSearch)
+  {
+   ri.Orig.resize(PageSize);
+   ri.Cand.resize((PageSize + 63) / 64);
+  }
+ }
+
+ MDFNI_CheatSearchShowExcluded();
+ MDFNI_CheatSearchSetCurrentAsOriginal();
+}
+
+static INLINE bool SearchMatch(uint64 ccval, uint64 ramval, const SearchParams& sp)
+{
+ switch(sp.type)
+ {
+  case 0: // Change to a specific value.
+	return ccval == sp.v1 && ramval == sp.v2;
+
+  case 1: // Search for relative change(between values).
+	return ccval == sp.v1 && (ccval - ramval) == sp.v2;
+
+  case 2: // Purely relative change.
+	return (ccval - ramval) == sp.v2;
+
+  case 3: // Any change
+	return ccval != ramval;
+
+  case 4: // Value decreased
+	return ramval < ccval;
+
+  case 5: // Value increased
+	return ramval > ccval;
+
+  case 6: // Value decreased(signed)
+  case 7: // Value increased(signed)
+	{
+	 const unsigned sh = 64 - sp.len * 8;
+	 const int64 sc = (int64)(ccval << sh) >> sh;
+	 const int64 sr = (int64)(ramval << sh) >> sh;
+
+	 return (sp.type == 6) ? (sr < sc) : (sr > sc);
+	}
+ }
+
+ return false;
+}
+
+//
+// Scalar fallback for BlockKeep(); bits for offsets the caller doesn't care about are undefined.
+//
+static uint64 BlockKeep_Scalar(const uint8* const o, const uint8* const c, const SearchParams& sp, uint64 cand)
+{
+ uint64 ret = 0;
+
+ for(; cand; cand &= cand - 1)
+ {
+  const unsigned j = MDFN_tzcount64_0UD(cand);
+  uint64 ccval = 0, ramval = 0;
+
+  for(unsigned x = 0; x < sp.len; x++)
   {
-   RAMInfo[page].Comp.resize(PageSize);
+   const unsigned shiftie = (sp.big_endian ? (sp.len - 1 - x) : x) * 8;
+
+   ccval |= (uint64)o[j + x] << shiftie;
+   ramval |= (uint64)c[j + x] << shiftie;
+  }
+
+  ret |= (uint64)SearchMatch(ccval, ramval, sp) << j;
+ }
+
+ return ret;
+}
+
+#if defined(HAVE_SSE2_INTRINSICS)
+#define CS_FN(n) n##_SSE2
+#define CS_VT __m128i
+#define CS_VL 16
+#define CS_LOADU(p) _mm_loadu_si128((const __m128i*)(p))
+#define CS_SET1(v) _mm_set1_epi8((char)(v))
+#define CS_ZERO() _mm_setzero_si128()
+#define CS_ONES() _mm_set1_epi8(-1)
+#define CS_CMPEQ(a, b) _mm_cmpeq_epi8(a, b)
+#define CS_AND(a, b) _mm_and_si128(a, b)
+#define CS_OR(a, b) _mm_or_si128(a, b)
+#define CS_XOR(a, b) _mm_xor_si128(a, b)
+#define CS_ANDNOT(a, b) _mm_andnot_si128(a, b)
+#define CS_ADD8(a, b) _mm_add_epi8(a, b)
+#define CS_SUB8(a, b) _mm_sub_epi8(a, b)
+#define CS_LTU8(a, b) _mm_andnot_si128(_mm_cmpeq_epi8(_mm_max_epu8(a, b), a), _mm_set1_epi8(-1))
+#define CS_MOVEMASK(v) (uint32)_mm_movemask_epi8(v)
+#include "mempatcher_search.inc"
+#undef CS_FN
+#undef CS_VT
+#undef CS_VL
+#undef CS_LOADU
+#undef CS_SET1
+#undef CS_ZERO
+#undef CS_ONES
+#undef CS_CMPEQ
+#undef CS_AND
+#undef CS_OR
+#undef CS_XOR
+#undef CS_ANDNOT
+#undef CS_ADD8
+#undef CS_SUB8
+#undef CS_LTU8
+#undef CS_MOVEMASK
+#endif
+
+#if defined(CS_HAVE_AVX2)
+#pragma GCC push_options
+#pragma GCC target("avx2")
+#define CS_FN(n) n##_AVX2
+#define CS_VT __m256i
+#define CS_VL 32
+#define CS_LOADU(p) _mm256_loadu_si256((const __m256i*)(p))
+#define CS_SET1(v) _mm256_set1_epi8((char)(v))
+#define CS_ZERO() _mm256_setzero_si256()
+#define CS_ONES() _mm256_set1_epi8(-1)
+#define CS_CMPEQ(a, b) _mm256_cmpeq_epi8(a, b)
+#define CS_AND(a, b) _mm256_and_si256(a, b)
+#define CS_OR(a, b) _mm256_or_si256(a, b)
+#define CS_XOR(a, b) _mm256_xor_si256(a, b)
+#define CS_ANDNOT(a, b) _mm256_andnot_si256(a, b)
+#define CS_ADD8(a, b) _mm256_add_epi8(a, b)
+#define CS_SUB8(a, b) _mm256_sub_epi8(a, b)
+#define CS_LTU8(a, b) _mm256_andnot_si256(_mm256_cmpeq_epi8(_mm256_max_epu8(a, b), a), _mm256_set1_epi8(-1))
+#define CS_MOVEMASK(v) (uint32)_mm256_movemask_epi8(v)
+#include "mempatcher_search.inc"
+#undef CS_FN
+#undef CS_VT
+#undef CS_VL
+#undef CS_LOADU
+#undef CS_SET1
+#undef CS_ZERO
+#undef CS_ONES
+#undef CS_CMPEQ
+#undef CS_AND
+#undef CS_OR
+#undef CS_XOR
+#undef CS_ANDNOT
+#undef CS_ADD8
+#undef CS_SUB8
+#undef CS_LTU8
+#undef CS_MOVEMASK
+#pragma GCC pop_options
+#endif
+
+enum
+{
+ SEARCH_IMPL_SCALAR = 0,
+ SEARCH_IMPL_SSE2,
+ SEARCH_IMPL_AVX2
+};
+
+struct SearchContext
+{
+ const SearchParams* sp;
+ const std::vector<uint32>* pages;
+ const std::vector<const uint8*>* cur;
+ std::atomic_uint_least32_t next;
+ int impl;
+};
+
+enum : unsigned { SearchPagesPerJob = 64 };
+enum : unsigned { MaxSearchThreads = 8 };
 
-   for(size_t offs = 0; offs < RAMInfo[page].Comp.size(); offs++)
+//
+// Filters the candidates at the offsets whose value lies entirely within the page; the rest are left to
+// the caller.
+//
+static void SearchPage(RAMInfoS* ri, const uint8* c, const SearchParams& sp, const int impl)
+{
+ const uint8* o = ri->Orig.data();
+ const uint32 bulk_end = (PageSize >= sp.len) ? (PageSize - sp.len + 1) : 0;
+
+ for(uint32 w = 0; w < ri->Cand.size(); w++)
+ {
+  uint64 cand = ri->Cand[w];
+  const uint32 base = w * 64;
+
+  if(!cand)
+   continue;
+
+  if((base + 64) <= bulk_end)
+  {
+   switch(impl)
    {
-    RAMInfo[page].Comp[offs].excluded = false;
-    RAMInfo[page].Comp[offs].value = ReadU8((page * PageSize) + offs);
+    default:
+	cand &= BlockKeep_Scalar(o + base, c + base, sp, cand);
+	break;
+
+#if defined(HAVE_SSE2_INTRINSICS)
+    case SEARCH_IMPL_SSE2:
+	cand &= BlockKeep_SSE2(o + base, c + base, sp);
+	break;
+#endif
+
+#if defined(CS_HAVE_AVX2)
+    case SEARCH_IMPL_AVX2:
+	cand &= BlockKeep_AVX2(o + base, c + base, sp);
+	break;
+#endif
    }
   }
+  else if(base < bulk_end)
+  {
+   const uint64 in_page = ((uint64)1 << (bulk_end - base)) - 1;
+
+   cand = (cand & ~in_page) | (cand & BlockKeep_Scalar(o + base, c + base, sp, cand & in_page));
+  }
+
+  ri->Cand[w] = cand;
  }
 }
 
-
-static uint64 INLINE CAbs(uint64 x) // FIXME?
+static int SearchThreadEntry(void* data)
 {
- if(x < 0)
-  return(0 - x);
- return x;
+ SearchContext* ctx = (SearchContext*)data;
+ uint32 i;
+
+ while((i = ctx->next.fetch_add(SearchPagesPerJob)) < ctx->pages->size())
+ {
+  const uint32 i_end = std::min<size_t>(i + SearchPagesPerJob, ctx->pages->size());
+
+  for(; i < i_end; i++)
+   SearchPage(&RAMInfo[(*ctx->pages)[i]], (*ctx->cur)[i], *ctx->sp, ctx->impl);
+ }
+
+ return 0;
 }
 
-void MDFNI_CheatSearchEnd(int type, uint64 v1, uint64 v2, unsigned int bytelen, bool bigendian)
+static int GetSearchImpl(void)
 {
- v1 &= (~0ULL) >> (8 - bytelen);
- v2 &= (~0ULL) >> (8 - bytelen);
+ static int impl = -1;
 
- resultsbytelen = bytelen;
- resultsbigendian = bigendian;
+ if(impl < 0)
+ {
+  impl = SEARCH_IMPL_SCALAR;
+
+#if defined(HAVE_SSE2_INTRINSICS)
+  impl = SEARCH_IMPL_SSE2;
+#endif
+
+#if defined(CS_HAVE_AVX2)
+  if(cputest_get_flags() & CPUTEST_FLAG_AVX2)
+   impl = SEARCH_IMPL_AVX2;
+#endif
+ }
+
+ return impl;
+}
+
+static void DoSearch(const SearchParams& sp, const int impl, const bool allow_threads)
+{
+ std::vector<uint32> pages;
+ std::vector<const uint8*> cur;
+ std::vector<std::vector<uint8>> cur_bufs;
 
  for(uint32 page = 0; page < NumPages; page++)
  {
-  for(uint32 offs = 0; offs < RAMInfo[page].Comp.size(); offs++)
+  if(RAMInfo[page].Orig.size())
+  {
+   pages.push_back(page);
+
+   // Pages without a pointer are read through the emulation module's MemRead(), only from this thread.
+   if(!RAMInfo[page].Ptr)
+    cur_bufs.emplace_back();
+  }
+ }
+
+ for(uint32 i = 0, bi = 0; i < pages.size(); i++)
+ {
+  if(RAMInfo[pages[i]].Ptr)
+   cur.push_back(RAMInfo[pages[i]].Ptr);
+  else
+   cur.push_back(GetCurrentPage(pages[i], &cur_bufs[bi++]));
+ }
+ //
+ //
+ //
+ {
+  SearchContext ctx;
+  std::vector<MThreading::Thread*> threads;
+  const uint64 total_size = (uint64)pages.size() * PageSize;
+  const unsigned num_threads = (!allow_threads || total_size < (1U << 20)) ? 1 : std::min<size_t>((pages.size() + SearchPagesPerJob - 1) / SearchPagesPerJob, std::max<unsigned>(1, std::min<unsigned>(MaxSearchThreads, std::thread::hardware_concurrency())));
+
+  ctx.sp = &sp;
+  ctx.pages = &pages;
+  ctx.cur = &cur;
+  ctx.next = 0;
+  ctx.impl = impl;
+
+  try
+  {
+   for(unsigned i = 1; i < num_threads; i++)
+    threads.push_back(MThreading::Thread_Create(SearchThreadEntry, &ctx, "Cheat Search"));
+  }
+  catch(...)
   {
-   if(!RAMInfo[page].Comp[offs].excluded)
+   // Fall back to whatever threads could be created; this thread always takes part.
+  }
+
+  SearchThreadEntry(&ctx);
+
+  for(MThreading::Thread* t : threads)
+   MThreading::Thread_Wait(t, nullptr);
+ }
+ //
+ // Values that straddle a page boundary.
+ //
+ for(uint32 page : pages)
+ {
+  auto& ri = RAMInfo[page];
+  const uint32 bulk_end = (PageSize >= sp.len) ? (PageSize - sp.len + 1) : 0;
+
+  for(uint32 offs = bulk_end; offs < PageSize; offs++)
+  {
+   uint64& cw = ri.Cand[offs >> 6];
+   const uint64 bit = (uint64)1 << (offs & 63);
+
+   if(cw & bit)
    {
-    const uint32 A = (page * PageSize) + offs;
     uint64 ccval, ramval;
-    bool do_exclude = false;
 
-    Read_CCV_RAMV(A, bytelen, resultsbigendian, &ccval, &ramval);
+    Read_CCV_RAMV(page * PageSize + offs, sp.len, sp.big_endian, &ccval, &ramval);
 
-    switch(type)
-    {
-     case 0: // Change to a specific value.
-	do_exclude |= !(ccval == v1 && ramval == v2);
-	break;
-	 
-     case 1: // Search for relative change(between values).
-	do_exclude |= !(ccval == v1 && CAbs(ccval - ramval) == v2);
-	break;
+    if(!SearchMatch(ccval, ramval, sp))
+     cw &= ~bit;
+   }
+  }
+ }
+}
 
-     case 2: // Purely relative change.
-	do_exclude |= !(CAbs(ccval - ramval) == v2);
-	break;
+//
+// The original one-address-at-a-time search, for cheats.dbg_search_bench.
+//
+static void DoSearch_Reference(const SearchParams& sp)
+{
+ for(uint32 page = 0; page < NumPages; page++)
+ {
+  auto& ri = RAMInfo[page];
 
-     case 3: // Any change
-	do_exclude |= !(ccval != ramval);
-        break;
+  for(uint32 offs = 0; offs < ri.Orig.size(); offs++)
+  {
+   uint64& cw = ri.Cand[offs >> 6];
+   const uint64 bit = (uint64)1 << (offs & 63);
 
-     case 4: // Value decreased
-	do_exclude |= (ramval >= ccval);
-        break;
+   if(cw & bit)
+   {
+    uint64 ccval, ramval;
 
-     case 5: // Value increased
-	do_exclude |= (ramval <= ccval);
-        break;
-    }
+    Read_CCV_RAMV(page * PageSize + offs, sp.len, sp.big_endian, &ccval, &ramval);
 
-    RAMInfo[page].Comp[offs].excluded |= do_exclude;
+    if(!SearchMatch(ccval, ramval, sp))
+     cw &= ~bit;
    }
   }
  }
+}
+
+static void RunSearchBench(const SearchParams& sp)
+{
+ static const char* const impl_names[] = { "scalar", "SSE2", "AVX2" };
+ std::vector<std::vector<uint64>> cand_saved;
+ std::vector<uint64> cand_ref;
+ const int best_impl = GetSearchImpl();
+
+ for(auto& ri : RAMInfo)
+  cand_saved.push_back(ri.Cand);
+
+ {
+  const int64 st = Time::MonoUS();
+
+  DoSearch_Reference(sp);
+  printf("Cheat search(type=%d, len=%u): reference: %lld us\n", sp.type, sp.len, (long long)(Time::MonoUS() - st));
+
+  for(auto& ri : RAMInfo)
+   cand_ref.insert(cand_ref.end(), ri.Cand.begin(), ri.Cand.end());
+ }
+
+ for(int impl = SEARCH_IMPL_SCALAR; impl <= best_impl; impl++)
+ {
+  for(unsigned threaded = 0; threaded < 2; threaded++)
+  {
+   std::vector<uint64> cand_new;
+
+   for(size_t page = 0; page < RAMInfo.size(); page++)
+    RAMInfo[page].Cand = cand_saved[page];
+
+   const int64 st = Time::MonoUS();
+
+   DoSearch(sp, impl, threaded);
+   const int64 et = Time::MonoUS();
+
+   for(auto& ri : RAMInfo)
+    cand_new.insert(cand_new.end(), ri.Cand.begin(), ri.Cand.end());
+
+   printf("Cheat search(type=%d, len=%u): %s%s: %lld us%s\n", sp.type, sp.len, impl_names[impl], threaded ? ", threaded" : "", (long long)(et - st), (cand_new != cand_ref) ? " -- MISMATCH" : "");
+  }
+ }
+}
+
+void MDFNI_CheatSearchEnd(int type, uint64 v1, uint64 v2, unsigned int bytelen, bool bigendian)
+{
+ SearchParams sp;
+
+ v1 &= (~0ULL) >> ((8 - bytelen) * 8);
+ v2 &= (~0ULL) >> ((8 - bytelen) * 8);
+
+ resultsbytelen = bytelen;
+ resultsbigendian = bigendian;
+
+ sp.type = type;
+ sp.len = bytelen;
+ sp.big_endian = bigendian;
+ sp.v1 = v1;
+ sp.v2 = v2;
+
+ for(unsigned s = 0; s < 8; s++)
+ {
+  // For type 1, ccval == v1 and ccval - ramval == v2 means ramval == v1 - v2.
+  const uint64 cvt = (type == 1) ? (v1 - v2) : v2;
+
+  sp.ob[s] = v1 >> (s * 8);
+  sp.cb[s] = cvt >> (s * 8);
+ }
+
+ // No possible match if v1 - v2 doesn't fit in the value length.
+ if(type == 1 && bytelen < 8 && ((v1 - v2) >> (bytelen * 8)))
+  sp.type = -1;
+
+ if(MDFN_GetSettingB("cheats.dbg_search_bench"))
+  RunSearchBench(sp);
+ else
+  DoSearch(sp, GetSearchImpl(), true);
 
  if(type >= 4)
   MDFNI_CheatSearchSetCurrentAsOriginal();
@@ -998,6 +1420,7 @@ static void SettingChanged(const char *name)
 extern const MDFNSetting MDFNMP_Settings[] =
 {
  { "cheats", MDFNSF_NOFLAGS, "Enable cheats.", NULL, MDFNST_BOOL, "1", NULL, NULL, NULL, SettingChanged },
+ { "cheats.dbg_search_bench", MDFNSF_SUPPRESS_DOC | MDFNSF_NONPERSISTENT, "Time cheat searches against the original search implementation.", "Each search is run with every available implementation, with and without threads, and the timings and any mismatch in the results are printed to stdout.", MDFNST_BOOL, "0" },
  { NULL}
 };
 
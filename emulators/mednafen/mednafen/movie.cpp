@@ -94,6 +94,11 @@ void MDFNI_SaveMovie(char *fname, const MDFN_Surface *surface, const MDFN_Rect *
    throw MDFN_Error(0, _("Module %s is not compatible with manual movie save starting/stopping during netplay."), MDFNGameInfo->shortname);
   }
 
+  if(Netplay_IsRollback())	/* Predicted input may be wrong, and re-emulated frames go through MDFNMOV_ProcessInput() too. */
+  {
+   throw MDFN_Error(0, _("Can't record movies during rollback netplay."));
+  }
+
   if(ActiveMovieMode == MOVIE_PLAYING)	/* Can't interrupt playback.*/
   {
    throw MDFN_Error(0, _("Can't record movie during movie playback."));
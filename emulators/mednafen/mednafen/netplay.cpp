@@ -37,6 +37,8 @@
 
 #include "driver.h"
 
+#include <deque>
+
 namespace Mednafen
 {
 
@@ -61,6 +63,54 @@ static bool StateLoaded;	// Set to true/false in Netplay_Update() call paths, us
 static std::unique_ptr<uint8[]> incoming_buffer;	// TotalInputStateSize + 1
 static std::unique_ptr<uint8[]> outgoing_buffer;	// 1 + LocalInputStateSize + 4
 
+//
+// Everything received from the server goes through IncomingQueue, so that complete messages can be checked for without blocking, and
+// so that netplay.dbg_latency can hold received data back to simulate a high-latency connection to a local server.
+//
+struct IncomingChunk
+{
+ int64 ReleaseTime;		// Time::MonoUS() time after which the data may be consumed.
+ std::vector<uint8> Data;
+ uint32 Pos;
+};
+static std::deque<IncomingChunk> IncomingQueue;
+static uint32 IncomingLatency;	// Microseconds
+
+//
+// Rollback mode(netplay.rollback): instead of waiting on the server for every frame's input, emulate ahead with predicted input, keeping
+// a save state from before each predicted frame.  When the server's input for a frame differs from what was predicted, load the state
+// from before that frame, and re-emulate up to the present with video and sound output suppressed.
+//
+struct RB_Frame
+{
+ std::vector<uint8> Input;	// TotalInputStateSize; predicted input the frame was emulated with.
+ std::unique_ptr<MemoryStream> State;	// State from before the frame was emulated.
+};
+
+static bool RB_Enabled;
+static uint32 RB_MaxFrames;
+static uint32 RB_InputDelay;
+static uint32 RB_MispredictPercent;
+static uint32 RB_MispredictLCG;
+static std::deque<RB_Frame> RB_Frames;		// Emulated frames whose input the server hasn't sent yet, oldest first.
+static std::deque<std::vector<uint8>> RB_Ahead;	// Input received from the server for frames not yet emulated.
+static std::deque<std::vector<uint8>> RB_Sent;	// Local input sent to the server, and not yet received back.
+static std::vector<uint8> RB_LastInput;		// Last input received from the server.
+static uint32 RB_Behind;			// Number of frames to re-emulate(with predicted input) to catch back up to the present.
+static EmulateSpecStruct* RB_espec;
+
+static struct
+{
+ uint64 Frames;
+ uint64 PredictedFrames;
+ uint64 Rollbacks;
+ uint64 ResimFrames;
+ uint64 ResimTime;
+ uint64 Stalls;
+} RB_Stats;
+
+static bool IncomingPending(void);
+
 static void RebuildPortVtoVMap(const uint32 PortDevIdx[])
 {
  const unsigned NumPorts = MDFNGameInfo->PortInfo.size();
@@ -104,7 +154,7 @@ static void SetLPM(const uint32 v, const uint32 PortDevIdx[], const uint32 PortL
 
  RebuildPortVtoVMap(PortDevIdx);
  //
- MDFND_NetplaySetHints(true, Connection->CanReceive(), LocalPlayersMask);
+ MDFND_NetplaySetHints(true, IncomingPending(), LocalPlayersMask);
 }
 
 
@@ -156,29 +206,79 @@ static void SendData(const void *data, uint32 len)
  } while(len);
 }
 
+static void PumpIncoming(void)
+{
+ uint8 buf[4096];
+
+ while(Connection->CanReceive())
+ {
+  const uint32 received = Connection->Receive(buf, sizeof(buf));
+
+  if(!received)
+   break;
+
+  IncomingQueue.push_back({ (int64)Time::MonoUS() + IncomingLatency, std::vector<uint8>(buf, buf + received), 0 });
+ }
+}
+
+static uint32 IncomingAvail(void)
+{
+ const int64 now = Time::MonoUS();
+ uint32 ret = 0;
+
+ for(auto const& ic : IncomingQueue)
+ {
+  if(ic.ReleaseTime > now)
+   break;
+
+  ret += ic.Data.size() - ic.Pos;
+ }
+
+ return ret;
+}
+
+static bool IncomingPending(void)
+{
+ return IncomingQueue.size() || Connection->CanReceive();
+}
+
 static void RecvData(void *data, uint32 len)
 {
- do
+ while(len)
  {
-  int32 received = Connection->Receive(data, len);
-  assert(received >= 0);
+  PumpIncoming();
+
+  const int64 now = Time::MonoUS();
 
-  data = (uint8*)data + received;
-  len -= received;
+  while(len && IncomingQueue.size() && IncomingQueue.front().ReleaseTime <= now)
+  {
+   IncomingChunk* ic = &IncomingQueue.front();
+   const uint32 cc = std::min<uint32>(len, ic->Data.size() - ic->Pos);
+
+   memcpy(data, &ic->Data[ic->Pos], cc);
+   data = (uint8*)data + cc;
+   len -= cc;
+   ic->Pos += cc;
+
+   if(ic->Pos == ic->Data.size())
+    IncomingQueue.pop_front();
+  }
 
   if(len)
   {
    if(MDFND_CheckNeedExit())
     throw MDFN_Error(0, _("Mednafen exit pending."));
 
-   Connection->CanReceive(50000);
+   if(IncomingQueue.size())
+    Time::SleepMS(1);
+   else
+    Connection->CanReceive(50000);
   }
- } while(len);
+ }
 
- MDFND_NetplaySetHints(true, Connection->CanReceive(), LocalPlayersMask);
+ MDFND_NetplaySetHints(true, IncomingPending(), LocalPlayersMask);
 }
 
-
 struct login_data_t
 {
  uint8 gameid[16];
@@ -324,9 +424,28 @@ static void NetplayStart(const uint32 PortDeviceCache[16], const uint32 PortData
 
  MDFN_FlushGameCheats(0);	/* Save our pre-netplay cheats. */
 
+ //
+ //
+ //
+ RB_Enabled = MDFN_GetSettingB("netplay.rollback");
+ RB_MaxFrames = MDFN_GetSettingUI("netplay.rollback.frames");
+ RB_InputDelay = MDFN_GetSettingUI("netplay.input_delay");
+ IncomingLatency = MDFN_GetSettingUI("netplay.dbg_latency") * 1000;
+ RB_MispredictPercent = MDFN_GetSettingUI("netplay.dbg_mispredict");
+ RB_MispredictLCG = 1;
+ RB_Frames.clear();
+ RB_Ahead.clear();
+ RB_Sent.clear();
+ RB_LastInput.assign(TotalInputStateSize, 0);
+ RB_Behind = 0;
+ memset(&RB_Stats, 0, sizeof(RB_Stats));
+
  if(MDFNMOV_IsPlaying())		/* Recording's ok during netplay, playback is not. */
   MDFNMOV_Stop();
 
+ if(RB_Enabled && MDFNMOV_IsRecording())	/* ...except in rollback mode, where input may be predicted wrongly. */
+  MDFNMOV_Stop();
+
  NetPrintText(_("*** Connection established."));
 
  if(game_key.size())
@@ -334,7 +453,7 @@ static void NetplayStart(const uint32 PortDeviceCache[16], const uint32 PortData
  //printf("%d\n", TotalInputStateSize);
  //
  //
- MDFND_NetplaySetHints(true, Connection->CanReceive(), LocalPlayersMask);
+ MDFND_NetplaySetHints(true, IncomingPending(), LocalPlayersMask);
 }
 
 static void SendCommand(uint8 cmd, uint32 len, const void* data = NULL)
@@ -620,6 +739,34 @@ void NetplaySendState(void)
  }
 }
 
+static void SendLocalInput(uint8* const PortData[], const uint32 PortLen[])
+{
+ const unsigned NumPorts = MDFNGameInfo->PortInfo.size();
+
+ outgoing_buffer[0] = 0; 	// Not a command
+
+ for(unsigned x = 0, wpos = 1; x < NumPorts; x++)
+ {
+  if(!PortLen[x])
+   continue;
+
+  auto n = PortVtoLVMap[x];
+  if(n != 0xFF)
+  {
+   if(PortData)
+    memcpy(&outgoing_buffer[wpos], PortData[n], PortLen[n]);
+   else
+    memset(&outgoing_buffer[wpos], 0, PortLen[n]);
+
+   wpos += PortLen[n];
+  }
+ }
+ SendData(&outgoing_buffer[0], 1 + LocalInputStateSize);
+
+ if(RB_Enabled)
+  RB_Sent.emplace_back(&outgoing_buffer[1], &outgoing_buffer[1 + LocalInputStateSize]);
+}
+
 static void ProcessCommand(const uint8 cmd, const uint32 raw_len, const uint32 PortDevIdx[], uint8* const PortData[], const uint32 PortLen[], int NumPorts)
 {
   switch(cmd)
@@ -954,6 +1101,11 @@ static void ProcessCommand(const uint8 cmd, const uint32 raw_len, const uint32 P
 			  Joined = true;
 
 			  SendCommand(MDFNNPCMD_SETFPS, MDFNGameInfo->fps);
+
+			  // Send neutral input for the first netplay.input_delay frames, so that local input
+			  // is always that many frames ahead of the server.
+			  for(uint32 i = 0; i < RB_InputDelay; i++)
+			   SendLocalInput(nullptr, PortLen);
 			 }
 			 else if(cmd == MDFNNPCMD_PLAYERLEFT)
 			 {
@@ -1023,7 +1175,258 @@ static void ProcessCommand(const uint8 cmd, const uint32 raw_len, const uint32 P
     }
 #endif
 
-void Netplay_Update(const uint32 PortDevIdx[], uint8* const PortData[], const uint32 PortLen[])
+//
+//
+//
+static std::vector<std::unique_ptr<MemoryStream>> RB_StatePool;
+
+static std::unique_ptr<MemoryStream> RB_SaveState(void)
+{
+ std::unique_ptr<MemoryStream> ret;
+
+ if(RB_StatePool.size())
+ {
+  ret = std::move(RB_StatePool.back());
+  RB_StatePool.pop_back();
+  ret->truncate(0);
+  ret->rewind();
+ }
+ else
+  ret.reset(new MemoryStream(65536));
+
+ MDFNSS_SaveSM(ret.get(), true);
+
+ return ret;
+}
+
+static void RB_PopFrame(void)
+{
+ RB_StatePool.push_back(std::move(RB_Frames.front().State));
+ RB_Frames.pop_front();
+}
+
+static void RB_SetPortData(const uint8* input, uint8* const PortData[], const uint32 PortLen[])
+{
+ for(unsigned x = 0, rpos = 0; x < MDFNGameInfo->PortInfo.size(); x++)
+ {
+  memcpy(PortData[x], &input[rpos], PortLen[x]);
+  rpos += PortLen[x];
+ }
+}
+
+//
+// Predicts the input for the index'th frame after the last frame received from the server: the last input received, with the
+// local input sent for that frame in the ports we control.
+//
+static void RB_Predict(std::vector<uint8>* input, const size_t index, const uint32 PortLen[])
+{
+ *input = RB_LastInput;
+
+ if(RB_MispredictPercent)
+ {
+  RB_MispredictLCG = RB_MispredictLCG * 1103515245 + 12345;
+
+  if(((RB_MispredictLCG >> 16) % 100) < RB_MispredictPercent)
+  {
+   // netplay.dbg_mispredict; can't match what the server sends.
+   for(auto& b : *input)
+    b = ~b;
+   return;
+  }
+ }
+
+ if(index < RB_Sent.size() && RB_Sent[index].size() == LocalInputStateSize)
+ {
+  const uint8* local = RB_Sent[index].data();
+
+  for(unsigned x = 0, pos = 0, lpos = 0; x < MDFNGameInfo->PortInfo.size(); x++)
+  {
+   if(PortLen[x] && PortVtoLVMap[x] != 0xFF)
+   {
+    memcpy(&(*input)[pos], &local[lpos], PortLen[x]);
+    lpos += PortLen[x];
+   }
+   pos += PortLen[x];
+  }
+ }
+}
+
+// Emulates a frame with video and sound output suppressed.
+static void RB_EmulateSuppressed(const uint8* input, uint8* const PortData[], const uint32 PortLen[])
+{
+ const int64 start_time = Time::MonoUS();
+ EmulateSpecStruct es = *RB_espec;
+
+ RB_SetPortData(input, PortData, PortLen);
+ MDFN_EmulateSuppressed(&es);
+
+ RB_Stats.ResimFrames++;
+ RB_Stats.ResimTime += Time::MonoUS() - start_time;
+}
+
+// Loads the state from before the oldest predicted frame; the predicted frames will be re-emulated by RB_CatchUp().
+static void RB_Rewind(void)
+{
+ if(!RB_Frames.size())
+  return;
+
+ RB_Frames.front().State->rewind();
+ MDFNSS_LoadSM(RB_Frames.front().State.get(), true);
+
+ RB_Behind += RB_Frames.size();
+ while(RB_Frames.size())
+  RB_PopFrame();
+}
+
+static void RB_ProcessInput(const uint8* input, uint8* const PortData[], const uint32 PortLen[])
+{
+ RB_LastInput.assign(input, input + TotalInputStateSize);
+
+ if(RB_Sent.size())
+  RB_Sent.pop_front();
+
+ if(RB_Frames.size())
+ {
+  if(!memcmp(RB_Frames.front().Input.data(), input, TotalInputStateSize))
+  {
+   RB_PopFrame();
+   return;
+  }
+
+  RB_Stats.Rollbacks++;
+  RB_Rewind();
+ }
+
+ if(RB_Behind)
+ {
+  RB_EmulateSuppressed(input, PortData, PortLen);
+  RB_Behind--;
+ }
+ else
+  RB_Ahead.push_back(RB_LastInput);
+}
+
+static void RB_CatchUp(uint8* const PortData[], const uint32 PortLen[])
+{
+ while(RB_Behind)
+ {
+  RB_Frame f;
+
+  RB_Predict(&f.Input, RB_Frames.size(), PortLen);
+  f.State = RB_SaveState();
+  RB_EmulateSuppressed(f.Input.data(), PortData, PortLen);
+  RB_Frames.push_back(std::move(f));
+  RB_Behind--;
+ }
+}
+
+static bool CommandAffectsEmulation(const uint8 cmd)
+{
+ switch(cmd)
+ {
+  case MDFNNPCMD_SERVERTEXT:
+  case MDFNNPCMD_ECHO:
+  case MDFNNPCMD_TEXT:
+  case MDFNNPCMD_NICKCHANGED:
+  case MDFNNPCMD_CTRLR_SWAP_NOTIF:
+  case MDFNNPCMD_CTRLR_TAKE_NOTIF:
+  case MDFNNPCMD_CTRLR_DROP_NOTIF:
+  case MDFNNPCMD_CTRLR_DUPE_NOTIF:
+  case MDFNNPCMD_YOUJOINED:
+  case MDFNNPCMD_YOULEFT:
+  case MDFNNPCMD_PLAYERLEFT:
+  case MDFNNPCMD_PLAYERJOINED:
+	return false;
+ }
+
+ return true;
+}
+
+static void RB_ReceiveOne(const uint32 PortDevIdx[], uint8* const PortData[], const uint32 PortLen[], const unsigned NumPorts)
+{
+ RecvData(&incoming_buffer[0], TotalInputStateSize + 1);
+
+ const uint8 cmd = incoming_buffer[TotalInputStateSize];
+
+ if(cmd != 0)
+ {
+  //
+  // Commands apply between the frames the server sent before and after them, so get the emulation state there first.
+  //
+  if(CommandAffectsEmulation(cmd))
+  {
+   RB_Rewind();
+
+   while(RB_Ahead.size())
+   {
+    RB_EmulateSuppressed(RB_Ahead.front().data(), PortData, PortLen);
+    RB_Ahead.pop_front();
+   }
+  }
+
+  ProcessCommand(cmd, MDFN_de32lsb(&incoming_buffer[0]), PortDevIdx, PortData, PortLen, NumPorts);
+ }
+ else
+  RB_ProcessInput(&incoming_buffer[0], PortData, PortLen);
+}
+
+static void RB_Update(const uint32 PortDevIdx[], uint8* const PortData[], const uint32 PortLen[], const unsigned NumPorts)
+{
+ if(Joined)
+  SendLocalInput(PortData, PortLen);
+ //
+ //
+ //
+ PumpIncoming();
+
+ while(IncomingAvail() >= (TotalInputStateSize + 1))
+  RB_ReceiveOne(PortDevIdx, PortData, PortLen, NumPorts);
+
+ RB_CatchUp(PortData, PortLen);
+
+ if(!RB_Ahead.size() && RB_Frames.size() >= RB_MaxFrames)
+ {
+  RB_Stats.Stalls++;
+
+  do
+  {
+   RB_ReceiveOne(PortDevIdx, PortData, PortLen, NumPorts);
+   RB_CatchUp(PortData, PortLen);
+  } while(!RB_Ahead.size() && RB_Frames.size() >= RB_MaxFrames);
+ }
+ //
+ //
+ //
+ RB_Stats.Frames++;
+
+ if(RB_Ahead.size())
+ {
+  RB_SetPortData(RB_Ahead.front().data(), PortData, PortLen);
+  RB_Ahead.pop_front();
+ }
+ else
+ {
+  RB_Frame f;
+
+  RB_Predict(&f.Input, RB_Frames.size(), PortLen);
+  f.State = RB_SaveState();
+  RB_SetPortData(f.Input.data(), PortData, PortLen);
+  RB_Frames.push_back(std::move(f));
+  RB_Stats.PredictedFrames++;
+ }
+}
+
+static void RB_PrintStats(void)
+{
+ if(!RB_Enabled || !RB_Stats.Frames)
+  return;
+
+ NetPrintText(_("*** Rollback: %llu frames, %llu predicted, %llu rollbacks, %llu stalls; %llu frames re-emulated, averaging %.2f us each."),
+	(unsigned long long)RB_Stats.Frames, (unsigned long long)RB_Stats.PredictedFrames, (unsigned long long)RB_Stats.Rollbacks, (unsigned long long)RB_Stats.Stalls,
+	(unsigned long long)RB_Stats.ResimFrames, RB_Stats.ResimFrames ? (double)RB_Stats.ResimTime / RB_Stats.ResimFrames : 0.0);
+}
+
+void Netplay_Update(const uint32 PortDevIdx[], uint8* const PortData[], const uint32 PortLen[], EmulateSpecStruct* espec)
 {
  const unsigned NumPorts = MDFNGameInfo->PortInfo.size();
 
@@ -1060,24 +1463,16 @@ void Netplay_Update(const uint32 PortDevIdx[], uint8* const PortData[], const ui
    memcpy(PreNPPortDataPortData[x].data(), PortData[x], PortLen[x]);
   }
 
-  if(Joined)
+  if(RB_Enabled)
   {
-   outgoing_buffer[0] = 0; 	// Not a command
-
-   for(unsigned x = 0, wpos = 1; x < NumPorts; x++)
-   {
-    if(!PortLen[x])
-     continue;
-
-    auto n = PortVtoLVMap[x];
-    if(n != 0xFF)
-    {
-     memcpy(&outgoing_buffer[wpos], PortData[n], PortLen[n]);
-     wpos += PortLen[n];
-    }
-   }
-   SendData(&outgoing_buffer[0], 1 + LocalInputStateSize);
+   RB_espec = espec;
+   RB_Update(PortDevIdx, PortData, PortLen, NumPorts);
+   RB_espec = nullptr;
+   return;
   }
+
+  if(Joined)
+   SendLocalInput(PortData, PortLen);
   //
   //
   //
@@ -1098,11 +1493,7 @@ void Netplay_Update(const uint32 PortDevIdx[], uint8* const PortData[], const ui
   //
   // Update local port data buffers with data received.
   //
-  for(unsigned x = 0, rpos = 0; x < NumPorts; x++)
-  {
-   memcpy(PortData[x], &incoming_buffer[rpos], PortLen[x]);
-   rpos += PortLen[x];
-  }
+  RB_SetPortData(&incoming_buffer[0], PortData, PortLen);
  }
  catch(std::exception &e)
  {
@@ -1110,6 +1501,11 @@ void Netplay_Update(const uint32 PortDevIdx[], uint8* const PortData[], const ui
  }
 }
 
+bool Netplay_IsRollback(void)
+{
+ return MDFNnetplay && RB_Enabled;
+}
+
 void Netplay_PostProcess(const uint32 PortDevIdx[], uint8* const PortData[], const uint32 PortLen[])
 {
  const unsigned NumPorts = MDFNGameInfo->PortInfo.size();
@@ -1217,9 +1613,17 @@ void MDFNI_NetplayDisconnect(void)
 {
  const bool had_connection = Connection != nullptr;
  Connection.reset(nullptr);
+ IncomingQueue.clear();
 
  if(MDFNnetplay)
  {
+  RB_PrintStats();
+  RB_Frames.clear();
+  RB_Ahead.clear();
+  RB_Sent.clear();
+  RB_StatePool.clear();
+  RB_Behind = 0;
+
   Joined = false;
   MDFNnetplay = 0;
   MDFN_FlushGameCheats(1);	/* Don't save netplay cheats. */
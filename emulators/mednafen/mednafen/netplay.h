@@ -4,8 +4,9 @@
 namespace Mednafen
 {
 
-void Netplay_Update(const uint32 PortDeviceCache[], uint8* const PortData[], const uint32 PortLen[]);
+void Netplay_Update(const uint32 PortDeviceCache[], uint8* const PortData[], const uint32 PortLen[], EmulateSpecStruct* espec);
 void Netplay_PostProcess(const uint32 PortDevIdx[], uint8* const PortData[], const uint32 PortLen[]);
+bool Netplay_IsRollback(void);
 
 void NetplaySendState(void);
 bool NetplaySendCommand(uint8, uint32, const void* data = NULL);
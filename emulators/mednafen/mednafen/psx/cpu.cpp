@@ -59,6 +59,18 @@ PS_CPU::PS_CPU()
  CPUHook = NULL;
  ADDBT = NULL;
 
+ BlockCacheEnabled = false;
+ BlockRAM = NULL;
+ BlockBIOS = NULL;
+ BlockCount = 0;
+ BlockOpCount = 0;
+ memset(BlockPageHasCode, 0, sizeof(BlockPageHasCode));
+ ICacheEpoch = 0;
+ BlockBreak = false;
+ BlockChecked = false;
+ BlockPage = 0;
+ InstructionCount = 0;
+
  GTE_Init();
 
  for(unsigned i = 0; i < 24; i++)
@@ -150,6 +162,8 @@ void PS_CPU::Power(void)
   ICache[i].TV = 0x2 | ((BIU & 0x800) ? 0x0 : 0x1);
   ICache[i].Data = 0;
  }
+ ICacheEpoch++;
+ InvalidateAllBlocks();
 
  GTE_Power();
 }
@@ -217,6 +231,9 @@ void PS_CPU::StateAction(StateMem *sm, const unsigned load, const bool data_only
   ReadAbsorbWhich &= 0x1F;
   BACKED_LDWhich %= 0x21;
 
+  ICacheEpoch++;
+  InvalidateAllBlocks();
+
   //printf("PC=0x%08x, new_PC=0x%08x, BDBT=0x%02x\n", BACKED_PC, BACKED_new_PC, BDBT);
  }
 }
@@ -251,6 +268,8 @@ void PS_CPU::SetBIU(uint32 val)
    for(unsigned i = 0; i < 1024; i++)
     ICache[i].TV |= 0x1;
   }
+  ICacheEpoch++;
+  InvalidateAllBlocks();
  }
 
  PSX_DBG(PSX_DBG_SPARSE, "[CPU] Set BIU=0x%08x\n", BIU);
@@ -435,6 +454,8 @@ INLINE void PS_CPU::WriteMemory(pscpu_timestamp_t &timestamp, uint32 address, ui
    {
     ICache[(address & 0xFFC) >> 2].Data = value << ((address & 0x3) * 8);
    }
+   ICacheEpoch++;
+   BlockBreak = true;
   }
 
   if((BIU & 0x081) == 0x080)	// Writes to the scratchpad(TODO test)
@@ -496,6 +517,7 @@ INLINE uint32 PS_CPU::ReadInstruction(pscpu_timestamp_t &timestamp, uint32 addre
    ICI[0x03].TV = (address & 0xFFFFFFF0) | 0xC | 0x2;
 
    timestamp += 3;
+   ICacheEpoch++;
 
    switch(address & 0xC)
    {
@@ -524,6 +546,177 @@ INLINE uint32 PS_CPU::ReadInstruction(pscpu_timestamp_t &timestamp, uint32 addre
  return instr;
 }
 
+void PS_CPU::SetBlockCache(bool enable, const uint8* ram, const uint8* bios)
+{
+ BlockCacheEnabled = enable;
+ BlockRAM = ram;
+ BlockBIOS = bios;
+
+ if(enable && !BlockTable)
+ {
+  BlockTable.reset(new uint32[BLOCK_WORDS]);
+  Blocks.reset(new Block[BLOCK_POOL_OPS / 4]);
+  BlockOps.reset(new BlockOp[BLOCK_POOL_OPS]);
+
+  memset(BlockTable.get(), 0, sizeof(uint32) * BLOCK_WORDS);
+  memset(BlockPageHasCode, 0, sizeof(BlockPageHasCode));
+  BlockCount = 0;
+  BlockOpCount = 0;
+ }
+
+ InvalidateAllBlocks();
+}
+
+//
+// The ops of dropped blocks stay intact until the pool is reset by BuildBlock(), so the block being run can still be
+// finished after its page has been written to; it's checked against the I-cache, not RAM.
+//
+void PS_CPU::InvalidateBlockPage(uint32 page)
+{
+ memset(&BlockTable[page << (BLOCK_PAGE_SHIFT - 2)], 0, sizeof(uint32) << (BLOCK_PAGE_SHIFT - 2));
+ BlockPageHasCode[page] = false;
+}
+
+void PS_CPU::InvalidateAllBlocks(void)
+{
+ BlockBreak = true;
+
+ if(!BlockTable)
+  return;
+
+ for(uint32 page = 0; page < BLOCK_PAGES; page++)
+ {
+  if(BlockPageHasCode[page])
+   InvalidateBlockPage(page);
+ }
+
+ BlockCount = 0;
+ BlockOpCount = 0;
+}
+
+PS_CPU::Block* PS_CPU::BuildBlock(uint32 word, const uint8* p)
+{
+ const uint32 page = word >> (BLOCK_PAGE_SHIFT - 2);
+ const uint32 page_end = (page + 1) << (BLOCK_PAGE_SHIFT - 2);
+
+ if(BlockCount == (BLOCK_POOL_OPS / 4) || (BlockOpCount + BLOCK_MAX_LENGTH) > BLOCK_POOL_OPS)
+  InvalidateAllBlocks();
+
+ Block* b = &Blocks[BlockCount];
+ BlockOp* ops = &BlockOps[BlockOpCount];
+ uint32 length = 0;
+ bool delay_slot = false;
+
+ while(length < BLOCK_MAX_LENGTH && (word + length) < page_end)
+ {
+  const uint32 instr = MDFN_de32lsb<true>(p + (length << 2));
+  const uint32 opf = DecodeOPF(instr);
+
+  ops[length].instr = instr;
+  ops[length].opf = opf;
+  ops[length].last = false;
+  length++;
+
+  if(delay_slot)
+   break;
+
+  // JR, JALR, BCOND, J, JAL, BEQ, BNE, BLEZ, BGTZ
+  delay_slot = (opf == 0x08 || opf == 0x09 || (opf >= 0x41 && opf <= 0x47));
+ }
+ ops[length - 1].last = true;
+
+ b->verified_pc = 1;
+ b->verified_epoch = 0;
+ b->length = length;
+ b->ops = ops;
+
+ BlockCount++;
+ BlockOpCount += length;
+ BlockTable[word] = BlockCount;
+ BlockPageHasCode[page] = true;
+
+ return b;
+}
+
+//
+// Returns NULL if there's no block for PC, in which case the instruction at PC is fetched and decoded as usual.
+//
+INLINE const PS_CPU::BlockOp* PS_CPU::LookupBlock(uint32 PC)
+{
+ const uintptr_t p = FastMap[PC >> FAST_MAP_SHIFT] + PC;
+
+ if(MDFN_LIKELY((p - (uintptr_t)BlockRAM) < (2048 * 1024) && !(PC & 0x3)))
+ {
+  const uint32 word = (p - (uintptr_t)BlockRAM) >> 2;
+  const uint32 bi = BlockTable[word];
+
+  if(MDFN_LIKELY(bi))
+  {
+   const Block* const b = &Blocks[bi - 1];
+
+   if(MDFN_LIKELY(b->verified_pc == PC && b->verified_epoch == ICacheEpoch))
+   {
+    BlockChecked = false;
+    BlockPage = word >> (BLOCK_PAGE_SHIFT - 2);
+
+    return b->ops;
+   }
+  }
+ }
+
+ return EnterBlock(PC);
+}
+
+const PS_CPU::BlockOp* NO_INLINE PS_CPU::EnterBlock(uint32 PC)
+{
+ const uintptr_t p = FastMap[PC >> FAST_MAP_SHIFT] + PC;
+ uint32 word;
+ Block* b;
+
+ if(PC & 0x3)
+  return NULL;
+
+ if((p - (uintptr_t)BlockRAM) < (2048 * 1024))
+  word = (p - (uintptr_t)BlockRAM) >> 2;
+ else if((p - (uintptr_t)BlockBIOS) < (512 * 1024))
+  word = BLOCK_RAM_WORDS + ((p - (uintptr_t)BlockBIOS) >> 2);
+ else
+  return NULL;
+
+ if(BlockTable[word])
+  b = &Blocks[BlockTable[word] - 1];
+ else
+  b = BuildBlock(word, (const uint8*)p);
+
+ if(b->verified_pc != PC || b->verified_epoch != ICacheEpoch)
+ {
+  uint32 i;
+
+  for(i = 0; i < b->length; i++)
+  {
+   const uint32 address = PC + (i << 2);
+   const __ICache* const ICI = &ICache[(address & 0xFFC) >> 2];
+
+   if(ICI->TV != address || ICI->Data != b->ops[i].instr)
+    break;
+  }
+
+  BlockChecked = (i != b->length);
+
+  if(!BlockChecked)
+  {
+   b->verified_pc = PC;
+   b->verified_epoch = ICacheEpoch;
+  }
+ }
+ else
+  BlockChecked = false;
+
+ BlockPage = word >> (BLOCK_PAGE_SHIFT - 2);
+
+ return b->ops;
+}
+
 uint32 NO_INLINE PS_CPU::Exception(uint32 code, uint32 PC, const uint32 NP, const uint32 instr)
 {
  uint32 handler = 0x80000080;
@@ -594,10 +787,14 @@ uint32 NO_INLINE PS_CPU::Exception(uint32 code, uint32 PC, const uint32 NP, cons
 #define GPR_RES(n) { unsigned tn = (n); ReadAbsorb[tn] = 0; }
 #define GPR_DEPRES_END ReadAbsorb[0] = back; }
 
-template<bool DebugMode, bool BIOSPrintMode, bool ILHMode>
+template<bool DebugMode, bool BIOSPrintMode, bool ILHMode, bool BlockMode>
 pscpu_timestamp_t PS_CPU::RunReal(pscpu_timestamp_t timestamp_in)
 {
  pscpu_timestamp_t timestamp = timestamp_in;
+ uint32 icount = 0;
+ const BlockOp* bop = NULL;
+ uint32 bop_pc = 1;	// Address of *bop when running a block without fetching, otherwise 1(which no aligned PC can match).
+ uint32 chk_pc = 1;	// Address of *bop when running a block word by word, otherwise 1.
 
  uint32 PC;
  uint32 new_PC;
@@ -653,25 +850,70 @@ pscpu_timestamp_t PS_CPU::RunReal(pscpu_timestamp_t timestamp_in)
    //
    // Instruction fetch
    //
-   if(MDFN_UNLIKELY(PC & 0x3))
+   FetchBlockOp:
+   if(BlockMode && MDFN_LIKELY(PC == bop_pc))
    {
-    // This will block interrupt processing, but since we're going more for keeping broken homebrew/hacks from working
-    // than super-duper-accurate pipeline emulation, it shouldn't be a problem.
-    CP0.BADA = PC;
-    new_PC = Exception(EXCEPTION_ADEL, PC, new_PC, 0);
-    goto OpDone;
+    // Verified as an I-cache hit on block entry, so the fetch costs nothing.
+    instr = bop->instr;
+    opf = bop->opf;
+    bop_pc = bop->last ? 1 : PC + 4;
+    bop++;
    }
+   else if(BlockMode && PC == chk_pc)
+   {
+    instr = ReadInstruction(timestamp, PC);
+    chk_pc = bop->last ? 1 : PC + 4;
 
-   instr = ReadInstruction(timestamp, PC);
+    if(MDFN_UNLIKELY(instr != bop->instr))
+    {
+     InvalidateBlockPage(BlockPage);
+     chk_pc = 1;
+     opf = DecodeOPF(instr);
+    }
+    else
+     opf = bop->opf;
+
+    bop++;
+   }
+   else
+   {
+    if(BlockMode)
+    {
+     bop_pc = 1;
+     chk_pc = 1;
 
+     if((bop = LookupBlock(PC)))
+     {
+      if(BlockChecked)
+       chk_pc = PC;
+      else
+       bop_pc = PC;
 
-   // 
-   // Instruction decode
-   //
-   opf = instr & 0x3F;
+      goto FetchBlockOp;
+     }
+    }
+
+    if(MDFN_UNLIKELY(PC & 0x3))
+    {
+     // This will block interrupt processing, but since we're going more for keeping broken homebrew/hacks from working
+     // than super-duper-accurate pipeline emulation, it shouldn't be a problem.
+     CP0.BADA = PC;
+     new_PC = Exception(EXCEPTION_ADEL, PC, new_PC, 0);
+     goto OpDone;
+    }
+
+    instr = ReadInstruction(timestamp, PC);
+
+
+    // 
+    // Instruction decode
+    //
+    opf = instr & 0x3F;
 
-   if(instr & (0x3F << 26))
-    opf = 0x40 | (instr >> 26);
+    if(instr & (0x3F << 26))
+     opf = 0x40 | (instr >> 26);
+   }
+   icount++;
 
    opf |= IPCache;
 
@@ -680,6 +922,8 @@ pscpu_timestamp_t PS_CPU::RunReal(pscpu_timestamp_t timestamp_in)
    else
     timestamp++;
 
+   // Isolated-cache writes and BIU changes made by a store can alter the I-cache, which the rest of the block was verified against.
+   #define BLOCK_STORE_CHECK() { if(BlockMode && MDFN_UNLIKELY(BlockBreak)) { BlockBreak = false; bop_pc = 1; chk_pc = 1; } }
    #define DO_LDS() { GPR[LDWhich] = LDValue; ReadAbsorb[LDWhich] = LDAbsorb; ReadFudge = LDWhich; ReadAbsorbWhich |= LDWhich & 0x1F; LDWhich = 0x20; }
    #define BEGIN_OPF(name) { op_##name:
    #define END_OPF goto OpDone; }
@@ -1399,6 +1643,7 @@ pscpu_timestamp_t PS_CPU::RunReal(pscpu_timestamp_t timestamp_in)
 
 	 WriteMemory<uint32>(timestamp, address, GTE_ReadDR(rt));
 	}
+	BLOCK_STORE_CHECK();
 	DO_LDS();
     END_OPF;
 
@@ -2199,6 +2444,7 @@ pscpu_timestamp_t PS_CPU::RunReal(pscpu_timestamp_t timestamp_in)
 	uint32 address = GPR[rs] + immediate;
 
 	WriteMemory<uint8>(timestamp, address, GPR[rt]);
+	BLOCK_STORE_CHECK();
 
 	DO_LDS();
     END_OPF;
@@ -2223,6 +2469,7 @@ pscpu_timestamp_t PS_CPU::RunReal(pscpu_timestamp_t timestamp_in)
 	}
 	else
 	 WriteMemory<uint16>(timestamp, address, GPR[rt]);
+	BLOCK_STORE_CHECK();
 
 	DO_LDS();
     END_OPF;
@@ -2247,6 +2494,7 @@ pscpu_timestamp_t PS_CPU::RunReal(pscpu_timestamp_t timestamp_in)
 	}
 	else
 	 WriteMemory<uint32>(timestamp, address, GPR[rt]);
+	BLOCK_STORE_CHECK();
 
 	DO_LDS();
     END_OPF;
@@ -2321,6 +2569,7 @@ pscpu_timestamp_t PS_CPU::RunReal(pscpu_timestamp_t timestamp_in)
 	 case 3: WriteMemory<uint32>(timestamp, address & ~3, GPR[rt] >> 0);
 		 break;
 	}
+	BLOCK_STORE_CHECK();
 	DO_LDS();
 
     END_OPF;
@@ -2393,6 +2642,7 @@ pscpu_timestamp_t PS_CPU::RunReal(pscpu_timestamp_t timestamp_in)
 	 case 3: WriteMemory<uint8>(timestamp, address, GPR[rt]);
 		 break;
 	}
+	BLOCK_STORE_CHECK();
 
 	DO_LDS();
 
@@ -2434,23 +2684,32 @@ pscpu_timestamp_t PS_CPU::RunReal(pscpu_timestamp_t timestamp_in)
 
  ACTIVE_TO_BACKING;
 
+ InstructionCount += icount;
+
  return(timestamp);
 }
 
 pscpu_timestamp_t PS_CPU::Run(pscpu_timestamp_t timestamp_in, bool BIOSPrintMode, bool ILHMode)
 {
  if(CPUHook || ADDBT)
-  return(RunReal<true, true, false>(timestamp_in));
+  return(RunReal<true, true, false, false>(timestamp_in));
  else
  {
   if(ILHMode)
-   return(RunReal<false, false, true>(timestamp_in));
+  {
+   if(BlockCacheEnabled)
+    return(RunReal<false, false, true, true>(timestamp_in));
+   else
+    return(RunReal<false, false, true, false>(timestamp_in));
+  }
   else
   {
    if(BIOSPrintMode)
-    return(RunReal<false, true, false>(timestamp_in));
+    return(RunReal<false, true, false, false>(timestamp_in));
+   else if(BlockCacheEnabled)
+    return(RunReal<false, false, false, true>(timestamp_in));
    else
-    return(RunReal<false, false, false>(timestamp_in));
+    return(RunReal<false, false, false, false>(timestamp_in));
   }
  }
 }
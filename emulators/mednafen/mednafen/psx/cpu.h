@@ -98,6 +98,28 @@ class PS_CPU
 
  void StateAction(StateMem *sm, const unsigned load, const bool data_only);
 
+ //
+ // Basic-block cache("psx.cpu_mode" "cached").  Blocks are only built from main RAM and BIOS ROM; writes to main RAM
+ // must be reported via InvalidateRAMCode() so that blocks built from the written words are dropped.
+ //
+ void SetBlockCache(bool enable, const uint8* ram, const uint8* bios) MDFN_COLD;
+
+ INLINE void InvalidateRAMCode(uint32 ram_offset, uint32 len)
+ {
+  const uint32 fp = (ram_offset & 0x1FFFFF) >> BLOCK_PAGE_SHIFT;
+  const uint32 lp = ((ram_offset + len - 1) & 0x1FFFFF) >> BLOCK_PAGE_SHIFT;
+
+  if(MDFN_UNLIKELY(BlockPageHasCode[fp]))
+   InvalidateBlockPage(fp);
+
+  if(MDFN_UNLIKELY(BlockPageHasCode[lp]))
+   InvalidateBlockPage(lp);
+ }
+
+ void InvalidateAllBlocks(void);
+
+ INLINE uint64 GetInstructionCount(void) { return InstructionCount; }
+
  private:
 
  uint32 GPR[32 + 1];	// GPR[32] Used as dummy in load delay simulation(indexing past the end of real GPR)
@@ -220,7 +242,7 @@ class PS_CPU
 
  uint32 Exception(uint32 code, uint32 PC, const uint32 NP, const uint32 instr) MDFN_WARN_UNUSED_RESULT;
 
- template<bool DebugMode, bool BIOSPrintMode, bool ILHMode> NO_INLINE pscpu_timestamp_t RunReal(pscpu_timestamp_t timestamp_in);
+ template<bool DebugMode, bool BIOSPrintMode, bool ILHMode, bool BlockMode> NO_INLINE pscpu_timestamp_t RunReal(pscpu_timestamp_t timestamp_in);
 
  template<typename T> T PeekMemory(uint32 address) MDFN_COLD;
  template<typename T> void PokeMemory(uint32 address, T value) MDFN_COLD;
@@ -229,6 +251,72 @@ class PS_CPU
 
  uint32 ReadInstruction(pscpu_timestamp_t &timestamp, uint32 address);
 
+ //
+ // Basic-block cache.
+ //
+ // A block is a run of pre-decoded instruction words that ends with the delay slot of a branch or jump, at BLOCK_MAX_LENGTH
+ // instructions, or at the end of a BLOCK_PAGE_SHIFT-sized page of main RAM/BIOS ROM.  Blocks are looked up by the physical
+ // word they start at, so the KUSEG, KSEG0 and KSEG1 mirrors of the same code share a block.
+ //
+ // The instruction cache is still emulated: a block is only run without fetching("fast") after every one of its words has been
+ // verified to be an I-cache hit holding the word the block was built from, and only for as long as ICacheEpoch(bumped on every
+ // change to ICache[]) stays the same.  Otherwise each word is fetched with ReadInstruction() as usual("checked"), and a
+ // fetched word that doesn't match the block drops every block in its page.
+ //
+ enum { BLOCK_PAGE_SHIFT = 10 };
+ enum { BLOCK_MAX_LENGTH = 64 };
+ enum { BLOCK_RAM_WORDS = (2048 * 1024) >> 2 };
+ enum { BLOCK_WORDS = BLOCK_RAM_WORDS + ((512 * 1024) >> 2) };
+ enum { BLOCK_PAGES = BLOCK_WORDS >> (BLOCK_PAGE_SHIFT - 2) };
+ enum { BLOCK_POOL_OPS = 1 << 18 };
+
+ struct BlockOp
+ {
+  uint32 instr;
+  uint8 opf;	// Without IPCache.
+  bool last;
+ };
+
+ struct Block
+ {
+  uint32 verified_pc;		// Virtual address the block was last verified as fully cached at.
+  uint64 verified_epoch;	// ICacheEpoch at that time.
+  uint32 length;
+  BlockOp* ops;
+ };
+
+ bool BlockCacheEnabled;
+ const uint8* BlockRAM;
+ const uint8* BlockBIOS;
+ std::unique_ptr<uint32[]> BlockTable;	// Physical word -> index into Blocks[] plus 1, or 0.
+ std::unique_ptr<Block[]> Blocks;
+ std::unique_ptr<BlockOp[]> BlockOps;
+ uint32 BlockCount;
+ uint32 BlockOpCount;
+ uint8 BlockPageHasCode[BLOCK_PAGES];
+ uint64 ICacheEpoch;
+
+ bool BlockBreak;		// Set when the I-cache changed or all blocks were dropped, to make RunReal() look up the block again.
+ bool BlockChecked;		// The block returned by LookupBlock() has to be fetched word by word.
+ uint32 BlockPage;		// Page of the block returned by LookupBlock().
+
+ uint64 InstructionCount;
+
+ void InvalidateBlockPage(uint32 page);
+ const BlockOp* LookupBlock(uint32 PC);
+ const BlockOp* EnterBlock(uint32 PC) NO_INLINE;
+ Block* BuildBlock(uint32 word, const uint8* p);
+
+ static INLINE uint32 DecodeOPF(const uint32 instr)
+ {
+  uint32 opf = instr & 0x3F;
+
+  if(instr & (0x3F << 26))
+   opf = 0x40 | (instr >> 26);
+
+  return opf;
+ }
+
  //
  // Mednafen debugger stuff follows:
  //
@@ -437,7 +437,10 @@ static INLINE void RunChannelI(const unsigned ch, const uint32 CRModeCache, int3
    ChRW(ch, CRModeCache, &vtmp, &voffs);
 
    if(!(CRModeCache & 0x1))
+   {
     MainRAM.WriteU32((DMACH[ch].CurAddr + (voffs << 2)) & 0x1FFFFC, vtmp);
+    CPU->InvalidateRAMCode((DMACH[ch].CurAddr + (voffs << 2)) & 0x1FFFFC, 4);
+   }
   }
 
   if(CRModeCache & 0x2)
@@ -23,6 +23,7 @@
 
 #include "psx.h"
 #include "timer.h"
+#include "gpu_mt.h"
 
 /* FIXME: Respect horizontal timing register values in relation to hsync/hblank/hretrace/whatever signal sent to the timers */
 
@@ -74,7 +75,14 @@ namespace PS_GPU_INTERNAL
 }
 using namespace PS_GPU_INTERNAL;
 
-void GPU_Init(bool pal_clock_and_tv)
+static void SetCommandFunc(const unsigned cc, void (*func)(const uint32 *cb))
+{
+ for(auto& fg : Commands[cc].func)
+  for(auto& f : fg)
+   f = func;
+}
+
+void GPU_Init(bool pal_clock_and_tv, const unsigned renderer, const uint64 affinity)
 {
  static const int8 dither_table[4][4] =
  {
@@ -122,11 +130,57 @@ void GPU_Init(bool pal_clock_and_tv)
  memcpy(&Commands[0x40], Commands_40_5F, sizeof(Commands_40_5F));
  memcpy(&Commands[0x60], Commands_60_7F, sizeof(Commands_60_7F));
  memcpy(&Commands[0x80], Commands_80_FF, sizeof(Commands_80_FF));
+
+ RenderThreaded = (renderer == GPU_RENDERER_MT);
+
+ if(RenderThreaded)
+ {
+  memcpy(&Commands[0x20], Commands_20_3F_Timing, sizeof(Commands_20_3F_Timing));
+  memcpy(&Commands[0x40], Commands_40_5F_Timing, sizeof(Commands_40_5F_Timing));
+  memcpy(&Commands[0x60], Commands_60_7F_Timing, sizeof(Commands_60_7F_Timing));
+
+  SetCommandFunc(0x02, Command_FBFill_Timing);
+
+  for(unsigned cc = 0x80; cc < 0xA0; cc++)
+   SetCommandFunc(cc, Command_FBCopy_Timing);
+
+  MTIF_Init(affinity);
+ }
 }
 
 void GPU_Kill(void)
 {
+ if(RenderThreaded)
+ {
+  MTIF_Kill();
+  RenderThreaded = false;
+ }
+}
+
+void GPU_SyncRender(void)
+{
+ if(RenderThreaded)
+  MTIF_Sync();
+}
 
+// Drawing commands(FB fill, polygons, lines, sprites, FB copy) are the ones that get queued to the render thread.
+static INLINE bool IsDrawCommand(const uint32 cc)
+{
+ return cc == 0x02 || (cc >= 0x20 && cc <= 0x9F);
+}
+
+static INLINE void RunCommand(const uint32 cc, const uint32 *CB, const unsigned len)
+{
+ const CTEntry *command = &Commands[cc];
+
+ if(RenderThreaded && IsDrawCommand(cc))
+ {
+  MTIF_Draw(cc, CB, len);
+  command->func[abr][TexMode | (MaskEvalAND ? 0x4 : 0x0)](CB);
+  MTIF_DrawDone();
+ }
+ else
+  command->func[abr][TexMode | (MaskEvalAND ? 0x4 : 0x0)](CB);
 }
 
 /*
@@ -206,12 +260,6 @@ void GPU_SetGetVideoParams(MDFNGI* gi, const bool caspect, const int sls, const
  }
 }
 
-static INLINE void InvalidateTexCache(void)
-{
- for(auto& c : TexCache)
-  c.Tag = ~0U;
-}
-
 static void InvalidateCache(void)
 {
  CLUT_Cache_VB = ~0U;
@@ -289,6 +337,8 @@ static void SoftReset(void) // Control command 0x00
 
 void GPU_Power(void)
 {
+ GPU_SyncRender();
+
  memset(GPURAM, 0, sizeof(GPURAM));
 
  memset(CLUT_Cache, 0, sizeof(CLUT_Cache));
@@ -385,6 +435,9 @@ void GPU_Power(void)
 
  IRQ_Assert(IRQ_VBLANK, InVBlank);
  TIMER_SetVBlank(InVBlank);
+
+ if(RenderThreaded)
+  MTIF_Reset();
 }
 
 void GPU_ResetTS(void)
@@ -392,89 +445,6 @@ void GPU_ResetTS(void)
  lastts = 0;
 }
 
-// Special RAM write mode(16 pixels at a time), does *not* appear to use mask drawing environment settings.
-static void Command_FBFill(const uint32 *cb)
-{
- int32 r = cb[0] & 0xFF;
- int32 g = (cb[0] >> 8) & 0xFF;
- int32 b = (cb[0] >> 16) & 0xFF;
- const uint16 fill_value = ((r >> 3) << 0) | ((g >> 3) << 5) | ((b >> 3) << 10);
-
- int32 destX = (cb[1] >>  0) & 0x3F0;
- int32 destY = (cb[1] >> 16) & 0x3FF;
-
- int32 width =  (((cb[2] >> 0) & 0x3FF) + 0xF) & ~0xF;
- int32 height = (cb[2] >> 16) & 0x1FF;
-
- //printf("[GPU] FB Fill %d:%d w=%d, h=%d\n", destX, destY, width, height);
- DrawTimeAvail -= 46;	// Approximate
-
- for(int32 y = 0; y < height; y++)
- {
-  const int32 d_y = (y + destY) & 511;
-
-  if(LineSkipTest(d_y))
-   continue;
-
-  DrawTimeAvail -= (width >> 3) + 9;
-
-  for(int32 x = 0; x < width; x++)
-  {
-   const int32 d_x = (x + destX) & 1023;
-
-   GPURAM[d_y][d_x] = fill_value;
-  }
- }
-}
-
-static void Command_FBCopy(const uint32 *cb)
-{
- int32 sourceX = (cb[1] >> 0) & 0x3FF;
- int32 sourceY = (cb[1] >> 16) & 0x3FF;
- int32 destX = (cb[2] >> 0) & 0x3FF;
- int32 destY = (cb[2] >> 16) & 0x3FF;
-
- int32 width = (cb[3] >> 0) & 0x3FF;
- int32 height = (cb[3] >> 16) & 0x1FF;
-
- if(!width)
-  width = 0x400;
-
- if(!height)
-  height = 0x200;
-
- InvalidateTexCache();
- //printf("FB Copy: %d %d %d %d %d %d\n", sourceX, sourceY, destX, destY, width, height);
-
- DrawTimeAvail -= (width * height) * 2;
-
- for(int32 y = 0; y < height; y++)
- {
-  for(int32 x = 0; x < width; x += 128)
-  {
-   const int32 chunk_x_max = std::min<int32>(width - x, 128);
-   uint16 tmpbuf[128];	// TODO: Check and see if the GPU is actually (ab)using the texture cache(doesn't seem to be affecting CLUT cache...).
-
-   for(int32 chunk_x = 0; chunk_x < chunk_x_max; chunk_x++)
-   {
-    int32 s_y = (y + sourceY) & 511;
-    int32 s_x = (x + chunk_x + sourceX) & 1023;
-
-    tmpbuf[chunk_x] = GPURAM[s_y][s_x];
-   }
-
-   for(int32 chunk_x = 0; chunk_x < chunk_x_max; chunk_x++)
-   {
-    int32 d_y = (y + destY) & 511;
-    int32 d_x = (x + chunk_x + destX) & 1023;
-
-    if(!(GPURAM[d_y][d_x] & MaskEvalAND))
-     GPURAM[d_y][d_x] = tmpbuf[chunk_x] | MaskSetOR;
-   }
-  }
- }
-}
-
 static void Command_FBWrite(const uint32 *cb)
 {
  assert(InCmd == PS_GPU::INCMD_NONE);
@@ -497,7 +467,12 @@ static void Command_FBWrite(const uint32 *cb)
  InvalidateTexCache();
 
  if(FBRW_W != 0 && FBRW_H != 0)
+ {
   InCmd = PS_GPU::INCMD_FBWRITE;
+
+  if(RenderThreaded)
+   MTIF_FBWriteBegin();
+ }
 }
 
 //
@@ -508,6 +483,9 @@ static void Command_FBRead(const uint32 *cb)
 {
  assert(InCmd == PS_GPU::INCMD_NONE);
 
+ // ReadData() reads GPU RAM directly.
+ GPU_SyncRender();
+
  FBRW_X = (cb[1] >>  0) & 0x3FF;
  FBRW_Y = (cb[1] >> 16) & 0x3FF;
 
@@ -707,24 +685,11 @@ static void ProcessFIFO(void)
        {
   	uint32 InData = BlitterFIFO.Read();
 
-  	for(int i = 0; i < 2; i++)
-  	{
-   	 if(!(GPURAM[FBRW_CurY & 511][FBRW_CurX & 1023] & MaskEvalAND))
-    	  GPURAM[FBRW_CurY & 511][FBRW_CurX & 1023] = InData | MaskSetOR;
+	if(RenderThreaded)
+	 MTIF_FBWriteData(InData);
 
-	 FBRW_CurX++;
-   	 if(FBRW_CurX == (FBRW_X + FBRW_W))
-	 {
-	  FBRW_CurX = FBRW_X;
-	  FBRW_CurY++;
-	  if(FBRW_CurY == (FBRW_Y + FBRW_H))
-	  {
-	   InCmd = PS_GPU::INCMD_NONE;
-	   break;	// Break out of the for() loop.
-	  }
-	 }
-	 InData >>= 16;
-  	}
+	if(!FBWrite_Data(InData, !RenderThreaded))
+	 InCmd = PS_GPU::INCMD_NONE;
   	return;
        }
        break;
@@ -735,7 +700,6 @@ static void ProcessFIFO(void)
 	 return;
 
 	const uint32 cc = InCmd_CC;
-	const CTEntry *command = &Commands[cc];
 	unsigned vl = 1 + (bool)(cc & 0x4) + (bool)(cc & 0x10);
 	uint32 CB[3];
 
@@ -746,7 +710,7 @@ static void ProcessFIFO(void)
 	  CB[i] = BlitterFIFO.Read();
 	 }
 
-	 command->func[abr][TexMode | (MaskEvalAND ? 0x4 : 0x0)](CB);
+	 RunCommand(cc, CB, vl);
 	}
 	return;
        }
@@ -758,7 +722,6 @@ static void ProcessFIFO(void)
 	 return;
 
 	const uint32 cc = InCmd_CC;
-	const CTEntry *command = &Commands[cc];
 	unsigned vl = 1 + (bool)(InCmd_CC & 0x10);
 	uint32 CB[2];
 
@@ -776,7 +739,7 @@ static void ProcessFIFO(void)
 	  CB[i] = BlitterFIFO.Read();
 	 }
 
-	 command->func[abr][TexMode | (MaskEvalAND ? 0x4 : 0x0)](CB);
+	 RunCommand(cc, CB, vl);
 	}
 	return;
        }
@@ -825,7 +788,7 @@ static void ProcessFIFO(void)
   }
   else
   {
-   command->func[abr][TexMode | (MaskEvalAND ? 0x4 : 0x0)](CB);
+   RunCommand(cc, CB, command->len);
   }
  }
 }
@@ -1115,6 +1078,49 @@ static NO_INLINE void ReorderRGB(bool bpp24, const uint16 *src, uint32 *dest, co
 }
 #pragma GCC pop_options
 
+namespace PS_GPU_INTERNAL
+{
+void DrawScanoutLine(const ScanoutLine& sl)
+{
+ const uint32 black = surface->MakeColor(0, 0, 0);
+ const uint16 *src = GPURAM[sl.src_y];
+ uint32 *dest = sl.dest;
+
+ for(int32 x = 0; x < sl.dx_start; x++)
+  dest[x] = black;
+
+ //printf("%d %d %d - %d %d\n", scanline, dx_start, dx_end, HorizStart, HorizEnd);
+ if(surface->format.Rshift == 0 && surface->format.Gshift == 8 && surface->format.Bshift == 16)
+  ReorderRGB<0, 8, 16>(sl.bpp24, src, dest, sl.dx_start, sl.dx_end, sl.fb_x);
+ else if(surface->format.Rshift == 8 && surface->format.Gshift == 16 && surface->format.Bshift == 24)
+  ReorderRGB<8, 16, 24>(sl.bpp24, src, dest, sl.dx_start, sl.dx_end, sl.fb_x);
+ else if(surface->format.Rshift == 16 && surface->format.Gshift == 8 && surface->format.Bshift == 0)
+  ReorderRGB<16, 8, 0>(sl.bpp24, src, dest, sl.dx_start, sl.dx_end, sl.fb_x);
+ else if(surface->format.Rshift == 24 && surface->format.Gshift == 16 && surface->format.Bshift == 8)
+  ReorderRGB<24, 16, 8>(sl.bpp24, src, dest, sl.dx_start, sl.dx_end, sl.fb_x);
+ else
+  ReorderRGB_Var(surface->format.Rshift, surface->format.Gshift, surface->format.Bshift, sl.bpp24, src, dest, sl.dx_start, sl.dx_end, sl.fb_x);
+
+ for(int32 x = sl.dx_end; x < sl.dmw; x++)
+  dest[x] = black;
+}
+
+void PadScanoutLine(const ScanoutLine& sl)
+{
+ const uint32 black = surface->MakeColor(0, 0, 0);
+ uint32 *dest = sl.nca_dest;
+
+ if(!dest)
+  return;
+
+ for(int32 x = 0; x < sl.nca_dest_adj; x++)
+  dest[x] = black; //rand();
+
+ for(int32 x = sl.nca_dest_adj + sl.lw; x < sl.nca_lw; x++)
+  dest[x] = black; //rand();
+}
+}
+
 MDFN_FASTCALL pscpu_timestamp_t GPU_Update(const pscpu_timestamp_t sys_timestamp)
 {
  const uint32 dmc = (DisplayMode & 0x40) ? 4 : (DisplayMode & 0x3);
@@ -1247,6 +1253,8 @@ MDFN_FASTCALL pscpu_timestamp_t GPU_Update(const pscpu_timestamp_t sys_timestamp
 
      if(espec)
      {
+      GPU_SyncRender();	// Lines queued before scanline 0 wrapped around may not have been drawn to the surface yet.
+
       if((bool)(DisplayMode & 0x08) != HardwarePALType)
       {
        const uint32 black = surface->MakeColor(0, 0, 0);
@@ -1361,7 +1369,8 @@ MDFN_FASTCALL pscpu_timestamp_t GPU_Update(const pscpu_timestamp_t sys_timestamp
 
     if((bool)(DisplayMode & 0x08) == HardwarePALType && scanline >= FirstVisibleLine && scanline < (FirstVisibleLine + VisibleLineCount) && !skip && espec)
     {
-     const uint32 black = surface->MakeColor(0, 0, 0);
+     const bool queue_line = RenderThreaded && !SyncLines;
+     ScanoutLine sl;
      uint32 *dest;
      int32 dest_line;
      int32 fb_x = DisplayFB_XStart * 2;
@@ -1406,26 +1415,27 @@ MDFN_FASTCALL pscpu_timestamp_t GPU_Update(const pscpu_timestamp_t sys_timestamp
       dest += nca_dest_adj;
      }
 
-     {
-      const uint16 *src = GPURAM[DisplayFB_CurLineYReadout];
-
-      for(int32 x = 0; x < dx_start; x++)
-       dest[x] = black;
-
-      //printf("%d %d %d - %d %d\n", scanline, dx_start, dx_end, HorizStart, HorizEnd);
-      if(surface->format.Rshift == 0 && surface->format.Gshift == 8 && surface->format.Bshift == 16)
-       ReorderRGB<0, 8, 16>(DisplayMode & 0x10, src, dest, dx_start, dx_end, fb_x);
-      else if(surface->format.Rshift == 8 && surface->format.Gshift == 16 && surface->format.Bshift == 24)
-       ReorderRGB<8, 16, 24>(DisplayMode & 0x10, src, dest, dx_start, dx_end, fb_x);
-      else if(surface->format.Rshift == 16 && surface->format.Gshift == 8 && surface->format.Bshift == 0)
-       ReorderRGB<16, 8, 0>(DisplayMode & 0x10, src, dest, dx_start, dx_end, fb_x);
-      else if(surface->format.Rshift == 24 && surface->format.Gshift == 16 && surface->format.Bshift == 8)
-       ReorderRGB<24, 16, 8>(DisplayMode & 0x10, src, dest, dx_start, dx_end, fb_x);
-      else
-       ReorderRGB_Var(surface->format.Rshift, surface->format.Gshift, surface->format.Bshift, DisplayMode & 0x10, src, dest, dx_start, dx_end, fb_x);
+     sl.dest = dest;
+     sl.nca_dest = CorrectAspect ? NULL : surface->pixels + drxbo + dest_line * surface->pitch32;
+     sl.dx_start = dx_start;
+     sl.dx_end = dx_end;
+     sl.dmw = dmw;
+     sl.fb_x = fb_x;
+     sl.lw = LineWidths[dest_line];
+     sl.nca_lw = nca_lw;
+     sl.nca_dest_adj = nca_dest_adj;
+     sl.src_y = DisplayFB_CurLineYReadout;
+     sl.bpp24 = DisplayMode & 0x10;
 
-      for(uint32 x = dx_end; x < dmw; x++)
-       dest[x] = black;
+     //
+     // Light guns need to see the line's pixels from PSX_GPULineHook(), so only queue the line when none are connected.
+     //
+     if(queue_line)
+      MTIF_ScanoutLine(sl);
+     else
+     {
+      GPU_SyncRender();
+      DrawScanoutLine(sl);
      }
 
      //if(scanline == 64)
@@ -1435,13 +1445,8 @@ MDFN_FASTCALL pscpu_timestamp_t GPU_Update(const pscpu_timestamp_t sys_timestamp
 
      if(!CorrectAspect)
      {
-      dest = surface->pixels + drxbo + dest_line * surface->pitch32;
-
-      for(int32 x = 0; x < nca_dest_adj; x++)
-       dest[x] = black; //rand();
-
-      for(int32 x = nca_dest_adj + LineWidths[dest_line]; x < nca_lw; x++)
-       dest[x] = black; //rand();
+      if(!queue_line)
+       PadScanoutLine(sl);
 
       LineWidths[dest_line] = nca_lw;
      }
@@ -1455,6 +1460,9 @@ MDFN_FASTCALL pscpu_timestamp_t GPU_Update(const pscpu_timestamp_t sys_timestamp
     {
      DisplayFB_CurYOffset = (DisplayFB_CurYOffset + 1) & 0x1FF;
     }
+
+    if(RenderThreaded)
+     MTIF_Flush();
    }
    PSX_SetEventNT(PSX_EVENT_TIMER, TIMER_Update(sys_timestamp));  // Mostly so the next event time gets recalculated properly in regards to our calls
 								  // to TIMER_SetVBlank() and TIMER_SetHRetrace().
@@ -1499,9 +1507,10 @@ void GPU_GetGunXTranslation(float* scale, float* offs)
   //printf("%f %d %d\n", *scale, lw, nca_lw);
  }
 }
-void GPU_StartFrame(EmulateSpecStruct *espec_arg)
+void GPU_StartFrame(EmulateSpecStruct *espec_arg, const bool sync_lines)
 {
  sl_zero_reached = false;
+ SyncLines = sync_lines;
 
  if(!espec_arg)
  {
@@ -1540,6 +1549,11 @@ void GPU_StateAction(StateMem *sm, const unsigned load, const bool data_only)
  uint32 TexCache_Tag[256];
  uint16 TexCache_Data[256][4];
 
+ GPU_SyncRender();
+
+ if(RenderThreaded && !load)
+  MTIF_GetCacheData();
+
  for(unsigned i = 0; i < 256; i++)
  {
   TexCache_Tag[i] = TexCache[i].Tag;
@@ -1690,6 +1704,9 @@ void GPU_StateAction(StateMem *sm, const unsigned load, const bool data_only)
   OffsY = sign_x_to_s32(11, OffsY);
 
   IRQ_Assert(IRQ_GPU, IRQPending);
+
+  if(RenderThreaded)
+   MTIF_Reset();
  }
 }
 
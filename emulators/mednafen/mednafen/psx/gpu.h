@@ -51,10 +51,14 @@ struct line_point
  uint8 r, g, b;
 };
 
-struct PS_GPU
+//
+// Drawing state that affects what the rasterizers write to GPU RAM(as opposed to only how long drawing takes), grouped so
+// it can be snapshotted and compared cheaply when the threaded renderer is enabled(see gpu_mt.h).
+//
+struct PS_GPU_DrawEnv
 {
- uint16 CLUT_Cache[256];
  uint32 CLUT_Cache_VB;	// Don't try to be clever and reduce it to 16 bits... ~0U is value for invalidated state.
+ uint32 TexCache_Serial;	// Incremented on every texture cache invalidation; not saved in save states.
 
  struct	// Speedup-cache variables, derived from other variables; shouldn't be saved in save states.
  {
@@ -66,6 +70,36 @@ struct PS_GPU
   uint32 TWY_ADD;
  } SUCV;
 
+ int32 ClipX0;
+ int32 ClipY0;
+ int32 ClipX1;
+ int32 ClipY1;
+
+ int32 OffsX;
+ int32 OffsY;
+
+ uint32 MaskSetOR;
+ uint32 MaskEvalAND;
+
+ uint32 SpriteFlip;
+
+ uint32 DisplayFB_YStart;
+ uint32 DisplayMode;
+
+ bool dtd;
+ bool dfe;
+ bool field_ram_readout;
+
+ uint8 InCmd;
+ uint8 InCmd_CC;
+
+ uint8 DrawEnv_Padding[3];	// Keep the struct free of implicit padding, so memcmp() can be used on it.
+};
+
+struct PS_GPU : public PS_GPU_DrawEnv
+{
+ uint16 CLUT_Cache[256];
+
  struct
  {
   uint16 Data[4];
@@ -82,20 +116,6 @@ struct PS_GPU
  //uint32 abr;		// Semi-transparency mode(0~3)
  //bool dtd;		// Dithering enable
 
- int32 ClipX0;
- int32 ClipY0;
- int32 ClipX1;
- int32 ClipY1;
-
- int32 OffsX;
- int32 OffsY;
-
- uint32 MaskSetOR;
- uint32 MaskEvalAND;
-
- bool dtd;
- bool dfe;
-
  bool TexDisable;
  bool TexDisableAllowChange;
 
@@ -104,8 +124,6 @@ struct PS_GPU
  uint32 TexPageX;
  uint32 TexPageY;
 
- uint32 SpriteFlip;
-
  uint32 abr;
  uint32 TexMode;
 
@@ -126,8 +144,6 @@ struct PS_GPU
   INCMD_FBWRITE = (1 << 2),
   INCMD_FBREAD = (1 << 3)
  };
- uint8 InCmd;
- uint8 InCmd_CC;
 
  tri_vertex InQuad_F3Vertices[3];
 
@@ -144,14 +160,12 @@ struct PS_GPU
  // Display Parameters
  //
  uint32 DisplayFB_XStart;
- uint32 DisplayFB_YStart;
 
  uint32 HorizStart;
  uint32 HorizEnd;
 
  uint32 VertStart;
  uint32 VertEnd;
- uint32 DisplayMode;
  bool DisplayOff;
 
  //
@@ -162,7 +176,6 @@ struct PS_GPU
  bool sl_zero_reached;
  bool skip;
  bool field;
- bool field_ram_readout;
  uint32 DisplayFB_CurYOffset;
  uint32 DisplayFB_CurLineYReadout;
 
@@ -203,6 +216,8 @@ struct PS_GPU
  int32 NCABaseW;
  int32 hmc_to_visible;
  /*const*/ bool HardwarePALType;
+ /*const*/ bool RenderThreaded;
+ bool SyncLines;	// Scan out lines in the emulation thread, for light guns.
  uint32 OutputLUT[384];
  //
  //
@@ -212,7 +227,13 @@ struct PS_GPU
 
  MDFN_HIDE extern PS_GPU GPU;
 
- void GPU_Init(bool pal_clock_and_tv) MDFN_COLD;
+ enum
+ {
+  GPU_RENDERER_ST = 0,
+  GPU_RENDERER_MT = 1
+ };
+
+ void GPU_Init(bool pal_clock_and_tv, const unsigned renderer, const uint64 affinity) MDFN_COLD;
  void GPU_Kill(void) MDFN_COLD;
 
  void GPU_SetGetVideoParams(MDFNGI* gi, const bool caspect, const int sls, const int sle, const bool show_h_overscan) MDFN_COLD;
@@ -225,7 +246,10 @@ struct PS_GPU
 
  void GPU_ResetTS(void);
 
- void GPU_StartFrame(EmulateSpecStruct *espec);
+ void GPU_StartFrame(EmulateSpecStruct *espec, const bool sync_lines);
+
+ // Waits for the render thread(if any) to finish all queued work, so GPU RAM can be accessed directly.
+ void GPU_SyncRender(void);
 
  MDFN_FASTCALL pscpu_timestamp_t GPU_Update(const pscpu_timestamp_t timestamp);
 
@@ -265,11 +289,15 @@ struct PS_GPU
 
  static INLINE uint16 GPU_PeekRAM(uint32 A)
  {
+  GPU_SyncRender();
+
   return GPU.GPURAM[(A >> 10) & 0x1FF][A & 0x3FF];
  }
 
  static INLINE void GPU_PokeRAM(uint32 A, uint16 V)
  {
+  GPU_SyncRender();
+
   GPU.GPURAM[(A >> 10) & 0x1FF][A & 0x3FF] = V;
  }
 }
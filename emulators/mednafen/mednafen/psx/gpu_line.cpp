@@ -146,6 +146,9 @@ static void DrawLine(line_point *points)
 
  DrawTimeAvail -= k * 2;
 
+ if(TimingOnly)
+  return;
+
  //
  //
  //
@@ -259,7 +262,7 @@ static void Command_DrawLine(const uint32 *cb)
  DrawLine<goraud, BlendMode, MaskEval_TA>(points);
 }
 
-MDFN_HIDE extern const CTEntry Commands_40_5F[0x20] =
+MDFN_HIDE extern const CTEntry PS_GPU_VARIANT_NAME(Commands_40_5F)[0x20] =
 {
  LINE_HELPER(0x40),
  LINE_HELPER(0x41),
@@ -0,0 +1,215 @@
+/******************************************************************************/
+/* Mednafen Sony PS1 Emulation Module                                         */
+/******************************************************************************/
+/* gpu_mt.cpp:
+**  Copyright (C) 2011-2019 Mednafen Team
+**
+** This program is free software; you can redistribute it and/or
+** modify it under the terms of the GNU General Public License
+** as published by the Free Software Foundation; either version 2
+** of the License, or (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software Foundation, Inc.,
+** 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+
+#include "psx.h"
+#include "gpu_mt.h"
+
+//
+// Render variants of the drawing commands, bound to GPU_RT instead of GPU.
+//
+#define PS_GPU_VARIANT_RENDER
+
+#pragma GCC push_options
+#include "gpu_polygon.cpp"
+#pragma GCC pop_options
+
+#pragma GCC push_options
+#include "gpu_sprite.cpp"
+#pragma GCC pop_options
+
+#pragma GCC push_options
+#include "gpu_line.cpp"
+#pragma GCC pop_options
+
+namespace MDFN_IEN_PSX
+{
+
+PS_GPU_RT GPU_RT;
+
+namespace PS_GPU_INTERNAL
+{
+
+alignas(32) ITC_S ITC;
+
+static MDFN_HOT int RThreadEntry(void* data)
+{
+ bool Running = true;
+ size_t WritePos = 0;
+ size_t ReadPos = 0;
+
+ while(MDFN_LIKELY(Running))
+ {
+  ITC.TMP_ReadPos.store(ReadPos, std::memory_order_release);
+  WritePos = ITC.TMP_WritePos.load(std::memory_order_acquire);
+
+  while(ReadPos == WritePos)
+  {
+   MThreading::Sem_Post(ITC.WakeupSem);
+   MThreading::Sem_TimedWait(ITC.RT_WakeupSem, 1);
+   WritePos = ITC.TMP_WritePos.load(std::memory_order_acquire);
+  }
+
+  while(ReadPos != WritePos)
+  {
+   const WQ_Entry* e = &ITC.WQ[ReadPos];
+
+   switch(e->Command)
+   {
+    case MTCOMMAND_EXIT:
+	Running = false;
+	break;
+
+    case MTCOMMAND_SET_DRAW_ENV:
+	if(e->DrawEnv.TexCache_Serial != TexCache_Serial)
+	 InvalidateTexCache();
+
+	static_cast<PS_GPU_DrawEnv&>(GPU_RT) = e->DrawEnv;
+	break;
+
+    case MTCOMMAND_DRAW:
+	e->Draw.func(e->Draw.cb);
+	break;
+
+    case MTCOMMAND_FBWRITE_BEGIN:
+	FBRW_X = e->FBWrite[0];
+	FBRW_Y = e->FBWrite[1];
+	FBRW_W = e->FBWrite[2];
+	FBRW_H = e->FBWrite[3];
+	FBRW_CurX = e->FBWrite[4];
+	FBRW_CurY = e->FBWrite[5];
+	break;
+
+    case MTCOMMAND_FBWRITE_DATA:
+	FBWrite_Data(e->FBWrite[0], true);
+	break;
+
+    case MTCOMMAND_SCANOUT_LINE:
+	DrawScanoutLine(e->Line);
+	PadScanoutLine(e->Line);
+	break;
+   }
+
+   ReadPos = (ReadPos + 1) % ITC.WQ.size();
+  }
+ }
+
+ return 0;
+}
+
+static void SetCommandFunc(const unsigned cc, void (*func)(const uint32 *cb))
+{
+ for(auto& fg : ITC.Commands[cc].func)
+  for(auto& f : fg)
+   f = func;
+}
+
+void MTIF_Init(const uint64 affinity)
+{
+ memset(ITC.Commands, 0, sizeof(ITC.Commands));
+ memcpy(&ITC.Commands[0x20], Commands_20_3F_Render, sizeof(Commands_20_3F_Render));
+ memcpy(&ITC.Commands[0x40], Commands_40_5F_Render, sizeof(Commands_40_5F_Render));
+ memcpy(&ITC.Commands[0x60], Commands_60_7F_Render, sizeof(Commands_60_7F_Render));
+
+ SetCommandFunc(0x02, Command_FBFill);
+
+ for(unsigned cc = 0x80; cc < 0xA0; cc++)
+  SetCommandFunc(cc, Command_FBCopy);
+ //
+ //
+ //
+ ITC.WritePos = 0;
+ ITC.ReadPos = 0;
+ ITC.TMP_WritePos = 0;
+ ITC.TMP_ReadPos = 0;
+ //
+ ITC.RT_WakeupSem = MThreading::Sem_Create();
+ ITC.WakeupSem = MThreading::Sem_Create();
+ //
+ MTIF_Reset();
+ //
+ ITC.RThread = MThreading::Thread_Create(RThreadEntry, NULL, "GPU Render");
+ if(affinity)
+  MThreading::Thread_SetAffinity(ITC.RThread, affinity);
+}
+
+void MTIF_Kill(void)
+{
+ if(ITC.RThread)
+ {
+  WQ_Begin(MTCOMMAND_EXIT);
+  WQ_End();
+  Wakeup(false);
+  MThreading::Thread_Wait(ITC.RThread, NULL);
+  ITC.RThread = NULL;
+ }
+
+ if(ITC.RT_WakeupSem)
+ {
+  MThreading::Sem_Destroy(ITC.RT_WakeupSem);
+  ITC.RT_WakeupSem = NULL;
+ }
+
+ if(ITC.WakeupSem)
+ {
+  MThreading::Sem_Destroy(ITC.WakeupSem);
+  ITC.WakeupSem = NULL;
+ }
+}
+
+//
+// Copies the emulation thread's drawing state and cache contents to the render thread's.  Must only be called while
+// the queue is empty, e.g. after power-on or a save state load.
+//
+void MTIF_Reset(void)
+{
+ if(ITC.RThread)
+  MTIF_Sync();
+
+ static_cast<PS_GPU_DrawEnv&>(GPU_RT) = GPU;
+ ITC.DrawEnv = GPU;
+
+ memcpy(GPU_RT.CLUT_Cache, GPU.CLUT_Cache, sizeof(GPU_RT.CLUT_Cache));
+ memcpy(GPU_RT.TexCache, GPU.TexCache, sizeof(GPU_RT.TexCache));
+ memcpy(GPU_RT.InQuad_F3Vertices, GPU.InQuad_F3Vertices, sizeof(GPU_RT.InQuad_F3Vertices));
+ GPU_RT.InPLine_PrevPoint = GPU.InPLine_PrevPoint;
+
+ GPU_RT.FBRW_X = GPU.FBRW_X;
+ GPU_RT.FBRW_Y = GPU.FBRW_Y;
+ GPU_RT.FBRW_W = GPU.FBRW_W;
+ GPU_RT.FBRW_H = GPU.FBRW_H;
+ GPU_RT.FBRW_CurY = GPU.FBRW_CurY;
+ GPU_RT.FBRW_CurX = GPU.FBRW_CurX;
+}
+
+//
+// The timing variants only maintain the cache tags; fetch the cache contents from the render thread, for save states.
+// Must only be called while the queue is empty.
+//
+void MTIF_GetCacheData(void)
+{
+ memcpy(GPU.CLUT_Cache, GPU_RT.CLUT_Cache, sizeof(GPU.CLUT_Cache));
+
+ for(unsigned i = 0; i < 256; i++)
+  memcpy(GPU.TexCache[i].Data, GPU_RT.TexCache[i].Data, sizeof(GPU.TexCache[i].Data));
+}
+
+}
+}
@@ -0,0 +1,263 @@
+/******************************************************************************/
+/* Mednafen Sony PS1 Emulation Module                                         */
+/******************************************************************************/
+/* gpu_mt.h:
+**  Copyright (C) 2011-2019 Mednafen Team
+**
+** This program is free software; you can redistribute it and/or
+** modify it under the terms of the GNU General Public License
+** as published by the Free Software Foundation; either version 2
+** of the License, or (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software Foundation, Inc.,
+** 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+
+/*
+ Threaded renderer:
+
+  The emulation thread runs the timing variants of the drawing commands(see gpu_common.inc), which compute drawing time and
+  maintain texture/CLUT cache tags exactly as the single-threaded renderer would, but don't touch GPU RAM.  Each drawing command
+  is also queued, along with any changes to the drawing state(PS_GPU_DrawEnv), to the render thread, which runs the render variants
+  against its own copy of that state and of the caches' contents.
+
+  Anything on the emulation thread that reads or writes GPU RAM directly(FB reads, save states, debugger access, power-on) waits
+  for the queue to drain first, via GPU_SyncRender().
+*/
+
+#ifndef __MDFN_PSX_GPU_MT_H
+#define __MDFN_PSX_GPU_MT_H
+
+#include <atomic>
+#include <mednafen/MThreading.h>
+
+namespace MDFN_IEN_PSX
+{
+
+struct PS_GPU_RT : public PS_GPU_DrawEnv
+{
+ uint16 CLUT_Cache[256];
+ decltype(PS_GPU::TexCache) TexCache;
+
+ tri_vertex InQuad_F3Vertices[3];
+
+ line_point InPLine_PrevPoint;
+
+ uint32 FBRW_X;
+ uint32 FBRW_Y;
+ uint32 FBRW_W;
+ uint32 FBRW_H;
+ uint32 FBRW_CurY;
+ uint32 FBRW_CurX;
+
+ int32 DrawTimeAvail;	// Decremented by the rasterizers, otherwise unused.
+};
+
+MDFN_HIDE extern PS_GPU_RT GPU_RT;
+
+namespace PS_GPU_INTERNAL
+{
+
+enum : uint8
+{
+ MTCOMMAND_EXIT = 0,
+ MTCOMMAND_SET_DRAW_ENV,
+ MTCOMMAND_DRAW,
+ MTCOMMAND_FBWRITE_BEGIN,
+ MTCOMMAND_FBWRITE_DATA,
+ MTCOMMAND_SCANOUT_LINE
+};
+
+struct ScanoutLine
+{
+ uint32* dest;
+ uint32* nca_dest;	// NULL if aspect ratio correction is enabled.
+ int32 dx_start;
+ int32 dx_end;
+ int32 dmw;
+ int32 fb_x;
+ int32 lw;
+ int32 nca_lw;
+ int32 nca_dest_adj;
+ uint16 src_y;
+ bool bpp24;
+};
+
+void DrawScanoutLine(const ScanoutLine& sl);
+void PadScanoutLine(const ScanoutLine& sl);
+
+struct WQ_Entry
+{
+ uint8 Command;
+
+ union
+ {
+  PS_GPU_DrawEnv DrawEnv;
+
+  struct
+  {
+   void (*func)(const uint32 *cb);
+   uint32 cb[12];
+  } Draw;
+
+  uint32 FBWrite[6];
+
+  ScanoutLine Line;
+ };
+};
+
+struct ITC_S
+{
+ uint8 padding0[64];
+ std::array<WQ_Entry, 16384> WQ;
+ uint8 padding1[64];
+ size_t WritePos;
+ size_t ReadPos;
+ PS_GPU_DrawEnv DrawEnv;	// Drawing state the render thread will have after it has processed everything queued so far.
+ //
+ uint8 padding2[64];
+ std::atomic_int_least32_t TMP_WritePos;
+ std::atomic_int_least32_t TMP_ReadPos;
+
+ MThreading::Sem* RT_WakeupSem;
+ MThreading::Sem* WakeupSem;
+ MThreading::Thread* RThread;
+
+ CTEntry Commands[256];		// Render variants; only valid for the drawing commands.
+};
+
+MDFN_HIDE extern struct ITC_S ITC;
+
+static void Wakeup(bool wait_until_empty = false)
+{
+ ITC.TMP_WritePos.store(ITC.WritePos, std::memory_order_release);
+ ITC.ReadPos = ITC.TMP_ReadPos.load(std::memory_order_acquire);
+
+ if(ITC.ReadPos != ITC.WritePos)
+ {
+  MThreading::Sem_Post(ITC.RT_WakeupSem);
+
+  if(wait_until_empty)
+  {
+   do
+   {
+    MThreading::Sem_TimedWait(ITC.WakeupSem, 1);
+    ITC.ReadPos = ITC.TMP_ReadPos.load(std::memory_order_acquire);
+   } while(ITC.ReadPos != ITC.WritePos);
+  }
+ }
+}
+
+static INLINE WQ_Entry* WQ_Begin(uint8 Command)
+{
+ WQ_Entry* e = &ITC.WQ[ITC.WritePos];
+
+ e->Command = Command;
+
+ return e;
+}
+
+static INLINE void WQ_End(void)
+{
+ size_t nwp = (ITC.WritePos + 1) % ITC.WQ.size();
+
+ if(MDFN_UNLIKELY(nwp == ITC.ReadPos))
+  Wakeup(true);
+
+ ITC.WritePos = nwp;
+}
+
+static INLINE void MTIF_SyncDrawEnv(void)
+{
+ const PS_GPU_DrawEnv& de = GPU;
+
+ if(MDFN_UNLIKELY(memcmp(&de, &ITC.DrawEnv, sizeof(PS_GPU_DrawEnv))))
+ {
+  WQ_Entry* e = WQ_Begin(MTCOMMAND_SET_DRAW_ENV);
+
+  e->DrawEnv = de;
+  WQ_End();
+  //
+  ITC.DrawEnv = de;
+ }
+}
+
+//
+// Call before running the timing variant of drawing command "cc"(with the same abr and TexMode state).
+//
+static INLINE void MTIF_Draw(const uint32 cc, const uint32* cb, const unsigned len)
+{
+ MTIF_SyncDrawEnv();
+ //
+ WQ_Entry* e = WQ_Begin(MTCOMMAND_DRAW);
+
+ assert(len <= sizeof(e->Draw.cb) / sizeof(e->Draw.cb[0]));
+
+ e->Draw.func = ITC.Commands[cc].func[GPU.abr][GPU.TexMode | (GPU.MaskEvalAND ? 0x4 : 0x0)];
+ memcpy(e->Draw.cb, cb, len * sizeof(uint32));
+ WQ_End();
+}
+
+//
+// Call after running the timing variant; the render variant will have made the same changes to the render thread's
+// drawing state(InCmd, CLUT cache tag, etc.) by the time it has run.
+//
+static INLINE void MTIF_DrawDone(void)
+{
+ ITC.DrawEnv = GPU;
+}
+
+static INLINE void MTIF_FBWriteBegin(void)
+{
+ MTIF_SyncDrawEnv();
+ //
+ WQ_Entry* e = WQ_Begin(MTCOMMAND_FBWRITE_BEGIN);
+
+ e->FBWrite[0] = GPU.FBRW_X;
+ e->FBWrite[1] = GPU.FBRW_Y;
+ e->FBWrite[2] = GPU.FBRW_W;
+ e->FBWrite[3] = GPU.FBRW_H;
+ e->FBWrite[4] = GPU.FBRW_CurX;
+ e->FBWrite[5] = GPU.FBRW_CurY;
+ WQ_End();
+}
+
+static INLINE void MTIF_FBWriteData(uint32 InData)
+{
+ WQ_Entry* e = WQ_Begin(MTCOMMAND_FBWRITE_DATA);
+
+ e->FBWrite[0] = InData;
+ WQ_End();
+}
+
+static INLINE void MTIF_ScanoutLine(const ScanoutLine& sl)
+{
+ WQ_Entry* e = WQ_Begin(MTCOMMAND_SCANOUT_LINE);
+
+ e->Line = sl;
+ WQ_End();
+}
+
+static INLINE void MTIF_Flush(void)
+{
+ Wakeup(false);
+}
+
+static INLINE void MTIF_Sync(void)
+{
+ Wakeup(true);
+}
+
+void MTIF_Init(const uint64 affinity) MDFN_COLD;
+void MTIF_Kill(void) MDFN_COLD;
+void MTIF_Reset(void);
+void MTIF_GetCacheData(void);
+}
+}
+#endif
@@ -179,6 +179,9 @@ static INLINE void DrawSpan(int y, const int32 x_start, const int32 x_bound, i_g
   else
    DrawTimeAvail -= w;
 
+  if(TimingOnly && !textured)
+   return;
+
   do
   {
    const uint32 r = ig.r >> (COORD_FBS + COORD_POST_PADDING);
@@ -594,7 +597,7 @@ static void Command_DrawPolygon(const uint32 *cb)
 #undef COORD_FBS
 #undef COORD_MF_INT
 
-MDFN_HIDE extern const CTEntry Commands_20_3F[0x20] =
+MDFN_HIDE extern const CTEntry PS_GPU_VARIANT_NAME(Commands_20_3F)[0x20] =
 {
  /* 0x20 */
  POLY_HELPER(0x20),
@@ -120,6 +120,9 @@ static void DrawSprite(int32 x_arg, int32 y_arg, int32 w, int32 h, uint8 u_arg,
     DrawTimeAvail -= suck_time;
    }
 
+   if(TimingOnly && !textured)
+    continue;
+
    for(int32 x = x_start; MDFN_LIKELY(x < x_bound); x++)
    {
     if(textured)
@@ -234,7 +237,7 @@ static void Command_DrawSprite(const uint32 *cb)
  }
 }
 
-MDFN_HIDE extern const CTEntry Commands_60_7F[0x20] =
+MDFN_HIDE extern const CTEntry PS_GPU_VARIANT_NAME(Commands_60_7F)[0x20] =
 {
  SPR_HELPER(0x60),
  SPR_HELPER(0x61),
@@ -0,0 +1,55 @@
+/******************************************************************************/
+/* Mednafen Sony PS1 Emulation Module                                         */
+/******************************************************************************/
+/* gpu_timing.cpp:
+**  Copyright (C) 2011-2019 Mednafen Team
+**
+** This program is free software; you can redistribute it and/or
+** modify it under the terms of the GNU General Public License
+** as published by the Free Software Foundation; either version 2
+** of the License, or (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software Foundation, Inc.,
+** 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+
+//
+// Timing-only variants of the drawing commands, run in the emulation thread when the threaded renderer is enabled(see gpu_mt.h).
+//
+#define PS_GPU_VARIANT_TIMING
+
+#pragma GCC push_options
+#include "gpu_polygon.cpp"
+#pragma GCC pop_options
+
+#pragma GCC push_options
+#include "gpu_sprite.cpp"
+#pragma GCC pop_options
+
+#pragma GCC push_options
+#include "gpu_line.cpp"
+#pragma GCC pop_options
+
+namespace MDFN_IEN_PSX
+{
+namespace PS_GPU_INTERNAL
+{
+
+void Command_FBFill_Timing(const uint32 *cb)
+{
+ Command_FBFill(cb);
+}
+
+void Command_FBCopy_Timing(const uint32 *cb)
+{
+ Command_FBCopy(cb);
+}
+
+}
+}
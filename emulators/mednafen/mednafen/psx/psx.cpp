@@ -29,6 +29,7 @@
 #include <mednafen/FileStream.h>
 #include <mednafen/mempatcher.h>
 #include <mednafen/PSFLoader.h>
+#include <mednafen/Time.h>
 #include <mednafen/player.h>
 #include <mednafen/hash/sha256.h>
 #include <mednafen/cheat_formats/psx.h>
@@ -168,6 +169,28 @@ static const MDFNSetting_EnumList Region_List[] =
  { NULL, 0 },
 };
 
+static const MDFNSetting_EnumList Renderer_List[] =
+{
+ { "st", GPU_RENDERER_ST, gettext_noop("Single-threaded"), gettext_noop("GPU rendering is performed in the main emulation thread.") },
+ { "mt", GPU_RENDERER_MT, gettext_noop("Multi-threaded"), gettext_noop("GPU rendering is performed in a dedicated thread.") },
+
+ { NULL, 0 }
+};
+
+enum
+{
+ CPU_MODE_INTERP = 0,
+ CPU_MODE_CACHED = 1
+};
+
+static const MDFNSetting_EnumList CPUMode_List[] =
+{
+ { "interp", CPU_MODE_INTERP, gettext_noop("Interpreter"), gettext_noop("Instructions are fetched and decoded one at a time.") },
+ { "cached", CPU_MODE_CACHED, gettext_noop("Basic-block cache"), gettext_noop("Runs of instructions up to and including a branch's delay slot are decoded once and reused until the code they were decoded from is written to.  Instruction cache timing is unchanged.") },
+
+ { NULL, 0 }
+};
+
 static const struct
 {
  const char* version;
@@ -226,6 +249,8 @@ static uint64 Memcard_PrevDC[8];
 static int64 Memcard_SaveDelay[8];
 
 PS_CPU *CPU = NULL;
+static bool CPUBench;
+static int64 CPUBenchTime;
 PS_SPU *SPU = NULL;
 PS_CDC *CDC = NULL;
 static FrontIO *FIO = NULL;
@@ -495,6 +520,9 @@ template<typename T, bool IsWrite, bool Access24> static INLINE void MemRW(pscpu
     V = MainRAM.Read<T>(A & 0x1FFFFF);
   }
 
+  if(IsWrite)
+   CPU->InvalidateRAMCode(A, Access24 ? 3 : sizeof(T));
+
   return;
  }
 
@@ -979,6 +1007,8 @@ template<typename T, bool Access24> static INLINE void MemPoke(pscpu_timestamp_t
   else
    MainRAM.Write<T>(A & 0x1FFFFF, V);
 
+  CPU->InvalidateRAMCode(A, Access24 ? 3 : sizeof(T));
+
   return;
  }
 
@@ -989,6 +1019,8 @@ template<typename T, bool Access24> static INLINE void MemPoke(pscpu_timestamp_t
   else
    BIOSROM->Write<T>(A & 0x7FFFF, V);
 
+  CPU->InvalidateAllBlocks();
+
   return;
  }
 
@@ -1084,15 +1116,23 @@ static void Emulate(EmulateSpecStruct *espec)
  espec->SoundBufSize = 0;
 
  FIO->UpdateInput();
- GPU_StartFrame(psf_loader ? NULL : espec);
+ GPU_StartFrame(psf_loader ? NULL : espec, FIO->RequireNoFrameskip());
  SPU->StartFrame(espec->SoundRate, MDFN_GetSettingUI("psx.spu.resamp_quality"));
 
  Running = -1;
- timestamp = CPU->Run(timestamp, psf_loader == NULL && psx_dbg_level >= PSX_DBG_BIOS_PRINT, psf_loader != NULL);
+ {
+  const int64 bench_st = CPUBench ? Time::MonoUS() : 0;
+
+  timestamp = CPU->Run(timestamp, psf_loader == NULL && psx_dbg_level >= PSX_DBG_BIOS_PRINT, psf_loader != NULL);
+
+  if(CPUBench)
+   CPUBenchTime += Time::MonoUS() - bench_st;
+ }
 
  assert(timestamp);
 
  ForceEventUpdates(timestamp);
+ GPU_SyncRender();
  if(GPU_GetScanlineNum() < 100)
   PSX_DBG(PSX_DBG_ERROR, "[BUUUUUUUG] Frame timing end glitch; scanline=%u, st=%u\n", GPU_GetScanlineNum(), timestamp);
 
@@ -1628,7 +1668,7 @@ static MDFN_COLD void InitCommon(std::vector<CDInterface*> *CDInterfaces, const
 
  CPU = new PS_CPU();
  SPU = new PS_SPU();
- GPU_Init(region == REGION_EU);
+ GPU_Init(region == REGION_EU, MDFN_GetSettingUI("psx.renderer"), MDFN_GetSettingUI("psx.affinity.gpu"));
  CDC = new PS_CDC();
  FIO = new FrontIO();
 
@@ -1688,6 +1728,10 @@ static MDFN_COLD void InitCommon(std::vector<CDInterface*> *CDInterfaces, const
  CPU->SetFastMap(BIOSROM->data8, 0x9FC00000, 512 * 1024);
  CPU->SetFastMap(BIOSROM->data8, 0xBFC00000, 512 * 1024);
 
+ CPU->SetBlockCache(MDFN_GetSettingUI("psx.cpu_mode") == CPU_MODE_CACHED, MainRAM.data8, BIOSROM->data8);
+ CPUBench = MDFN_GetSettingB("psx.dbg_cpu_bench");
+ CPUBenchTime = 0;
+
  if(PIOMem)
  {
   CPU->SetFastMap(PIOMem->data8, 0x1F000000, 65536);
@@ -2076,6 +2120,13 @@ static MDFN_COLD void Cleanup(void)
 
  if(CPU)
  {
+  if(CPUBench && CPUBenchTime > 0)
+  {
+   const uint64 icount = CPU->GetInstructionCount();
+
+   MDFN_printf(_("CPU(%s): %llu instructions in %.3f seconds, %.2f emulated MIPS per host core.\n"), MDFN_GetSettingS("psx.cpu_mode").c_str(), (unsigned long long)icount, CPUBenchTime / 1000000.0, (double)icount / CPUBenchTime);
+  }
+
   delete CPU;
   CPU = NULL;
  }
@@ -2297,6 +2348,13 @@ static const MDFNSetting PSXSettings[] =
 
  { "psx.h_overscan", MDFNSF_NOFLAGS, gettext_noop("Show horizontal overscan area."), NULL, MDFNST_BOOL, "1" },
 
+ { "psx.cpu_mode", MDFNSF_NOFLAGS, gettext_noop("CPU emulation mode."), NULL, MDFNST_ENUM, "interp", NULL, NULL, NULL, NULL, CPUMode_List },
+
+ { "psx.renderer", MDFNSF_NOFLAGS, gettext_noop("GPU renderer."), gettext_noop("If you have only one CPU with one physical CPU core, select the single-threaded renderer for better performance.\n\nThe multi-threaded renderer falls back to drawing each scanline synchronously while a light gun is connected."), MDFNST_ENUM, "st", NULL, NULL, NULL, NULL, Renderer_List },
+ { "psx.affinity.gpu", MDFNSF_NOFLAGS, gettext_noop("GPU rendering thread CPU affinity mask."), gettext_noop("Set to 0 to disable changing affinity."), MDFNST_UINT, "0", "0x0000000000000000", "0xFFFFFFFFFFFFFFFF" },
+
+ { "psx.dbg_cpu_bench", MDFNSF_NOFLAGS, gettext_noop("Report CPU emulation throughput on game close."), gettext_noop("Time spent in the CPU emulation loop includes time spent emulating the other components it calls into.  Run once with each psx.cpu_mode setting to compare them."), MDFNST_BOOL, "0" },
+
 #if PSX_DBGPRINT_ENABLE
  { "psx.dbg_level", MDFNSF_NOFLAGS, gettext_noop("Debug printf verbosity level."), NULL, MDFNST_UINT, "0", "0", "4" },
 #endif
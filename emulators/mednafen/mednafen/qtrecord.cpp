@@ -26,6 +26,7 @@
 #include "video/png.h"
 
 #include <zlib.h>
+#include <thread>
 
 namespace Mednafen
 {
@@ -191,6 +192,23 @@ QTRecord::QTRecord(const std::string& path, const VideoSpec &spec) : qtfile(path
 {
  Finished = false;
 
+ NumEncoderThreads = 0;
+ WriterThread = nullptr;
+ QueueMutex = nullptr;
+ FreeSem = nullptr;
+ EncodeSem = nullptr;
+ WriteSem = nullptr;
+ WriterExit = false;
+ WriteErrorThrown = false;
+
+ Bench = spec.Bench;
+ BenchFrames = 0;
+ BenchWaits = 0;
+ BenchStallTime = 0;
+ BenchMaxStallTime = 0;
+ BenchEncodeTime = 0;
+ BenchWriteTime = 0;
+
  SoundFramesWritten = 0;
 
  SoundRate = spec.SoundRate;
@@ -243,14 +261,9 @@ QTRecord::QTRecord(const std::string& path, const VideoSpec &spec) : qtfile(path
  VideoCodec = spec.VideoCodec;
 
  if(VideoCodec == VCODEC_PNG)
-  RawVideoBuffer.resize((1 + QTVideoWidth * 3) * QTVideoHeight);
+  RawVideoSize = (1 + QTVideoWidth * 3) * QTVideoHeight;
  else
-  RawVideoBuffer.resize(QTVideoWidth * QTVideoHeight * 3);
-
- if(VideoCodec == VCODEC_CSCD)
-  CompressedVideoBuffer.resize((RawVideoBuffer.size() * 110 + 99 ) / 100);	// 1.10
- else if(VideoCodec == VCODEC_PNG)
-  CompressedVideoBuffer.resize(compressBound(RawVideoBuffer.size()));
+  RawVideoSize = QTVideoWidth * QTVideoHeight * 3;
 
  {
   uint32 appley_time = Time::EpochTime() + 2082844800;
@@ -262,15 +275,243 @@ QTRecord::QTRecord(const std::string& path, const VideoSpec &spec) : qtfile(path
  Write_ftyp();
 
  atom_begin("mdat", false);
+
+ try
+ {
+  unsigned num_encoders = spec.EncoderThreads;
+
+  if(!num_encoders)
+  {
+   // The emulation thread keeps a core busy.
+   num_encoders = std::thread::hardware_concurrency();
+
+   if(num_encoders > 1)
+    num_encoders--;
+  }
+
+  StartThreads(std::max<unsigned>(1, std::min<unsigned>(MaxEncoderThreads, num_encoders)));
+ }
+ catch(...)
+ {
+  StopThreads();
+
+  if(resampler)
+  {
+   speex_resampler_destroy(resampler);
+   resampler = NULL;
+  }
+  throw;
+ }
+}
+
+void QTRecord::StartThreads(unsigned num_encoders)
+{
+ // Enough frames for every encoder thread to have one in progress and one queued, with the writer thread working on
+ // another couple.
+ const unsigned num_jobs = num_encoders * 2 + 2;
+ size_t encoded_size;
+
+ if(VideoCodec == VCODEC_CSCD)
+  encoded_size = 2 + RawVideoSize + RawVideoSize / 16 + 64 + 3;	// Worst case LZO1X expansion
+ else if(VideoCodec == VCODEC_PNG)
+  encoded_size = 8 + (12 + 13) + (12 + compressBound(RawVideoSize)) + 12;	// Signature, IHDR, IDAT, IEND
+ else
+  encoded_size = RawVideoSize;
+
+ QueueMutex = MThreading::Mutex_Create();
+ FreeSem = MThreading::Sem_Create();
+ EncodeSem = MThreading::Sem_Create();
+ WriteSem = MThreading::Sem_Create();
+
+ for(unsigned i = 0; i < num_jobs; i++)
+ {
+  std::unique_ptr<FrameJob> job(new FrameJob());
+
+  job->Encoded.resize(encoded_size);
+  job->EncodedSize = 0;
+  job->IsEncoded = false;
+
+  FreeJobs.push_back(job.get());
+  Jobs.push_back(std::move(job));
+  MThreading::Sem_Post(FreeSem);
+ }
+
+ WriterThread = MThreading::Thread_Create(WriterThreadEntry, this, "MDFN QT Writer");
+
+ for(unsigned i = 0; i < num_encoders; i++)
+ {
+  EncoderThreadS* et = &EncoderThreads[i];
+
+  et->qt = this;
+
+  if(VideoCodec != VCODEC_RAW)
+   et->RawVideoBuffer.resize(RawVideoSize);
+
+  if(VideoCodec == VCODEC_CSCD)
+   et->LZOWorkMem.reset(new uint8[LZO1X_1_MEM_COMPRESS]);
+
+  et->Thread = MThreading::Thread_Create(EncoderThreadEntry, et, "MDFN QT Encoder");
+  NumEncoderThreads = i + 1;
+ }
+}
+
+// Waits for every queued frame to be written.
+void QTRecord::StopThreads(void)
+{
+ for(unsigned i = 0; i < NumEncoderThreads; i++)
+ {
+  if(EncoderThreads[i].Thread)
+   MThreading::Sem_Post(EncodeSem);
+ }
+
+ for(unsigned i = 0; i < NumEncoderThreads; i++)
+ {
+  if(EncoderThreads[i].Thread)
+  {
+   MThreading::Thread_Wait(EncoderThreads[i].Thread, nullptr);
+   EncoderThreads[i].Thread = nullptr;
+  }
+ }
+
+ if(WriterThread)
+ {
+  MThreading::Mutex_Lock(QueueMutex);
+  WriterExit = true;
+  MThreading::Mutex_Unlock(QueueMutex);
+  MThreading::Sem_Post(WriteSem);
+
+  MThreading::Thread_Wait(WriterThread, nullptr);
+  WriterThread = nullptr;
+ }
+
+ if(WriteSem)
+ {
+  MThreading::Sem_Destroy(WriteSem);
+  WriteSem = nullptr;
+ }
+
+ if(EncodeSem)
+ {
+  MThreading::Sem_Destroy(EncodeSem);
+  EncodeSem = nullptr;
+ }
+
+ if(FreeSem)
+ {
+  MThreading::Sem_Destroy(FreeSem);
+  FreeSem = nullptr;
+ }
+
+ if(QueueMutex)
+ {
+  MThreading::Mutex_Destroy(QueueMutex);
+  QueueMutex = nullptr;
+ }
+
+ FreeJobs.clear();
+ EncodeQueue.clear();
+ WriteQueue.clear();
+ Jobs.clear();
 }
 
+int QTRecord::EncoderThreadEntry(void* data)
+{
+ EncoderThreadS* const et = (EncoderThreadS*)data;
+ QTRecord* const qt = et->qt;
+
+ for(;;)
+ {
+  FrameJob* job;
+
+  MThreading::Sem_Wait(qt->EncodeSem);
+  MThreading::Mutex_Lock(qt->QueueMutex);
+
+  // Every frame queued comes with its own post, so nothing left to encode means StopThreads() wants us gone.
+  if(qt->EncodeQueue.empty())
+  {
+   MThreading::Mutex_Unlock(qt->QueueMutex);
+   break;
+  }
+
+  job = qt->EncodeQueue.front();
+  qt->EncodeQueue.pop_front();
+  MThreading::Mutex_Unlock(qt->QueueMutex);
+
+  const uint64 encode_start = Time::MonoUS();
+
+  qt->EncodeFrame(et, job);
+
+  MThreading::Mutex_Lock(qt->QueueMutex);
+  job->IsEncoded = true;
+  qt->BenchEncodeTime += Time::MonoUS() - encode_start;
+  MThreading::Mutex_Unlock(qt->QueueMutex);
+
+  MThreading::Sem_Post(qt->WriteSem);
+ }
+
+ return 0;
+}
+
+int QTRecord::WriterThreadEntry(void* data)
+{
+ QTRecord* const qt = (QTRecord*)data;
+ bool failed = false;
+
+ for(;;)
+ {
+  bool exit;
+
+  MThreading::Sem_Wait(qt->WriteSem);
+  MThreading::Mutex_Lock(qt->QueueMutex);
+
+  while(qt->WriteQueue.size() && qt->WriteQueue.front()->IsEncoded)
+  {
+   FrameJob* job = qt->WriteQueue.front();
+
+   qt->WriteQueue.pop_front();
+   MThreading::Mutex_Unlock(qt->QueueMutex);
+
+   const uint64 write_start = Time::MonoUS();
+
+   // After an error, frames are only returned to the pool, until WriteFrame() or Finish() report it.
+   if(!failed)
+   {
+    try
+    {
+     qt->WriteFrameData(job);
+    }
+    catch(std::exception &e)
+    {
+     failed = true;
+     MThreading::Mutex_Lock(qt->QueueMutex);
+     qt->WriteError = e.what();
+     MThreading::Mutex_Unlock(qt->QueueMutex);
+    }
+   }
+
+   MThreading::Mutex_Lock(qt->QueueMutex);
+   job->IsEncoded = false;
+   qt->FreeJobs.push_back(job);
+   qt->BenchWriteTime += Time::MonoUS() - write_start;
+   MThreading::Sem_Post(qt->FreeSem);
+  }
+
+  exit = qt->WriterExit && !qt->WriteQueue.size();
+  MThreading::Mutex_Unlock(qt->QueueMutex);
+
+  if(exit)
+   break;
+ }
+
+ return 0;
+}
 
 void QTRecord::WriteFrame(const MDFN_Surface *surface, const MDFN_Rect &DisplayRect, const int32 *LineWidths,
 			  const int16 *SoundBuf, const int32 SoundBufSize, const int64 MasterCycles)
 {
- QTChunk qts;
-
- memset(&qts, 0, sizeof(qts));
+ const uint64 stall_start = Time::MonoUS();
+ FrameJob* job;
+ bool wait;
 
  if(DisplayRect.h <= 0)
  {
@@ -278,143 +519,250 @@ void QTRecord::WriteFrame(const MDFN_Surface *surface, const MDFN_Rect &DisplayR
   return;
  }
 
+ MThreading::Mutex_Lock(QueueMutex);
+ if(WriteError.size())
+ {
+  const std::string error = WriteError;
 
- qts.video_foffset = qtfile.tell();
+  MThreading::Mutex_Unlock(QueueMutex);
+  WriteErrorThrown = true;
+  throw MDFN_Error(0, "%s", error.c_str());
+ }
+ wait = !FreeJobs.size();
+ MThreading::Mutex_Unlock(QueueMutex);
 
- // Write video here
+ MThreading::Sem_Wait(FreeSem);
+ MThreading::Mutex_Lock(QueueMutex);
+ job = FreeJobs.back();
+ FreeJobs.pop_back();
+ MThreading::Mutex_Unlock(QueueMutex);
+
+ //
+ // Copy the frame, leaving the conversion to the encoder thread.
+ //
+ job->Format = surface->format;
+ job->DisplayRect = DisplayRect;
+ job->LineWidths.resize(DisplayRect.h);
+ job->PixelsPitch = 0;
+
+ for(int y = 0; y < DisplayRect.h; y++)
  {
-  uint32 dest_y = 0;
-  int yscale_factor = QTVideoHeight / DisplayRect.h;
+  const int32 width = (LineWidths[0] == ~0) ? DisplayRect.w : LineWidths[DisplayRect.y + y];
 
-  for(int y = DisplayRect.y; y < DisplayRect.y + DisplayRect.h; y++)
-  {
-   int x_start;
-   int width;
-   int xscale_factor;
-   uint32 dest_x;
-   uint32 *src_ptr;
-   uint8 *dest_line;
-
-   if(dest_y >= QTVideoHeight)
-    break;
+  job->LineWidths[y] = width;
+  job->PixelsPitch = std::max<int32>(job->PixelsPitch, width);
+ }
 
-   if(VideoCodec == VCODEC_CSCD)
-    dest_line = &RawVideoBuffer[(QTVideoHeight - 1 - dest_y) * QTVideoWidth * 3];
-   else if(VideoCodec == VCODEC_PNG)
-    dest_line = &RawVideoBuffer[dest_y * (QTVideoWidth * 3 + 1)];
-   else
-    dest_line = &RawVideoBuffer[dest_y * QTVideoWidth * 3];
+ job->Pixels.resize(job->PixelsPitch * DisplayRect.h);
 
-   x_start = DisplayRect.x;
+ for(int y = 0; y < DisplayRect.h; y++)
+ {
+  const uint32* src_ptr = surface->pixels + (DisplayRect.y + y) * surface->pitchinpix + DisplayRect.x;
 
-   if(LineWidths[0] == ~0)
-    width = DisplayRect.w;
-   else
-    width = LineWidths[y];
+  memcpy(&job->Pixels[y * job->PixelsPitch], src_ptr, job->LineWidths[y] * sizeof(uint32));
+ }
 
-   xscale_factor = QTVideoWidth / width;
+ job->SoundBuf.assign(SoundBuf, SoundBuf + SoundBufSize * SoundChan);
+ job->SoundBufSize = SoundBufSize;
+ job->MasterCycles = MasterCycles;
 
-   dest_x = 0;
+ MThreading::Mutex_Lock(QueueMutex);
+ EncodeQueue.push_back(job);
+ WriteQueue.push_back(job);
+ MThreading::Mutex_Unlock(QueueMutex);
+ MThreading::Sem_Post(EncodeSem);
 
-   src_ptr = surface->pixels + y * surface->pitchinpix + x_start;
+ {
+  const uint64 stall_time = Time::MonoUS() - stall_start;
 
-   if(VideoCodec == VCODEC_PNG)
-   {
-    *dest_line = 0;
-    dest_line++;
-   }
+  BenchFrames++;
+  BenchWaits += wait;
+  BenchStallTime += stall_time;
+  BenchMaxStallTime = std::max<uint64>(BenchMaxStallTime, stall_time);
 
-#if 0
-   while(dest_x < ((QTVideoWidth - (xscale_factor * width)) / 2))
-   {
-    dest_line[dest_x * 3 + 0] = 0;
-    dest_line[dest_x * 3 + 1] = 0;
-    dest_line[dest_x * 3 + 2] = 0;
+  if(Bench && !(BenchFrames % 600))
+   PrintBench();
+ }
+}
 
-    dest_x++;
-   }
-#endif
+void QTRecord::PrintBench(void)
+{
+ uint64 encode_time, write_time;
+
+ // No lock needed once Finish() has stopped the threads.
+ if(QueueMutex)
+  MThreading::Mutex_Lock(QueueMutex);
+ encode_time = BenchEncodeTime;
+ write_time = BenchWriteTime;
+ if(QueueMutex)
+  MThreading::Mutex_Unlock(QueueMutex);
+
+ if(!BenchFrames)
+  return;
+
+ printf("QTRecord: %llu frames; emulation thread stall per frame: %.1f us average, %llu us worst, %llu frames waited for a free buffer; "
+	"per frame on the %u encoder threads: %.1f us, on the writer thread: %.1f us\n",
+	(unsigned long long)BenchFrames, (double)BenchStallTime / BenchFrames, (unsigned long long)BenchMaxStallTime, (unsigned long long)BenchWaits,
+	NumEncoderThreads, (double)encode_time / BenchFrames, (double)write_time / BenchFrames);
+}
+
+// Converts the frame to 24-bit RGB(BGR, bottom line first, for CSCD), each line preceded by a 0 filter type byte for PNG.
+void QTRecord::ConvertFrame(const FrameJob* job, uint8* raw) const
+{
+ const MDFN_Rect& DisplayRect = job->DisplayRect;
+ uint32 dest_y = 0;
+ int yscale_factor = QTVideoHeight / DisplayRect.h;
+
+ for(int y = 0; y < DisplayRect.h; y++)
+ {
+  int width;
+  int xscale_factor;
+  uint32 dest_x;
+  const uint32 *src_ptr;
+  uint8 *dest_line;
+
+  if(dest_y >= QTVideoHeight)
+   break;
+
+  if(VideoCodec == VCODEC_CSCD)
+   dest_line = &raw[(QTVideoHeight - 1 - dest_y) * QTVideoWidth * 3];
+  else if(VideoCodec == VCODEC_PNG)
+   dest_line = &raw[dest_y * (QTVideoWidth * 3 + 1)];
+  else
+   dest_line = &raw[dest_y * QTVideoWidth * 3];
+
+  width = job->LineWidths[y];
+
+  xscale_factor = QTVideoWidth / width;
+
+  dest_x = 0;
+
+  src_ptr = &job->Pixels[y * job->PixelsPitch];
 
-   for(int x = x_start; x < x_start + width; x++)
+  if(VideoCodec == VCODEC_PNG)
+  {
+   *dest_line = 0;
+   dest_line++;
+  }
+
+  for(int x = 0; x < width; x++)
+  {
+   for(int sub_x = 0; sub_x < xscale_factor; sub_x++)
    {
-    for(int sub_x = 0; sub_x < xscale_factor; sub_x++)
+    if(dest_x < QTVideoWidth)
     {
-     if(dest_x < QTVideoWidth)
+     int r, g, b, a;
+
+     job->Format.DecodeColor(*src_ptr, r, g, b, a);
+
+     if(VideoCodec == VCODEC_CSCD)
      {
-      int r, g, b, a;
-
-      surface->DecodeColor(*src_ptr, r, g, b, a);
-
-      if(VideoCodec == VCODEC_CSCD)
-      {
-       dest_line[dest_x * 3 + 0] = b;
-       dest_line[dest_x * 3 + 1] = g;
-       dest_line[dest_x * 3 + 2] = r;
-      }
-      else
-      {
-       dest_line[dest_x * 3 + 0] = r;
-       dest_line[dest_x * 3 + 1] = g;
-       dest_line[dest_x * 3 + 2] = b;
-      }
-
-      dest_x++;
+      dest_line[dest_x * 3 + 0] = b;
+      dest_line[dest_x * 3 + 1] = g;
+      dest_line[dest_x * 3 + 2] = r;
      }
+     else
+     {
+      dest_line[dest_x * 3 + 0] = r;
+      dest_line[dest_x * 3 + 1] = g;
+      dest_line[dest_x * 3 + 2] = b;
+     }
+
+     dest_x++;
     }
-    src_ptr++;
    }
+   src_ptr++;
+  }
 
-   while(dest_x < QTVideoWidth)
-   {
-    dest_line[dest_x * 3 + 0] = 0;
-    dest_line[dest_x * 3 + 1] = 0;
-    dest_line[dest_x * 3 + 2] = 0;
+  while(dest_x < QTVideoWidth)
+  {
+   dest_line[dest_x * 3 + 0] = 0;
+   dest_line[dest_x * 3 + 1] = 0;
+   dest_line[dest_x * 3 + 2] = 0;
 
-    dest_x++;
-   }
+   dest_x++;
+  }
 
-   for(int sub_y = 1; sub_y < yscale_factor; sub_y++)
-   {
-    if((dest_y + sub_y) >= QTVideoHeight)
-     break;
-
-    if(VideoCodec == VCODEC_CSCD)
-     memcpy(&RawVideoBuffer[(QTVideoHeight - 1 - (dest_y + sub_y)) * QTVideoWidth * 3], dest_line, QTVideoWidth * 3);
-    else if(VideoCodec == VCODEC_PNG)
-     memcpy(&RawVideoBuffer[(dest_y + sub_y) * (QTVideoWidth * 3 + 1)], dest_line - 1, QTVideoWidth * 3 + 1);
-    else
-     memcpy(&RawVideoBuffer[(dest_y + sub_y) * QTVideoWidth * 3], dest_line, QTVideoWidth * 3);
-   }
+  for(int sub_y = 1; sub_y < yscale_factor; sub_y++)
+  {
+   if((dest_y + sub_y) >= QTVideoHeight)
+    break;
+
+   if(VideoCodec == VCODEC_CSCD)
+    memcpy(&raw[(QTVideoHeight - 1 - (dest_y + sub_y)) * QTVideoWidth * 3], dest_line, QTVideoWidth * 3);
+   else if(VideoCodec == VCODEC_PNG)
+    memcpy(&raw[(dest_y + sub_y) * (QTVideoWidth * 3 + 1)], dest_line - 1, QTVideoWidth * 3 + 1);
+   else
+    memcpy(&raw[(dest_y + sub_y) * QTVideoWidth * 3], dest_line, QTVideoWidth * 3);
+  }
 
-   dest_y += yscale_factor;
-  } // end for(int y = DisplayRect.y; y < DisplayRect.y + DisplayRect.h; y++)
+  dest_y += yscale_factor;
+ } // end for(int y = 0; y < DisplayRect.h; y++)
+
+ // Clear any lines the frame doesn't reach; the buffer may hold some other frame.
+ for(; dest_y < QTVideoHeight; dest_y++)
+ {
+  if(VideoCodec == VCODEC_CSCD)
+   memset(&raw[(QTVideoHeight - 1 - dest_y) * QTVideoWidth * 3], 0, QTVideoWidth * 3);
+  else if(VideoCodec == VCODEC_PNG)
+   memset(&raw[dest_y * (QTVideoWidth * 3 + 1)], 0, QTVideoWidth * 3 + 1);
+  else
+   memset(&raw[dest_y * QTVideoWidth * 3], 0, QTVideoWidth * 3);
  }
+}
 
- if(VideoCodec == VCODEC_CSCD)
+// Same as PNGWrite::WriteChunk(), into memory; data may already be in place at dest + 8.
+static uint32 PutPNGChunk(uint8* dest, const char* type, const uint8* data, uint32 size)
+{
+ uint32 crc;
+
+ MDFN_en32msb(&dest[0], size);
+ memcpy(&dest[4], type, 4);
+
+ if(size && data != &dest[8])
+  memmove(&dest[8], data, size);
+
+ crc = crc32(0, (const uint8*)type, 4);
+ if(size)
+  crc = crc32(crc, &dest[8], size);
+
+ MDFN_en32msb(&dest[8 + size], crc);
+
+ return 12 + size;
+}
+
+void QTRecord::EncodeFrame(EncoderThreadS* et, FrameJob* job) const
+{
+ if(VideoCodec == VCODEC_RAW)
  {
-  static uint8 workmem[LZO1X_1_MEM_COMPRESS];
-  lzo_uint dst_len = CompressedVideoBuffer.size();
-  uint8 tmp[2];
+  ConvertFrame(job, &job->Encoded[0]);
+  job->EncodedSize = RawVideoSize;
+  return;
+ }
+
+ ConvertFrame(job, &et->RawVideoBuffer[0]);
 
-  tmp[0] = (0 << 1) | 0x1;
-  tmp[1] = 0;
+ if(VideoCodec == VCODEC_CSCD)
+ {
+  lzo_uint dst_len = job->Encoded.size() - 2;
 
-  qtfile.write(tmp, 2);
+  job->Encoded[0] = (0 << 1) | 0x1;
+  job->Encoded[1] = 0;
 
-  lzo1x_1_compress(&RawVideoBuffer[0], RawVideoBuffer.size(), &CompressedVideoBuffer[0], &dst_len, workmem);
+  lzo1x_1_compress(&et->RawVideoBuffer[0], RawVideoSize, &job->Encoded[2], &dst_len, et->LZOWorkMem.get());
 
-  qtfile.write(&CompressedVideoBuffer[0], dst_len);
+  job->EncodedSize = 2 + dst_len;
  }
- else if(VideoCodec == VCODEC_RAW)
-  qtfile.write(&RawVideoBuffer[0], RawVideoBuffer.size());
  else if(VideoCodec == VCODEC_PNG)
  {
-  //PNGWrite(qtfile, surface, DisplayRect, LineWidths);
   static const uint8 png_sig[8] = { 137, 80, 78, 71, 13, 10, 26, 10 };
+  uint8* const d = &job->Encoded[0];
+  uint32 offs = 0;
   uint8 IHDR[13];
   uLongf compress_buffer_size;
 
-  qtfile.write(png_sig, sizeof(png_sig));
+  memcpy(&d[offs], png_sig, sizeof(png_sig));
+  offs += sizeof(png_sig);
 
   MDFN_en32msb(&IHDR[0], QTVideoWidth);
   MDFN_en32msb(&IHDR[4], QTVideoHeight);
@@ -425,19 +773,30 @@ void QTRecord::WriteFrame(const MDFN_Surface *surface, const MDFN_Rect &DisplayR
   IHDR[11] = 0;	// Basic adaptive filter set
   IHDR[12] = 0;	// No interlace
 
+  offs += PutPNGChunk(&d[offs], "IHDR", IHDR, sizeof(IHDR));
 
-  PNGWrite::WriteChunk(qtfile, 13, "IHDR", IHDR);
-
-  compress_buffer_size = CompressedVideoBuffer.size();
+  // Straight into the IDAT chunk, leaving room for IDAT's CRC and IEND.
+  compress_buffer_size = job->Encoded.size() - offs - 12 - 12;
 
-  compress(&CompressedVideoBuffer[0], &compress_buffer_size, &RawVideoBuffer[0], RawVideoBuffer.size());
+  compress(&d[offs + 8], &compress_buffer_size, &et->RawVideoBuffer[0], RawVideoSize);
 
-  PNGWrite::WriteChunk(qtfile, compress_buffer_size, "IDAT", &CompressedVideoBuffer[0]);
+  offs += PutPNGChunk(&d[offs], "IDAT", &d[offs + 8], compress_buffer_size);
+  offs += PutPNGChunk(&d[offs], "IEND", NULL, 0);
 
-  PNGWrite::WriteChunk(qtfile, 0, "IEND", 0);
+  job->EncodedSize = offs;
  }
+}
+
+// Writer thread
+void QTRecord::WriteFrameData(FrameJob* job)
+{
+ QTChunk qts;
 
+ memset(&qts, 0, sizeof(qts));
+
+ qts.video_foffset = qtfile.tell();
 
+ qtfile.write(&job->Encoded[0], job->EncodedSize);
 
  qts.video_byte_size = qtfile.tell() - qts.video_foffset;
 
@@ -448,6 +807,8 @@ void QTRecord::WriteFrame(const MDFN_Surface *surface, const MDFN_Rect &DisplayR
  // Write audio here
  //
  //
+ const int16* const SoundBuf = job->SoundBuf.data();
+ const int32 SoundBufSize = job->SoundBufSize;
  int32 SoundBufROSize;
 
  if(resampler)
@@ -522,7 +883,7 @@ void QTRecord::WriteFrame(const MDFN_Surface *surface, const MDFN_Rect &DisplayR
  {
   uint64 tnt;
  
-  MCAccum += (uint64)MasterCycles * TimeScale;
+  MCAccum += (uint64)job->MasterCycles * TimeScale;
   tnt = MCAccum / (MC >> 32);
   MCAccum %= (MC >> 32);
 
@@ -1066,6 +1427,22 @@ void QTRecord::Finish(void)
 
  Finished = true;
 
+ // Blocks until everything queued is written.
+ StopThreads();
+
+ if(Bench)
+  PrintBench();
+
+ if(WriteError.size())
+ {
+  // WriteFrame() already threw it, don't bother with a moov atom for a broken file.
+  if(WriteErrorThrown)
+   return;
+
+  WriteErrorThrown = true;
+  throw MDFN_Error(0, "%s", WriteError.c_str());
+ }
+
  atom_end();
 
  Write_moov();
@@ -23,8 +23,11 @@
 #define __MDFN_QTRECORD_H
 
 #include <mednafen/FileStream.h>
+#include <mednafen/MThreading.h>
 #include "resampler/resampler.h"
 
+#include <deque>
+
 namespace Mednafen
 {
 
@@ -53,8 +56,13 @@ class QTRecord
   int64 MasterClock;	// Fixed-point, 32.32, should be used when SoundRate == 0
 
   int VideoCodec;
+
+  uint32 EncoderThreads;	// 0 for one per CPU core but one, up to MaxEncoderThreads
+  bool Bench;		// Print emulation thread stall statistics to stdout
  };
 
+ enum { MaxEncoderThreads = 8 };
+
  QTRecord(const std::string& path, const VideoSpec &spec_arg);
  void Finish();
  ~QTRecord();
@@ -63,6 +71,46 @@ class QTRecord
                           const int16 *SoundBuf, const int32 SoundBufSize, const int64 MasterCycles);
  private:
 
+ //
+ // WriteFrame() copies the frame and sound into a FrameJob from a fixed pool and queues it, waiting only when the whole pool
+ // is in use.  The encoder threads convert and compress the queued frames in parallel, and the writer thread writes them
+ // to the mdat atom in the order they were queued, resampling the sound as it goes.
+ //
+ struct FrameJob
+ {
+  // Filled in by WriteFrame()
+  MDFN_PixelFormat Format;
+  MDFN_Rect DisplayRect;
+  std::vector<uint32> Pixels;		// DisplayRect.h lines, PixelsPitch pixels apart, starting at DisplayRect.x
+  uint32 PixelsPitch;
+  std::vector<int32> LineWidths;	// Width of each line in Pixels
+  std::vector<int16> SoundBuf;
+  int32 SoundBufSize;
+  int64 MasterCycles;
+
+  // Filled in by the encoder thread
+  std::vector<uint8> Encoded;		// Video sample, EncodedSize bytes
+  uint32 EncodedSize;
+  bool IsEncoded;
+ };
+
+ struct EncoderThreadS
+ {
+  QTRecord* qt = nullptr;
+  MThreading::Thread* Thread = nullptr;
+  std::vector<uint8> RawVideoBuffer;
+  std::unique_ptr<uint8[]> LZOWorkMem;
+ };
+
+ static int EncoderThreadEntry(void* data);
+ static int WriterThreadEntry(void* data);
+ void StartThreads(unsigned num_encoders);
+ void StopThreads(void);
+ void ConvertFrame(const FrameJob* job, uint8* raw) const;
+ void EncodeFrame(EncoderThreadS* et, FrameJob* job) const;
+ void WriteFrameData(FrameJob* job);
+ void PrintBench(void);
+
  void w8(uint8 val);
  void w16(uint16 val);
  void w32(uint32 val);
@@ -102,8 +150,32 @@ class QTRecord
 
  FileStream qtfile;
 
- std::vector<uint8> RawVideoBuffer;
- std::vector<uint8> CompressedVideoBuffer;
+ uint32 RawVideoSize;
+
+ EncoderThreadS EncoderThreads[MaxEncoderThreads];
+ unsigned NumEncoderThreads;
+ MThreading::Thread* WriterThread;
+
+ // QueueMutex protects the queues, IsEncoded, WriterExit, WriteError and the Bench*Time statistics.
+ MThreading::Mutex* QueueMutex;
+ MThreading::Sem* FreeSem;	// Posted for each job put in FreeJobs
+ MThreading::Sem* EncodeSem;	// Posted for each job put in EncodeQueue, and once per encoder thread to stop it
+ MThreading::Sem* WriteSem;	// Posted for each job encoded, and to stop the writer thread
+ std::vector<std::unique_ptr<FrameJob>> Jobs;
+ std::vector<FrameJob*> FreeJobs;
+ std::deque<FrameJob*> EncodeQueue;
+ std::deque<FrameJob*> WriteQueue;	// In the order of WriteFrame() calls
+ bool WriterExit;
+ std::string WriteError;
+ bool WriteErrorThrown;
+
+ bool Bench;
+ uint64 BenchFrames;
+ uint64 BenchWaits;
+ uint64 BenchStallTime;
+ uint64 BenchMaxStallTime;
+ uint64 BenchEncodeTime;
+ uint64 BenchWriteTime;
 
  std::list<bool> atom_smalls;
  std::list<uint64> atom_foffsets;
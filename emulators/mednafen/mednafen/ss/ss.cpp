@@ -8525,6 +8525,7 @@ static void MDFN_COLD InitCommon(const unsigned cpucache_emumode, const unsigned
  int sls = MDFN_GetSettingI(PAL ? "ss.slstartp" : "ss.slstart");
  int sle = MDFN_GetSettingI(PAL ? "ss.slendp" : "ss.slend");
  const uint64 vdp2_affinity = MDFN_GetSettingUI("ss.affinity.vdp2");
+ const unsigned vdp2_threads = MDFN_GetSettingUI("ss.vdp2_threads");
 
  if(PAL)
  {
@@ -8595,7 +8596,7 @@ static void MDFN_COLD InitCommon(const unsigned cpucache_emumode, const unsigned
  SCU_Init();
  SMPC_Init(smpc_area, MasterClock);
  VDP1::Init();
- VDP2::Init(PAL, vdp2_affinity);
+ VDP2::Init(PAL, vdp2_affinity, vdp2_threads, MDFN_GetSettingB("ss.dbg_vdp2_bench"), MDFN_GetSettingB("ss.dbg_vdp2_verify"));
  CDB_Init();
  SOUND_Init();
 
@@ -9428,12 +9429,16 @@ static const MDFNSetting SSSettings[] =
  { "ss.slstartp", MDFNSF_NOFLAGS, gettext_noop("First displayed scanline in PAL mode."), NULL, MDFNST_INT, "0", "-16", "271" },
  { "ss.slendp", MDFNSF_NOFLAGS, gettext_noop("Last displayed scanline in PAL mode."), NULL, MDFNST_INT, "255", "-16", "271" },
 
- { "ss.affinity.vdp2", MDFNSF_NOFLAGS, gettext_noop("VDP2 rendering thread CPU affinity mask."), gettext_noop("Set to 0 to disable changing affinity."), MDFNST_UINT, "0", "0x0000000000000000", "0xFFFFFFFFFFFFFFFF" },
+ { "ss.vdp2_threads", MDFNSF_NOFLAGS, gettext_noop("Number of VDP2 rendering threads."), gettext_noop("Each thread draws its own bands of scanlines.  The output is the same regardless of the number of threads, but more than one thread is only beneficial on hosts with plenty of idle CPU cores."), MDFNST_UINT, "1", "1", "8" },
+ { "ss.affinity.vdp2", MDFNSF_NOFLAGS, gettext_noop("VDP2 rendering thread(s) CPU affinity mask."), gettext_noop("Set to 0 to disable changing affinity."), MDFNST_UINT, "0", "0x0000000000000000", "0xFFFFFFFFFFFFFFFF" },
 
 #ifdef MDFN_ENABLE_DEV_BUILD
  { "ss.dbg_mask", MDFNSF_SUPPRESS_DOC, gettext_noop("Debug printf mask."), NULL, MDFNST_MULTI_ENUM, "none", NULL, NULL, NULL, NULL, DBGMask_List },
 #endif
 
+ { "ss.dbg_vdp2_bench", MDFNSF_SUPPRESS_DOC | MDFNSF_NONPERSISTENT, gettext_noop("Print VDP2 render thread timing statistics at exit."), gettext_noop("Intended for comparing ss.vdp2_threads values over the same movie playback."), MDFNST_BOOL, "0" },
+ { "ss.dbg_vdp2_verify", MDFNSF_SUPPRESS_DOC | MDFNSF_NONPERSISTENT, gettext_noop("Check multithreaded VDP2 rendering against a single-threaded render of every line."), gettext_noop("An extra render thread draws each line the single-threaded way; mismatched lines are counted and reported at exit."), MDFNST_BOOL, "0" },
+
  { "ss.dbg_exe_cdpath", MDFNSF_SUPPRESS_DOC | MDFNSF_CAT_PATH, gettext_noop("CD image to use with bootable cart ROM image loading."), NULL, MDFNST_STRING, "" },
  { "ss.dbg_exe_cem", MDFNSF_SUPPRESS_DOC | MDFNSF_NONPERSISTENT, gettext_noop("Cache emulation mode to use with bootable cart ROM image loading."), NULL, MDFNST_ENUM, "data", NULL, NULL, NULL, NULL, CEM_List },
  { "ss.dbg_exe_hh", MDFNSF_SUPPRESS_DOC | MDFNSF_NONPERSISTENT, gettext_noop("Horrible hacks to use with bootable cart ROM image loading."), NULL, MDFNST_MULTI_ENUM, "none", NULL, NULL, NULL, NULL, HH_List },
@@ -884,7 +884,7 @@ void AdjustTS(const int32 delta)
 }
 
 
-void Init(const bool IsPAL, const uint64 affinity)
+void Init(const bool IsPAL, const uint64 affinity, const unsigned num_threads, const bool bench, const bool verify)
 {
  SurfInterlaceField = -1;
  PAL = IsPAL;
@@ -896,7 +896,7 @@ void Init(const bool IsPAL, const uint64 affinity)
 
  ExLatchIn = false;
 
- VDP2REND_Init(IsPAL, affinity);
+ VDP2REND_Init(IsPAL, VRAM, affinity, num_threads, bench, verify);
 }
 
 void SetGetVideoParams(MDFNGI* gi, const bool caspect, const int sls, const int sle, const bool show_h_overscan, const bool dohblend)
@@ -48,16 +48,9 @@ static uint32 NextOutLine;
 static bool Clock28M;
 static unsigned VisibleLines;
 static VDP2Rend_LIB LIB[256];
-static uint16 VRAM[262144];
-static uint16 CRAM[2048];
 
-static uint8 HRes, VRes;
-static bool BorderMode;
-static uint8 InterlaceMode;
 enum { IM_NONE, IM_ILLEGAL, IM_SINGLE, IM_DOUBLE };
 
-static bool CRKTE;
-static uint8 CRAM_Mode;
 enum
 {
  CRAM_MODE_RGB555_1024	= 0,
@@ -65,140 +58,161 @@ enum
  CRAM_MODE_RGB888_1024	= 2,
  CRAM_MODE_ILLEGAL	= 3
 };
-static uint8 VRAM_Mode;
-static uint8 RDBS_Mode;
 
-static uint8 VCPRegs[4][8];
 static const uint16 DummyTileNT[8 * 8 * 4 / sizeof(uint16)] = { 0 };
 
-static uint32 UserLayerEnableMask;
-//
+enum
+{
+ WINLAYER_NBG0 = 0,
+ WINLAYER_NBG1 = 1,
+ WINLAYER_NBG2 = 2,
+ WINLAYER_NBG3 = 3,
+ WINLAYER_RBG0 = 4,
+ WINLAYER_SPRITE = 5,
+ WINLAYER_ROTPARAM = 6,
+ WINLAYER_CC = 7,
+};
+
 //
+// The decoded registers, and the state carried over from line to line.  Each render thread has its own copy(as part of RenderS); with more
+// than one render thread, the emulation thread keeps one more, to set up each line before it's queued(see VDP2REND_DrawLine()).
 //
-static uint16 BGON;
-static uint16 MZCTL;
-static uint8 MosaicVCount;
+struct RegStateS
+{
+ void RegsWrite(uint32 A, uint16 V);
+ void Reset(void);
 
-static uint8 SFSEL;
-static uint16 SFCODE;
+ void BeginLine(const uint16* VRAM, const uint16 vdp2_line, const bool field);
+ void EndLine(const uint16 vdp2_line);
+ void FetchVCScroll(const uint16* VRAM, const unsigned w);
+ //
+ //
+ //
+ uint8 HRes, VRes;
+ bool BorderMode;
+ uint8 InterlaceMode;
 
-static uint16 CHCTLA;
-static uint16 CHCTLB;
+ bool CRKTE;
+ uint8 CRAM_Mode;
+ uint8 VRAM_Mode;
+ uint8 RDBS_Mode;
 
-static uint16 BMPNA;
-static uint8 BMPNB;
+ uint8 VCPRegs[4][8];
+ //
+ //
+ //
+ uint16 BGON;
+ uint16 MZCTL;
+ uint8 MosaicVCount;
 
-static uint16 PNCN[4];
-static uint16 PNCNR;
+ uint8 SFSEL;
+ uint16 SFCODE;
 
-static uint16 PLSZ;
-static uint16 MPOFN;
-static uint16 MPOFR;
+ uint16 CHCTLA;
+ uint16 CHCTLB;
 
-static uint8 MapRegs[4][4];
-static uint8 RotMapRegs[2][16];
-//
-static uint16 XScrollI[4], YScrollI[4];
-static uint8 XScrollF[2], YScrollF[2];
-
-static uint16 ZMCTL;
-static uint16 SCRCTL;
-static uint32 LineScrollAddr[2];
-static uint32 VCScrollAddr;
-static uint32 VCLast[2];
-
-static uint16 XCoordInc[2], YCoordInc[2];
-static uint32 YCoordAccum[2];
-static uint32 MosEff_YCoordAccum[2];
-
-static uint32 CurXScrollIF[2];
-static uint32 CurYScrollIF[2];
-static uint16 CurXCoordInc[2];
-static uint32 CurLSA[2];
-
-static uint16 NBG23_YCounter[2];
-static uint16 MosEff_NBG23_YCounter[2];
-//
-static uint8 RPMD;
-static uint8 KTCTL[2];
-static uint16 OVPNR[2];
-//
-static uint32 BKTA;
-static uint32 CurBackTabAddr;
-static uint16 CurBackColor;
+ uint16 BMPNA;
+ uint8 BMPNB;
 
-static uint32 LCTA;
-static uint32 CurLCTabAddr;
-static uint16 CurLCColor;
+ uint16 PNCN[4];
+ uint16 PNCNR;
 
-static uint8 LineColorEn;
+ uint16 PLSZ;
+ uint16 MPOFN;
+ uint16 MPOFR;
 
-static uint16 SFPRMD;
-static uint16 CCCTL;
-static uint16 SFCCMD;
-//
-static uint8 NBGPrioNum[4];
-static uint8 RBG0PrioNum;
+ uint8 MapRegs[4][4];
+ uint8 RotMapRegs[2][16];
+ //
+ uint16 XScrollI[4], YScrollI[4];
+ uint8 XScrollF[2], YScrollF[2];
 
-static uint8 NBGCCRatio[4];
-static uint8 RBG0CCRatio;
-static uint8 LineColorCCRatio;
-static uint8 BackCCRatio;
+ uint16 ZMCTL;
+ uint16 SCRCTL;
+ uint32 LineScrollAddr[2];
+ uint32 VCScrollAddr;
+ uint32 VCLast[2];
 
-//
-static struct
-{
- uint16 XStart, XEnd;
- uint32 LineWinAddr;
- bool LineWinEn;
+ uint16 XCoordInc[2], YCoordInc[2];
+ uint32 YCoordAccum[2];
+ uint32 MosEff_YCoordAccum[2];
+
+ uint32 CurXScrollIF[2];
+ uint32 CurYScrollIF[2];
+ uint16 CurXCoordInc[2];
+ uint32 CurLSA[2];
+
+ uint16 NBG23_YCounter[2];
+ uint16 MosEff_NBG23_YCounter[2];
+ //
+ uint8 RPMD;
+ uint8 KTCTL[2];
+ uint16 OVPNR[2];
  //
- bool YMet;
- uint16 CurXStart, CurXEnd;
- uint32 CurLineWinAddr;
-} Window[2];
+ uint32 BKTA;
+ uint32 CurBackTabAddr;
+ uint16 CurBackColor;
 
-static uint8 WinControl[8];
-enum
-{
- WINLAYER_NBG0 = 0,
- WINLAYER_NBG1 = 1,
- WINLAYER_NBG2 = 2,
- WINLAYER_NBG3 = 3,
- WINLAYER_RBG0 = 4,
- WINLAYER_SPRITE = 5,
- WINLAYER_ROTPARAM = 6,
- WINLAYER_CC = 7,
-};
+ uint32 LCTA;
+ uint32 CurLCTabAddr;
+ uint16 CurLCColor;
 
-static std::array<unsigned, 5> WinPieces;
-//
-static uint8 SpriteCCCond;
-static uint8 SpriteCCNum;
-static uint8 SPCTL_Low;
+ uint8 LineColorEn;
 
-static uint16 SDCTL;
+ uint16 SFPRMD;
+ uint16 CCCTL;
+ uint16 SFCCMD;
+ //
+ uint8 NBGPrioNum[4];
+ uint8 RBG0PrioNum;
 
-static uint8 SpritePrioNum[8];
-static uint8 SpriteCCRatio[8];
+ uint8 NBGCCRatio[4];
+ uint8 RBG0CCRatio;
+ uint8 LineColorCCRatio;
+ uint8 BackCCRatio;
 
-static uint8 SpriteCCLUT[8];	// Temp optimization data
-static uint8 SpriteCC3Mask; 	// Temp optimization data
+ //
+ struct
+ {
+  uint16 XStart, XEnd;
+  uint32 LineWinAddr;
+  bool LineWinEn;
+  //
+  bool YMet;
+  uint16 CurXStart, CurXEnd;
+  uint32 CurLineWinAddr;
+ } Window[2];
 
-//
-static uint8 CRAMAddrOffs_NBG[4];
-static uint8 CRAMAddrOffs_RBG0;
-static uint8 CRAMAddrOffs_Sprite;
-//
-static uint8 ColorOffsEn;
-static uint8 ColorOffsSel;
+ uint8 WinControl[8];
+
+ std::array<unsigned, 5> WinPieces;
+ uint16 vcscr[2][88 + 1 + 1];	// + 1 for fine x scroll != 0, + 1 for pointer shenanigans in FetchVCScroll
+ //
+ uint8 SpriteCCCond;
+ uint8 SpriteCCNum;
+ uint8 SPCTL_Low;
+
+ uint16 SDCTL;
 
-//enum
-//{
-// COLOFFS_ENSEL_NBG0 = 0,
-// COLOFFS_ENSEL_NBG1 = 0,
-//};
+ uint8 SpritePrioNum[8];
+ uint8 SpriteCCRatio[8];
 
-static int32 ColorOffs[2][3];	// [A,B] [R << 0, G << 8, B << 16]
+ //
+ uint8 CRAMAddrOffs_NBG[4];
+ uint8 CRAMAddrOffs_RBG0;
+ uint8 CRAMAddrOffs_Sprite;
+ //
+ uint8 ColorOffsEn;
+ uint8 ColorOffsSel;
+
+ //enum
+ //{
+ // COLOFFS_ENSEL_NBG0 = 0,
+ // COLOFFS_ENSEL_NBG1 = 0,
+ //};
+
+ int32 ColorOffs[2][3];	// [A,B] [R << 0, G << 8, B << 16]
+};
 
 template<bool IsRot>
 struct TileFetcher
@@ -235,7 +249,7 @@ struct TileFetcher
  // n=0...3, NBG0...3
  // n=4, RBG0
  // n=5, RBG1
- INLINE void Start(const unsigned n, const bool bmen, const unsigned map_offset, const uint8* map_regs)
+ INLINE void Start(const RegStateS* rs, const unsigned n, const bool bmen, const unsigned map_offset, const uint8* map_regs)
  {
   BMOffset = map_offset << 16;
   BMWShift = ((BMSize & 2) ? 10 : 9);
@@ -271,15 +285,15 @@ struct TileFetcher
   // Kludgeyness:
   for(unsigned bank = 0; bank < 4; bank++)
   {
-   const unsigned esb = bank & (2 | ((VRAM_Mode >> (bank >> 1)) & 1));
-   const uint8 rdbs = (RDBS_Mode >> (esb << 1)) & 0x3;
+   const unsigned esb = bank & (2 | ((rs->VRAM_Mode >> (bank >> 1)) & 1));
+   const uint8 rdbs = (rs->RDBS_Mode >> (esb << 1)) & 0x3;
 
    if(IsRot)
    {
-    if(!(BGON & 0x20) || n == 4)
+    if(!(rs->BGON & 0x20) || n == 4)
     {
-     nt_ok[bank] = (rdbs == RDBS_NAME) && (bank < 2 || !(BGON & 0x20));
-     cg_ok[bank] = (rdbs == RDBS_CHAR) && (bank < 2 || !(BGON & 0x20));
+     nt_ok[bank] = (rdbs == RDBS_NAME) && (bank < 2 || !(rs->BGON & 0x20));
+     cg_ok[bank] = (rdbs == RDBS_CHAR) && (bank < 2 || !(rs->BGON & 0x20));
     }
     else
     {
@@ -292,14 +306,14 @@ struct TileFetcher
     nt_ok[bank] = false;
     cg_ok[bank] = false;
 
-    if(!(BGON & 0x30) || rdbs == RDBS_UNUSED)
+    if(!(rs->BGON & 0x30) || rdbs == RDBS_UNUSED)
     {
-     for(unsigned ac = 0; ac < ((HRes & 0x6) ? 4 : 8); ac++)
+     for(unsigned ac = 0; ac < ((rs->HRes & 0x6) ? 4 : 8); ac++)
      {
-      if(VCPRegs[esb][ac] == (VCP_NBG0_CG + n))
+      if(rs->VCPRegs[esb][ac] == (VCP_NBG0_CG + n))
        cg_ok[bank] = true;
 
-      if(VCPRegs[esb][ac] == (VCP_NBG0_NT + n))
+      if(rs->VCPRegs[esb][ac] == (VCP_NBG0_NT + n))
        nt_ok[bank] = true;
      }
     }
@@ -325,7 +339,7 @@ struct TileFetcher
  uint32 cellx_xor;
 
  template<unsigned TA_bpp>
- INLINE bool Fetch(const bool bmen, const uint32 ix, const uint32 iy)
+ INLINE bool Fetch(const uint16* VRAM, const bool bmen, const uint32 ix, const uint32 iy)
  {
   size_t cg_addr;
   uint32 palno;
@@ -456,29 +470,6 @@ struct RotVars
  TileFetcher<true> tf;
 };
 
-static struct
-{
- uint64 spr[704];
- uint64 rbg0[704];
- union
- {
-  uint64 nbg[4][8 + 704 + 8];
-  struct
-  {
-   uint8 dummy[sizeof(nbg) / 2];
-   uint16 vcscr[2][88 + 1 + 1];	// + 1 for fine x scroll != 0, + 1 for pointer shenanigans in FetchVCScroll
-  };
-  struct
-  {
-   uint8 rotdummy[sizeof(nbg) / 4];
-   uint8 rotabsel[352];	// Also used as a scratch buffer in T_DrawRBG() to handle mosaic-related junk.
-   RotVars rotv[2];
-   uint32 rotcoeff[352];
-  };
- };
- alignas(16) uint8 lc[704];
-} LB;
-
 // ColorOffsEn, etc. ?...hmm, discrepancy with ColorCalcEn and LineColorEn...
 enum
 {
@@ -494,11 +485,79 @@ enum
  LAYER_SPRITE = 6,
 };
 
+//
+// A render thread's state; allocated on the heap by VDP2REND_Init(), one per render thread.
+//
+struct RenderS : public RegStateS
+{
+ void RegsWrite(uint32 A, uint16 V);
+ template<typename T> void MemW(uint32 A, const uint16 DB);
+ void Reset(bool powering_up);
+
+ void DrawLine(uint32* const line_target, int32* const line_width, const uint16 vdp2_line);
+
+ void CacheCRE(const unsigned cri);
+ void RecalcColorCache(void);
+
+ void GetCWV(const uint8 ctrl, const bool* const xmet, bool* cwv);
+ void GetWinRotAB(void);
+ void ApplyWin(const unsigned wlayer, uint64* buf);
+ void ApplyHMosaic(const unsigned layer, uint64* buf, const unsigned w);
+
+ template<unsigned TA_PrioMode, unsigned TA_CCMode> void MakeSFCodeLUT(const unsigned layer, int16* const sfcode_lut);
+ template<bool TA_bmen, unsigned TA_bpp, bool TA_isrgb, bool TA_igntp, unsigned TA_PrioMode, unsigned TA_CCMode, typename T> uint64 MakeNBGRBGPix(T& tf, const uint32 pix_base_or, const int16* sfcode_lut, const uint32 ix, const uint32 iy);
+ template<bool TA_bmen, unsigned TA_bpp, bool TA_isrgb, bool TA_igntp, unsigned TA_PrioMode, unsigned TA_CCMode> void T_DrawNBG(const unsigned n, uint64* bgbuf, const unsigned w, const uint32 pix_base_or);
+ template<bool TA_igntp, unsigned TA_PrioMode, unsigned TA_CCMode> uint64 MakeNBG23Pix(uint32 dcc, uint32 pbor, const int16* sfcode_lut, uint32 colcacheoffs);
+ template<unsigned TA_bpp, bool TA_igntp, unsigned TA_PrioMode, unsigned TA_CCMode> void T_DrawNBG23(const unsigned n, uint64* bgbuf, const unsigned w, const uint32 pix_base_or);
+
+ uint32 GetCoeffAddr(const unsigned i, uint32 offset);
+ uint32 ReadCoeff(const unsigned i, const uint32 addr);
+ template<typename T> void SetupRotVars(const T* rs, const unsigned rbg_w);
+ template<bool TA_bmen, unsigned TA_bpp, bool TA_isrgb, bool TA_igntp, unsigned TA_PrioMode, unsigned TA_CCMode> void T_DrawRBG(const bool rn, uint64* bgbuf, const unsigned w, const uint32 pix_base_or);
+ void RBGPP(const unsigned layer, uint64* buf, const unsigned rbg_w);
+
+ void MakeSpriteCCLUT(void);
+ template<bool TA_HiRes, bool TA_TPShadSel, unsigned TA_SPCTL_Low> void T_DrawSpriteData(const uint16* vdp1sb, const bool vdp1_hires8, unsigned w);
+
+ template<bool TA_rbg1en, unsigned TA_Special, bool TA_CCRTMD, bool TA_CCMD> void T_MixIt(uint32* target, const unsigned vdp2_line, const unsigned w, const uint32 back_rgb24, const uint64* blursrc);
+ int32 ApplyHBlend(uint32* const target, int32 w);
+
+ //
+ //
+ //
+ uint16 VRAM[262144];
+ uint16 CRAM[2048];
+
+ uint32 UserLayerEnableMask;
+
+ uint8 SpriteCCLUT[8];	// Temp optimization data
+ uint8 SpriteCC3Mask; 	// Temp optimization data
+
+ struct
+ {
+  uint64 spr[704];
+  uint64 rbg0[704];
+  union
+  {
+   uint64 nbg[4][8 + 704 + 8];
+   struct
+   {
+    uint8 rotdummy[sizeof(nbg) / 4];
+    uint8 rotabsel[352];	// Also used as a scratch buffer in T_DrawRBG() to handle mosaic-related junk.
+    RotVars rotv[2];
+    uint32 rotcoeff[352];
+   };
+  };
+  alignas(16) uint8 lc[704];
+ } LB;
+
+ uint32 ColorCache[2048];
+};
+
 //
 //
 //
-static uint32 ColorCache[2048];
-static void CacheCRE(const unsigned cri)
+void RenderS::CacheCRE(const unsigned cri)
 {
  if(CRAM_Mode & CRAM_MODE_RGB888_1024)
  {
@@ -516,7 +575,7 @@ static void CacheCRE(const unsigned cri)
  }
 }
 
-static void RecalcColorCache(void)
+void RenderS::RecalcColorCache(void)
 {
  if(CRAM_Mode & CRAM_MODE_RGB888_1024)
  {
@@ -535,7 +594,7 @@ static void RecalcColorCache(void)
 //
 // Register writes seem to always be 16-bit
 //
-static INLINE void RegsWrite(uint32 A, uint16 V)
+void RegStateS::RegsWrite(uint32 A, uint16 V)
 {
  A &= 0x1FE;
 
@@ -561,17 +620,10 @@ static INLINE void RegsWrite(uint32 A, uint16 V)
 	break;
 
   case 0x0E:
-	{
-	 const unsigned old_CRAM_Mode = CRAM_Mode;
-
-	 CRKTE = (V >> 15) & 0x1;
-	 CRAM_Mode = (V >> 12) & 0x3;;
-	 VRAM_Mode = (V >> 8) & 0x3;
-	 RDBS_Mode = V & 0xFF;
-
-	 if(old_CRAM_Mode != CRAM_Mode)
-	  RecalcColorCache();
-	}
+	CRKTE = (V >> 15) & 0x1;
+	CRAM_Mode = (V >> 12) & 0x3;;
+	VRAM_Mode = (V >> 8) & 0x3;
+	RDBS_Mode = V & 0xFF;
 	break;
   //
   case 0x10:
@@ -932,8 +984,18 @@ static INLINE void RegsWrite(uint32 A, uint16 V)
  }
 }
 
+INLINE void RenderS::RegsWrite(uint32 A, uint16 V)
+{
+ const unsigned old_CRAM_Mode = CRAM_Mode;
+
+ RegStateS::RegsWrite(A, V);
+
+ if(old_CRAM_Mode != CRAM_Mode)
+  RecalcColorCache();
+}
+
 template<typename T>
-static INLINE void MemW(uint32 A, const uint16 DB)
+INLINE void RenderS::MemW(uint32 A, const uint16 DB)
 {
  A &= 0x1FFFFF;
 
@@ -993,7 +1055,7 @@ static INLINE void MemW(uint32 A, const uint16 DB)
 }
 
 
-static void Reset(bool powering_up)
+void RenderS::Reset(bool powering_up)
 {
  if(powering_up)
  {
@@ -1002,6 +1064,11 @@ static void Reset(bool powering_up)
  }
  //
  //
+ RegStateS::Reset();
+}
+
+void RegStateS::Reset(void)
+{
  CRKTE = false;
  CRAM_Mode = 0;
  VRAM_Mode = 0;
@@ -1208,7 +1275,7 @@ enum
  //SPECIAL_CCALC_SHIFT = 63
 };
 
-static INLINE void GetCWV(const uint8 ctrl, const bool* const xmet, bool* cwv)
+INLINE void RenderS::GetCWV(const uint8 ctrl, const bool* const xmet, bool* cwv)
 {
  const bool logic = (ctrl >> 7) & 1;	// 0 = OR, 1 = AND
  const bool w_enable[2] = { (bool)(ctrl & 0x02), (bool)(ctrl & 0x08) };
@@ -1233,7 +1300,7 @@ static INLINE void GetCWV(const uint8 ctrl, const bool* const xmet, bool* cwv)
  }
 }
 
-static void GetWinRotAB(void)
+void RenderS::GetWinRotAB(void)
 {
  unsigned x = 0;
 
@@ -1263,7 +1330,7 @@ static void GetWinRotAB(void)
  }
 }
 
-static void ApplyWin(const unsigned wlayer, uint64* buf)
+void RenderS::ApplyWin(const unsigned wlayer, uint64* buf)
 {
  unsigned x = 0;
 
@@ -1326,7 +1393,7 @@ static void ApplyWin(const unsigned wlayer, uint64* buf)
 
 #pragma GCC push_options
 #pragma GCC optimize("no-unroll-loops,no-peel-loops,no-crossjumping")
-static NO_INLINE void ApplyHMosaic(const unsigned layer, uint64* buf, const unsigned w)
+NO_INLINE void RenderS::ApplyHMosaic(const unsigned layer, uint64* buf, const unsigned w)
 {
  if(!(MZCTL & (1U << layer)))
   return;
@@ -1372,7 +1439,7 @@ static NO_INLINE void ApplyHMosaic(const unsigned layer, uint64* buf, const unsi
 //	[Entry 44] [Entry 44] [Entry 0] [Entry 1]
 //
 
-static void FetchVCScroll(const unsigned w)
+void RegStateS::FetchVCScroll(const uint16* VRAM, const unsigned w)
 {
  const bool vcon[2] = { (bool)(SCRCTL & BGON & !(MZCTL & 0x1)), (bool)((SCRCTL >> 8) & (BGON >> 1) & !(MZCTL & 0x2) & 0x1) };
  const unsigned max_cyc = (HRes & 0x6) ? 4 : 8;
@@ -1419,7 +1486,7 @@ static void FetchVCScroll(const unsigned w)
    if(vcon[0])
    {
     if(cyc == 3)
-     LB.vcscr[0][tile] = ((base[0] + tmp[0]) >> 8);
+     vcscr[0][tile] = ((base[0] + tmp[0]) >> 8);
 
     if(cyc == 3)
      tmp[0] = VCLast[0];
@@ -1436,7 +1503,7 @@ static void FetchVCScroll(const unsigned w)
    if(vcon[1])
    {
     if(cyc == 4)
-     LB.vcscr[1][tile] = ((base[1] + tmp[1]) >> 8);
+     vcscr[1][tile] = ((base[1] + tmp[1]) >> 8);
 
     if(cyc == 4)
      tmp[1] = VCLast[1];
@@ -1455,7 +1522,7 @@ static void FetchVCScroll(const unsigned w)
 }
 
 template<unsigned TA_PrioMode, unsigned TA_CCMode>
-static INLINE void MakeSFCodeLUT(const unsigned layer, int16* const sfcode_lut)
+INLINE void RenderS::MakeSFCodeLUT(const unsigned layer, int16* const sfcode_lut)
 {
  const uint8 code = SFCODE >> (((SFSEL >> layer) & 1) << 3);
 
@@ -1482,7 +1549,7 @@ static INLINE uint32 rgb15_to_rgb24(uint16 src)
 }
 
 template<bool TA_bmen, unsigned TA_bpp, bool TA_isrgb, bool TA_igntp, unsigned TA_PrioMode, unsigned TA_CCMode, typename T>
-static INLINE uint64 MakeNBGRBGPix(T& tf, const uint32 pix_base_or, const int16* sfcode_lut, const uint32 ix, const uint32 iy)
+INLINE uint64 RenderS::MakeNBGRBGPix(T& tf, const uint32 pix_base_or, const int16* sfcode_lut, const uint32 ix, const uint32 iy)
 {
  uint32 cellx = (ix ^ tf.cellx_xor);
  const uint16* vrb = &tf.tile_vrb[((cellx * TA_bpp) >> 4)];
@@ -1549,7 +1616,7 @@ static INLINE uint64 MakeNBGRBGPix(T& tf, const uint32 pix_base_or, const int16*
 }
 
 template<bool TA_bmen, unsigned TA_bpp, bool TA_isrgb, bool TA_igntp, unsigned TA_PrioMode, unsigned TA_CCMode>
-static void T_DrawNBG(const unsigned n, uint64* bgbuf, const unsigned w, const uint32 pix_base_or)
+void RenderS::T_DrawNBG(const unsigned n, uint64* bgbuf, const unsigned w, const uint32 pix_base_or)
 {
  assert(n < 2);
  //
@@ -1575,7 +1642,7 @@ static void T_DrawNBG(const unsigned n, uint64* bgbuf, const unsigned w, const u
  tf.AuxMode = (PNCN[n] >> 14) & 1;
  tf.Supp = (PNCN[n] & 0x3FF); // Supplement bits when PNDSize == 1
  //
- tf.Start(n, TA_bmen, (MPOFN >> (n << 2)) & 0x7, MapRegs[n]);
+ tf.Start(this, n, TA_bmen, (MPOFN >> (n << 2)) & 0x7, MapRegs[n]);
 
  MakeSFCodeLUT<TA_PrioMode, TA_CCMode>(n, sfcode_lut);
 
@@ -1600,8 +1667,8 @@ static void T_DrawNBG(const unsigned n, uint64* bgbuf, const unsigned w, const u
   for(unsigned i = 0; MDFN_LIKELY(i < w); i++)
   {
    const uint32 ix = xc >> 8;
-   iy = LB.vcscr[n][i >> 3];
-   tf.Fetch<TA_bpp>(TA_bmen, ix, iy);
+   iy = vcscr[n][i >> 3];
+   tf.Fetch<TA_bpp>(VRAM, TA_bmen, ix, iy);
    //
    //
    //
@@ -1620,9 +1687,9 @@ static void T_DrawNBG(const unsigned n, uint64* bgbuf, const unsigned w, const u
     prev_ix = ix >> 3;
     //
     if(VCSEn)
-     iy = LB.vcscr[n][(i + 7) >> 3];
+     iy = vcscr[n][(i + 7) >> 3];
 
-    tf.Fetch<TA_bpp>(TA_bmen, ix, iy);
+    tf.Fetch<TA_bpp>(VRAM, TA_bmen, ix, iy);
    }
    //
    //
@@ -1633,26 +1700,26 @@ static void T_DrawNBG(const unsigned n, uint64* bgbuf, const unsigned w, const u
  }
 }
 
-static void (*DrawNBG[2 /*bitmap enable*/][5/*col mode*/][2/*igntp*/][3/*priomode*/][4/*ccmode*/])(const unsigned n, uint64* bgbuf, const unsigned w, const uint32 pix_base_or) =
+static void (RenderS::*DrawNBG[2 /*bitmap enable*/][5/*col mode*/][2/*igntp*/][3/*priomode*/][4/*ccmode*/])(const unsigned n, uint64* bgbuf, const unsigned w, const uint32 pix_base_or) =
 {
  {
-  {  {  { T_DrawNBG<0, 4, 0, 0, 0, 0>, T_DrawNBG<0, 4, 0, 0, 0, 1>, T_DrawNBG<0, 4, 0, 0, 0, 2>, T_DrawNBG<0, 4, 0, 0, 0, 3>,  },  { T_DrawNBG<0, 4, 0, 0, 1, 0>, T_DrawNBG<0, 4, 0, 0, 1, 1>, T_DrawNBG<0, 4, 0, 0, 1, 2>, T_DrawNBG<0, 4, 0, 0, 1, 3>,  },  { T_DrawNBG<0, 4, 0, 0, 2, 0>, T_DrawNBG<0, 4, 0, 0, 2, 1>, T_DrawNBG<0, 4, 0, 0, 2, 2>, T_DrawNBG<0, 4, 0, 0, 2, 3>,  },  },  {  { T_DrawNBG<0, 4, 0, 1, 0, 0>, T_DrawNBG<0, 4, 0, 1, 0, 1>, T_DrawNBG<0, 4, 0, 1, 0, 2>, T_DrawNBG<0, 4, 0, 1, 0, 3>,  },  { T_DrawNBG<0, 4, 0, 1, 1, 0>, T_DrawNBG<0, 4, 0, 1, 1, 1>, T_DrawNBG<0, 4, 0, 1, 1, 2>, T_DrawNBG<0, 4, 0, 1, 1, 3>,  },  { T_DrawNBG<0, 4, 0, 1, 2, 0>, T_DrawNBG<0, 4, 0, 1, 2, 1>, T_DrawNBG<0, 4, 0, 1, 2, 2>, T_DrawNBG<0, 4, 0, 1, 2, 3>,  },  },  },
-  {  {  { T_DrawNBG<0, 8, 0, 0, 0, 0>, T_DrawNBG<0, 8, 0, 0, 0, 1>, T_DrawNBG<0, 8, 0, 0, 0, 2>, T_DrawNBG<0, 8, 0, 0, 0, 3>,  },  { T_DrawNBG<0, 8, 0, 0, 1, 0>, T_DrawNBG<0, 8, 0, 0, 1, 1>, T_DrawNBG<0, 8, 0, 0, 1, 2>, T_DrawNBG<0, 8, 0, 0, 1, 3>,  },  { T_DrawNBG<0, 8, 0, 0, 2, 0>, T_DrawNBG<0, 8, 0, 0, 2, 1>, T_DrawNBG<0, 8, 0, 0, 2, 2>, T_DrawNBG<0, 8, 0, 0, 2, 3>,  },  },  {  { T_DrawNBG<0, 8, 0, 1, 0, 0>, T_DrawNBG<0, 8, 0, 1, 0, 1>, T_DrawNBG<0, 8, 0, 1, 0, 2>, T_DrawNBG<0, 8, 0, 1, 0, 3>,  },  { T_DrawNBG<0, 8, 0, 1, 1, 0>, T_DrawNBG<0, 8, 0, 1, 1, 1>, T_DrawNBG<0, 8, 0, 1, 1, 2>, T_DrawNBG<0, 8, 0, 1, 1, 3>,  },  { T_DrawNBG<0, 8, 0, 1, 2, 0>, T_DrawNBG<0, 8, 0, 1, 2, 1>, T_DrawNBG<0, 8, 0, 1, 2, 2>, T_DrawNBG<0, 8, 0, 1, 2, 3>,  },  },  },
-  {  {  { T_DrawNBG<0, 16, 0, 0, 0, 0>, T_DrawNBG<0, 16, 0, 0, 0, 1>, T_DrawNBG<0, 16, 0, 0, 0, 2>, T_DrawNBG<0, 16, 0, 0, 0, 3>,  },  { T_DrawNBG<0, 16, 0, 0, 1, 0>, T_DrawNBG<0, 16, 0, 0, 1, 1>, T_DrawNBG<0, 16, 0, 0, 1, 2>, T_DrawNBG<0, 16, 0, 0, 1, 3>,  },  { T_DrawNBG<0, 16, 0, 0, 2, 0>, T_DrawNBG<0, 16, 0, 0, 2, 1>, T_DrawNBG<0, 16, 0, 0, 2, 2>, T_DrawNBG<0, 16, 0, 0, 2, 3>,  },  },  {  { T_DrawNBG<0, 16, 0, 1, 0, 0>, T_DrawNBG<0, 16, 0, 1, 0, 1>, T_DrawNBG<0, 16, 0, 1, 0, 2>, T_DrawNBG<0, 16, 0, 1, 0, 3>,  },  { T_DrawNBG<0, 16, 0, 1, 1, 0>, T_DrawNBG<0, 16, 0, 1, 1, 1>, T_DrawNBG<0, 16, 0, 1, 1, 2>, T_DrawNBG<0, 16, 0, 1, 1, 3>,  },  { T_DrawNBG<0, 16, 0, 1, 2, 0>, T_DrawNBG<0, 16, 0, 1, 2, 1>, T_DrawNBG<0, 16, 0, 1, 2, 2>, T_DrawNBG<0, 16, 0, 1, 2, 3>,  },  },  },
-  {  {  { T_DrawNBG<0, 16, 1, 0, 0, 0>, T_DrawNBG<0, 16, 1, 0, 0, 1>, T_DrawNBG<0, 16, 1, 0, 0, 2>, T_DrawNBG<0, 16, 1, 0, 0, 3>,  },  { T_DrawNBG<0, 16, 1, 0, 1, 0>, T_DrawNBG<0, 16, 1, 0, 1, 1>, T_DrawNBG<0, 16, 1, 0, 1, 2>, T_DrawNBG<0, 16, 1, 0, 1, 3>,  },  { T_DrawNBG<0, 16, 1, 0, 2, 0>, T_DrawNBG<0, 16, 1, 0, 2, 1>, T_DrawNBG<0, 16, 1, 0, 2, 2>, T_DrawNBG<0, 16, 1, 0, 2, 3>,  },  },  {  { T_DrawNBG<0, 16, 1, 1, 0, 0>, T_DrawNBG<0, 16, 1, 1, 0, 1>, T_DrawNBG<0, 16, 1, 1, 0, 2>, T_DrawNBG<0, 16, 1, 1, 0, 3>,  },  { T_DrawNBG<0, 16, 1, 1, 1, 0>, T_DrawNBG<0, 16, 1, 1, 1, 1>, T_DrawNBG<0, 16, 1, 1, 1, 2>, T_DrawNBG<0, 16, 1, 1, 1, 3>,  },  { T_DrawNBG<0, 16, 1, 1, 2, 0>, T_DrawNBG<0, 16, 1, 1, 2, 1>, T_DrawNBG<0, 16, 1, 1, 2, 2>, T_DrawNBG<0, 16, 1, 1, 2, 3>,  },  },  },
-  {  {  { T_DrawNBG<0, 32, 1, 0, 0, 0>, T_DrawNBG<0, 32, 1, 0, 0, 1>, T_DrawNBG<0, 32, 1, 0, 0, 2>, T_DrawNBG<0, 32, 1, 0, 0, 3>,  },  { T_DrawNBG<0, 32, 1, 0, 1, 0>, T_DrawNBG<0, 32, 1, 0, 1, 1>, T_DrawNBG<0, 32, 1, 0, 1, 2>, T_DrawNBG<0, 32, 1, 0, 1, 3>,  },  { T_DrawNBG<0, 32, 1, 0, 2, 0>, T_DrawNBG<0, 32, 1, 0, 2, 1>, T_DrawNBG<0, 32, 1, 0, 2, 2>, T_DrawNBG<0, 32, 1, 0, 2, 3>,  },  },  {  { T_DrawNBG<0, 32, 1, 1, 0, 0>, T_DrawNBG<0, 32, 1, 1, 0, 1>, T_DrawNBG<0, 32, 1, 1, 0, 2>, T_DrawNBG<0, 32, 1, 1, 0, 3>,  },  { T_DrawNBG<0, 32, 1, 1, 1, 0>, T_DrawNBG<0, 32, 1, 1, 1, 1>, T_DrawNBG<0, 32, 1, 1, 1, 2>, T_DrawNBG<0, 32, 1, 1, 1, 3>,  },  { T_DrawNBG<0, 32, 1, 1, 2, 0>, T_DrawNBG<0, 32, 1, 1, 2, 1>, T_DrawNBG<0, 32, 1, 1, 2, 2>, T_DrawNBG<0, 32, 1, 1, 2, 3>,  },  },  },
+  {  {  { &RenderS::T_DrawNBG<0, 4, 0, 0, 0, 0>, &RenderS::T_DrawNBG<0, 4, 0, 0, 0, 1>, &RenderS::T_DrawNBG<0, 4, 0, 0, 0, 2>, &RenderS::T_DrawNBG<0, 4, 0, 0, 0, 3>,  },  { &RenderS::T_DrawNBG<0, 4, 0, 0, 1, 0>, &RenderS::T_DrawNBG<0, 4, 0, 0, 1, 1>, &RenderS::T_DrawNBG<0, 4, 0, 0, 1, 2>, &RenderS::T_DrawNBG<0, 4, 0, 0, 1, 3>,  },  { &RenderS::T_DrawNBG<0, 4, 0, 0, 2, 0>, &RenderS::T_DrawNBG<0, 4, 0, 0, 2, 1>, &RenderS::T_DrawNBG<0, 4, 0, 0, 2, 2>, &RenderS::T_DrawNBG<0, 4, 0, 0, 2, 3>,  },  },  {  { &RenderS::T_DrawNBG<0, 4, 0, 1, 0, 0>, &RenderS::T_DrawNBG<0, 4, 0, 1, 0, 1>, &RenderS::T_DrawNBG<0, 4, 0, 1, 0, 2>, &RenderS::T_DrawNBG<0, 4, 0, 1, 0, 3>,  },  { &RenderS::T_DrawNBG<0, 4, 0, 1, 1, 0>, &RenderS::T_DrawNBG<0, 4, 0, 1, 1, 1>, &RenderS::T_DrawNBG<0, 4, 0, 1, 1, 2>, &RenderS::T_DrawNBG<0, 4, 0, 1, 1, 3>,  },  { &RenderS::T_DrawNBG<0, 4, 0, 1, 2, 0>, &RenderS::T_DrawNBG<0, 4, 0, 1, 2, 1>, &RenderS::T_DrawNBG<0, 4, 0, 1, 2, 2>, &RenderS::T_DrawNBG<0, 4, 0, 1, 2, 3>,  },  },  },
+  {  {  { &RenderS::T_DrawNBG<0, 8, 0, 0, 0, 0>, &RenderS::T_DrawNBG<0, 8, 0, 0, 0, 1>, &RenderS::T_DrawNBG<0, 8, 0, 0, 0, 2>, &RenderS::T_DrawNBG<0, 8, 0, 0, 0, 3>,  },  { &RenderS::T_DrawNBG<0, 8, 0, 0, 1, 0>, &RenderS::T_DrawNBG<0, 8, 0, 0, 1, 1>, &RenderS::T_DrawNBG<0, 8, 0, 0, 1, 2>, &RenderS::T_DrawNBG<0, 8, 0, 0, 1, 3>,  },  { &RenderS::T_DrawNBG<0, 8, 0, 0, 2, 0>, &RenderS::T_DrawNBG<0, 8, 0, 0, 2, 1>, &RenderS::T_DrawNBG<0, 8, 0, 0, 2, 2>, &RenderS::T_DrawNBG<0, 8, 0, 0, 2, 3>,  },  },  {  { &RenderS::T_DrawNBG<0, 8, 0, 1, 0, 0>, &RenderS::T_DrawNBG<0, 8, 0, 1, 0, 1>, &RenderS::T_DrawNBG<0, 8, 0, 1, 0, 2>, &RenderS::T_DrawNBG<0, 8, 0, 1, 0, 3>,  },  { &RenderS::T_DrawNBG<0, 8, 0, 1, 1, 0>, &RenderS::T_DrawNBG<0, 8, 0, 1, 1, 1>, &RenderS::T_DrawNBG<0, 8, 0, 1, 1, 2>, &RenderS::T_DrawNBG<0, 8, 0, 1, 1, 3>,  },  { &RenderS::T_DrawNBG<0, 8, 0, 1, 2, 0>, &RenderS::T_DrawNBG<0, 8, 0, 1, 2, 1>, &RenderS::T_DrawNBG<0, 8, 0, 1, 2, 2>, &RenderS::T_DrawNBG<0, 8, 0, 1, 2, 3>,  },  },  },
+  {  {  { &RenderS::T_DrawNBG<0, 16, 0, 0, 0, 0>, &RenderS::T_DrawNBG<0, 16, 0, 0, 0, 1>, &RenderS::T_DrawNBG<0, 16, 0, 0, 0, 2>, &RenderS::T_DrawNBG<0, 16, 0, 0, 0, 3>,  },  { &RenderS::T_DrawNBG<0, 16, 0, 0, 1, 0>, &RenderS::T_DrawNBG<0, 16, 0, 0, 1, 1>, &RenderS::T_DrawNBG<0, 16, 0, 0, 1, 2>, &RenderS::T_DrawNBG<0, 16, 0, 0, 1, 3>,  },  { &RenderS::T_DrawNBG<0, 16, 0, 0, 2, 0>, &RenderS::T_DrawNBG<0, 16, 0, 0, 2, 1>, &RenderS::T_DrawNBG<0, 16, 0, 0, 2, 2>, &RenderS::T_DrawNBG<0, 16, 0, 0, 2, 3>,  },  },  {  { &RenderS::T_DrawNBG<0, 16, 0, 1, 0, 0>, &RenderS::T_DrawNBG<0, 16, 0, 1, 0, 1>, &RenderS::T_DrawNBG<0, 16, 0, 1, 0, 2>, &RenderS::T_DrawNBG<0, 16, 0, 1, 0, 3>,  },  { &RenderS::T_DrawNBG<0, 16, 0, 1, 1, 0>, &RenderS::T_DrawNBG<0, 16, 0, 1, 1, 1>, &RenderS::T_DrawNBG<0, 16, 0, 1, 1, 2>, &RenderS::T_DrawNBG<0, 16, 0, 1, 1, 3>,  },  { &RenderS::T_DrawNBG<0, 16, 0, 1, 2, 0>, &RenderS::T_DrawNBG<0, 16, 0, 1, 2, 1>, &RenderS::T_DrawNBG<0, 16, 0, 1, 2, 2>, &RenderS::T_DrawNBG<0, 16, 0, 1, 2, 3>,  },  },  },
+  {  {  { &RenderS::T_DrawNBG<0, 16, 1, 0, 0, 0>, &RenderS::T_DrawNBG<0, 16, 1, 0, 0, 1>, &RenderS::T_DrawNBG<0, 16, 1, 0, 0, 2>, &RenderS::T_DrawNBG<0, 16, 1, 0, 0, 3>,  },  { &RenderS::T_DrawNBG<0, 16, 1, 0, 1, 0>, &RenderS::T_DrawNBG<0, 16, 1, 0, 1, 1>, &RenderS::T_DrawNBG<0, 16, 1, 0, 1, 2>, &RenderS::T_DrawNBG<0, 16, 1, 0, 1, 3>,  },  { &RenderS::T_DrawNBG<0, 16, 1, 0, 2, 0>, &RenderS::T_DrawNBG<0, 16, 1, 0, 2, 1>, &RenderS::T_DrawNBG<0, 16, 1, 0, 2, 2>, &RenderS::T_DrawNBG<0, 16, 1, 0, 2, 3>,  },  },  {  { &RenderS::T_DrawNBG<0, 16, 1, 1, 0, 0>, &RenderS::T_DrawNBG<0, 16, 1, 1, 0, 1>, &RenderS::T_DrawNBG<0, 16, 1, 1, 0, 2>, &RenderS::T_DrawNBG<0, 16, 1, 1, 0, 3>,  },  { &RenderS::T_DrawNBG<0, 16, 1, 1, 1, 0>, &RenderS::T_DrawNBG<0, 16, 1, 1, 1, 1>, &RenderS::T_DrawNBG<0, 16, 1, 1, 1, 2>, &RenderS::T_DrawNBG<0, 16, 1, 1, 1, 3>,  },  { &RenderS::T_DrawNBG<0, 16, 1, 1, 2, 0>, &RenderS::T_DrawNBG<0, 16, 1, 1, 2, 1>, &RenderS::T_DrawNBG<0, 16, 1, 1, 2, 2>, &RenderS::T_DrawNBG<0, 16, 1, 1, 2, 3>,  },  },  },
+  {  {  { &RenderS::T_DrawNBG<0, 32, 1, 0, 0, 0>, &RenderS::T_DrawNBG<0, 32, 1, 0, 0, 1>, &RenderS::T_DrawNBG<0, 32, 1, 0, 0, 2>, &RenderS::T_DrawNBG<0, 32, 1, 0, 0, 3>,  },  { &RenderS::T_DrawNBG<0, 32, 1, 0, 1, 0>, &RenderS::T_DrawNBG<0, 32, 1, 0, 1, 1>, &RenderS::T_DrawNBG<0, 32, 1, 0, 1, 2>, &RenderS::T_DrawNBG<0, 32, 1, 0, 1, 3>,  },  { &RenderS::T_DrawNBG<0, 32, 1, 0, 2, 0>, &RenderS::T_DrawNBG<0, 32, 1, 0, 2, 1>, &RenderS::T_DrawNBG<0, 32, 1, 0, 2, 2>, &RenderS::T_DrawNBG<0, 32, 1, 0, 2, 3>,  },  },  {  { &RenderS::T_DrawNBG<0, 32, 1, 1, 0, 0>, &RenderS::T_DrawNBG<0, 32, 1, 1, 0, 1>, &RenderS::T_DrawNBG<0, 32, 1, 1, 0, 2>, &RenderS::T_DrawNBG<0, 32, 1, 1, 0, 3>,  },  { &RenderS::T_DrawNBG<0, 32, 1, 1, 1, 0>, &RenderS::T_DrawNBG<0, 32, 1, 1, 1, 1>, &RenderS::T_DrawNBG<0, 32, 1, 1, 1, 2>, &RenderS::T_DrawNBG<0, 32, 1, 1, 1, 3>,  },  { &RenderS::T_DrawNBG<0, 32, 1, 1, 2, 0>, &RenderS::T_DrawNBG<0, 32, 1, 1, 2, 1>, &RenderS::T_DrawNBG<0, 32, 1, 1, 2, 2>, &RenderS::T_DrawNBG<0, 32, 1, 1, 2, 3>,  },  },  },
  },
  {
-  {  {  { T_DrawNBG<1, 4, 0, 0, 0, 0>, T_DrawNBG<1, 4, 0, 0, 0, 1>, T_DrawNBG<1, 4, 0, 0, 0, 2>, T_DrawNBG<1, 4, 0, 0, 0, 3>,  },  { T_DrawNBG<1, 4, 0, 0, 1, 0>, T_DrawNBG<1, 4, 0, 0, 1, 1>, T_DrawNBG<1, 4, 0, 0, 1, 2>, T_DrawNBG<1, 4, 0, 0, 1, 3>,  },  { T_DrawNBG<1, 4, 0, 0, 2, 0>, T_DrawNBG<1, 4, 0, 0, 2, 1>, T_DrawNBG<1, 4, 0, 0, 2, 2>, T_DrawNBG<1, 4, 0, 0, 2, 3>,  },  },  {  { T_DrawNBG<1, 4, 0, 1, 0, 0>, T_DrawNBG<1, 4, 0, 1, 0, 1>, T_DrawNBG<1, 4, 0, 1, 0, 2>, T_DrawNBG<1, 4, 0, 1, 0, 3>,  },  { T_DrawNBG<1, 4, 0, 1, 1, 0>, T_DrawNBG<1, 4, 0, 1, 1, 1>, T_DrawNBG<1, 4, 0, 1, 1, 2>, T_DrawNBG<1, 4, 0, 1, 1, 3>,  },  { T_DrawNBG<1, 4, 0, 1, 2, 0>, T_DrawNBG<1, 4, 0, 1, 2, 1>, T_DrawNBG<1, 4, 0, 1, 2, 2>, T_DrawNBG<1, 4, 0, 1, 2, 3>,  },  },  },
-  {  {  { T_DrawNBG<1, 8, 0, 0, 0, 0>, T_DrawNBG<1, 8, 0, 0, 0, 1>, T_DrawNBG<1, 8, 0, 0, 0, 2>, T_DrawNBG<1, 8, 0, 0, 0, 3>,  },  { T_DrawNBG<1, 8, 0, 0, 1, 0>, T_DrawNBG<1, 8, 0, 0, 1, 1>, T_DrawNBG<1, 8, 0, 0, 1, 2>, T_DrawNBG<1, 8, 0, 0, 1, 3>,  },  { T_DrawNBG<1, 8, 0, 0, 2, 0>, T_DrawNBG<1, 8, 0, 0, 2, 1>, T_DrawNBG<1, 8, 0, 0, 2, 2>, T_DrawNBG<1, 8, 0, 0, 2, 3>,  },  },  {  { T_DrawNBG<1, 8, 0, 1, 0, 0>, T_DrawNBG<1, 8, 0, 1, 0, 1>, T_DrawNBG<1, 8, 0, 1, 0, 2>, T_DrawNBG<1, 8, 0, 1, 0, 3>,  },  { T_DrawNBG<1, 8, 0, 1, 1, 0>, T_DrawNBG<1, 8, 0, 1, 1, 1>, T_DrawNBG<1, 8, 0, 1, 1, 2>, T_DrawNBG<1, 8, 0, 1, 1, 3>,  },  { T_DrawNBG<1, 8, 0, 1, 2, 0>, T_DrawNBG<1, 8, 0, 1, 2, 1>, T_DrawNBG<1, 8, 0, 1, 2, 2>, T_DrawNBG<1, 8, 0, 1, 2, 3>,  },  },  },
-  {  {  { T_DrawNBG<1, 16, 0, 0, 0, 0>, T_DrawNBG<1, 16, 0, 0, 0, 1>, T_DrawNBG<1, 16, 0, 0, 0, 2>, T_DrawNBG<1, 16, 0, 0, 0, 3>,  },  { T_DrawNBG<1, 16, 0, 0, 1, 0>, T_DrawNBG<1, 16, 0, 0, 1, 1>, T_DrawNBG<1, 16, 0, 0, 1, 2>, T_DrawNBG<1, 16, 0, 0, 1, 3>,  },  { T_DrawNBG<1, 16, 0, 0, 2, 0>, T_DrawNBG<1, 16, 0, 0, 2, 1>, T_DrawNBG<1, 16, 0, 0, 2, 2>, T_DrawNBG<1, 16, 0, 0, 2, 3>,  },  },  {  { T_DrawNBG<1, 16, 0, 1, 0, 0>, T_DrawNBG<1, 16, 0, 1, 0, 1>, T_DrawNBG<1, 16, 0, 1, 0, 2>, T_DrawNBG<1, 16, 0, 1, 0, 3>,  },  { T_DrawNBG<1, 16, 0, 1, 1, 0>, T_DrawNBG<1, 16, 0, 1, 1, 1>, T_DrawNBG<1, 16, 0, 1, 1, 2>, T_DrawNBG<1, 16, 0, 1, 1, 3>,  },  { T_DrawNBG<1, 16, 0, 1, 2, 0>, T_DrawNBG<1, 16, 0, 1, 2, 1>, T_DrawNBG<1, 16, 0, 1, 2, 2>, T_DrawNBG<1, 16, 0, 1, 2, 3>,  },  },  },
-  {  {  { T_DrawNBG<1, 16, 1, 0, 0, 0>, T_DrawNBG<1, 16, 1, 0, 0, 1>, T_DrawNBG<1, 16, 1, 0, 0, 2>, T_DrawNBG<1, 16, 1, 0, 0, 3>,  },  { T_DrawNBG<1, 16, 1, 0, 1, 0>, T_DrawNBG<1, 16, 1, 0, 1, 1>, T_DrawNBG<1, 16, 1, 0, 1, 2>, T_DrawNBG<1, 16, 1, 0, 1, 3>,  },  { T_DrawNBG<1, 16, 1, 0, 2, 0>, T_DrawNBG<1, 16, 1, 0, 2, 1>, T_DrawNBG<1, 16, 1, 0, 2, 2>, T_DrawNBG<1, 16, 1, 0, 2, 3>,  },  },  {  { T_DrawNBG<1, 16, 1, 1, 0, 0>, T_DrawNBG<1, 16, 1, 1, 0, 1>, T_DrawNBG<1, 16, 1, 1, 0, 2>, T_DrawNBG<1, 16, 1, 1, 0, 3>,  },  { T_DrawNBG<1, 16, 1, 1, 1, 0>, T_DrawNBG<1, 16, 1, 1, 1, 1>, T_DrawNBG<1, 16, 1, 1, 1, 2>, T_DrawNBG<1, 16, 1, 1, 1, 3>,  },  { T_DrawNBG<1, 16, 1, 1, 2, 0>, T_DrawNBG<1, 16, 1, 1, 2, 1>, T_DrawNBG<1, 16, 1, 1, 2, 2>, T_DrawNBG<1, 16, 1, 1, 2, 3>,  },  },  },
-  {  {  { T_DrawNBG<1, 32, 1, 0, 0, 0>, T_DrawNBG<1, 32, 1, 0, 0, 1>, T_DrawNBG<1, 32, 1, 0, 0, 2>, T_DrawNBG<1, 32, 1, 0, 0, 3>,  },  { T_DrawNBG<1, 32, 1, 0, 1, 0>, T_DrawNBG<1, 32, 1, 0, 1, 1>, T_DrawNBG<1, 32, 1, 0, 1, 2>, T_DrawNBG<1, 32, 1, 0, 1, 3>,  },  { T_DrawNBG<1, 32, 1, 0, 2, 0>, T_DrawNBG<1, 32, 1, 0, 2, 1>, T_DrawNBG<1, 32, 1, 0, 2, 2>, T_DrawNBG<1, 32, 1, 0, 2, 3>,  },  },  {  { T_DrawNBG<1, 32, 1, 1, 0, 0>, T_DrawNBG<1, 32, 1, 1, 0, 1>, T_DrawNBG<1, 32, 1, 1, 0, 2>, T_DrawNBG<1, 32, 1, 1, 0, 3>,  },  { T_DrawNBG<1, 32, 1, 1, 1, 0>, T_DrawNBG<1, 32, 1, 1, 1, 1>, T_DrawNBG<1, 32, 1, 1, 1, 2>, T_DrawNBG<1, 32, 1, 1, 1, 3>,  },  { T_DrawNBG<1, 32, 1, 1, 2, 0>, T_DrawNBG<1, 32, 1, 1, 2, 1>, T_DrawNBG<1, 32, 1, 1, 2, 2>, T_DrawNBG<1, 32, 1, 1, 2, 3>,  },  },  },
+  {  {  { &RenderS::T_DrawNBG<1, 4, 0, 0, 0, 0>, &RenderS::T_DrawNBG<1, 4, 0, 0, 0, 1>, &RenderS::T_DrawNBG<1, 4, 0, 0, 0, 2>, &RenderS::T_DrawNBG<1, 4, 0, 0, 0, 3>,  },  { &RenderS::T_DrawNBG<1, 4, 0, 0, 1, 0>, &RenderS::T_DrawNBG<1, 4, 0, 0, 1, 1>, &RenderS::T_DrawNBG<1, 4, 0, 0, 1, 2>, &RenderS::T_DrawNBG<1, 4, 0, 0, 1, 3>,  },  { &RenderS::T_DrawNBG<1, 4, 0, 0, 2, 0>, &RenderS::T_DrawNBG<1, 4, 0, 0, 2, 1>, &RenderS::T_DrawNBG<1, 4, 0, 0, 2, 2>, &RenderS::T_DrawNBG<1, 4, 0, 0, 2, 3>,  },  },  {  { &RenderS::T_DrawNBG<1, 4, 0, 1, 0, 0>, &RenderS::T_DrawNBG<1, 4, 0, 1, 0, 1>, &RenderS::T_DrawNBG<1, 4, 0, 1, 0, 2>, &RenderS::T_DrawNBG<1, 4, 0, 1, 0, 3>,  },  { &RenderS::T_DrawNBG<1, 4, 0, 1, 1, 0>, &RenderS::T_DrawNBG<1, 4, 0, 1, 1, 1>, &RenderS::T_DrawNBG<1, 4, 0, 1, 1, 2>, &RenderS::T_DrawNBG<1, 4, 0, 1, 1, 3>,  },  { &RenderS::T_DrawNBG<1, 4, 0, 1, 2, 0>, &RenderS::T_DrawNBG<1, 4, 0, 1, 2, 1>, &RenderS::T_DrawNBG<1, 4, 0, 1, 2, 2>, &RenderS::T_DrawNBG<1, 4, 0, 1, 2, 3>,  },  },  },
+  {  {  { &RenderS::T_DrawNBG<1, 8, 0, 0, 0, 0>, &RenderS::T_DrawNBG<1, 8, 0, 0, 0, 1>, &RenderS::T_DrawNBG<1, 8, 0, 0, 0, 2>, &RenderS::T_DrawNBG<1, 8, 0, 0, 0, 3>,  },  { &RenderS::T_DrawNBG<1, 8, 0, 0, 1, 0>, &RenderS::T_DrawNBG<1, 8, 0, 0, 1, 1>, &RenderS::T_DrawNBG<1, 8, 0, 0, 1, 2>, &RenderS::T_DrawNBG<1, 8, 0, 0, 1, 3>,  },  { &RenderS::T_DrawNBG<1, 8, 0, 0, 2, 0>, &RenderS::T_DrawNBG<1, 8, 0, 0, 2, 1>, &RenderS::T_DrawNBG<1, 8, 0, 0, 2, 2>, &RenderS::T_DrawNBG<1, 8, 0, 0, 2, 3>,  },  },  {  { &RenderS::T_DrawNBG<1, 8, 0, 1, 0, 0>, &RenderS::T_DrawNBG<1, 8, 0, 1, 0, 1>, &RenderS::T_DrawNBG<1, 8, 0, 1, 0, 2>, &RenderS::T_DrawNBG<1, 8, 0, 1, 0, 3>,  },  { &RenderS::T_DrawNBG<1, 8, 0, 1, 1, 0>, &RenderS::T_DrawNBG<1, 8, 0, 1, 1, 1>, &RenderS::T_DrawNBG<1, 8, 0, 1, 1, 2>, &RenderS::T_DrawNBG<1, 8, 0, 1, 1, 3>,  },  { &RenderS::T_DrawNBG<1, 8, 0, 1, 2, 0>, &RenderS::T_DrawNBG<1, 8, 0, 1, 2, 1>, &RenderS::T_DrawNBG<1, 8, 0, 1, 2, 2>, &RenderS::T_DrawNBG<1, 8, 0, 1, 2, 3>,  },  },  },
+  {  {  { &RenderS::T_DrawNBG<1, 16, 0, 0, 0, 0>, &RenderS::T_DrawNBG<1, 16, 0, 0, 0, 1>, &RenderS::T_DrawNBG<1, 16, 0, 0, 0, 2>, &RenderS::T_DrawNBG<1, 16, 0, 0, 0, 3>,  },  { &RenderS::T_DrawNBG<1, 16, 0, 0, 1, 0>, &RenderS::T_DrawNBG<1, 16, 0, 0, 1, 1>, &RenderS::T_DrawNBG<1, 16, 0, 0, 1, 2>, &RenderS::T_DrawNBG<1, 16, 0, 0, 1, 3>,  },  { &RenderS::T_DrawNBG<1, 16, 0, 0, 2, 0>, &RenderS::T_DrawNBG<1, 16, 0, 0, 2, 1>, &RenderS::T_DrawNBG<1, 16, 0, 0, 2, 2>, &RenderS::T_DrawNBG<1, 16, 0, 0, 2, 3>,  },  },  {  { &RenderS::T_DrawNBG<1, 16, 0, 1, 0, 0>, &RenderS::T_DrawNBG<1, 16, 0, 1, 0, 1>, &RenderS::T_DrawNBG<1, 16, 0, 1, 0, 2>, &RenderS::T_DrawNBG<1, 16, 0, 1, 0, 3>,  },  { &RenderS::T_DrawNBG<1, 16, 0, 1, 1, 0>, &RenderS::T_DrawNBG<1, 16, 0, 1, 1, 1>, &RenderS::T_DrawNBG<1, 16, 0, 1, 1, 2>, &RenderS::T_DrawNBG<1, 16, 0, 1, 1, 3>,  },  { &RenderS::T_DrawNBG<1, 16, 0, 1, 2, 0>, &RenderS::T_DrawNBG<1, 16, 0, 1, 2, 1>, &RenderS::T_DrawNBG<1, 16, 0, 1, 2, 2>, &RenderS::T_DrawNBG<1, 16, 0, 1, 2, 3>,  },  },  },
+  {  {  { &RenderS::T_DrawNBG<1, 16, 1, 0, 0, 0>, &RenderS::T_DrawNBG<1, 16, 1, 0, 0, 1>, &RenderS::T_DrawNBG<1, 16, 1, 0, 0, 2>, &RenderS::T_DrawNBG<1, 16, 1, 0, 0, 3>,  },  { &RenderS::T_DrawNBG<1, 16, 1, 0, 1, 0>, &RenderS::T_DrawNBG<1, 16, 1, 0, 1, 1>, &RenderS::T_DrawNBG<1, 16, 1, 0, 1, 2>, &RenderS::T_DrawNBG<1, 16, 1, 0, 1, 3>,  },  { &RenderS::T_DrawNBG<1, 16, 1, 0, 2, 0>, &RenderS::T_DrawNBG<1, 16, 1, 0, 2, 1>, &RenderS::T_DrawNBG<1, 16, 1, 0, 2, 2>, &RenderS::T_DrawNBG<1, 16, 1, 0, 2, 3>,  },  },  {  { &RenderS::T_DrawNBG<1, 16, 1, 1, 0, 0>, &RenderS::T_DrawNBG<1, 16, 1, 1, 0, 1>, &RenderS::T_DrawNBG<1, 16, 1, 1, 0, 2>, &RenderS::T_DrawNBG<1, 16, 1, 1, 0, 3>,  },  { &RenderS::T_DrawNBG<1, 16, 1, 1, 1, 0>, &RenderS::T_DrawNBG<1, 16, 1, 1, 1, 1>, &RenderS::T_DrawNBG<1, 16, 1, 1, 1, 2>, &RenderS::T_DrawNBG<1, 16, 1, 1, 1, 3>,  },  { &RenderS::T_DrawNBG<1, 16, 1, 1, 2, 0>, &RenderS::T_DrawNBG<1, 16, 1, 1, 2, 1>, &RenderS::T_DrawNBG<1, 16, 1, 1, 2, 2>, &RenderS::T_DrawNBG<1, 16, 1, 1, 2, 3>,  },  },  },
+  {  {  { &RenderS::T_DrawNBG<1, 32, 1, 0, 0, 0>, &RenderS::T_DrawNBG<1, 32, 1, 0, 0, 1>, &RenderS::T_DrawNBG<1, 32, 1, 0, 0, 2>, &RenderS::T_DrawNBG<1, 32, 1, 0, 0, 3>,  },  { &RenderS::T_DrawNBG<1, 32, 1, 0, 1, 0>, &RenderS::T_DrawNBG<1, 32, 1, 0, 1, 1>, &RenderS::T_DrawNBG<1, 32, 1, 0, 1, 2>, &RenderS::T_DrawNBG<1, 32, 1, 0, 1, 3>,  },  { &RenderS::T_DrawNBG<1, 32, 1, 0, 2, 0>, &RenderS::T_DrawNBG<1, 32, 1, 0, 2, 1>, &RenderS::T_DrawNBG<1, 32, 1, 0, 2, 2>, &RenderS::T_DrawNBG<1, 32, 1, 0, 2, 3>,  },  },  {  { &RenderS::T_DrawNBG<1, 32, 1, 1, 0, 0>, &RenderS::T_DrawNBG<1, 32, 1, 1, 0, 1>, &RenderS::T_DrawNBG<1, 32, 1, 1, 0, 2>, &RenderS::T_DrawNBG<1, 32, 1, 1, 0, 3>,  },  { &RenderS::T_DrawNBG<1, 32, 1, 1, 1, 0>, &RenderS::T_DrawNBG<1, 32, 1, 1, 1, 1>, &RenderS::T_DrawNBG<1, 32, 1, 1, 1, 2>, &RenderS::T_DrawNBG<1, 32, 1, 1, 1, 3>,  },  { &RenderS::T_DrawNBG<1, 32, 1, 1, 2, 0>, &RenderS::T_DrawNBG<1, 32, 1, 1, 2, 1>, &RenderS::T_DrawNBG<1, 32, 1, 1, 2, 2>, &RenderS::T_DrawNBG<1, 32, 1, 1, 2, 3>,  },  },  },
  }
 };
 
 template<bool TA_igntp, unsigned TA_PrioMode, unsigned TA_CCMode>
-static INLINE uint64 MakeNBG23Pix(uint32 dcc, uint32 pbor, const int16* sfcode_lut, uint32 colcacheoffs)
+INLINE uint64 RenderS::MakeNBG23Pix(uint32 dcc, uint32 pbor, const int16* sfcode_lut, uint32 colcacheoffs)
 {
  uint32 rgb24;
 
@@ -1674,7 +1741,7 @@ static INLINE uint64 MakeNBG23Pix(uint32 dcc, uint32 pbor, const int16* sfcode_l
 // CCMode will be forced to 0 in the effective instantiation if corresponding NBG CCE bit in CCCTL is 0.
 //
 template<unsigned TA_bpp, bool TA_igntp, unsigned TA_PrioMode, unsigned TA_CCMode>
-static void T_DrawNBG23(const unsigned n, uint64* bgbuf, const unsigned w, const uint32 pix_base_or)
+void RenderS::T_DrawNBG23(const unsigned n, uint64* bgbuf, const unsigned w, const uint32 pix_base_or)
 {
  assert(n >= 2);
  TileFetcher<false> tf;
@@ -1692,7 +1759,7 @@ static void T_DrawNBG23(const unsigned n, uint64* bgbuf, const unsigned w, const
  tf.AuxMode = (PNCN[n] >> 14) & 1;
  tf.Supp = (PNCN[n] & 0x3FF); // Supplement bits when PNDSize == 1
  //
- tf.Start(n, false, (MPOFN >> (n << 2)) & 0x7, MapRegs[n]);
+ tf.Start(this, n, false, (MPOFN >> (n << 2)) & 0x7, MapRegs[n]);
 
  MakeSFCodeLUT<TA_PrioMode, TA_CCMode>(n, sfcode_lut);
 
@@ -1727,7 +1794,7 @@ static void T_DrawNBG23(const unsigned n, uint64* bgbuf, const unsigned w, const
  {
   uint32 pbor = pix_base_or;
 
-  tf.Fetch<TA_bpp>(false, tx << 3, yscr);
+  tf.Fetch<TA_bpp>(VRAM, false, tx << 3, yscr);
 
   if(TA_CCMode == 1 || TA_CCMode == 2)
    pbor |= (tf.scc << PIX_CCE_SHIFT);
@@ -1736,7 +1803,7 @@ static void T_DrawNBG23(const unsigned n, uint64* bgbuf, const unsigned w, const
    pbor |= (tf.spr << PIX_PRIO_SHIFT);
   //
   //
-  auto* const mbp = MakeNBG23Pix<TA_igntp, TA_PrioMode, TA_CCMode>;
+  auto const mbp = [this](uint32 dcc, uint32 pb, const int16* sl, uint32 cco) { return MakeNBG23Pix<TA_igntp, TA_PrioMode, TA_CCMode>(dcc, pb, sl, cco); };
 
   if(TA_bpp == 8)
   {
@@ -1797,19 +1864,19 @@ static void T_DrawNBG23(const unsigned n, uint64* bgbuf, const unsigned w, const
  }
 }
 
-static void (*DrawNBG23[2/*col mode*/][2/*igntp*/][3/*priomode*/][4/*ccmode*/])(const unsigned n, uint64* bgbuf, const unsigned w, const uint32 pix_base_or) =
+static void (RenderS::*DrawNBG23[2/*col mode*/][2/*igntp*/][3/*priomode*/][4/*ccmode*/])(const unsigned n, uint64* bgbuf, const unsigned w, const uint32 pix_base_or) =
 {
  {
-  {    { T_DrawNBG23<4, 0, 0, 0>, T_DrawNBG23<4, 0, 0, 1>, T_DrawNBG23<4, 0, 0, 2>, T_DrawNBG23<4, 0, 0, 3>, },    { T_DrawNBG23<4, 0, 1, 0>, T_DrawNBG23<4, 0, 1, 1>, T_DrawNBG23<4, 0, 1, 2>, T_DrawNBG23<4, 0, 1, 3>, },    { T_DrawNBG23<4, 0, 2, 0>, T_DrawNBG23<4, 0, 2, 1>, T_DrawNBG23<4, 0, 2, 2>, T_DrawNBG23<4, 0, 2, 3>, }, },
-  {    { T_DrawNBG23<4, 1, 0, 0>, T_DrawNBG23<4, 1, 0, 1>, T_DrawNBG23<4, 1, 0, 2>, T_DrawNBG23<4, 1, 0, 3>, },    { T_DrawNBG23<4, 1, 1, 0>, T_DrawNBG23<4, 1, 1, 1>, T_DrawNBG23<4, 1, 1, 2>, T_DrawNBG23<4, 1, 1, 3>, },    { T_DrawNBG23<4, 1, 2, 0>, T_DrawNBG23<4, 1, 2, 1>, T_DrawNBG23<4, 1, 2, 2>, T_DrawNBG23<4, 1, 2, 3>, }, },
+  {    { &RenderS::T_DrawNBG23<4, 0, 0, 0>, &RenderS::T_DrawNBG23<4, 0, 0, 1>, &RenderS::T_DrawNBG23<4, 0, 0, 2>, &RenderS::T_DrawNBG23<4, 0, 0, 3>, },    { &RenderS::T_DrawNBG23<4, 0, 1, 0>, &RenderS::T_DrawNBG23<4, 0, 1, 1>, &RenderS::T_DrawNBG23<4, 0, 1, 2>, &RenderS::T_DrawNBG23<4, 0, 1, 3>, },    { &RenderS::T_DrawNBG23<4, 0, 2, 0>, &RenderS::T_DrawNBG23<4, 0, 2, 1>, &RenderS::T_DrawNBG23<4, 0, 2, 2>, &RenderS::T_DrawNBG23<4, 0, 2, 3>, }, },
+  {    { &RenderS::T_DrawNBG23<4, 1, 0, 0>, &RenderS::T_DrawNBG23<4, 1, 0, 1>, &RenderS::T_DrawNBG23<4, 1, 0, 2>, &RenderS::T_DrawNBG23<4, 1, 0, 3>, },    { &RenderS::T_DrawNBG23<4, 1, 1, 0>, &RenderS::T_DrawNBG23<4, 1, 1, 1>, &RenderS::T_DrawNBG23<4, 1, 1, 2>, &RenderS::T_DrawNBG23<4, 1, 1, 3>, },    { &RenderS::T_DrawNBG23<4, 1, 2, 0>, &RenderS::T_DrawNBG23<4, 1, 2, 1>, &RenderS::T_DrawNBG23<4, 1, 2, 2>, &RenderS::T_DrawNBG23<4, 1, 2, 3>, }, },
  },
  {
-  {    { T_DrawNBG23<8, 0, 0, 0>, T_DrawNBG23<8, 0, 0, 1>, T_DrawNBG23<8, 0, 0, 2>, T_DrawNBG23<8, 0, 0, 3>, },    { T_DrawNBG23<8, 0, 1, 0>, T_DrawNBG23<8, 0, 1, 1>, T_DrawNBG23<8, 0, 1, 2>, T_DrawNBG23<8, 0, 1, 3>, },    { T_DrawNBG23<8, 0, 2, 0>, T_DrawNBG23<8, 0, 2, 1>, T_DrawNBG23<8, 0, 2, 2>, T_DrawNBG23<8, 0, 2, 3>, }, },
-  {    { T_DrawNBG23<8, 1, 0, 0>, T_DrawNBG23<8, 1, 0, 1>, T_DrawNBG23<8, 1, 0, 2>, T_DrawNBG23<8, 1, 0, 3>, },    { T_DrawNBG23<8, 1, 1, 0>, T_DrawNBG23<8, 1, 1, 1>, T_DrawNBG23<8, 1, 1, 2>, T_DrawNBG23<8, 1, 1, 3>, },    { T_DrawNBG23<8, 1, 2, 0>, T_DrawNBG23<8, 1, 2, 1>, T_DrawNBG23<8, 1, 2, 2>, T_DrawNBG23<8, 1, 2, 3>, }, },
+  {    { &RenderS::T_DrawNBG23<8, 0, 0, 0>, &RenderS::T_DrawNBG23<8, 0, 0, 1>, &RenderS::T_DrawNBG23<8, 0, 0, 2>, &RenderS::T_DrawNBG23<8, 0, 0, 3>, },    { &RenderS::T_DrawNBG23<8, 0, 1, 0>, &RenderS::T_DrawNBG23<8, 0, 1, 1>, &RenderS::T_DrawNBG23<8, 0, 1, 2>, &RenderS::T_DrawNBG23<8, 0, 1, 3>, },    { &RenderS::T_DrawNBG23<8, 0, 2, 0>, &RenderS::T_DrawNBG23<8, 0, 2, 1>, &RenderS::T_DrawNBG23<8, 0, 2, 2>, &RenderS::T_DrawNBG23<8, 0, 2, 3>, }, },
+  {    { &RenderS::T_DrawNBG23<8, 1, 0, 0>, &RenderS::T_DrawNBG23<8, 1, 0, 1>, &RenderS::T_DrawNBG23<8, 1, 0, 2>, &RenderS::T_DrawNBG23<8, 1, 0, 3>, },    { &RenderS::T_DrawNBG23<8, 1, 1, 0>, &RenderS::T_DrawNBG23<8, 1, 1, 1>, &RenderS::T_DrawNBG23<8, 1, 1, 2>, &RenderS::T_DrawNBG23<8, 1, 1, 3>, },    { &RenderS::T_DrawNBG23<8, 1, 2, 0>, &RenderS::T_DrawNBG23<8, 1, 2, 1>, &RenderS::T_DrawNBG23<8, 1, 2, 2>, &RenderS::T_DrawNBG23<8, 1, 2, 3>, }, },
  },
 };
 
-static INLINE uint32 GetCoeffAddr(const unsigned i, uint32 offset)
+INLINE uint32 RenderS::GetCoeffAddr(const unsigned i, uint32 offset)
 {
  const uint32 src_mask = (CRKTE ? 0x3FF : 0x3FFFF);
 
@@ -1820,7 +1887,7 @@ static INLINE uint32 GetCoeffAddr(const unsigned i, uint32 offset)
  return offset;
 }
 
-static INLINE uint32 ReadCoeff(const unsigned i, const uint32 addr)
+INLINE uint32 RenderS::ReadCoeff(const unsigned i, const uint32 addr)
 {
  const uint16* src = (CRKTE ? &CRAM[0x400] : VRAM);
  uint32 coeff;
@@ -1849,14 +1916,17 @@ static INLINE uint32 ReadCoeff(const unsigned i, const uint32 addr)
 // RBG1 requires RPMD == 0, or else bad things happen?
 
 template<typename T>
-static void SetupRotVars(const T* rs, const unsigned rbg_w)
+void RenderS::SetupRotVars(const T* rs, const unsigned rbg_w)
 {
  const uint8 EffRPMD = ((BGON & 0x20) ? 0 : RPMD);
 
  if(EffRPMD < 2)
  {
+  // RPMD can be 2 or 3 here when RBG1 is enabled; select parameter A then, rather than indexing past the end of LB.rotv[].
+  const uint8 sel = (RPMD < 2) ? RPMD : 0;
+
   for(unsigned x = 0; MDFN_LIKELY(x < rbg_w); x++)
-   LB.rotabsel[x] = RPMD;
+   LB.rotabsel[x] = sel;
  }
  else if(EffRPMD == 3)
   GetWinRotAB();
@@ -1908,7 +1978,7 @@ static void SetupRotVars(const T* rs, const unsigned rbg_w)
   LB.rotv[i].tf.PlaneSize = (PLSZ >> ( 8 + (i << 2))) & 0x3;
   LB.rotv[i].tf.PlaneOver = (PLSZ >> (10 + (i << 2))) & 0x3;
   LB.rotv[i].tf.PlaneOverChar = OVPNR[i];
-  LB.rotv[i].tf.Start(4 + i, !i && ((CHCTLB >> 9) & 1), (MPOFR >> (i << 2)) & 0x7, RotMapRegs[i]);
+  LB.rotv[i].tf.Start(this, 4 + i, !i && ((CHCTLB >> 9) & 1), (MPOFR >> (i << 2)) & 0x7, RotMapRegs[i]);
  }
 
  //
@@ -1974,7 +2044,7 @@ static void SetupRotVars(const T* rs, const unsigned rbg_w)
 
 // const bool TA_bmen = ((rn == 1) ? false : ((CHCTLB >> 9) & 1));
 template<bool TA_bmen, unsigned TA_bpp, bool TA_isrgb, bool TA_igntp, unsigned TA_PrioMode, unsigned TA_CCMode>
-static void T_DrawRBG(const bool rn, uint64* bgbuf, const unsigned w, const uint32 pix_base_or)
+void RenderS::T_DrawRBG(const bool rn, uint64* bgbuf, const unsigned w, const uint32 pix_base_or)
 {
  // Full color format selection for both RBG0 and RBG1
  // Bitmap only allowed for RBG0
@@ -2017,7 +2087,7 @@ static void T_DrawRBG(const bool rn, uint64* bgbuf, const unsigned w, const uint
   const uint32 ix = (  Xp + (uint32)(((int64)kx * (int32)(r.Xsp + (r.dX * i))) >> 16)) >> 10;
   const uint32 iy = (r.Yp + (uint32)(((int64)ky * (int32)(r.Ysp + (r.dY * i))) >> 16)) >> 10;
 
-  rot_tp |= tf.Fetch<TA_bpp>(TA_bmen, ix, iy);
+  rot_tp |= tf.Fetch<TA_bpp>(VRAM, TA_bmen, ix, iy);
 
   LB.rotabsel[i] = rot_tp;
   //
@@ -2028,21 +2098,21 @@ static void T_DrawRBG(const bool rn, uint64* bgbuf, const unsigned w, const uint
 }
 
 //template<unsigned TA_bpp, bool TA_isrgb, bool TA_igntp, unsigned TA_PrioMode, unsigned TA_CCMode>
-static void (*DrawRBG[2 /*bitmap enable*/][5/*col mode*/][2/*igntp*/][3/*priomode*/][4/*ccmode*/])(const bool rn, uint64* bgbuf, const unsigned w, const uint32 pix_base_or) =
+static void (RenderS::*DrawRBG[2 /*bitmap enable*/][5/*col mode*/][2/*igntp*/][3/*priomode*/][4/*ccmode*/])(const bool rn, uint64* bgbuf, const unsigned w, const uint32 pix_base_or) =
 {
  {
-  {  {  { T_DrawRBG<0, 4, 0, 0, 0, 0>, T_DrawRBG<0, 4, 0, 0, 0, 1>, T_DrawRBG<0, 4, 0, 0, 0, 2>, T_DrawRBG<0, 4, 0, 0, 0, 3>,  },  { T_DrawRBG<0, 4, 0, 0, 1, 0>, T_DrawRBG<0, 4, 0, 0, 1, 1>, T_DrawRBG<0, 4, 0, 0, 1, 2>, T_DrawRBG<0, 4, 0, 0, 1, 3>,  },  { T_DrawRBG<0, 4, 0, 0, 2, 0>, T_DrawRBG<0, 4, 0, 0, 2, 1>, T_DrawRBG<0, 4, 0, 0, 2, 2>, T_DrawRBG<0, 4, 0, 0, 2, 3>,  },  },  {  { T_DrawRBG<0, 4, 0, 1, 0, 0>, T_DrawRBG<0, 4, 0, 1, 0, 1>, T_DrawRBG<0, 4, 0, 1, 0, 2>, T_DrawRBG<0, 4, 0, 1, 0, 3>,  },  { T_DrawRBG<0, 4, 0, 1, 1, 0>, T_DrawRBG<0, 4, 0, 1, 1, 1>, T_DrawRBG<0, 4, 0, 1, 1, 2>, T_DrawRBG<0, 4, 0, 1, 1, 3>,  },  { T_DrawRBG<0, 4, 0, 1, 2, 0>, T_DrawRBG<0, 4, 0, 1, 2, 1>, T_DrawRBG<0, 4, 0, 1, 2, 2>, T_DrawRBG<0, 4, 0, 1, 2, 3>,  },  },  },
-  {  {  { T_DrawRBG<0, 8, 0, 0, 0, 0>, T_DrawRBG<0, 8, 0, 0, 0, 1>, T_DrawRBG<0, 8, 0, 0, 0, 2>, T_DrawRBG<0, 8, 0, 0, 0, 3>,  },  { T_DrawRBG<0, 8, 0, 0, 1, 0>, T_DrawRBG<0, 8, 0, 0, 1, 1>, T_DrawRBG<0, 8, 0, 0, 1, 2>, T_DrawRBG<0, 8, 0, 0, 1, 3>,  },  { T_DrawRBG<0, 8, 0, 0, 2, 0>, T_DrawRBG<0, 8, 0, 0, 2, 1>, T_DrawRBG<0, 8, 0, 0, 2, 2>, T_DrawRBG<0, 8, 0, 0, 2, 3>,  },  },  {  { T_DrawRBG<0, 8, 0, 1, 0, 0>, T_DrawRBG<0, 8, 0, 1, 0, 1>, T_DrawRBG<0, 8, 0, 1, 0, 2>, T_DrawRBG<0, 8, 0, 1, 0, 3>,  },  { T_DrawRBG<0, 8, 0, 1, 1, 0>, T_DrawRBG<0, 8, 0, 1, 1, 1>, T_DrawRBG<0, 8, 0, 1, 1, 2>, T_DrawRBG<0, 8, 0, 1, 1, 3>,  },  { T_DrawRBG<0, 8, 0, 1, 2, 0>, T_DrawRBG<0, 8, 0, 1, 2, 1>, T_DrawRBG<0, 8, 0, 1, 2, 2>, T_DrawRBG<0, 8, 0, 1, 2, 3>,  },  },  },
-  {  {  { T_DrawRBG<0, 16, 0, 0, 0, 0>, T_DrawRBG<0, 16, 0, 0, 0, 1>, T_DrawRBG<0, 16, 0, 0, 0, 2>, T_DrawRBG<0, 16, 0, 0, 0, 3>,  },  { T_DrawRBG<0, 16, 0, 0, 1, 0>, T_DrawRBG<0, 16, 0, 0, 1, 1>, T_DrawRBG<0, 16, 0, 0, 1, 2>, T_DrawRBG<0, 16, 0, 0, 1, 3>,  },  { T_DrawRBG<0, 16, 0, 0, 2, 0>, T_DrawRBG<0, 16, 0, 0, 2, 1>, T_DrawRBG<0, 16, 0, 0, 2, 2>, T_DrawRBG<0, 16, 0, 0, 2, 3>,  },  },  {  { T_DrawRBG<0, 16, 0, 1, 0, 0>, T_DrawRBG<0, 16, 0, 1, 0, 1>, T_DrawRBG<0, 16, 0, 1, 0, 2>, T_DrawRBG<0, 16, 0, 1, 0, 3>,  },  { T_DrawRBG<0, 16, 0, 1, 1, 0>, T_DrawRBG<0, 16, 0, 1, 1, 1>, T_DrawRBG<0, 16, 0, 1, 1, 2>, T_DrawRBG<0, 16, 0, 1, 1, 3>,  },  { T_DrawRBG<0, 16, 0, 1, 2, 0>, T_DrawRBG<0, 16, 0, 1, 2, 1>, T_DrawRBG<0, 16, 0, 1, 2, 2>, T_DrawRBG<0, 16, 0, 1, 2, 3>,  },  },  },
-  {  {  { T_DrawRBG<0, 16, 1, 0, 0, 0>, T_DrawRBG<0, 16, 1, 0, 0, 1>, T_DrawRBG<0, 16, 1, 0, 0, 2>, T_DrawRBG<0, 16, 1, 0, 0, 3>,  },  { T_DrawRBG<0, 16, 1, 0, 1, 0>, T_DrawRBG<0, 16, 1, 0, 1, 1>, T_DrawRBG<0, 16, 1, 0, 1, 2>, T_DrawRBG<0, 16, 1, 0, 1, 3>,  },  { T_DrawRBG<0, 16, 1, 0, 2, 0>, T_DrawRBG<0, 16, 1, 0, 2, 1>, T_DrawRBG<0, 16, 1, 0, 2, 2>, T_DrawRBG<0, 16, 1, 0, 2, 3>,  },  },  {  { T_DrawRBG<0, 16, 1, 1, 0, 0>, T_DrawRBG<0, 16, 1, 1, 0, 1>, T_DrawRBG<0, 16, 1, 1, 0, 2>, T_DrawRBG<0, 16, 1, 1, 0, 3>,  },  { T_DrawRBG<0, 16, 1, 1, 1, 0>, T_DrawRBG<0, 16, 1, 1, 1, 1>, T_DrawRBG<0, 16, 1, 1, 1, 2>, T_DrawRBG<0, 16, 1, 1, 1, 3>,  },  { T_DrawRBG<0, 16, 1, 1, 2, 0>, T_DrawRBG<0, 16, 1, 1, 2, 1>, T_DrawRBG<0, 16, 1, 1, 2, 2>, T_DrawRBG<0, 16, 1, 1, 2, 3>,  },  },  },
-  {  {  { T_DrawRBG<0, 32, 1, 0, 0, 0>, T_DrawRBG<0, 32, 1, 0, 0, 1>, T_DrawRBG<0, 32, 1, 0, 0, 2>, T_DrawRBG<0, 32, 1, 0, 0, 3>,  },  { T_DrawRBG<0, 32, 1, 0, 1, 0>, T_DrawRBG<0, 32, 1, 0, 1, 1>, T_DrawRBG<0, 32, 1, 0, 1, 2>, T_DrawRBG<0, 32, 1, 0, 1, 3>,  },  { T_DrawRBG<0, 32, 1, 0, 2, 0>, T_DrawRBG<0, 32, 1, 0, 2, 1>, T_DrawRBG<0, 32, 1, 0, 2, 2>, T_DrawRBG<0, 32, 1, 0, 2, 3>,  },  },  {  { T_DrawRBG<0, 32, 1, 1, 0, 0>, T_DrawRBG<0, 32, 1, 1, 0, 1>, T_DrawRBG<0, 32, 1, 1, 0, 2>, T_DrawRBG<0, 32, 1, 1, 0, 3>,  },  { T_DrawRBG<0, 32, 1, 1, 1, 0>, T_DrawRBG<0, 32, 1, 1, 1, 1>, T_DrawRBG<0, 32, 1, 1, 1, 2>, T_DrawRBG<0, 32, 1, 1, 1, 3>,  },  { T_DrawRBG<0, 32, 1, 1, 2, 0>, T_DrawRBG<0, 32, 1, 1, 2, 1>, T_DrawRBG<0, 32, 1, 1, 2, 2>, T_DrawRBG<0, 32, 1, 1, 2, 3>,  },  },  },
+  {  {  { &RenderS::T_DrawRBG<0, 4, 0, 0, 0, 0>, &RenderS::T_DrawRBG<0, 4, 0, 0, 0, 1>, &RenderS::T_DrawRBG<0, 4, 0, 0, 0, 2>, &RenderS::T_DrawRBG<0, 4, 0, 0, 0, 3>,  },  { &RenderS::T_DrawRBG<0, 4, 0, 0, 1, 0>, &RenderS::T_DrawRBG<0, 4, 0, 0, 1, 1>, &RenderS::T_DrawRBG<0, 4, 0, 0, 1, 2>, &RenderS::T_DrawRBG<0, 4, 0, 0, 1, 3>,  },  { &RenderS::T_DrawRBG<0, 4, 0, 0, 2, 0>, &RenderS::T_DrawRBG<0, 4, 0, 0, 2, 1>, &RenderS::T_DrawRBG<0, 4, 0, 0, 2, 2>, &RenderS::T_DrawRBG<0, 4, 0, 0, 2, 3>,  },  },  {  { &RenderS::T_DrawRBG<0, 4, 0, 1, 0, 0>, &RenderS::T_DrawRBG<0, 4, 0, 1, 0, 1>, &RenderS::T_DrawRBG<0, 4, 0, 1, 0, 2>, &RenderS::T_DrawRBG<0, 4, 0, 1, 0, 3>,  },  { &RenderS::T_DrawRBG<0, 4, 0, 1, 1, 0>, &RenderS::T_DrawRBG<0, 4, 0, 1, 1, 1>, &RenderS::T_DrawRBG<0, 4, 0, 1, 1, 2>, &RenderS::T_DrawRBG<0, 4, 0, 1, 1, 3>,  },  { &RenderS::T_DrawRBG<0, 4, 0, 1, 2, 0>, &RenderS::T_DrawRBG<0, 4, 0, 1, 2, 1>, &RenderS::T_DrawRBG<0, 4, 0, 1, 2, 2>, &RenderS::T_DrawRBG<0, 4, 0, 1, 2, 3>,  },  },  },
+  {  {  { &RenderS::T_DrawRBG<0, 8, 0, 0, 0, 0>, &RenderS::T_DrawRBG<0, 8, 0, 0, 0, 1>, &RenderS::T_DrawRBG<0, 8, 0, 0, 0, 2>, &RenderS::T_DrawRBG<0, 8, 0, 0, 0, 3>,  },  { &RenderS::T_DrawRBG<0, 8, 0, 0, 1, 0>, &RenderS::T_DrawRBG<0, 8, 0, 0, 1, 1>, &RenderS::T_DrawRBG<0, 8, 0, 0, 1, 2>, &RenderS::T_DrawRBG<0, 8, 0, 0, 1, 3>,  },  { &RenderS::T_DrawRBG<0, 8, 0, 0, 2, 0>, &RenderS::T_DrawRBG<0, 8, 0, 0, 2, 1>, &RenderS::T_DrawRBG<0, 8, 0, 0, 2, 2>, &RenderS::T_DrawRBG<0, 8, 0, 0, 2, 3>,  },  },  {  { &RenderS::T_DrawRBG<0, 8, 0, 1, 0, 0>, &RenderS::T_DrawRBG<0, 8, 0, 1, 0, 1>, &RenderS::T_DrawRBG<0, 8, 0, 1, 0, 2>, &RenderS::T_DrawRBG<0, 8, 0, 1, 0, 3>,  },  { &RenderS::T_DrawRBG<0, 8, 0, 1, 1, 0>, &RenderS::T_DrawRBG<0, 8, 0, 1, 1, 1>, &RenderS::T_DrawRBG<0, 8, 0, 1, 1, 2>, &RenderS::T_DrawRBG<0, 8, 0, 1, 1, 3>,  },  { &RenderS::T_DrawRBG<0, 8, 0, 1, 2, 0>, &RenderS::T_DrawRBG<0, 8, 0, 1, 2, 1>, &RenderS::T_DrawRBG<0, 8, 0, 1, 2, 2>, &RenderS::T_DrawRBG<0, 8, 0, 1, 2, 3>,  },  },  },
+  {  {  { &RenderS::T_DrawRBG<0, 16, 0, 0, 0, 0>, &RenderS::T_DrawRBG<0, 16, 0, 0, 0, 1>, &RenderS::T_DrawRBG<0, 16, 0, 0, 0, 2>, &RenderS::T_DrawRBG<0, 16, 0, 0, 0, 3>,  },  { &RenderS::T_DrawRBG<0, 16, 0, 0, 1, 0>, &RenderS::T_DrawRBG<0, 16, 0, 0, 1, 1>, &RenderS::T_DrawRBG<0, 16, 0, 0, 1, 2>, &RenderS::T_DrawRBG<0, 16, 0, 0, 1, 3>,  },  { &RenderS::T_DrawRBG<0, 16, 0, 0, 2, 0>, &RenderS::T_DrawRBG<0, 16, 0, 0, 2, 1>, &RenderS::T_DrawRBG<0, 16, 0, 0, 2, 2>, &RenderS::T_DrawRBG<0, 16, 0, 0, 2, 3>,  },  },  {  { &RenderS::T_DrawRBG<0, 16, 0, 1, 0, 0>, &RenderS::T_DrawRBG<0, 16, 0, 1, 0, 1>, &RenderS::T_DrawRBG<0, 16, 0, 1, 0, 2>, &RenderS::T_DrawRBG<0, 16, 0, 1, 0, 3>,  },  { &RenderS::T_DrawRBG<0, 16, 0, 1, 1, 0>, &RenderS::T_DrawRBG<0, 16, 0, 1, 1, 1>, &RenderS::T_DrawRBG<0, 16, 0, 1, 1, 2>, &RenderS::T_DrawRBG<0, 16, 0, 1, 1, 3>,  },  { &RenderS::T_DrawRBG<0, 16, 0, 1, 2, 0>, &RenderS::T_DrawRBG<0, 16, 0, 1, 2, 1>, &RenderS::T_DrawRBG<0, 16, 0, 1, 2, 2>, &RenderS::T_DrawRBG<0, 16, 0, 1, 2, 3>,  },  },  },
+  {  {  { &RenderS::T_DrawRBG<0, 16, 1, 0, 0, 0>, &RenderS::T_DrawRBG<0, 16, 1, 0, 0, 1>, &RenderS::T_DrawRBG<0, 16, 1, 0, 0, 2>, &RenderS::T_DrawRBG<0, 16, 1, 0, 0, 3>,  },  { &RenderS::T_DrawRBG<0, 16, 1, 0, 1, 0>, &RenderS::T_DrawRBG<0, 16, 1, 0, 1, 1>, &RenderS::T_DrawRBG<0, 16, 1, 0, 1, 2>, &RenderS::T_DrawRBG<0, 16, 1, 0, 1, 3>,  },  { &RenderS::T_DrawRBG<0, 16, 1, 0, 2, 0>, &RenderS::T_DrawRBG<0, 16, 1, 0, 2, 1>, &RenderS::T_DrawRBG<0, 16, 1, 0, 2, 2>, &RenderS::T_DrawRBG<0, 16, 1, 0, 2, 3>,  },  },  {  { &RenderS::T_DrawRBG<0, 16, 1, 1, 0, 0>, &RenderS::T_DrawRBG<0, 16, 1, 1, 0, 1>, &RenderS::T_DrawRBG<0, 16, 1, 1, 0, 2>, &RenderS::T_DrawRBG<0, 16, 1, 1, 0, 3>,  },  { &RenderS::T_DrawRBG<0, 16, 1, 1, 1, 0>, &RenderS::T_DrawRBG<0, 16, 1, 1, 1, 1>, &RenderS::T_DrawRBG<0, 16, 1, 1, 1, 2>, &RenderS::T_DrawRBG<0, 16, 1, 1, 1, 3>,  },  { &RenderS::T_DrawRBG<0, 16, 1, 1, 2, 0>, &RenderS::T_DrawRBG<0, 16, 1, 1, 2, 1>, &RenderS::T_DrawRBG<0, 16, 1, 1, 2, 2>, &RenderS::T_DrawRBG<0, 16, 1, 1, 2, 3>,  },  },  },
+  {  {  { &RenderS::T_DrawRBG<0, 32, 1, 0, 0, 0>, &RenderS::T_DrawRBG<0, 32, 1, 0, 0, 1>, &RenderS::T_DrawRBG<0, 32, 1, 0, 0, 2>, &RenderS::T_DrawRBG<0, 32, 1, 0, 0, 3>,  },  { &RenderS::T_DrawRBG<0, 32, 1, 0, 1, 0>, &RenderS::T_DrawRBG<0, 32, 1, 0, 1, 1>, &RenderS::T_DrawRBG<0, 32, 1, 0, 1, 2>, &RenderS::T_DrawRBG<0, 32, 1, 0, 1, 3>,  },  { &RenderS::T_DrawRBG<0, 32, 1, 0, 2, 0>, &RenderS::T_DrawRBG<0, 32, 1, 0, 2, 1>, &RenderS::T_DrawRBG<0, 32, 1, 0, 2, 2>, &RenderS::T_DrawRBG<0, 32, 1, 0, 2, 3>,  },  },  {  { &RenderS::T_DrawRBG<0, 32, 1, 1, 0, 0>, &RenderS::T_DrawRBG<0, 32, 1, 1, 0, 1>, &RenderS::T_DrawRBG<0, 32, 1, 1, 0, 2>, &RenderS::T_DrawRBG<0, 32, 1, 1, 0, 3>,  },  { &RenderS::T_DrawRBG<0, 32, 1, 1, 1, 0>, &RenderS::T_DrawRBG<0, 32, 1, 1, 1, 1>, &RenderS::T_DrawRBG<0, 32, 1, 1, 1, 2>, &RenderS::T_DrawRBG<0, 32, 1, 1, 1, 3>,  },  { &RenderS::T_DrawRBG<0, 32, 1, 1, 2, 0>, &RenderS::T_DrawRBG<0, 32, 1, 1, 2, 1>, &RenderS::T_DrawRBG<0, 32, 1, 1, 2, 2>, &RenderS::T_DrawRBG<0, 32, 1, 1, 2, 3>,  },  },  },
  },
  {
-  {  {  { T_DrawRBG<1, 4, 0, 0, 0, 0>, T_DrawRBG<1, 4, 0, 0, 0, 1>, T_DrawRBG<1, 4, 0, 0, 0, 2>, T_DrawRBG<1, 4, 0, 0, 0, 3>,  },  { T_DrawRBG<1, 4, 0, 0, 1, 0>, T_DrawRBG<1, 4, 0, 0, 1, 1>, T_DrawRBG<1, 4, 0, 0, 1, 2>, T_DrawRBG<1, 4, 0, 0, 1, 3>,  },  { T_DrawRBG<1, 4, 0, 0, 2, 0>, T_DrawRBG<1, 4, 0, 0, 2, 1>, T_DrawRBG<1, 4, 0, 0, 2, 2>, T_DrawRBG<1, 4, 0, 0, 2, 3>,  },  },  {  { T_DrawRBG<1, 4, 0, 1, 0, 0>, T_DrawRBG<1, 4, 0, 1, 0, 1>, T_DrawRBG<1, 4, 0, 1, 0, 2>, T_DrawRBG<1, 4, 0, 1, 0, 3>,  },  { T_DrawRBG<1, 4, 0, 1, 1, 0>, T_DrawRBG<1, 4, 0, 1, 1, 1>, T_DrawRBG<1, 4, 0, 1, 1, 2>, T_DrawRBG<1, 4, 0, 1, 1, 3>,  },  { T_DrawRBG<1, 4, 0, 1, 2, 0>, T_DrawRBG<1, 4, 0, 1, 2, 1>, T_DrawRBG<1, 4, 0, 1, 2, 2>, T_DrawRBG<1, 4, 0, 1, 2, 3>,  },  },  },
-  {  {  { T_DrawRBG<1, 8, 0, 0, 0, 0>, T_DrawRBG<1, 8, 0, 0, 0, 1>, T_DrawRBG<1, 8, 0, 0, 0, 2>, T_DrawRBG<1, 8, 0, 0, 0, 3>,  },  { T_DrawRBG<1, 8, 0, 0, 1, 0>, T_DrawRBG<1, 8, 0, 0, 1, 1>, T_DrawRBG<1, 8, 0, 0, 1, 2>, T_DrawRBG<1, 8, 0, 0, 1, 3>,  },  { T_DrawRBG<1, 8, 0, 0, 2, 0>, T_DrawRBG<1, 8, 0, 0, 2, 1>, T_DrawRBG<1, 8, 0, 0, 2, 2>, T_DrawRBG<1, 8, 0, 0, 2, 3>,  },  },  {  { T_DrawRBG<1, 8, 0, 1, 0, 0>, T_DrawRBG<1, 8, 0, 1, 0, 1>, T_DrawRBG<1, 8, 0, 1, 0, 2>, T_DrawRBG<1, 8, 0, 1, 0, 3>,  },  { T_DrawRBG<1, 8, 0, 1, 1, 0>, T_DrawRBG<1, 8, 0, 1, 1, 1>, T_DrawRBG<1, 8, 0, 1, 1, 2>, T_DrawRBG<1, 8, 0, 1, 1, 3>,  },  { T_DrawRBG<1, 8, 0, 1, 2, 0>, T_DrawRBG<1, 8, 0, 1, 2, 1>, T_DrawRBG<1, 8, 0, 1, 2, 2>, T_DrawRBG<1, 8, 0, 1, 2, 3>,  },  },  },
-  {  {  { T_DrawRBG<1, 16, 0, 0, 0, 0>, T_DrawRBG<1, 16, 0, 0, 0, 1>, T_DrawRBG<1, 16, 0, 0, 0, 2>, T_DrawRBG<1, 16, 0, 0, 0, 3>,  },  { T_DrawRBG<1, 16, 0, 0, 1, 0>, T_DrawRBG<1, 16, 0, 0, 1, 1>, T_DrawRBG<1, 16, 0, 0, 1, 2>, T_DrawRBG<1, 16, 0, 0, 1, 3>,  },  { T_DrawRBG<1, 16, 0, 0, 2, 0>, T_DrawRBG<1, 16, 0, 0, 2, 1>, T_DrawRBG<1, 16, 0, 0, 2, 2>, T_DrawRBG<1, 16, 0, 0, 2, 3>,  },  },  {  { T_DrawRBG<1, 16, 0, 1, 0, 0>, T_DrawRBG<1, 16, 0, 1, 0, 1>, T_DrawRBG<1, 16, 0, 1, 0, 2>, T_DrawRBG<1, 16, 0, 1, 0, 3>,  },  { T_DrawRBG<1, 16, 0, 1, 1, 0>, T_DrawRBG<1, 16, 0, 1, 1, 1>, T_DrawRBG<1, 16, 0, 1, 1, 2>, T_DrawRBG<1, 16, 0, 1, 1, 3>,  },  { T_DrawRBG<1, 16, 0, 1, 2, 0>, T_DrawRBG<1, 16, 0, 1, 2, 1>, T_DrawRBG<1, 16, 0, 1, 2, 2>, T_DrawRBG<1, 16, 0, 1, 2, 3>,  },  },  },
-  {  {  { T_DrawRBG<1, 16, 1, 0, 0, 0>, T_DrawRBG<1, 16, 1, 0, 0, 1>, T_DrawRBG<1, 16, 1, 0, 0, 2>, T_DrawRBG<1, 16, 1, 0, 0, 3>,  },  { T_DrawRBG<1, 16, 1, 0, 1, 0>, T_DrawRBG<1, 16, 1, 0, 1, 1>, T_DrawRBG<1, 16, 1, 0, 1, 2>, T_DrawRBG<1, 16, 1, 0, 1, 3>,  },  { T_DrawRBG<1, 16, 1, 0, 2, 0>, T_DrawRBG<1, 16, 1, 0, 2, 1>, T_DrawRBG<1, 16, 1, 0, 2, 2>, T_DrawRBG<1, 16, 1, 0, 2, 3>,  },  },  {  { T_DrawRBG<1, 16, 1, 1, 0, 0>, T_DrawRBG<1, 16, 1, 1, 0, 1>, T_DrawRBG<1, 16, 1, 1, 0, 2>, T_DrawRBG<1, 16, 1, 1, 0, 3>,  },  { T_DrawRBG<1, 16, 1, 1, 1, 0>, T_DrawRBG<1, 16, 1, 1, 1, 1>, T_DrawRBG<1, 16, 1, 1, 1, 2>, T_DrawRBG<1, 16, 1, 1, 1, 3>,  },  { T_DrawRBG<1, 16, 1, 1, 2, 0>, T_DrawRBG<1, 16, 1, 1, 2, 1>, T_DrawRBG<1, 16, 1, 1, 2, 2>, T_DrawRBG<1, 16, 1, 1, 2, 3>,  },  },  },
-  {  {  { T_DrawRBG<1, 32, 1, 0, 0, 0>, T_DrawRBG<1, 32, 1, 0, 0, 1>, T_DrawRBG<1, 32, 1, 0, 0, 2>, T_DrawRBG<1, 32, 1, 0, 0, 3>,  },  { T_DrawRBG<1, 32, 1, 0, 1, 0>, T_DrawRBG<1, 32, 1, 0, 1, 1>, T_DrawRBG<1, 32, 1, 0, 1, 2>, T_DrawRBG<1, 32, 1, 0, 1, 3>,  },  { T_DrawRBG<1, 32, 1, 0, 2, 0>, T_DrawRBG<1, 32, 1, 0, 2, 1>, T_DrawRBG<1, 32, 1, 0, 2, 2>, T_DrawRBG<1, 32, 1, 0, 2, 3>,  },  },  {  { T_DrawRBG<1, 32, 1, 1, 0, 0>, T_DrawRBG<1, 32, 1, 1, 0, 1>, T_DrawRBG<1, 32, 1, 1, 0, 2>, T_DrawRBG<1, 32, 1, 1, 0, 3>,  },  { T_DrawRBG<1, 32, 1, 1, 1, 0>, T_DrawRBG<1, 32, 1, 1, 1, 1>, T_DrawRBG<1, 32, 1, 1, 1, 2>, T_DrawRBG<1, 32, 1, 1, 1, 3>,  },  { T_DrawRBG<1, 32, 1, 1, 2, 0>, T_DrawRBG<1, 32, 1, 1, 2, 1>, T_DrawRBG<1, 32, 1, 1, 2, 2>, T_DrawRBG<1, 32, 1, 1, 2, 3>,  },  },  },
+  {  {  { &RenderS::T_DrawRBG<1, 4, 0, 0, 0, 0>, &RenderS::T_DrawRBG<1, 4, 0, 0, 0, 1>, &RenderS::T_DrawRBG<1, 4, 0, 0, 0, 2>, &RenderS::T_DrawRBG<1, 4, 0, 0, 0, 3>,  },  { &RenderS::T_DrawRBG<1, 4, 0, 0, 1, 0>, &RenderS::T_DrawRBG<1, 4, 0, 0, 1, 1>, &RenderS::T_DrawRBG<1, 4, 0, 0, 1, 2>, &RenderS::T_DrawRBG<1, 4, 0, 0, 1, 3>,  },  { &RenderS::T_DrawRBG<1, 4, 0, 0, 2, 0>, &RenderS::T_DrawRBG<1, 4, 0, 0, 2, 1>, &RenderS::T_DrawRBG<1, 4, 0, 0, 2, 2>, &RenderS::T_DrawRBG<1, 4, 0, 0, 2, 3>,  },  },  {  { &RenderS::T_DrawRBG<1, 4, 0, 1, 0, 0>, &RenderS::T_DrawRBG<1, 4, 0, 1, 0, 1>, &RenderS::T_DrawRBG<1, 4, 0, 1, 0, 2>, &RenderS::T_DrawRBG<1, 4, 0, 1, 0, 3>,  },  { &RenderS::T_DrawRBG<1, 4, 0, 1, 1, 0>, &RenderS::T_DrawRBG<1, 4, 0, 1, 1, 1>, &RenderS::T_DrawRBG<1, 4, 0, 1, 1, 2>, &RenderS::T_DrawRBG<1, 4, 0, 1, 1, 3>,  },  { &RenderS::T_DrawRBG<1, 4, 0, 1, 2, 0>, &RenderS::T_DrawRBG<1, 4, 0, 1, 2, 1>, &RenderS::T_DrawRBG<1, 4, 0, 1, 2, 2>, &RenderS::T_DrawRBG<1, 4, 0, 1, 2, 3>,  },  },  },
+  {  {  { &RenderS::T_DrawRBG<1, 8, 0, 0, 0, 0>, &RenderS::T_DrawRBG<1, 8, 0, 0, 0, 1>, &RenderS::T_DrawRBG<1, 8, 0, 0, 0, 2>, &RenderS::T_DrawRBG<1, 8, 0, 0, 0, 3>,  },  { &RenderS::T_DrawRBG<1, 8, 0, 0, 1, 0>, &RenderS::T_DrawRBG<1, 8, 0, 0, 1, 1>, &RenderS::T_DrawRBG<1, 8, 0, 0, 1, 2>, &RenderS::T_DrawRBG<1, 8, 0, 0, 1, 3>,  },  { &RenderS::T_DrawRBG<1, 8, 0, 0, 2, 0>, &RenderS::T_DrawRBG<1, 8, 0, 0, 2, 1>, &RenderS::T_DrawRBG<1, 8, 0, 0, 2, 2>, &RenderS::T_DrawRBG<1, 8, 0, 0, 2, 3>,  },  },  {  { &RenderS::T_DrawRBG<1, 8, 0, 1, 0, 0>, &RenderS::T_DrawRBG<1, 8, 0, 1, 0, 1>, &RenderS::T_DrawRBG<1, 8, 0, 1, 0, 2>, &RenderS::T_DrawRBG<1, 8, 0, 1, 0, 3>,  },  { &RenderS::T_DrawRBG<1, 8, 0, 1, 1, 0>, &RenderS::T_DrawRBG<1, 8, 0, 1, 1, 1>, &RenderS::T_DrawRBG<1, 8, 0, 1, 1, 2>, &RenderS::T_DrawRBG<1, 8, 0, 1, 1, 3>,  },  { &RenderS::T_DrawRBG<1, 8, 0, 1, 2, 0>, &RenderS::T_DrawRBG<1, 8, 0, 1, 2, 1>, &RenderS::T_DrawRBG<1, 8, 0, 1, 2, 2>, &RenderS::T_DrawRBG<1, 8, 0, 1, 2, 3>,  },  },  },
+  {  {  { &RenderS::T_DrawRBG<1, 16, 0, 0, 0, 0>, &RenderS::T_DrawRBG<1, 16, 0, 0, 0, 1>, &RenderS::T_DrawRBG<1, 16, 0, 0, 0, 2>, &RenderS::T_DrawRBG<1, 16, 0, 0, 0, 3>,  },  { &RenderS::T_DrawRBG<1, 16, 0, 0, 1, 0>, &RenderS::T_DrawRBG<1, 16, 0, 0, 1, 1>, &RenderS::T_DrawRBG<1, 16, 0, 0, 1, 2>, &RenderS::T_DrawRBG<1, 16, 0, 0, 1, 3>,  },  { &RenderS::T_DrawRBG<1, 16, 0, 0, 2, 0>, &RenderS::T_DrawRBG<1, 16, 0, 0, 2, 1>, &RenderS::T_DrawRBG<1, 16, 0, 0, 2, 2>, &RenderS::T_DrawRBG<1, 16, 0, 0, 2, 3>,  },  },  {  { &RenderS::T_DrawRBG<1, 16, 0, 1, 0, 0>, &RenderS::T_DrawRBG<1, 16, 0, 1, 0, 1>, &RenderS::T_DrawRBG<1, 16, 0, 1, 0, 2>, &RenderS::T_DrawRBG<1, 16, 0, 1, 0, 3>,  },  { &RenderS::T_DrawRBG<1, 16, 0, 1, 1, 0>, &RenderS::T_DrawRBG<1, 16, 0, 1, 1, 1>, &RenderS::T_DrawRBG<1, 16, 0, 1, 1, 2>, &RenderS::T_DrawRBG<1, 16, 0, 1, 1, 3>,  },  { &RenderS::T_DrawRBG<1, 16, 0, 1, 2, 0>, &RenderS::T_DrawRBG<1, 16, 0, 1, 2, 1>, &RenderS::T_DrawRBG<1, 16, 0, 1, 2, 2>, &RenderS::T_DrawRBG<1, 16, 0, 1, 2, 3>,  },  },  },
+  {  {  { &RenderS::T_DrawRBG<1, 16, 1, 0, 0, 0>, &RenderS::T_DrawRBG<1, 16, 1, 0, 0, 1>, &RenderS::T_DrawRBG<1, 16, 1, 0, 0, 2>, &RenderS::T_DrawRBG<1, 16, 1, 0, 0, 3>,  },  { &RenderS::T_DrawRBG<1, 16, 1, 0, 1, 0>, &RenderS::T_DrawRBG<1, 16, 1, 0, 1, 1>, &RenderS::T_DrawRBG<1, 16, 1, 0, 1, 2>, &RenderS::T_DrawRBG<1, 16, 1, 0, 1, 3>,  },  { &RenderS::T_DrawRBG<1, 16, 1, 0, 2, 0>, &RenderS::T_DrawRBG<1, 16, 1, 0, 2, 1>, &RenderS::T_DrawRBG<1, 16, 1, 0, 2, 2>, &RenderS::T_DrawRBG<1, 16, 1, 0, 2, 3>,  },  },  {  { &RenderS::T_DrawRBG<1, 16, 1, 1, 0, 0>, &RenderS::T_DrawRBG<1, 16, 1, 1, 0, 1>, &RenderS::T_DrawRBG<1, 16, 1, 1, 0, 2>, &RenderS::T_DrawRBG<1, 16, 1, 1, 0, 3>,  },  { &RenderS::T_DrawRBG<1, 16, 1, 1, 1, 0>, &RenderS::T_DrawRBG<1, 16, 1, 1, 1, 1>, &RenderS::T_DrawRBG<1, 16, 1, 1, 1, 2>, &RenderS::T_DrawRBG<1, 16, 1, 1, 1, 3>,  },  { &RenderS::T_DrawRBG<1, 16, 1, 1, 2, 0>, &RenderS::T_DrawRBG<1, 16, 1, 1, 2, 1>, &RenderS::T_DrawRBG<1, 16, 1, 1, 2, 2>, &RenderS::T_DrawRBG<1, 16, 1, 1, 2, 3>,  },  },  },
+  {  {  { &RenderS::T_DrawRBG<1, 32, 1, 0, 0, 0>, &RenderS::T_DrawRBG<1, 32, 1, 0, 0, 1>, &RenderS::T_DrawRBG<1, 32, 1, 0, 0, 2>, &RenderS::T_DrawRBG<1, 32, 1, 0, 0, 3>,  },  { &RenderS::T_DrawRBG<1, 32, 1, 0, 1, 0>, &RenderS::T_DrawRBG<1, 32, 1, 0, 1, 1>, &RenderS::T_DrawRBG<1, 32, 1, 0, 1, 2>, &RenderS::T_DrawRBG<1, 32, 1, 0, 1, 3>,  },  { &RenderS::T_DrawRBG<1, 32, 1, 0, 2, 0>, &RenderS::T_DrawRBG<1, 32, 1, 0, 2, 1>, &RenderS::T_DrawRBG<1, 32, 1, 0, 2, 2>, &RenderS::T_DrawRBG<1, 32, 1, 0, 2, 3>,  },  },  {  { &RenderS::T_DrawRBG<1, 32, 1, 1, 0, 0>, &RenderS::T_DrawRBG<1, 32, 1, 1, 0, 1>, &RenderS::T_DrawRBG<1, 32, 1, 1, 0, 2>, &RenderS::T_DrawRBG<1, 32, 1, 1, 0, 3>,  },  { &RenderS::T_DrawRBG<1, 32, 1, 1, 1, 0>, &RenderS::T_DrawRBG<1, 32, 1, 1, 1, 1>, &RenderS::T_DrawRBG<1, 32, 1, 1, 1, 2>, &RenderS::T_DrawRBG<1, 32, 1, 1, 1, 3>,  },  { &RenderS::T_DrawRBG<1, 32, 1, 1, 2, 0>, &RenderS::T_DrawRBG<1, 32, 1, 1, 2, 1>, &RenderS::T_DrawRBG<1, 32, 1, 1, 2, 2>, &RenderS::T_DrawRBG<1, 32, 1, 1, 2, 3>,  },  },  },
  }
 };
 
@@ -2058,7 +2128,7 @@ static INLINE void Doubleize(T* ptr, const int orig_len)
  }
 }
 
-static void RBGPP(const unsigned layer, uint64* buf, const unsigned rbg_w)
+void RenderS::RBGPP(const unsigned layer, uint64* buf, const unsigned rbg_w)
 {
  ApplyHMosaic(layer, buf, rbg_w);
 
@@ -2079,7 +2149,7 @@ static void RBGPP(const unsigned layer, uint64* buf, const unsigned rbg_w)
 }
 
 // Call before DrawSpriteData()
-static INLINE void MakeSpriteCCLUT(void)
+INLINE void RenderS::MakeSpriteCCLUT(void)
 {
  const bool cce = ((CCCTL >> 6) & 1);
 
@@ -2102,7 +2172,7 @@ static INLINE void MakeSpriteCCLUT(void)
 }
 
 template<bool TA_HiRes, bool TA_TPShadSel, unsigned TA_SPCTL_Low>
-static void T_DrawSpriteData(const uint16* vdp1sb, const bool vdp1_hires8, unsigned w)
+void RenderS::T_DrawSpriteData(const uint16* vdp1sb, const bool vdp1_hires8, unsigned w)
 {
  const unsigned SpriteType = (TA_SPCTL_Low & 0xF);
  const bool SpriteWinEn = (TA_SPCTL_Low & 0x10);
@@ -2317,15 +2387,15 @@ static void T_DrawSpriteData(const uint16* vdp1sb, const bool vdp1_hires8, unsig
  }
 }
 
-static void (*DrawSpriteData[2][2][0x40])(const uint16* vdp1sb, const bool vdp1_hires8, unsigned w) =
+static void (RenderS::*DrawSpriteData[2][2][0x40])(const uint16* vdp1sb, const bool vdp1_hires8, unsigned w) =
 {
  {
-  { T_DrawSpriteData<0, 0, 0x00>, T_DrawSpriteData<0, 0, 0x01>, T_DrawSpriteData<0, 0, 0x02>, T_DrawSpriteData<0, 0, 0x03>, T_DrawSpriteData<0, 0, 0x04>, T_DrawSpriteData<0, 0, 0x05>, T_DrawSpriteData<0, 0, 0x06>, T_DrawSpriteData<0, 0, 0x07>, T_DrawSpriteData<0, 0, 0x08>, T_DrawSpriteData<0, 0, 0x09>, T_DrawSpriteData<0, 0, 0x0a>, T_DrawSpriteData<0, 0, 0x0b>, T_DrawSpriteData<0, 0, 0x0c>, T_DrawSpriteData<0, 0, 0x0d>, T_DrawSpriteData<0, 0, 0x0e>, T_DrawSpriteData<0, 0, 0x0f>, T_DrawSpriteData<0, 0, 0x10>, T_DrawSpriteData<0, 0, 0x11>, T_DrawSpriteData<0, 0, 0x12>, T_DrawSpriteData<0, 0, 0x13>, T_DrawSpriteData<0, 0, 0x14>, T_DrawSpriteData<0, 0, 0x15>, T_DrawSpriteData<0, 0, 0x16>, T_DrawSpriteData<0, 0, 0x17>, T_DrawSpriteData<0, 0, 0x18>, T_DrawSpriteData<0, 0, 0x19>, T_DrawSpriteData<0, 0, 0x1a>, T_DrawSpriteData<0, 0, 0x1b>, T_DrawSpriteData<0, 0, 0x1c>, T_DrawSpriteData<0, 0, 0x1d>, T_DrawSpriteData<0, 0, 0x1e>, T_DrawSpriteData<0, 0, 0x1f>, T_DrawSpriteData<0, 0, 0x20>, T_DrawSpriteData<0, 0, 0x21>, T_DrawSpriteData<0, 0, 0x22>, T_DrawSpriteData<0, 0, 0x23>, T_DrawSpriteData<0, 0, 0x24>, T_DrawSpriteData<0, 0, 0x25>, T_DrawSpriteData<0, 0, 0x26>, T_DrawSpriteData<0, 0, 0x27>, T_DrawSpriteData<0, 0, 0x28>, T_DrawSpriteData<0, 0, 0x29>, T_DrawSpriteData<0, 0, 0x2a>, T_DrawSpriteData<0, 0, 0x2b>, T_DrawSpriteData<0, 0, 0x2c>, T_DrawSpriteData<0, 0, 0x2d>, T_DrawSpriteData<0, 0, 0x2e>, T_DrawSpriteData<0, 0, 0x2f>, T_DrawSpriteData<0, 0, 0x30>, T_DrawSpriteData<0, 0, 0x31>, T_DrawSpriteData<0, 0, 0x32>, T_DrawSpriteData<0, 0, 0x33>, T_DrawSpriteData<0, 0, 0x34>, T_DrawSpriteData<0, 0, 0x35>, T_DrawSpriteData<0, 0, 0x36>, T_DrawSpriteData<0, 0, 0x37>, T_DrawSpriteData<0, 0, 0x38>, T_DrawSpriteData<0, 0, 0x39>, T_DrawSpriteData<0, 0, 0x3a>, T_DrawSpriteData<0, 0, 0x3b>, T_DrawSpriteData<0, 0, 0x3c>, T_DrawSpriteData<0, 0, 0x3d>, T_DrawSpriteData<0, 0, 0x3e>, T_DrawSpriteData<0, 0, 0x3f> },
-  { T_DrawSpriteData<0, 1, 0x00>, T_DrawSpriteData<0, 1, 0x01>, T_DrawSpriteData<0, 1, 0x02>, T_DrawSpriteData<0, 1, 0x03>, T_DrawSpriteData<0, 1, 0x04>, T_DrawSpriteData<0, 1, 0x05>, T_DrawSpriteData<0, 1, 0x06>, T_DrawSpriteData<0, 1, 0x07>, T_DrawSpriteData<0, 1, 0x08>, T_DrawSpriteData<0, 1, 0x09>, T_DrawSpriteData<0, 1, 0x0a>, T_DrawSpriteData<0, 1, 0x0b>, T_DrawSpriteData<0, 1, 0x0c>, T_DrawSpriteData<0, 1, 0x0d>, T_DrawSpriteData<0, 1, 0x0e>, T_DrawSpriteData<0, 1, 0x0f>, T_DrawSpriteData<0, 1, 0x10>, T_DrawSpriteData<0, 1, 0x11>, T_DrawSpriteData<0, 1, 0x12>, T_DrawSpriteData<0, 1, 0x13>, T_DrawSpriteData<0, 1, 0x14>, T_DrawSpriteData<0, 1, 0x15>, T_DrawSpriteData<0, 1, 0x16>, T_DrawSpriteData<0, 1, 0x17>, T_DrawSpriteData<0, 1, 0x18>, T_DrawSpriteData<0, 1, 0x19>, T_DrawSpriteData<0, 1, 0x1a>, T_DrawSpriteData<0, 1, 0x1b>, T_DrawSpriteData<0, 1, 0x1c>, T_DrawSpriteData<0, 1, 0x1d>, T_DrawSpriteData<0, 1, 0x1e>, T_DrawSpriteData<0, 1, 0x1f>, T_DrawSpriteData<0, 1, 0x20>, T_DrawSpriteData<0, 1, 0x21>, T_DrawSpriteData<0, 1, 0x22>, T_DrawSpriteData<0, 1, 0x23>, T_DrawSpriteData<0, 1, 0x24>, T_DrawSpriteData<0, 1, 0x25>, T_DrawSpriteData<0, 1, 0x26>, T_DrawSpriteData<0, 1, 0x27>, T_DrawSpriteData<0, 1, 0x28>, T_DrawSpriteData<0, 1, 0x29>, T_DrawSpriteData<0, 1, 0x2a>, T_DrawSpriteData<0, 1, 0x2b>, T_DrawSpriteData<0, 1, 0x2c>, T_DrawSpriteData<0, 1, 0x2d>, T_DrawSpriteData<0, 1, 0x2e>, T_DrawSpriteData<0, 1, 0x2f>, T_DrawSpriteData<0, 1, 0x30>, T_DrawSpriteData<0, 1, 0x31>, T_DrawSpriteData<0, 1, 0x32>, T_DrawSpriteData<0, 1, 0x33>, T_DrawSpriteData<0, 1, 0x34>, T_DrawSpriteData<0, 1, 0x35>, T_DrawSpriteData<0, 1, 0x36>, T_DrawSpriteData<0, 1, 0x37>, T_DrawSpriteData<0, 1, 0x38>, T_DrawSpriteData<0, 1, 0x39>, T_DrawSpriteData<0, 1, 0x3a>, T_DrawSpriteData<0, 1, 0x3b>, T_DrawSpriteData<0, 1, 0x3c>, T_DrawSpriteData<0, 1, 0x3d>, T_DrawSpriteData<0, 1, 0x3e>, T_DrawSpriteData<0, 1, 0x3f> },
+  { &RenderS::T_DrawSpriteData<0, 0, 0x00>, &RenderS::T_DrawSpriteData<0, 0, 0x01>, &RenderS::T_DrawSpriteData<0, 0, 0x02>, &RenderS::T_DrawSpriteData<0, 0, 0x03>, &RenderS::T_DrawSpriteData<0, 0, 0x04>, &RenderS::T_DrawSpriteData<0, 0, 0x05>, &RenderS::T_DrawSpriteData<0, 0, 0x06>, &RenderS::T_DrawSpriteData<0, 0, 0x07>, &RenderS::T_DrawSpriteData<0, 0, 0x08>, &RenderS::T_DrawSpriteData<0, 0, 0x09>, &RenderS::T_DrawSpriteData<0, 0, 0x0a>, &RenderS::T_DrawSpriteData<0, 0, 0x0b>, &RenderS::T_DrawSpriteData<0, 0, 0x0c>, &RenderS::T_DrawSpriteData<0, 0, 0x0d>, &RenderS::T_DrawSpriteData<0, 0, 0x0e>, &RenderS::T_DrawSpriteData<0, 0, 0x0f>, &RenderS::T_DrawSpriteData<0, 0, 0x10>, &RenderS::T_DrawSpriteData<0, 0, 0x11>, &RenderS::T_DrawSpriteData<0, 0, 0x12>, &RenderS::T_DrawSpriteData<0, 0, 0x13>, &RenderS::T_DrawSpriteData<0, 0, 0x14>, &RenderS::T_DrawSpriteData<0, 0, 0x15>, &RenderS::T_DrawSpriteData<0, 0, 0x16>, &RenderS::T_DrawSpriteData<0, 0, 0x17>, &RenderS::T_DrawSpriteData<0, 0, 0x18>, &RenderS::T_DrawSpriteData<0, 0, 0x19>, &RenderS::T_DrawSpriteData<0, 0, 0x1a>, &RenderS::T_DrawSpriteData<0, 0, 0x1b>, &RenderS::T_DrawSpriteData<0, 0, 0x1c>, &RenderS::T_DrawSpriteData<0, 0, 0x1d>, &RenderS::T_DrawSpriteData<0, 0, 0x1e>, &RenderS::T_DrawSpriteData<0, 0, 0x1f>, &RenderS::T_DrawSpriteData<0, 0, 0x20>, &RenderS::T_DrawSpriteData<0, 0, 0x21>, &RenderS::T_DrawSpriteData<0, 0, 0x22>, &RenderS::T_DrawSpriteData<0, 0, 0x23>, &RenderS::T_DrawSpriteData<0, 0, 0x24>, &RenderS::T_DrawSpriteData<0, 0, 0x25>, &RenderS::T_DrawSpriteData<0, 0, 0x26>, &RenderS::T_DrawSpriteData<0, 0, 0x27>, &RenderS::T_DrawSpriteData<0, 0, 0x28>, &RenderS::T_DrawSpriteData<0, 0, 0x29>, &RenderS::T_DrawSpriteData<0, 0, 0x2a>, &RenderS::T_DrawSpriteData<0, 0, 0x2b>, &RenderS::T_DrawSpriteData<0, 0, 0x2c>, &RenderS::T_DrawSpriteData<0, 0, 0x2d>, &RenderS::T_DrawSpriteData<0, 0, 0x2e>, &RenderS::T_DrawSpriteData<0, 0, 0x2f>, &RenderS::T_DrawSpriteData<0, 0, 0x30>, &RenderS::T_DrawSpriteData<0, 0, 0x31>, &RenderS::T_DrawSpriteData<0, 0, 0x32>, &RenderS::T_DrawSpriteData<0, 0, 0x33>, &RenderS::T_DrawSpriteData<0, 0, 0x34>, &RenderS::T_DrawSpriteData<0, 0, 0x35>, &RenderS::T_DrawSpriteData<0, 0, 0x36>, &RenderS::T_DrawSpriteData<0, 0, 0x37>, &RenderS::T_DrawSpriteData<0, 0, 0x38>, &RenderS::T_DrawSpriteData<0, 0, 0x39>, &RenderS::T_DrawSpriteData<0, 0, 0x3a>, &RenderS::T_DrawSpriteData<0, 0, 0x3b>, &RenderS::T_DrawSpriteData<0, 0, 0x3c>, &RenderS::T_DrawSpriteData<0, 0, 0x3d>, &RenderS::T_DrawSpriteData<0, 0, 0x3e>, &RenderS::T_DrawSpriteData<0, 0, 0x3f> },
+  { &RenderS::T_DrawSpriteData<0, 1, 0x00>, &RenderS::T_DrawSpriteData<0, 1, 0x01>, &RenderS::T_DrawSpriteData<0, 1, 0x02>, &RenderS::T_DrawSpriteData<0, 1, 0x03>, &RenderS::T_DrawSpriteData<0, 1, 0x04>, &RenderS::T_DrawSpriteData<0, 1, 0x05>, &RenderS::T_DrawSpriteData<0, 1, 0x06>, &RenderS::T_DrawSpriteData<0, 1, 0x07>, &RenderS::T_DrawSpriteData<0, 1, 0x08>, &RenderS::T_DrawSpriteData<0, 1, 0x09>, &RenderS::T_DrawSpriteData<0, 1, 0x0a>, &RenderS::T_DrawSpriteData<0, 1, 0x0b>, &RenderS::T_DrawSpriteData<0, 1, 0x0c>, &RenderS::T_DrawSpriteData<0, 1, 0x0d>, &RenderS::T_DrawSpriteData<0, 1, 0x0e>, &RenderS::T_DrawSpriteData<0, 1, 0x0f>, &RenderS::T_DrawSpriteData<0, 1, 0x10>, &RenderS::T_DrawSpriteData<0, 1, 0x11>, &RenderS::T_DrawSpriteData<0, 1, 0x12>, &RenderS::T_DrawSpriteData<0, 1, 0x13>, &RenderS::T_DrawSpriteData<0, 1, 0x14>, &RenderS::T_DrawSpriteData<0, 1, 0x15>, &RenderS::T_DrawSpriteData<0, 1, 0x16>, &RenderS::T_DrawSpriteData<0, 1, 0x17>, &RenderS::T_DrawSpriteData<0, 1, 0x18>, &RenderS::T_DrawSpriteData<0, 1, 0x19>, &RenderS::T_DrawSpriteData<0, 1, 0x1a>, &RenderS::T_DrawSpriteData<0, 1, 0x1b>, &RenderS::T_DrawSpriteData<0, 1, 0x1c>, &RenderS::T_DrawSpriteData<0, 1, 0x1d>, &RenderS::T_DrawSpriteData<0, 1, 0x1e>, &RenderS::T_DrawSpriteData<0, 1, 0x1f>, &RenderS::T_DrawSpriteData<0, 1, 0x20>, &RenderS::T_DrawSpriteData<0, 1, 0x21>, &RenderS::T_DrawSpriteData<0, 1, 0x22>, &RenderS::T_DrawSpriteData<0, 1, 0x23>, &RenderS::T_DrawSpriteData<0, 1, 0x24>, &RenderS::T_DrawSpriteData<0, 1, 0x25>, &RenderS::T_DrawSpriteData<0, 1, 0x26>, &RenderS::T_DrawSpriteData<0, 1, 0x27>, &RenderS::T_DrawSpriteData<0, 1, 0x28>, &RenderS::T_DrawSpriteData<0, 1, 0x29>, &RenderS::T_DrawSpriteData<0, 1, 0x2a>, &RenderS::T_DrawSpriteData<0, 1, 0x2b>, &RenderS::T_DrawSpriteData<0, 1, 0x2c>, &RenderS::T_DrawSpriteData<0, 1, 0x2d>, &RenderS::T_DrawSpriteData<0, 1, 0x2e>, &RenderS::T_DrawSpriteData<0, 1, 0x2f>, &RenderS::T_DrawSpriteData<0, 1, 0x30>, &RenderS::T_DrawSpriteData<0, 1, 0x31>, &RenderS::T_DrawSpriteData<0, 1, 0x32>, &RenderS::T_DrawSpriteData<0, 1, 0x33>, &RenderS::T_DrawSpriteData<0, 1, 0x34>, &RenderS::T_DrawSpriteData<0, 1, 0x35>, &RenderS::T_DrawSpriteData<0, 1, 0x36>, &RenderS::T_DrawSpriteData<0, 1, 0x37>, &RenderS::T_DrawSpriteData<0, 1, 0x38>, &RenderS::T_DrawSpriteData<0, 1, 0x39>, &RenderS::T_DrawSpriteData<0, 1, 0x3a>, &RenderS::T_DrawSpriteData<0, 1, 0x3b>, &RenderS::T_DrawSpriteData<0, 1, 0x3c>, &RenderS::T_DrawSpriteData<0, 1, 0x3d>, &RenderS::T_DrawSpriteData<0, 1, 0x3e>, &RenderS::T_DrawSpriteData<0, 1, 0x3f> },
  },
  {
-  { T_DrawSpriteData<1, 0, 0x00>, T_DrawSpriteData<1, 0, 0x01>, T_DrawSpriteData<1, 0, 0x02>, T_DrawSpriteData<1, 0, 0x03>, T_DrawSpriteData<1, 0, 0x04>, T_DrawSpriteData<1, 0, 0x05>, T_DrawSpriteData<1, 0, 0x06>, T_DrawSpriteData<1, 0, 0x07>, T_DrawSpriteData<1, 0, 0x08>, T_DrawSpriteData<1, 0, 0x09>, T_DrawSpriteData<1, 0, 0x0a>, T_DrawSpriteData<1, 0, 0x0b>, T_DrawSpriteData<1, 0, 0x0c>, T_DrawSpriteData<1, 0, 0x0d>, T_DrawSpriteData<1, 0, 0x0e>, T_DrawSpriteData<1, 0, 0x0f>, T_DrawSpriteData<1, 0, 0x10>, T_DrawSpriteData<1, 0, 0x11>, T_DrawSpriteData<1, 0, 0x12>, T_DrawSpriteData<1, 0, 0x13>, T_DrawSpriteData<1, 0, 0x14>, T_DrawSpriteData<1, 0, 0x15>, T_DrawSpriteData<1, 0, 0x16>, T_DrawSpriteData<1, 0, 0x17>, T_DrawSpriteData<1, 0, 0x18>, T_DrawSpriteData<1, 0, 0x19>, T_DrawSpriteData<1, 0, 0x1a>, T_DrawSpriteData<1, 0, 0x1b>, T_DrawSpriteData<1, 0, 0x1c>, T_DrawSpriteData<1, 0, 0x1d>, T_DrawSpriteData<1, 0, 0x1e>, T_DrawSpriteData<1, 0, 0x1f>, T_DrawSpriteData<1, 0, 0x20>, T_DrawSpriteData<1, 0, 0x21>, T_DrawSpriteData<1, 0, 0x22>, T_DrawSpriteData<1, 0, 0x23>, T_DrawSpriteData<1, 0, 0x24>, T_DrawSpriteData<1, 0, 0x25>, T_DrawSpriteData<1, 0, 0x26>, T_DrawSpriteData<1, 0, 0x27>, T_DrawSpriteData<1, 0, 0x28>, T_DrawSpriteData<1, 0, 0x29>, T_DrawSpriteData<1, 0, 0x2a>, T_DrawSpriteData<1, 0, 0x2b>, T_DrawSpriteData<1, 0, 0x2c>, T_DrawSpriteData<1, 0, 0x2d>, T_DrawSpriteData<1, 0, 0x2e>, T_DrawSpriteData<1, 0, 0x2f>, T_DrawSpriteData<1, 0, 0x30>, T_DrawSpriteData<1, 0, 0x31>, T_DrawSpriteData<1, 0, 0x32>, T_DrawSpriteData<1, 0, 0x33>, T_DrawSpriteData<1, 0, 0x34>, T_DrawSpriteData<1, 0, 0x35>, T_DrawSpriteData<1, 0, 0x36>, T_DrawSpriteData<1, 0, 0x37>, T_DrawSpriteData<1, 0, 0x38>, T_DrawSpriteData<1, 0, 0x39>, T_DrawSpriteData<1, 0, 0x3a>, T_DrawSpriteData<1, 0, 0x3b>, T_DrawSpriteData<1, 0, 0x3c>, T_DrawSpriteData<1, 0, 0x3d>, T_DrawSpriteData<1, 0, 0x3e>, T_DrawSpriteData<1, 0, 0x3f> },
-  { T_DrawSpriteData<1, 1, 0x00>, T_DrawSpriteData<1, 1, 0x01>, T_DrawSpriteData<1, 1, 0x02>, T_DrawSpriteData<1, 1, 0x03>, T_DrawSpriteData<1, 1, 0x04>, T_DrawSpriteData<1, 1, 0x05>, T_DrawSpriteData<1, 1, 0x06>, T_DrawSpriteData<1, 1, 0x07>, T_DrawSpriteData<1, 1, 0x08>, T_DrawSpriteData<1, 1, 0x09>, T_DrawSpriteData<1, 1, 0x0a>, T_DrawSpriteData<1, 1, 0x0b>, T_DrawSpriteData<1, 1, 0x0c>, T_DrawSpriteData<1, 1, 0x0d>, T_DrawSpriteData<1, 1, 0x0e>, T_DrawSpriteData<1, 1, 0x0f>, T_DrawSpriteData<1, 1, 0x10>, T_DrawSpriteData<1, 1, 0x11>, T_DrawSpriteData<1, 1, 0x12>, T_DrawSpriteData<1, 1, 0x13>, T_DrawSpriteData<1, 1, 0x14>, T_DrawSpriteData<1, 1, 0x15>, T_DrawSpriteData<1, 1, 0x16>, T_DrawSpriteData<1, 1, 0x17>, T_DrawSpriteData<1, 1, 0x18>, T_DrawSpriteData<1, 1, 0x19>, T_DrawSpriteData<1, 1, 0x1a>, T_DrawSpriteData<1, 1, 0x1b>, T_DrawSpriteData<1, 1, 0x1c>, T_DrawSpriteData<1, 1, 0x1d>, T_DrawSpriteData<1, 1, 0x1e>, T_DrawSpriteData<1, 1, 0x1f>, T_DrawSpriteData<1, 1, 0x20>, T_DrawSpriteData<1, 1, 0x21>, T_DrawSpriteData<1, 1, 0x22>, T_DrawSpriteData<1, 1, 0x23>, T_DrawSpriteData<1, 1, 0x24>, T_DrawSpriteData<1, 1, 0x25>, T_DrawSpriteData<1, 1, 0x26>, T_DrawSpriteData<1, 1, 0x27>, T_DrawSpriteData<1, 1, 0x28>, T_DrawSpriteData<1, 1, 0x29>, T_DrawSpriteData<1, 1, 0x2a>, T_DrawSpriteData<1, 1, 0x2b>, T_DrawSpriteData<1, 1, 0x2c>, T_DrawSpriteData<1, 1, 0x2d>, T_DrawSpriteData<1, 1, 0x2e>, T_DrawSpriteData<1, 1, 0x2f>, T_DrawSpriteData<1, 1, 0x30>, T_DrawSpriteData<1, 1, 0x31>, T_DrawSpriteData<1, 1, 0x32>, T_DrawSpriteData<1, 1, 0x33>, T_DrawSpriteData<1, 1, 0x34>, T_DrawSpriteData<1, 1, 0x35>, T_DrawSpriteData<1, 1, 0x36>, T_DrawSpriteData<1, 1, 0x37>, T_DrawSpriteData<1, 1, 0x38>, T_DrawSpriteData<1, 1, 0x39>, T_DrawSpriteData<1, 1, 0x3a>, T_DrawSpriteData<1, 1, 0x3b>, T_DrawSpriteData<1, 1, 0x3c>, T_DrawSpriteData<1, 1, 0x3d>, T_DrawSpriteData<1, 1, 0x3e>, T_DrawSpriteData<1, 1, 0x3f> },
+  { &RenderS::T_DrawSpriteData<1, 0, 0x00>, &RenderS::T_DrawSpriteData<1, 0, 0x01>, &RenderS::T_DrawSpriteData<1, 0, 0x02>, &RenderS::T_DrawSpriteData<1, 0, 0x03>, &RenderS::T_DrawSpriteData<1, 0, 0x04>, &RenderS::T_DrawSpriteData<1, 0, 0x05>, &RenderS::T_DrawSpriteData<1, 0, 0x06>, &RenderS::T_DrawSpriteData<1, 0, 0x07>, &RenderS::T_DrawSpriteData<1, 0, 0x08>, &RenderS::T_DrawSpriteData<1, 0, 0x09>, &RenderS::T_DrawSpriteData<1, 0, 0x0a>, &RenderS::T_DrawSpriteData<1, 0, 0x0b>, &RenderS::T_DrawSpriteData<1, 0, 0x0c>, &RenderS::T_DrawSpriteData<1, 0, 0x0d>, &RenderS::T_DrawSpriteData<1, 0, 0x0e>, &RenderS::T_DrawSpriteData<1, 0, 0x0f>, &RenderS::T_DrawSpriteData<1, 0, 0x10>, &RenderS::T_DrawSpriteData<1, 0, 0x11>, &RenderS::T_DrawSpriteData<1, 0, 0x12>, &RenderS::T_DrawSpriteData<1, 0, 0x13>, &RenderS::T_DrawSpriteData<1, 0, 0x14>, &RenderS::T_DrawSpriteData<1, 0, 0x15>, &RenderS::T_DrawSpriteData<1, 0, 0x16>, &RenderS::T_DrawSpriteData<1, 0, 0x17>, &RenderS::T_DrawSpriteData<1, 0, 0x18>, &RenderS::T_DrawSpriteData<1, 0, 0x19>, &RenderS::T_DrawSpriteData<1, 0, 0x1a>, &RenderS::T_DrawSpriteData<1, 0, 0x1b>, &RenderS::T_DrawSpriteData<1, 0, 0x1c>, &RenderS::T_DrawSpriteData<1, 0, 0x1d>, &RenderS::T_DrawSpriteData<1, 0, 0x1e>, &RenderS::T_DrawSpriteData<1, 0, 0x1f>, &RenderS::T_DrawSpriteData<1, 0, 0x20>, &RenderS::T_DrawSpriteData<1, 0, 0x21>, &RenderS::T_DrawSpriteData<1, 0, 0x22>, &RenderS::T_DrawSpriteData<1, 0, 0x23>, &RenderS::T_DrawSpriteData<1, 0, 0x24>, &RenderS::T_DrawSpriteData<1, 0, 0x25>, &RenderS::T_DrawSpriteData<1, 0, 0x26>, &RenderS::T_DrawSpriteData<1, 0, 0x27>, &RenderS::T_DrawSpriteData<1, 0, 0x28>, &RenderS::T_DrawSpriteData<1, 0, 0x29>, &RenderS::T_DrawSpriteData<1, 0, 0x2a>, &RenderS::T_DrawSpriteData<1, 0, 0x2b>, &RenderS::T_DrawSpriteData<1, 0, 0x2c>, &RenderS::T_DrawSpriteData<1, 0, 0x2d>, &RenderS::T_DrawSpriteData<1, 0, 0x2e>, &RenderS::T_DrawSpriteData<1, 0, 0x2f>, &RenderS::T_DrawSpriteData<1, 0, 0x30>, &RenderS::T_DrawSpriteData<1, 0, 0x31>, &RenderS::T_DrawSpriteData<1, 0, 0x32>, &RenderS::T_DrawSpriteData<1, 0, 0x33>, &RenderS::T_DrawSpriteData<1, 0, 0x34>, &RenderS::T_DrawSpriteData<1, 0, 0x35>, &RenderS::T_DrawSpriteData<1, 0, 0x36>, &RenderS::T_DrawSpriteData<1, 0, 0x37>, &RenderS::T_DrawSpriteData<1, 0, 0x38>, &RenderS::T_DrawSpriteData<1, 0, 0x39>, &RenderS::T_DrawSpriteData<1, 0, 0x3a>, &RenderS::T_DrawSpriteData<1, 0, 0x3b>, &RenderS::T_DrawSpriteData<1, 0, 0x3c>, &RenderS::T_DrawSpriteData<1, 0, 0x3d>, &RenderS::T_DrawSpriteData<1, 0, 0x3e>, &RenderS::T_DrawSpriteData<1, 0, 0x3f> },
+  { &RenderS::T_DrawSpriteData<1, 1, 0x00>, &RenderS::T_DrawSpriteData<1, 1, 0x01>, &RenderS::T_DrawSpriteData<1, 1, 0x02>, &RenderS::T_DrawSpriteData<1, 1, 0x03>, &RenderS::T_DrawSpriteData<1, 1, 0x04>, &RenderS::T_DrawSpriteData<1, 1, 0x05>, &RenderS::T_DrawSpriteData<1, 1, 0x06>, &RenderS::T_DrawSpriteData<1, 1, 0x07>, &RenderS::T_DrawSpriteData<1, 1, 0x08>, &RenderS::T_DrawSpriteData<1, 1, 0x09>, &RenderS::T_DrawSpriteData<1, 1, 0x0a>, &RenderS::T_DrawSpriteData<1, 1, 0x0b>, &RenderS::T_DrawSpriteData<1, 1, 0x0c>, &RenderS::T_DrawSpriteData<1, 1, 0x0d>, &RenderS::T_DrawSpriteData<1, 1, 0x0e>, &RenderS::T_DrawSpriteData<1, 1, 0x0f>, &RenderS::T_DrawSpriteData<1, 1, 0x10>, &RenderS::T_DrawSpriteData<1, 1, 0x11>, &RenderS::T_DrawSpriteData<1, 1, 0x12>, &RenderS::T_DrawSpriteData<1, 1, 0x13>, &RenderS::T_DrawSpriteData<1, 1, 0x14>, &RenderS::T_DrawSpriteData<1, 1, 0x15>, &RenderS::T_DrawSpriteData<1, 1, 0x16>, &RenderS::T_DrawSpriteData<1, 1, 0x17>, &RenderS::T_DrawSpriteData<1, 1, 0x18>, &RenderS::T_DrawSpriteData<1, 1, 0x19>, &RenderS::T_DrawSpriteData<1, 1, 0x1a>, &RenderS::T_DrawSpriteData<1, 1, 0x1b>, &RenderS::T_DrawSpriteData<1, 1, 0x1c>, &RenderS::T_DrawSpriteData<1, 1, 0x1d>, &RenderS::T_DrawSpriteData<1, 1, 0x1e>, &RenderS::T_DrawSpriteData<1, 1, 0x1f>, &RenderS::T_DrawSpriteData<1, 1, 0x20>, &RenderS::T_DrawSpriteData<1, 1, 0x21>, &RenderS::T_DrawSpriteData<1, 1, 0x22>, &RenderS::T_DrawSpriteData<1, 1, 0x23>, &RenderS::T_DrawSpriteData<1, 1, 0x24>, &RenderS::T_DrawSpriteData<1, 1, 0x25>, &RenderS::T_DrawSpriteData<1, 1, 0x26>, &RenderS::T_DrawSpriteData<1, 1, 0x27>, &RenderS::T_DrawSpriteData<1, 1, 0x28>, &RenderS::T_DrawSpriteData<1, 1, 0x29>, &RenderS::T_DrawSpriteData<1, 1, 0x2a>, &RenderS::T_DrawSpriteData<1, 1, 0x2b>, &RenderS::T_DrawSpriteData<1, 1, 0x2c>, &RenderS::T_DrawSpriteData<1, 1, 0x2d>, &RenderS::T_DrawSpriteData<1, 1, 0x2e>, &RenderS::T_DrawSpriteData<1, 1, 0x2f>, &RenderS::T_DrawSpriteData<1, 1, 0x30>, &RenderS::T_DrawSpriteData<1, 1, 0x31>, &RenderS::T_DrawSpriteData<1, 1, 0x32>, &RenderS::T_DrawSpriteData<1, 1, 0x33>, &RenderS::T_DrawSpriteData<1, 1, 0x34>, &RenderS::T_DrawSpriteData<1, 1, 0x35>, &RenderS::T_DrawSpriteData<1, 1, 0x36>, &RenderS::T_DrawSpriteData<1, 1, 0x37>, &RenderS::T_DrawSpriteData<1, 1, 0x38>, &RenderS::T_DrawSpriteData<1, 1, 0x39>, &RenderS::T_DrawSpriteData<1, 1, 0x3a>, &RenderS::T_DrawSpriteData<1, 1, 0x3b>, &RenderS::T_DrawSpriteData<1, 1, 0x3c>, &RenderS::T_DrawSpriteData<1, 1, 0x3d>, &RenderS::T_DrawSpriteData<1, 1, 0x3e>, &RenderS::T_DrawSpriteData<1, 1, 0x3f> },
  }
 };
 
@@ -2342,7 +2412,7 @@ enum
 };
 
 template<bool TA_rbg1en, unsigned TA_Special, bool TA_CCRTMD, bool TA_CCMD>
-static void T_MixIt(uint32* target, const unsigned vdp2_line, const unsigned w, const uint32 back_rgb24, const uint64* blursrc)
+void RenderS::T_MixIt(uint32* target, const unsigned vdp2_line, const unsigned w, const uint32 back_rgb24, const uint64* blursrc)
 {
  //printf("MixIt: %d, %d, %d, %d\n", TA_rbg1en, TA_Special, TA_CCRTMD, TA_CCMD);
  const uint32* lclut = &ColorCache[CurLCColor &~ 0x7F];
@@ -2562,13 +2632,13 @@ static void T_MixIt(uint32* target, const unsigned vdp2_line, const unsigned w,
 }
 
 //template<bool TA_rbg1en, unsigned TA_Special, bool TA_CCRTMD, bool TA_CCMD>
-static void (*MixIt[2][6][2][2])(uint32* target, const unsigned vdp2_line, const unsigned w, const uint32 back_rgb24, const uint64* blursrc) =
+static void (RenderS::*MixIt[2][6][2][2])(uint32* target, const unsigned vdp2_line, const unsigned w, const uint32 back_rgb24, const uint64* blursrc) =
 {
- {  {  { T_MixIt<0, 0, 0, 0>, T_MixIt<0, 0, 0, 1>,  },  { T_MixIt<0, 0, 1, 0>, T_MixIt<0, 0, 1, 1>,  },  },  {  { T_MixIt<0, 1, 0, 0>, T_MixIt<0, 1, 0, 1>,  },  { T_MixIt<0, 1, 1, 0>, T_MixIt<0, 1, 1, 1>,  },  },  {  { T_MixIt<0, 2, 0, 0>, T_MixIt<0, 2, 0, 1>,  },  { T_MixIt<0, 2, 1, 0>, T_MixIt<0, 2, 1, 1>,  },  },  {  { T_MixIt<0, 3, 0, 0>, T_MixIt<0, 3, 0, 1>,  },  { T_MixIt<0, 3, 1, 0>, T_MixIt<0, 3, 1, 1>,  },  },  {  { T_MixIt<0, 4, 0, 0>, T_MixIt<0, 4, 0, 1>,  },  { T_MixIt<0, 4, 1, 0>, T_MixIt<0, 4, 1, 1>,  },  },  {  { T_MixIt<0, 5, 0, 0>, T_MixIt<0, 5, 0, 1>,  },  { T_MixIt<0, 5, 1, 0>, T_MixIt<0, 5, 1, 1>,  },  },  },
- {  {  { T_MixIt<1, 0, 0, 0>, T_MixIt<1, 0, 0, 1>,  },  { T_MixIt<1, 0, 1, 0>, T_MixIt<1, 0, 1, 1>,  },  },  {  { T_MixIt<1, 1, 0, 0>, T_MixIt<1, 1, 0, 1>,  },  { T_MixIt<1, 1, 1, 0>, T_MixIt<1, 1, 1, 1>,  },  },  {  { T_MixIt<1, 2, 0, 0>, T_MixIt<1, 2, 0, 1>,  },  { T_MixIt<1, 2, 1, 0>, T_MixIt<1, 2, 1, 1>,  },  },  {  { T_MixIt<1, 3, 0, 0>, T_MixIt<1, 3, 0, 1>,  },  { T_MixIt<1, 3, 1, 0>, T_MixIt<1, 3, 1, 1>,  },  },  {  { T_MixIt<1, 4, 0, 0>, T_MixIt<1, 4, 0, 1>,  },  { T_MixIt<1, 4, 1, 0>, T_MixIt<1, 4, 1, 1>,  },  },  {  { T_MixIt<1, 5, 0, 0>, T_MixIt<1, 5, 0, 1>,  },  { T_MixIt<1, 5, 1, 0>, T_MixIt<1, 5, 1, 1>,  },  },  },
+ {  {  { &RenderS::T_MixIt<0, 0, 0, 0>, &RenderS::T_MixIt<0, 0, 0, 1>,  },  { &RenderS::T_MixIt<0, 0, 1, 0>, &RenderS::T_MixIt<0, 0, 1, 1>,  },  },  {  { &RenderS::T_MixIt<0, 1, 0, 0>, &RenderS::T_MixIt<0, 1, 0, 1>,  },  { &RenderS::T_MixIt<0, 1, 1, 0>, &RenderS::T_MixIt<0, 1, 1, 1>,  },  },  {  { &RenderS::T_MixIt<0, 2, 0, 0>, &RenderS::T_MixIt<0, 2, 0, 1>,  },  { &RenderS::T_MixIt<0, 2, 1, 0>, &RenderS::T_MixIt<0, 2, 1, 1>,  },  },  {  { &RenderS::T_MixIt<0, 3, 0, 0>, &RenderS::T_MixIt<0, 3, 0, 1>,  },  { &RenderS::T_MixIt<0, 3, 1, 0>, &RenderS::T_MixIt<0, 3, 1, 1>,  },  },  {  { &RenderS::T_MixIt<0, 4, 0, 0>, &RenderS::T_MixIt<0, 4, 0, 1>,  },  { &RenderS::T_MixIt<0, 4, 1, 0>, &RenderS::T_MixIt<0, 4, 1, 1>,  },  },  {  { &RenderS::T_MixIt<0, 5, 0, 0>, &RenderS::T_MixIt<0, 5, 0, 1>,  },  { &RenderS::T_MixIt<0, 5, 1, 0>, &RenderS::T_MixIt<0, 5, 1, 1>,  },  },  },
+ {  {  { &RenderS::T_MixIt<1, 0, 0, 0>, &RenderS::T_MixIt<1, 0, 0, 1>,  },  { &RenderS::T_MixIt<1, 0, 1, 0>, &RenderS::T_MixIt<1, 0, 1, 1>,  },  },  {  { &RenderS::T_MixIt<1, 1, 0, 0>, &RenderS::T_MixIt<1, 1, 0, 1>,  },  { &RenderS::T_MixIt<1, 1, 1, 0>, &RenderS::T_MixIt<1, 1, 1, 1>,  },  },  {  { &RenderS::T_MixIt<1, 2, 0, 0>, &RenderS::T_MixIt<1, 2, 0, 1>,  },  { &RenderS::T_MixIt<1, 2, 1, 0>, &RenderS::T_MixIt<1, 2, 1, 1>,  },  },  {  { &RenderS::T_MixIt<1, 3, 0, 0>, &RenderS::T_MixIt<1, 3, 0, 1>,  },  { &RenderS::T_MixIt<1, 3, 1, 0>, &RenderS::T_MixIt<1, 3, 1, 1>,  },  },  {  { &RenderS::T_MixIt<1, 4, 0, 0>, &RenderS::T_MixIt<1, 4, 0, 1>,  },  { &RenderS::T_MixIt<1, 4, 1, 0>, &RenderS::T_MixIt<1, 4, 1, 1>,  },  },  {  { &RenderS::T_MixIt<1, 5, 0, 0>, &RenderS::T_MixIt<1, 5, 0, 1>,  },  { &RenderS::T_MixIt<1, 5, 1, 0>, &RenderS::T_MixIt<1, 5, 1, 1>,  },  },  },
 };
 
-static int32 ApplyHBlend(uint32* const target, int32 w)
+int32 RenderS::ApplyHBlend(uint32* const target, int32 w)
 {
  #define BHALF(m, n) ((((uint64)(m) + (n)) - (((m) ^ (n)) & 0x01010101)) >> 1)
 
@@ -2646,32 +2716,12 @@ static void ReorderRGB(uint32* target, const unsigned w, const unsigned Rshift,
  }
 }
 
-static NO_INLINE void DrawLine(const uint16 out_line, const uint16 vdp2_line, const bool field)
+//
+// Advances the state carried over from line to line, up to the point where the line is drawn; EndLine() does the rest.
+//
+NO_INLINE void RegStateS::BeginLine(const uint16* VRAM, const uint16 vdp2_line, const bool field)
 {
- uint32* target;
- const int32 tvdw = ((!CorrectAspect || Clock28M) ? 352 : 330) << ((HRes & 0x2) >> 1);
- const unsigned rbg_w = ((HRes & 0x1) ? 352 : 320);
  const unsigned w = ((HRes & 0x1) ? 352 : 320) << ((HRes & 0x2) >> 1);
- const int32 tvxo = std::max<int32>(0, (int32)(tvdw - w) >> 1);
- uint32 back_rgb24;
- uint32 border_ncf;
-
- target = espec->surface->pixels + out_line * espec->surface->pitchinpix;
- espec->LineWidths[out_line] = tvdw;
-
- if(!ShowHOverscan)
- {
-  const int32 ntdw = tvdw * 1024 / 1056;
-  const int32 tadj = std::max<int32>(0, espec->DisplayRect.x - ((tvdw - ntdw) >> 1));
-
-  //if(out_line == 100)
-  // printf("tvdw=%d, ntdw=%d, tadj=%d --- tvdw+tadj=%d\n", tvdw, ntdw, tadj, tvdw + tadj);
-
-  assert((tvdw + tadj) <= 704);
-
-  target += tadj;
-  espec->LineWidths[out_line] = ntdw;
- }
 
  //
  // FIXME: Timing
@@ -2723,138 +2773,217 @@ static NO_INLINE void DrawLine(const uint16 out_line, const uint16 vdp2_line, co
    CurLCTabAddr += 1 << (InterlaceMode == IM_DOUBLE);
  }
 
- back_rgb24 = rgb15_to_rgb24(CurBackColor);
+ if(vdp2_line == 0xFFFF)
+  return;
 
- if(BorderMode)
-  border_ncf = espec->surface->MakeColor((uint8)(back_rgb24 >> 0), (uint8)(back_rgb24 >> 8), (uint8)(back_rgb24 >> 16));
- else
-  border_ncf = espec->surface->MakeColor(0, 0, 0);
+ //
+ // Line scroll
+ //
+ const unsigned ls_comp_line = vdp2_line << (InterlaceMode == IM_DOUBLE);
 
- if(vdp2_line == 0xFFFF)
- {
-  for(int32 i = 0; i < tvdw; i++)
-   target[i] = border_ncf;
- }
- else
+ for(unsigned n = 0; n < 2; n++)
  {
-  //
-  // Line scroll
-  //
-  const unsigned ls_comp_line = vdp2_line << (InterlaceMode == IM_DOUBLE);
+  const uint8 sc = (SCRCTL >> (n << 3));
+  const uint8 lss = ((sc >> 4) & 0x3);
 
-  for(unsigned n = 0; n < 2; n++)
+  if((ls_comp_line & ((1 << lss) - 1)) == 0)
   {
-   const uint8 sc = (SCRCTL >> (n << 3));
-   const uint8 lss = ((sc >> 4) & 0x3);
-
-   if((ls_comp_line & ((1 << lss) - 1)) == 0)
+   if(sc & 0x2)	// X
    {
-    if(sc & 0x2)	// X
-    {
-     CurXScrollIF[n] = (VRAM[CurLSA[n] & 0x3FFFF] & 0x7FF) << 8;
-     CurLSA[n]++;
-     CurXScrollIF[n] |= VRAM[CurLSA[n] & 0x3FFFF] >> 8;
-     CurLSA[n]++;
+    CurXScrollIF[n] = (VRAM[CurLSA[n] & 0x3FFFF] & 0x7FF) << 8;
+    CurLSA[n]++;
+    CurXScrollIF[n] |= VRAM[CurLSA[n] & 0x3FFFF] >> 8;
+    CurLSA[n]++;
 
-     CurXScrollIF[n] += (XScrollI[n] << 8) + XScrollF[n];
-    }
+    CurXScrollIF[n] += (XScrollI[n] << 8) + XScrollF[n];
+   }
 
-    if(sc & 0x4) // Y
-    {
-     YCoordAccum[n] = 0;	// Don't (InterlaceMode == IM_DOUBLE && field)
-     //
-     CurYScrollIF[n] = (VRAM[CurLSA[n] & 0x3FFFF] & 0x7FF) << 8;
-     CurLSA[n]++;
-     CurYScrollIF[n] |= VRAM[CurLSA[n] & 0x3FFFF] >> 8;
-     CurLSA[n]++;
+   if(sc & 0x4) // Y
+   {
+    YCoordAccum[n] = 0;	// Don't (InterlaceMode == IM_DOUBLE && field)
+    //
+    CurYScrollIF[n] = (VRAM[CurLSA[n] & 0x3FFFF] & 0x7FF) << 8;
+    CurLSA[n]++;
+    CurYScrollIF[n] |= VRAM[CurLSA[n] & 0x3FFFF] >> 8;
+    CurLSA[n]++;
 
-     CurYScrollIF[n] += (YScrollI[n] << 8) + YScrollF[n];
-     //printf("%d %d %08x: %08x \n", vdp2_line, n, CurLSA[n], CurYScrollIF[n]);
-    }
+    CurYScrollIF[n] += (YScrollI[n] << 8) + YScrollF[n];
+    //printf("%d %d %08x: %08x \n", vdp2_line, n, CurLSA[n], CurYScrollIF[n]);
+   }
  
-    if(sc & 0x8) // X zoom
-    {
-     CurXCoordInc[n] = (VRAM[CurLSA[n] & 0x3FFFF] & 0x7) << 8;
-     CurLSA[n]++;
-     CurXCoordInc[n] |= VRAM[CurLSA[n] & 0x3FFFF] >> 8;
-     CurLSA[n]++;
-    }
+   if(sc & 0x8) // X zoom
+   {
+    CurXCoordInc[n] = (VRAM[CurLSA[n] & 0x3FFFF] & 0x7) << 8;
+    CurLSA[n]++;
+    CurXCoordInc[n] |= VRAM[CurLSA[n] & 0x3FFFF] >> 8;
+    CurLSA[n]++;
+   }
 
-    if(InterlaceMode == IM_DOUBLE && !lss)
-     CurLSA[n] += ((bool)(sc & 0x2) + (bool)(sc & 0x4) + (bool)(sc & 0x8)) << 1;
+   if(InterlaceMode == IM_DOUBLE && !lss)
+    CurLSA[n] += ((bool)(sc & 0x2) + (bool)(sc & 0x4) + (bool)(sc & 0x8)) << 1;
+  }
+
+  if(!(sc & 0x2))
+   CurXScrollIF[n] = (XScrollI[n] << 8) + XScrollF[n];
+
+  if(!(sc & 0x4))
+   CurYScrollIF[n] = (YScrollI[n] << 8) + YScrollF[n];
+
+  if(!(sc & 0x8))
+   CurXCoordInc[n] = XCoordInc[n];
+ }
+
+ //
+ // Line Window
+ //
+ {
+  for(unsigned d = 0; d < 2; d++)
+  {
+   if(Window[d].LineWinEn)
+   {
+    const uint16* vrt = &VRAM[Window[d].CurLineWinAddr & 0x3FFFE];
+
+    Window[d].XStart = vrt[0] & 0x3FF;
+    Window[d].XEnd = vrt[1] & 0x3FF;
+
+    //printf("LWin %d, %d(%08x): %04x %04x\n", vdp2_line, d, Window[d].CurLineWinAddr & 0x3FFFE, vrt[0], vrt[1]);
+   }
+   //
+   //
+   //
+   int32 xs = Window[d].XStart, xe = Window[d].XEnd;
+
+   // FIXME: Kludge, until we can figure out what's going on.
+   if(xs >= 0x380)
+    xs = 0;
+
+   // FIXME: Kludge, until we can figure out what's going on.
+   if(xe >= 0x380)
+   {
+    xs = 2;
+    xe = 0;
    }
 
-   if(!(sc & 0x2))
-    CurXScrollIF[n] = (XScrollI[n] << 8) + XScrollF[n];
+   if(!(HRes & 0x2))
+   {
+    xs >>= 1;
+    xe >>= 1;
+   }
+   Window[d].CurXStart = xs;
+   Window[d].CurXEnd = xe;
 
-   if(!(sc & 0x4))
-    CurYScrollIF[n] = (YScrollI[n] << 8) + YScrollF[n];
+   Window[d].CurLineWinAddr += 2 << (InterlaceMode == IM_DOUBLE);
 
-   if(!(sc & 0x8))
-    CurXCoordInc[n] = XCoordInc[n];
+   //
+   //
+   //
   }
 
   //
-  // Line Window
   //
+  //
+  WinPieces[0] = Window[0].CurXStart;
+  WinPieces[1] = Window[0].CurXEnd + 1;
+  WinPieces[2] = Window[1].CurXStart;
+  WinPieces[3] = Window[1].CurXEnd + 1;
+  WinPieces[4] = w;
+
+  for(unsigned piece = 0; piece < WinPieces.size(); piece++)
+   WinPieces[piece] = std::min<unsigned>(w, WinPieces[piece]);	// Almost forgot to do this...
+
+  std::sort(WinPieces.begin(), WinPieces.end());
+ }
+
+ //
+ //
+ //
+ for(unsigned n = 0; n < 4; n++)
+ {
+  if(!MosaicVCount || !(MZCTL & (1U << n)))
   {
-   for(unsigned d = 0; d < 2; d++)
+   if(n < 2)
    {
-    if(Window[d].LineWinEn)
-    {
-     const uint16* vrt = &VRAM[Window[d].CurLineWinAddr & 0x3FFFE];
+    MosEff_YCoordAccum[n] = YCoordAccum[n];	// Don't + (InterlaceMode == IM_DOUBLE && field)
+   }
+   else
+   {
+    MosEff_NBG23_YCounter[n & 1] = NBG23_YCounter[n & 1] + (InterlaceMode == IM_DOUBLE && field);
+   }
+  }
+ }
 
-     Window[d].XStart = vrt[0] & 0x3FF;
-     Window[d].XEnd = vrt[1] & 0x3FF;
+ if(SCRCTL & 0x0101)
+  FetchVCScroll(VRAM, w);	// Call after handling line scroll, and before DrawNBG() stuff
+}
 
-     //printf("LWin %d, %d(%08x): %04x %04x\n", vdp2_line, d, Window[d].CurLineWinAddr & 0x3FFFE, vrt[0], vrt[1]);
-    }
-    //
-    //
-    //
-    int32 xs = Window[d].XStart, xe = Window[d].XEnd;
+INLINE void RegStateS::EndLine(const uint16 vdp2_line)
+{
+ if(vdp2_line == 0xFFFF)
+  return;
 
-    // FIXME: Kludge, until we can figure out what's going on.
-    if(xs >= 0x380)
-     xs = 0;
+ //
+ //
+ //
+ // FIXME: Timing
+ //
+ for(unsigned n = 0; n < 2; n++)
+ {
+  YCoordAccum[n] += YCoordInc[n] << (InterlaceMode == IM_DOUBLE);
+  NBG23_YCounter[n & 1] += 1 << (InterlaceMode == IM_DOUBLE);
+ }
 
-    // FIXME: Kludge, until we can figure out what's going on.
-    if(xe >= 0x380)
-    {
-     xs = 2;
-     xe = 0;
-    }
+ if(MosaicVCount >= ((MZCTL >> 12) & 0xF))
+  MosaicVCount = 0;
+ else
+  MosaicVCount++;
+}
 
-    if(!(HRes & 0x2))
-    {
-     xs >>= 1;
-     xe >>= 1;
-    }
-    Window[d].CurXStart = xs;
-    Window[d].CurXEnd = xe;
+//
+// Call between BeginLine() and EndLine().  "line_target" and "line_width" point to the output line's pixels and entry in LineWidths.
+//
+NO_INLINE void RenderS::DrawLine(uint32* const line_target, int32* const line_width, const uint16 vdp2_line)
+{
+ uint32* target;
+ const int32 tvdw = ((!CorrectAspect || Clock28M) ? 352 : 330) << ((HRes & 0x2) >> 1);
+ const unsigned rbg_w = ((HRes & 0x1) ? 352 : 320);
+ const unsigned w = ((HRes & 0x1) ? 352 : 320) << ((HRes & 0x2) >> 1);
+ const int32 tvxo = std::max<int32>(0, (int32)(tvdw - w) >> 1);
+ uint32 back_rgb24;
+ uint32 border_ncf;
 
-    Window[d].CurLineWinAddr += 2 << (InterlaceMode == IM_DOUBLE);
+ target = line_target;
+ *line_width = tvdw;
 
-    Window[d].YMet = LIB[vdp2_line].win_ymet[d];
-    //
-    //
-    //
-   }
+ if(!ShowHOverscan)
+ {
+  const int32 ntdw = tvdw * 1024 / 1056;
+  const int32 tadj = std::max<int32>(0, espec->DisplayRect.x - ((tvdw - ntdw) >> 1));
 
-   //
-   //
-   //
-   WinPieces[0] = Window[0].CurXStart;
-   WinPieces[1] = Window[0].CurXEnd + 1;
-   WinPieces[2] = Window[1].CurXStart;
-   WinPieces[3] = Window[1].CurXEnd + 1;
-   WinPieces[4] = w;
+  //if(out_line == 100)
+  // printf("tvdw=%d, ntdw=%d, tadj=%d --- tvdw+tadj=%d\n", tvdw, ntdw, tadj, tvdw + tadj);
 
-   for(unsigned piece = 0; piece < WinPieces.size(); piece++)
-    WinPieces[piece] = std::min<unsigned>(w, WinPieces[piece]);	// Almost forgot to do this...
+  assert((tvdw + tadj) <= 704);
 
-   std::sort(WinPieces.begin(), WinPieces.end());
-  }
+  target += tadj;
+  *line_width = ntdw;
+ }
+
+ back_rgb24 = rgb15_to_rgb24(CurBackColor);
+
+ if(BorderMode)
+  border_ncf = espec->surface->MakeColor((uint8)(back_rgb24 >> 0), (uint8)(back_rgb24 >> 8), (uint8)(back_rgb24 >> 16));
+ else
+  border_ncf = espec->surface->MakeColor(0, 0, 0);
+
+ if(vdp2_line == 0xFFFF)
+ {
+  for(int32 i = 0; i < tvdw; i++)
+   target[i] = border_ncf;
+ }
+ else
+ {
+  for(unsigned d = 0; d < 2; d++)
+   Window[d].YMet = LIB[vdp2_line].win_ymet[d];
 
   //
   //
@@ -2873,7 +3002,7 @@ static NO_INLINE void DrawLine(const uint16 out_line, const uint16 vdp2_line, co
   if(MDFN_LIKELY(UserLayerEnableMask & (1U << 6)))
   {
    MakeSpriteCCLUT();
-   DrawSpriteData[(HRes & 0x2) >> 0x1][(SDCTL >> 8) & 0x1][SPCTL_Low](LIB[vdp2_line].vdp1_line, LIB[vdp2_line].vdp1_hires8, w);
+   (this->*DrawSpriteData[(HRes & 0x2) >> 0x1][(SDCTL >> 8) & 0x1][SPCTL_Low])(LIB[vdp2_line].vdp1_line, LIB[vdp2_line].vdp1_hires8, w);
   }
   else
    MDFN_FastArraySet(LB.spr, 0, w);
@@ -2919,7 +3048,7 @@ static NO_INLINE void DrawLine(const uint16 out_line, const uint16 vdp2_line, co
     else
      pix_base_or |= (prio << PIX_PRIO_SHIFT);
 
-    DrawRBG[bmen][colornum][igntp][priomode % 3][ccmode](0, LB.rbg0, rbg_w, pix_base_or);
+    (this->*DrawRBG[bmen][colornum][igntp][priomode % 3][ccmode])(0, LB.rbg0, rbg_w, pix_base_or);
     RBGPP(4, LB.rbg0, rbg_w);
    }
    else
@@ -2953,7 +3082,7 @@ static NO_INLINE void DrawLine(const uint16 out_line, const uint16 vdp2_line, co
      pix_base_or |= (prio << PIX_PRIO_SHIFT);
 
     MDFN_FastArraySet(LB.rotabsel, 1, rbg_w);
-    DrawRBG[false][colornum][igntp][priomode % 3][ccmode](1, LB.nbg[0] + 8, rbg_w, pix_base_or);
+    (this->*DrawRBG[false][colornum][igntp][priomode % 3][ccmode])(1, LB.nbg[0] + 8, rbg_w, pix_base_or);
     RBGPP(0, LB.nbg[0] + 8, rbg_w);
    }
    else if(BGON & 0x20)
@@ -2964,26 +3093,6 @@ static NO_INLINE void DrawLine(const uint16 out_line, const uint16 vdp2_line, co
    MDFN_FastArraySet(LB.lc, CurLCColor & 0x7F, w);
    MDFN_FastArraySet(LB.rbg0, 0, w);
   }
-  //
-  //
-  //
-  for(unsigned n = 0; n < 4; n++)
-  {
-   if(!MosaicVCount || !(MZCTL & (1U << n)))
-   {
-    if(n < 2)
-    {
-     MosEff_YCoordAccum[n] = YCoordAccum[n];	// Don't + (InterlaceMode == IM_DOUBLE && field)
-    }
-    else
-    {
-     MosEff_NBG23_YCounter[n & 1] = NBG23_YCounter[n & 1] + (InterlaceMode == IM_DOUBLE && field);
-    }
-   }
-  }
-
-  if(SCRCTL & 0x0101)
-   FetchVCScroll(w);	// Call after handling line scroll, and before DrawNBG() stuff
 
   if(!(BGON & 0x20))
   {
@@ -3041,9 +3150,9 @@ static NO_INLINE void DrawLine(const uint16 out_line, const uint16 vdp2_line, co
       pix_base_or |= (prio << PIX_PRIO_SHIFT);
 
      if(n < 2)
-      DrawNBG[bmen][colornum][igntp][priomode % 3][ccmode](n, LB.nbg[n] + 8, w, pix_base_or);
+      (this->*DrawNBG[bmen][colornum][igntp][priomode % 3][ccmode])(n, LB.nbg[n] + 8, w, pix_base_or);
      else
-      DrawNBG23[colornum][igntp][priomode % 3][ccmode](n, LB.nbg[n] + 8, w, pix_base_or);
+      (this->*DrawNBG23[colornum][igntp][priomode % 3][ccmode])(n, LB.nbg[n] + 8, w, pix_base_or);
 
      ApplyHMosaic(n, LB.nbg[n] + 8, w);
      ApplyWin(n, LB.nbg[n] + 8);
@@ -3073,10 +3182,16 @@ static NO_INLINE void DrawLine(const uint16 out_line, const uint16 vdp2_line, co
    unsigned special = MIXIT_SPECIAL_NONE;
    const bool CCRTMD = (bool)(CCCTL & 0x0200);
    const bool CCMD = (bool)(CCCTL & 0x0100);
-   static const uint64* blurremap[8] = { LB.spr, LB.rbg0, LB.nbg[0] + 8, /*Dummy:*/LB.spr,
+   const uint64* const blurremap[8] = { LB.spr, LB.rbg0, LB.nbg[0] + 8, /*Dummy:*/LB.spr,
 					 LB.nbg[1] + 8, LB.nbg[2] + 8, LB.nbg[3] + 8, /*Dummy:*/LB.spr
 				       };
-   const uint64* blursrc = blurremap[(CCCTL >> 12) & 0x7];
+   const unsigned blursel = (CCCTL >> 12) & 0x7;
+   const uint64* blursrc = blurremap[blursel];
+
+   // NBG1-3 aren't drawn when RBG1 is enabled, so their line buffers hold whatever an earlier line(or RBG0) left there; the mixer
+   // treats them as transparent then, so make the gradation source agree, rather than depend on previously-drawn lines.
+   if(rbg1en && blursel >= 4 && blursel <= 6)
+    MDFN_FastArraySet(LB.nbg[blursel - 3] + 8, 0, w);
 
    if(!(HRes & 0x6))
    {
@@ -3092,25 +3207,9 @@ static NO_INLINE void DrawLine(const uint16 out_line, const uint16 vdp2_line, co
      special += (CCCTL >> 4) & 0x2;
     }
    }
-   MixIt[rbg1en][special][CCRTMD][CCMD](target + tvxo, vdp2_line, w, back_rgb24, blursrc);
+   (this->*MixIt[rbg1en][special][CCRTMD][CCMD])(target + tvxo, vdp2_line, w, back_rgb24, blursrc);
    ReorderRGB(target + tvxo, w, espec->surface->format.Rshift, espec->surface->format.Gshift, espec->surface->format.Bshift);
   }
-
-  //
-  //
-  //
-  // FIXME: Timing
-  //
-  for(unsigned n = 0; n < 2; n++)
-  {
-   YCoordAccum[n] += YCoordInc[n] << (InterlaceMode == IM_DOUBLE);
-   NBG23_YCounter[n & 1] += 1 << (InterlaceMode == IM_DOUBLE);
-  }
-
-  if(MosaicVCount >= ((MZCTL >> 12) & 0xF))
-   MosaicVCount = 0;
-  else
-   MosaicVCount++;
  }
 
  //
@@ -3118,17 +3217,45 @@ static NO_INLINE void DrawLine(const uint16 out_line, const uint16 vdp2_line, co
  //
  if(DoHBlend)
  {
-  espec->LineWidths[out_line] = ApplyHBlend(espec->surface->pixels + out_line * espec->surface->pitchinpix + espec->DisplayRect.x, espec->LineWidths[out_line]);
+  *line_width = ApplyHBlend(line_target + espec->DisplayRect.x, *line_width);
 
   // Kind of late, but meh. ;p
-  assert((espec->DisplayRect.x + espec->LineWidths[out_line]) <= 704);
+  assert((espec->DisplayRect.x + *line_width) <= 704);
  }
 }
 
 //
 //
 //
-static MThreading::Thread* RThread = NULL;
+//
+// Lines are drawn by NumRThreads render threads, each with its own RenderS.  Every render thread consumes the whole command stream and applies
+// every write to its own copy of the VDP2 state, but only draws the lines in its own bands of BandLines lines(assigned round-robin).
+//
+// With more than one render thread, the state carried over from line to line is advanced just once per line, on the emulation thread, in
+// EmuLineState; register writes are applied to it as they're queued, and VRAM is read from the VDP2 module's copy(EmuVRAM).  The carried
+// state as of each line is handed to the owning render thread through LineCarry[]; the other render threads skip the line entirely.
+//
+// With ss.dbg_vdp2_verify, one more render thread draws every line the single-threaded way into VerifyPixels, which VDP2REND_EndFrame()
+// then compares against the output.
+//
+enum : unsigned { MaxRThreads = 8 };
+enum : unsigned { BandLines = 8 };
+
+struct RThreadS
+{
+ alignas(64) std::atomic_uint_least32_t ReadCount;
+ MThreading::Thread* Thread;
+ MThreading::Sem* WakeupSem;
+ unsigned Index;
+ RenderS* RS;
+};
+
+static RThreadS RThreads[MaxRThreads + 1];	// + 1 for the verification thread.
+static unsigned NumRThreads = 0;
+static unsigned NumWQReaders = 0;	// NumRThreads, + 1 with verification.
+
+static RegStateS EmuLineState;
+static const uint16* EmuVRAM;
 
 enum
 {
@@ -3141,6 +3268,9 @@ enum
 
  COMMAND_SET_BUSYWAIT,
 
+ COMMAND_STATE_SAVE,
+ COMMAND_STATE_LOAD,
+
  COMMAND_RESET,
  COMMAND_EXIT
 };
@@ -3153,38 +3283,217 @@ struct WQ_Entry
 };
 
 static std::array<WQ_Entry, 0x80000> WQ;
-static size_t WQ_ReadPos, WQ_WritePos;
-static std::atomic_int_least32_t WQ_InCount;
+static uint32 WQ_WriteCount;	// Modulo WQ.size() for the write position.
+static uint32 WQ_FreeCount;	// Lower bound, updated by WQ_WaitFree().
+static std::atomic_uint_least32_t WQ_PubWriteCount;
 static std::atomic_int_least32_t DrawCounter;
-static bool DoBusyWait;
-static MThreading::Sem* WakeupSem;
 static bool DoWakeupIfNecessary;
 
-static INLINE void WWQ(uint16 command, uint32 arg32 = 0, uint16 arg16 = 0)
+static bool DoBench;
+static uint64 BenchFrames;
+static uint64 BenchWaitTime;
+
+static bool DoVerify;
+static std::unique_ptr<uint32[]> VerifyPixels;	// 576 lines of 704 pixels.
+static int32 VerifyLineWidths[576];
+static bool VerifyLineDrawn[288];
+static uint64 VerifyFrames;
+static uint64 VerifyBadLines;
+
+static_assert(!(WQ.size() & (WQ.size() - 1)), "WQ size must be a power of 2.");
+
+static void WakeRThreads(void)
+{
+ for(unsigned i = 0; i < NumWQReaders; i++)
+  MThreading::Sem_Post(RThreads[i].WakeupSem);
+}
+
+static INLINE uint32 WQ_MaxInCount(void)
+{
+ uint32 ret = 0;
+
+ for(unsigned i = 0; i < NumWQReaders; i++)
+  ret = std::max<uint32>(ret, WQ_WriteCount - RThreads[i].ReadCount.load(std::memory_order_acquire));
+
+ return ret;
+}
+
+static NO_INLINE void WQ_WaitFree(void)
+{
+ uint32 ic;
+
+ while(MDFN_UNLIKELY((ic = WQ_MaxInCount()) == WQ.size()))
+  Time::SleepMS(1);
+
+ WQ_FreeCount = WQ.size() - ic;
+}
+
+// Waits until every render thread has processed everything queued so far.
+static void WQ_Sync(void)
 {
- while(MDFN_UNLIKELY(WQ_InCount.load(std::memory_order_acquire) == WQ.size()))
+ while(MDFN_UNLIKELY(WQ_MaxInCount() != 0))
   Time::SleepMS(1);
+}
+
+static INLINE void WWQ(uint16 command, uint32 arg32 = 0, uint16 arg16 = 0)
+{
+ if(MDFN_UNLIKELY(!WQ_FreeCount))
+  WQ_WaitFree();
 
- WQ_Entry* wqe = &WQ[WQ_WritePos];
+ WQ_Entry* wqe = &WQ[WQ_WriteCount & (WQ.size() - 1)];
 
  wqe->Command = command;
  wqe->Arg16 = arg16;
  wqe->Arg32 = arg32;
 
- WQ_WritePos = (WQ_WritePos + 1) % WQ.size();
- WQ_InCount.fetch_add(1, std::memory_order_release);
+ WQ_WriteCount++;
+ WQ_FreeCount--;
+ WQ_PubWriteCount.store(WQ_WriteCount, std::memory_order_release);
+}
+
+//
+// Save state staging area; see VDP2REND_StateAction().
+//
+#define VDP2REND_CARRIED_STATE_LIST	\
+	CSX(MosaicVCount)		\
+	CSX(VCLast)			\
+	CSX(YCoordAccum)		\
+	CSX(MosEff_YCoordAccum)		\
+	CSX(CurXScrollIF)		\
+	CSX(CurYScrollIF)		\
+	CSX(CurXCoordInc)		\
+	CSX(CurLSA)			\
+	CSX(NBG23_YCounter)		\
+	CSX(MosEff_NBG23_YCounter)	\
+	CSX(CurBackTabAddr)		\
+	CSX(CurBackColor)		\
+	CSX(CurLCTabAddr)		\
+	CSX(CurLCColor)
+
+struct CarriedStateS
+{
+ uint8 MosaicVCount;
+ uint32 VCLast[2];
+ uint32 YCoordAccum[2];
+ uint32 MosEff_YCoordAccum[2];
+ uint32 CurXScrollIF[2];
+ uint32 CurYScrollIF[2];
+ uint16 CurXCoordInc[2];
+ uint32 CurLSA[2];
+ uint16 NBG23_YCounter[2];
+ uint16 MosEff_NBG23_YCounter[2];
+ uint32 CurBackTabAddr;
+ uint16 CurBackColor;
+ uint32 CurLCTabAddr;
+ uint16 CurLCColor;
+
+ struct
+ {
+  uint16 XStart, XEnd;
+  uint16 CurXStart, CurXEnd;
+  uint32 CurLineWinAddr;
+ } Window[2];
+};
+
+static struct : CarriedStateS
+{
+ const uint16* rr;
+ const uint16* cr;
+ const uint16* vr;
+} StateStaging;
+
+static void SaveCarriedState(const RegStateS* rs, CarriedStateS* cs)
+{
+ #define CSX(x) static_assert(sizeof(cs->x) == sizeof(rs->x), "Mismatch"); memcpy(&cs->x, &rs->x, sizeof(rs->x));
+ VDP2REND_CARRIED_STATE_LIST
+ #undef CSX
+
+ for(unsigned d = 0; d < 2; d++)
+ {
+  cs->Window[d].XStart = rs->Window[d].XStart;
+  cs->Window[d].XEnd = rs->Window[d].XEnd;
+  cs->Window[d].CurXStart = rs->Window[d].CurXStart;
+  cs->Window[d].CurXEnd = rs->Window[d].CurXEnd;
+  cs->Window[d].CurLineWinAddr = rs->Window[d].CurLineWinAddr;
+ }
+}
+
+static void LoadCarriedState(RegStateS* rs, const CarriedStateS* cs)
+{
+ #define CSX(x) memcpy(&rs->x, &cs->x, sizeof(rs->x));
+ VDP2REND_CARRIED_STATE_LIST
+ #undef CSX
+
+ for(unsigned d = 0; d < 2; d++)
+ {
+  rs->Window[d].XStart = cs->Window[d].XStart;
+  rs->Window[d].XEnd = cs->Window[d].XEnd;
+  rs->Window[d].CurXStart = cs->Window[d].CurXStart;
+  rs->Window[d].CurXEnd = cs->Window[d].CurXEnd;
+  rs->Window[d].CurLineWinAddr = cs->Window[d].CurLineWinAddr;
+ }
+}
+
+static void LoadState(RenderS* rs)
+{
+ // Calls to RegsWrite() should go before loading the carried state, and before memcpy() to VRAM and CRAM.
+ for(unsigned i = 0; i < 0x100; i++)
+  rs->RegsWrite(i << 1, StateStaging.rr[i]);
+
+ LoadCarriedState(rs, &StateStaging);
+
+ memcpy(rs->VRAM, StateStaging.vr, sizeof(rs->VRAM));
+ memcpy(rs->CRAM, StateStaging.cr, sizeof(rs->CRAM));
+
+ rs->RecalcColorCache();
+}
+
+//
+// Carried state of each line, as of BeginLine(); written by the emulation thread in VDP2REND_DrawLine(), and read by the render thread
+// that owns the line.  An entry isn't reused until VDP2REND_EndFrame() has waited for the frame's lines to be drawn.
+//
+static struct
+{
+ CarriedStateS CS;
+ std::array<unsigned, 5> WinPieces;
+ uint16 vcscr[2][88 + 1 + 1];
+} LineCarry[288];
+
+static void SaveLineCarry(const unsigned crt_line)
+{
+ auto* lc = &LineCarry[crt_line];
+
+ static_assert(sizeof(lc->vcscr) == sizeof(EmuLineState.vcscr), "Mismatch");
+
+ SaveCarriedState(&EmuLineState, &lc->CS);
+ lc->WinPieces = EmuLineState.WinPieces;
+ memcpy(lc->vcscr, EmuLineState.vcscr, sizeof(lc->vcscr));
+}
+
+static void LoadLineCarry(RegStateS* rs, const unsigned crt_line)
+{
+ const auto* lc = &LineCarry[crt_line];
+
+ LoadCarriedState(rs, &lc->CS);
+ rs->WinPieces = lc->WinPieces;
+ memcpy(rs->vcscr, lc->vcscr, sizeof(rs->vcscr));
 }
 
 static int RThreadEntry(void* data)
 {
+ RThreadS* const rt = (RThreadS*)data;
+ RenderS* const rs = rt->RS;
+ const bool is_verify = (rt->Index == NumRThreads);
  bool Running = true;
+ bool DoBusyWait = false;
+ uint32 ReadCount = rt->ReadCount.load(std::memory_order_relaxed);
 
  while(MDFN_LIKELY(Running))
  {
-  while(MDFN_UNLIKELY(WQ_InCount.load(std::memory_order_acquire) == 0))
+  while(MDFN_UNLIKELY(ReadCount == WQ_PubWriteCount.load(std::memory_order_acquire)))
   {
    if(!DoBusyWait)
-    MThreading::Sem_TimedWait(WakeupSem, 1);
+    MThreading::Sem_TimedWait(rt->WakeupSem, 1);
    else
    {
 #ifdef MDFN_SS_BUSYWAIT_PAUSE
@@ -3204,37 +3513,74 @@ static int RThreadEntry(void* data)
   //
   //
   //
-  WQ_Entry* wqe = &WQ[WQ_ReadPos];
+  WQ_Entry* wqe = &WQ[ReadCount & (WQ.size() - 1)];
 
   switch(wqe->Command)
   {
    case COMMAND_WRITE8:
-	MemW<uint8>(wqe->Arg32, wqe->Arg16);
+	rs->MemW<uint8>(wqe->Arg32, wqe->Arg16);
 	break;
 
    case COMMAND_WRITE16:
-	MemW<uint16>(wqe->Arg32, wqe->Arg16);
+	rs->MemW<uint16>(wqe->Arg32, wqe->Arg16);
 	break;
 
    case COMMAND_DRAW_LINE:
-	//for(unsigned i = 0; i < 2; i++)
-	DrawLine((uint16)wqe->Arg32, wqe->Arg32 >> 16, wqe->Arg16);
-	//
-	DrawCounter.fetch_sub(1, std::memory_order_release);
+	if(is_verify)
+	{
+	 const uint16 out_line = wqe->Arg32;
+	 const uint16 vdp2_line = wqe->Arg32 >> 16;
+
+	 rs->BeginLine(rs->VRAM, vdp2_line, wqe->Arg16 & 1);
+	 rs->DrawLine(&VerifyPixels[out_line * 704], &VerifyLineWidths[out_line], vdp2_line);
+	 rs->EndLine(vdp2_line);
+	 //
+	 DrawCounter.fetch_sub(1, std::memory_order_release);
+	}
+	else if((wqe->Arg16 >> 8) == rt->Index)
+	{
+	 const uint16 out_line = wqe->Arg32;
+	 const uint16 vdp2_line = wqe->Arg32 >> 16;
+	 uint32* const line_target = espec->surface->pixels + out_line * espec->surface->pitchinpix;
+	 int32* const line_width = &espec->LineWidths[out_line];
+
+	 if(NumRThreads > 1)
+	 {
+	  LoadLineCarry(rs, espec->InterlaceOn ? (out_line >> 1) : out_line);
+	  rs->DrawLine(line_target, line_width, vdp2_line);
+	 }
+	 else
+	 {
+	  rs->BeginLine(rs->VRAM, vdp2_line, wqe->Arg16 & 1);
+	  rs->DrawLine(line_target, line_width, vdp2_line);
+	  rs->EndLine(vdp2_line);
+	 }
+	 //
+	 DrawCounter.fetch_sub(1, std::memory_order_release);
+	}
 	break;
 
    case COMMAND_RESET:
-	Reset(wqe->Arg32);
+	rs->Reset(wqe->Arg32);
 	break;
 
    case COMMAND_SET_LEM:
-	UserLayerEnableMask = wqe->Arg32;
+	rs->UserLayerEnableMask = wqe->Arg32;
 	break;
 
    case COMMAND_SET_BUSYWAIT:
 	DoBusyWait = wqe->Arg32;
 	break;
 
+   case COMMAND_STATE_SAVE:
+	if(!rt->Index)
+	 SaveCarriedState(rs, &StateStaging);
+	break;
+
+   case COMMAND_STATE_LOAD:
+	LoadState(rs);
+	break;
+
    case COMMAND_EXIT:
 	Running = false;
 	break;
@@ -3242,8 +3588,8 @@ static int RThreadEntry(void* data)
   //
   //
   //
-  WQ_ReadPos = (WQ_ReadPos + 1) % WQ.size();
-  WQ_InCount.fetch_sub(1, std::memory_order_release);
+  ReadCount++;
+  rt->ReadCount.store(ReadCount, std::memory_order_release);
  }
 
  return 0;
@@ -3255,23 +3601,56 @@ static int RThreadEntry(void* data)
 //
 //
 //
-void VDP2REND_Init(const bool IsPAL, const uint64 affinity)
+void VDP2REND_Init(const bool IsPAL, const uint16* vram, const uint64 affinity, const unsigned num_threads, const bool bench, const bool verify)
 {
  PAL = IsPAL;
  VisibleLines = PAL ? 288 : 240;
  //
- UserLayerEnableMask = ~0U;
  Clock28M = false;
  //
- WQ_ReadPos = 0;
- WQ_WritePos = 0;
- WQ_InCount.store(0, std::memory_order_release); 
+ DoBench = bench;
+ BenchFrames = 0;
+ BenchWaitTime = 0;
+ //
+ DoVerify = verify;
+ VerifyFrames = 0;
+ VerifyBadLines = 0;
+ if(DoVerify)
+  VerifyPixels.reset(new uint32[576 * 704]);
+ //
+ EmuVRAM = vram;
+ EmuLineState = RegStateS();
+ //
+ WQ_WriteCount = 0;
+ WQ_FreeCount = WQ.size();
+ WQ_PubWriteCount.store(0, std::memory_order_release);
  DrawCounter.store(0, std::memory_order_release);
 
- WakeupSem = MThreading::Sem_Create();
- RThread = MThreading::Thread_Create(RThreadEntry, NULL, "MDFN VDP2 Render");
- if(affinity)
-  MThreading::Thread_SetAffinity(RThread, affinity);
+ NumRThreads = std::max<unsigned>(1, std::min<unsigned>(MaxRThreads, num_threads));
+ NumWQReaders = NumRThreads + DoVerify;
+
+ for(unsigned i = 0; i < NumWQReaders; i++)
+ {
+  RThreadS* const rt = &RThreads[i];
+  char name[64];
+
+  rt->Index = i;
+  rt->ReadCount.store(0, std::memory_order_release);
+  rt->WakeupSem = MThreading::Sem_Create();
+  rt->RS = new RenderS();
+  rt->RS->UserLayerEnableMask = ~0U;
+
+  if(i == NumRThreads)
+   trio_snprintf(name, sizeof(name), "MDFN VDP2 Render Verify");
+  else if(NumRThreads > 1)
+   trio_snprintf(name, sizeof(name), "MDFN VDP2 Render %u", i);
+  else
+   trio_snprintf(name, sizeof(name), "MDFN VDP2 Render");
+
+  rt->Thread = MThreading::Thread_Create(RThreadEntry, rt, name);
+  if(affinity)
+   MThreading::Thread_SetAffinity(rt->Thread, affinity);
+ }
 }
 
 // Needed for ss.correct_aspect == 0
@@ -3333,17 +3712,43 @@ void VDP2REND_SetGetVideoParams(MDFNGI* gi, const bool caspect, const int sls, c
 
 void VDP2REND_Kill(void)
 {
- if(RThread != NULL)
+ if(NumRThreads)
  {
   WWQ(COMMAND_EXIT);
-  MThreading::Thread_Wait(RThread, NULL);
+  WakeRThreads();
+
+  for(unsigned i = 0; i < NumWQReaders; i++)
+  {
+   MThreading::Thread_Wait(RThreads[i].Thread, NULL);
+   RThreads[i].Thread = NULL;
+  }
  }
 
- if(WakeupSem != NULL)
+ for(unsigned i = 0; i < NumWQReaders; i++)
  {
-  MThreading::Sem_Destroy(WakeupSem);
-  WakeupSem = NULL;
+  if(RThreads[i].WakeupSem != NULL)
+  {
+   MThreading::Sem_Destroy(RThreads[i].WakeupSem);
+   RThreads[i].WakeupSem = NULL;
+  }
+
+  if(RThreads[i].RS != NULL)
+  {
+   delete RThreads[i].RS;
+   RThreads[i].RS = NULL;
+  }
  }
+
+ if(BenchFrames)
+  printf("VDP2 render: %u thread(s), %llu frames, average end-of-frame wait %.2f us\n", NumRThreads, (unsigned long long)BenchFrames, (double)BenchWaitTime / BenchFrames);
+
+ if(VerifyFrames)
+  printf("VDP2 render verify: %u thread(s), %llu frames, %llu mismatched lines\n", NumRThreads, (unsigned long long)VerifyFrames, (unsigned long long)VerifyBadLines);
+
+ VerifyPixels.reset();
+
+ NumRThreads = 0;
+ NumWQReaders = 0;
 }
 
 void VDP2REND_StartFrame(EmulateSpecStruct* espec_arg, const bool clock28m, const int SurfInterlaceField)
@@ -3351,6 +3756,9 @@ void VDP2REND_StartFrame(EmulateSpecStruct* espec_arg, const bool clock28m, cons
  NextOutLine = 0;
  Clock28M = clock28m;
 
+ if(DoVerify)
+  memset(VerifyLineDrawn, 0, sizeof(VerifyLineDrawn));
+
  espec = espec_arg;
 
  if(SurfInterlaceField >= 0)
@@ -3368,14 +3776,56 @@ void VDP2REND_StartFrame(EmulateSpecStruct* espec_arg, const bool clock28m, cons
  espec->DisplayRect.h = (LineVisLast + 1 - LineVisFirst) << espec->InterlaceOn;
 }
 
+//
+// Compares the lines drawn this frame against those drawn by the verification thread.
+//
+static void VerifyFrame(void)
+{
+ for(unsigned crt_line = 0; crt_line < VisibleLines; crt_line++)
+ {
+  if(!VerifyLineDrawn[crt_line])
+   continue;
+
+  uint16 out_line = crt_line;
+
+  if(espec->InterlaceOn)
+   out_line = (out_line << 1) | espec->InterlaceField;
+
+  const int32 w = espec->LineWidths[out_line];
+  const uint32* const a = espec->surface->pixels + out_line * espec->surface->pitchinpix + espec->DisplayRect.x;
+  const uint32* const b = &VerifyPixels[out_line * 704] + espec->DisplayRect.x;
+
+  if(w != VerifyLineWidths[out_line] || memcmp(a, b, w * sizeof(uint32)))
+  {
+   if(!VerifyBadLines)
+    printf("VDP2 render verify: first mismatch at frame %llu, line %u\n", (unsigned long long)VerifyFrames, crt_line);
+
+   VerifyBadLines++;
+  }
+ }
+
+ VerifyFrames++;
+}
+
 void VDP2REND_EndFrame(void)
 {
+ const int64 bench_start = DoBench ? Time::MonoUS() : 0;
+
  while(MDFN_UNLIKELY(DrawCounter.load(std::memory_order_acquire) != 0))
  {
   //fprintf(stderr, "SLEEEEP\n");
   //Time::SleepMS(1);
  }
 
+ if(DoBench)
+ {
+  BenchWaitTime += Time::MonoUS() - bench_start;
+  BenchFrames++;
+ }
+
+ if(DoVerify)
+  VerifyFrame();
+
  WWQ(COMMAND_SET_BUSYWAIT, false);
 
  if(NextOutLine < VisibleLines)
@@ -3416,14 +3866,26 @@ void VDP2REND_DrawLine(const int vdp2_line, const uint32 crt_line, const bool fi
   if(espec->InterlaceOn)
    out_line = (out_line << 1) | espec->InterlaceField;
 
-  auto wdcq = DrawCounter.fetch_add(1, std::memory_order_release);
-  WWQ(COMMAND_DRAW_LINE, ((uint16)vdp2_line << 16) | out_line, field);
+  const unsigned owner = (crt_line / BandLines) % NumRThreads;
+
+  if(NumRThreads > 1)
+  {
+   EmuLineState.BeginLine(EmuVRAM, vdp2_line, field);
+   SaveLineCarry(crt_line);
+   EmuLineState.EndLine(vdp2_line);
+  }
+
+  if(DoVerify)
+   VerifyLineDrawn[crt_line] = true;
+
+  auto wdcq = DrawCounter.fetch_add(1 + DoVerify, std::memory_order_release);
+  WWQ(COMMAND_DRAW_LINE, ((uint16)vdp2_line << 16) | out_line, field | (owner << 8));
   //
   //
   if(crt_line == bwthresh)
   {
    WWQ(COMMAND_SET_BUSYWAIT, true);
-   MThreading::Sem_Post(WakeupSem);
+   WakeRThreads();
   }
   else if(crt_line < bwthresh)
   {
@@ -3432,7 +3894,7 @@ void VDP2REND_DrawLine(const int vdp2_line, const uint32 crt_line, const bool fi
    else if((wdcq + 1) >= 64 && DoWakeupIfNecessary)
    {
     //printf("Post Wakeup: %3d --- crt_line=%3d\n", wdcq + 1, crt_line);
-    MThreading::Sem_Post(WakeupSem);
+    WakeRThreads();
     DoWakeupIfNecessary = false;
    }
   }
@@ -3443,6 +3905,9 @@ void VDP2REND_DrawLine(const int vdp2_line, const uint32 crt_line, const bool fi
 
 void VDP2REND_Reset(bool powering_up)
 {
+ if(NumRThreads > 1)
+  EmuLineState.Reset();
+
  WWQ(COMMAND_RESET, powering_up);
 }
 
@@ -3451,8 +3916,21 @@ void VDP2REND_SetLayerEnableMask(uint64 mask)
  WWQ(COMMAND_SET_LEM, mask);
 }
 
+//
+// With more than one render thread, register writes are also applied to EmuLineState as they're queued.
+//
+static INLINE void EmuRegsWrite(uint32 A, uint16 DB)
+{
+ A &= 0x1FFFFF;
+
+ if(NumRThreads > 1 && A >= 0x180000 && A < 0x1C0000)
+  EmuLineState.RegsWrite(A, DB);
+}
+
 void VDP2REND_Write8_DB(uint32 A, uint16 DB)
 {
+ EmuRegsWrite(A, DB);
+
  //if(DrawCounter.load(std::memory_order_acquire) != 0)
   WWQ(COMMAND_WRITE8, A, DB);
  //else
@@ -3461,6 +3939,8 @@ void VDP2REND_Write8_DB(uint32 A, uint16 DB)
 
 void VDP2REND_Write16_DB(uint32 A, uint16 DB)
 {
+ EmuRegsWrite(A, DB);
+
  //if(DrawCounter.load(std::memory_order_acquire) != 0)
   WWQ(COMMAND_WRITE16, A, DB);
  //else
@@ -3469,63 +3949,78 @@ void VDP2REND_Write16_DB(uint32 A, uint16 DB)
 
 void VDP2REND_StateAction(StateMem* sm, const unsigned load, const bool data_only, uint16 (&rr)[0x100], uint16 (&cr)[2048], uint16 (&vr)[262144])
 {
- while(MDFN_UNLIKELY(WQ_InCount.load(std::memory_order_acquire) != 0))
-  Time::SleepMS(1);
- //
  //
+ // The carried state is saved from the first render thread's RenderS with a single render thread, otherwise from EmuLineState.  Every
+ // copy of the state loads the staged state.
  //
+ if(!load)
+ {
+  if(NumRThreads > 1)
+   SaveCarriedState(&EmuLineState, &StateStaging);
+  else
+  {
+   WWQ(COMMAND_STATE_SAVE);
+   WakeRThreads();
+   WQ_Sync();
+  }
+ }
+
  SFORMAT StateRegs[] =
  {
   SFVAR(Clock28M),	// DUBIOUS
 
-  SFVAR(MosaicVCount),
+  SFVARN(StateStaging.MosaicVCount, "MosaicVCount"),
 
-  SFVAR(VCLast),
+  SFVARN(StateStaging.VCLast, "VCLast"),
 
-  SFVAR(YCoordAccum),
-  SFVAR(MosEff_YCoordAccum),
+  SFVARN(StateStaging.YCoordAccum, "YCoordAccum"),
+  SFVARN(StateStaging.MosEff_YCoordAccum, "MosEff_YCoordAccum"),
 
-  SFVAR(CurXScrollIF),
-  SFVAR(CurYScrollIF),
-  SFVAR(CurXCoordInc),
-  SFVAR(CurLSA),
+  SFVARN(StateStaging.CurXScrollIF, "CurXScrollIF"),
+  SFVARN(StateStaging.CurYScrollIF, "CurYScrollIF"),
+  SFVARN(StateStaging.CurXCoordInc, "CurXCoordInc"),
+  SFVARN(StateStaging.CurLSA, "CurLSA"),
 
-  SFVAR(NBG23_YCounter),
-  SFVAR(MosEff_NBG23_YCounter),
+  SFVARN(StateStaging.NBG23_YCounter, "NBG23_YCounter"),
+  SFVARN(StateStaging.MosEff_NBG23_YCounter, "MosEff_NBG23_YCounter"),
 
-  SFVAR(CurBackTabAddr),
-  SFVAR(CurBackColor),
+  SFVARN(StateStaging.CurBackTabAddr, "CurBackTabAddr"),
+  SFVARN(StateStaging.CurBackColor, "CurBackColor"),
 
-  SFVAR(CurLCTabAddr),
-  SFVAR(CurLCColor),
+  SFVARN(StateStaging.CurLCTabAddr, "CurLCTabAddr"),
+  SFVARN(StateStaging.CurLCColor, "CurLCColor"),
 
   // XStart and XEnd can be modified by line window processing.
-  SFVAR(Window->XStart, 2, sizeof(*Window), Window),
-  SFVAR(Window->XEnd, 2, sizeof(*Window), Window),
-  SFVAR(Window->CurXStart, 2, sizeof(*Window), Window),
-  SFVAR(Window->CurXEnd, 2, sizeof(*Window), Window),
-  SFVAR(Window->CurLineWinAddr, 2, sizeof(*Window), Window),
+  SFVARN(StateStaging.Window->XStart, 2, sizeof(*StateStaging.Window), StateStaging.Window, "Window->XStart"),
+  SFVARN(StateStaging.Window->XEnd, 2, sizeof(*StateStaging.Window), StateStaging.Window, "Window->XEnd"),
+  SFVARN(StateStaging.Window->CurXStart, 2, sizeof(*StateStaging.Window), StateStaging.Window, "Window->CurXStart"),
+  SFVARN(StateStaging.Window->CurXEnd, 2, sizeof(*StateStaging.Window), StateStaging.Window, "Window->CurXEnd"),
+  SFVARN(StateStaging.Window->CurLineWinAddr, 2, sizeof(*StateStaging.Window), StateStaging.Window, "Window->CurLineWinAddr"),
 
   SFEND
  };
 
- // Calls to RegsWrite() should go before MDFNSS_StateAction(), and before memcpy() to VRAM and CRAM.
+ MDFNSS_StateAction(sm, load, data_only, StateRegs, "VDP2REND");
+
  if(load)
  {
-  for(unsigned i = 0; i < 0x100; i++)
+  StateStaging.rr = rr;
+  StateStaging.cr = cr;
+  StateStaging.vr = vr;
+
+  if(NumRThreads > 1)
   {
-   RegsWrite(i << 1, rr[i]);
+   for(unsigned i = 0; i < 0x100; i++)
+    EmuLineState.RegsWrite(i << 1, rr[i]);
+
+   LoadCarriedState(&EmuLineState, &StateStaging);
   }
- }
 
- MDFNSS_StateAction(sm, load, data_only, StateRegs, "VDP2REND");
+  WWQ(COMMAND_STATE_LOAD);
+  WakeRThreads();
+  WQ_Sync();
 
- if(load)
- {
-  memcpy(VRAM, vr, sizeof(VRAM));
-  memcpy(CRAM, cr, sizeof(CRAM));
-
-  RecalcColorCache();
+  StateStaging.rr = StateStaging.cr = StateStaging.vr = NULL;
  }
 }
 
@@ -17,6 +17,9 @@ bool MDFNI_LoadState(const char *fname, const char *suffix) noexcept;
 
 void MDFNI_SelectState(int) noexcept;
 
+// Prints how long MDFNI_SaveState() stalled the calling thread versus the total time to write each state file.
+void MDFNI_PrintStateSaveStatistics(void);
+
 void MDFND_SetStateStatus(StateStatusStruct *status) noexcept;
 void MDFND_SetMovieStatus(StateStatusStruct *status) noexcept;
 }
@@ -30,9 +30,16 @@
 #include "video/resize.h"
 
 #include "MemoryStream.h"
+#include "FileStream.h"
+#include "MThreading.h"
 #include "compress/GZFileStream.h"
 
+#include <zlib.h>
+
+#include <atomic>
+#include <deque>
 #include <functional>
+#include <thread>
 
 namespace Mednafen
 {
@@ -624,6 +631,414 @@ void MDFNSS_LoadSM(Stream *st, bool data_only, bool fuzz)
 	}
 }
 
+//
+// Save states are written in two steps.  The emulation thread serializes the state into a MemoryStream and queues
+// it; a writer thread splits the data into independent blocks, deflates them in parallel, and writes them out as a
+// single gzip member(each block but the last ends on a byte boundary via Z_FULL_FLUSH, so the raw deflate streams
+// can be concatenated, and their CRCs are merged with crc32_combine()).  The result loads through GZFileStream as
+// before.
+//
+struct StateWriteJob
+{
+ std::string path;
+ std::unique_ptr<MemoryStream> data;
+ int level;
+ int64 queue_time;
+ std::function<void(const char* error)> done;	// run on the emulation thread once the file is written; error is NULL on success
+};
+
+struct StateWriteResult
+{
+ std::function<void(const char* error)> done;
+ std::string error;
+};
+
+enum : size_t { MaxPendingWrites = 2 };
+enum : size_t { DeflateBlockSize = 256 * 1024 };
+enum : unsigned { MaxDeflateThreads = 8 };
+
+static MThreading::Thread* WriterThread = nullptr;
+static MThreading::Mutex* WriterMutex = nullptr;
+static MThreading::Cond* WriterCond = nullptr;	// signalled when a job is queued or the writer should exit
+static MThreading::Cond* WriterIdleCond = nullptr;	// signalled when a job is finished
+
+//
+// Protected by WriterMutex.
+//
+static std::deque<StateWriteJob> PendingWrites;
+static std::deque<StateWriteResult> CompletedWrites;
+static bool WriterBusy;
+static bool WriterRun;
+
+//
+// Emulation thread only.
+//
+static uint64 SaveAllocHint = 65536;
+
+//
+// Reported by MDFNI_PrintStateSaveStatistics(); "stall" is the time spent in MDFNI_SaveState() on the emulation
+// thread, "total" is from the start of MDFNI_SaveState() until the file has been closed.
+//
+static struct
+{
+ uint64 saves;
+ uint64 stall_time;
+ uint64 stall_time_max;
+ uint64 total_time;
+ uint64 total_time_max;
+ uint64 deflate_time;
+ uint64 state_bytes;
+ uint64 file_bytes;
+} SaveStats;
+
+struct DeflateBlock
+{
+ const uint8* data;
+ uint32 size;
+ bool last;
+ std::vector<uint8> out;
+ uint32 crc;
+ std::string error;
+};
+
+struct DeflateContext
+{
+ std::vector<DeflateBlock>* blocks;
+ int level;
+ std::atomic<size_t> next;
+};
+
+static void DeflateOneBlock(DeflateBlock* b, int level)
+{
+ z_stream zs;
+
+ memset(&zs, 0, sizeof(zs));
+
+ if(deflateInit2(&zs, level, Z_DEFLATED, -15, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+  throw MDFN_Error(0, _("Error initializing zlib: %s"), zs.msg ? zs.msg : _("Unknown error"));
+
+ // Room for the Z_FULL_FLUSH empty stored block as well.
+ b->out.resize(deflateBound(&zs, b->size) + 16);
+
+ zs.next_in = (Bytef*)b->data;
+ zs.avail_in = b->size;
+ zs.next_out = b->out.data();
+ zs.avail_out = b->out.size();
+
+ const int zr = deflate(&zs, b->last ? Z_FINISH : Z_FULL_FLUSH);
+
+ if(zr != (b->last ? Z_STREAM_END : Z_OK) || zs.avail_in || !zs.avail_out)
+ {
+  deflateEnd(&zs);
+  throw MDFN_Error(0, _("Error compressing save state: %s"), zs.msg ? zs.msg : _("Unknown error"));
+ }
+
+ b->out.resize(zs.total_out);
+ deflateEnd(&zs);
+
+ b->crc = crc32(0, b->data, b->size);
+}
+
+static int DeflateThreadEntry(void* data)
+{
+ DeflateContext* ctx = (DeflateContext*)data;
+ size_t i;
+
+ while((i = ctx->next++) < ctx->blocks->size())
+ {
+  DeflateBlock* b = &(*ctx->blocks)[i];
+
+  try
+  {
+   DeflateOneBlock(b, ctx->level);
+  }
+  catch(std::exception& e)
+  {
+   b->error = e.what();
+  }
+ }
+
+ return 0;
+}
+
+// Returns the size of the file written.
+static uint64 WriteStateFile(const StateWriteJob& job)
+{
+ const uint8* data = job.data->map();
+ const uint64 size = job.data->size();
+ FileStream fp(job.path, FileStream::MODE_WRITE);
+
+ if(job.level < 0)
+ {
+  fp.write(data, size);
+  fp.close();
+  return size;
+ }
+
+ std::vector<DeflateBlock> blocks;
+
+ for(uint64 offs = 0; offs < size || !blocks.size(); offs += DeflateBlockSize)
+ {
+  DeflateBlock b;
+
+  b.data = data + offs;
+  b.size = std::min<uint64>(DeflateBlockSize, size - offs);
+  b.last = (offs + b.size) >= size;
+  b.crc = 0;
+  blocks.push_back(std::move(b));
+ }
+
+ {
+  const int64 deflate_start = Time::MonoUS();
+  DeflateContext ctx;
+  std::vector<MThreading::Thread*> threads;
+  const unsigned num_threads = std::min<size_t>(blocks.size(), std::max<unsigned>(1, std::min<unsigned>(MaxDeflateThreads, std::thread::hardware_concurrency())));
+
+  ctx.blocks = &blocks;
+  ctx.level = job.level;
+  ctx.next = 0;
+
+  try
+  {
+   for(unsigned i = 1; i < num_threads; i++)
+    threads.push_back(MThreading::Thread_Create(DeflateThreadEntry, &ctx, "State Deflate"));
+  }
+  catch(...)
+  {
+   // Fall back to whatever threads could be created; this thread always takes part.
+  }
+
+  DeflateThreadEntry(&ctx);
+
+  for(MThreading::Thread* t : threads)
+   MThreading::Thread_Wait(t, nullptr);
+
+  MThreading::Mutex_Lock(WriterMutex);
+  SaveStats.deflate_time += Time::MonoUS() - deflate_start;
+  MThreading::Mutex_Unlock(WriterMutex);
+ }
+
+ uint8 header[10] = { 0x1F, 0x8B, Z_DEFLATED, 0, 0, 0, 0, 0, 0, 0xFF };
+ uint32 crc = crc32(0, Z_NULL, 0);
+ uint64 file_size = sizeof(header) + 8;
+
+ header[8] = (job.level >= 9) ? 2 : ((job.level <= 1) ? 4 : 0);
+ fp.write(header, sizeof(header));
+
+ for(const DeflateBlock& b : blocks)
+ {
+  if(b.error.size())
+   throw MDFN_Error(0, "%s", b.error.c_str());
+
+  fp.write(b.out.data(), b.out.size());
+  crc = crc32_combine(crc, b.crc, b.size);
+  file_size += b.out.size();
+ }
+
+ fp.put_LE<uint32>(crc);
+ fp.put_LE<uint32>((uint32)size);
+ fp.close();
+
+ return file_size;
+}
+
+static int WriterEntry(void*)
+{
+ MThreading::Mutex_Lock(WriterMutex);
+ while(WriterRun || PendingWrites.size())
+ {
+  if(!PendingWrites.size())
+  {
+   MThreading::Cond_Wait(WriterCond, WriterMutex);
+   continue;
+  }
+
+  StateWriteJob job = std::move(PendingWrites.front());
+  PendingWrites.pop_front();
+  WriterBusy = true;
+  MThreading::Mutex_Unlock(WriterMutex);
+  //
+  //
+  uint64 file_size = 0;
+  std::string error;
+
+  try
+  {
+   file_size = WriteStateFile(job);
+  }
+  catch(std::exception& e)
+  {
+   error = e.what();
+  }
+  //
+  //
+  const uint64 total_time = Time::MonoUS() - job.queue_time;
+
+  MThreading::Mutex_Lock(WriterMutex);
+  CompletedWrites.push_back({ std::move(job.done), error });
+  if(!error.size())
+  {
+   SaveStats.saves++;
+   SaveStats.total_time += total_time;
+   SaveStats.total_time_max = std::max<uint64>(SaveStats.total_time_max, total_time);
+   SaveStats.state_bytes += job.data->size();
+   SaveStats.file_bytes += file_size;
+  }
+  WriterBusy = false;
+  MThreading::Cond_Signal(WriterIdleCond);
+ }
+ MThreading::Mutex_Unlock(WriterMutex);
+
+ return 0;
+}
+
+static void StartWriter(void)
+{
+ if(WriterThread)
+  return;
+
+ if(!WriterMutex)
+  WriterMutex = MThreading::Mutex_Create();
+
+ if(!WriterCond)
+  WriterCond = MThreading::Cond_Create();
+
+ if(!WriterIdleCond)
+  WriterIdleCond = MThreading::Cond_Create();
+
+ memset(&SaveStats, 0, sizeof(SaveStats));
+ WriterBusy = false;
+ WriterRun = true;
+ WriterThread = MThreading::Thread_Create(WriterEntry, nullptr, "State Writer");
+}
+
+// Runs the completion callbacks of finished background writes; emulation thread only.
+static void RunWriteCompletions(void)
+{
+ std::deque<StateWriteResult> completed;
+
+ if(!WriterMutex)
+  return;
+
+ MThreading::Mutex_Lock(WriterMutex);
+ completed.swap(CompletedWrites);
+ MThreading::Mutex_Unlock(WriterMutex);
+
+ for(StateWriteResult& result : completed)
+ {
+  if(result.done)
+   result.done(result.error.size() ? result.error.c_str() : nullptr);
+  else if(result.error.size())
+   MDFN_Notify(MDFN_NOTICE_ERROR, _("Save state write error: %s"), result.error.c_str());
+ }
+}
+
+void MDFNSS_PollPendingSaves(void)
+{
+ RunWriteCompletions();
+}
+
+void MDFNSS_FinishPendingSaves(void)
+{
+ if(WriterThread)
+ {
+  MThreading::Mutex_Lock(WriterMutex);
+  while(PendingWrites.size() || WriterBusy)
+   MThreading::Cond_Wait(WriterIdleCond, WriterMutex);
+  MThreading::Mutex_Unlock(WriterMutex);
+ }
+
+ RunWriteCompletions();
+}
+
+void MDFNSS_StopWriter(void)
+{
+ if(WriterThread)
+ {
+  MThreading::Mutex_Lock(WriterMutex);
+  WriterRun = false;
+  MThreading::Cond_Signal(WriterCond);
+  MThreading::Mutex_Unlock(WriterMutex);
+
+  MThreading::Thread_Wait(WriterThread, nullptr);
+  WriterThread = nullptr;
+ }
+
+ RunWriteCompletions();
+
+ if(WriterIdleCond)
+ {
+  MThreading::Cond_Destroy(WriterIdleCond);
+  WriterIdleCond = nullptr;
+ }
+
+ if(WriterCond)
+ {
+  MThreading::Cond_Destroy(WriterCond);
+  WriterCond = nullptr;
+ }
+
+ if(WriterMutex)
+ {
+  MThreading::Mutex_Destroy(WriterMutex);
+  WriterMutex = nullptr;
+ }
+}
+
+static void QueueStateWrite(const std::string& path, const MDFN_Surface *surface, const MDFN_Rect *DisplayRect, const int32 *LineWidths, std::function<void(const char* error)> done)
+{
+ const int64 start_time = Time::MonoUS();
+ StateWriteJob job;
+
+ RunWriteCompletions();
+ StartWriter();
+
+ job.path = path;
+ job.done = std::move(done);
+ job.level = MDFN_GetSettingI("filesys.state_comp_level");
+ job.queue_time = start_time;
+ job.data.reset(new MemoryStream(SaveAllocHint));
+
+ MDFNSS_SaveSM(job.data.get(), false, surface, DisplayRect, LineWidths);
+ SaveAllocHint = std::max<uint64>(SaveAllocHint, job.data->size());
+
+ MThreading::Mutex_Lock(WriterMutex);
+ while(PendingWrites.size() >= MaxPendingWrites)
+  MThreading::Cond_Wait(WriterIdleCond, WriterMutex);
+
+ PendingWrites.push_back(std::move(job));
+ MThreading::Cond_Signal(WriterCond);
+
+ const uint64 stall_time = Time::MonoUS() - start_time;
+
+ SaveStats.stall_time += stall_time;
+ SaveStats.stall_time_max = std::max<uint64>(SaveStats.stall_time_max, stall_time);
+ MThreading::Mutex_Unlock(WriterMutex);
+}
+
+void MDFNI_PrintStateSaveStatistics(void)
+{
+ if(!WriterThread)
+  return;
+
+ MDFNSS_FinishPendingSaves();
+
+ MThreading::Mutex_Lock(WriterMutex);
+ const auto stats = SaveStats;
+ MThreading::Mutex_Unlock(WriterMutex);
+
+ if(!stats.saves)
+  return;
+
+ MDFN_printf(_("Save state write statistics:\n"));
+ MDFN_AutoIndent aind(1);
+ MDFN_printf(_("States saved: %llu\n"), (unsigned long long)stats.saves);
+ MDFN_printf(_("Emulation thread stall: %.1f ms average, %.1f ms maximum\n"), (double)stats.stall_time / stats.saves / 1000, (double)stats.stall_time_max / 1000);
+ MDFN_printf(_("Total write time: %.1f ms average, %.1f ms maximum\n"), (double)stats.total_time / stats.saves / 1000, (double)stats.total_time_max / 1000);
+ MDFN_printf(_("Deflate time: %.1f ms average\n"), (double)stats.deflate_time / stats.saves / 1000);
+ MDFN_printf(_("State size: %.1f KiB, file size: %.1f KiB average\n"), (double)stats.state_bytes / stats.saves / 1024, (double)stats.file_bytes / stats.saves / 1024);
+}
+
 //
 //
 //
@@ -638,6 +1053,8 @@ void MDFNSS_CheckStates(void)
         if(!MDFNGameInfo->StateAction) 
          return;
 
+	MDFNSS_FinishPendingSaves();
+
 	for(int ssel = 0; ssel < 10; ssel++)
         {
 	 SaveStateStatus[ssel] = false;
@@ -672,6 +1089,8 @@ void MDFNSS_GetStateInfo(const std::string& path, StateStatusStruct* status)
  uint32 StateShowPBHeight;
  uint8 *previewbuffer = NULL;
 
+ MDFNSS_FinishPendingSaves();
+
  try
  {
   GZFileStream fp(path, GZFileStream::MODE::READ);
@@ -769,31 +1188,34 @@ bool MDFNI_SaveState(const char *fname, const char *suffix, const MDFN_Surface *
   }
 
   //
+  // Success and write errors are only known once the writer thread is done with the file.
   //
-  {
-   MemoryStream st(65536);
-
-   MDFNSS_SaveSM(&st, false, surface, DisplayRect, LineWidths);
+  const bool slot_save = !fname && !suffix;
+  const int slot = CurrentState;
 
-   //
-   //
-   //
-   GZFileStream gp(fname ? std::string(fname) : MDFN_MakeFName(MDFNMKF_STATE,CurrentState,suffix),
-			GZFileStream::MODE::WRITE, MDFN_GetSettingI("filesys.state_comp_level"));
+  QueueStateWrite(fname ? std::string(fname) : MDFN_MakeFName(MDFNMKF_STATE,CurrentState,suffix), surface, DisplayRect, LineWidths,
+  [slot_save, slot](const char* error)
+  {
+   if(error)
+   {
+    if(slot_save)
+     MDFN_Notify(MDFN_NOTICE_ERROR, _("State %d save error: %s"), slot, error);
+    else
+     MDFND_OutputNotice(MDFN_NOTICE_ERROR, error);
 
-   gp.write(st.map(), st.size());
-   gp.close();
-  }
+    if(MDFNnetplay)
+     MDFND_NetplayText(error, false);
+   }
+   else if(slot_save)
+   {
+    SaveStateStatus[slot] = true;
+    RecentlySavedState = slot;
+    Marley_Save();
+    MDFN_Notify(MDFN_NOTICE_STATUS, _("State %d saved."), slot);
+   }
+  });
 
   MDFND_SetStateStatus(NULL);
-
-  if(!fname && !suffix)
-  {
-   SaveStateStatus[CurrentState] = true;
-   RecentlySavedState = CurrentState;
-   Marley_Save();
-   MDFN_Notify(MDFN_NOTICE_STATUS, _("State %d saved."), CurrentState);
-  }
  }
  catch(std::exception &e)
  {
@@ -838,6 +1260,8 @@ bool MDFNI_LoadState(const char *fname, const char *suffix) noexcept
      from this ;)).
   */
 
+  MDFNSS_FinishPendingSaves();
+
   {
    GZFileStream st(fname ? std::string(fname) : MDFN_MakeFName(MDFNMKF_STATE,CurrentState,suffix), GZFileStream::MODE::READ);
    uint8 header[32];
@@ -50,6 +50,13 @@ void MDFNSS_LoadSM(Stream *st, bool data_only = false, const bool fuzz = false);
 
 void MDFNSS_CheckStates(void);
 
+// Save states are written to disk by a background thread; success and write errors are reported once a write has
+// finished, from MDFNSS_PollPendingSaves()(called every frame), MDFNSS_FinishPendingSaves()(which waits for queued
+// writes to complete) or MDFNSS_StopWriter()(which also shuts the thread down).
+void MDFNSS_PollPendingSaves(void);
+void MDFNSS_FinishPendingSaves(void);
+void MDFNSS_StopWriter(void);
+
 struct SFORMAT
 {
 	const char* name;	// Name;
@@ -25,39 +25,249 @@
 #include "state_rewind.h"
 
 #include <mednafen/MemoryStream.h>
+#include <mednafen/MThreading.h>
+#include <mednafen/Time.h>
 #include <mednafen/quicklz/quicklz.h>
 
+#include <deque>
+
 #if QLZ_COMPRESSION_LEVEL != 0
  #error "State rewinding code untested with QLZ_COMPRESSION_LEVEL != 0"
 #endif
 
+//
+// The emulation thread only serializes the state into a buffer taken from a pool.  XOR filtering
+// against the previous state and compression are handed to a worker thread, which appends the
+// result to the history and recycles the raw buffer.  The history is bounded either by a frame
+// count("srwframes") or, when "srwmemory" is nonzero, by the total size of the compressed states.
+//
 namespace Mednafen
 {
 
 struct StateMemPacket
 {
-	std::unique_ptr<MemoryStream> data;
+	std::vector<uint8> data;
 	uint32 uncompressed_len = 0;
 };
 
+struct CompressJob
+{
+	std::unique_ptr<MemoryStream> prev;	// filtered in place, then compressed and recycled
+	MemoryStream* cur;			// owned by the next job or by ss_prev, read-only here
+};
+
+enum : size_t { MaxPendingJobs = 4 };
+enum : size_t { MaxPooledStreams = MaxPendingJobs + 2 };
+
 static bool Active = false;
 static bool Enabled = false;
-static std::vector<StateMemPacket> bcs;
-static size_t bcs_pos;
 
+//
+// Shared between the emulation thread and the worker; protected by WorkMutex.
+//
+static std::deque<StateMemPacket> bcs;
+static uint64 bcs_bytes;
+static size_t bcs_max_frames;
+static uint64 bcs_max_bytes;
+static std::deque<CompressJob> PendingJobs;
+static bool WorkerBusy;
+static bool WorkerRun;
+static std::string WorkerError;
+static std::vector<std::unique_ptr<MemoryStream>> ss_pool;
+
+static MThreading::Thread* WorkerThread = nullptr;
+static MThreading::Mutex* WorkMutex = nullptr;
+static MThreading::Cond* WorkCond = nullptr;	// signalled when a job is queued or the worker should exit
+static MThreading::Cond* IdleCond = nullptr;	// signalled when a job is finished
+
+//
+// Emulation thread only.
+//
 static uint32 SRW_AllocHint;
 static std::unique_ptr<MemoryStream> ss_prev;
+static char qlz_scratch_decompress[QLZ_SCRATCH_DECOMPRESS];
+
+//
+// Worker thread only.
+//
+static char qlz_scratch_compress[QLZ_SCRATCH_COMPRESS];
+static std::unique_ptr<MemoryStream> CompressBuf;
+
+//
+// Per-frame cost, reported by MDFNSRW_PrintStatistics().
+//
+static struct
+{
+ uint64 frames;
+ uint64 record_time;	// us spent on the emulation thread
+ uint64 record_time_max;
+ uint64 compress_time;	// us spent on the worker thread
+ uint64 state_bytes;
+ uint64 compressed_bytes;
+ uint64 stalls;		// frames the emulation thread had to wait for the worker
+} Stats;
+
+static std::unique_ptr<MemoryStream> AcquireStream(void)
+{
+ std::unique_ptr<MemoryStream> ret;
+
+ MThreading::Mutex_Lock(WorkMutex);
+ if(ss_pool.size())
+ {
+  ret = std::move(ss_pool.back());
+  ss_pool.pop_back();
+ }
+ MThreading::Mutex_Unlock(WorkMutex);
+
+ if(!ret)
+  ret.reset(new MemoryStream(SRW_AllocHint));
+
+ ret->truncate(0);
+ ret->rewind();
+
+ return ret;
+}
+
+// WorkMutex must be held.
+static void ReleaseStream(std::unique_ptr<MemoryStream> ms)
+{
+ if(ss_pool.size() < MaxPooledStreams)
+  ss_pool.push_back(std::move(ms));
+}
+
+// WorkMutex must be held.  The newest state is always kept, even if it alone exceeds "srwmemory".
+static void TrimHistory(void)
+{
+ while(bcs.size() > 1)
+ {
+  if(bcs_max_bytes ? (bcs_bytes <= bcs_max_bytes) : (bcs.size() <= bcs_max_frames))
+   break;
+
+  bcs_bytes -= bcs.front().data.size();
+  bcs.pop_front();
+ }
+}
+
+static INLINE void DoXORFilter(MemoryStream* prev, MemoryStream* cur) noexcept
+{
+ MDFN_FastMemXOR(prev->map(), cur->map(), std::min(prev->size(), cur->size()));
+}
+
+static void DoCompress(MemoryStream* data, std::vector<uint8>* out)
+{
+ const uint32 uncompressed_len = data->size();
+ const uint32 max_compressed_len = (uncompressed_len + 400);
+ uint32 dst_len;
+
+ CompressBuf->truncate(max_compressed_len);
+ dst_len = qlz_compress(data->map(), (char*)CompressBuf->map(), uncompressed_len, qlz_scratch_compress);
+ out->assign(CompressBuf->map(), CompressBuf->map() + dst_len);
+}
+
+static int WorkerEntry(void*)
+{
+ MThreading::Mutex_Lock(WorkMutex);
+ while(WorkerRun)
+ {
+  if(!PendingJobs.size())
+  {
+   MThreading::Cond_Wait(WorkCond, WorkMutex);
+   continue;
+  }
+
+  CompressJob job = std::move(PendingJobs.front());
+  PendingJobs.pop_front();
+  WorkerBusy = true;
+  MThreading::Mutex_Unlock(WorkMutex);
+  //
+  //
+  const int64 start_time = Time::MonoUS();
+  StateMemPacket smp;
+  std::string error;
+
+  try
+  {
+   DoXORFilter(job.prev.get(), job.cur);
+   DoCompress(job.prev.get(), &smp.data);
+   smp.uncompressed_len = job.prev->size();
+  }
+  catch(std::exception& e)
+  {
+   error = e.what();
+  }
+  //
+  //
+  MThreading::Mutex_Lock(WorkMutex);
+  if(error.size())
+  {
+   // The history is no longer contiguous; drop it and let the emulation thread report the error.
+   bcs.clear();
+   bcs_bytes = 0;
+   WorkerError = error;
+  }
+  else
+  {
+   const size_t compressed_len = smp.data.size();
+
+   bcs_bytes += compressed_len;
+   bcs.push_back(std::move(smp));
+   TrimHistory();
+   Stats.compressed_bytes += compressed_len;
+  }
+  ReleaseStream(std::move(job.prev));
+  Stats.compress_time += Time::MonoUS() - start_time;
+  WorkerBusy = false;
+  MThreading::Cond_Signal(IdleCond);
+ }
+ MThreading::Mutex_Unlock(WorkMutex);
+
+ return 0;
+}
 
-static union
+// WorkMutex must be held.
+static void WaitForWorker(void)
 {
- char compress[QLZ_SCRATCH_COMPRESS];
- char decompress[QLZ_SCRATCH_DECOMPRESS];
-} qlz_scratch;
+ while(PendingJobs.size() || WorkerBusy)
+  MThreading::Cond_Wait(IdleCond, WorkMutex);
+}
 
 static void Cleanup(void)
 {
+ if(WorkerThread)
+ {
+  MThreading::Mutex_Lock(WorkMutex);
+  WorkerRun = false;
+  MThreading::Cond_Signal(WorkCond);
+  MThreading::Mutex_Unlock(WorkMutex);
+
+  MThreading::Thread_Wait(WorkerThread, nullptr);
+  WorkerThread = nullptr;
+ }
+
+ if(IdleCond)
+ {
+  MThreading::Cond_Destroy(IdleCond);
+  IdleCond = nullptr;
+ }
+
+ if(WorkCond)
+ {
+  MThreading::Cond_Destroy(WorkCond);
+  WorkCond = nullptr;
+ }
+
+ if(WorkMutex)
+ {
+  MThreading::Mutex_Destroy(WorkMutex);
+  WorkMutex = nullptr;
+ }
+
+ PendingJobs.clear();
  bcs.clear();
+ bcs_bytes = 0;
+ ss_pool.clear();
  ss_prev.reset(nullptr);
+ CompressBuf.reset(nullptr);
 }
 
 void MDFNSRW_Begin(void) noexcept
@@ -69,11 +279,23 @@ void MDFNSRW_Begin(void) noexcept
  {
   try
   {
-   bcs.resize(std::max<size_t>(3, MDFN_GetSettingUI("srwframes")) - 1);
-   bcs_pos = 0;
-   memset(&qlz_scratch, 0, sizeof(qlz_scratch));
+   bcs_max_frames = std::max<size_t>(3, MDFN_GetSettingUI("srwframes")) - 1;
+   bcs_max_bytes = (uint64)MDFN_GetSettingUI("srwmemory") << 20;
+   bcs_bytes = 0;
+   memset(qlz_scratch_compress, 0, sizeof(qlz_scratch_compress));
+   memset(qlz_scratch_decompress, 0, sizeof(qlz_scratch_decompress));
+   memset(&Stats, 0, sizeof(Stats));
 
    SRW_AllocHint = 8192;
+   CompressBuf.reset(new MemoryStream(SRW_AllocHint));
+
+   WorkMutex = MThreading::Mutex_Create();
+   WorkCond = MThreading::Cond_Create();
+   IdleCond = MThreading::Cond_Create();
+   WorkerBusy = false;
+   WorkerRun = true;
+   WorkerError.clear();
+   WorkerThread = MThreading::Thread_Create(WorkerEntry, nullptr, "State Rewind");
 
    Active = true;
   }
@@ -101,24 +323,25 @@ bool MDFNSRW_IsRunning(void) noexcept
  return Active;
 }
 
-static INLINE void DoXORFilter(MemoryStream* prev, MemoryStream* cur) noexcept
-{
- MDFN_FastMemXOR(prev->map(), cur->map(), std::min(prev->size(), cur->size()));
-}
-
-
-static INLINE std::unique_ptr<MemoryStream> DoCompress(MemoryStream* data)
+void MDFNI_PrintStateRewindStatistics(void)
 {
- const uint32 uncompressed_len = data->size();
- const uint32 max_compressed_len = (uncompressed_len + 400);
- std::unique_ptr<MemoryStream> tmp_buf(new MemoryStream(max_compressed_len, -1));
- uint32 dst_len;
-
- dst_len = qlz_compress(data->map(), (char*)tmp_buf->map(), uncompressed_len, qlz_scratch.compress);
- tmp_buf->truncate(dst_len);
- tmp_buf->shrink_to_fit();
+ if(!Active || !Stats.frames)
+  return;
 
- return tmp_buf;
+ MThreading::Mutex_Lock(WorkMutex);
+ WaitForWorker();
+ const auto stats = Stats;
+ const size_t frames = bcs.size();
+ const uint64 bytes = bcs_bytes;
+ MThreading::Mutex_Unlock(WorkMutex);
+
+ MDFN_printf(_("State rewind statistics for \"%s\":\n"), MDFNGameInfo ? MDFNGameInfo->shortname : "");
+ MDFN_AutoIndent aind(1);
+ MDFN_printf(_("Frames recorded: %llu\n"), (unsigned long long)stats.frames);
+ MDFN_printf(_("Emulation thread: %.1f us/frame average, %llu us maximum, %llu stalls\n"), (double)stats.record_time / stats.frames, (unsigned long long)stats.record_time_max, (unsigned long long)stats.stalls);
+ MDFN_printf(_("Worker thread: %.1f us/frame average\n"), (double)stats.compress_time / stats.frames);
+ MDFN_printf(_("State size: %.1f KiB, compressed: %.1f KiB average\n"), (double)stats.state_bytes / stats.frames / 1024, (double)stats.compressed_bytes / stats.frames / 1024);
+ MDFN_printf(_("History: %zu frames in %.1f MiB\n"), frames, (double)bytes / (1024 * 1024));
 }
 
 //
@@ -132,6 +355,21 @@ static bool DoRewind(void)
  if(!ss_prev)
   return false;
 
+ //
+ // The history must be complete before the most recent compressed state can be taken.
+ //
+ StateMemPacket smp;
+
+ MThreading::Mutex_Lock(WorkMutex);
+ WaitForWorker();
+ if(bcs.size())
+ {
+  smp = std::move(bcs.back());
+  bcs.pop_back();
+  bcs_bytes -= smp.data.size();
+ }
+ MThreading::Mutex_Unlock(WorkMutex);
+
  //
  // Load most recent state.
  //
@@ -141,17 +379,19 @@ static bool DoRewind(void)
  //
  // If a compressed state exists, decompress it.
  //
- StateMemPacket* smp = &bcs[(bcs_pos + bcs.size() - 1) % bcs.size()];
-
- if(smp->data)
+ if(smp.data.size())
  {
-  std::unique_ptr<MemoryStream> tmp(new MemoryStream(smp->uncompressed_len, -1));
-  qlz_decompress((char*)smp->data->map(), tmp->map(), qlz_scratch.decompress);
-  smp->data.reset(nullptr);
-  bcs_pos = (bcs_pos + bcs.size() - 1) % bcs.size();
+  std::unique_ptr<MemoryStream> tmp = AcquireStream();
+
+  tmp->truncate(smp.uncompressed_len);
+  qlz_decompress((char*)smp.data.data(), tmp->map(), qlz_scratch_decompress);
   //
   DoXORFilter(tmp.get(), ss_prev.get());
   //
+  MThreading::Mutex_Lock(WorkMutex);
+  ReleaseStream(std::move(ss_prev));
+  MThreading::Mutex_Unlock(WorkMutex);
+
   ss_prev = std::move(tmp);
  }
 
@@ -163,33 +403,55 @@ static bool DoRewind(void)
 //
 static void DoRecord(void)
 {
+ const int64 start_time = Time::MonoUS();
+
  //
  // Save current state
  //
- std::unique_ptr<MemoryStream> ss_cur(new MemoryStream(SRW_AllocHint));
+ std::unique_ptr<MemoryStream> ss_cur = AcquireStream();
 
  MDFNSS_SaveSM(ss_cur.get(), true);
 
  SRW_AllocHint = std::max<uint32>(SRW_AllocHint, ss_cur->size());
 
  //
- // Compress previous state if it exists.
+ // Queue the previous state for filtering and compression if it exists.
  //
  if(ss_prev)
  {
-  DoXORFilter(ss_prev.get(), ss_cur.get());
+  MThreading::Mutex_Lock(WorkMutex);
+  if(WorkerError.size())
+  {
+   const std::string error = std::move(WorkerError);
 
-  //printf("Compress: %zu\n", ss_prev->size());
+   WorkerError.clear();
+   MThreading::Mutex_Unlock(WorkMutex);
+   throw MDFN_Error(0, "%s", error.c_str());
+  }
 
-  bcs[bcs_pos].data = DoCompress(ss_prev.get());
-  bcs[bcs_pos].uncompressed_len = ss_prev->size();
-  bcs_pos = (bcs_pos + 1) % bcs.size();
+  if(PendingJobs.size() >= MaxPendingJobs)
+  {
+   Stats.stalls++;
+   while(PendingJobs.size() >= MaxPendingJobs)
+    MThreading::Cond_Wait(IdleCond, WorkMutex);
+  }
+
+  PendingJobs.push_back({ std::move(ss_prev), ss_cur.get() });
+  MThreading::Cond_Signal(WorkCond);
+  MThreading::Mutex_Unlock(WorkMutex);
  }
 
  //
  // Make current state previous for next time.
  //
+ Stats.state_bytes += ss_cur->size();
  ss_prev = std::move(ss_cur);
+
+ const uint64 record_time = Time::MonoUS() - start_time;
+
+ Stats.frames++;
+ Stats.record_time += record_time;
+ Stats.record_time_max = std::max<uint64>(Stats.record_time_max, record_time);
 }
 
 bool MDFNSRW_Frame(bool rewind) noexcept
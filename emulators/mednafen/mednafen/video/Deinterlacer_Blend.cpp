@@ -22,53 +22,14 @@
 #include "video-common.h"
 #include "Deinterlacer.h"
 #include "Deinterlacer_Blend.h"
+#include "blend.h"
 
 namespace Mednafen
 {
 
-Deinterlacer_Blend::Deinterlacer_Blend(bool rg) : prev_height(0), prev_valid(false), WantRG(rg)
+Deinterlacer_Blend::Deinterlacer_Blend(bool rg) : prev_height(0), prev_valid(false), RGT(rg ? Blend_GetRGTables() : nullptr), WantRG(rg)
 {
- if(WantRG)
- {
-  for(unsigned i = 0; i < 256; i++)
-  {
-   double ccp = i / 255.0;
-   double cc;
-
-   if(ccp <= 0.04045)
-    cc = ccp / 12.92;
-   else
-    cc = pow((ccp + 0.055) / 1.055, 2.4);
-
-   GCRLUT[i] = std::min<int>(65535, floor(0.5 + 4095 * (65536 / 4096) * cc));
-  }
-
-  for(unsigned i = 0; i < 4096; i++)
-  {
-   double cc = (i + 0.5) / 4095.0;
-   double ccp;
 
-   if(cc <= 0.0031308)
-    ccp = 12.92 * cc;
-   else
-    ccp = 1.055 * pow(cc, 1.0 / 2.4) - 0.055;
-
-   GCALUT[i] = std::min<int>(255, floor(0.5 + 255 * ccp));
-  }
-#if 0
-  for(unsigned i = 0; i < 256; i++)
-  {
-   const unsigned ri = GCALUT[(GCRLUT[i] + GCRLUT[i]) >> (16 - 12 + 1)];
-
-   if(i != ri)
-   // printf("* ");
-   //else
-   // printf("  ");
-    printf("%3d: %3d --- %d(%d)\n", i, ri, GCRLUT[i], GCRLUT[i] >> (16 - 12));
-  }
-  abort();
-#endif
- }
 }
 
 
@@ -87,9 +48,9 @@ INLINE T Deinterlacer_Blend::Blend(T a, T b)
   {
    uint32 ret;
 
-   ret  = GCALUT[(GCRLUT[(uint8)(a >> cc0s)] + GCRLUT[(uint8)(b >> cc0s)]) >> (16 - 12 + 1)] << cc0s;
-   ret |= GCALUT[(GCRLUT[(uint8)(a >> cc1s)] + GCRLUT[(uint8)(b >> cc1s)]) >> (16 - 12 + 1)] << cc1s;
-   ret |= GCALUT[(GCRLUT[(uint8)(a >> cc2s)] + GCRLUT[(uint8)(b >> cc2s)]) >> (16 - 12 + 1)] << cc2s;
+   ret  = RGT->GCALUT[(RGT->GCRLUT[(uint8)(a >> cc0s)] + RGT->GCRLUT[(uint8)(b >> cc0s)]) >> (16 - 12 + 1)] << cc0s;
+   ret |= RGT->GCALUT[(RGT->GCRLUT[(uint8)(a >> cc1s)] + RGT->GCRLUT[(uint8)(b >> cc1s)]) >> (16 - 12 + 1)] << cc1s;
+   ret |= RGT->GCALUT[(RGT->GCRLUT[(uint8)(a >> cc2s)] + RGT->GCRLUT[(uint8)(b >> cc2s)]) >> (16 - 12 + 1)] << cc2s;
 
    return ret;
   }
@@ -106,6 +67,23 @@ INLINE T Deinterlacer_Blend::Blend(T a, T b)
  }
 }
 
+template<typename T, bool rg, unsigned cc0s, unsigned cc1s, unsigned cc2s>
+INLINE void Deinterlacer_Blend::BlendLine(T* d, const T* a, const T* b, int32 w)
+{
+ if(sizeof(T) == 4)
+ {
+  if(rg)
+   Blend_AvgRG32((uint32*)d, (const uint32*)a, (const uint32*)b, w, cc0s, cc1s, cc2s);
+  else
+   Blend_Avg32((uint32*)d, (const uint32*)a, (const uint32*)b, w);
+ }
+ else
+ {
+  for(int32 x = 0; MDFN_LIKELY(x < w); x++)
+   d[x] = Blend<T, rg, cc0s, cc1s, cc2s>(a[x], b[x]);
+ }
+}
+
 template<typename T, bool rg, unsigned cc0s, unsigned cc1s, unsigned cc2s>
 NO_INLINE void Deinterlacer_Blend::InternalProcess(MDFN_Surface* surface, MDFN_Rect& dr, int32* LineWidths, const bool field)
 {
@@ -143,8 +121,7 @@ NO_INLINE void Deinterlacer_Blend::InternalProcess(MDFN_Surface* surface, MDFN_R
    {
     T* s = field ? prevlp : (T*)&prev_field_delay[0];
 
-    for(int32 x = 0; MDFN_LIKELY(x < w); x++)
-     curlp[x] = Blend<T, rg, cc0s, cc1s, cc2s>(curlp[x], s[x]);
+    BlendLine<T, rg, cc0s, cc1s, cc2s>(curlp, curlp, s, w);
    }
    else
    {
@@ -160,8 +137,7 @@ NO_INLINE void Deinterlacer_Blend::InternalProcess(MDFN_Surface* surface, MDFN_R
 
     assert(w == prev_field_w[i + field]);
 
-    for(int32 x = 0; MDFN_LIKELY(x < w); x++)
-     t[x] = Blend<T, rg, cc0s, cc1s, cc2s>(d[x], s[x]);
+    BlendLine<T, rg, cc0s, cc1s, cc2s>(t, d, s, w);
    }
   }
   else
@@ -25,6 +25,8 @@
 namespace Mednafen
 {
 
+struct Blend_RGTables;
+
 class Deinterlacer_Blend : public Deinterlacer
 {
  public:
@@ -42,6 +44,9 @@ class Deinterlacer_Blend : public Deinterlacer
  template<typename T, bool gc, unsigned cc0s, unsigned cc1s, unsigned cc2s>
  T Blend(T a, T b);
 
+ template<typename T, bool gc, unsigned cc0s, unsigned cc1s, unsigned cc2s>
+ void BlendLine(T* d, const T* a, const T* b, int32 w);
+
  template<typename T, bool gc, unsigned cc0s, unsigned cc1s, unsigned cc2s>
  void InternalProcess(MDFN_Surface* surface, MDFN_Rect& dr, int32* LineWidths, const bool field);
 
@@ -54,8 +59,7 @@ class Deinterlacer_Blend : public Deinterlacer
  int32 prev_w_delay;
  bool prev_valid;
  //
- uint16 GCRLUT[256];
- uint8 GCALUT[4096];
+ const Blend_RGTables* const RGT;
  //
  const bool WantRG;
 };
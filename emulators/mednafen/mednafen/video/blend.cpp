@@ -0,0 +1,565 @@
+/******************************************************************************/
+/* Mednafen - Multi-system Emulator                                           */
+/******************************************************************************/
+/* blend.cpp:
+**
+** This program is free software; you can redistribute it and/or
+** modify it under the terms of the GNU General Public License
+** as published by the Free Software Foundation; either version 2
+** of the License, or (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software Foundation, Inc.,
+** 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+
+#include "video-common.h"
+#include "blend.h"
+
+#include <mednafen/Time.h>
+#include <mednafen/cputest/cputest.h>
+
+#include <trio/trio.h>
+
+#if defined(HAVE_SSE2_INTRINSICS)
+ #include <xmmintrin.h>
+ #include <emmintrin.h>
+#endif
+
+#if defined(ARCH_X86) && (defined(__GNUC__) || defined(__clang__))
+ #include <immintrin.h>
+ #define BLEND_HAVE_AVX2 1
+#endif
+
+namespace Mednafen
+{
+
+int Blend_GetImpl(void)
+{
+ static int impl = -1;
+
+ if(impl < 0)
+ {
+  impl = BLEND_IMPL_SCALAR;
+
+#if defined(HAVE_SSE2_INTRINSICS)
+  impl = BLEND_IMPL_SSE2;
+#endif
+
+#if defined(BLEND_HAVE_AVX2)
+  if(cputest_get_flags() & CPUTEST_FLAG_AVX2)
+   impl = BLEND_IMPL_AVX2;
+#endif
+ }
+
+ return impl;
+}
+
+const Blend_RGTables* Blend_GetRGTables(void)
+{
+ static Blend_RGTables t;
+ static bool inited = false;
+
+ if(!inited)
+ {
+  memset(&t, 0, sizeof(t));
+
+  for(unsigned i = 0; i < 256; i++)
+  {
+   double ccp = i / 255.0;
+   double cc;
+
+   if(ccp <= 0.04045)
+    cc = ccp / 12.92;
+   else
+    cc = pow((ccp + 0.055) / 1.055, 2.4);
+
+   t.GCRLUT[i] = std::min<int>(65535, floor(0.5 + 4095 * (65536 / 4096) * cc));
+  }
+
+  for(unsigned i = 0; i < 4096; i++)
+  {
+   double cc = (i + 0.5) / 4095.0;
+   double ccp;
+
+   if(cc <= 0.0031308)
+    ccp = 12.92 * cc;
+   else
+    ccp = 1.055 * pow(cc, 1.0 / 2.4) - 0.055;
+
+   t.GCALUT[i] = std::min<int>(255, floor(0.5 + 255 * ccp));
+  }
+#if 0
+  for(unsigned i = 0; i < 256; i++)
+  {
+   const unsigned ri = t.GCALUT[(t.GCRLUT[i] + t.GCRLUT[i]) >> (16 - 12 + 1)];
+
+   if(i != ri)
+   // printf("* ");
+   //else
+   // printf("  ");
+    printf("%3d: %3d --- %d(%d)\n", i, ri, t.GCRLUT[i], t.GCRLUT[i] >> (16 - 12));
+  }
+  abort();
+#endif
+  inited = true;
+ }
+
+ return &t;
+}
+
+//
+// Plain C
+//
+static INLINE uint32 Avg32(uint32 a, uint32 b)
+{
+ return ((((uint64)a + b) - ((a ^ b) & 0x01010101))) >> 1;
+}
+
+static void Avg32_Scalar(uint32* d, const uint32* a, const uint32* b, uint32 count)
+{
+ for(uint32 x = 0; x < count; x++)
+  d[x] = Avg32(a[x], b[x]);
+}
+
+static void AvgRG32_Scalar(uint32* d, const uint32* a, const uint32* b, uint32 count, unsigned cc0s, unsigned cc1s, unsigned cc2s)
+{
+ const Blend_RGTables* t = Blend_GetRGTables();
+
+ for(uint32 x = 0; x < count; x++)
+ {
+  const uint32 ap = a[x];
+  const uint32 bp = b[x];
+  uint32 ret;
+
+  ret  = t->GCALUT[(t->GCRLUT[(uint8)(ap >> cc0s)] + t->GCRLUT[(uint8)(bp >> cc0s)]) >> (16 - 12 + 1)] << cc0s;
+  ret |= t->GCALUT[(t->GCRLUT[(uint8)(ap >> cc1s)] + t->GCRLUT[(uint8)(bp >> cc1s)]) >> (16 - 12 + 1)] << cc1s;
+  ret |= t->GCALUT[(t->GCRLUT[(uint8)(ap >> cc2s)] + t->GCRLUT[(uint8)(bp >> cc2s)]) >> (16 - 12 + 1)] << cc2s;
+
+  d[x] = ret;
+ }
+}
+
+static void AvgHistory32_Scalar(uint32* pix, uint32* hist, uint32 count)
+{
+ for(uint32 x = 0; x < count; x++)
+ {
+  const uint32 color = pix[x];
+
+  pix[x] = Avg32(color, hist[x]);
+  hist[x] = color;
+ }
+}
+
+static void Accum32_Scalar(uint32* pix, uint16* accum, uint32 count, uint32 amount)
+{
+ const uint32 inv_amount = 16384 - amount;
+
+ for(uint32 x = 0; x < count; x++)
+ {
+  const uint32 color = pix[x];
+  uint32 ret = 0;
+
+  for(unsigned i = 0; i < 4; i++)
+  {
+   const uint32 c = ((color >> (i * 8)) & 0xFF) << 8;
+   uint32 m = accum[x * 4 + i];
+
+   if(amount == 8192)
+    m = (m + c) >> 1;
+   else
+    m = (m * amount + inv_amount * c) >> 14;
+
+   accum[x * 4 + i] = m;
+   ret |= (m >> 8) << (i * 8);
+  }
+
+  pix[x] = ret;
+ }
+}
+
+//
+// SSE2
+//
+#if defined(HAVE_SSE2_INTRINSICS)
+// Rounded-down average; pavgb/pavgw round up, so take off the low bit where a + b is odd.
+static INLINE __m128i Avg8_SSE2(__m128i a, __m128i b)
+{
+ return _mm_sub_epi8(_mm_avg_epu8(a, b), _mm_and_si128(_mm_xor_si128(a, b), _mm_set1_epi8(1)));
+}
+
+static INLINE __m128i Avg16_SSE2(__m128i a, __m128i b)
+{
+ return _mm_sub_epi16(_mm_avg_epu16(a, b), _mm_and_si128(_mm_xor_si128(a, b), _mm_set1_epi16(1)));
+}
+
+// (m * amount + c * inv_amount) >> 14 on unsigned 16-bit elements; the result always fits in 16 bits.
+static INLINE __m128i Accum16_SSE2(__m128i m, __m128i c, __m128i amount, __m128i inv_amount)
+{
+ const __m128i ml = _mm_mullo_epi16(m, amount);
+ const __m128i mh = _mm_mulhi_epu16(m, amount);
+ const __m128i cl = _mm_mullo_epi16(c, inv_amount);
+ const __m128i ch = _mm_mulhi_epu16(c, inv_amount);
+ const __m128i lo = _mm_srli_epi32(_mm_add_epi32(_mm_unpacklo_epi16(ml, mh), _mm_unpacklo_epi16(cl, ch)), 14);
+ const __m128i hi = _mm_srli_epi32(_mm_add_epi32(_mm_unpackhi_epi16(ml, mh), _mm_unpackhi_epi16(cl, ch)), 14);
+ const __m128i bias = _mm_set1_epi32(0x8000);
+
+ return _mm_xor_si128(_mm_packs_epi32(_mm_sub_epi32(lo, bias), _mm_sub_epi32(hi, bias)), _mm_set1_epi16((int16)0x8000));
+}
+
+static void Avg32_SSE2(uint32* d, const uint32* a, const uint32* b, uint32 count)
+{
+ uint32 x = 0;
+
+ for(; x + 4 <= count; x += 4)
+  _mm_storeu_si128((__m128i*)(d + x), Avg8_SSE2(_mm_loadu_si128((const __m128i*)(a + x)), _mm_loadu_si128((const __m128i*)(b + x))));
+
+ Avg32_Scalar(d + x, a + x, b + x, count - x);
+}
+
+static void AvgHistory32_SSE2(uint32* pix, uint32* hist, uint32 count)
+{
+ uint32 x = 0;
+
+ for(; x + 4 <= count; x += 4)
+ {
+  const __m128i c = _mm_loadu_si128((const __m128i*)(pix + x));
+  const __m128i h = _mm_loadu_si128((const __m128i*)(hist + x));
+
+  _mm_storeu_si128((__m128i*)(pix + x), Avg8_SSE2(c, h));
+  _mm_storeu_si128((__m128i*)(hist + x), c);
+ }
+
+ AvgHistory32_Scalar(pix + x, hist + x, count - x);
+}
+
+static void Accum32_SSE2(uint32* pix, uint16* accum, uint32 count, uint32 amount)
+{
+ const __m128i z = _mm_setzero_si128();
+ const __m128i va = _mm_set1_epi16((int16)amount);
+ const __m128i via = _mm_set1_epi16((int16)(16384 - amount));
+ uint32 x = 0;
+
+ for(; x + 4 <= count; x += 4)
+ {
+  const __m128i color = _mm_loadu_si128((const __m128i*)(pix + x));
+  const __m128i c0 = _mm_unpacklo_epi8(z, color);
+  const __m128i c1 = _mm_unpackhi_epi8(z, color);
+  __m128i m0 = _mm_loadu_si128((const __m128i*)(accum + x * 4 + 0));
+  __m128i m1 = _mm_loadu_si128((const __m128i*)(accum + x * 4 + 8));
+
+  if(amount == 8192)
+  {
+   m0 = Avg16_SSE2(m0, c0);
+   m1 = Avg16_SSE2(m1, c1);
+  }
+  else
+  {
+   m0 = Accum16_SSE2(m0, c0, va, via);
+   m1 = Accum16_SSE2(m1, c1, va, via);
+  }
+
+  _mm_storeu_si128((__m128i*)(accum + x * 4 + 0), m0);
+  _mm_storeu_si128((__m128i*)(accum + x * 4 + 8), m1);
+  _mm_storeu_si128((__m128i*)(pix + x), _mm_packus_epi16(_mm_srli_epi16(m0, 8), _mm_srli_epi16(m1, 8)));
+ }
+
+ Accum32_Scalar(pix + x, accum + x * 4, count - x, amount);
+}
+#endif
+
+//
+// AVX2
+//
+#if defined(BLEND_HAVE_AVX2)
+#pragma GCC push_options
+#pragma GCC target("avx2")
+
+static INLINE __m256i Avg8_AVX2(__m256i a, __m256i b)
+{
+ return _mm256_sub_epi8(_mm256_avg_epu8(a, b), _mm256_and_si256(_mm256_xor_si256(a, b), _mm256_set1_epi8(1)));
+}
+
+static INLINE __m256i Avg16_AVX2(__m256i a, __m256i b)
+{
+ return _mm256_sub_epi16(_mm256_avg_epu16(a, b), _mm256_and_si256(_mm256_xor_si256(a, b), _mm256_set1_epi16(1)));
+}
+
+static INLINE __m256i Accum16_AVX2(__m256i m, __m256i c, __m256i amount, __m256i inv_amount)
+{
+ const __m256i ml = _mm256_mullo_epi16(m, amount);
+ const __m256i mh = _mm256_mulhi_epu16(m, amount);
+ const __m256i cl = _mm256_mullo_epi16(c, inv_amount);
+ const __m256i ch = _mm256_mulhi_epu16(c, inv_amount);
+ const __m256i lo = _mm256_srli_epi32(_mm256_add_epi32(_mm256_unpacklo_epi16(ml, mh), _mm256_unpacklo_epi16(cl, ch)), 14);
+ const __m256i hi = _mm256_srli_epi32(_mm256_add_epi32(_mm256_unpackhi_epi16(ml, mh), _mm256_unpackhi_epi16(cl, ch)), 14);
+
+ return _mm256_packus_epi32(lo, hi);
+}
+
+static void Avg32_AVX2(uint32* d, const uint32* a, const uint32* b, uint32 count)
+{
+ uint32 x = 0;
+
+ for(; x + 8 <= count; x += 8)
+  _mm256_storeu_si256((__m256i*)(d + x), Avg8_AVX2(_mm256_loadu_si256((const __m256i*)(a + x)), _mm256_loadu_si256((const __m256i*)(b + x))));
+
+ Avg32_Scalar(d + x, a + x, b + x, count - x);
+}
+
+static void AvgRG32_AVX2(uint32* d, const uint32* a, const uint32* b, uint32 count, unsigned cc0s, unsigned cc1s, unsigned cc2s)
+{
+ const Blend_RGTables* t = Blend_GetRGTables();
+ const unsigned ccs[3] = { cc0s, cc1s, cc2s };
+ const __m256i m8 = _mm256_set1_epi32(0xFF);
+ const __m256i m16 = _mm256_set1_epi32(0xFFFF);
+ uint32 x = 0;
+
+ for(; x + 8 <= count; x += 8)
+ {
+  const __m256i va = _mm256_loadu_si256((const __m256i*)(a + x));
+  const __m256i vb = _mm256_loadu_si256((const __m256i*)(b + x));
+  __m256i ret = _mm256_setzero_si256();
+
+  for(unsigned i = 0; i < 3; i++)
+  {
+   const __m128i sh = _mm_cvtsi32_si128(ccs[i]);
+   const __m256i ia = _mm256_and_si256(_mm256_srl_epi32(va, sh), m8);
+   const __m256i ib = _mm256_and_si256(_mm256_srl_epi32(vb, sh), m8);
+   const __m256i la = _mm256_and_si256(_mm256_i32gather_epi32((const int*)t->GCRLUT, ia, 2), m16);
+   const __m256i lb = _mm256_and_si256(_mm256_i32gather_epi32((const int*)t->GCRLUT, ib, 2), m16);
+   const __m256i il = _mm256_srli_epi32(_mm256_add_epi32(la, lb), 16 - 12 + 1);
+   const __m256i cc = _mm256_and_si256(_mm256_i32gather_epi32((const int*)t->GCALUT, il, 1), m8);
+
+   ret = _mm256_or_si256(ret, _mm256_sll_epi32(cc, sh));
+  }
+
+  _mm256_storeu_si256((__m256i*)(d + x), ret);
+ }
+
+ AvgRG32_Scalar(d + x, a + x, b + x, count - x, cc0s, cc1s, cc2s);
+}
+
+static void AvgHistory32_AVX2(uint32* pix, uint32* hist, uint32 count)
+{
+ uint32 x = 0;
+
+ for(; x + 8 <= count; x += 8)
+ {
+  const __m256i c = _mm256_loadu_si256((const __m256i*)(pix + x));
+  const __m256i h = _mm256_loadu_si256((const __m256i*)(hist + x));
+
+  _mm256_storeu_si256((__m256i*)(pix + x), Avg8_AVX2(c, h));
+  _mm256_storeu_si256((__m256i*)(hist + x), c);
+ }
+
+ AvgHistory32_Scalar(pix + x, hist + x, count - x);
+}
+
+static void Accum32_AVX2(uint32* pix, uint16* accum, uint32 count, uint32 amount)
+{
+ const __m256i va = _mm256_set1_epi16((int16)amount);
+ const __m256i via = _mm256_set1_epi16((int16)(16384 - amount));
+ uint32 x = 0;
+
+ for(; x + 4 <= count; x += 4)
+ {
+  const __m256i c = _mm256_slli_epi16(_mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i*)(pix + x))), 8);
+  __m256i m = _mm256_loadu_si256((const __m256i*)(accum + x * 4));
+
+  if(amount == 8192)
+   m = Avg16_AVX2(m, c);
+  else
+   m = Accum16_AVX2(m, c, va, via);
+
+  _mm256_storeu_si256((__m256i*)(accum + x * 4), m);
+  _mm_storeu_si128((__m128i*)(pix + x), _mm256_castsi256_si128(_mm256_permute4x64_epi64(_mm256_packus_epi16(_mm256_srli_epi16(m, 8), _mm256_setzero_si256()), 0x08)));
+ }
+
+ Accum32_Scalar(pix + x, accum + x * 4, count - x, amount);
+}
+
+#pragma GCC pop_options
+#endif
+
+//
+//
+//
+void Blend_Avg32(uint32* d, const uint32* a, const uint32* b, uint32 count, int impl)
+{
+ switch((impl < 0) ? Blend_GetImpl() : impl)
+ {
+#if defined(BLEND_HAVE_AVX2)
+  case BLEND_IMPL_AVX2: Avg32_AVX2(d, a, b, count); break;
+#endif
+#if defined(HAVE_SSE2_INTRINSICS)
+  case BLEND_IMPL_SSE2: Avg32_SSE2(d, a, b, count); break;
+#endif
+  default: Avg32_Scalar(d, a, b, count); break;
+ }
+}
+
+void Blend_AvgRG32(uint32* d, const uint32* a, const uint32* b, uint32 count, unsigned cc0s, unsigned cc1s, unsigned cc2s, int impl)
+{
+ // SSE2 has no gather, so it's no better than plain C here.
+ switch((impl < 0) ? Blend_GetImpl() : impl)
+ {
+#if defined(BLEND_HAVE_AVX2)
+  case BLEND_IMPL_AVX2: AvgRG32_AVX2(d, a, b, count, cc0s, cc1s, cc2s); break;
+#endif
+  default: AvgRG32_Scalar(d, a, b, count, cc0s, cc1s, cc2s); break;
+ }
+}
+
+void Blend_AvgHistory32(uint32* pix, uint32* hist, uint32 count, int impl)
+{
+ switch((impl < 0) ? Blend_GetImpl() : impl)
+ {
+#if defined(BLEND_HAVE_AVX2)
+  case BLEND_IMPL_AVX2: AvgHistory32_AVX2(pix, hist, count); break;
+#endif
+#if defined(HAVE_SSE2_INTRINSICS)
+  case BLEND_IMPL_SSE2: AvgHistory32_SSE2(pix, hist, count); break;
+#endif
+  default: AvgHistory32_Scalar(pix, hist, count); break;
+ }
+}
+
+void Blend_Accum32(uint32* pix, uint16* accum, uint32 count, uint32 amount, int impl)
+{
+ assert(amount <= 16384);
+
+ switch((impl < 0) ? Blend_GetImpl() : impl)
+ {
+#if defined(BLEND_HAVE_AVX2)
+  case BLEND_IMPL_AVX2: Accum32_AVX2(pix, accum, count, amount); break;
+#endif
+#if defined(HAVE_SSE2_INTRINSICS)
+  case BLEND_IMPL_SSE2: Accum32_SSE2(pix, accum, count, amount); break;
+#endif
+  default: Accum32_Scalar(pix, accum, count, amount); break;
+ }
+}
+
+//
+// Benchmark
+//
+static void RunBench(const uint32* a, const uint32* b, const uint32 count, const char* what)
+{
+ static const char* const impl_names[] = { "scalar", "SSE2", "AVX2" };
+ static const char* const kernel_names[] = { "avg", "avg_rg", "avg_history", "accum(50%)", "accum(70%)" };
+ const unsigned reps = 50;
+ const int best_impl = Blend_GetImpl();
+ std::vector<uint32> pix(count), hist(count), ref_pix, ref_hist;
+ std::vector<uint16> accum(count * 4), ref_accum;
+
+ for(unsigned kernel = 0; kernel < 5; kernel++)
+ {
+  for(int impl = BLEND_IMPL_SCALAR; impl <= best_impl; impl++)
+  {
+   auto run = [&]()
+   {
+    switch(kernel)
+    {
+     case 0: Blend_Avg32(&pix[0], a, b, count, impl); break;
+     case 1: Blend_AvgRG32(&pix[0], a, b, count, 0, 8, 16, impl); break;
+     case 2: Blend_AvgHistory32(&pix[0], &hist[0], count, impl); break;
+     case 3: Blend_Accum32(&pix[0], &accum[0], count, 8192, impl); break;
+     case 4: Blend_Accum32(&pix[0], &accum[0], count, 11469, impl); break;
+    }
+   };
+   auto reset = [&]()
+   {
+    memcpy(&pix[0], a, count * sizeof(uint32));
+    memcpy(&hist[0], b, count * sizeof(uint32));
+    for(uint32 x = 0; x < count * 4; x++)
+     accum[x] = (uint16)(b[x >> 2] >> ((x & 3) * 8)) * 0x101;
+   };
+   bool mismatch = false;
+
+   reset();
+   run();
+
+   if(impl == BLEND_IMPL_SCALAR)
+   {
+    ref_pix = pix;
+    ref_hist = hist;
+    ref_accum = accum;
+   }
+   else
+    mismatch = (pix != ref_pix || hist != ref_hist || accum != ref_accum);
+
+   const int64 st = Time::MonoUS();
+
+   for(unsigned i = 0; i < reps; i++)
+    run();
+
+   const int64 et = Time::MonoUS();
+
+   printf("Blend kernels(%s): %s: %s: %.3f ms/frame%s\n", what, kernel_names[kernel], impl_names[impl], (double)(et - st) / reps / 1000, mismatch ? " -- MISMATCH" : "");
+  }
+ }
+}
+
+void Blend_BenchSynthetic(void)
+{
+ static const struct
+ {
+  uint32 w, h;
+ } sizes[] =
+ {
+  { 320, 240 },
+  { 640, 480 },
+  { 704, 576 },
+ };
+
+ for(auto const& s : sizes)
+ {
+  const uint32 count = s.w * s.h;
+  std::vector<uint32> a(count), b(count);
+  uint32 lfsr = 1;
+  char what[64];
+
+  for(uint32 i = 0; i < count; i++)
+  {
+   lfsr = (lfsr >> 1) ^ (-(lfsr & 1) & 0xD0000001);
+   a[i] = lfsr;
+   lfsr = (lfsr >> 1) ^ (-(lfsr & 1) & 0xD0000001);
+   b[i] = (lfsr & 0x3) ? a[i] ^ (lfsr & 0x01030307) : lfsr;
+  }
+
+  trio_snprintf(what, sizeof(what), "synthetic %ux%u", s.w, s.h);
+  RunBench(&a[0], &b[0], count, what);
+ }
+}
+
+void Blend_BenchRecord(const MDFN_Surface* surface, const MDFN_Rect& rect)
+{
+ static std::vector<uint32> frames[2];
+ static uint32 counter = 0;
+ const unsigned phase = counter++ % 600;
+
+ if(surface->format.bpp != 32 || rect.w <= 0 || rect.h <= 0 || phase < 598)
+  return;
+
+ std::vector<uint32>& f = frames[phase - 598];
+
+ f.resize((size_t)rect.w * rect.h);
+ for(int32 y = 0; y < rect.h; y++)
+  memcpy(&f[(size_t)y * rect.w], surface->pixels + (rect.y + y) * surface->pitchinpix + rect.x, rect.w * sizeof(uint32));
+
+ if(phase == 599 && frames[0].size() == frames[1].size())
+ {
+  char what[64];
+
+  trio_snprintf(what, sizeof(what), "recorded %dx%d", rect.w, rect.h);
+  RunBench(&frames[0][0], &frames[1][0], frames[1].size(), what);
+ }
+}
+
+}
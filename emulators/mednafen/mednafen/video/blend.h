@@ -0,0 +1,71 @@
+/******************************************************************************/
+/* Mednafen - Multi-system Emulator                                           */
+/******************************************************************************/
+/* blend.h:
+**
+** This program is free software; you can redistribute it and/or
+** modify it under the terms of the GNU General Public License
+** as published by the Free Software Foundation; either version 2
+** of the License, or (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software Foundation, Inc.,
+** 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+
+#ifndef __MDFN_VIDEO_BLEND_H
+#define __MDFN_VIDEO_BLEND_H
+
+#include <mednafen/video.h>
+
+namespace Mednafen
+{
+
+//
+// 32bpp line blending kernels shared by the blend deinterlacers and temporal blur.  The SSE2 and AVX2 implementations give
+// exactly the same results as the plain C ones; an impl of -1 selects the best one the CPU supports.
+//
+enum
+{
+ BLEND_IMPL_SCALAR = 0,
+ BLEND_IMPL_SSE2,
+ BLEND_IMPL_AVX2
+};
+
+int Blend_GetImpl(void);
+
+struct Blend_RGTables
+{
+ uint16 GCRLUT[256 + 1];	// sRGB(8-bit) to linear(16-bit)
+ uint8 GCALUT[4096 + 3];	// linear(12-bit) to sRGB(8-bit)
+				// (Both padded so that 32-bit gathers of the last entry stay in bounds.)
+};
+
+const Blend_RGTables* Blend_GetRGTables(void);
+
+// d = (a + b) / 2 for each 8-bit component, rounded down.
+void Blend_Avg32(uint32* d, const uint32* a, const uint32* b, uint32 count, int impl = -1);
+
+// Same, but averaged in linear light through Blend_GetRGTables(), for the color components at shifts cc0s, cc1s and cc2s; the
+// remaining component of d is 0.
+void Blend_AvgRG32(uint32* d, const uint32* a, const uint32* b, uint32 count, unsigned cc0s, unsigned cc1s, unsigned cc2s, int impl = -1);
+
+// pix = (pix + hist) / 2 as Blend_Avg32(), with hist set to the old pix.
+void Blend_AvgHistory32(uint32* pix, uint32* hist, uint32 count, int impl = -1);
+
+// For each 8-bit component of pix and the corresponding 16-bit element of accum:
+//  accum = (accum * amount + (pix << 8) * (16384 - amount)) >> 14, pix = accum >> 8
+void Blend_Accum32(uint32* pix, uint16* accum, uint32 count, uint32 amount, int impl = -1);
+
+// Time each kernel with each implementation and check it against the plain C version, printing the results to stdout; on
+// synthetic frames, and on a pair of consecutive 32bpp frames from the running game every 600 frames passed to Blend_BenchRecord().
+void Blend_BenchSynthetic(void);
+void Blend_BenchRecord(const MDFN_Surface* surface, const MDFN_Rect& rect);
+
+}
+#endif
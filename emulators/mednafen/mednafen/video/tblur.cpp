@@ -21,6 +21,7 @@
 
 #include <mednafen/mednafen.h>
 #include "tblur.h"
+#include "blend.h"
 
 namespace Mednafen
 {
@@ -29,6 +30,7 @@ struct HQPixelEntry
 {
  uint16 a, b, c, d;
 };
+static_assert(sizeof(HQPixelEntry) == 4 * sizeof(uint16), "Blend_Accum32() treats HQPixelEntry arrays as uint16 arrays.");
 
 static std::unique_ptr<uint32[]> BlurBuf;
 static uint32 AccumBlurAmount; // max of 16384, infinite blur!
@@ -88,48 +90,7 @@ void TBlur_Run(EmulateSpecStruct *espec)
     xw = espec->LineWidths[espec->DisplayRect.y + y];
    }
 
-   if(AccumBlurAmount == 8192)
-   {
-    for(int x = 0; x < xw; x++)
-    {
-     uint32 color;
-     HQPixelEntry mixcolor;
-
-     color = pXBuf[(y + espec->DisplayRect.y) * surface->pitch32 + xs + x];
-     mixcolor = AccumBlurBuf[y * bb_pitch + x];
-     mixcolor.a = ((uint32)mixcolor.a + ((color & 0xFF) << 8)) >> 1;
-     mixcolor.b = ((uint32)mixcolor.b + ((color & 0xFF00))) >> 1;
-     mixcolor.c = ((uint32)mixcolor.c + ((color & 0xFF0000) >> 8)) >> 1;
-     mixcolor.d = ((uint32)mixcolor.d + ((color & 0xFF000000) >> 16)) >> 1;
-
-     AccumBlurBuf[y * bb_pitch + x] = mixcolor;
-
-     pXBuf[(y + espec->DisplayRect.y) * surface->pitch32 + xs + x] = ((mixcolor.a >> 8) << 0) | ((mixcolor.b >> 8) << 8) |
-        ((mixcolor.c >> 8) << 16) | ((mixcolor.d >> 8) << 24);
-    }
-   }
-   else
-   {
-    uint32 InvAccumBlurAmount = 16384 - AccumBlurAmount;
-
-    for(int x = 0; x < xw; x++)
-    {
-     uint32 color;
-     HQPixelEntry mixcolor;
-     color = pXBuf[(y + espec->DisplayRect.y) * surface->pitch32 + xs + x];
-
-     mixcolor = AccumBlurBuf[y * bb_pitch + x];
-     mixcolor.a = ((uint32)mixcolor.a * AccumBlurAmount + InvAccumBlurAmount * ((color & 0xFF) << 8)) >> 14;
-     mixcolor.b = ((uint32)mixcolor.b * AccumBlurAmount + InvAccumBlurAmount * ((color & 0xFF00))) >> 14;
-     mixcolor.c = ((uint32)mixcolor.c * AccumBlurAmount + InvAccumBlurAmount * ((color & 0xFF0000) >> 8)) >> 14;
-     mixcolor.d = ((uint32)mixcolor.d * AccumBlurAmount + InvAccumBlurAmount * ((color & 0xFF000000) >> 16)) >> 14;
-     AccumBlurBuf[y * bb_pitch + x] = mixcolor;
-
-     pXBuf[(y + espec->DisplayRect.y) * surface->pitch32 + xs + x] = ((mixcolor.a >> 8) << 0) | ((mixcolor.b >> 8) << 8) |
-        ((mixcolor.c >> 8) << 16) | ((mixcolor.d >> 8) << 24);
-    }
-   }
-
+   Blend_Accum32(&pXBuf[(y + espec->DisplayRect.y) * surface->pitch32 + xs], &AccumBlurBuf[y * bb_pitch].a, xw, AccumBlurAmount);
   }
  }
  else if(BlurBuf)
@@ -144,25 +105,7 @@ void TBlur_Run(EmulateSpecStruct *espec)
     xw = espec->LineWidths[espec->DisplayRect.y + y];
    }
 
-   for(int x = 0; x < xw; x++)
-   {
-    uint32 color, mixcolor;
-    color = pXBuf[(y + espec->DisplayRect.y) * surface->pitch32 + xs + x];
-
-    mixcolor = BlurBuf[y * bb_pitch + x];
-    BlurBuf[y * bb_pitch + x] = color;
-
-    // Needs 64-bit
-    #ifdef HAVE_NATIVE64BIT
-    color = ((((uint64)color + mixcolor) - ((color ^ mixcolor) & 0x01010101))) >> 1;
-    #else
-    color = ((((color & 0x00FF00FF) + (mixcolor & 0x00FF00FF)) >> 1) & 0x00FF00FF) | (((((color & 0xFF00FF00) >> 1) + ((mixcolor & 0xFF00FF00) >> 1))) & 0xFF00FF00);
-    #endif
-
-    //    color = (((color & 0xFF) + (mixcolor & 0xFF)) >> 1) | ((((color & 0xFF00) + (mixcolor & 0xFF00)) >> 1) & 0xFF00) |
-    //       ((((color & 0xFF0000) + (mixcolor & 0xFF0000)) >> 1) & 0xFF0000) | ((((color >> 24) + (mixcolor >> 24)) >> 1) << 24);
-    pXBuf[(y + espec->DisplayRect.y) * surface->pitch32 + xs + x] = color;
-   }
+   Blend_AvgHistory32(&pXBuf[(y + espec->DisplayRect.y) * surface->pitch32 + xs], &BlurBuf[y * bb_pitch], xw);
   }
  }
 }
@@ -24,6 +24,7 @@
    SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
 
 #include <algorithm>
+#include <cstring>
 
 #include "common.h"
 #include "core.h"
@@ -597,6 +598,8 @@ void SCREEN_DrawBuffer::DoAlign(int flags, float *x, float *y, float *w, float *
     }
 }
 
+uint SCREEN_DrawBuffer::s_TextGeneration = 1;
+
 void SCREEN_DrawBuffer::DrawTextRect(FontID font, const char *text, float x, float y, float w, float h, Color color, int align)
 {
     if (align & ALIGN_HCENTER)
@@ -617,17 +620,36 @@ void SCREEN_DrawBuffer::DrawTextRect(FontID font, const char *text, float x, flo
         y += h;
     }
 
+    const SCREEN_AtlasFont *atlasfont = ui_atlas.getFont(font);
+    if (!atlasfont || !text[0])
+    {
+        return;
+    }
+
+    if (align & (ROTATE_90DEG_LEFT | ROTATE_90DEG_RIGHT))
+    {
+        // the alignment of rotated text swaps x and y, it isn't cached
+        m_UncachedRun.m_Glyphs.clear();
+        LayoutTextRect(atlasfont, font, text, x, y, w, align, m_UncachedRun.m_Glyphs);
+        DrawGlyphs(m_UncachedRun, 0.0f, 0.0f, color);
+        return;
+    }
+
+    DrawGlyphs(GetTextRun(atlasfont, font, text, w, align, true), x, y, color);
+}
+
+void SCREEN_DrawBuffer::LayoutTextRect(const SCREEN_AtlasFont *atlasfont, FontID font, const char *text, float x, float y, float w, int align, std::vector<SCREEN_TextGlyph> &glyphs)
+{
     std::string toDraw = text;
     int wrap = align & (FLAG_WRAP_TEXT | FLAG_ELLIPSIZE_TEXT);
-    const SCREEN_AtlasFont *atlasfont = ui_atlas.getFont(font);
-    if (wrap && atlasfont)
+    if (wrap)
     {
         SCREEN_AtlasWordWrapper wrapper(*atlasfont, fontscalex, toDraw.c_str(), w, wrap);
         toDraw = wrapper.Wrapped();
     }
 
     float totalWidth, totalHeight;
-    MeasureTextRect(font, toDraw.c_str(), (int)toDraw.size(), Bounds(x, y, w, h), &totalWidth, &totalHeight, align);
+    MeasureTextRect(font, toDraw.c_str(), (int)toDraw.size(), Bounds(x, y, w, 0.0f), &totalWidth, &totalHeight, align);
 
     std::vector<std::string> lines;
     SCREEN_PSplitString(toDraw, '\n', lines);
@@ -646,7 +668,7 @@ void SCREEN_DrawBuffer::DrawTextRect(FontID font, const char *text, float x, flo
 
     for (const std::string &line : lines)
     {
-        DrawText(font, line.c_str(), x, baseY, color, align);
+        LayoutText(atlasfont, font, line.c_str(), x, baseY, align, glyphs);
 
         float tw, th;
         MeasureText(font, line.c_str(), &tw, &th);
@@ -656,9 +678,7 @@ void SCREEN_DrawBuffer::DrawTextRect(FontID font, const char *text, float x, flo
 
 void SCREEN_DrawBuffer::DrawText(FontID font, const char *text, float x, float y, Color color, int align)
 {
-    size_t textLen = strlen(text);
-    
-    if (!textLen)
+    if (!text[0])
     {
         return;
     }
@@ -668,6 +688,27 @@ void SCREEN_DrawBuffer::DrawText(FontID font, const char *text, float x, float y
     {
         return;
     }
+
+    if (align & (ROTATE_90DEG_LEFT | ROTATE_90DEG_RIGHT))
+    {
+        m_UncachedRun.m_Glyphs.clear();
+        LayoutText(atlasfont, font, text, x, y, align, m_UncachedRun.m_Glyphs);
+        DrawGlyphs(m_UncachedRun, 0.0f, 0.0f, color);
+        return;
+    }
+
+    DrawGlyphs(GetTextRun(atlasfont, font, text, 0.0f, align, false), x, y, color);
+}
+
+void SCREEN_DrawBuffer::LayoutText(const SCREEN_AtlasFont *atlasfont, FontID font, const char *text, float x, float y, int align, std::vector<SCREEN_TextGlyph> &glyphs)
+{
+    size_t textLen = strlen(text);
+    
+    if (!textLen)
+    {
+        return;
+    }
+
     unsigned int cval;
     float w, h;
     MeasureText(font, text, &w, &h);
@@ -724,32 +765,23 @@ void SCREEN_DrawBuffer::DrawText(FontID font, const char *text, float x, float y
         else
         {
             const AtlasChar &c = *ch;
-            float cx1, cy1, cx2, cy2;
+            SCREEN_TextGlyph glyph;
             if (align & ROTATE_90DEG_LEFT)
             {
-                cy1 = y - c.ox * fontscalex;
-                cx1 = x + c.oy * fontscaley;
-                cy2 = y - (c.ox + c.pw) * fontscalex;
-                cx2 = x + (c.oy + c.ph) * fontscaley;
+                glyph.x1 = x + c.oy * fontscaley;
+                glyph.y1 = y - c.ox * fontscalex;
+                glyph.x2 = x + (c.oy + c.ph) * fontscaley;
+                glyph.y2 = y - (c.ox + c.pw) * fontscalex;
             }
             else
             {
-                cx1 = x + c.ox * fontscalex;
-                cy1 = y + c.oy * fontscaley;
-                cx2 = x + (c.ox + c.pw) * fontscalex;
-                cy2 = y + (c.oy + c.ph) * fontscaley;
+                glyph.x1 = x + c.ox * fontscalex;
+                glyph.y1 = y + c.oy * fontscaley;
+                glyph.x2 = x + (c.ox + c.pw) * fontscalex;
+                glyph.y2 = y + (c.oy + c.ph) * fontscaley;
             }
-            
-            glm::mat4 position = glm::mat4
-            (
-                cx1 - m_HalfContextWidth, m_HalfContextHeight - cy1, 1.0f, 1.0f,
-                cx2 - m_HalfContextWidth, m_HalfContextHeight - cy1, 1.0f, 1.0f,
-                cx2 - m_HalfContextWidth, m_HalfContextHeight - cy2, 1.0f, 1.0f,
-                cx1 - m_HalfContextWidth, m_HalfContextHeight - cy2, 1.0f, 1.0f
-            );
-            glm::vec4 textureCoordinates{c.sx, 1.0f - c.sy, c.ex, 1.0f - c.ey};
-            
-            m_Renderer->Draw(MarleyApp::UI::m_FontAtlas, position, textureCoordinates, -0.5f, ConvertColor(color));
+            glyph.textureCoordinates = glm::vec4(c.sx, 1.0f - c.sy, c.ex, 1.0f - c.ey);
+            glyphs.push_back(glyph);
             
             if (align & ROTATE_90DEG_LEFT)
             {
@@ -762,3 +794,122 @@ void SCREEN_DrawBuffer::DrawText(FontID font, const char *text, float x, float y
         }
     }
 }
+
+// FNV-1a over the text and the parameters its layout depends on
+static uint64 HashTextRun(const SCREEN_AtlasFont *atlasfont, const char *text, size_t length, float w, float scaleX, float scaleY, int align, bool rect)
+{
+    uint64 hash = 0xcbf29ce484222325ull;
+    auto mix = [&hash](const void *data, size_t size)
+    {
+        const uint8_t *bytes = static_cast<const uint8_t *>(data);
+        for (size_t i = 0; i < size; i++)
+        {
+            hash = (hash ^ bytes[i]) * 0x100000001b3ull;
+        }
+    };
+    mix(text, length);
+    mix(&atlasfont, sizeof(atlasfont));
+    mix(&w, sizeof(w));
+    mix(&scaleX, sizeof(scaleX));
+    mix(&scaleY, sizeof(scaleY));
+    mix(&align, sizeof(align));
+    mix(&rect, sizeof(rect));
+    return hash;
+}
+
+// Text is laid out relative to its anchor, (0, 0), so that a run can be drawn anywhere. Runs
+// are rebuilt if the generation they were laid out in is out of date, or on a hash collision.
+const SCREEN_TextRun &SCREEN_DrawBuffer::GetTextRun(const SCREEN_AtlasFont *atlasfont, FontID font, const char *text, float w, int align, bool rect)
+{
+    size_t length = strlen(text);
+    if (!m_TextCacheEnabled)
+    {
+        m_TextCacheStatistics.m_Misses++;
+        m_UncachedRun.m_Glyphs.clear();
+        if (rect)
+        {
+            LayoutTextRect(atlasfont, font, text, 0.0f, 0.0f, w, align, m_UncachedRun.m_Glyphs);
+        }
+        else
+        {
+            LayoutText(atlasfont, font, text, 0.0f, 0.0f, align, m_UncachedRun.m_Glyphs);
+        }
+        return m_UncachedRun;
+    }
+
+    uint64 hash = HashTextRun(atlasfont, text, length, w, fontscalex, fontscaley, align, rect);
+    SCREEN_TextRun &run = m_TextRuns[hash];
+    run.m_LastUsedFrame = m_Frame;
+    if ((run.m_Generation == s_TextGeneration) && (run.m_Font == atlasfont) && (run.m_Width == w) &&
+        (run.m_ScaleX == fontscalex) && (run.m_ScaleY == fontscaley) && (run.m_Align == align) &&
+        (run.m_Rect == rect) && (run.m_Text.size() == length) && !memcmp(run.m_Text.data(), text, length))
+    {
+        m_TextCacheStatistics.m_Hits++;
+        return run;
+    }
+
+    m_TextCacheStatistics.m_Misses++;
+    run.m_Generation = s_TextGeneration;
+    run.m_Font   = atlasfont;
+    run.m_Width  = w;
+    run.m_ScaleX = fontscalex;
+    run.m_ScaleY = fontscaley;
+    run.m_Align  = align;
+    run.m_Rect   = rect;
+    run.m_Text.assign(text, length);
+    run.m_Glyphs.clear();
+    if (rect)
+    {
+        LayoutTextRect(atlasfont, font, text, 0.0f, 0.0f, w, align, run.m_Glyphs);
+    }
+    else
+    {
+        LayoutText(atlasfont, font, text, 0.0f, 0.0f, align, run.m_Glyphs);
+    }
+    return run;
+}
+
+void SCREEN_DrawBuffer::DrawGlyphs(const SCREEN_TextRun &run, float x, float y, Color color)
+{
+    glm::vec4 colorVec = ConvertColor(color);
+    float offsetX = x - m_HalfContextWidth;
+    float offsetY = m_HalfContextHeight - y;
+    for (const SCREEN_TextGlyph &glyph : run.m_Glyphs)
+    {
+        float x1 = offsetX + glyph.x1, x2 = offsetX + glyph.x2;
+        float y1 = offsetY - glyph.y1, y2 = offsetY - glyph.y2;
+        glm::mat4 position = glm::mat4
+        (
+            x1, y1, 1.0f, 1.0f,
+            x2, y1, 1.0f, 1.0f,
+            x2, y2, 1.0f, 1.0f,
+            x1, y2, 1.0f, 1.0f
+        );
+        m_Renderer->Draw(MarleyApp::UI::m_FontAtlas, position, glyph.textureCoordinates, -0.5f, colorVec);
+    }
+    m_TextCacheStatistics.m_Glyphs += run.m_Glyphs.size();
+}
+
+void SCREEN_DrawBuffer::InvalidateTextCache()
+{
+    s_TextGeneration++;
+}
+
+void SCREEN_DrawBuffer::OncePerFrame()
+{
+    m_Frame++;
+    if ((m_Frame % TEXT_RUN_EVICTION_INTERVAL) == 0)
+    {
+        for (auto it = m_TextRuns.begin(); it != m_TextRuns.end(); )
+        {
+            if ((m_Frame - it->second.m_LastUsedFrame > TEXT_RUN_MAX_AGE) || (it->second.m_Generation != s_TextGeneration))
+            {
+                it = m_TextRuns.erase(it);
+            }
+            else
+            {
+                it++;
+            }
+        }
+    }
+}
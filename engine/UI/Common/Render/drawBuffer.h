@@ -25,6 +25,10 @@
 
 #pragma once
 
+#include <string>
+#include <vector>
+#include <unordered_map>
+
 #include "spritesheet.h"
 #include "glm.hpp"
 #include "textureAtlas.h"
@@ -76,6 +80,28 @@ struct GradientStop
 
 class SCREEN_TextDrawer;
 
+// a glyph quad of a laid out text, in context coordinates relative to the anchor of the text
+struct SCREEN_TextGlyph
+{
+    float x1, y1, x2, y2;
+    glm::vec4 textureCoordinates;
+};
+
+// the glyphs of a text together with everything their layout depends on
+struct SCREEN_TextRun
+{
+    uint m_Generation = 0;
+    uint m_LastUsedFrame = 0;
+    const SCREEN_AtlasFont *m_Font = nullptr;
+    float m_Width = 0.0f;
+    float m_ScaleX = 0.0f;
+    float m_ScaleY = 0.0f;
+    int m_Align = 0;
+    bool m_Rect = false;
+    std::string m_Text;
+    std::vector<SCREEN_TextGlyph> m_Glyphs;
+};
+
 class SCREEN_DrawBuffer 
 {
 public:
@@ -170,6 +196,23 @@ public:
     }
 
     static void DoAlign(int flags, float *x, float *y, float *w, float *h);
+
+    // The UI draws mostly the same labels every frame, their layout is cached. Runs
+    // that weren't drawn for TEXT_RUN_MAX_AGE frames are evicted by OncePerFrame(),
+    // InvalidateTextCache() drops all of them, for example after a theme change.
+    struct TextCacheStatistics
+    {
+        uint64 m_Hits = 0;
+        uint64 m_Misses = 0;
+        uint64 m_Glyphs = 0;
+    };
+
+    const SCREEN_TextRun &GetTextRun(const SCREEN_AtlasFont *atlasfont, FontID font, const char *text, float w, int align, bool rect);
+    static void InvalidateTextCache();
+    void OncePerFrame();
+    void SetTextCacheEnabled(bool enabled) { m_TextCacheEnabled = enabled; }
+    const TextCacheStatistics &GetTextCacheStatistics() const { return m_TextCacheStatistics; }
+    void ResetTextCacheStatistics() { m_TextCacheStatistics = TextCacheStatistics(); }
 //
 //    void PushDrawMatrix(const SCREEN_Lin::SCREEN_Matrix4x4 &m) 
 //    {
@@ -240,5 +283,19 @@ public:
 //    float curZ_ = 0.0f;
 private:
     glm::vec4 ConvertColor(Color color);
+    void LayoutText(const SCREEN_AtlasFont *atlasfont, FontID font, const char *text, float x, float y, int align, std::vector<SCREEN_TextGlyph> &glyphs);
+    void LayoutTextRect(const SCREEN_AtlasFont *atlasfont, FontID font, const char *text, float x, float y, float w, int align, std::vector<SCREEN_TextGlyph> &glyphs);
+    void DrawGlyphs(const SCREEN_TextRun &run, float x, float y, Color color);
+
+private:
+    static constexpr uint TEXT_RUN_MAX_AGE = 300;
+    static constexpr uint TEXT_RUN_EVICTION_INTERVAL = 60;
+    static uint s_TextGeneration;
+
+    std::unordered_map<uint64, SCREEN_TextRun> m_TextRuns;
+    SCREEN_TextRun m_UncachedRun;
+    bool m_TextCacheEnabled = true;
+    uint m_Frame = 0;
+    TextCacheStatistics m_TextCacheStatistics;
 };
 
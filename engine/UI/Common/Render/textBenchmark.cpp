@@ -0,0 +1,108 @@
+/* Engine Copyright (c) 2021 Engine Development Team 
+   https://github.com/beaumanvienna/gfxRenderEngine
+
+   Permission is hereby granted, free of charge, to any person
+   obtaining a copy of this software and associated documentation files
+   (the "Software"), to deal in the Software without restriction,
+   including without limitation the rights to use, copy, modify, merge,
+   publish, distribute, sublicense, and/or sell copies of the Software,
+   and to permit persons to whom the Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be
+   included in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+   MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+   CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, 
+   TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE 
+   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
+
+#include <chrono>
+#include <string>
+#include <algorithm>
+#include <vector>
+
+#include "core.h"
+#include "textBenchmark.h"
+#include "drawBuffer.h"
+#include "textureAtlas.h"
+
+TextBenchmark::TextBenchmark(uint labels, uint frames)
+    : m_Labels(labels), m_Frames(frames)
+{
+    m_Frames = std::max(m_Frames, 1u);
+}
+
+void TextBenchmark::Run()
+{
+    LOG_CORE_INFO("TextBenchmark: {0} labels, {1} frames", m_Labels, m_Frames);
+
+    double uncachedHitRate, cachedHitRate;
+    double uncachedGlyphsPerSecond = GlyphsPerSecond(false, uncachedHitRate);
+    double cachedGlyphsPerSecond   = GlyphsPerSecond(true, cachedHitRate);
+
+    LOG_CORE_INFO("TextBenchmark: uncached layout: {0:.0f} glyphs/s", uncachedGlyphsPerSecond);
+    LOG_CORE_INFO("TextBenchmark: cached layout:   {0:.0f} glyphs/s, hit rate {1:.1f}%", cachedGlyphsPerSecond, cachedHitRate * 100.0);
+    if (uncachedGlyphsPerSecond > 0.0)
+    {
+        LOG_CORE_INFO("TextBenchmark: speed-up {0:.2f}x", cachedGlyphsPerSecond / uncachedGlyphsPerSecond);
+    }
+}
+
+double TextBenchmark::GlyphsPerSecond(bool cached, double& hitRate)
+{
+    hitRate = 0.0;
+    FontID font("UBUNTU24");
+    const SCREEN_AtlasFont *atlasfont = ui_atlas.getFont(font);
+    if (!atlasfont)
+    {
+        LOG_CORE_ERROR("TextBenchmark: font not found");
+        return 0.0;
+    }
+
+    // every fourth label is wrapped text, like the descriptions of a settings tab
+    std::vector<std::string> labels(m_Labels);
+    for (uint index = 0; index < m_Labels; index++)
+    {
+        if (index % 4 == 3)
+        {
+            labels[index] = "Setting " + std::to_string(index) + ": a longer description that has to be wrapped to the width of its tab";
+        }
+        else
+        {
+            labels[index] = "Setting " + std::to_string(index);
+        }
+    }
+
+    SCREEN_DrawBuffer drawBuffer;
+    drawBuffer.SetTextCacheEnabled(cached);
+    drawBuffer.SetFontScale(0.5f, 0.5f);
+
+    uint64 glyphs = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (uint frame = 0; frame < m_Frames; frame++)
+    {
+        for (uint index = 0; index < m_Labels; index++)
+        {
+            int align = (index % 4 == 3) ? (ALIGN_LEFT | FLAG_WRAP_TEXT) : ALIGN_VCENTER;
+            glyphs += drawBuffer.GetTextRun(atlasfont, font, labels[index].c_str(), 400.0f, align, true).m_Glyphs.size();
+        }
+
+        // a label that changes every frame, like a frame counter
+        std::string counter = std::to_string(frame) + " frames";
+        glyphs += drawBuffer.GetTextRun(atlasfont, font, counter.c_str(), 0.0f, ALIGN_LEFT, false).m_Glyphs.size();
+
+        drawBuffer.OncePerFrame();
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    const SCREEN_DrawBuffer::TextCacheStatistics& statistics = drawBuffer.GetTextCacheStatistics();
+    uint64 lookups = statistics.m_Hits + statistics.m_Misses;
+    hitRate = lookups ? static_cast<double>(statistics.m_Hits) / lookups : 0.0;
+
+    std::chrono::duration<double> seconds = end - start;
+    return static_cast<double>(glyphs) / seconds.count();
+}
@@ -0,0 +1,48 @@
+/* Engine Copyright (c) 2021 Engine Development Team 
+   https://github.com/beaumanvienna/gfxRenderEngine
+
+   Permission is hereby granted, free of charge, to any person
+   obtaining a copy of this software and associated documentation files
+   (the "Software"), to deal in the Software without restriction,
+   including without limitation the rights to use, copy, modify, merge,
+   publish, distribute, sublicense, and/or sell copies of the Software,
+   and to permit persons to whom the Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be
+   included in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+   MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+   CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, 
+   TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE 
+   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
+
+#pragma once
+
+#include "engine.h"
+
+// started with --headless --benchmark=text: lays out the labels of a settings-like screen for a
+// number of frames, with and without the text layout cache of SCREEN_DrawBuffer,
+// and reports the throughput in glyphs/s and the hit rate of the cache
+class TextBenchmark
+{
+
+public:
+
+    TextBenchmark(uint labels = 200, uint frames = 1000);
+
+    void Run();
+
+private:
+
+    double GlyphsPerSecond(bool cached, double& hitRate);
+
+private:
+
+    uint m_Labels;
+    uint m_Frames;
+
+};
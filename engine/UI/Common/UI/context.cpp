@@ -64,6 +64,7 @@ SCREEN_UIContext::SCREEN_UIContext()
 
 void SCREEN_UIContext::UIThemeInit()
 {
+    SCREEN_DrawBuffer::InvalidateTextCache();
     if (CoreSettings::m_UITheme == THEME_RETRO)
     {
         ui_theme.uiFont = SCREEN_UI::FontStyle(FontID("RETRO24"), "", 22);
@@ -183,7 +184,6 @@ void SCREEN_UIContext::Flush()
 //
 void SCREEN_UIContext::PushScissor(const Bounds &bounds)
 {
-    Flush();
     Bounds clipped = TransformBounds(bounds);
     if (scissorStack_.size())
     {
@@ -199,7 +199,6 @@ void SCREEN_UIContext::PushScissor(const Bounds &bounds)
 
 void SCREEN_UIContext::PopScissor()
 {
-    Flush();
     scissorStack_.pop_back();
     ActivateTopScissor();
 }
@@ -223,23 +222,24 @@ Bounds SCREEN_UIContext::GetLayoutBounds() const
     return bounds;
 }
 
+// the renderer clips the quads of the UI against the top of the scissor stack
+// on the CPU, so that pushing and popping doesn't require a flush of the batch
 void SCREEN_UIContext::ActivateTopScissor()
 {
-    Bounds bounds;
+    std::shared_ptr<Renderer> renderer = Engine::m_Engine->GetRenderer();
     if (scissorStack_.size()) 
     {
-        float scale_x = Engine::m_Engine->GetWindowWidth() / Engine::m_Engine->GetContextWidth();
-        float scale_y = Engine::m_Engine->GetWindowHeight() / Engine::m_Engine->GetContextHeight();
-        bounds = scissorStack_.back();
-        int x = floorf(scale_x * bounds.x);
-        int y = Engine::m_Engine->GetWindowHeight() - floorf(scale_y * (bounds.y + bounds.h));
-        int w = std::max(0.0f, ceilf(scale_x * bounds.w));
-        int h = std::max(0.0f, ceilf(scale_y * bounds.h));
-        RenderCommand::SetScissor(x, y, w, h);
+        const Bounds &bounds = scissorStack_.back();
+        glm::vec4 clipRect
+        (
+            bounds.x    - m_HalfContextWidth, m_HalfContextHeight - bounds.y2(),
+            bounds.x2() - m_HalfContextWidth, m_HalfContextHeight - bounds.y
+        );
+        renderer->SetClipRect(clipRect);
     } 
     else 
     {
-        RenderCommand::SetScissor(0, 0, Engine::m_Engine->GetWindowWidth(), Engine::m_Engine->GetWindowHeight());
+        renderer->ResetClipRect();
     }
 }
 
@@ -30,6 +30,7 @@
 #include "screen.h"
 #include "root.h"
 #include "context.h"
+#include "drawBuffer.h"
 #include "inputState.h"
 
 SpriteSheet* SCREEN_ScreenManager::m_SpritesheetUI = nullptr;
@@ -197,6 +198,11 @@ void SCREEN_ScreenManager::deviceRestored()
 //
 void SCREEN_ScreenManager::render()
 {
+    if (getUIContext())
+    {
+        getUIContext()->Draw()->OncePerFrame();
+    }
+
     if (!stack_.empty())
     {
         switch (stack_.back().flags)
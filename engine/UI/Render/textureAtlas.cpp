@@ -23,10 +23,21 @@
    TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE 
    SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
 
+#include <algorithm>
+
 #include "textureAtlas.h"
 #include "fontAtlas.h"
 #include "../../resources/atlas/fontAtlas.cpp"
 
+void SCREEN_Atlas::buildLookupTables() const
+{
+    for (int i = 0; i < num_fonts; i++)
+    {
+        fonts[i]->buildCharTable();
+    }
+    lookupTablesBuilt = true;
+}
+
 const SCREEN_AtlasFont *SCREEN_Atlas::getFont(FontID id) const
 {
     if (id.isInvalid())
@@ -34,18 +45,51 @@ const SCREEN_AtlasFont *SCREEN_Atlas::getFont(FontID id) const
         return nullptr;
     }
 
+    if (!lookupTablesBuilt)
+    {
+        buildLookupTables();
+    }
+
+    auto it = fontsByID.find(id.id);
+    if (it != fontsByID.end())
+    {
+        return it->second;
+    }
+
     for (int i = 0; i < num_fonts; i++)
     {
         if (!strcmp(id.id, fonts[i]->name))
         {
+            fontsByID[id.id] = fonts[i];
             return fonts[i];
         }
     }
     return nullptr;
 }
 
+void SCREEN_AtlasFont::buildCharTable() const
+{
+    charTable.assign(DIRECT_LOOKUP_SIZE, nullptr);
+    for (int i = 0; i < numRanges; i++)
+    {
+        for (int utf32 = ranges[i].start; utf32 < std::min(ranges[i].end, DIRECT_LOOKUP_SIZE); utf32++)
+        {
+            const AtlasChar *c = &charData[ranges[i].result_index + utf32 - ranges[i].start];
+            if (c->ex != 0 || c->ey != 0)
+            {
+                charTable[utf32] = c;
+            }
+        }
+    }
+}
+
 const AtlasChar *SCREEN_AtlasFont::getChar(int utf32) const
 {
+    if (utf32 >= 0 && utf32 < (int)charTable.size())
+    {
+        return charTable[utf32];
+    }
+
     for (int i = 0; i < numRanges; i++)
     {
         if (utf32 >= ranges[i].start && utf32 < ranges[i].end)
@@ -27,6 +27,7 @@
 
 #include <iostream>
 #include <vector>
+#include <unordered_map>
 #include <stdio.h>
 #include <string.h>
 
@@ -107,6 +108,11 @@ struct SCREEN_AtlasFont
 
     // Returns 0 on no match.
     const AtlasChar *getChar(int utf32) const ;
+
+    // code points below DIRECT_LOOKUP_SIZE are looked up in charTable, the rest in the ranges
+    static constexpr int DIRECT_LOOKUP_SIZE = 0x800;
+    mutable std::vector<const AtlasChar *> charTable;
+    void buildCharTable() const;
 };
 
 struct AtlasHeader 
@@ -126,6 +132,12 @@ struct SCREEN_Atlas
     int num_fonts = 0;
     AtlasImage *images = nullptr;
     int num_images = 0;
+
+    // built when the atlas is first used, font IDs are made from string literals
+    // and are looked up by their address after the first time
+    mutable bool lookupTablesBuilt = false;
+    mutable std::unordered_map<const char *, const SCREEN_AtlasFont *> fontsByID;
+    void buildLookupTables() const;
 };
 
 extern const SCREEN_Atlas ui_atlas;
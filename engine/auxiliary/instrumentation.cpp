@@ -23,7 +23,7 @@
 #if defined(PROFILING)
 
     #include <iostream>
-    #include <sstream>
+    #include <cstdio>
 
     #include "core.h"
     #include "engine.h"
@@ -32,25 +32,17 @@
 
     namespace Instrumentation
     {
-        Timer::Timer(const char* name)
-            : m_Name(name)
+        TraceBuffer::TraceBuffer(uint32_t threadID)
+            : m_Events(new Event[CAPACITY]), m_Head(0), m_Tail(0), m_Dropped(0), m_ThreadID(threadID)
         {
-            m_Start = std::chrono::high_resolution_clock::now();
         }
 
-        Timer::~Timer()
+        SessionManager::SessionManager()
+            : m_SessionActive(false), m_StartTime(0), m_Capturing(false), m_WriterRun(false)
         {
-            m_End = std::chrono::high_resolution_clock::now();
-
-            auto start = std::chrono::duration<double, std::micro>{ m_Start.time_since_epoch() };
-            auto elapsedMicroSeconds = std::chrono::time_point_cast<std::chrono::microseconds>(m_End).time_since_epoch() - std::chrono::time_point_cast<std::chrono::microseconds>(m_Start).time_since_epoch();
-            SessionManager::Get().CreateEntry({ m_Name, start, elapsedMicroSeconds, std::this_thread::get_id() });
+            m_FrameMarkerID = Intern("frame");
         }
 
-        SessionManager::SessionManager()
-            : m_CurrentSession(nullptr)
-        {}
-
         SessionManager::~SessionManager()
         {
             End();
@@ -58,13 +50,11 @@
 
         void SessionManager::Begin(const std::string& name, const std::string& filename)
         {
+            End();
+
             std::lock_guard lock(m_Mutex);
-            if (m_CurrentSession)
-            {
-                EndInternal();
-            }
-            m_StartTime =  std::chrono::steady_clock::now();
-            
+            m_StartTime = Now();
+
             //this function must be called
             //after the constructor of engine 
             //and before engine.Start()
@@ -87,8 +77,19 @@
 
             if (m_OutputStream.is_open())
             {
-                m_CurrentSession = new Session({name});
+                m_SessionName = name;
+                m_SessionActive = true;
                 StartJsonFile();
+
+                // discard events from an earlier session
+                for (auto& traceBuffer : m_TraceBuffers)
+                {
+                    traceBuffer->Drain([](const Event&) {});
+                }
+
+                m_WriterRun = true;
+                m_WriterThread = std::thread([this]() { Writer(); });
+                m_Capturing.store(true);
             }
             else
             {
@@ -99,33 +100,201 @@
 
         void SessionManager::End()
         {
+            m_Capturing.store(false);
+            if (m_WriterThread.joinable())
+            {
+                {
+                    std::lock_guard writerLock(m_WriterMutex);
+                    m_WriterRun = false;
+                }
+                m_WriterWakeup.notify_one();
+                m_WriterThread.join();
+            }
+
             std::lock_guard lock(m_Mutex);
             EndInternal();
         }
 
-        void SessionManager::CreateEntry(const Result& result)
+        void SessionManager::StartCapture()
+        {
+            std::lock_guard lock(m_Mutex);
+            if (m_SessionActive)
+            {
+                m_Capturing.store(true);
+            }
+        }
+
+        void SessionManager::StopCapture()
+        {
+            m_Capturing.store(false);
+        }
+
+        void SessionManager::ToggleCapture()
+        {
+            if (IsCapturing())
+            {
+                StopCapture();
+            }
+            else
+            {
+                StartCapture();
+            }
+            LOG_CORE_INFO("Instrumentation: profiling capture {0}", IsCapturing() ? "started" : "stopped");
+        }
+
+        uint32_t SessionManager::Intern(const char* name)
+        {
+            std::lock_guard lock(m_Mutex);
+            for (uint32_t nameID = 0; nameID < m_Names.size(); nameID++)
+            {
+                if (m_Names[nameID] == name)
+                {
+                    return nameID;
+                }
+            }
+            m_Names.push_back(name);
+            m_JsonNames.push_back(EscapeJson(name));
+            return m_Names.size() - 1;
+        }
+
+        std::string SessionManager::EscapeJson(const std::string& str)
         {
-            if ((std::chrono::steady_clock::now() - m_StartTime) > 5min)
+            std::string escaped;
+            escaped.reserve(str.size());
+            for (char character : str)
             {
-                return;
+                switch (character)
+                {
+                    case '"':
+                        escaped += "\\\"";
+                        break;
+                    case '\\':
+                        escaped += "\\\\";
+                        break;
+                    default:
+                        if (static_cast<unsigned char>(character) < 0x20)
+                        {
+                            char code[8];
+                            snprintf(code, sizeof(code), "\\u%04x", static_cast<unsigned char>(character));
+                            escaped += code;
+                        }
+                        else
+                        {
+                            escaped += character;
+                        }
+                        break;
+                }
             }
-            std::stringstream outputFile;
+            return escaped;
+        }
+
+        TraceBuffer* SessionManager::RegisterThread()
+        {
+            std::lock_guard lock(m_Mutex);
+            m_TraceBuffers.push_back(std::make_unique<TraceBuffer>(m_TraceBuffers.size()));
+            return m_TraceBuffers.back().get();
+        }
+
+        void SessionManager::Interval(uint32_t nameID, const Clock::time_point& start, const Clock::time_point& end)
+        {
+            int64_t startTime = std::chrono::duration_cast<std::chrono::nanoseconds>(start.time_since_epoch()).count();
+            int64_t duration  = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+            Record({ startTime, duration, nameID, EVENT_SCOPE });
+        }
 
-            outputFile << std::setprecision(3) << std::fixed;
-            outputFile << ",\n    {";
-            outputFile << "\"cat\":\"function\",";
-            outputFile << "\"dur\":" << result.m_ElapsedTime.count() << ',';
-            outputFile << "\"name\":\"" << result.m_Name << "\",";
-            outputFile << "\"ph\":\"X\",";
-            outputFile << "\"pid\":0,";
-            outputFile << "\"tid\":" << result.m_ThreadID << ",";
-            outputFile << "\"ts\":" << result.m_Start.count();
-            outputFile << "}";
+        void SessionManager::Counter(uint32_t nameID, int64_t value)
+        {
+            Record({ Now(), value, nameID, EVENT_COUNTER });
+        }
 
+        void SessionManager::FrameMarker()
+        {
+            Record({ Now(), 0, m_FrameMarkerID, EVENT_FRAME_MARKER });
+        }
+
+        // cost of an empty PROFILE_SCOPE with capture on and off
+        void SessionManager::MeasureOverhead()
+        {
+            const int iterations = 50000;
+            bool capturing = IsCapturing();
+            PROFILE_NAME_ID("overhead", measurement);
+
+            for (bool capture : {true, false})
+            {
+                m_Capturing.store(capture && m_SessionActive);
+                int64_t start = Now();
+                for (int i = 0; i < iterations; i++)
+                {
+                    Timer timer(profileNameIDmeasurement);
+                }
+                double nanoSecondsPerScope = static_cast<double>(Now() - start) / iterations;
+                LOG_CORE_INFO("Instrumentation: {0:.1f} ns per scope with capture {1}", nanoSecondsPerScope, IsCapturing() ? "on" : "off");
+            }
+            m_Capturing.store(capturing);
+        }
+
+        // wakes up periodically and moves the trace buffers into the output file
+        void SessionManager::Writer()
+        {
+            std::unique_lock writerLock(m_WriterMutex);
+            while (m_WriterRun)
+            {
+                m_WriterWakeup.wait_for(writerLock, std::chrono::milliseconds(50));
+                WriteEvents();
+            }
+            WriteEvents();
+        }
+
+        void SessionManager::WriteEvents()
+        {
             std::lock_guard lock(m_Mutex);
-            if (m_CurrentSession)
+            m_WriteBuffer.clear();
+
+            // only the fixed-size fields go through snprintf, names are appended as they are
+            char fields[128];
+            auto append = [&](const char* format, auto... args)
+            {
+                int length = snprintf(fields, sizeof(fields), format, args...);
+                m_WriteBuffer.append(fields, std::min<size_t>(std::max(length, 0), sizeof(fields) - 1));
+            };
+
+            for (auto& traceBuffer : m_TraceBuffers)
+            {
+                uint32_t threadID = traceBuffer->GetThreadID();
+                traceBuffer->Drain([&](const Event& event)
+                    {
+                        double timestamp = (event.m_Timestamp - m_StartTime) / 1000.0;
+                        if (timestamp < 0.0)
+                        {
+                            return;
+                        }
+                        const std::string& name = m_JsonNames[event.m_NameID];
+                        switch (event.m_Type)
+                        {
+                            case EVENT_SCOPE:
+                                append(",\n    {\"cat\":\"function\",\"dur\":%.3f,\"name\":\"", event.m_Value / 1000.0);
+                                m_WriteBuffer += name;
+                                append("\",\"ph\":\"X\",\"pid\":0,\"tid\":%u,\"ts\":%.3f}", threadID, timestamp);
+                                break;
+                            case EVENT_COUNTER:
+                                m_WriteBuffer += ",\n    {\"cat\":\"counter\",\"name\":\"";
+                                m_WriteBuffer += name;
+                                append("\",\"ph\":\"C\",\"pid\":0,\"tid\":%u,\"ts\":%.3f,\"args\":{\"value\":%lld}}",
+                                    threadID, timestamp, static_cast<long long>(event.m_Value));
+                                break;
+                            case EVENT_FRAME_MARKER:
+                                m_WriteBuffer += ",\n    {\"cat\":\"frame\",\"name\":\"";
+                                m_WriteBuffer += name;
+                                append("\",\"ph\":\"i\",\"s\":\"g\",\"pid\":0,\"tid\":%u,\"ts\":%.3f}", threadID, timestamp);
+                                break;
+                        }
+                    }
+                );
+            }
+
+            if (m_SessionActive && m_WriteBuffer.size())
             {
-                m_OutputStream << outputFile.str();
+                m_OutputStream << m_WriteBuffer;
                 m_OutputStream.flush();
             }
         }
@@ -138,18 +307,22 @@
 
         void SessionManager::EndJsonFile()
         {
-            m_OutputStream << "]}";
+            uint64_t dropped = 0;
+            for (auto& traceBuffer : m_TraceBuffers)
+            {
+                dropped += traceBuffer->GetDropped();
+            }
+            m_OutputStream << "],\"droppedEvents\":" << dropped << "}";
             m_OutputStream.flush();
         }
 
         void SessionManager::EndInternal()
         {
-            if (m_CurrentSession)
+            if (m_SessionActive)
             {
                 EndJsonFile();
                 m_OutputStream.close();
-                delete m_CurrentSession;
-                m_CurrentSession = nullptr;
+                m_SessionActive = false;
             }
         }
     }
@@ -30,11 +30,16 @@
 // enable PROFILING in premake5.lua
 #if defined(PROFILING)
 
+    #include <atomic>
     #include <chrono>
     #include <fstream>
     #include <iostream>
+    #include <memory>
     #include <thread>
     #include <mutex>
+    #include <condition_variable>
+    #include <string>
+    #include <vector>
 
 	#if (defined(__FUNCSIG__) || defined(_MSC_VER))
 		#define FUNC_SIGNATURE __FUNCSIG__
@@ -45,25 +50,96 @@
 	#define PROFILE_BEGIN_SESSION(name, filepath) ::Instrumentation::SessionManager::Get().Begin(name, filepath)
 	#define PROFILE_END_SESSION() ::Instrumentation::SessionManager::Get().End()
 
-    #define PROFILE_SCOPE_LINE2(name, line) ::Instrumentation::Timer timer##line(name)
+    // names are interned once per call site
+    #define PROFILE_NAME_ID(name, line) static const uint32_t profileNameID##line = ::Instrumentation::SessionManager::Get().Intern(name)
+    // same as an expression, so that a scope is a single declaration (name is evaluated at the call site)
+    #define PROFILE_NAME_ID_VALUE(name) [](const char* profileName) { static const uint32_t nameID = ::Instrumentation::SessionManager::Get().Intern(profileName); return nameID; }(name)
+
+    #define PROFILE_SCOPE_LINE2(name, line) ::Instrumentation::Timer timer##line(PROFILE_NAME_ID_VALUE(name))
 	#define PROFILE_SCOPE_LINE(name, line) PROFILE_SCOPE_LINE2(name, line)
 	#define PROFILE_SCOPE(name) PROFILE_SCOPE_LINE(name, __LINE__)
     #define PROFILE_FUNCTION() PROFILE_SCOPE(FUNC_SIGNATURE)
 
+    // an interval measured elsewhere, e.g. across threads
+    #define PROFILE_INTERVAL2(name, start, end, line) { PROFILE_NAME_ID(name, line); ::Instrumentation::SessionManager::Get().Interval(profileNameID##line, start, end); }
+    #define PROFILE_INTERVAL1(name, start, end, line) PROFILE_INTERVAL2(name, start, end, line)
+    #define PROFILE_INTERVAL(name, start, end) PROFILE_INTERVAL1(name, start, end, __LINE__)
+
+    #define PROFILE_COUNTER2(name, value, line) { PROFILE_NAME_ID(name, line); ::Instrumentation::SessionManager::Get().Counter(profileNameID##line, value); }
+    #define PROFILE_COUNTER1(name, value, line) PROFILE_COUNTER2(name, value, line)
+    #define PROFILE_COUNTER(name, value) PROFILE_COUNTER1(name, value, __LINE__)
+
+    #define PROFILE_FRAME_MARKER() ::Instrumentation::SessionManager::Get().FrameMarker()
+
+    // capture can be stopped and restarted while a session is running
+    #define PROFILE_START_CAPTURE() ::Instrumentation::SessionManager::Get().StartCapture()
+    #define PROFILE_STOP_CAPTURE() ::Instrumentation::SessionManager::Get().StopCapture()
+    #define PROFILE_TOGGLE_CAPTURE() ::Instrumentation::SessionManager::Get().ToggleCapture()
+    #define PROFILE_MEASURE_OVERHEAD() ::Instrumentation::SessionManager::Get().MeasureOverhead()
+
     namespace Instrumentation
     {
+        typedef std::chrono::steady_clock Clock;
 
-        struct Result
+        enum EventType : uint32_t
         {
-            std::string m_Name;
-            std::chrono::duration<double, std::micro> m_Start;
-            std::chrono::microseconds m_ElapsedTime;
-            std::thread::id m_ThreadID;
+            EVENT_SCOPE,
+            EVENT_COUNTER,
+            EVENT_FRAME_MARKER
         };
 
-        struct Session
+        struct Event
         {
-            std::string m_Name;
+            int64_t m_Timestamp;    // ns, steady clock
+            int64_t m_Value;        // duration in ns or counter value
+            uint32_t m_NameID;
+            EventType m_Type;
+        };
+
+        // Fixed-size ring of events, written only by the thread that owns it
+        // and read only by the writer thread. Events are dropped when it is full.
+        class TraceBuffer
+        {
+        public:
+
+            TraceBuffer(uint32_t threadID);
+
+            inline void Push(const Event& event)
+            {
+                uint64_t head = m_Head.load(std::memory_order_relaxed);
+                if (head - m_Tail.load(std::memory_order_acquire) == CAPACITY)
+                {
+                    m_Dropped.fetch_add(1, std::memory_order_relaxed);
+                    return;
+                }
+                m_Events[head & (CAPACITY - 1)] = event;
+                m_Head.store(head + 1, std::memory_order_release);
+            }
+
+            // called by the writer thread
+            template<typename F> void Drain(F&& consume)
+            {
+                uint64_t tail = m_Tail.load(std::memory_order_relaxed);
+                uint64_t head = m_Head.load(std::memory_order_acquire);
+                for (; tail != head; tail++)
+                {
+                    consume(m_Events[tail & (CAPACITY - 1)]);
+                }
+                m_Tail.store(tail, std::memory_order_release);
+            }
+
+            uint32_t GetThreadID() const { return m_ThreadID; }
+            uint64_t GetDropped() const { return m_Dropped.load(std::memory_order_relaxed); }
+
+        private:
+
+            static constexpr uint64_t CAPACITY = 1 << 16; // power of two
+
+            std::unique_ptr<Event[]> m_Events;
+            alignas(64) std::atomic<uint64_t> m_Head;
+            alignas(64) std::atomic<uint64_t> m_Tail;
+            std::atomic<uint64_t> m_Dropped;
+            uint32_t m_ThreadID;
         };
 
         class SessionManager
@@ -75,7 +151,31 @@
             void Begin(const std::string& name, const std::string& filename = "results.json");
             void End();
 
-            void CreateEntry(const Result& result);
+            void StartCapture();
+            void StopCapture();
+            void ToggleCapture();
+            bool IsCapturing() const { return m_Capturing.load(std::memory_order_relaxed); }
+
+            uint32_t Intern(const char* name);
+
+            inline void Record(const Event& event)
+            {
+                if (IsCapturing())
+                {
+                    GetTraceBuffer()->Push(event);
+                }
+            }
+
+            void Interval(uint32_t nameID, const Clock::time_point& start, const Clock::time_point& end);
+            void Counter(uint32_t nameID, int64_t value);
+            void FrameMarker();
+
+            void MeasureOverhead();
+
+            static inline int64_t Now()
+            {
+                return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now().time_since_epoch()).count();
+            }
 
             static SessionManager& Get()
             {
@@ -86,16 +186,45 @@
             SessionManager();
             ~SessionManager();
 
+            TraceBuffer* GetTraceBuffer()
+            {
+                thread_local TraceBuffer* traceBuffer = nullptr;
+                if (!traceBuffer)
+                {
+                    traceBuffer = RegisterThread();
+                }
+                return traceBuffer;
+            }
+            TraceBuffer* RegisterThread();
+
             void StartJsonFile();
             void EndJsonFile();
             void EndInternal();
 
+            void Writer();
+            void WriteEvents();
+            static std::string EscapeJson(const std::string& str);
+
         private:
 
-            std::mutex m_Mutex;
-            Session* m_CurrentSession;
+            std::mutex m_Mutex;          // session, trace buffers, and names
+            std::string m_SessionName;
+            bool m_SessionActive;
             std::ofstream m_OutputStream;
-            std::chrono::time_point<std::chrono::steady_clock> m_StartTime;
+            int64_t m_StartTime;
+
+            std::atomic<bool> m_Capturing;
+            std::vector<std::unique_ptr<TraceBuffer>> m_TraceBuffers;
+            std::vector<std::string> m_Names;
+            std::vector<std::string> m_JsonNames; // m_Names escaped for JSON strings
+            uint32_t m_FrameMarkerID;
+
+            // background writer emitting Chrome trace JSON
+            std::thread m_WriterThread;
+            std::mutex m_WriterMutex;
+            std::condition_variable m_WriterWakeup;
+            bool m_WriterRun;
+            std::string m_WriteBuffer;
         };
 
         class Timer
@@ -103,13 +232,20 @@
 
         public:
 
-            Timer(const char* name);
-            ~Timer();
+            Timer(uint32_t nameID)
+                : m_NameID(nameID), m_Start(SessionManager::Now())
+            {
+            }
+
+            ~Timer()
+            {
+                SessionManager::Get().Record({ m_Start, SessionManager::Now() - m_Start, m_NameID, EVENT_SCOPE });
+            }
 
         private:
 
-            const char* m_Name;
-            std::chrono::time_point<std::chrono::high_resolution_clock> m_Start, m_End;
+            uint32_t m_NameID;
+            int64_t m_Start;
 
         };
     }
@@ -119,5 +255,11 @@
 	#define PROFILE_END_SESSION()
 	#define PROFILE_SCOPE(name)
 	#define PROFILE_FUNCTION()
+	#define PROFILE_INTERVAL(name, start, end)
+	#define PROFILE_COUNTER(name, value)
+	#define PROFILE_FRAME_MARKER()
+	#define PROFILE_START_CAPTURE()
+	#define PROFILE_STOP_CAPTURE()
+	#define PROFILE_TOGGLE_CAPTURE()
+	#define PROFILE_MEASURE_OVERHEAD()
 #endif
-
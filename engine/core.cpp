@@ -21,6 +21,7 @@
    SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
 
 #include <csignal>
+#include <sstream>
 #include <filesystem>
 
 #include "input.h"
@@ -37,13 +38,42 @@
 
 Engine*         Engine::m_Engine = nullptr;
 std::unique_ptr<TextureSlotManager> Engine::m_TextureSlotManager;
+std::unique_ptr<TextureManager> Engine::m_TextureManager;
 SettingsManager Engine::m_SettingsManager;
 
 Engine::Engine(int argc, char** argv, const std::string& configFilePath) :
             m_Argc(argc), m_Argv(argv), m_ConfigFilePath(configFilePath),
-            m_Running(false), m_Paused(false), m_Window(nullptr), m_ScaleImguiWidgets(0),
+            m_Running(false), m_Paused(false), m_Headless(false), m_SoftwareRenderer(false), m_Window(nullptr), m_ScaleImguiWidgets(0),
             m_DisableMousePointerTimer(Timer(2500))
 {
+    // --headless: invisible window, runs the renderer benchmark and exits
+    // --benchmark=name[,name...]: with --headless, runs these benchmarks instead ("all" for every one)
+    // --software: renders on the CPU, with --headless runs the frame time benchmark
+    for (int i = 1; i < m_Argc; i++)
+    {
+        std::string argument(m_Argv[i]);
+        if (argument == "--headless")
+        {
+            m_Headless = true;
+        }
+        else if (argument == "--software")
+        {
+            m_SoftwareRenderer = true;
+        }
+        else if (argument.rfind("--benchmark=", 0) == 0)
+        {
+            std::stringstream names(argument.substr(std::string("--benchmark=").size()));
+            std::string name;
+            while (std::getline(names, name, ','))
+            {
+                if (!name.empty())
+                {
+                    m_Benchmarks.push_back(name);
+                }
+            }
+        }
+    }
+
     #ifdef _MSC_VER
     m_HomeDir = "";
     #else
@@ -85,8 +115,8 @@ bool Engine::Start()
 
     InitSettings();
 
-    // set render API
-    RendererAPI::SetAPI(m_CoreSettings.m_RendererAPI);
+    // set render API, --software does not change the saved setting
+    RendererAPI::SetAPI(m_SoftwareRenderer ? RendererAPI::SOFTWARE : m_CoreSettings.m_RendererAPI);
 
     // create main window
     std::string title = "Engine v" ENGINE_VERSION;
@@ -104,6 +134,7 @@ bool Engine::Start()
     m_Window->SetEventCallback([this](Event& event){ return this->OnEvent(event); });
     m_GraphicsContext = m_Window->GetGraphicsContent();
     m_TextureSlotManager = TextureSlotManager::Create();
+    m_TextureManager = std::make_unique<TextureManager>();
 
     // init controller
     if (!m_Controller.Start())
@@ -120,12 +151,15 @@ bool Engine::Start()
     m_Audio = Audio::Create();
     m_Audio->Start();
 
-    // init imgui
+    // init imgui, its backend is OpenGL only
     m_ScaleImguiWidgets = GetWindowScale() * 2.0f;
-    if (!ImguiInit((GLFWwindow*)m_Window->GetWindow(), m_ScaleImguiWidgets))
+    if (RendererAPI::GetAPI() == RendererAPI::OPENGL)
     {
-        LOG_CORE_CRITICAL("Could not initialze imgui");
-        return false;
+        if (!ImguiInit((GLFWwindow*)m_Window->GetWindow(), m_ScaleImguiWidgets))
+        {
+            LOG_CORE_CRITICAL("Could not initialze imgui");
+            return false;
+        }
     }
     m_TimeLastFrame = GetTime();
     m_Running = true;
@@ -147,7 +181,10 @@ void Engine::Quit()
 
     // save settings
     m_CoreSettings.m_EngineVersion    = ENGINE_VERSION;
-    m_CoreSettings.m_EnableFullscreen = IsFullscreen();
+    if (!m_SoftwareRenderer)
+    {
+        m_CoreSettings.m_EnableFullscreen = IsFullscreen();
+    }
     m_SettingsManager.SaveToFile();
 
     if (m_SwitchOffComputer)
@@ -177,10 +214,19 @@ void Engine::OnUpdate()
 
     m_Window->OnUpdate();
     m_Controller.OnUpdate();
+    m_TextureManager->OnUpdate();
 }
 
 void Engine::OnRender()
 {
+    if (m_Renderer)
+    {
+        m_Renderer->EndFrame();
+        PROFILE_COUNTER("quads", m_Renderer->GetStatistics().m_Quads);
+        PROFILE_COUNTER("batches", m_Renderer->GetStatistics().m_Batches);
+    }
+    m_TextureSlotManager->EndFrame();
+    PROFILE_COUNTER("texture binds", m_TextureSlotManager->GetStatistics().m_Binds);
     m_GraphicsContext->SwapBuffers();
 }
 
@@ -227,6 +273,9 @@ void Engine::OnEvent(Event& event)
                 case ENGINE_KEY_F:
                     ToggleFullscreen();
                     break;
+                case ENGINE_KEY_F12:
+                    PROFILE_TOGGLE_CAPTURE();
+                    break;
             }
             return false;
         }
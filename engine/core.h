@@ -24,6 +24,7 @@
 
 #include <iostream>
 #include <memory>
+#include <vector>
 #include <functional>
 
 #include "event.h"
@@ -34,6 +35,7 @@
 #include "rendererAPI.h"
 #include "graphicsContext.h"
 #include "textureSlotManager.h"
+#include "textureManager.h"
 #include "coreSettings.h"
 #include "layerStack.h"
 #include "timestep.h"
@@ -72,6 +74,9 @@ public:
 
     bool IsRunning() const { return m_Running; }
     bool IsPaused() const { return m_Paused; }
+    bool IsHeadless() const { return m_Headless; }
+    bool IsSoftwareRenderer() const { return m_SoftwareRenderer; }
+    const std::vector<std::string>& GetBenchmarks() const { return m_Benchmarks; }
     std::string& GetHomeDirectory() { return m_HomeDir; }
     double GetTime() const { return m_Window->GetTime(); }
     Timestep GetTimestep() const { return m_Timestep; }
@@ -88,6 +93,7 @@ public:
 
     void SetRenderer(std::shared_ptr<Renderer>& renderer) { m_Renderer = renderer; }
     std::shared_ptr<Renderer>& GetRenderer() { return m_Renderer; }
+    std::shared_ptr<Audio>& GetAudio() { return m_Audio; }
 
     void InitSettings();
     void ApplyAppSettings();
@@ -107,6 +113,7 @@ public:
 
     static Engine* m_Engine;
     static std::unique_ptr<TextureSlotManager> m_TextureSlotManager;
+    static std::unique_ptr<TextureManager> m_TextureManager;
 
 private:
 
@@ -117,7 +124,8 @@ private:
     char** m_Argv;
     std::string m_ConfigFilePath;
 
-    bool m_Running, m_Paused, m_SwitchOffComputer;
+    bool m_Running, m_Paused, m_SwitchOffComputer, m_Headless, m_SoftwareRenderer;
+    std::vector<std::string> m_Benchmarks;
     std::string m_HomeDir;
     std::unique_ptr<Window> m_Window;
     std::shared_ptr<GraphicsContext>(m_GraphicsContext);
@@ -22,11 +22,21 @@
 
 #include <chrono>
 #include <thread>
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <functional>
 
 #include "engine.h"
 #include "core.h"
 #include "engineApp.h"
 #include "instrumentation.h"
+#include "rendererBenchmark.h"
+#include "frameTimeBenchmark.h"
+#include "audioBenchmark.h"
+#include "textBenchmark.h"
+#include "tilemapBenchmark.h"
+#include "spriteBenchmark.h"
 #include "application.h"
 #include "event.h"
 #include "GL.h"
@@ -54,6 +64,54 @@ int main(int argc, char* argv[])
         return -1;
     }
 
+    if (engine.IsHeadless())
+    {
+        if (RendererAPI::GetAPI() == RendererAPI::SOFTWARE)
+        {
+            // replays the application offscreen
+            FrameTimeBenchmark frameTimeBenchmark;
+            frameTimeBenchmark.Run(engine, application);
+            application.reset();
+        }
+        else
+        {
+            const std::pair<std::string, std::function<void()>> benchmarks[] =
+            {
+                {"renderer", []() { RendererBenchmark().Run(); }},
+                {"audio",    []() { AudioBenchmark().Run(); }},
+                {"text",     []() { TextBenchmark().Run(); }},
+                {"tilemap",  []() { TilemapBenchmark().Run(); }},
+                {"sprite",   []() { SpriteBenchmark().Run(); }}
+            };
+
+            // selected with --benchmark=name[,name...], the renderer benchmark by default
+            std::vector<std::string> selected = engine.GetBenchmarks();
+            if (selected.empty())
+            {
+                selected.push_back("renderer");
+            }
+            bool all = std::find(selected.begin(), selected.end(), "all") != selected.end();
+            for (auto& name : selected)
+            {
+                if (name != "all" && std::none_of(std::begin(benchmarks), std::end(benchmarks), [&](auto& benchmark) { return benchmark.first == name; }))
+                {
+                    LOG_CORE_WARN("unknown benchmark '{0}'", name);
+                }
+            }
+            for (auto& [name, run] : benchmarks)
+            {
+                if (all || std::find(selected.begin(), selected.end(), name) != selected.end())
+                {
+                    run();
+                }
+            }
+        }
+        PROFILE_MEASURE_OVERHEAD();
+        engine.Quit();
+        PROFILE_END_SESSION();
+        return 0;
+    }
+
     engine.SetAppEventCallback([&](Event& event) { application->OnEvent(event); } );
 
     LOG_CORE_INFO("entering main application");
@@ -65,6 +123,7 @@ int main(int argc, char* argv[])
     
     while (engine.IsRunning())
     {
+        PROFILE_FRAME_MARKER();
         PROFILE_SCOPE("frame");
         {
             PROFILE_SCOPE("engine.OnUpdate()");
@@ -50,6 +50,7 @@ bool EngineApp::Start()
     m_VertexArray = VertexArray::Create();
     m_VertexArray->AddVertexBuffer(m_VertexBuffer);
     m_VertexArray->AddIndexBuffer(m_IndexBuffer);
+    m_IndexBuffer->Create(NUMBER_OF_VERTICIES);
 
     // program the GPU
     m_ShaderProg = ShaderProgram::Create();
@@ -33,6 +33,8 @@
 bool Input::IsKeyPressed(const KeyCode key)
 {
     auto* window = static_cast<GLFWwindow*>(Engine::m_Engine->GetWindow());
+    // no GLFW window with the software renderer
+    if (!window) return false;
     auto state = glfwGetKey(window, static_cast<int32_t>(key));
     return state == GLFW_PRESS || state == GLFW_REPEAT;
 }
@@ -40,6 +42,7 @@ bool Input::IsKeyPressed(const KeyCode key)
 bool Input::IsMouseButtonPressed(const MouseCode button)
 {
     auto* window = static_cast<GLFWwindow*>(Engine::m_Engine->GetWindow());
+    if (!window) return false;
     auto state = glfwGetMouseButton(window, static_cast<int32_t>(button));
     return state == GLFW_PRESS;
 }
@@ -47,6 +50,7 @@ bool Input::IsMouseButtonPressed(const MouseCode button)
 glm::vec2 Input::GetMousePosition()
 {
     auto* window = static_cast<GLFWwindow*>(Engine::m_Engine->GetWindow());
+    if (!window) return { 0.0f, 0.0f };
     double xpos, ypos;
     glfwGetCursorPos(window, &xpos, &ypos);
 
@@ -150,7 +150,10 @@ GLFW_Window::GLFW_Window(const WindowProperties& props)
             
             // make the window visible
             glfwWindowHint(GLFW_VISIBLE, GLFW_TRUE);
-            glfwShowWindow(m_Window);
+            if (!Engine::m_Engine->IsHeadless())
+            {
+                glfwShowWindow(m_Window);
+            }
 
             // set app icon
             GLFWimage icon;
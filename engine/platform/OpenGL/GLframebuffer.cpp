@@ -27,6 +27,7 @@
 
 #include "GLframebuffer.h"
 #include "GL.h"
+#include "core.h"
 
 static const uint s_MaxFramebufferSize = 8192;
 
@@ -203,6 +204,8 @@ void GLFramebuffer::Recreate()
     ASSERT(glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE);
 
     GLCall(glBindFramebuffer(GL_FRAMEBUFFER, 0));
+    // attachments were bound directly, not through the texture slot manager
+    Engine::m_TextureSlotManager->RestoreBindings();
 }
 
 void GLFramebuffer::Bind()
@@ -23,7 +23,8 @@
 #include "GLindexBuffer.h"
 #include "GL.h"
 
-GLIndexBuffer::GLIndexBuffer(const uint* indicies, uint count) : m_VertexCount(0)
+GLIndexBuffer::GLIndexBuffer(const uint* indicies, uint count)
+    : m_BufferMode(BUFFER_MODE_DYNAMIC), m_VertexCount(0), m_IndexCount(count)
 {
     GLCall(glGenBuffers(1, &m_RendererID));
     Bind();
@@ -37,7 +38,8 @@ GLIndexBuffer::GLIndexBuffer(const uint* indicies, uint count) : m_VertexCount(0
     ));
 }
 
-GLIndexBuffer::GLIndexBuffer()  : m_VertexCount(0)
+GLIndexBuffer::GLIndexBuffer(BufferMode bufferMode)
+    : m_BufferMode(bufferMode), m_VertexCount(0), m_IndexCount(0)
 {
     GLCall(glGenBuffers(1, &m_RendererID));
     Bind();
@@ -56,11 +58,53 @@ GLIndexBuffer::~GLIndexBuffer()
     GLCall(glDeleteBuffers(1,&m_RendererID));
 }
 
+// count: maximum number of verticies per draw call
+void GLIndexBuffer::Create(uint count)
+{
+    uint quads = count / 4;
+    if (m_BufferMode != BUFFER_MODE_STREAMING)
+    {
+        m_Indicies.reserve(quads * 6);
+        return;
+    }
+
+    // the quad indicies never change, upload them once
+    std::vector<uint> indicies(quads * 6);
+    for (uint quad = 0; quad < quads; quad++)
+    {
+        uint vertex = quad * 4;
+        uint* index = &indicies[quad * 6];
+        index[0] = vertex + 0;
+        index[1] = vertex + 1;
+        index[2] = vertex + 3;
+        index[3] = vertex + 1;
+        index[4] = vertex + 2;
+        index[5] = vertex + 3;
+    }
+
+    Bind();
+    GLCall(glBufferData
+    (
+        GL_ELEMENT_ARRAY_BUFFER,            /* target */
+        indicies.size() * sizeof(uint),     /* buffer size */
+        (const void*)indicies.data(),       /* actual data */
+        GL_STATIC_DRAW                      /* usage */
+    ));
+}
+
 void GLIndexBuffer::AddObject(IndexBufferObject object)
 {
     switch (object)
     {
         case INDEX_BUFFER_QUAD:
+
+            m_IndexCount += 6;
+            if (m_BufferMode == BUFFER_MODE_STREAMING)
+            {
+                // indicies are already in the static index buffer
+                m_VertexCount += 4;
+                break;
+            }
         
             //0,1,3,   /*first triangle */
             //
@@ -87,11 +131,12 @@ void GLIndexBuffer::BeginScene()
 {
     m_Indicies.clear(); 
     m_VertexCount = 0;
+    m_IndexCount = 0;
 }
 
 void GLIndexBuffer::EndScene()
 {
-    if (!m_Indicies.size()) return;
+    if ((m_BufferMode == BUFFER_MODE_STREAMING) || !m_Indicies.size()) return;
     Bind();
     // load data into ibo
     GLCall(glBufferData
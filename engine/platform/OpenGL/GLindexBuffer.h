@@ -31,21 +31,25 @@ class GLIndexBuffer : public IndexBuffer
 {
 public:
 
-    GLIndexBuffer(); //empty buffer
+    GLIndexBuffer(BufferMode bufferMode = BUFFER_MODE_STREAMING); //empty buffer
     GLIndexBuffer(const uint* indicies, uint count); // set all indicies in constructor
     ~GLIndexBuffer();
 
+    virtual void Create(uint count) override;
     virtual void AddObject(IndexBufferObject object) override;
     virtual void BeginScene() override;
     virtual void EndScene() override;
 
     virtual void Bind() const override;
     virtual void Unbind() const override;
-    virtual uint GetCount() const override { return m_Indicies.size(); }
+    virtual uint GetCount() const override { return m_IndexCount; }
+    virtual BufferMode GetBufferMode() const override { return m_BufferMode; }
 
 private: 
+    BufferMode m_BufferMode;
     uint m_RendererID;
     uint m_VertexCount;
+    uint m_IndexCount;
     std::vector<uint> m_Indicies;
 
 };
@@ -0,0 +1,152 @@
+/* Engine Copyright (c) 2021 Engine Development Team 
+   https://github.com/beaumanvienna/gfxRenderEngine
+
+   Permission is hereby granted, free of charge, to any person
+   obtaining a copy of this software and associated documentation files
+   (the "Software"), to deal in the Software without restriction,
+   including without limitation the rights to use, copy, modify, merge,
+   publish, distribute, sublicense, and/or sell copies of the Software,
+   and to permit persons to whom the Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be
+   included in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+   MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+   CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, 
+   TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE 
+   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
+
+
+#include <algorithm>
+
+#include "GLinstanceBuffer.h"
+#include "GL.h"
+#include "resources.h"
+#include "textureSlotManager.h"
+
+GLInstanceBuffer::GLInstanceBuffer()
+    : m_VertexArrayID(0), m_RendererID(0), m_Capacity(0), m_ShaderFailed(false)
+{
+}
+
+GLInstanceBuffer::~GLInstanceBuffer()
+{
+    if (m_RendererID)
+    {
+        GLCall(glDeleteBuffers(1, &m_RendererID));
+        GLCall(glDeleteVertexArrays(1, &m_VertexArrayID));
+    }
+}
+
+bool GLInstanceBuffer::CreateShader()
+{
+    m_Shader = ShaderProgram::Create();
+    m_Shader->AddShader(ShaderProgram::VERTEX_SHADER, "/text/../engine/shader/instancedVertexShader.vert", IDR_INSTANCED_VERTEX_SHADER, "TEXT");
+    m_Shader->AddShader(ShaderProgram::FRAGMENT_SHADER, "/text/../engine/shader/fragmentShader.frag", IDR_FRAGMENT_SHADER, "TEXT");
+    m_Shader->Build();
+    if (!m_Shader->IsOK())
+    {
+        LOG_CORE_ERROR("GLInstanceBuffer: shader creation failed");
+        m_Shader = nullptr;
+        m_ShaderFailed = true;
+        return false;
+    }
+
+    int textureIDs[TextureSlotManager::MAX_TEXTURE_UNITS];
+    for (uint unit = 0; unit < TextureSlotManager::MAX_TEXTURE_UNITS; unit++)
+    {
+        textureIDs[unit] = unit;
+    }
+    m_Shader->SetUniform1iv("u_Textures", TextureSlotManager::MAX_TEXTURE_UNITS, textureIDs);
+    return true;
+}
+
+// the streams are at offset stream size * capacity, so the attribute pointers change with the capacity
+void GLInstanceBuffer::Resize(uint capacity)
+{
+    if (!m_RendererID)
+    {
+        GLCall(glGenVertexArrays(1, &m_VertexArrayID));
+        GLCall(glGenBuffers(1, &m_RendererID));
+    }
+    m_Capacity = capacity;
+
+    GLCall(glBindVertexArray(m_VertexArrayID));
+    GLCall(glBindBuffer(GL_ARRAY_BUFFER, m_RendererID));
+    GLCall(glBufferData(GL_ARRAY_BUFFER, m_Capacity * INSTANCE_SIZE, nullptr, GL_STREAM_DRAW));
+
+    uint location = 0;
+    uintptr_t offset = 0;
+    for (; location < SpriteInstances::NUMBER_OF_FLOAT_STREAMS; location++)
+    {
+        GLCall(glEnableVertexAttribArray(location));
+        GLCall(glVertexAttribPointer(location, 1, GL_FLOAT, GL_FALSE, sizeof(float), (const void*)offset));
+        GLCall(glVertexAttribDivisor(location, 1));
+        offset += m_Capacity * sizeof(float);
+    }
+
+    // colors, RGBA8
+    GLCall(glEnableVertexAttribArray(location));
+    GLCall(glVertexAttribPointer(location, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(uint), (const void*)offset));
+    GLCall(glVertexAttribDivisor(location, 1));
+    offset += m_Capacity * sizeof(uint);
+    location++;
+
+    // texture indicies
+    GLCall(glEnableVertexAttribArray(location));
+    GLCall(glVertexAttribIPointer(location, 1, GL_UNSIGNED_BYTE, sizeof(uchar), (const void*)offset));
+    GLCall(glVertexAttribDivisor(location, 1));
+}
+
+void GLInstanceBuffer::Draw(const SpriteInstances& instances, const int* textureUnits, const glm::mat4& viewProjectionMatrix)
+{
+    uint count = instances.GetCount();
+    if (!count || m_ShaderFailed)
+    {
+        return;
+    }
+    if (!m_Shader && !CreateShader())
+    {
+        return;
+    }
+
+    if (count > m_Capacity)
+    {
+        // room to grow, for particle systems
+        Resize(std::max(count + count / 2, 1024u));
+    }
+    else
+    {
+        GLCall(glBindVertexArray(m_VertexArrayID));
+        GLCall(glBindBuffer(GL_ARRAY_BUFFER, m_RendererID));
+        // orphan the buffer, the GPU may still read the previous instances
+        GLCall(glBufferData(GL_ARRAY_BUFFER, m_Capacity * INSTANCE_SIZE, nullptr, GL_STREAM_DRAW));
+    }
+
+    uint offset = 0;
+    for (uint stream = 0; stream < SpriteInstances::NUMBER_OF_FLOAT_STREAMS; stream++)
+    {
+        auto data = instances.GetStream(static_cast<SpriteInstances::FloatStream>(stream));
+        GLCall(glBufferSubData(GL_ARRAY_BUFFER, offset, count * sizeof(float), data));
+        offset += m_Capacity * sizeof(float);
+    }
+    GLCall(glBufferSubData(GL_ARRAY_BUFFER, offset, count * sizeof(uint), instances.GetColors()));
+    offset += m_Capacity * sizeof(uint);
+    GLCall(glBufferSubData(GL_ARRAY_BUFFER, offset, count * sizeof(uchar), instances.GetTextureIndicies()));
+
+    int units[SpriteInstances::MAX_TEXTURES] = {};
+    for (uint index = 0; index < instances.GetNumberOfTextures(); index++)
+    {
+        units[index] = textureUnits[index];
+    }
+    m_Shader->Bind();
+    m_Shader->SetUniformMat4f("u_ViewProjectionMatrix", viewProjectionMatrix);
+    m_Shader->SetUniform1iv("u_TextureUnits", SpriteInstances::MAX_TEXTURES, units);
+
+    // four corners per instance, see instancedVertexShader.vert
+    GLCall(glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, count));
+}
@@ -0,0 +1,61 @@
+/* Engine Copyright (c) 2021 Engine Development Team 
+   https://github.com/beaumanvienna/gfxRenderEngine
+
+   Permission is hereby granted, free of charge, to any person
+   obtaining a copy of this software and associated documentation files
+   (the "Software"), to deal in the Software without restriction,
+   including without limitation the rights to use, copy, modify, merge,
+   publish, distribute, sublicense, and/or sell copies of the Software,
+   and to permit persons to whom the Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be
+   included in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+   MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+   CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, 
+   TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE 
+   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
+
+
+#pragma once
+
+#include <memory>
+
+#include "engine.h"
+#include "buffer.h"
+#include "shader.h"
+#include "spriteInstances.h"
+
+// the streams of SpriteInstances one after the other in a vbo, read once per instance
+// (attribute divisor 1) by instancedVertexShader.vert, which has a shader program of its own
+class GLInstanceBuffer : public InstanceBuffer
+{
+
+public:
+
+    GLInstanceBuffer();
+    ~GLInstanceBuffer() override;
+
+    virtual void Draw(const SpriteInstances& instances, const int* textureUnits, const glm::mat4& viewProjectionMatrix) override;
+
+private:
+
+    bool CreateShader();
+    void Resize(uint capacity);
+
+private:
+
+    // bytes per instance
+    static constexpr uint INSTANCE_SIZE = SpriteInstances::NUMBER_OF_FLOAT_STREAMS * sizeof(float) + sizeof(uint) + sizeof(uchar);
+
+    uint m_VertexArrayID;
+    uint m_RendererID;
+    uint m_Capacity; // number of instances
+    std::shared_ptr<ShaderProgram> m_Shader;
+    bool m_ShaderFailed;
+
+};
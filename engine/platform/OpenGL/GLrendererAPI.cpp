@@ -76,18 +76,30 @@ void GLRendererAPI::DisableDethTesting() const
 
 void GLRendererAPI::DrawIndexed(const std::shared_ptr<VertexArray>& vertexArray) const
 {
-    auto indexBuffers = vertexArray->GetIndexBuffers();
+    auto& vertexBuffers = vertexArray->GetVertexBuffers();
+    auto& indexBuffers = vertexArray->GetIndexBuffers();
+
+    // upload staged verticies (streaming mode)
+    vertexBuffers[0]->EndScene();
 
     // bind & write index buffer
     indexBuffers[0]->EndScene();
 
+    uint count = indexBuffers[0]->GetCount();
+    if (!count) return;
+
     // the actual draw call
-    GLCall(glDrawElements
+    GLCall(glDrawElementsBaseVertex
     (
-        GL_TRIANGLES,                 /* mode */
-        indexBuffers[0]->GetCount(),  /* count */
-        GL_UNSIGNED_INT,              /* type */
-        (void*)0                      /* element array buffer offset */
+        GL_TRIANGLES,                       /* mode */
+        count,                              /* count */
+        GL_UNSIGNED_INT,                    /* type */
+        (void*)0,                           /* element array buffer offset */
+        vertexBuffers[0]->GetBaseVertex()   /* offset added to each index */
     ));
 }
-    
+
+void GLRendererAPI::Finish() const
+{
+    GLCall(glFinish());
+}
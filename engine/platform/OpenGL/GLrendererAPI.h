@@ -42,5 +42,6 @@ public:
     virtual void SetScissor(int left, int bottom, int width, int height) const override;
 
     virtual void DrawIndexed(const std::shared_ptr<VertexArray>& vertexArray) const override;
+    virtual void Finish() const override;
     
 };
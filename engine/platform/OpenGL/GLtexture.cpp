@@ -29,13 +29,18 @@
 
 GLTexture::GLTexture()
     : m_FileName(""), m_RendererID(0), m_LocalBuffer(nullptr), 
-      m_Width(0), m_Height(0), m_BytesPerPixel(0), m_InternalFormat(0), m_DataFormat(0)
+      m_Width(0), m_Height(0), m_BytesPerPixel(0), m_InternalFormat(0), m_DataFormat(0),
+      m_Placeholder(false)
 {
     m_TextureSlot = -1;
 }
 
 GLTexture::~GLTexture()
 {
+    if (Engine::m_TextureManager)
+    {
+        Engine::m_TextureManager->Cancel(this);
+    }
     if (m_TextureSlot > -1)
     {
         Engine::m_TextureSlotManager->RemoveTextureSlot(m_TextureSlot);
@@ -50,6 +55,7 @@ GLTexture::GLTexture(uint ID, int internalFormat, int dataFormat, int type)
     m_InternalFormat = internalFormat;
     m_DataFormat = dataFormat;
     m_Type = type;
+    m_Placeholder = false;
 }
 
 // create texture from raw memory
@@ -90,7 +96,6 @@ bool GLTexture::Init(const uint width, const uint height, const void* data)
             GL_UNSIGNED_BYTE,    /* GLenum type,          */
             m_LocalBuffer        /* const void * data);   */
         ));
-        Unbind();
     }
     return ok;
 }
@@ -99,16 +104,28 @@ bool GLTexture::Init(const uint width, const uint height, const void* data)
 bool GLTexture::Init(const std::string& fileName)
 {
     bool ok = false;
-    int channels_in_file;
-    stbi_set_flip_vertically_on_load(true);
     m_FileName = fileName;
-    m_LocalBuffer = stbi_load(m_FileName.c_str(), &m_Width, &m_Height, &m_BytesPerPixel, 4);
 
-    if(m_LocalBuffer)
+    if (Engine::m_TextureManager)
     {
-        ok = Create();
+        // decoded on a worker thread, the texture manager uploads it later
+        if (Engine::m_TextureManager->Load(this, m_FileName, m_Width, m_Height))
+        {
+            ok = Create(nullptr);
+        }
     }
     else
+    {
+        stbi_set_flip_vertically_on_load(true);
+        m_LocalBuffer = stbi_load(m_FileName.c_str(), &m_Width, &m_Height, &m_BytesPerPixel, 4);
+        if (m_LocalBuffer)
+        {
+            ok = Create(m_LocalBuffer);
+            stbi_image_free(m_LocalBuffer);
+        }
+    }
+
+    if (!ok)
     {
         std::cout << "Texture: Couldn't load file " << m_FileName << std::endl;
     }
@@ -119,16 +136,27 @@ bool GLTexture::Init(const std::string& fileName)
 bool GLTexture::Init(const unsigned char* data, int length)
 {
     bool ok = false;
-    int channels_in_file;
-    stbi_set_flip_vertically_on_load(true);
     m_FileName = "file in memory";
-    m_LocalBuffer = stbi_load_from_memory(data, length, &m_Width, &m_Height, &m_BytesPerPixel, 4);
 
-    if(m_LocalBuffer)
+    if (Engine::m_TextureManager)
     {
-        ok = Create();
+        if (Engine::m_TextureManager->Load(this, data, length, m_Width, m_Height))
+        {
+            ok = Create(nullptr);
+        }
     }
     else
+    {
+        stbi_set_flip_vertically_on_load(true);
+        m_LocalBuffer = stbi_load_from_memory(data, length, &m_Width, &m_Height, &m_BytesPerPixel, 4);
+        if (m_LocalBuffer)
+        {
+            ok = Create(m_LocalBuffer);
+            stbi_image_free(m_LocalBuffer);
+        }
+    }
+
+    if (!ok)
     {
         std::cout << "Texture: Couldn't load file " << m_FileName << std::endl;
     }
@@ -146,7 +174,9 @@ bool GLTexture::Init(const uint width, const uint height, const uint rendererID)
     return true;
 }
 
-bool GLTexture::Create()
+// images are always decoded to RGBA, a null pointer creates
+// a transparent placeholder and leaves the image to be blitted later
+bool GLTexture::Create(const void* data)
 {
     m_TextureSlot = Engine::m_TextureSlotManager->GetTextureSlot();
     GLCall(glGenTextures(1, &m_RendererID));
@@ -157,27 +187,17 @@ bool GLTexture::Create()
     GLCall(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE));
     GLCall(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE));
     
-    GLenum internalFormat = 0, dataFormat = 0;
-    if (m_BytesPerPixel == 4)
-    {
-        internalFormat = GL_RGBA8;
-        dataFormat = GL_RGBA;
-    }
-    else if (m_BytesPerPixel == 3)
-    {
-        internalFormat = GL_RGB8;
-        dataFormat = GL_RGBA; // GL_RGB did not work with resources/splashscreen/splash_spritesheet2.png
-    }
-    else
+    m_BytesPerPixel = 4;
+    m_InternalFormat = GL_RGBA8;
+    m_DataFormat = GL_RGBA;
+    m_Type = GL_UNSIGNED_BYTE;
+
+    if (!data)
     {
-        LOG_CORE_CRITICAL("data format for {0} not supported", m_FileName);
+        AllocatePlaceholder();
+        return true;
     }
-    ASSERT(internalFormat && dataFormat);
-
-    m_InternalFormat = internalFormat;
-    m_DataFormat = dataFormat;
     
-    const int BITS_PER_CHANNEL = 8;
     GLCall(glTexImage2D
     (
         GL_TEXTURE_2D,       /* GLenum target,        */
@@ -187,28 +207,55 @@ bool GLTexture::Create()
         m_Height,            /* GLsizei height,       */
         0,                   /* GLint border,         */
         m_DataFormat,        /* GLenum format,        */
-        GL_UNSIGNED_BYTE,    /* GLenum type,          */
-        m_LocalBuffer        /* const void* data);    */
+        m_Type,              /* GLenum type,          */
+        data                 /* const void* data);    */
     ));
-    Unbind();    
-    //free local buffer
-    stbi_image_free(m_LocalBuffer);
     return true;
 }
 
+// a single pixel samples the same at any texture coordinate, and
+// the full size isn't allocated for an image that may never arrive
+void GLTexture::AllocatePlaceholder()
+{
+    static const uint transparent = 0;
+    m_Placeholder = true;
+
+    GLCall(glTexImage2D
+    (
+        GL_TEXTURE_2D,       /* GLenum target,        */
+        0,                   /* GLint level,          */
+        m_InternalFormat,    /* GLint internalformat, */
+        1,                   /* GLsizei width,        */
+        1,                   /* GLsizei height,       */
+        0,                   /* GLint border,         */
+        GL_RGBA,             /* GLenum format,        */
+        GL_UNSIGNED_BYTE,    /* GLenum type,          */
+        &transparent         /* const void* data);    */
+    ));
+}
+
+// the texture slot manager only issues GL calls if the texture is not resident
 void GLTexture::Bind() const
 {
-    GLCall(glActiveTexture(GL_TEXTURE0 + m_TextureSlot));
-    GLCall(glBindTexture(GL_TEXTURE_2D, m_RendererID));
+    Engine::m_TextureSlotManager->BindTexture(m_TextureSlot, m_RendererID);
+}
+
+int GLTexture::BindToBatch() const
+{
+    return Engine::m_TextureSlotManager->PinTexture(m_TextureSlot, m_RendererID);
 }
 
 void GLTexture::Unbind() const
 {
-    GLCall(glBindTexture(GL_TEXTURE_2D, INVALID_ID));
+    Engine::m_TextureSlotManager->UnbindTexture(m_TextureSlot);
 }
 
 void GLTexture::Blit(uint x, uint y, uint width, uint height, uint bytesPerPixel, const void* data)
 {
+    if (m_Placeholder)
+    {
+        Resize(m_Width, m_Height);
+    }
     Bind();
     m_BytesPerPixel = bytesPerPixel;
 
@@ -238,11 +285,14 @@ void GLTexture::Blit(uint x, uint y, uint width, uint height, uint bytesPerPixel
         GL_UNSIGNED_BYTE,    /* GLenum type,         */
         data                 /* const void* pixels   */
     ));
-    Unbind();
 }
 
 void GLTexture::Blit(uint x, uint y, uint width, uint height, int dataFormat, int type, const void* data)
 {
+    if (m_Placeholder)
+    {
+        Resize(m_Width, m_Height);
+    }
     Bind();
 
     m_DataFormat = dataFormat;
@@ -260,7 +310,6 @@ void GLTexture::Blit(uint x, uint y, uint width, uint height, int dataFormat, in
         m_Type,              /* GLenum type,         */
         data                 /* const void* pixels   */
     ));
-    Unbind();
 }
 
 void GLTexture::Resize(uint width, uint height)
@@ -269,6 +318,7 @@ void GLTexture::Resize(uint width, uint height)
 
     m_Width = width;
     m_Height = height;
+    m_Placeholder = false;
     
     GLCall(glTexImage2D
     (
@@ -282,6 +332,5 @@ void GLTexture::Resize(uint width, uint height)
         m_Type,              /* GLenum type,          */
         nullptr              /* const void* data);    */
     ));
-    Unbind(); 
 
 }
@@ -38,6 +38,7 @@ public:
     virtual bool Init(const unsigned char* data, int length) override;
     virtual bool Init(const uint width, const uint height, const uint rendererID) override;
     virtual void Bind() const override;
+    virtual int BindToBatch() const override;
     virtual void Unbind() const override;
     virtual int GetWidth() const override { return m_Width; }
     virtual int GetHeight() const override { return m_Height; }
@@ -47,7 +48,8 @@ public:
     virtual void Blit(uint x, uint y, uint width, uint height, int dataFormat, int type, const void* data) override;
 
 private:
-    bool Create();
+    bool Create(const void* data);
+    void AllocatePlaceholder();
 
 private:
 
@@ -59,5 +61,8 @@ private:
     
     GLenum m_InternalFormat, m_DataFormat;
     GLenum m_Type;
+
+    // 1x1 storage until the image is blitted, m_Width and m_Height are the image's size
+    bool m_Placeholder;
     
 };
@@ -20,36 +20,185 @@
    TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE 
    SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
 
+#include <algorithm>
+
 #include "GLtextureSlotManager.h"
 #include "GL.h"
 
 GLTextureSlotManager::GLTextureSlotManager()
+    : m_ActiveUnit(NO_UNIT), m_PinnedUnits(0), m_UseCounter(0)
 {
     GLint maxTextureSlots;
     GLCall(glGetIntegerv(GL_MAX_TEXTURE_IMAGE_UNITS, &maxTextureSlots));
-    m_TextureSlots.resize(maxTextureSlots);
-    for(auto slot : m_TextureSlots)
+    m_TextureUnits.resize(std::min(static_cast<uint>(maxTextureSlots), MAX_TEXTURE_UNITS));
+}
+
+uint GLTextureSlotManager::GetTextureSlot()
+{
+    uint slot;
+    if (m_FreeSlots.size())
     {
-        slot = false;
+        slot = m_FreeSlots.back();
+        m_FreeSlots.pop_back();
     }
+    else
+    {
+        slot = m_Residency.size();
+        m_Residency.push_back(NO_UNIT);
+    }
+    return slot;
 }
 
-uint GLTextureSlotManager::GetTextureSlot()
+void GLTextureSlotManager::RemoveTextureSlot(uint slot)
 {
-    uint textureSlot = 0;
-    for(auto slot : m_TextureSlots)
+    // the texture gets deleted, GL unbinds it from its unit
+    int unit = m_Residency[slot];
+    if (unit != NO_UNIT)
     {
-        if(!slot)
+        if (m_TextureUnits[unit].m_Pinned)
         {
-            slot = true;
-            break;
+            m_PinnedUnits--;
         }
-        textureSlot++;
+        m_TextureUnits[unit] = TextureUnit();
+        m_Residency[slot] = NO_UNIT;
     }
-    return textureSlot;
+    m_FreeSlots.push_back(slot);
 }
 
-void GLTextureSlotManager::RemoveTextureSlot(uint slot)
+// prefers an empty texture unit, otherwise the least recently used one,
+// pinned texture units are never evicted
+int GLTextureSlotManager::FindTextureUnit() const
+{
+    int unit = NO_UNIT;
+    uint64 lastUse = UINT64_MAX;
+    for (uint index = 0; index < m_TextureUnits.size(); index++)
+    {
+        const TextureUnit& textureUnit = m_TextureUnits[index];
+        if (textureUnit.m_Pinned)
+        {
+            continue;
+        }
+        if (textureUnit.m_Slot == NO_SLOT)
+        {
+            return index;
+        }
+        if (textureUnit.m_LastUse < lastUse)
+        {
+            lastUse = textureUnit.m_LastUse;
+            unit = index;
+        }
+    }
+    return unit;
+}
+
+uint GLTextureSlotManager::Bind(uint slot, uint rendererID, uint unit)
+{
+    TextureUnit& textureUnit = m_TextureUnits[unit];
+    if (textureUnit.m_Slot != NO_SLOT)
+    {
+        m_Residency[textureUnit.m_Slot] = NO_UNIT;
+        m_Statistics.m_Evictions++;
+    }
+
+    ActivateTextureUnit(unit);
+    GLCall(glBindTexture(GL_TEXTURE_2D, rendererID));
+    m_Statistics.m_Binds++;
+
+    textureUnit.m_Slot = slot;
+    textureUnit.m_RendererID = rendererID;
+    textureUnit.m_Pinned = false;
+    m_Residency[slot] = unit;
+    return unit;
+}
+
+uint GLTextureSlotManager::BindTexture(uint slot, uint rendererID)
+{
+    int unit = m_Residency[slot];
+    if (unit == NO_UNIT)
+    {
+        unit = Bind(slot, rendererID, FindTextureUnit());
+    }
+    else
+    {
+        ActivateTextureUnit(unit);
+    }
+    m_TextureUnits[unit].m_LastUse = ++m_UseCounter;
+    return unit;
+}
+
+int GLTextureSlotManager::PinTexture(uint slot, uint rendererID)
+{
+    int unit = m_Residency[slot];
+    if ((unit != NO_UNIT) && m_TextureUnits[unit].m_Pinned)
+    {
+        m_TextureUnits[unit].m_LastUse = ++m_UseCounter;
+        return unit;
+    }
+
+    // one texture unit always stays available for uploads
+    if (m_PinnedUnits == m_TextureUnits.size() - 1)
+    {
+        return NO_UNIT;
+    }
+
+    if (unit == NO_UNIT)
+    {
+        unit = Bind(slot, rendererID, FindTextureUnit());
+    }
+    TextureUnit& textureUnit = m_TextureUnits[unit];
+    textureUnit.m_LastUse = ++m_UseCounter;
+    textureUnit.m_Pinned = true;
+    m_PinnedUnits++;
+    return unit;
+}
+
+void GLTextureSlotManager::UnpinAll()
+{
+    for (auto& textureUnit : m_TextureUnits)
+    {
+        textureUnit.m_Pinned = false;
+    }
+    m_PinnedUnits = 0;
+}
+
+void GLTextureSlotManager::UnbindTexture(uint slot)
+{
+    int unit = m_Residency[slot];
+    if ((unit == NO_UNIT) || m_TextureUnits[unit].m_Pinned)
+    {
+        return;
+    }
+    ActivateTextureUnit(unit);
+    GLCall(glBindTexture(GL_TEXTURE_2D, INVALID_ID));
+    m_TextureUnits[unit] = TextureUnit();
+    m_Residency[slot] = NO_UNIT;
+}
+
+void GLTextureSlotManager::RestoreBindings()
+{
+    m_ActiveUnit = NO_UNIT;
+    for (uint unit = 0; unit < m_TextureUnits.size(); unit++)
+    {
+        if (m_TextureUnits[unit].m_Slot != NO_SLOT)
+        {
+            ActivateTextureUnit(unit);
+            GLCall(glBindTexture(GL_TEXTURE_2D, m_TextureUnits[unit].m_RendererID));
+            m_Statistics.m_Binds++;
+        }
+    }
+}
+
+void GLTextureSlotManager::ActivateTextureUnit(uint unit)
+{
+    if (m_ActiveUnit != static_cast<int>(unit))
+    {
+        GLCall(glActiveTexture(GL_TEXTURE0 + unit));
+        m_ActiveUnit = unit;
+    }
+}
+
+void GLTextureSlotManager::EndFrame()
 {
-    m_TextureSlots[slot] = false;
+    m_LastFrameStatistics = m_Statistics;
+    m_Statistics = Statistics();
 }
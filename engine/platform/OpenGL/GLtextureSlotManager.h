@@ -35,9 +35,46 @@ public:
 
     virtual uint GetTextureSlot() override;
     virtual void RemoveTextureSlot(uint slot) override;
+    virtual uint GetNumberOfTextureSlots() const override { return m_TextureUnits.size(); }
+
+    virtual uint BindTexture(uint slot, uint rendererID) override;
+    virtual int  PinTexture(uint slot, uint rendererID) override;
+    virtual void UnpinAll() override;
+    virtual void UnbindTexture(uint slot) override;
+    virtual void RestoreBindings() override;
+
+    virtual void EndFrame() override;
+    virtual const Statistics& GetStatistics() const override { return m_LastFrameStatistics; }
+
+private:
+
+    struct TextureUnit
+    {
+        int    m_Slot = NO_SLOT;
+        uint   m_RendererID = 0;
+        uint64 m_LastUse = 0;
+        bool   m_Pinned = false;
+    };
 
 private:
 
-    std::vector<bool> m_TextureSlots; 
+    int  FindTextureUnit() const;
+    uint Bind(uint slot, uint rendererID, uint unit);
+    void ActivateTextureUnit(uint unit);
+
+private:
+
+    static constexpr int NO_SLOT = -1;
+    static constexpr int NO_UNIT = -1;
+
+    std::vector<TextureUnit> m_TextureUnits;  // hardware texture units
+    std::vector<int> m_Residency;             // virtual slot -> texture unit
+    std::vector<uint> m_FreeSlots;            // recycled virtual slots
+    int m_ActiveUnit;
+    uint m_PinnedUnits;
+    uint64 m_UseCounter;
+
+    Statistics m_Statistics;
+    Statistics m_LastFrameStatistics;
 
 };
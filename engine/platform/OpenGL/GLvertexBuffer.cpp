@@ -20,33 +20,118 @@
    TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE 
    SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
 
+#include <cstring>
+
 #include "GLvertexBuffer.h"
 #include "GL.h"
 
+GLVertexBuffer::GLVertexBuffer(BufferMode bufferMode)
+    : m_BufferMode(bufferMode), m_RendererID(0), m_BufferOffset(0),
+      m_Capacity(0), m_BaseVertex(0), m_DroppedBytes(0), m_PersistentMapping(nullptr),
+      m_RingSection(0), m_RingOffset(0)
+{
+    for (auto& fence : m_Fences)
+    {
+        fence = nullptr;
+    }
+}
 
 GLVertexBuffer::~GLVertexBuffer()
 {
+    for (auto& fence : m_Fences)
+    {
+        if (fence)
+        {
+            GLCall(glDeleteSync(fence));
+        }
+    }
+    if (m_PersistentMapping)
+    {
+        Bind();
+        GLCall(glUnmapBuffer(GL_ARRAY_BUFFER));
+    }
     GLCall(glDeleteBuffers(1,&m_RendererID));
 }
 
 void GLVertexBuffer::Create(uint count)
 {
-    uint size = m_Layout.GetStride() * count;
+    m_Capacity = m_Layout.GetStride() * count;
+    if (m_BufferMode == BUFFER_MODE_STREAMING)
+    {
+        CreateStreamingBuffer();
+        return;
+    }
+
     GLCall(glGenBuffers(1, &m_RendererID));
     Bind();
     // load data into vbo
     GLCall(glBufferData
     (
         GL_ARRAY_BUFFER,                /* target */
-        size,                           /* buffer size */
+        m_Capacity,                     /* buffer size */
         nullptr,                        /* empty for now */
         GL_DYNAMIC_DRAW                 /* usage */
     ));
-    uint m_BuferOffset = 0;
+    m_BufferOffset = 0;
+}
+
+// one vbo holding RING_SECTIONS copies of the vertex capacity,
+// persistently mapped if the driver supports ARB_buffer_storage
+void GLVertexBuffer::CreateStreamingBuffer()
+{
+    uint size = m_Capacity * RING_SECTIONS;
+    m_Staging.resize(m_Capacity);
+    m_BufferOffset = 0;
+    m_RingSection = 0;
+    m_RingOffset = 0;
+
+    GLCall(glGenBuffers(1, &m_RendererID));
+    Bind();
+    if (GLEW_ARB_buffer_storage)
+    {
+        GLbitfield mapFlags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+        GLCall(glBufferStorage
+        (
+            GL_ARRAY_BUFFER,                    /* target */
+            size,                               /* buffer size */
+            nullptr,                            /* empty for now */
+            mapFlags | GL_DYNAMIC_STORAGE_BIT   /* flags */
+        ));
+        GLCall(m_PersistentMapping = (uchar*)glMapBufferRange(GL_ARRAY_BUFFER, 0, size, mapFlags));
+        if (!m_PersistentMapping)
+        {
+            LOG_CORE_WARN("GLVertexBuffer: could not map streaming buffer persistently");
+        }
+    }
+    else
+    {
+        GLCall(glBufferData
+        (
+            GL_ARRAY_BUFFER,                /* target */
+            size,                           /* buffer size */
+            nullptr,                        /* empty for now */
+            GL_STREAM_DRAW                  /* usage */
+        ));
+    }
 }
 
 void GLVertexBuffer::LoadBuffer(const void* verticies, uint size)
 {
+    if ((m_BufferOffset + size) > m_Capacity)
+    {
+        // reported once per draw call in EndScene()
+        m_DroppedBytes += size;
+        return;
+    }
+
+    if (m_BufferMode == BUFFER_MODE_STREAMING)
+    {
+        // staged on the CPU, uploaded in EndScene()
+        memcpy(&m_Staging[m_BufferOffset], verticies, size);
+        m_BufferOffset += size;
+        return;
+    }
+
     Bind();
     // load data into vbo
     GLCall(glBufferSubData
@@ -60,6 +145,72 @@ void GLVertexBuffer::LoadBuffer(const void* verticies, uint size)
     m_BufferOffset += size;
 }
 
+// called once per draw call: uploads all verticies
+// staged since BeginScene() into the ring buffer
+void GLVertexBuffer::EndScene()
+{
+    if (m_DroppedBytes)
+    {
+        LOG_CORE_ERROR("GLVertexBuffer: vertex buffer overflow, {0} verticies were dropped (capacity {1})", m_DroppedBytes / m_Layout.GetStride(), GetCapacity());
+    }
+
+    if ((m_BufferMode != BUFFER_MODE_STREAMING) || !m_BufferOffset)
+    {
+        return;
+    }
+
+    if ((m_RingOffset + m_BufferOffset) > ((m_RingSection + 1) * m_Capacity))
+    {
+        NextRingSection();
+    }
+
+    if (m_PersistentMapping)
+    {
+        memcpy(m_PersistentMapping + m_RingOffset, m_Staging.data(), m_BufferOffset);
+    }
+    else
+    {
+        Bind();
+        // the fences guarantee that the GPU is not reading this range
+        GLbitfield access = GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT;
+        GLCall(void* destination = glMapBufferRange(GL_ARRAY_BUFFER, m_RingOffset, m_BufferOffset, access));
+        if (destination)
+        {
+            memcpy(destination, m_Staging.data(), m_BufferOffset);
+            GLCall(glUnmapBuffer(GL_ARRAY_BUFFER));
+        }
+    }
+
+    m_BaseVertex = m_RingOffset / m_Layout.GetStride();
+    m_RingOffset += m_BufferOffset;
+}
+
+void GLVertexBuffer::NextRingSection()
+{
+    // fence the section the GPU might still be reading from
+    GLCall(m_Fences[m_RingSection] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0));
+
+    m_RingSection = (m_RingSection + 1) % RING_SECTIONS;
+    m_RingOffset  = m_RingSection * m_Capacity;
+
+    GLsync& fence = m_Fences[m_RingSection];
+    if (fence)
+    {
+        const GLuint64 ONE_MILLISECOND = 1000000;
+        GLenum result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 0);
+        while (result == GL_TIMEOUT_EXPIRED)
+        {
+            result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, ONE_MILLISECOND);
+        }
+        if (result == GL_WAIT_FAILED)
+        {
+            LOG_CORE_ERROR("GLVertexBuffer: glClientWaitSync failed");
+        }
+        GLCall(glDeleteSync(fence));
+        fence = nullptr;
+    }
+}
+
 void GLVertexBuffer::Bind() const
 {
      GLCall(glBindBuffer(GL_ARRAY_BUFFER, m_RendererID));
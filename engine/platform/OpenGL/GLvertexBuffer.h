@@ -22,9 +22,12 @@
 
 #pragma once
 
+#include <vector>
+
 #include "engine.h"
 #include "buffer.h"
 #include "vertexBufferLayout.h"
+#include "GL.h"
 
 class GLVertexBuffer : public VertexBuffer
 {
@@ -46,21 +49,45 @@ public:
      * 
     */
     
+    GLVertexBuffer(BufferMode bufferMode = BUFFER_MODE_STREAMING);
     ~GLVertexBuffer() override;
     
     virtual void Create(uint count) override;
     virtual void LoadBuffer(const void* verticies, uint size) override;
-    virtual void BeginScene() override { m_BufferOffset = 0; }
+    virtual void BeginScene() override { m_BufferOffset = 0; m_DroppedBytes = 0; }
+    virtual void EndScene() override;
     virtual void Bind() const override;
     virtual void Unbind() const override;
+    virtual uint GetBaseVertex() const override { return m_BaseVertex; }
+    virtual uint GetCapacity() const override { return m_Capacity / m_Layout.GetStride(); }
+    virtual BufferMode GetBufferMode() const override { return m_BufferMode; }
     
     virtual const VertexBufferLayout& GetLayout() const override { return m_Layout; }
     virtual void SetLayout(const VertexBufferLayout& layout) override { m_Layout = layout; }
-    
-private: 
 
+private:
+
+    void CreateStreamingBuffer();
+    void NextRingSection();
+
+private:
+
+    // number of ring buffer sections the GPU may still be reading from
+    static constexpr uint RING_SECTIONS = 3;
+
+    BufferMode m_BufferMode;
     uint m_RendererID;
     uint m_BufferOffset;
+    uint m_Capacity;
+    uint m_BaseVertex;
+    uint m_DroppedBytes;
+
+    // streaming mode
+    std::vector<uchar> m_Staging;
+    uchar* m_PersistentMapping;
+    uint m_RingSection;
+    uint m_RingOffset;
+    GLsync m_Fences[RING_SECTIONS];
     
     VertexBufferLayout m_Layout;
 
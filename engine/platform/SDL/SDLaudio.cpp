@@ -27,16 +27,27 @@
 
 #include <iostream>
 
+#include "core.h"
 #include "SDLaudio.h"
 #include "SDL.h"
 #include "resources.h"
 
+SDLAudio::SDLAudio()
+    : m_CacheSize(0), m_StartCounter(0), m_AudioOpen(false)
+{
+}
+
 void SDLAudio::Start()
 {
+    // no audio device is needed for a headless run
+    if (Engine::m_Engine && Engine::m_Engine->IsHeadless())
+    {
+        SDL_setenv("SDL_AUDIODRIVER", "dummy", true);
+    }
     SDL_InitSubSystem(SDL_INIT_AUDIO);
 
     // Set up the audio stream
-    int result = Mix_OpenAudio(44100, AUDIO_S16SYS, SOUND_CHANNELS, 512);
+    int result = Mix_OpenAudio(44100, AUDIO_S16SYS, MIX_DEFAULT_CHANNELS, 512);
     if( result < 0 )
     {
         std::string errorMessage = SDL_GetError();
@@ -44,66 +55,179 @@ void SDLAudio::Start()
         return;
     }
 
-    result = Mix_AllocateChannels(4);
+    result = Mix_AllocateChannels(NUMBER_OF_VOICES);
     if( result < 0 )
     {
         std::string errorMessage = SDL_GetError();
         LOG_CORE_WARN("Unable to allocate mixing channels: {0}", errorMessage);
         return;
     }
+    m_Voices.assign(result, {nullptr, 0});
+    m_AudioOpen = true;
 }
 
 void SDLAudio::Stop()
 {
-    for( int i = 0; i < SOUND_CHANNELS; i++ )
-    {
-        Mix_FreeChunk(m_DataBuffer[i]);
-    }
+    Mix_HaltChannel(-1);
+    m_Voices.clear();
+    ClearCache();
 
     Mix_CloseAudio();
     SDL_QuitSubSystem(SDL_INIT_AUDIO);
+    m_AudioOpen = false;
 }
 
 void SDLAudio::PlaySound(const std::string& filename)
 {
-    memset(m_DataBuffer, 0, sizeof(Mix_Chunk*) * SOUND_CHANNELS);
+    Mix_Chunk* chunk = GetChunk(filename, [&]() { return LoadFile(filename); });
+    Play(chunk);
+}
+
+void SDLAudio::PlaySound(const char* path, int resourceID, const std::string& resourceClass)
+{
+    Mix_Chunk* chunk = GetChunk(path, [&]() { return LoadResource(path, resourceID, resourceClass); });
+    Play(chunk);
+}
+
+void SDLAudio::Preload(const std::string& filename)
+{
+    GetChunk(filename, [&]() { return LoadFile(filename); });
+}
+
+void SDLAudio::Preload(const char* path, int resourceID, const std::string& resourceClass)
+{
+    GetChunk(path, [&]() { return LoadResource(path, resourceID, resourceClass); });
+}
 
-    // load sound file from disk
-    for (int i = 0; i < SOUND_CHANNELS; i++)
+void SDLAudio::ClearCache()
+{
+    for (auto& voice : m_Voices)
     {
-        m_DataBuffer[i] = Mix_LoadWAV(filename.c_str());
-        if (m_DataBuffer[i] == nullptr)
-        {
-            LOG_CORE_WARN("SDLAudio::PlaySound: Unable to load sound file: {0}, Mix_GetError(): {1}", filename, Mix_GetError());
-            return;
-        }
+        voice.m_Chunk = nullptr;
     }
-    Mix_PlayChannel(-1, m_DataBuffer[0], 0);
+    Mix_HaltChannel(-1);
+
+    for (auto& cachedSound : m_Cache)
+    {
+        Mix_FreeChunk(cachedSound.second.m_Chunk);
+    }
+    m_Cache.clear();
+    m_LRU.clear();
+    m_CacheSize = 0;
 }
 
-void SDLAudio::PlaySound(const char* path, int resourceID, const std::string& resourceClass)
+// returns the decoded sound for a key, decodes it only on a cache miss
+Mix_Chunk* SDLAudio::GetChunk(const std::string& key, const std::function<Mix_Chunk*()>& decode)
 {
-    memset(m_DataBuffer, 0, sizeof(Mix_Chunk*) * SOUND_CHANNELS);
+    if (!m_AudioOpen)
+    {
+        return nullptr;
+    }
+
+    auto it = m_Cache.find(key);
+    if (it != m_Cache.end())
+    {
+        m_LRU.splice(m_LRU.begin(), m_LRU, it->second.m_LRUPosition);
+        return it->second.m_Chunk;
+    }
+
+    Mix_Chunk* chunk = decode();
+    if (chunk)
+    {
+        m_LRU.push_front(key);
+        m_Cache[key] = {chunk, m_LRU.begin()};
+        m_CacheSize += chunk->alen;
+        EvictToBudget();
+    }
+    return chunk;
+}
 
+Mix_Chunk* SDLAudio::LoadFile(const std::string& filename)
+{
+    Mix_Chunk* chunk = Mix_LoadWAV(filename.c_str());
+    if (chunk == nullptr)
+    {
+        LOG_CORE_WARN("SDLAudio::PlaySound: Unable to load sound file: {0}, Mix_GetError(): {1}", filename, Mix_GetError());
+    }
+    return chunk;
+}
+
+Mix_Chunk* SDLAudio::LoadResource(const char* path, int resourceID, const std::string& resourceClass)
+{
     // load file from memory
     size_t fileSize;
     void* data = (void*)ResourceSystem::GetDataPointer(fileSize, path, resourceID, resourceClass);
 
-    for (int i = 0; i < SOUND_CHANNELS; i++)
+    SDL_RWops* sdlRWOps = SDL_RWFromMem(data, fileSize);
+    if (!sdlRWOps)
+    {
+        LOG_CORE_WARN("SDLAudio::PlaySound: Resource '{0}' not found", path);
+        return nullptr;
+    }
+
+    Mix_Chunk* chunk = Mix_LoadWAV_RW(sdlRWOps, 1 /* free sdlRWOps */);
+    if (chunk == nullptr)
     {
-        SDL_RWops* sdlRWOps = SDL_RWFromMem(data, fileSize);
-        if (!sdlRWOps)
+        LOG_CORE_WARN("SDLAudio::PlaySound: Unable to load sound file: {0}, Mix_GetError(): {1}", path, Mix_GetError());
+    }
+    return chunk;
+}
+
+// plays on a free voice, or takes over the voice that started first
+void SDLAudio::Play(Mix_Chunk* chunk)
+{
+    if (!chunk || m_Voices.empty())
+    {
+        return;
+    }
+
+    int channel = 0;
+    for (int voice = 0; voice < static_cast<int>(m_Voices.size()); voice++)
+    {
+        if (!Mix_Playing(voice))
+        {
+            channel = voice;
+            break;
+        }
+        if (m_Voices[voice].m_StartOrder < m_Voices[channel].m_StartOrder)
+        {
+            channel = voice;
+        }
+    }
+
+    m_Voices[channel] = {chunk, ++m_StartCounter};
+    Mix_PlayChannel(channel, chunk, 0);
+}
+
+bool SDLAudio::IsPlaying(Mix_Chunk* chunk) const
+{
+    for (int voice = 0; voice < static_cast<int>(m_Voices.size()); voice++)
+    {
+        if ((m_Voices[voice].m_Chunk == chunk) && Mix_Playing(voice))
         {
-            LOG_CORE_WARN("SDLAudio::PlaySound: Resource '{0}' not found", path);
-            return; 
+            return true;
         }
+    }
+    return false;
+}
 
-        m_DataBuffer[i] = Mix_LoadWAV_RW(sdlRWOps, 0);
-        if (m_DataBuffer[i] == nullptr)
+// frees least recently used sounds until the cache fits into its budget,
+// sounds that are still playing and the most recent one are kept
+void SDLAudio::EvictToBudget()
+{
+    auto it = std::prev(m_LRU.end());
+    while ((m_CacheSize > SOUND_CACHE_BUDGET) && (it != m_LRU.begin()))
+    {
+        Mix_Chunk* chunk = m_Cache[*it].m_Chunk;
+        if (IsPlaying(chunk))
         {
-            LOG_CORE_WARN("SDLAudio::PlaySound: Unable to load sound file: {0}, Mix_GetError(): {1}", path, Mix_GetError());
-            return;
+            it--;
+            continue;
         }
+
+        m_CacheSize -= chunk->alen;
+        Mix_FreeChunk(chunk);
+        m_Cache.erase(*it);
+        it = std::prev(m_LRU.erase(it));
     }
-    Mix_PlayChannel(-1, m_DataBuffer[0], 0);
 }
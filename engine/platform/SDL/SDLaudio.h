@@ -28,6 +28,10 @@
 #pragma once
 
 #include <iostream>
+#include <list>
+#include <vector>
+#include <functional>
+#include <unordered_map>
 
 #include "engine.h"
 #include "audio.h"
@@ -38,14 +42,53 @@ class SDLAudio: public Audio
 
 public:
 
+    SDLAudio();
+
     virtual void Start() override;
     virtual void Stop() override;
     virtual void PlaySound(const std::string& filename) override;
     virtual void PlaySound(const char* path, int resourceID, const std::string& resourceClass) override;
 
+    virtual void Preload(const std::string& filename) override;
+    virtual void Preload(const char* path, int resourceID, const std::string& resourceClass) override;
+    virtual void ClearCache() override;
+
+private:
+
+    struct CachedSound
+    {
+        Mix_Chunk* m_Chunk;
+        std::list<std::string>::iterator m_LRUPosition;
+    };
+
+    struct Voice
+    {
+        Mix_Chunk* m_Chunk;
+        uint64 m_StartOrder;
+    };
+
 private:
 
-    static constexpr uint SOUND_CHANNELS = 2;
-    Mix_Chunk* m_DataBuffer[SOUND_CHANNELS];
+    Mix_Chunk* GetChunk(const std::string& key, const std::function<Mix_Chunk*()>& decode);
+    Mix_Chunk* LoadFile(const std::string& filename);
+    Mix_Chunk* LoadResource(const char* path, int resourceID, const std::string& resourceClass);
+    void Play(Mix_Chunk* chunk);
+    bool IsPlaying(Mix_Chunk* chunk) const;
+    void EvictToBudget();
+
+private:
+
+    static constexpr uint NUMBER_OF_VOICES = 8;
+    static constexpr size_t SOUND_CACHE_BUDGET = 32 * 1024 * 1024; // decoded bytes
+
+    // decoded sounds by file name or resource path, most recently used first
+    std::unordered_map<std::string, CachedSound> m_Cache;
+    std::list<std::string> m_LRU;
+    size_t m_CacheSize;
+
+    // one voice per mixer channel
+    std::vector<Voice> m_Voices;
+    uint64 m_StartCounter;
+    bool m_AudioOpen;
 
 };
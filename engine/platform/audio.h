@@ -51,6 +51,11 @@ public:
     virtual void PlaySound(const std::string& filename) = 0;
     virtual void PlaySound(const char* path, int resourceID, const std::string& resourceClass) = 0;
 
+    // decode a sound in advance, so that playing it the first time does not hitch a frame
+    virtual void Preload(const std::string& filename) = 0;
+    virtual void Preload(const char* path, int resourceID, const std::string& resourceClass) = 0;
+    virtual void ClearCache() = 0;
+
     static std::shared_ptr<Audio> Create();
     static AudioBackend GetBackend() { return AudioBackend::SDL; }
 
@@ -0,0 +1,118 @@
+/* Engine Copyright (c) 2021 Engine Development Team 
+   https://github.com/beaumanvienna/gfxRenderEngine
+
+   Permission is hereby granted, free of charge, to any person
+   obtaining a copy of this software and associated documentation files
+   (the "Software"), to deal in the Software without restriction,
+   including without limitation the rights to use, copy, modify, merge,
+   publish, distribute, sublicense, and/or sell copies of the Software,
+   and to permit persons to whom the Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be
+   included in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+   MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+   CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, 
+   TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE 
+   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
+
+#include <cmath>
+#include <chrono>
+#include <fstream>
+#include <filesystem>
+
+#include "core.h"
+#include "audioBenchmark.h"
+
+AudioBenchmark::AudioBenchmark(uint iterations)
+    : m_Iterations(iterations)
+{
+}
+
+void AudioBenchmark::Run()
+{
+    std::shared_ptr<Audio> audio = Engine::m_Engine->GetAudio();
+    std::string filename = (std::filesystem::temp_directory_path() / "audioBenchmark.wav").string();
+    if (!audio || !WriteTestSound(filename))
+    {
+        LOG_CORE_ERROR("AudioBenchmark: could not set up test sound {0}", filename);
+        return;
+    }
+
+    // cold: every call decodes the file
+    std::chrono::duration<double, std::micro> cold(0);
+    for (uint i = 0; i < m_Iterations; i++)
+    {
+        audio->ClearCache();
+        auto start = std::chrono::high_resolution_clock::now();
+        audio->PlaySound(filename);
+        cold += std::chrono::high_resolution_clock::now() - start;
+    }
+
+    // warm: the decoded sound comes from the cache
+    audio->ClearCache();
+    audio->Preload(filename);
+    std::chrono::duration<double, std::micro> warm(0);
+    for (uint i = 0; i < m_Iterations; i++)
+    {
+        auto start = std::chrono::high_resolution_clock::now();
+        audio->PlaySound(filename);
+        warm += std::chrono::high_resolution_clock::now() - start;
+    }
+
+    double coldLatency = cold.count() / m_Iterations;
+    double warmLatency = warm.count() / m_Iterations;
+    LOG_CORE_INFO("AudioBenchmark: PlaySound cold cache: {0:.1f} us", coldLatency);
+    LOG_CORE_INFO("AudioBenchmark: PlaySound warm cache: {0:.1f} us", warmLatency);
+    if (warmLatency > 0.0)
+    {
+        LOG_CORE_INFO("AudioBenchmark: speed-up {0:.1f}x", coldLatency / warmLatency);
+    }
+
+    audio->ClearCache();
+    std::filesystem::remove(filename);
+}
+
+// one second of a 440 Hz tone, 16 bit stereo PCM
+bool AudioBenchmark::WriteTestSound(const std::string& filename)
+{
+    const uint32_t sampleRate = 44100;
+    const uint16_t channels = 2;
+    const uint16_t bitsPerSample = 16;
+    const uint32_t dataSize = sampleRate * channels * bitsPerSample / 8;
+    const double pi = 3.14159265358979323846;
+
+    std::ofstream file(filename, std::ios::binary);
+    if (!file.is_open())
+    {
+        return false;
+    }
+
+    auto write32 = [&](uint32_t value) { file.write(reinterpret_cast<const char*>(&value), 4); };
+    auto write16 = [&](uint16_t value) { file.write(reinterpret_cast<const char*>(&value), 2); };
+
+    file.write("RIFF", 4);
+    write32(36 + dataSize);
+    file.write("WAVEfmt ", 8);
+    write32(16);
+    write16(1); // PCM
+    write16(channels);
+    write32(sampleRate);
+    write32(sampleRate * channels * bitsPerSample / 8);
+    write16(channels * bitsPerSample / 8);
+    write16(bitsPerSample);
+    file.write("data", 4);
+    write32(dataSize);
+
+    for (uint32_t i = 0; i < sampleRate; i++)
+    {
+        int16_t sample = static_cast<int16_t>(8000.0 * std::sin(2.0 * pi * 440.0 * i / sampleRate));
+        write16(sample);
+        write16(sample);
+    }
+    return file.good();
+}
@@ -0,0 +1,690 @@
+/* Engine Copyright (c) 2021 Engine Development Team 
+   https://github.com/beaumanvienna/gfxRenderEngine
+
+   Permission is hereby granted, free of charge, to any person
+   obtaining a copy of this software and associated documentation files
+   (the "Software"), to deal in the Software without restriction,
+   including without limitation the rights to use, copy, modify, merge,
+   publish, distribute, sublicense, and/or sell copies of the Software,
+   and to permit persons to whom the Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be
+   included in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+   MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+   CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, 
+   TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE 
+   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
+
+#include <cmath>
+#include <cstring>
+#include <algorithm>
+
+#include "SWdevice.h"
+#include "log.h"
+
+namespace
+{
+    inline uint PackColor(const glm::vec4& color)
+    {
+        glm::vec4 clamped = glm::clamp(color, 0.0f, 1.0f) * 255.0f + 0.5f;
+        return (static_cast<uint>(clamped.r) <<  0) |
+               (static_cast<uint>(clamped.g) <<  8) |
+               (static_cast<uint>(clamped.b) << 16) |
+               (static_cast<uint>(clamped.a) << 24);
+    }
+
+    // edge function: > 0 if p is left of the edge a->b
+    inline float Edge(float ax, float ay, float bx, float by, float px, float py)
+    {
+        return (bx - ax) * (py - ay) - (by - ay) * (px - ax);
+    }
+
+    // pixels exactly on a shared edge belong to only one of the two triangles,
+    // for counter-clockwise triangles with y pointing up these are the left and top edges
+    inline bool IsTopLeft(float ax, float ay, float bx, float by)
+    {
+        return (by < ay) || ((by == ay) && (bx < ax));
+    }
+}
+
+SWDevice& SWDevice::Get()
+{
+    static SWDevice device;
+    return device;
+}
+
+SWDevice::SWDevice()
+    : m_NextImageID(1), m_DefaultColorImage(0), m_ColorTarget(0), m_DepthTarget(nullptr),
+      m_ClearColor(0.0f), m_Blending(false), m_DepthTesting(false), m_ScissorTesting(false),
+      m_Scissor{0, 0, 0, 0}, m_ViewProjectionMatrix(1.0f), m_Target(nullptr), m_Depth(nullptr), m_TilesX(0), m_TilesY(0),
+      m_DrawArea{0, 0, 0, 0}, m_Job(nullptr), m_JobCount(0), m_NextJob(0), m_BusyWorkers(0),
+      m_Generation(0), m_WorkersRun(true)
+{
+    for (auto& textureUnit : m_TextureUnits)
+    {
+        textureUnit = 0;
+    }
+
+    m_DefaultColorImage = CreateImage();
+    m_ColorTarget = m_DefaultColorImage;
+    m_DepthTarget = &m_DefaultDepthBuffer;
+
+    // the calling thread rasterizes as well
+    uint threads = std::thread::hardware_concurrency();
+    uint workers = (threads > 1) ? threads - 1 : 0;
+    for (uint worker = 0; worker < workers; worker++)
+    {
+        m_Workers.push_back(std::thread([this]() { Worker(); }));
+    }
+    LOG_CORE_INFO("SWDevice: rasterizing with {0} thread(s)", workers + 1);
+}
+
+SWDevice::~SWDevice()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_WorkerMutex);
+        m_WorkersRun = false;
+    }
+    m_WorkerWakeup.notify_all();
+    for (auto& worker : m_Workers)
+    {
+        worker.join();
+    }
+}
+
+uint SWDevice::CreateImage()
+{
+    std::lock_guard<std::mutex> lock(m_ImageMutex);
+    uint id = m_NextImageID++;
+    m_Images[id] = std::make_unique<Image>();
+    return id;
+}
+
+void SWDevice::DeleteImage(uint id)
+{
+    std::lock_guard<std::mutex> lock(m_ImageMutex);
+    m_Images.erase(id);
+}
+
+SWDevice::Image* SWDevice::GetImage(uint id)
+{
+    std::lock_guard<std::mutex> lock(m_ImageMutex);
+    auto iterator = m_Images.find(id);
+    return (iterator != m_Images.end()) ? iterator->second.get() : nullptr;
+}
+
+void SWDevice::ResizeDefaultRenderTarget(int width, int height)
+{
+    Image* image = GetImage(m_DefaultColorImage);
+    image->m_Width = width;
+    image->m_Height = height;
+    image->m_Pixels.assign(width * height, 0);
+    m_DefaultDepthBuffer.assign(width * height, 1.0f);
+}
+
+void SWDevice::SetRenderTarget(uint colorImage, std::vector<float>* depthBuffer)
+{
+    m_ColorTarget = colorImage;
+    m_DepthTarget = depthBuffer;
+}
+
+void SWDevice::SetDefaultRenderTarget()
+{
+    SetRenderTarget(m_DefaultColorImage, &m_DefaultDepthBuffer);
+}
+
+void SWDevice::ReleaseRenderTarget(uint colorImage)
+{
+    if (m_ColorTarget == colorImage)
+    {
+        SetDefaultRenderTarget();
+    }
+}
+
+void SWDevice::SetScissor(int left, int bottom, int width, int height)
+{
+    m_Scissor = {left, bottom, left + width, bottom + height};
+}
+
+void SWDevice::BindTextureUnit(uint unit, uint imageID)
+{
+    ASSERT(unit < TextureSlotManager::MAX_TEXTURE_UNITS);
+    m_TextureUnits[unit] = imageID;
+}
+
+// the render target, limited by the scissor rectangle
+SWDevice::Rectangle SWDevice::GetDrawArea(const Image* target) const
+{
+    Rectangle area = {0, 0, target->m_Width, target->m_Height};
+    if (m_ScissorTesting)
+    {
+        area.m_MinX = std::max(area.m_MinX, m_Scissor.m_MinX);
+        area.m_MinY = std::max(area.m_MinY, m_Scissor.m_MinY);
+        area.m_MaxX = std::min(area.m_MaxX, m_Scissor.m_MaxX);
+        area.m_MaxY = std::min(area.m_MaxY, m_Scissor.m_MaxY);
+    }
+    return area;
+}
+
+void SWDevice::Clear()
+{
+    Image* target = GetImage(m_ColorTarget);
+    if (!target)
+    {
+        return;
+    }
+    Rectangle area = GetDrawArea(target);
+    if ((area.m_MinX >= area.m_MaxX) || (area.m_MinY >= area.m_MaxY))
+    {
+        return;
+    }
+
+    uint color = PackColor(m_ClearColor);
+    bool clearDepth = m_DepthTarget && (m_DepthTarget->size() == target->m_Pixels.size());
+    uint rows = area.m_MaxY - area.m_MinY;
+    Parallel((rows + TILE_SIZE - 1) / TILE_SIZE, [&](uint band)
+    {
+        int firstRow = area.m_MinY + band * TILE_SIZE;
+        int lastRow = std::min(firstRow + TILE_SIZE, area.m_MaxY);
+        for (int y = firstRow; y < lastRow; y++)
+        {
+            uint offset = y * target->m_Width;
+            std::fill(&target->m_Pixels[offset + area.m_MinX], &target->m_Pixels[offset] + area.m_MaxX, color);
+            if (clearDepth)
+            {
+                std::fill(&(*m_DepthTarget)[offset + area.m_MinX], &(*m_DepthTarget)[offset] + area.m_MaxX, 1.0f);
+            }
+        }
+    });
+}
+
+void SWDevice::DrawIndexed(const uchar* verticies, const VertexFormat& format, uint baseVertex, const uint* indicies, uint count)
+{
+    m_Target = GetImage(m_ColorTarget);
+    if (!m_Target || !m_Target->m_Width || !m_Target->m_Height)
+    {
+        return;
+    }
+    m_DrawArea = GetDrawArea(m_Target);
+    if ((m_DrawArea.m_MinX >= m_DrawArea.m_MaxX) || (m_DrawArea.m_MinY >= m_DrawArea.m_MaxY))
+    {
+        return;
+    }
+    m_Depth = (m_DepthTesting && m_DepthTarget && (m_DepthTarget->size() == m_Target->m_Pixels.size())) ?
+                m_DepthTarget->data() : nullptr;
+
+    m_TilesX = (m_Target->m_Width  + TILE_SIZE - 1) / TILE_SIZE;
+    m_TilesY = (m_Target->m_Height + TILE_SIZE - 1) / TILE_SIZE;
+    m_Bins.resize(m_TilesX * m_TilesY);
+
+    // textures are looked up once per draw call, not per pixel
+    const Image* textures[TextureSlotManager::MAX_TEXTURE_UNITS];
+    for (uint unit = 0; unit < TextureSlotManager::MAX_TEXTURE_UNITS; unit++)
+    {
+        textures[unit] = m_TextureUnits[unit] ? GetImage(m_TextureUnits[unit]) : nullptr;
+        if (textures[unit] && textures[unit]->m_Pixels.empty())
+        {
+            textures[unit] = nullptr;
+        }
+    }
+
+    // vertex stage and binning
+    m_Triangles.clear();
+    float halfWidth  = m_Target->m_Width  * 0.5f;
+    float halfHeight = m_Target->m_Height * 0.5f;
+    for (uint index = 0; index + 2 < count; index += 3)
+    {
+        float x[3], y[3], z[3], u[3], v[3];
+        glm::vec4 color[3];
+        for (uint corner = 0; corner < 3; corner++)
+        {
+            const uchar* vertex = verticies + (baseVertex + indicies[index + corner]) * format.m_Stride;
+
+            float position[3];
+            memcpy(position, vertex + format.m_PositionOffset, sizeof(position));
+            glm::vec4 clip = m_ViewProjectionMatrix * glm::vec4(position[0], position[1], position[2], 1.0f);
+            float inverseW = 1.0f / clip.w;
+            x[corner] = (clip.x * inverseW + 1.0f) * halfWidth;
+            y[corner] = (clip.y * inverseW + 1.0f) * halfHeight;
+            z[corner] = (clip.z * inverseW + 1.0f) * 0.5f;
+
+            float textureCoordinates[2];
+            memcpy(textureCoordinates, vertex + format.m_TextureCoordinateOffset, sizeof(textureCoordinates));
+            u[corner] = textureCoordinates[0];
+            v[corner] = textureCoordinates[1];
+
+            memcpy(&color[corner], vertex + format.m_ColorOffset, sizeof(glm::vec4));
+        }
+
+        // the texture unit is stored as an int
+        Triangle triangle;
+        int textureUnit;
+        memcpy(&textureUnit, verticies + (baseVertex + indicies[index]) * format.m_Stride + format.m_TextureIndexOffset, sizeof(int));
+        triangle.m_Texture = ((textureUnit >= 0) && (textureUnit < static_cast<int>(TextureSlotManager::MAX_TEXTURE_UNITS))) ?
+                                textures[textureUnit] : nullptr;
+
+        if (!SetupTriangle(triangle, x, y, z, u, v, color))
+        {
+            continue;
+        }
+
+        uint triangleIndex = m_Triangles.size();
+        m_Triangles.push_back(triangle);
+        for (int tileY = triangle.m_MinY / TILE_SIZE; tileY <= (triangle.m_MaxY - 1) / TILE_SIZE; tileY++)
+        {
+            for (int tileX = triangle.m_MinX / TILE_SIZE; tileX <= (triangle.m_MaxX - 1) / TILE_SIZE; tileX++)
+            {
+                uint tile = tileY * m_TilesX + tileX;
+                if (m_Bins[tile].empty())
+                {
+                    m_ActiveTiles.push_back(tile);
+                }
+                m_Bins[tile].push_back(triangleIndex);
+            }
+        }
+    }
+
+    // every tile is owned by one thread, so no two threads write the same pixel
+    Parallel(m_ActiveTiles.size(), [this](uint job) { RasterizeTile(m_ActiveTiles[job]); });
+
+    m_Statistics.m_Triangles += m_Triangles.size();
+    m_Statistics.m_TileJobs += m_ActiveTiles.size();
+    for (uint tile : m_ActiveTiles)
+    {
+        m_Bins[tile].clear();
+    }
+    m_ActiveTiles.clear();
+}
+
+void SWDevice::RasterizeTile(uint tile)
+{
+    int tileX = (tile % m_TilesX) * TILE_SIZE;
+    int tileY = (tile / m_TilesX) * TILE_SIZE;
+    Rectangle tileArea =
+    {
+        std::max(tileX, m_DrawArea.m_MinX),
+        std::max(tileY, m_DrawArea.m_MinY),
+        std::min(tileX + TILE_SIZE, m_DrawArea.m_MaxX),
+        std::min(tileY + TILE_SIZE, m_DrawArea.m_MaxY)
+    };
+
+    // submission order, required for blending
+    for (uint triangleIndex : m_Bins[tile])
+    {
+        RasterizeTriangle(m_Triangles[triangleIndex], tileArea);
+    }
+}
+
+// computes edges, bounding box and attribute gradients,
+// returns false if the triangle does not cover any pixel
+bool SWDevice::SetupTriangle(Triangle& triangle, const float x[3], const float y[3], const float z[3],
+                             const float u[3], const float v[3], const glm::vec4 color[3]) const
+{
+    float area = Edge(x[0], y[0], x[1], y[1], x[2], y[2]);
+    if (area == 0.0f)
+    {
+        return false;
+    }
+
+    // no culling, clockwise triangles are made counter-clockwise
+    int order[3] = {0, 1, 2};
+    if (area < 0.0f)
+    {
+        std::swap(order[1], order[2]);
+        area = -area;
+    }
+    for (int corner = 0; corner < 3; corner++)
+    {
+        triangle.m_X[corner] = x[order[corner]];
+        triangle.m_Y[corner] = y[order[corner]];
+    }
+    const float* X = triangle.m_X;
+    const float* Y = triangle.m_Y;
+
+    // pixel centers inside the bounding box
+    float minX = std::min({X[0], X[1], X[2]});
+    float minY = std::min({Y[0], Y[1], Y[2]});
+    float maxX = std::max({X[0], X[1], X[2]});
+    float maxY = std::max({Y[0], Y[1], Y[2]});
+    triangle.m_MinX = std::max(static_cast<int>(std::floor(minX - 0.5f)), m_DrawArea.m_MinX);
+    triangle.m_MinY = std::max(static_cast<int>(std::floor(minY - 0.5f)), m_DrawArea.m_MinY);
+    triangle.m_MaxX = std::min(static_cast<int>(std::ceil (maxX - 0.5f)) + 1, m_DrawArea.m_MaxX);
+    triangle.m_MaxY = std::min(static_cast<int>(std::ceil (maxY - 0.5f)) + 1, m_DrawArea.m_MaxY);
+    if ((triangle.m_MinX >= triangle.m_MaxX) || (triangle.m_MinY >= triangle.m_MaxY))
+    {
+        return false;
+    }
+
+    // edge 0 is opposite of vertex 0 and so on
+    triangle.m_TopLeft[0] = IsTopLeft(X[1], Y[1], X[2], Y[2]);
+    triangle.m_TopLeft[1] = IsTopLeft(X[2], Y[2], X[0], Y[0]);
+    triangle.m_TopLeft[2] = IsTopLeft(X[0], Y[0], X[1], Y[1]);
+
+    // the barycentric weight of vertex i changes by stepX[i] / area per pixel
+    float inverseArea = 1.0f / area;
+    float stepX[3] = {Y[1] - Y[2], Y[2] - Y[0], Y[0] - Y[1]};
+    float stepY[3] = {X[2] - X[1], X[0] - X[2], X[1] - X[0]};
+    auto plane = [&](float a0, float a1, float a2)
+    {
+        float attribute[3] = {a0, a1, a2};
+        Plane result;
+        result.m_Value = attribute[order[0]];
+        result.m_DX = (stepX[0] * attribute[order[0]] + stepX[1] * attribute[order[1]] + stepX[2] * attribute[order[2]]) * inverseArea;
+        result.m_DY = (stepY[0] * attribute[order[0]] + stepY[1] * attribute[order[1]] + stepY[2] * attribute[order[2]]) * inverseArea;
+        return result;
+    };
+
+    triangle.m_Depth = plane(z[0], z[1], z[2]);
+    if (triangle.m_Texture)
+    {
+        float width  = static_cast<float>(triangle.m_Texture->m_Width);
+        float height = static_cast<float>(triangle.m_Texture->m_Height);
+        triangle.m_U = plane(u[0] * width,  u[1] * width,  u[2] * width);
+        triangle.m_V = plane(v[0] * height, v[1] * height, v[2] * height);
+    }
+    else
+    {
+        triangle.m_U = triangle.m_V = {0.0f, 0.0f, 0.0f};
+    }
+
+    triangle.m_FlatColor = (color[0] == color[1]) && (color[0] == color[2]);
+    if (triangle.m_FlatColor)
+    {
+        for (int channel = 0; channel < 4; channel++)
+        {
+            triangle.m_FlatColorFixed[channel] = static_cast<uint>(std::clamp(color[0][channel], 0.0f, 1.0f) * 256.0f + 0.5f);
+        }
+    }
+    else
+    {
+        for (int channel = 0; channel < 4; channel++)
+        {
+            triangle.m_Color[channel] = plane(color[0][channel], color[1][channel], color[2][channel]);
+        }
+    }
+    return true;
+}
+
+void SWDevice::RasterizeTriangle(const Triangle& triangle, const Rectangle& tileArea)
+{
+    int minX = std::max(triangle.m_MinX, tileArea.m_MinX);
+    int minY = std::max(triangle.m_MinY, tileArea.m_MinY);
+    int maxX = std::min(triangle.m_MaxX, tileArea.m_MaxX);
+    int maxY = std::min(triangle.m_MaxY, tileArea.m_MaxY);
+    if ((minX >= maxX) || (minY >= maxY))
+    {
+        return;
+    }
+
+    const float* x = triangle.m_X;
+    const float* y = triangle.m_Y;
+    const bool* topLeft = triangle.m_TopLeft;
+    float stepX[3] = {y[1] - y[2], y[2] - y[0], y[0] - y[1]};
+
+    // copied to locals, the compiler cannot keep them in registers
+    // otherwise because the pixel writes could alias them
+    const Image* texture = triangle.m_Texture;
+    const uint* texels = texture ? texture->m_Pixels.data() : nullptr;
+    const int textureWidth  = texture ? texture->m_Width  : 0;
+    const int textureHeight = texture ? texture->m_Height : 0;
+    const bool flatColor = triangle.m_FlatColor;
+    const uint fixed[4] =
+    {
+        triangle.m_FlatColorFixed[0], triangle.m_FlatColorFixed[1],
+        triangle.m_FlatColorFixed[2], triangle.m_FlatColorFixed[3]
+    };
+    const bool blending = m_Blending;
+    // a white vertex color leaves the texel as it is
+    const bool white = flatColor && (fixed[0] == 256) && (fixed[1] == 256) && (fixed[2] == 256) && (fixed[3] == 256);
+    const float depthDX = triangle.m_Depth.m_DX;
+    const float uDX = triangle.m_U.m_DX;
+    const float vDX = triangle.m_V.m_DX;
+    uint* targetPixels = m_Target->m_Pixels.data();
+    const int targetWidth = m_Target->m_Width;
+    auto evaluate = [&](const Plane& plane, float pixelX, float pixelY)
+    {
+        return plane.m_Value + plane.m_DX * (pixelX - x[0]) + plane.m_DY * (pixelY - y[0]);
+    };
+
+    for (int row = minY; row < maxY; row++)
+    {
+        float pixelX = minX + 0.5f;
+        float pixelY = row  + 0.5f;
+        float edge[3] =
+        {
+            Edge(x[1], y[1], x[2], y[2], pixelX, pixelY),
+            Edge(x[2], y[2], x[0], y[0], pixelX, pixelY),
+            Edge(x[0], y[0], x[1], y[1], pixelX, pixelY)
+        };
+
+        // the covered span of the row: solve each edge for x, then
+        // correct the rounding with the exact test at the span ends
+        auto inside = [&](int column)
+        {
+            for (int index = 0; index < 3; index++)
+            {
+                float value = edge[index] + stepX[index] * (column - minX);
+                if (!((value > 0.0f) || ((value == 0.0f) && topLeft[index])))
+                {
+                    return false;
+                }
+            }
+            return true;
+        };
+        float spanStart = static_cast<float>(minX);
+        float spanEnd = static_cast<float>(maxX);
+        bool empty = false;
+        for (int index = 0; index < 3; index++)
+        {
+            if (stepX[index] > 0.0f)
+            {
+                spanStart = std::max(spanStart, minX - edge[index] / stepX[index]);
+            }
+            else if (stepX[index] < 0.0f)
+            {
+                spanEnd = std::min(spanEnd, minX - edge[index] / stepX[index] + 1.0f);
+            }
+            else if ((edge[index] < 0.0f) || ((edge[index] == 0.0f) && !topLeft[index]))
+            {
+                empty = true;
+            }
+        }
+        if (empty || (spanStart >= spanEnd))
+        {
+            continue;
+        }
+        int start = std::max(static_cast<int>(spanStart), minX);
+        int end   = std::min(static_cast<int>(std::ceil(spanEnd)), maxX);
+        while ((start < end) && !inside(start))     start++;
+        while ((start > minX) && inside(start - 1)) start--;
+        while ((end > start) && !inside(end - 1))   end--;
+        while ((end < maxX) && inside(end))         end++;
+        if (start >= end)
+        {
+            continue;
+        }
+
+        float startX = start + 0.5f;
+        float depth = evaluate(triangle.m_Depth, startX, pixelY);
+        float u = texture ? evaluate(triangle.m_U, startX, pixelY) : 0.0f;
+        float v = texture ? evaluate(triangle.m_V, startX, pixelY) : 0.0f;
+        float color[4] = {};
+        if (!flatColor)
+        {
+            for (int channel = 0; channel < 4; channel++)
+            {
+                color[channel] = evaluate(triangle.m_Color[channel], startX, pixelY);
+            }
+        }
+
+        uint* pixels = &targetPixels[row * targetWidth];
+        float* depths = m_Depth ? &m_Depth[row * targetWidth] : nullptr;
+
+        // untextured and opaque: a solid span
+        if (flatColor && !texels && !depths && (!blending || (fixed[3] >= 0xff)))
+        {
+            uint solid = std::min(fixed[0], 0xffu) | (std::min(fixed[1], 0xffu) << 8) |
+                         (std::min(fixed[2], 0xffu) << 16) | (std::min(fixed[3], 0xffu) << 24);
+            std::fill(pixels + start, pixels + end, solid);
+            continue;
+        }
+        for (int column = start; column < end; column++)
+        {
+            if (!depths || (depth < depths[column]))
+            {
+                if (depths)
+                {
+                    depths[column] = depth;
+                }
+
+                // vertex color in 0 ... 256
+                uint source[4];
+                if (flatColor)
+                {
+                    source[0] = fixed[0]; source[1] = fixed[1]; source[2] = fixed[2]; source[3] = fixed[3];
+                }
+                else
+                {
+                    for (int channel = 0; channel < 4; channel++)
+                    {
+                        source[channel] = static_cast<uint>(std::clamp(color[channel], 0.0f, 1.0f) * 256.0f + 0.5f);
+                    }
+                }
+
+                // nearest sampling, clamped to the edge, modulated with the vertex color
+                uint texel = 0xffffffff;
+                if (texels)
+                {
+                    int texelX = std::min(std::max(static_cast<int>(u), 0), textureWidth  - 1);
+                    int texelY = std::min(std::max(static_cast<int>(v), 0), textureHeight - 1);
+                    texel = texels[texelY * textureWidth + texelX];
+                }
+                if (white)
+                {
+                    if (!blending || ((texel >> 24) == 0xff))
+                    {
+                        pixels[column] = texel;
+                        depth += depthDX; u += uDX; v += vDX;
+                        continue;
+                    }
+                    source[0] = (texel >>  0) & 0xff;
+                    source[1] = (texel >>  8) & 0xff;
+                    source[2] = (texel >> 16) & 0xff;
+                    source[3] = (texel >> 24) & 0xff;
+                }
+                else
+                {
+                    for (int channel = 0; channel < 4; channel++)
+                    {
+                        source[channel] = (((texel >> (channel * 8)) & 0xff) * source[channel]) >> 8;
+                    }
+                }
+
+                uint alpha = source[3];
+                if (!blending || (alpha == 0xff))
+                {
+                    pixels[column] = source[0] | (source[1] << 8) | (source[2] << 16) | (source[3] << 24);
+                }
+                else if (alpha)
+                {
+                    // glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA)
+                    uint destination = pixels[column];
+                    uint result = 0;
+                    for (int channel = 0; channel < 4; channel++)
+                    {
+                        uint blended = (source[channel] * alpha + ((destination >> (channel * 8)) & 0xff) * (0xff - alpha) + 127) / 0xff;
+                        result |= blended << (channel * 8);
+                    }
+                    pixels[column] = result;
+                }
+            }
+
+            depth += depthDX;
+            u += uDX;
+            v += vDX;
+            if (!flatColor)
+            {
+                for (int channel = 0; channel < 4; channel++)
+                {
+                    color[channel] += triangle.m_Color[channel].m_DX;
+                }
+            }
+        }
+    }
+}
+
+void SWDevice::Present()
+{
+    m_Statistics.m_Frames++;
+}
+
+void SWDevice::Parallel(uint count, const std::function<void(uint)>& job)
+{
+    if (!count)
+    {
+        return;
+    }
+    if (m_Workers.empty() || (count == 1))
+    {
+        for (uint index = 0; index < count; index++)
+        {
+            job(index);
+        }
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_WorkerMutex);
+        m_Job = &job;
+        m_JobCount = count;
+        m_NextJob = 0;
+        m_BusyWorkers = m_Workers.size();
+        m_Generation++;
+    }
+    m_WorkerWakeup.notify_all();
+
+    uint index;
+    while ((index = m_NextJob.fetch_add(1)) < count)
+    {
+        job(index);
+    }
+
+    std::unique_lock<std::mutex> lock(m_WorkerMutex);
+    m_WorkerDone.wait(lock, [this]() { return m_BusyWorkers == 0; });
+    m_Job = nullptr;
+}
+
+void SWDevice::Worker()
+{
+    uint generation = 0;
+    std::unique_lock<std::mutex> lock(m_WorkerMutex);
+    while (true)
+    {
+        m_WorkerWakeup.wait(lock, [this, generation]() { return !m_WorkersRun || (m_Generation != generation); });
+        if (!m_WorkersRun)
+        {
+            return;
+        }
+        generation = m_Generation;
+        const std::function<void(uint)>* job = m_Job;
+        uint count = m_JobCount;
+        lock.unlock();
+
+        uint index;
+        while ((index = m_NextJob.fetch_add(1)) < count)
+        {
+            (*job)(index);
+        }
+
+        lock.lock();
+        if (--m_BusyWorkers == 0)
+        {
+            m_WorkerDone.notify_one();
+        }
+    }
+}
@@ -0,0 +1,197 @@
+/* Engine Copyright (c) 2021 Engine Development Team 
+   https://github.com/beaumanvienna/gfxRenderEngine
+
+   Permission is hereby granted, free of charge, to any person
+   obtaining a copy of this software and associated documentation files
+   (the "Software"), to deal in the Software without restriction,
+   including without limitation the rights to use, copy, modify, merge,
+   publish, distribute, sublicense, and/or sell copies of the Software,
+   and to permit persons to whom the Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be
+   included in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+   MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+   CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, 
+   TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE 
+   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
+
+#pragma once
+
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <functional>
+#include <unordered_map>
+#include <condition_variable>
+
+#include "engine.h"
+#include "glm.hpp"
+#include "textureSlotManager.h"
+
+// The software renderer's equivalent of a GPU: it owns the images behind
+// textures and framebuffer attachments, the render target, the pipeline
+// state and the texture units, and rasterizes triangles.
+//
+// Draw calls are rasterized in tiles of TILE_SIZE x TILE_SIZE pixels. The
+// triangles of a draw call are binned per tile, and the tiles are processed
+// in parallel by a pool of worker threads. Within a tile, triangles are drawn
+// in submission order, so blending gives the same result as on a GPU.
+//
+// Images are stored bottom row first, four bytes per pixel in RGBA order,
+// like textures uploaded with GL_RGBA/GL_UNSIGNED_BYTE.
+class SWDevice
+{
+
+public:
+
+    static constexpr int TILE_SIZE = 64;
+
+    struct Image
+    {
+        int m_Width = 0;
+        int m_Height = 0;
+        std::vector<uint> m_Pixels;
+    };
+
+    // the engine's vertex format: position, texture coordinate, texture unit, color
+    struct VertexFormat
+    {
+        uint m_Stride;
+        uint m_PositionOffset;
+        uint m_TextureCoordinateOffset;
+        uint m_TextureIndexOffset;
+        uint m_ColorOffset;
+    };
+
+    struct Statistics
+    {
+        uint64 m_Triangles = 0;
+        uint64 m_TileJobs = 0;
+        uint64 m_Frames = 0;
+    };
+
+public:
+
+    static SWDevice& Get();
+
+    ~SWDevice();
+
+    // images
+    uint CreateImage();
+    void DeleteImage(uint id);
+    Image* GetImage(uint id);
+
+    // render target, the default target is the window
+    void ResizeDefaultRenderTarget(int width, int height);
+    void SetRenderTarget(uint colorImage, std::vector<float>* depthBuffer);
+    void SetDefaultRenderTarget();
+    // switches back to the default target if the image is the current target
+    void ReleaseRenderTarget(uint colorImage);
+    const Image* GetDefaultRenderTarget() { return GetImage(m_DefaultColorImage); }
+
+    // pipeline state
+    void SetClearColor(const glm::vec4& color) { m_ClearColor = color; }
+    void SetBlending(bool enable) { m_Blending = enable; }
+    void SetDepthTesting(bool enable) { m_DepthTesting = enable; }
+    void SetScissorTesting(bool enable) { m_ScissorTesting = enable; }
+    void SetScissor(int left, int bottom, int width, int height);
+    void SetViewProjectionMatrix(const glm::mat4& matrix) { m_ViewProjectionMatrix = matrix; }
+    void BindTextureUnit(uint unit, uint imageID);
+
+    void Clear();
+    void DrawIndexed(const uchar* verticies, const VertexFormat& format, uint baseVertex, const uint* indicies, uint count);
+    void Present();
+
+    const Statistics& GetStatistics() const { return m_Statistics; }
+
+private:
+
+    // an attribute interpolated linearly across a triangle
+    struct Plane
+    {
+        float m_Value; // at vertex 0
+        float m_DX, m_DY;
+    };
+
+    struct Triangle
+    {
+        // screen space, pixel centers at +0.5, counter-clockwise
+        float m_X[3], m_Y[3];
+        bool m_TopLeft[3];
+        Plane m_Depth;
+        Plane m_U, m_V; // in texels
+        Plane m_Color[4];
+        bool m_FlatColor;
+        uint m_FlatColorFixed[4]; // 0 ... 256, if all verticies have the same color
+        const Image* m_Texture;
+        int m_MinX, m_MinY, m_MaxX, m_MaxY;
+    };
+
+    struct Rectangle
+    {
+        int m_MinX, m_MinY, m_MaxX, m_MaxY; // inclusive minimum, exclusive maximum
+    };
+
+private:
+
+    SWDevice();
+
+    Rectangle GetDrawArea(const Image* target) const;
+    void RasterizeTile(uint tile);
+    bool SetupTriangle(Triangle& triangle, const float x[3], const float y[3], const float z[3],
+                       const float u[3], const float v[3], const glm::vec4 color[3]) const;
+    void RasterizeTriangle(const Triangle& triangle, const Rectangle& area);
+    // runs job(0) ... job(count - 1) on the worker threads and the calling thread
+    void Parallel(uint count, const std::function<void(uint)>& job);
+    void Worker();
+
+private:
+
+    // images
+    std::mutex m_ImageMutex;
+    std::unordered_map<uint, std::unique_ptr<Image>> m_Images;
+    uint m_NextImageID;
+
+    // render target
+    uint m_DefaultColorImage;
+    std::vector<float> m_DefaultDepthBuffer;
+    uint m_ColorTarget;
+    std::vector<float>* m_DepthTarget;
+
+    // pipeline state
+    glm::vec4 m_ClearColor;
+    bool m_Blending, m_DepthTesting, m_ScissorTesting;
+    Rectangle m_Scissor;
+    glm::mat4 m_ViewProjectionMatrix;
+    uint m_TextureUnits[TextureSlotManager::MAX_TEXTURE_UNITS];
+
+    // current draw call
+    Image* m_Target;
+    float* m_Depth;
+    std::vector<Triangle> m_Triangles;
+    std::vector<std::vector<uint>> m_Bins;
+    std::vector<uint> m_ActiveTiles;
+    int m_TilesX, m_TilesY;
+    Rectangle m_DrawArea;
+
+    // worker threads
+    std::vector<std::thread> m_Workers;
+    std::mutex m_WorkerMutex;
+    std::condition_variable m_WorkerWakeup;
+    std::condition_variable m_WorkerDone;
+    const std::function<void(uint)>* m_Job;
+    uint m_JobCount;
+    std::atomic<uint> m_NextJob;
+    uint m_BusyWorkers;
+    uint m_Generation;
+    bool m_WorkersRun;
+
+    Statistics m_Statistics;
+
+};
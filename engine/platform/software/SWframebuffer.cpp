@@ -0,0 +1,138 @@
+/* Engine Copyright (c) 2021 Engine Development Team 
+   https://github.com/beaumanvienna/gfxRenderEngine
+
+   Permission is hereby granted, free of charge, to any person
+   obtaining a copy of this software and associated documentation files
+   (the "Software"), to deal in the Software without restriction,
+   including without limitation the rights to use, copy, modify, merge,
+   publish, distribute, sublicense, and/or sell copies of the Software,
+   and to permit persons to whom the Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be
+   included in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+   MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+   CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, 
+   TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE 
+   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
+
+#include <algorithm>
+
+#include "SWframebuffer.h"
+#include "SWdevice.h"
+
+static const uint s_MaxFramebufferSize = 8192;
+
+SWFramebuffer::SWFramebuffer(const FramebufferSpecification& spec)
+    : m_Specification(spec)
+{
+    for (auto spec : m_Specification.m_Attachments.m_Attachments)
+    {
+        if (spec.m_TextureFormat != FramebufferTextureFormat::DEPTH24STENCIL8)
+        {
+            m_ColorAttachmentSpecifications.emplace_back(spec);
+        }
+        else
+        {
+            m_DepthAttachmentSpecification = spec;
+        }
+    }
+
+    Recreate();
+}
+
+SWFramebuffer::~SWFramebuffer()
+{
+    DeleteAttachments();
+}
+
+void SWFramebuffer::DeleteAttachments()
+{
+    SWDevice& device = SWDevice::Get();
+    for (uint attachment : m_ColorAttachments)
+    {
+        device.ReleaseRenderTarget(attachment);
+        device.DeleteImage(attachment);
+    }
+    m_ColorAttachments.clear();
+    m_DepthAttachment.clear();
+}
+
+// multisampling is not supported, the attachments are always single sampled
+void SWFramebuffer::Recreate()
+{
+    DeleteAttachments();
+
+    SWDevice& device = SWDevice::Get();
+    uint pixels = m_Specification.m_Width * m_Specification.m_Height;
+    for (uint index = 0; index < m_ColorAttachmentSpecifications.size(); index++)
+    {
+        uint attachment = device.CreateImage();
+        SWDevice::Image* image = device.GetImage(attachment);
+        image->m_Width = m_Specification.m_Width;
+        image->m_Height = m_Specification.m_Height;
+        image->m_Pixels.assign(pixels, 0);
+        m_ColorAttachments.push_back(attachment);
+    }
+
+    if (m_DepthAttachmentSpecification.m_TextureFormat != FramebufferTextureFormat::NONE)
+    {
+        m_DepthAttachment.assign(pixels, 1.0f);
+    }
+}
+
+// only the first color attachment is rendered to
+void SWFramebuffer::Bind()
+{
+    ASSERT(m_ColorAttachments.size());
+    SWDevice::Get().SetRenderTarget(m_ColorAttachments[0], m_DepthAttachment.size() ? &m_DepthAttachment : nullptr);
+}
+
+void SWFramebuffer::Unbind()
+{
+    SWDevice::Get().SetDefaultRenderTarget();
+}
+
+void SWFramebuffer::Resize(uint width, uint height)
+{
+    if (width == 0 || height == 0 || width > s_MaxFramebufferSize || height > s_MaxFramebufferSize)
+    {
+        LOG_CORE_WARN("Attempted to rezize framebuffer to {0}, {1}", width, height);
+        return;
+    }
+    m_Specification.m_Width = width;
+    m_Specification.m_Height = height;
+    
+    Recreate();
+}
+
+int SWFramebuffer::ReadPixel(uint attachmentIndex, int x, int y)
+{
+    ASSERT(attachmentIndex < m_ColorAttachments.size());
+
+    SWDevice::Image* image = SWDevice::Get().GetImage(m_ColorAttachments[attachmentIndex]);
+    if ((x < 0) || (y < 0) || (x >= image->m_Width) || (y >= image->m_Height))
+    {
+        return 0;
+    }
+    return static_cast<int>(image->m_Pixels[y * image->m_Width + x]);
+}
+
+void SWFramebuffer::ClearAttachment(uint attachmentIndex, int value)
+{
+    ASSERT(attachmentIndex < m_ColorAttachments.size());
+
+    SWDevice::Image* image = SWDevice::Get().GetImage(m_ColorAttachments[attachmentIndex]);
+    std::fill(image->m_Pixels.begin(), image->m_Pixels.end(), static_cast<uint>(value));
+}
+
+uint SWFramebuffer::GetColorAttachmentRendererID(uint index = 0) const
+{ 
+    ASSERT(index < m_ColorAttachments.size());
+
+    return m_ColorAttachments[index]; 
+}
@@ -0,0 +1,64 @@
+/* Engine Copyright (c) 2021 Engine Development Team 
+   https://github.com/beaumanvienna/gfxRenderEngine
+
+   Permission is hereby granted, free of charge, to any person
+   obtaining a copy of this software and associated documentation files
+   (the "Software"), to deal in the Software without restriction,
+   including without limitation the rights to use, copy, modify, merge,
+   publish, distribute, sublicense, and/or sell copies of the Software,
+   and to permit persons to whom the Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be
+   included in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+   MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+   CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, 
+   TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE 
+   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "engine.h"
+#include "framebuffer.h"
+
+class SWFramebuffer : public Framebuffer
+{
+
+public:
+
+    SWFramebuffer(const FramebufferSpecification& spec);
+    virtual ~SWFramebuffer();
+
+    void Recreate();
+
+    virtual void Bind() override;
+    virtual void Unbind() override;
+    virtual void Resize(uint width, uint height) override;
+    virtual int ReadPixel(uint attachmentIndex, int x, int y) override;
+    virtual void ClearAttachment(uint attachmentIndex, int value) override;
+    virtual uint GetColorAttachmentRendererID(uint index) const override;
+
+    virtual const FramebufferSpecification& GetSpecification() const override { return m_Specification; }
+
+private:
+
+    void DeleteAttachments();
+
+private:
+
+    FramebufferSpecification m_Specification;
+
+    std::vector<FramebufferTextureSpecification> m_ColorAttachmentSpecifications;
+    FramebufferTextureSpecification m_DepthAttachmentSpecification = FramebufferTextureFormat::NONE;
+
+    // SWDevice images, RED_INTEGER attachments store an int per pixel
+    std::vector<uint> m_ColorAttachments;
+    std::vector<float> m_DepthAttachment;
+};
@@ -0,0 +1,103 @@
+/* Engine Copyright (c) 2021 Engine Development Team 
+   https://github.com/beaumanvienna/gfxRenderEngine
+
+   Permission is hereby granted, free of charge, to any person
+   obtaining a copy of this software and associated documentation files
+   (the "Software"), to deal in the Software without restriction,
+   including without limitation the rights to use, copy, modify, merge,
+   publish, distribute, sublicense, and/or sell copies of the Software,
+   and to permit persons to whom the Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be
+   included in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+   MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+   CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, 
+   TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE 
+   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
+
+#include "SWindexBuffer.h"
+
+SWIndexBuffer::SWIndexBuffer(const uint* indicies, uint count)
+    : m_BufferMode(BUFFER_MODE_DYNAMIC), m_VertexCount(0), m_IndexCount(count),
+      m_Indicies(indicies, indicies + count)
+{
+}
+
+SWIndexBuffer::SWIndexBuffer(BufferMode bufferMode)
+    : m_BufferMode(bufferMode), m_VertexCount(0), m_IndexCount(0)
+{
+}
+
+SWIndexBuffer::~SWIndexBuffer()
+{
+}
+
+// count: maximum number of verticies per draw call
+void SWIndexBuffer::Create(uint count)
+{
+    uint quads = count / 4;
+    if (m_BufferMode != BUFFER_MODE_STREAMING)
+    {
+        m_Indicies.reserve(quads * 6);
+        return;
+    }
+
+    // the quad indicies never change, generate them once
+    m_Indicies.resize(quads * 6);
+    for (uint quad = 0; quad < quads; quad++)
+    {
+        uint vertex = quad * 4;
+        uint* index = &m_Indicies[quad * 6];
+        index[0] = vertex + 0;
+        index[1] = vertex + 1;
+        index[2] = vertex + 3;
+        index[3] = vertex + 1;
+        index[4] = vertex + 2;
+        index[5] = vertex + 3;
+    }
+}
+
+void SWIndexBuffer::AddObject(IndexBufferObject object)
+{
+    switch (object)
+    {
+        case INDEX_BUFFER_QUAD:
+
+            m_IndexCount += 6;
+            if (m_BufferMode == BUFFER_MODE_STREAMING)
+            {
+                // indicies are already in the static index buffer
+                m_VertexCount += 4;
+                break;
+            }
+
+            m_Indicies.push_back(0 + m_VertexCount);
+            m_Indicies.push_back(1 + m_VertexCount);
+            m_Indicies.push_back(3 + m_VertexCount);
+            m_Indicies.push_back(1 + m_VertexCount);
+            m_Indicies.push_back(2 + m_VertexCount);
+            m_Indicies.push_back(3 + m_VertexCount);
+            
+            m_VertexCount += 4; // four new verticies
+            
+            break;
+        default:
+            // not found
+            break;
+    }
+}
+
+void SWIndexBuffer::BeginScene()
+{
+    if (m_BufferMode != BUFFER_MODE_STREAMING)
+    {
+        m_Indicies.clear();
+    }
+    m_VertexCount = 0;
+    m_IndexCount = 0;
+}
@@ -0,0 +1,56 @@
+/* Engine Copyright (c) 2021 Engine Development Team 
+   https://github.com/beaumanvienna/gfxRenderEngine
+
+   Permission is hereby granted, free of charge, to any person
+   obtaining a copy of this software and associated documentation files
+   (the "Software"), to deal in the Software without restriction,
+   including without limitation the rights to use, copy, modify, merge,
+   publish, distribute, sublicense, and/or sell copies of the Software,
+   and to permit persons to whom the Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be
+   included in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+   MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+   CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, 
+   TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE 
+   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
+
+#pragma once
+
+#include <vector>
+
+#include "engine.h"
+#include "buffer.h"
+
+class SWIndexBuffer : public IndexBuffer
+{
+public:
+
+    SWIndexBuffer(BufferMode bufferMode = BUFFER_MODE_STREAMING); //empty buffer
+    SWIndexBuffer(const uint* indicies, uint count); // set all indicies in constructor
+    ~SWIndexBuffer();
+
+    virtual void Create(uint count) override;
+    virtual void AddObject(IndexBufferObject object) override;
+    virtual void BeginScene() override;
+    virtual void EndScene() override {}
+
+    virtual void Bind() const override {}
+    virtual void Unbind() const override {}
+    virtual uint GetCount() const override { return m_IndexCount; }
+    virtual BufferMode GetBufferMode() const override { return m_BufferMode; }
+
+    const uint* GetIndicies() const { return m_Indicies.data(); }
+
+private: 
+    BufferMode m_BufferMode;
+    uint m_VertexCount;
+    uint m_IndexCount;
+    std::vector<uint> m_Indicies;
+
+};
@@ -0,0 +1,104 @@
+/* Engine Copyright (c) 2021 Engine Development Team 
+   https://github.com/beaumanvienna/gfxRenderEngine
+
+   Permission is hereby granted, free of charge, to any person
+   obtaining a copy of this software and associated documentation files
+   (the "Software"), to deal in the Software without restriction,
+   including without limitation the rights to use, copy, modify, merge,
+   publish, distribute, sublicense, and/or sell copies of the Software,
+   and to permit persons to whom the Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be
+   included in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+   MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+   CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, 
+   TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE 
+   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
+
+
+#include <cstring>
+
+#include "SWinstanceBuffer.h"
+#include "SWdevice.h"
+
+void SWInstanceBuffer::Draw(const SpriteInstances& instances, const int* textureUnits, const glm::mat4& viewProjectionMatrix)
+{
+    uint count = instances.GetCount();
+    if (!count)
+    {
+        return;
+    }
+
+    m_Verticies.resize(count * 4 * FLOATS_PER_VERTEX);
+    while (m_Indicies.size() < count * 6)
+    {
+        // same order as SWIndexBuffer
+        uint vertex = m_Indicies.size() / 6 * 4;
+        m_Indicies.insert(m_Indicies.end(), {vertex + 0, vertex + 1, vertex + 3, vertex + 1, vertex + 2, vertex + 3});
+    }
+
+    const float* a  = instances.GetStream(SpriteInstances::TRANSFORM_A);
+    const float* b  = instances.GetStream(SpriteInstances::TRANSFORM_B);
+    const float* c  = instances.GetStream(SpriteInstances::TRANSFORM_C);
+    const float* d  = instances.GetStream(SpriteInstances::TRANSFORM_D);
+    const float* x  = instances.GetStream(SpriteInstances::TRANSLATION_X);
+    const float* y  = instances.GetStream(SpriteInstances::TRANSLATION_Y);
+    const float* u1 = instances.GetStream(SpriteInstances::TEXTURE_U1);
+    const float* v1 = instances.GetStream(SpriteInstances::TEXTURE_V1);
+    const float* u2 = instances.GetStream(SpriteInstances::TEXTURE_U2);
+    const float* v2 = instances.GetStream(SpriteInstances::TEXTURE_V2);
+    const float* depth = instances.GetStream(SpriteInstances::DEPTH);
+    const uint* colors = instances.GetColors();
+    const uchar* textureIndicies = instances.GetTextureIndicies();
+
+    // the corners of Sprite::GetScaleMatrix()
+    static constexpr float cornerX[4] = {-1.0f,  1.0f,  1.0f, -1.0f};
+    static constexpr float cornerY[4] = { 1.0f,  1.0f, -1.0f, -1.0f};
+
+    float* vertex = m_Verticies.data();
+    for (uint instance = 0; instance < count; instance++)
+    {
+        float textureUnit;
+        int unit = textureUnits[textureIndicies[instance]];
+        memcpy(&textureUnit, &unit, sizeof(float));
+
+        uint color = colors[instance];
+        float red   = static_cast<float>( color        & 0xff) / 255.0f;
+        float green = static_cast<float>((color >>  8) & 0xff) / 255.0f;
+        float blue  = static_cast<float>((color >> 16) & 0xff) / 255.0f;
+        float alpha = static_cast<float>((color >> 24) & 0xff) / 255.0f;
+
+        float u[4] = {u1[instance], u2[instance], u2[instance], u1[instance]};
+        float v[4] = {v1[instance], v1[instance], v2[instance], v2[instance]};
+        for (uint corner = 0; corner < 4; corner++)
+        {
+            vertex[0] = a[instance] * cornerX[corner] + c[instance] * cornerY[corner] + x[instance];
+            vertex[1] = b[instance] * cornerX[corner] + d[instance] * cornerY[corner] + y[instance];
+            vertex[2] = depth[instance];
+            vertex[3] = u[corner];
+            vertex[4] = v[corner];
+            vertex[5] = textureUnit;
+            vertex[6] = red;
+            vertex[7] = green;
+            vertex[8] = blue;
+            vertex[9] = alpha;
+            vertex += FLOATS_PER_VERTEX;
+        }
+    }
+
+    SWDevice::VertexFormat format =
+    {
+        FLOATS_PER_VERTEX * sizeof(float),
+        0 * sizeof(float),
+        3 * sizeof(float),
+        5 * sizeof(float),
+        6 * sizeof(float)
+    };
+    SWDevice::Get().SetViewProjectionMatrix(viewProjectionMatrix);
+    SWDevice::Get().DrawIndexed(reinterpret_cast<const uchar*>(m_Verticies.data()), format, 0, m_Indicies.data(), count * 6);
+}
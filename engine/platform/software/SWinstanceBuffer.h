@@ -0,0 +1,52 @@
+/* Engine Copyright (c) 2021 Engine Development Team 
+   https://github.com/beaumanvienna/gfxRenderEngine
+
+   Permission is hereby granted, free of charge, to any person
+   obtaining a copy of this software and associated documentation files
+   (the "Software"), to deal in the Software without restriction,
+   including without limitation the rights to use, copy, modify, merge,
+   publish, distribute, sublicense, and/or sell copies of the Software,
+   and to permit persons to whom the Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be
+   included in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+   MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+   CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, 
+   TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE 
+   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
+
+
+#pragma once
+
+#include <vector>
+
+#include "engine.h"
+#include "buffer.h"
+#include "spriteInstances.h"
+
+// builds the quads of the instances on the CPU, what instancedVertexShader.vert does,
+// and rasterizes them like a batch of the renderer
+class SWInstanceBuffer : public InstanceBuffer
+{
+
+public:
+
+    SWInstanceBuffer() {}
+    ~SWInstanceBuffer() override {}
+
+    virtual void Draw(const SpriteInstances& instances, const int* textureUnits, const glm::mat4& viewProjectionMatrix) override;
+
+private:
+
+    // position (3), texture coordinates (2), texture slot (1), color (4)
+    static constexpr uint FLOATS_PER_VERTEX = 10;
+
+    std::vector<float> m_Verticies;
+    std::vector<uint> m_Indicies;
+
+};
@@ -0,0 +1,113 @@
+/* Engine Copyright (c) 2021 Engine Development Team 
+   https://github.com/beaumanvienna/gfxRenderEngine
+
+   Permission is hereby granted, free of charge, to any person
+   obtaining a copy of this software and associated documentation files
+   (the "Software"), to deal in the Software without restriction,
+   including without limitation the rights to use, copy, modify, merge,
+   publish, distribute, sublicense, and/or sell copies of the Software,
+   and to permit persons to whom the Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be
+   included in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+   MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+   CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, 
+   TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE 
+   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
+
+#include "SWrendererAPI.h"
+#include "SWvertexBuffer.h"
+#include "SWindexBuffer.h"
+#include "SWdevice.h"
+
+void SWRendererAPI::SetClearColor(const glm::vec4& color)
+{
+    SWDevice::Get().SetClearColor(color);
+}
+
+void SWRendererAPI::Clear() const
+{
+    SWDevice::Get().Clear();
+}
+
+void SWRendererAPI::EnableBlending() const
+{
+    SWDevice::Get().SetBlending(true);
+}
+
+void SWRendererAPI::DisableBlending() const
+{
+    SWDevice::Get().SetBlending(false);
+}
+
+void SWRendererAPI::EnableScissor() const
+{
+    SWDevice::Get().SetScissorTesting(true);
+}
+
+void SWRendererAPI::DisableScissor() const
+{
+    SWDevice::Get().SetScissorTesting(false);
+}
+
+void SWRendererAPI::SetScissor(int left, int bottom, int width, int height) const
+{
+    SWDevice::Get().SetScissor(left, bottom, width, height);
+}
+
+void SWRendererAPI::EnableDethTesting() const
+{
+    SWDevice::Get().SetDepthTesting(true);
+}
+
+void SWRendererAPI::DisableDethTesting() const
+{
+    SWDevice::Get().SetDepthTesting(false);
+}
+
+void SWRendererAPI::DrawIndexed(const std::shared_ptr<VertexArray>& vertexArray) const
+{
+    auto& vertexBuffers = vertexArray->GetVertexBuffers();
+    auto& indexBuffers = vertexArray->GetIndexBuffers();
+
+    vertexBuffers[0]->EndScene();
+    indexBuffers[0]->EndScene();
+
+    uint count = indexBuffers[0]->GetCount();
+    if (!count) return;
+
+    auto vertexBuffer = static_cast<SWVertexBuffer*>(vertexBuffers[0].get());
+    auto indexBuffer = static_cast<SWIndexBuffer*>(indexBuffers[0].get());
+
+    // a_Position, a_TextureCoordinate, a_TextureIndex, a_Color
+    auto& layout = vertexBuffer->GetLayout();
+    auto& elements = layout.GetElements();
+    ASSERT(elements.size() >= 4);
+    SWDevice::VertexFormat format =
+    {
+        layout.GetStride(),
+        static_cast<uint>(elements[0].m_Offset),
+        static_cast<uint>(elements[1].m_Offset),
+        static_cast<uint>(elements[2].m_Offset),
+        static_cast<uint>(elements[3].m_Offset)
+    };
+
+    // rasterized right away, there is nothing to wait for in Finish()
+    SWDevice::Get().DrawIndexed
+    (
+        vertexBuffer->GetData(),
+        format,
+        vertexBuffer->GetBaseVertex(),
+        indexBuffer->GetIndicies(),
+        count
+    );
+}
+
+void SWRendererAPI::Finish() const
+{
+}
@@ -0,0 +1,47 @@
+/* Engine Copyright (c) 2021 Engine Development Team 
+   https://github.com/beaumanvienna/gfxRenderEngine
+
+   Permission is hereby granted, free of charge, to any person
+   obtaining a copy of this software and associated documentation files
+   (the "Software"), to deal in the Software without restriction,
+   including without limitation the rights to use, copy, modify, merge,
+   publish, distribute, sublicense, and/or sell copies of the Software,
+   and to permit persons to whom the Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be
+   included in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+   MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+   CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, 
+   TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE 
+   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
+
+#pragma once
+
+#include "rendererAPI.h"
+#include "vertexArray.h"
+
+class SWRendererAPI: public RendererAPI
+{
+public:
+    
+public:
+
+    virtual void SetClearColor(const glm::vec4& color) override;
+    virtual void Clear() const override;
+    virtual void EnableBlending() const override;
+    virtual void DisableBlending() const override;
+    virtual void EnableDethTesting() const override;
+    virtual void DisableDethTesting() const override;
+    virtual void EnableScissor() const override;
+    virtual void DisableScissor() const override;
+    virtual void SetScissor(int left, int bottom, int width, int height) const override;
+
+    virtual void DrawIndexed(const std::shared_ptr<VertexArray>& vertexArray) const override;
+    virtual void Finish() const override;
+    
+};
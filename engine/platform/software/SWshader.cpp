@@ -0,0 +1,66 @@
+/* Engine Copyright (c) 2021 Engine Development Team 
+   https://github.com/beaumanvienna/gfxRenderEngine
+
+   Permission is hereby granted, free of charge, to any person
+   obtaining a copy of this software and associated documentation files
+   (the "Software"), to deal in the Software without restriction,
+   including without limitation the rights to use, copy, modify, merge,
+   publish, distribute, sublicense, and/or sell copies of the Software,
+   and to permit persons to whom the Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be
+   included in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+   MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+   CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, 
+   TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE 
+   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
+
+#include "SWshader.h"
+#include "SWdevice.h"
+
+SWShaderProgram::SWShaderProgram()
+    : m_Built(false), m_ViewProjectionMatrix(1.0f)
+{
+}
+
+SWShaderProgram::~SWShaderProgram()
+{
+}
+
+int SWShaderProgram::AddShader(const ShaderProgramTypes type, const std::string& shaderFileName)
+{
+    return 1;
+}
+
+int SWShaderProgram::AddShader(const ShaderProgramTypes type, const char* path /* GNU */, int resourceID /* MSVC */, const std::string& resourceClass /* MSVC */)
+{
+    return 1;
+}
+
+int SWShaderProgram::Build()
+{
+    m_Built = true;
+    Bind();
+    LOG_CORE_INFO("Shader creation successful (software renderer)");
+    return 1;
+}
+
+void SWShaderProgram::Bind() const
+{
+    SWDevice::Get().SetViewProjectionMatrix(m_ViewProjectionMatrix);
+}
+
+// like glUniform*(), this applies to the bound program
+void SWShaderProgram::SetUniformMat4f(const std::string& name, const glm::mat4& modelViewProjection)
+{
+    if (name == "u_ViewProjectionMatrix")
+    {
+        m_ViewProjectionMatrix = modelViewProjection;
+        SWDevice::Get().SetViewProjectionMatrix(m_ViewProjectionMatrix);
+    }
+}
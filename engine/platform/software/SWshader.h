@@ -0,0 +1,55 @@
+/* Engine Copyright (c) 2021 Engine Development Team 
+   https://github.com/beaumanvienna/gfxRenderEngine
+
+   Permission is hereby granted, free of charge, to any person
+   obtaining a copy of this software and associated documentation files
+   (the "Software"), to deal in the Software without restriction,
+   including without limitation the rights to use, copy, modify, merge,
+   publish, distribute, sublicense, and/or sell copies of the Software,
+   and to permit persons to whom the Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be
+   included in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+   MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+   CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, 
+   TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE 
+   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
+
+#pragma once
+
+#include "engine.h"
+#include "shader.h"
+
+// The software renderer has a fixed pipeline that does what vertexShader.vert
+// and fragmentShader.frag do: transform by u_ViewProjectionMatrix, sample
+// u_Textures[a_TextureIndex] and multiply with a_Color. The GLSL sources
+// are accepted but not used.
+class SWShaderProgram: public ShaderProgram
+{
+
+public:
+
+    SWShaderProgram();
+    ~SWShaderProgram();
+    virtual int AddShader(const ShaderProgramTypes type, const std::string& shaderFileName) override;
+    virtual int AddShader(const ShaderProgramTypes type, const char* path /* GNU */, int resourceID /* MSVC */, const std::string& resourceClass /* MSVC */) override;
+    virtual int Build() override;
+    virtual void Bind() const override;
+    virtual void Unbind() const override {}
+    virtual bool IsOK() const override { return m_Built; }
+    virtual void SetUniform4f(const std::string& name, float v0, float v1, float v2, float v3) override {}
+    virtual void SetUniform1i(const std::string& name, int i0) override {}
+    virtual void SetUniform1iv(const std::string& name, int count, int* i0) override {}
+    virtual void SetUniformMat4f(const std::string& name, const glm::mat4& modelViewProjection) override;
+
+private:
+
+    bool m_Built;
+    glm::mat4 m_ViewProjectionMatrix;
+    
+};
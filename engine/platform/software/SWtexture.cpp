@@ -0,0 +1,245 @@
+/* Engine Copyright (c) 2021 Engine Development Team 
+   https://github.com/beaumanvienna/gfxRenderEngine
+
+   Permission is hereby granted, free of charge, to any person
+   obtaining a copy of this software and associated documentation files
+   (the "Software"), to deal in the Software without restriction,
+   including without limitation the rights to use, copy, modify, merge,
+   publish, distribute, sublicense, and/or sell copies of the Software,
+   and to permit persons to whom the Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be
+   included in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+   MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+   CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, 
+   TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE 
+   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
+
+#include <string>
+#include <cstring>
+
+#include "log.h"
+#include "SWtexture.h"
+#include "SWdevice.h"
+#include "stb_image.h"
+#include "core.h"
+
+SWTexture::SWTexture()
+    : m_RendererID(0), m_OwnsImage(false), m_FileName(""),
+      m_Width(0), m_Height(0), m_BytesPerPixel(0), m_TextureSlot(-1)
+{
+}
+
+// wraps an image of the device, e.g. a framebuffer attachment
+SWTexture::SWTexture(uint ID, int internalFormat, int dataFormat, int type)
+    : m_RendererID(ID), m_OwnsImage(false), m_FileName(""),
+      m_Width(0), m_Height(0), m_BytesPerPixel(4)
+{
+    m_TextureSlot = Engine::m_TextureSlotManager->GetTextureSlot();
+    SWDevice::Image* image = SWDevice::Get().GetImage(m_RendererID);
+    if (image)
+    {
+        m_Width = image->m_Width;
+        m_Height = image->m_Height;
+    }
+}
+
+SWTexture::~SWTexture()
+{
+    if (Engine::m_TextureManager)
+    {
+        Engine::m_TextureManager->Cancel(this);
+    }
+    if (m_TextureSlot > -1)
+    {
+        Engine::m_TextureSlotManager->RemoveTextureSlot(m_TextureSlot);
+    }
+    if (m_OwnsImage)
+    {
+        SWDevice::Get().DeleteImage(m_RendererID);
+    }
+}
+
+// create texture from raw memory
+bool SWTexture::Init(const uint width, const uint height, const void* data)
+{
+    m_FileName = "raw memory";
+    if (!data)
+    {
+        return false;
+    }
+    m_Width = width;
+    m_Height = height;
+    return Create(data);
+}
+
+// create texture from file on disk
+bool SWTexture::Init(const std::string& fileName)
+{
+    bool ok = false;
+    m_FileName = fileName;
+
+    if (Engine::m_TextureManager)
+    {
+        // decoded on a worker thread, the texture manager uploads it later
+        if (Engine::m_TextureManager->Load(this, m_FileName, m_Width, m_Height))
+        {
+            ok = Create(nullptr);
+        }
+    }
+    else
+    {
+        stbi_set_flip_vertically_on_load(true);
+        uchar* pixels = stbi_load(m_FileName.c_str(), &m_Width, &m_Height, &m_BytesPerPixel, 4);
+        if (pixels)
+        {
+            ok = Create(pixels);
+            stbi_image_free(pixels);
+        }
+    }
+
+    if (!ok)
+    {
+        std::cout << "Texture: Couldn't load file " << m_FileName << std::endl;
+    }
+    return ok;
+}
+
+// create texture from file in memory
+bool SWTexture::Init(const unsigned char* data, int length)
+{
+    bool ok = false;
+    m_FileName = "file in memory";
+
+    if (Engine::m_TextureManager)
+    {
+        if (Engine::m_TextureManager->Load(this, data, length, m_Width, m_Height))
+        {
+            ok = Create(nullptr);
+        }
+    }
+    else
+    {
+        stbi_set_flip_vertically_on_load(true);
+        uchar* pixels = stbi_load_from_memory(data, length, &m_Width, &m_Height, &m_BytesPerPixel, 4);
+        if (pixels)
+        {
+            ok = Create(pixels);
+            stbi_image_free(pixels);
+        }
+    }
+
+    if (!ok)
+    {
+        std::cout << "Texture: Couldn't load file " << m_FileName << std::endl;
+    }
+    return ok;
+}
+
+// create texture from framebuffer attachment
+bool SWTexture::Init(const uint width, const uint height, const uint rendererID)
+{
+    m_RendererID = rendererID;
+    m_OwnsImage = false;
+    m_Width = width;
+    m_Height = height;
+    m_TextureSlot = Engine::m_TextureSlotManager->GetTextureSlot();
+    m_FileName = "framebuffer";
+    return true;
+}
+
+// RGBA, a null pointer allocates a transparent
+// texture and leaves it to be blitted later
+bool SWTexture::Create(const void* data)
+{
+    m_TextureSlot = Engine::m_TextureSlotManager->GetTextureSlot();
+    m_RendererID = SWDevice::Get().CreateImage();
+    m_OwnsImage = true;
+    m_BytesPerPixel = 4;
+
+    SWDevice::Image* image = SWDevice::Get().GetImage(m_RendererID);
+    image->m_Width = m_Width;
+    image->m_Height = m_Height;
+    image->m_Pixels.assign(m_Width * m_Height, 0);
+    if (data)
+    {
+        memcpy(image->m_Pixels.data(), data, m_Width * m_Height * sizeof(uint));
+    }
+    return true;
+}
+
+void SWTexture::Bind() const
+{
+    Engine::m_TextureSlotManager->BindTexture(m_TextureSlot, m_RendererID);
+}
+
+int SWTexture::BindToBatch() const
+{
+    return Engine::m_TextureSlotManager->PinTexture(m_TextureSlot, m_RendererID);
+}
+
+void SWTexture::Unbind() const
+{
+    Engine::m_TextureSlotManager->UnbindTexture(m_TextureSlot);
+}
+
+void SWTexture::Blit(uint x, uint y, uint width, uint height, uint bytesPerPixel, const void* data)
+{
+    SWDevice::Image* image = SWDevice::Get().GetImage(m_RendererID);
+    if (!image || ((x + width) > static_cast<uint>(image->m_Width)) || ((y + height) > static_cast<uint>(image->m_Height)))
+    {
+        LOG_CORE_ERROR("SWTexture::Blit: out of bounds for {0}", m_FileName);
+        return;
+    }
+    if ((bytesPerPixel != 4) && (bytesPerPixel != 3))
+    {
+        LOG_CORE_CRITICAL("data format for {0} not supported", m_FileName);
+        return;
+    }
+    m_BytesPerPixel = bytesPerPixel;
+
+    const uchar* source = static_cast<const uchar*>(data);
+    for (uint row = 0; row < height; row++)
+    {
+        uint* destination = &image->m_Pixels[(y + row) * image->m_Width + x];
+        if (bytesPerPixel == 4)
+        {
+            memcpy(destination, source, width * sizeof(uint));
+        }
+        else
+        {
+            for (uint column = 0; column < width; column++)
+            {
+                const uchar* pixel = source + column * 3;
+                destination[column] = pixel[0] | (pixel[1] << 8) | (pixel[2] << 16) | (0xffu << 24);
+            }
+        }
+        source += width * bytesPerPixel;
+    }
+}
+
+// data format and type are GL enums,
+// the software renderer only knows RGBA8
+void SWTexture::Blit(uint x, uint y, uint width, uint height, int dataFormat, int type, const void* data)
+{
+    Blit(x, y, width, height, 4u, data);
+}
+
+void SWTexture::Resize(uint width, uint height)
+{
+    m_Width = width;
+    m_Height = height;
+
+    SWDevice::Image* image = SWDevice::Get().GetImage(m_RendererID);
+    if (image)
+    {
+        image->m_Width = m_Width;
+        image->m_Height = m_Height;
+        image->m_Pixels.assign(m_Width * m_Height, 0);
+    }
+}
@@ -0,0 +1,176 @@
+/* Engine Copyright (c) 2021 Engine Development Team 
+   https://github.com/beaumanvienna/gfxRenderEngine
+
+   Permission is hereby granted, free of charge, to any person
+   obtaining a copy of this software and associated documentation files
+   (the "Software"), to deal in the Software without restriction,
+   including without limitation the rights to use, copy, modify, merge,
+   publish, distribute, sublicense, and/or sell copies of the Software,
+   and to permit persons to whom the Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be
+   included in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+   MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+   CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, 
+   TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE 
+   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
+
+#include "SWtextureSlotManager.h"
+#include "SWdevice.h"
+
+SWTextureSlotManager::SWTextureSlotManager()
+    : m_PinnedUnits(0), m_UseCounter(0)
+{
+    m_TextureUnits.resize(MAX_TEXTURE_UNITS);
+}
+
+uint SWTextureSlotManager::GetTextureSlot()
+{
+    uint slot;
+    if (m_FreeSlots.size())
+    {
+        slot = m_FreeSlots.back();
+        m_FreeSlots.pop_back();
+    }
+    else
+    {
+        slot = m_Residency.size();
+        m_Residency.push_back(NO_UNIT);
+    }
+    return slot;
+}
+
+void SWTextureSlotManager::RemoveTextureSlot(uint slot)
+{
+    int unit = m_Residency[slot];
+    if (unit != NO_UNIT)
+    {
+        if (m_TextureUnits[unit].m_Pinned)
+        {
+            m_PinnedUnits--;
+        }
+        SWDevice::Get().BindTextureUnit(unit, 0);
+        m_TextureUnits[unit] = TextureUnit();
+        m_Residency[slot] = NO_UNIT;
+    }
+    m_FreeSlots.push_back(slot);
+}
+
+// prefers an empty texture unit, otherwise the least recently used one,
+// pinned texture units are never evicted
+int SWTextureSlotManager::FindTextureUnit() const
+{
+    int unit = NO_UNIT;
+    uint64 lastUse = UINT64_MAX;
+    for (uint index = 0; index < m_TextureUnits.size(); index++)
+    {
+        const TextureUnit& textureUnit = m_TextureUnits[index];
+        if (textureUnit.m_Pinned)
+        {
+            continue;
+        }
+        if (textureUnit.m_Slot == NO_SLOT)
+        {
+            return index;
+        }
+        if (textureUnit.m_LastUse < lastUse)
+        {
+            lastUse = textureUnit.m_LastUse;
+            unit = index;
+        }
+    }
+    return unit;
+}
+
+uint SWTextureSlotManager::Bind(uint slot, uint rendererID, uint unit)
+{
+    TextureUnit& textureUnit = m_TextureUnits[unit];
+    if (textureUnit.m_Slot != NO_SLOT)
+    {
+        m_Residency[textureUnit.m_Slot] = NO_UNIT;
+        m_Statistics.m_Evictions++;
+    }
+
+    SWDevice::Get().BindTextureUnit(unit, rendererID);
+    m_Statistics.m_Binds++;
+
+    textureUnit.m_Slot = slot;
+    textureUnit.m_RendererID = rendererID;
+    textureUnit.m_Pinned = false;
+    m_Residency[slot] = unit;
+    return unit;
+}
+
+uint SWTextureSlotManager::BindTexture(uint slot, uint rendererID)
+{
+    int unit = m_Residency[slot];
+    if (unit == NO_UNIT)
+    {
+        unit = Bind(slot, rendererID, FindTextureUnit());
+    }
+    m_TextureUnits[unit].m_LastUse = ++m_UseCounter;
+    return unit;
+}
+
+int SWTextureSlotManager::PinTexture(uint slot, uint rendererID)
+{
+    int unit = m_Residency[slot];
+    if ((unit != NO_UNIT) && m_TextureUnits[unit].m_Pinned)
+    {
+        m_TextureUnits[unit].m_LastUse = ++m_UseCounter;
+        return unit;
+    }
+
+    // one texture unit always stays available for uploads
+    if (m_PinnedUnits == m_TextureUnits.size() - 1)
+    {
+        return NO_UNIT;
+    }
+
+    if (unit == NO_UNIT)
+    {
+        unit = Bind(slot, rendererID, FindTextureUnit());
+    }
+    TextureUnit& textureUnit = m_TextureUnits[unit];
+    textureUnit.m_LastUse = ++m_UseCounter;
+    textureUnit.m_Pinned = true;
+    m_PinnedUnits++;
+    return unit;
+}
+
+void SWTextureSlotManager::UnpinAll()
+{
+    for (auto& textureUnit : m_TextureUnits)
+    {
+        textureUnit.m_Pinned = false;
+    }
+    m_PinnedUnits = 0;
+}
+
+void SWTextureSlotManager::UnbindTexture(uint slot)
+{
+    int unit = m_Residency[slot];
+    if ((unit == NO_UNIT) || m_TextureUnits[unit].m_Pinned)
+    {
+        return;
+    }
+    SWDevice::Get().BindTextureUnit(unit, 0);
+    m_TextureUnits[unit] = TextureUnit();
+    m_Residency[slot] = NO_UNIT;
+}
+
+// nothing outside of the engine binds textures on the SWDevice
+void SWTextureSlotManager::RestoreBindings()
+{
+}
+
+void SWTextureSlotManager::EndFrame()
+{
+    m_LastFrameStatistics = m_Statistics;
+    m_Statistics = Statistics();
+}
@@ -0,0 +1,80 @@
+/* Engine Copyright (c) 2021 Engine Development Team 
+   https://github.com/beaumanvienna/gfxRenderEngine
+
+   Permission is hereby granted, free of charge, to any person
+   obtaining a copy of this software and associated documentation files
+   (the "Software"), to deal in the Software without restriction,
+   including without limitation the rights to use, copy, modify, merge,
+   publish, distribute, sublicense, and/or sell copies of the Software,
+   and to permit persons to whom the Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be
+   included in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+   MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+   CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, 
+   TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE 
+   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
+
+#pragma once
+#include <vector>
+
+#include "engine.h"
+#include "textureSlotManager.h"
+
+// same policy as the GL texture slot manager,
+// the texture units are the ones of the SWDevice
+class SWTextureSlotManager : public TextureSlotManager
+{
+
+public:
+
+    SWTextureSlotManager();
+
+    virtual uint GetTextureSlot() override;
+    virtual void RemoveTextureSlot(uint slot) override;
+    virtual uint GetNumberOfTextureSlots() const override { return m_TextureUnits.size(); }
+
+    virtual uint BindTexture(uint slot, uint rendererID) override;
+    virtual int  PinTexture(uint slot, uint rendererID) override;
+    virtual void UnpinAll() override;
+    virtual void UnbindTexture(uint slot) override;
+    virtual void RestoreBindings() override;
+
+    virtual void EndFrame() override;
+    virtual const Statistics& GetStatistics() const override { return m_LastFrameStatistics; }
+
+private:
+
+    struct TextureUnit
+    {
+        int    m_Slot = NO_SLOT;
+        uint   m_RendererID = 0;
+        uint64 m_LastUse = 0;
+        bool   m_Pinned = false;
+    };
+
+private:
+
+    int  FindTextureUnit() const;
+    uint Bind(uint slot, uint rendererID, uint unit);
+
+private:
+
+    static constexpr int NO_SLOT = -1;
+    static constexpr int NO_UNIT = -1;
+
+    std::vector<TextureUnit> m_TextureUnits;
+    std::vector<int> m_Residency;             // virtual slot -> texture unit
+    std::vector<uint> m_FreeSlots;            // recycled virtual slots
+    uint m_PinnedUnits;
+    uint64 m_UseCounter;
+
+    Statistics m_Statistics;
+    Statistics m_LastFrameStatistics;
+
+};
@@ -0,0 +1,62 @@
+/* Engine Copyright (c) 2021 Engine Development Team 
+   https://github.com/beaumanvienna/gfxRenderEngine
+
+   Permission is hereby granted, free of charge, to any person
+   obtaining a copy of this software and associated documentation files
+   (the "Software"), to deal in the Software without restriction,
+   including without limitation the rights to use, copy, modify, merge,
+   publish, distribute, sublicense, and/or sell copies of the Software,
+   and to permit persons to whom the Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be
+   included in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+   MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+   CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, 
+   TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE 
+   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
+
+#include <cstring>
+
+#include "SWvertexBuffer.h"
+
+SWVertexBuffer::SWVertexBuffer(BufferMode bufferMode)
+    : m_BufferMode(bufferMode), m_BufferOffset(0), m_Capacity(0), m_DroppedBytes(0)
+{
+}
+
+SWVertexBuffer::~SWVertexBuffer()
+{
+}
+
+void SWVertexBuffer::Create(uint count)
+{
+    m_Capacity = m_Layout.GetStride() * count;
+    m_Data.resize(m_Capacity);
+    m_BufferOffset = 0;
+}
+
+void SWVertexBuffer::LoadBuffer(const void* verticies, uint size)
+{
+    if ((m_BufferOffset + size) > m_Capacity)
+    {
+        // reported once per draw call in EndScene()
+        m_DroppedBytes += size;
+        return;
+    }
+
+    memcpy(&m_Data[m_BufferOffset], verticies, size);
+    m_BufferOffset += size;
+}
+
+void SWVertexBuffer::EndScene()
+{
+    if (m_DroppedBytes)
+    {
+        LOG_CORE_ERROR("SWVertexBuffer: vertex buffer overflow, {0} verticies were dropped (capacity {1})", m_DroppedBytes / m_Layout.GetStride(), GetCapacity());
+    }
+}
@@ -0,0 +1,42 @@
+/* Engine Copyright (c) 2021 Engine Development Team 
+   https://github.com/beaumanvienna/gfxRenderEngine
+
+   Permission is hereby granted, free of charge, to any person
+   obtaining a copy of this software and associated documentation files
+   (the "Software"), to deal in the Software without restriction,
+   including without limitation the rights to use, copy, modify, merge,
+   publish, distribute, sublicense, and/or sell copies of the Software,
+   and to permit persons to whom the Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be
+   included in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+   MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+   CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, 
+   TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE 
+   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
+
+#include "SWwindow.h"
+#include "SWdevice.h"
+
+SW_Window::SW_Window(const WindowProperties& props)
+    : m_OK(false), m_StartTime(std::chrono::steady_clock::now())
+{
+    m_Width  = (props.m_Width  > 0) ? props.m_Width  : DEFAULT_WIDTH;
+    m_Height = (props.m_Height > 0) ? props.m_Height : DEFAULT_HEIGHT;
+    SWDevice::Get().ResizeDefaultRenderTarget(m_Width, m_Height);
+
+    m_GraphicsContext = GraphicsContext::Create(nullptr, 60);
+    m_OK = m_GraphicsContext->Init();
+    LOG_CORE_INFO("Software renderer: {0}x{1} offscreen window", m_Width, m_Height);
+}
+
+double SW_Window::GetTime() const
+{
+    std::chrono::duration<double> time = std::chrono::steady_clock::now() - m_StartTime;
+    return time.count();
+}
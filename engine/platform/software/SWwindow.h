@@ -0,0 +1,74 @@
+/* Engine Copyright (c) 2021 Engine Development Team 
+   https://github.com/beaumanvienna/gfxRenderEngine
+
+   Permission is hereby granted, free of charge, to any person
+   obtaining a copy of this software and associated documentation files
+   (the "Software"), to deal in the Software without restriction,
+   including without limitation the rights to use, copy, modify, merge,
+   publish, distribute, sublicense, and/or sell copies of the Software,
+   and to permit persons to whom the Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be
+   included in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+   MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+   CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, 
+   TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE 
+   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
+
+#pragma once
+
+#include <chrono>
+
+#include "engine.h"
+#include "window.h"
+#include "event.h"
+#include "graphicsContext.h"
+
+// an invisible window backed by the default render target of the SWDevice
+class SW_Window : public Window
+{
+    
+public:
+    
+    SW_Window(const WindowProperties& props);
+    ~SW_Window() override {}
+    
+    void* GetWindow() const override { return nullptr; }
+    std::shared_ptr<GraphicsContext> GetGraphicsContent() const override { return m_GraphicsContext; }
+    void OnUpdate() override {}
+    uint GetWidth()  const override { return m_Width; }
+    uint GetHeight() const override { return m_Height; }
+    
+    void SetEventCallback(const EventCallbackFunction& callback) override { m_EventCallback = callback; }
+    void SetVSync(int interval) override {}
+    void ToggleFullscreen() override {}
+    bool IsFullscreen() override { return false; }
+    bool IsOK() const override { return m_OK; }
+    void SetWindowAspectRatio() override {}
+    void SetWindowAspectRatio(int numer, int denom) override {}
+    float GetWindowAspectRatio() const override { return m_Width / (1.0f * m_Height); }
+    double GetTime() const override;
+    
+    void EnableMousePointer() override {}
+    void DisableMousePointer() override {}
+    virtual void AllowCursor() override {}
+    virtual void DisallowCursor() override {}
+
+private:
+
+    static constexpr int DEFAULT_WIDTH  = 1920;
+    static constexpr int DEFAULT_HEIGHT = 1080;
+
+    bool m_OK;
+    int m_Width;
+    int m_Height;
+    EventCallbackFunction m_EventCallback;
+    std::shared_ptr<GraphicsContext> m_GraphicsContext;
+    std::chrono::steady_clock::time_point m_StartTime;
+
+};
@@ -28,6 +28,7 @@
 #include "window.h"
 #include "rendererAPI.h"
 #include "GLFWwindow.h"
+#include "SWwindow.h"
 
 std::unique_ptr<Window> Window::Create(const WindowProperties& props)
 {
@@ -38,6 +39,9 @@ std::unique_ptr<Window> Window::Create(const WindowProperties& props)
         case RendererAPI::OPENGL:
             m_Window = std::make_unique<GLFW_Window>(props);
             break;
+        case RendererAPI::SOFTWARE:
+            m_Window = std::make_unique<SW_Window>(props);
+            break;
         default:
             m_Window = nullptr;
             break;
@@ -0,0 +1,70 @@
+/* Engine Copyright (c) 2021 Engine Development Team 
+   https://github.com/beaumanvienna/gfxRenderEngine
+
+   Permission is hereby granted, free of charge, to any person
+   obtaining a copy of this software and associated documentation files
+   (the "Software"), to deal in the Software without restriction,
+   including without limitation the rights to use, copy, modify, merge,
+   publish, distribute, sublicense, and/or sell copies of the Software,
+   and to permit persons to whom the Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be
+   included in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+   MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+   CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, 
+   TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE 
+   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
+
+
+#include "benchmarkScene.h"
+#include "resources.h"
+
+BenchmarkScene::BenchmarkScene(const char* benchmarkName, BufferMode bufferMode)
+    : m_OK(false)
+{
+    std::shared_ptr<VertexBuffer> vertexBuffer = VertexBuffer::Create(bufferMode);
+    VertexBufferLayout vertexBufferLayout =
+    {
+        {ShaderDataType::Float3, "a_Position"},
+        {ShaderDataType::Float2, "a_TextureCoordinate"},
+        {ShaderDataType::Int,    "a_TextureIndex"},
+        {ShaderDataType::Float4, "a_Color"}
+    };
+    vertexBuffer->SetLayout(vertexBufferLayout);
+    vertexBuffer->Create(NUMBER_OF_VERTICIES);
+
+    std::shared_ptr<IndexBuffer> indexBuffer = IndexBuffer::Create(bufferMode);
+    m_VertexArray = VertexArray::Create();
+    m_VertexArray->AddVertexBuffer(vertexBuffer);
+    m_VertexArray->AddIndexBuffer(indexBuffer);
+    indexBuffer->Create(NUMBER_OF_VERTICIES);
+
+    m_Shader = ShaderProgram::Create();
+    m_Shader->AddShader(ShaderProgram::VERTEX_SHADER, "/text/../engine/shader/vertexShader.vert", IDR_VERTEX_SHADER, "TEXT");
+    m_Shader->AddShader(ShaderProgram::FRAGMENT_SHADER, "/text/../engine/shader/fragmentShader.frag", IDR_FRAGMENT_SHADER, "TEXT");
+    m_Shader->Build();
+    if (!m_Shader->IsOK())
+    {
+        LOG_CORE_ERROR("{0}: shader creation failed", benchmarkName);
+        return;
+    }
+
+    m_Renderer = std::make_shared<Renderer>();
+    m_OK = true;
+}
+
+void BenchmarkScene::BeginScene(std::shared_ptr<OrthographicCamera>& camera)
+{
+    m_Renderer->BeginScene(camera, m_Shader, m_VertexArray);
+}
+
+void BenchmarkScene::EndScene()
+{
+    m_Renderer->Submit(m_VertexArray);
+    m_Renderer->EndScene();
+}
@@ -0,0 +1,59 @@
+/* Engine Copyright (c) 2021 Engine Development Team 
+   https://github.com/beaumanvienna/gfxRenderEngine
+
+   Permission is hereby granted, free of charge, to any person
+   obtaining a copy of this software and associated documentation files
+   (the "Software"), to deal in the Software without restriction,
+   including without limitation the rights to use, copy, modify, merge,
+   publish, distribute, sublicense, and/or sell copies of the Software,
+   and to permit persons to whom the Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be
+   included in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+   MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+   CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, 
+   TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE 
+   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
+
+
+#pragma once
+
+#include <memory>
+
+#include "engine.h"
+#include "buffer.h"
+#include "renderer.h"
+
+// what the headless renderer benchmarks share: a batch renderer with the sprite
+// shader of the engine, drawing into a vertex array of its own
+class BenchmarkScene
+{
+
+public:
+
+    static constexpr uint NUMBER_OF_VERTICIES = 65536;
+
+    BenchmarkScene(const char* benchmarkName, BufferMode bufferMode = BUFFER_MODE_STREAMING);
+
+    // false if the shader could not be built
+    bool IsOK() const { return m_OK; }
+
+    void BeginScene(std::shared_ptr<OrthographicCamera>& camera);
+    void EndScene();
+
+    std::shared_ptr<Renderer>& GetRenderer() { return m_Renderer; }
+    std::shared_ptr<VertexArray>& GetVertexArray() { return m_VertexArray; }
+
+private:
+
+    bool m_OK;
+    std::shared_ptr<VertexArray> m_VertexArray;
+    std::shared_ptr<ShaderProgram> m_Shader;
+    std::shared_ptr<Renderer> m_Renderer;
+
+};
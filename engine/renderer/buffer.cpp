@@ -29,15 +29,22 @@
 #include "rendererAPI.h"
 #include "GLindexBuffer.h"
 #include "GLvertexBuffer.h"
+#include "GLinstanceBuffer.h"
+#include "SWindexBuffer.h"
+#include "SWvertexBuffer.h"
+#include "SWinstanceBuffer.h"
 
-std::shared_ptr<VertexBuffer> VertexBuffer::Create()
+std::shared_ptr<VertexBuffer> VertexBuffer::Create(BufferMode bufferMode)
 {
     std::shared_ptr<VertexBuffer> vertexBuffer;
 
     switch(RendererAPI::GetAPI())
     {
         case RendererAPI::OPENGL:
-            vertexBuffer = std::make_shared<GLVertexBuffer>();
+            vertexBuffer = std::make_shared<GLVertexBuffer>(bufferMode);
+            break;
+        case RendererAPI::SOFTWARE:
+            vertexBuffer = std::make_shared<SWVertexBuffer>(bufferMode);
             break;
         default:
             vertexBuffer = nullptr;
@@ -47,14 +54,17 @@ std::shared_ptr<VertexBuffer> VertexBuffer::Create()
     return vertexBuffer;
 }
 
-std::shared_ptr<IndexBuffer> IndexBuffer::Create()
+std::shared_ptr<IndexBuffer> IndexBuffer::Create(BufferMode bufferMode)
 {
     std::shared_ptr<IndexBuffer> indexBuffer;
 
     switch(RendererAPI::GetAPI())
     {
         case RendererAPI::OPENGL:
-            indexBuffer = std::make_shared<GLIndexBuffer>();
+            indexBuffer = std::make_shared<GLIndexBuffer>(bufferMode);
+            break;
+        case RendererAPI::SOFTWARE:
+            indexBuffer = std::make_shared<SWIndexBuffer>(bufferMode);
             break;
         default:
             indexBuffer = nullptr;
@@ -64,3 +74,22 @@ std::shared_ptr<IndexBuffer> IndexBuffer::Create()
     return indexBuffer;
 }
 
+std::shared_ptr<InstanceBuffer> InstanceBuffer::Create()
+{
+    std::shared_ptr<InstanceBuffer> instanceBuffer;
+
+    switch(RendererAPI::GetAPI())
+    {
+        case RendererAPI::OPENGL:
+            instanceBuffer = std::make_shared<GLInstanceBuffer>();
+            break;
+        case RendererAPI::SOFTWARE:
+            instanceBuffer = std::make_shared<SWInstanceBuffer>();
+            break;
+        default:
+            instanceBuffer = nullptr;
+            break;
+    }
+
+    return instanceBuffer;
+}
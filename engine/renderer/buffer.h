@@ -29,8 +29,20 @@
 
 #include "window.h"
 #include <memory>
+#include "glm.hpp"
 #include "vertexBufferLayout.h"
 
+class SpriteInstances;
+
+// BUFFER_MODE_DYNAMIC:   every LoadBuffer() is uploaded on its own, the index buffer is rebuilt per draw call
+// BUFFER_MODE_STREAMING: verticies are staged on the CPU and uploaded once per draw call into a
+//                        fenced ring buffer, the index buffer holds static quad indices
+enum BufferMode
+{
+    BUFFER_MODE_DYNAMIC,
+    BUFFER_MODE_STREAMING
+};
+
 class VertexBuffer
 {
 
@@ -48,13 +60,17 @@ public:
     virtual void Create(uint count) = 0;
     virtual void LoadBuffer(const void* verticies, uint size) = 0;
     virtual void BeginScene() = 0;
+    virtual void EndScene() = 0;
     virtual void Bind() const = 0;
     virtual void Unbind() const = 0;
+    virtual uint GetBaseVertex() const = 0;
+    virtual uint GetCapacity() const = 0; // number of verticies
+    virtual BufferMode GetBufferMode() const = 0;
     
     virtual const VertexBufferLayout& GetLayout() const = 0;
     virtual void SetLayout(const VertexBufferLayout& layout) = 0;
     
-    static std::shared_ptr<VertexBuffer> Create();
+    static std::shared_ptr<VertexBuffer> Create(BufferMode bufferMode = BUFFER_MODE_STREAMING);
 
 };
 
@@ -70,6 +86,7 @@ public:
 
     virtual ~IndexBuffer() {}
     
+    virtual void Create(uint count) = 0;
     virtual void AddObject(IndexBufferObject object) = 0;
     virtual void BeginScene() = 0;
     virtual void EndScene() = 0;
@@ -77,8 +94,22 @@ public:
     virtual void Bind() const = 0;
     virtual void Unbind() const = 0;
     virtual uint GetCount() const = 0;
+    virtual BufferMode GetBufferMode() const = 0;
     
-    static std::shared_ptr<IndexBuffer> Create();
+    static std::shared_ptr<IndexBuffer> Create(BufferMode bufferMode = BUFFER_MODE_STREAMING);
 
 };
 
+// draws SpriteInstances with a single instanced draw call, the vertex shader builds the quads
+class InstanceBuffer
+{
+public:
+
+    virtual ~InstanceBuffer() {}
+
+    // textureUnits[i] is the texture unit that instances.GetTexture(i) is bound to
+    virtual void Draw(const SpriteInstances& instances, const int* textureUnits, const glm::mat4& viewProjectionMatrix) = 0;
+
+    static std::shared_ptr<InstanceBuffer> Create();
+
+};
@@ -23,6 +23,7 @@
 #include "rendererAPI.h"
 #include "cursor.h"
 #include "GLcursor.h"
+#include "SWcursor.h"
 
 std::shared_ptr<Cursor> Cursor::Create()
 {
@@ -33,6 +34,9 @@ std::shared_ptr<Cursor> Cursor::Create()
         case RendererAPI::OPENGL:
             cursor = std::make_shared<GLCursor>();
             break;
+        case RendererAPI::SOFTWARE:
+            cursor = std::make_shared<SWCursor>();
+            break;
         default:
             cursor = nullptr;
             break;
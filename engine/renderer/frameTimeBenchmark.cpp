@@ -0,0 +1,93 @@
+/* Engine Copyright (c) 2021 Engine Development Team 
+   https://github.com/beaumanvienna/gfxRenderEngine
+
+   Permission is hereby granted, free of charge, to any person
+   obtaining a copy of this software and associated documentation files
+   (the "Software"), to deal in the Software without restriction,
+   including without limitation the rights to use, copy, modify, merge,
+   publish, distribute, sublicense, and/or sell copies of the Software,
+   and to permit persons to whom the Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be
+   included in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+   MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+   CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, 
+   TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE 
+   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
+
+#include <chrono>
+#include <vector>
+#include <numeric>
+#include <algorithm>
+
+#include "frameTimeBenchmark.h"
+#include "core.h"
+#include "renderer.h"
+#include "textureManager.h"
+
+FrameTimeBenchmark::FrameTimeBenchmark(uint frames, uint warmUpFrames)
+    : m_Frames(frames), m_WarmUpFrames(warmUpFrames)
+{
+    m_Frames = std::max(m_Frames, 1u);
+}
+
+bool FrameTimeBenchmark::Run(Engine& engine, std::shared_ptr<Application>& application)
+{
+    engine.SetAppEventCallback([&](Event& event) { application->OnEvent(event); } );
+    if (!application->Start())
+    {
+        LOG_CORE_CRITICAL("FrameTimeBenchmark: could not start application");
+        return false;
+    }
+
+    // textures are decoded asynchronously, they have to be in place before measuring
+    Engine::m_TextureManager->Flush();
+
+    auto frame = [&]()
+    {
+        engine.OnUpdate();
+        application->OnUpdate();
+        engine.OnRender();
+    };
+
+    for (uint warmUpFrame = 0; warmUpFrame < m_WarmUpFrames; warmUpFrame++)
+    {
+        frame();
+    }
+
+    std::vector<double> frameTimes(m_Frames);
+    uint64 quads = 0, batches = 0;
+    for (uint index = 0; index < m_Frames; index++)
+    {
+        auto start = std::chrono::steady_clock::now();
+        frame();
+        auto end = std::chrono::steady_clock::now();
+
+        std::chrono::duration<double, std::milli> milliseconds = end - start;
+        frameTimes[index] = milliseconds.count();
+        if (engine.GetRenderer())
+        {
+            quads   += engine.GetRenderer()->GetStatistics().m_Quads;
+            batches += engine.GetRenderer()->GetStatistics().m_Batches;
+        }
+    }
+
+    application->Shutdown();
+
+    double average = std::accumulate(frameTimes.begin(), frameTimes.end(), 0.0) / m_Frames;
+    std::sort(frameTimes.begin(), frameTimes.end());
+    double median = frameTimes[m_Frames / 2];
+    double percentile99 = frameTimes[std::min(m_Frames - 1, (m_Frames * 99) / 100)];
+    double maximum = frameTimes.back();
+
+    LOG_CORE_INFO("FrameTimeBenchmark: {0} frames, {1}x{2}", m_Frames, engine.GetWindowWidth(), engine.GetWindowHeight());
+    LOG_CORE_INFO("FrameTimeBenchmark: average {0:.3f} ms ({1:.1f} fps), median {2:.3f} ms, 99th percentile {3:.3f} ms, max {4:.3f} ms",
+                    average, 1000.0 / average, median, percentile99, maximum);
+    LOG_CORE_INFO("FrameTimeBenchmark: {0} quads, {1} batches per frame", quads / m_Frames, batches / m_Frames);
+    return true;
+}
@@ -28,6 +28,7 @@
 #include "framebuffer.h"
 #include "rendererAPI.h"
 #include "GLframebuffer.h"
+#include "SWframebuffer.h"
 
 std::shared_ptr<Framebuffer> Framebuffer::Create(const FramebufferSpecification& spec)
 {
@@ -38,6 +39,9 @@ std::shared_ptr<Framebuffer> Framebuffer::Create(const FramebufferSpecification&
         case RendererAPI::OPENGL:
             framebuffer = std::make_shared<GLFramebuffer>(spec);
             break;
+        case RendererAPI::SOFTWARE:
+            framebuffer = std::make_shared<SWFramebuffer>(spec);
+            break;
         default:
             framebuffer = nullptr;
             break;
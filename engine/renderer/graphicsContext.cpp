@@ -28,6 +28,7 @@
 #include "graphicsContext.h"
 #include "rendererAPI.h"
 #include "GLGraphicsContext.h"
+#include "SWgraphicsContext.h"
 
 std::shared_ptr<GraphicsContext> GraphicsContext::Create(void* window, uint refreshRate)
 {
@@ -38,6 +39,9 @@ std::shared_ptr<GraphicsContext> GraphicsContext::Create(void* window, uint refr
         case RendererAPI::OPENGL:
             graphicsContext = std::make_shared<GLContext>(static_cast<GLFWwindow*>(window), refreshRate);
             break;
+        case RendererAPI::SOFTWARE:
+            graphicsContext = std::make_shared<SWGraphicsContext>();
+            break;
         default:
             graphicsContext = nullptr;
             break;
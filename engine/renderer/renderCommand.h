@@ -87,6 +87,12 @@ public:
     {
         s_RendererAPI->DrawIndexed(vertexArray);
     }
+
+    // block until all submitted draw calls are completed
+    static void Finish()
+    {
+        s_RendererAPI->Finish();
+    }
     
     static std::unique_ptr<RendererAPI> s_RendererAPI;
     
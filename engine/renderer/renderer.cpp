@@ -25,59 +25,296 @@
    be found under https://github.com/TheCherno/Hazel/blob/master/LICENSE
    */
    
+#include <algorithm>
+#include <cmath>
+
+#include "core.h"
 #include "renderer.h"
 #include "rendererAPI.h"
 #include "renderCommand.h"
 
 Renderer::Renderer()
+    : m_BatchQuads(0), m_MaxBatchQuads(0), m_Clip(false)
 { 
     RendererAPI::Create(); 
+    m_BatchTextures.reserve(TextureSlotManager::MAX_TEXTURE_UNITS);
 }
 
 void Renderer::BeginScene(std::shared_ptr<OrthographicCamera>& camera, 
                             std::shared_ptr<ShaderProgram>& shader, 
-                            std::shared_ptr<VertexBuffer>& vertexBuffer, 
-                            std::shared_ptr<IndexBuffer>& indexBuffer)
+                            std::shared_ptr<VertexArray>& vertexArray)
 {
-    m_IndexBuffer = indexBuffer;
-    m_VertexBuffer = vertexBuffer;
+    m_VertexArray = vertexArray;
+    m_VertexBuffer = vertexArray->GetVertexBuffers()[0];
+    m_IndexBuffer = vertexArray->GetIndexBuffers()[0];
     m_Shader = shader;
     
     m_Shader->Bind();
     m_VertexBuffer->BeginScene();
     m_IndexBuffer->BeginScene();
+    m_BatchTextures.clear();
+    Engine::m_TextureSlotManager->UnpinAll();
+    m_BatchQuads = 0;
+    m_MaxBatchQuads = m_VertexBuffer->GetCapacity() / 4;
     
-    m_Shader->SetUniformMat4f("u_ViewProjectionMatrix", camera->GetViewProjectionMatrix());
+    m_ViewProjectionMatrix = camera->GetViewProjectionMatrix();
+    m_Shader->SetUniformMat4f("u_ViewProjectionMatrix", m_ViewProjectionMatrix);
 }
 
 void Renderer::EndScene()
 {
 }
 
-void Renderer::Draw(std::shared_ptr<Texture> texture, const glm::mat4& position, const float depth, const glm::vec4& color)
+void Renderer::EndFrame()
+{
+    m_LastFrameStatistics = m_Statistics;
+    m_Statistics = Statistics();
+}
+
+void Renderer::Draw(const std::shared_ptr<Texture>& texture, const glm::mat4& position, const float depth, const glm::vec4& color)
 {
-    int textureSlot = texture->GetTextureSlot();
     glm::vec4 textureCoordinates(0.0f, 0.0f, 1.0f, 1.0f); // entire texture
-    FillVertexBuffer(textureSlot, position, depth, color, textureCoordinates);
+    ClipAndFillVertexBuffer(texture, position, depth, color, textureCoordinates);
 }
 
-void Renderer::Draw(std::shared_ptr<Texture> texture, const glm::mat4& position, const glm::vec4 textureCoordinates, const float depth, const glm::vec4& color)
+void Renderer::Draw(const std::shared_ptr<Texture>& texture, const glm::mat4& position, const glm::vec4& textureCoordinates, const float depth, const glm::vec4& color)
 {
-    int textureSlot = texture->GetTextureSlot();
-    FillVertexBuffer(textureSlot, position, depth, color, textureCoordinates);
+    ClipAndFillVertexBuffer(texture, position, depth, color, textureCoordinates);
 }
 
 void Renderer::Draw(Sprite* sprite, const glm::mat4& position, const float depth, const glm::vec4& color)
 {
-    int textureSlot = sprite->GetTextureSlot();
     glm::vec4 textureCoordinates(sprite->m_Pos1X, sprite->m_Pos1Y, sprite->m_Pos2X, sprite->m_Pos2Y);
-    FillVertexBuffer(textureSlot, position, depth, color, textureCoordinates);
+    ClipAndFillVertexBuffer(sprite->m_Texture, position, depth, color, textureCoordinates);
+}
+
+void Renderer::DrawQuads(const std::shared_ptr<Texture>& texture, float* verticies, uint quads)
+{
+    while (quads)
+    {
+        if (m_BatchQuads == m_MaxBatchQuads)
+        {
+            Flush(FLUSH_VERTEX_CAPACITY);
+        }
+        int textureSlot = GetBatchTextureSlot(texture);
+        float textureSlotFloat = CastToFloat(textureSlot);
+        uint count = std::min(quads, m_MaxBatchQuads - m_BatchQuads);
+
+        // the slot can differ between the parts of a block that is split across a flush,
+        // so every vertex of this part gets it
+        for (uint vertex = 0; vertex < count * 4; vertex++)
+        {
+            verticies[vertex * FLOATS_PER_VERTEX + TEXTURE_SLOT_OFFSET] = textureSlotFloat;
+        }
+
+        for (uint quad = 0; quad < count; quad++)
+        {
+            m_IndexBuffer->AddObject(IndexBuffer::INDEX_BUFFER_QUAD);
+        }
+        m_BatchQuads += count;
+        m_VertexBuffer->LoadBuffer(verticies, count * FLOATS_PER_QUAD * sizeof(float));
+
+        verticies += count * FLOATS_PER_QUAD;
+        quads -= count;
+    }
+}
+
+void Renderer::DrawInstances(const SpriteInstances& instances)
+{
+    if (!instances.GetCount())
+    {
+        return;
+    }
+    Flush(FLUSH_INSTANCES);
+
+    if (!m_InstanceBuffer)
+    {
+        m_InstanceBuffer = InstanceBuffer::Create();
+    }
+
+    // all texture units are free after the flush
+    int textureUnits[SpriteInstances::MAX_TEXTURES];
+    for (uint index = 0; index < instances.GetNumberOfTextures(); index++)
+    {
+        textureUnits[index] = instances.GetTexture(index)->BindToBatch();
+    }
+
+    m_InstanceBuffer->Draw(instances, textureUnits, m_ViewProjectionMatrix);
+    Engine::m_TextureSlotManager->UnpinAll();
+
+    m_Statistics.m_Batches++;
+    m_Statistics.m_Instances += instances.GetCount();
+}
+
+void Renderer::SetClipRect(const glm::vec4& clipRect)
+{
+    m_Clip = true;
+    m_ClipRect = clipRect;
+}
+
+void Renderer::ResetClipRect()
+{
+    m_Clip = false;
+}
+
+// moves the ends a and b of an edge into [low, high], interpolating
+// their texture coordinates ta and tb along with them
+static void ClipEdge(float& a, float& b, float& ta, float& tb, float low, float high)
+{
+    float clippedA = std::clamp(a, low, high);
+    float clippedB = std::clamp(b, low, high);
+    float textureScale = (tb - ta) / (b - a);
+
+    ta += (clippedA - a) * textureScale;
+    tb += (clippedB - b) * textureScale;
+    a = clippedA;
+    b = clippedB;
+}
+
+// Clipping happens on the CPU so that it doesn't break up the batch. Quads that are outside of
+// the clip rectangle are dropped. Axis-aligned quads are cut down to the clip rectangle: their
+// texture coordinate u changes along the edge from vertex 0 to vertex 1 and v along the edge
+// from vertex 1 to vertex 2, horizontally and vertically, or the other way around for rotated
+// sprites. Anything else that crosses the clip rectangle falls back to the scissor test.
+void Renderer::ClipAndFillVertexBuffer(const std::shared_ptr<Texture>& texture, const glm::mat4& position, const float depth, const glm::vec4& color, const glm::vec4& textureCoordinates)
+{
+    if (!m_Clip)
+    {
+        FillVertexBuffer(texture, position, depth, color, textureCoordinates);
+        return;
+    }
+
+    float minX = std::min(std::min(position[0][0], position[1][0]), std::min(position[2][0], position[3][0]));
+    float maxX = std::max(std::max(position[0][0], position[1][0]), std::max(position[2][0], position[3][0]));
+    float minY = std::min(std::min(position[0][1], position[1][1]), std::min(position[2][1], position[3][1]));
+    float maxY = std::max(std::max(position[0][1], position[1][1]), std::max(position[2][1], position[3][1]));
+
+    if ((maxX <= m_ClipRect.x) || (minX >= m_ClipRect.z) || (maxY <= m_ClipRect.y) || (minY >= m_ClipRect.w) ||
+        (minX == maxX) || (minY == maxY))
+    {
+        m_Statistics.m_CulledQuads++;
+        return;
+    }
+
+    if ((minX >= m_ClipRect.x) && (maxX <= m_ClipRect.z) && (minY >= m_ClipRect.y) && (maxY <= m_ClipRect.w))
+    {
+        FillVertexBuffer(texture, position, depth, color, textureCoordinates);
+        return;
+    }
+
+    bool uAlongX = (position[0][1] == position[1][1]) && (position[1][0] == position[2][0]) &&
+                   (position[2][1] == position[3][1]) && (position[3][0] == position[0][0]);
+    bool uAlongY = (position[0][0] == position[1][0]) && (position[1][1] == position[2][1]) &&
+                   (position[2][0] == position[3][0]) && (position[3][1] == position[0][1]);
+
+    if (!uAlongX && !uAlongY)
+    {
+        FillVertexBufferScissored(texture, position, depth, color, textureCoordinates);
+        return;
+    }
+
+    glm::mat4 clippedPosition = position;
+    glm::vec4 clippedTextureCoordinates = textureCoordinates;
+    if (uAlongX)
+    {
+        // vertices 0 and 3 are at x1, 1 and 2 at x2; 0 and 1 are at y1, 2 and 3 at y2
+        float x1 = position[0][0], x2 = position[1][0];
+        float y1 = position[0][1], y2 = position[2][1];
+        ClipEdge(x1, x2, clippedTextureCoordinates.x, clippedTextureCoordinates.z, m_ClipRect.x, m_ClipRect.z);
+        ClipEdge(y1, y2, clippedTextureCoordinates.y, clippedTextureCoordinates.w, m_ClipRect.y, m_ClipRect.w);
+        clippedPosition[0][0] = clippedPosition[3][0] = x1;
+        clippedPosition[1][0] = clippedPosition[2][0] = x2;
+        clippedPosition[0][1] = clippedPosition[1][1] = y1;
+        clippedPosition[2][1] = clippedPosition[3][1] = y2;
+    }
+    else
+    {
+        // vertices 0 and 3 are at y1, 1 and 2 at y2; 0 and 1 are at x1, 2 and 3 at x2
+        float y1 = position[0][1], y2 = position[1][1];
+        float x1 = position[0][0], x2 = position[2][0];
+        ClipEdge(y1, y2, clippedTextureCoordinates.x, clippedTextureCoordinates.z, m_ClipRect.y, m_ClipRect.w);
+        ClipEdge(x1, x2, clippedTextureCoordinates.y, clippedTextureCoordinates.w, m_ClipRect.x, m_ClipRect.z);
+        clippedPosition[0][1] = clippedPosition[3][1] = y1;
+        clippedPosition[1][1] = clippedPosition[2][1] = y2;
+        clippedPosition[0][0] = clippedPosition[1][0] = x1;
+        clippedPosition[2][0] = clippedPosition[3][0] = x2;
+    }
+
+    m_Statistics.m_ClippedQuads++;
+    FillVertexBuffer(texture, clippedPosition, depth, color, clippedTextureCoordinates);
+}
+
+// the quad gets a batch of its own, drawn with the clip rectangle as scissor box
+void Renderer::FillVertexBufferScissored(const std::shared_ptr<Texture>& texture, const glm::mat4& position, const float depth, const glm::vec4& color, const glm::vec4& textureCoordinates)
+{
+    Flush(FLUSH_SCISSOR);
+
+    float windowWidth  = Engine::m_Engine->GetWindowWidth();
+    float windowHeight = Engine::m_Engine->GetWindowHeight();
+
+    // the clip rectangle in window pixels
+    float left = windowWidth, right = 0.0f, bottom = windowHeight, top = 0.0f;
+    glm::vec2 corners[4] =
+    {
+        {m_ClipRect.x, m_ClipRect.y},
+        {m_ClipRect.z, m_ClipRect.y},
+        {m_ClipRect.z, m_ClipRect.w},
+        {m_ClipRect.x, m_ClipRect.w}
+    };
+    for (auto& corner : corners)
+    {
+        glm::vec4 normalizedDeviceCoordinates = m_ViewProjectionMatrix * glm::vec4(corner.x, corner.y, depth, 1.0f);
+        float x = (normalizedDeviceCoordinates.x + 1.0f) * 0.5f * windowWidth;
+        float y = (normalizedDeviceCoordinates.y + 1.0f) * 0.5f * windowHeight;
+        left   = std::min(left, x);
+        right  = std::max(right, x);
+        bottom = std::min(bottom, y);
+        top    = std::max(top, y);
+    }
+    int scissorLeft   = floorf(left);
+    int scissorBottom = floorf(bottom);
+    int scissorWidth  = std::max(0.0f, ceilf(right - left));
+    int scissorHeight = std::max(0.0f, ceilf(top - bottom));
+
+    RenderCommand::SetScissor(scissorLeft, scissorBottom, scissorWidth, scissorHeight);
+    FillVertexBuffer(texture, position, depth, color, textureCoordinates);
+    Flush(FLUSH_SCISSOR);
+    RenderCommand::SetScissor(0, 0, windowWidth, windowHeight);
+}
+
+// textures stay bound to their texture unit for the duration of a batch,
+// the batch is flushed when no texture unit is left
+int Renderer::GetBatchTextureSlot(const std::shared_ptr<Texture>& texture)
+{
+    for (auto it = m_BatchTextures.rbegin(); it != m_BatchTextures.rend(); it++)
+    {
+        if (it->m_Texture == texture)
+        {
+            return it->m_TextureUnit;
+        }
+    }
+
+    int textureUnit = texture->BindToBatch();
+    if (textureUnit == -1)
+    {
+        Flush(FLUSH_TEXTURE_SLOTS);
+        textureUnit = texture->BindToBatch();
+    }
+    m_BatchTextures.push_back({texture, textureUnit});
+    return textureUnit;
 }
     
-void Renderer::FillVertexBuffer(const int textureSlot, const glm::mat4& position, const float depth, const glm::vec4& color, const glm::vec4& textureCoordinates)
+void Renderer::FillVertexBuffer(const std::shared_ptr<Texture>& texture, const glm::mat4& position, const float depth, const glm::vec4& color, const glm::vec4& textureCoordinates)
 {
+    if (m_BatchQuads == m_MaxBatchQuads)
+    {
+        Flush(FLUSH_VERTEX_CAPACITY);
+    }
+    int textureSlot = GetBatchTextureSlot(texture);
+
     //fill index buffer object (ibo)
     m_IndexBuffer->AddObject(IndexBuffer::INDEX_BUFFER_QUAD);
+    m_BatchQuads++;
 
     float pos1X = textureCoordinates.x; 
     float pos2X = textureCoordinates.z;    
@@ -95,9 +332,31 @@ void Renderer::FillVertexBuffer(const int textureSlot, const glm::mat4& position
     m_VertexBuffer->LoadBuffer(verticies, sizeof(verticies));
 }
 
-void Renderer::Submit(const std::shared_ptr<VertexArray>& vertexArray)
+void Renderer::Flush(FlushReason reason)
 {
-    vertexArray->Bind();
-    RenderCommand::DrawIndexed(vertexArray);
+    if (m_BatchQuads)
+    {
+        // the textures of this batch are already bound (pinned) to the
+        // texture units baked into its verticies
+        m_Shader->Bind();
+        m_VertexArray->Bind();
+        RenderCommand::DrawIndexed(m_VertexArray);
+
+        m_Statistics.m_Batches++;
+        m_Statistics.m_Quads += m_BatchQuads;
+        m_Statistics.m_Flushes[reason]++;
+    }
+
+    // start a new batch
+    m_VertexBuffer->BeginScene();
+    m_IndexBuffer->BeginScene();
+    m_BatchTextures.clear();
+    Engine::m_TextureSlotManager->UnpinAll();
+    m_BatchQuads = 0;
 }
 
+void Renderer::Submit(const std::shared_ptr<VertexArray>& vertexArray)
+{
+    m_VertexArray = vertexArray;
+    Flush(FLUSH_SUBMIT);
+}
@@ -28,12 +28,14 @@
 #pragma once
 
 #include <memory>
+#include <vector>
 #include "engine.h"
 #include "glm.hpp"
 #include "vertexArray.h"
 #include "orthographicCamera.h"
 #include "shader.h"
 #include "spritesheet.h"
+#include "spriteInstances.h"
 
 class Renderer
 {
@@ -41,6 +43,33 @@ public:
 
     static glm::mat4 normalizedPosition;
 
+    // layout of the verticies of a quad: position (3), texture coordinates (2), texture slot (1), color (4)
+    static constexpr uint FLOATS_PER_VERTEX = 10;
+    static constexpr uint FLOATS_PER_QUAD = 4 * FLOATS_PER_VERTEX;
+    static constexpr uint TEXTURE_SLOT_OFFSET = 5;
+
+    enum FlushReason
+    {
+        FLUSH_SUBMIT,
+        FLUSH_VERTEX_CAPACITY,
+        FLUSH_TEXTURE_SLOTS,
+        FLUSH_SCISSOR,
+        FLUSH_INSTANCES,
+        NUMBER_OF_FLUSH_REASONS
+    };
+
+    struct Statistics
+    {
+        uint m_Batches = 0;
+        uint m_Quads = 0;
+        uint m_Flushes[NUMBER_OF_FLUSH_REASONS] = {};
+        uint m_ClippedQuads = 0;
+        uint m_CulledQuads = 0;
+        uint m_Instances = 0;
+    };
+
+public:
+
     Renderer();
     
     // a draw call requires a vertex array (with a vertex buffer bound to it), index buffer, and bound shaders
@@ -48,21 +77,60 @@ public:
         
     virtual void BeginScene(std::shared_ptr<OrthographicCamera>& camera, 
                             std::shared_ptr<ShaderProgram>& shader, 
-                            std::shared_ptr<VertexBuffer>& vertexBuffer, 
-                            std::shared_ptr<IndexBuffer>& indexBuffer);
+                            std::shared_ptr<VertexArray>& vertexArray);
     virtual void EndScene();
+
+    // called once per frame, before the buffers are swapped
+    void EndFrame();
+    const Statistics& GetStatistics() const { return m_LastFrameStatistics; }
     
     void Draw(Sprite* sprite, const glm::mat4& position, const float depth = 0.0f, const glm::vec4& color = glm::vec4(1.0f));
-    void Draw(std::shared_ptr<Texture> texture, const glm::mat4& position, const float depth, const glm::vec4& color = glm::vec4(1.0f));
-    void Draw(std::shared_ptr<Texture> texture, const glm::mat4& position, const glm::vec4 textureCoordinates, const float depth, const glm::vec4& color = glm::vec4(1.0f));
+    void Draw(const std::shared_ptr<Texture>& texture, const glm::mat4& position, const float depth, const glm::vec4& color = glm::vec4(1.0f));
+    void Draw(const std::shared_ptr<Texture>& texture, const glm::mat4& position, const glm::vec4& textureCoordinates, const float depth, const glm::vec4& color = glm::vec4(1.0f));
+
+    // appends quads with verticies that were built up front (see FLOATS_PER_QUAD), all using the same texture;
+    // their texture slot is written into them, they are not clipped (SetClipRect() doesn't apply)
+    void DrawQuads(const std::shared_ptr<Texture>& texture, float* verticies, uint quads);
+    // draws the sprites with one instanced draw call after the current batch, they are not clipped
+    void DrawInstances(const SpriteInstances& instances);
+    const glm::mat4& GetViewProjectionMatrix() const { return m_ViewProjectionMatrix; }
+
+    // quads drawn until ResetClipRect() are clipped to this rectangle (min x, min y, max x, max y),
+    // given in the same coordinates as their position
+    void SetClipRect(const glm::vec4& clipRect);
+    void ResetClipRect();
     
 private:
 
-    void FillVertexBuffer(const int textureSlot, const glm::mat4& position, const float depth, const glm::vec4& color, const glm::vec4& textureCoordinates);
+    void FillVertexBuffer(const std::shared_ptr<Texture>& texture, const glm::mat4& position, const float depth, const glm::vec4& color, const glm::vec4& textureCoordinates);
+    void ClipAndFillVertexBuffer(const std::shared_ptr<Texture>& texture, const glm::mat4& position, const float depth, const glm::vec4& color, const glm::vec4& textureCoordinates);
+    void FillVertexBufferScissored(const std::shared_ptr<Texture>& texture, const glm::mat4& position, const float depth, const glm::vec4& color, const glm::vec4& textureCoordinates);
+    int GetBatchTextureSlot(const std::shared_ptr<Texture>& texture);
+    void Flush(FlushReason reason);
 
 private:
 
+    struct BatchTexture
+    {
+        std::shared_ptr<Texture> m_Texture;
+        int m_TextureUnit;
+    };
+
+    std::shared_ptr<VertexArray> m_VertexArray;
     std::shared_ptr<IndexBuffer> m_IndexBuffer;
     std::shared_ptr<VertexBuffer> m_VertexBuffer;
     std::shared_ptr<ShaderProgram> m_Shader;
+    std::shared_ptr<InstanceBuffer> m_InstanceBuffer;
+
+    // current batch
+    uint m_BatchQuads, m_MaxBatchQuads;
+    std::vector<BatchTexture> m_BatchTextures;
+
+    // clipping
+    bool m_Clip;
+    glm::vec4 m_ClipRect;
+    glm::mat4 m_ViewProjectionMatrix;
+
+    Statistics m_Statistics;
+    Statistics m_LastFrameStatistics;
 };
@@ -28,6 +28,7 @@
 #include "rendererAPI.h"
 #include "renderCommand.h"
 #include "GLrendererAPI.h"
+#include "SWrendererAPI.h"
 
 RendererAPI::API RendererAPI::s_API;
 
@@ -38,6 +39,9 @@ void RendererAPI::Create()
         case RendererAPI::OPENGL:
             RenderCommand::s_RendererAPI = std::make_unique<GLRendererAPI>();
             break;
+        case RendererAPI::SOFTWARE:
+            RenderCommand::s_RendererAPI = std::make_unique<SWRendererAPI>();
+            break;
         default:
             RenderCommand::s_RendererAPI = nullptr;
             break;
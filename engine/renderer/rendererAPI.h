@@ -41,7 +41,8 @@ public:
     enum API
     {
         OPENGL,
-        VULKAN
+        VULKAN,
+        SOFTWARE  // headless, tile-based rasterizer on the CPU
     };
     
 public:
@@ -59,6 +60,7 @@ public:
     virtual void SetScissor(int left, int bottom, int width, int height) const = 0;
 
     virtual void DrawIndexed(const std::shared_ptr<VertexArray>& vertexArray) const = 0;
+    virtual void Finish() const = 0;
     
     static void Create();
     
@@ -0,0 +1,98 @@
+/* Engine Copyright (c) 2021 Engine Development Team 
+   https://github.com/beaumanvienna/gfxRenderEngine
+
+   Permission is hereby granted, free of charge, to any person
+   obtaining a copy of this software and associated documentation files
+   (the "Software"), to deal in the Software without restriction,
+   including without limitation the rights to use, copy, modify, merge,
+   publish, distribute, sublicense, and/or sell copies of the Software,
+   and to permit persons to whom the Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be
+   included in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+   MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+   CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, 
+   TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE 
+   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
+
+#include <chrono>
+#include <algorithm>
+
+#include "rendererBenchmark.h"
+#include "benchmarkScene.h"
+#include "renderCommand.h"
+#include "texture.h"
+#include "orthographicCamera.h"
+
+RendererBenchmark::RendererBenchmark(uint quadsPerFrame, uint frames)
+    : m_QuadsPerFrame(quadsPerFrame), m_Frames(frames)
+{
+    // one draw call per frame
+    m_QuadsPerFrame = std::min(m_QuadsPerFrame, BenchmarkScene::NUMBER_OF_VERTICIES / 4);
+}
+
+void RendererBenchmark::Run()
+{
+    LOG_CORE_INFO("RendererBenchmark: {0} quads per frame, {1} frames", m_QuadsPerFrame, m_Frames);
+
+    double dynamicQuadsPerSecond   = QuadsPerSecond(BUFFER_MODE_DYNAMIC);
+    double streamingQuadsPerSecond = QuadsPerSecond(BUFFER_MODE_STREAMING);
+
+    LOG_CORE_INFO("RendererBenchmark: dynamic buffers:   {0:.0f} quads/s", dynamicQuadsPerSecond);
+    LOG_CORE_INFO("RendererBenchmark: streaming buffers: {0:.0f} quads/s", streamingQuadsPerSecond);
+    if (dynamicQuadsPerSecond > 0.0)
+    {
+        LOG_CORE_INFO("RendererBenchmark: speed-up {0:.2f}x", streamingQuadsPerSecond / dynamicQuadsPerSecond);
+    }
+}
+
+double RendererBenchmark::QuadsPerSecond(BufferMode bufferMode)
+{
+    BenchmarkScene scene("RendererBenchmark", bufferMode);
+    if (!scene.IsOK())
+    {
+        return 0.0;
+    }
+    std::shared_ptr<Renderer>& renderer = scene.GetRenderer();
+    std::shared_ptr<OrthographicCamera> camera = std::make_shared<OrthographicCamera>();
+
+    uint whitePixel = 0xffffffff;
+    std::shared_ptr<Texture> texture = Texture::Create();
+    texture->Init(1, 1, &whitePixel);
+    texture->Bind();
+
+    glm::mat4 position
+    (
+        -1.0f,  1.0f, 0.0f, 1.0f,
+         1.0f,  1.0f, 0.0f, 1.0f,
+         1.0f, -1.0f, 0.0f, 1.0f,
+        -1.0f, -1.0f, 0.0f, 1.0f
+    );
+
+    // warm-up frame
+    scene.BeginScene(camera);
+    renderer->Draw(texture, position, 0.0f);
+    renderer->Submit(scene.GetVertexArray());
+    RenderCommand::Finish();
+
+    auto start = std::chrono::steady_clock::now();
+    for (uint frame = 0; frame < m_Frames; frame++)
+    {
+        scene.BeginScene(camera);
+        for (uint quad = 0; quad < m_QuadsPerFrame; quad++)
+        {
+            renderer->Draw(texture, position, 0.0f);
+        }
+        scene.EndScene();
+    }
+    RenderCommand::Finish();
+    auto end = std::chrono::steady_clock::now();
+
+    std::chrono::duration<double> seconds = end - start;
+    return static_cast<double>(m_QuadsPerFrame) * m_Frames / seconds.count();
+}
@@ -0,0 +1,121 @@
+/* Engine Copyright (c) 2021 Engine Development Team 
+   https://github.com/beaumanvienna/gfxRenderEngine
+
+   Permission is hereby granted, free of charge, to any person
+   obtaining a copy of this software and associated documentation files
+   (the "Software"), to deal in the Software without restriction,
+   including without limitation the rights to use, copy, modify, merge,
+   publish, distribute, sublicense, and/or sell copies of the Software,
+   and to permit persons to whom the Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be
+   included in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+   MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+   CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, 
+   TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE 
+   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
+
+
+#include <chrono>
+#include <vector>
+#include <random>
+#include <algorithm>
+
+#include "spriteBenchmark.h"
+#include "benchmarkScene.h"
+#include "renderCommand.h"
+#include "texture.h"
+#include "orthographicCamera.h"
+#include "spriteInstances.h"
+#include "matrix.h"
+
+SpriteBenchmark::SpriteBenchmark(uint frames)
+    : m_Frames(frames)
+{
+    m_Frames = std::max(m_Frames, 1u);
+}
+
+void SpriteBenchmark::Run()
+{
+    static constexpr uint STAR_SIZE = 4;
+    static constexpr float SPEED = 0.5f; // pixels per frame and scale
+
+    BenchmarkScene scene("SpriteBenchmark");
+    if (!scene.IsOK())
+    {
+        return;
+    }
+    std::shared_ptr<Renderer>& renderer = scene.GetRenderer();
+    std::shared_ptr<OrthographicCamera> camera = std::make_shared<OrthographicCamera>(-960.0f, 960.0f, -540.0f, 540.0f, 1.0f, -1.0f);
+
+    std::vector<uint> pixels(STAR_SIZE * STAR_SIZE, 0xffffffff);
+    std::shared_ptr<Texture> texture = Texture::Create();
+    texture->Init(STAR_SIZE, STAR_SIZE, pixels.data());
+    Sprite star(0.0f, 1.0f, 1.0f, 0.0f, STAR_SIZE, STAR_SIZE, texture, "star");
+
+    LOG_CORE_INFO("SpriteBenchmark: star field, {0} frames", m_Frames);
+    for (uint stars = 1000; stars <= 100000; stars *= 10)
+    {
+        // stars further away are smaller and slower
+        std::mt19937 random(stars);
+        std::uniform_real_distribution<float> randomX(-960.0f, 960.0f), randomY(-540.0f, 540.0f), randomScale(0.25f, 2.0f);
+        std::vector<float> x(stars), y(stars), scale(stars);
+        for (uint index = 0; index < stars; index++)
+        {
+            x[index] = randomX(random);
+            y[index] = randomY(random);
+            scale[index] = randomScale(random);
+        }
+        std::vector<float> positionX(stars);
+        auto move = [&](uint frame)
+        {
+            for (uint index = 0; index < stars; index++)
+            {
+                positionX[index] = fmodf(x[index] + 960.0f + frame * SPEED * scale[index], 1920.0f) - 960.0f;
+            }
+        };
+
+        auto start = std::chrono::steady_clock::now();
+        for (uint frame = 0; frame < m_Frames; frame++)
+        {
+            move(frame);
+            scene.BeginScene(camera);
+            for (uint index = 0; index < stars; index++)
+            {
+                glm::vec3 translation{positionX[index], y[index], 0.0f};
+                glm::mat4 position = Translate(translation) * Scale({scale[index], scale[index], 1.0f}) * star.GetScaleMatrix();
+                renderer->Draw(&star, position);
+            }
+            scene.EndScene();
+        }
+        RenderCommand::Finish();
+        auto end = std::chrono::steady_clock::now();
+        std::chrono::duration<double, std::milli> perSpriteMilliseconds = end - start;
+
+        SpriteInstances instances;
+        instances.Reserve(stars);
+        start = std::chrono::steady_clock::now();
+        for (uint frame = 0; frame < m_Frames; frame++)
+        {
+            move(frame);
+            scene.BeginScene(camera);
+            instances.Clear();
+            instances.Add(&star, positionX.data(), y.data(), scale.data(), stars);
+            renderer->DrawInstances(instances);
+            scene.EndScene();
+        }
+        RenderCommand::Finish();
+        end = std::chrono::steady_clock::now();
+        std::chrono::duration<double, std::milli> instancedMilliseconds = end - start;
+
+        double perSprite = perSpriteMilliseconds.count() / m_Frames;
+        double instanced = instancedMilliseconds.count() / m_Frames;
+        LOG_CORE_INFO("SpriteBenchmark: {0} stars: per sprite {1:.3f} ms/frame, instanced {2:.3f} ms/frame, speed-up {3:.1f}x",
+                      stars, perSprite, instanced, instanced > 0.0 ? perSprite / instanced : 0.0);
+    }
+}
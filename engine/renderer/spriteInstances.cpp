@@ -0,0 +1,274 @@
+/* Engine Copyright (c) 2021 Engine Development Team 
+   https://github.com/beaumanvienna/gfxRenderEngine
+
+   Permission is hereby granted, free of charge, to any person
+   obtaining a copy of this software and associated documentation files
+   (the "Software"), to deal in the Software without restriction,
+   including without limitation the rights to use, copy, modify, merge,
+   publish, distribute, sublicense, and/or sell copies of the Software,
+   and to permit persons to whom the Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be
+   included in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+   MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+   CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, 
+   TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE 
+   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
+
+
+#include <cmath>
+#include <cstring>
+#include <algorithm>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include "spriteInstances.h"
+
+SpriteInstances::SpriteInstances()
+{
+    m_Textures.reserve(MAX_TEXTURES);
+}
+
+void SpriteInstances::Clear()
+{
+    for (auto& stream : m_Streams)
+    {
+        stream.clear();
+    }
+    m_Colors.clear();
+    m_TextureIndicies.clear();
+    m_Textures.clear();
+}
+
+void SpriteInstances::Reserve(uint count)
+{
+    for (auto& stream : m_Streams)
+    {
+        stream.reserve(count);
+    }
+    m_Colors.reserve(count);
+    m_TextureIndicies.reserve(count);
+}
+
+uint SpriteInstances::PackColor(const glm::vec4& color)
+{
+    auto channel = [](float value)
+    {
+        return static_cast<uint>(std::clamp(value, 0.0f, 1.0f) * 255.0f + 0.5f);
+    };
+    return channel(color.r) | (channel(color.g) << 8) | (channel(color.b) << 16) | (channel(color.a) << 24);
+}
+
+// the transform of Sprite::GetScaleMatrix(): A, B, C, D
+static void GetSpriteTransform(const Sprite* sprite, float transform[4])
+{
+    float halfWidth  = sprite->GetWidth()  / 2.0f;
+    float halfHeight = sprite->GetHeight() / 2.0f;
+
+    if (sprite->m_Rotated)
+    {
+        // rotated by 90 degrees counter-clockwise
+        transform[0] = 0.0f;
+        transform[1] = halfWidth;
+        transform[2] = -halfHeight;
+        transform[3] = 0.0f;
+    }
+    else
+    {
+        transform[0] = halfWidth;
+        transform[1] = 0.0f;
+        transform[2] = 0.0f;
+        transform[3] = halfHeight;
+    }
+}
+
+static void Fill(float* destination, float value, uint count)
+{
+    uint i = 0;
+#if defined(__SSE2__)
+    const __m128 values = _mm_set1_ps(value);
+    for (; i + 4 <= count; i += 4)
+    {
+        _mm_storeu_ps(destination + i, values);
+    }
+#endif
+    for (; i < count; i++)
+    {
+        destination[i] = value;
+    }
+}
+
+static void Fill(uint* destination, uint value, uint count)
+{
+    uint i = 0;
+#if defined(__SSE2__)
+    const __m128i values = _mm_set1_epi32(value);
+    for (; i + 4 <= count; i += 4)
+    {
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + i), values);
+    }
+#endif
+    for (; i < count; i++)
+    {
+        destination[i] = value;
+    }
+}
+
+// destination[n][i] = transform[n] * scale[i]
+static void ScaleTransform(float* const destination[4], const float transform[4], const float* scale, uint count)
+{
+    uint i = 0;
+#if defined(__SSE2__)
+    const __m128 a = _mm_set1_ps(transform[0]);
+    const __m128 b = _mm_set1_ps(transform[1]);
+    const __m128 c = _mm_set1_ps(transform[2]);
+    const __m128 d = _mm_set1_ps(transform[3]);
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128 scales = _mm_loadu_ps(scale + i);
+        _mm_storeu_ps(destination[0] + i, _mm_mul_ps(a, scales));
+        _mm_storeu_ps(destination[1] + i, _mm_mul_ps(b, scales));
+        _mm_storeu_ps(destination[2] + i, _mm_mul_ps(c, scales));
+        _mm_storeu_ps(destination[3] + i, _mm_mul_ps(d, scales));
+    }
+#endif
+    for (; i < count; i++)
+    {
+        destination[0][i] = transform[0] * scale[i];
+        destination[1][i] = transform[1] * scale[i];
+        destination[2][i] = transform[2] * scale[i];
+        destination[3][i] = transform[3] * scale[i];
+    }
+}
+
+int SpriteInstances::GetTextureIndex(const std::shared_ptr<Texture>& texture)
+{
+    for (uint index = 0; index < m_Textures.size(); index++)
+    {
+        if (m_Textures[index] == texture)
+        {
+            return index;
+        }
+    }
+
+    if (m_Textures.size() == MAX_TEXTURES)
+    {
+        LOG_CORE_WARN("SpriteInstances: no more than {0} textures, sprite dropped", MAX_TEXTURES);
+        return -1;
+    }
+    m_Textures.push_back(texture);
+    return m_Textures.size() - 1;
+}
+
+int SpriteInstances::Append(Sprite* sprite, uint count, const float depth, const glm::vec4& color)
+{
+    int textureIndex = GetTextureIndex(sprite->m_Texture);
+    if (textureIndex == -1)
+    {
+        return -1;
+    }
+
+    uint first = GetCount();
+    for (auto& stream : m_Streams)
+    {
+        stream.resize(first + count);
+    }
+    m_Colors.resize(first + count);
+    m_TextureIndicies.resize(first + count, static_cast<uchar>(textureIndex));
+
+    Fill(&m_Streams[TEXTURE_U1][first], sprite->m_Pos1X, count);
+    Fill(&m_Streams[TEXTURE_V1][first], sprite->m_Pos1Y, count);
+    Fill(&m_Streams[TEXTURE_U2][first], sprite->m_Pos2X, count);
+    Fill(&m_Streams[TEXTURE_V2][first], sprite->m_Pos2Y, count);
+    Fill(&m_Streams[DEPTH][first], depth, count);
+    Fill(&m_Colors[first], PackColor(color), count);
+
+    return first;
+}
+
+void SpriteInstances::Add(Sprite* sprite, const glm::vec2& translation, const float depth, const glm::vec4& color)
+{
+    int index = Append(sprite, 1, depth, color);
+    if (index == -1)
+    {
+        return;
+    }
+
+    float transform[4];
+    GetSpriteTransform(sprite, transform);
+    m_Streams[TRANSFORM_A][index] = transform[0];
+    m_Streams[TRANSFORM_B][index] = transform[1];
+    m_Streams[TRANSFORM_C][index] = transform[2];
+    m_Streams[TRANSFORM_D][index] = transform[3];
+    m_Streams[TRANSLATION_X][index] = translation.x;
+    m_Streams[TRANSLATION_Y][index] = translation.y;
+}
+
+void SpriteInstances::Add(Sprite* sprite, const glm::vec2& translation, const float rotation, const glm::vec2& scale,
+                          const float depth, const glm::vec4& color)
+{
+    int index = Append(sprite, 1, depth, color);
+    if (index == -1)
+    {
+        return;
+    }
+
+    float transform[4];
+    GetSpriteTransform(sprite, transform);
+
+    // rotation * scale * transform
+    float a = scale.x * transform[0], b = scale.y * transform[1];
+    float c = scale.x * transform[2], d = scale.y * transform[3];
+    float cosine = cosf(rotation), sine = sinf(rotation);
+    m_Streams[TRANSFORM_A][index] = cosine * a - sine * b;
+    m_Streams[TRANSFORM_B][index] = sine * a + cosine * b;
+    m_Streams[TRANSFORM_C][index] = cosine * c - sine * d;
+    m_Streams[TRANSFORM_D][index] = sine * c + cosine * d;
+    m_Streams[TRANSLATION_X][index] = translation.x;
+    m_Streams[TRANSLATION_Y][index] = translation.y;
+}
+
+void SpriteInstances::Add(Sprite* sprite, const float* x, const float* y, const float* scale, uint count,
+                          const float depth, const glm::vec4& color)
+{
+    if (!count)
+    {
+        return;
+    }
+
+    int first = Append(sprite, count, depth, color);
+    if (first == -1)
+    {
+        return;
+    }
+
+    float transform[4];
+    GetSpriteTransform(sprite, transform);
+    float* const destination[4] =
+    {
+        &m_Streams[TRANSFORM_A][first],
+        &m_Streams[TRANSFORM_B][first],
+        &m_Streams[TRANSFORM_C][first],
+        &m_Streams[TRANSFORM_D][first]
+    };
+    if (scale)
+    {
+        ScaleTransform(destination, transform, scale, count);
+    }
+    else
+    {
+        for (uint component = 0; component < 4; component++)
+        {
+            Fill(destination[component], transform[component], count);
+        }
+    }
+    memcpy(&m_Streams[TRANSLATION_X][first], x, count * sizeof(float));
+    memcpy(&m_Streams[TRANSLATION_Y][first], y, count * sizeof(float));
+}
@@ -0,0 +1,110 @@
+/* Engine Copyright (c) 2021 Engine Development Team 
+   https://github.com/beaumanvienna/gfxRenderEngine
+
+   Permission is hereby granted, free of charge, to any person
+   obtaining a copy of this software and associated documentation files
+   (the "Software"), to deal in the Software without restriction,
+   including without limitation the rights to use, copy, modify, merge,
+   publish, distribute, sublicense, and/or sell copies of the Software,
+   and to permit persons to whom the Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be
+   included in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+   MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+   CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, 
+   TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE 
+   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
+
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "engine.h"
+#include "sprite.h"
+#include "texture.h"
+#include "glm.hpp"
+
+// Sprites for Renderer::DrawInstances(), one compact record per sprite instead of four verticies:
+// a 2D affine transform, a texture rectangle, a texture, an RGBA8 color and a depth. The vertex
+// shader builds the quads, corner (x, y) of the unit quad [-1, 1] x [-1, 1] is drawn at
+// (A * x + C * y + TRANSLATION_X, B * x + D * y + TRANSLATION_Y).
+//
+// The records are stored as structure of arrays, one stream per component, which go to the GPU
+// as they are. Adding many instances of a sprite at once fills the streams with SIMD.
+// Up to MAX_TEXTURES textures can be used by the instances of one SpriteInstances.
+class SpriteInstances
+{
+
+public:
+
+    static constexpr uint MAX_TEXTURES = 8;
+
+    enum FloatStream
+    {
+        TRANSFORM_A,
+        TRANSFORM_B,
+        TRANSFORM_C,
+        TRANSFORM_D,
+        TRANSLATION_X,
+        TRANSLATION_Y,
+        TEXTURE_U1,
+        TEXTURE_V1,
+        TEXTURE_U2,
+        TEXTURE_V2,
+        DEPTH,
+        NUMBER_OF_FLOAT_STREAMS
+    };
+
+public:
+
+    SpriteInstances();
+
+    void Clear();
+    void Reserve(uint count);
+
+    // looks like Renderer::Draw(sprite, Translate(translation) * sprite->GetScaleMatrix(), depth, color)
+    void Add(Sprite* sprite, const glm::vec2& translation, const float depth = 0.0f, const glm::vec4& color = glm::vec4(1.0f));
+    // the same, scaled and then rotated counter-clockwise by rotation (in radians) around its center
+    void Add(Sprite* sprite, const glm::vec2& translation, const float rotation, const glm::vec2& scale,
+             const float depth = 0.0f, const glm::vec4& color = glm::vec4(1.0f));
+    // count instances of a sprite at (x[i], y[i]), scaled by scale[i] or not at all if scale is nullptr
+    void Add(Sprite* sprite, const float* x, const float* y, const float* scale, uint count,
+             const float depth = 0.0f, const glm::vec4& color = glm::vec4(1.0f));
+
+    uint GetCount() const { return m_Colors.size(); }
+    uint GetNumberOfTextures() const { return m_Textures.size(); }
+    const std::shared_ptr<Texture>& GetTexture(uint index) const { return m_Textures[index]; }
+
+    // GetCount() elements each, can be changed in place, e.g. to move instances
+    float* GetStream(FloatStream stream) { return m_Streams[stream].data(); }
+    const float* GetStream(FloatStream stream) const { return m_Streams[stream].data(); }
+    uint* GetColors() { return m_Colors.data(); }
+    const uint* GetColors() const { return m_Colors.data(); }
+    // index into the textures of this SpriteInstances
+    const uchar* GetTextureIndicies() const { return m_TextureIndicies.data(); }
+
+    // R, G, B, A in memory order
+    static uint PackColor(const glm::vec4& color);
+
+private:
+
+    int GetTextureIndex(const std::shared_ptr<Texture>& texture);
+    // appends count instances with everything but their transform and translation set,
+    // returns the first one or -1 if there is no room for the sprite's texture
+    int Append(Sprite* sprite, uint count, const float depth, const glm::vec4& color);
+
+private:
+
+    std::vector<float> m_Streams[NUMBER_OF_FLOAT_STREAMS];
+    std::vector<uint> m_Colors;
+    std::vector<uchar> m_TextureIndicies;
+    std::vector<std::shared_ptr<Texture>> m_Textures;
+
+};
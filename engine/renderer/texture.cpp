@@ -23,6 +23,7 @@
 #include "rendererAPI.h"
 #include "texture.h"
 #include "GLtexture.h"
+#include "SWtexture.h"
 
 std::shared_ptr<Texture> Texture::Create()
 {
@@ -33,6 +34,9 @@ std::shared_ptr<Texture> Texture::Create()
         case RendererAPI::OPENGL:
             texture = std::make_shared<GLTexture>();
             break;
+        case RendererAPI::SOFTWARE:
+            texture = std::make_shared<SWTexture>();
+            break;
         default:
             texture = nullptr;
             break;
@@ -49,6 +53,9 @@ std::shared_ptr<Texture> Texture::Create(uint ID, int internalFormat, int dataFo
         case RendererAPI::OPENGL:
             texture = std::make_shared<GLTexture>(ID,internalFormat, dataFormat, type);
             break;
+        case RendererAPI::SOFTWARE:
+            texture = std::make_shared<SWTexture>(ID,internalFormat, dataFormat, type);
+            break;
         default:
             texture = nullptr;
             break;
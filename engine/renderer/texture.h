@@ -37,6 +37,8 @@ public:
     virtual bool Init(const unsigned char* data, int length) = 0;
     virtual bool Init(const uint width, const uint height, const uint rendererID) = 0;
     virtual void Bind() const = 0;
+    // binds to a texture unit reserved for the current batch, -1 if none is left
+    virtual int BindToBatch() const = 0;
     virtual void Unbind() const = 0;
     virtual int GetWidth() const = 0;
     virtual int GetHeight() const = 0;
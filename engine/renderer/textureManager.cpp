@@ -0,0 +1,385 @@
+/* Engine Copyright (c) 2021 Engine Development Team 
+   https://github.com/beaumanvienna/gfxRenderEngine
+
+   Permission is hereby granted, free of charge, to any person
+   obtaining a copy of this software and associated documentation files
+   (the "Software"), to deal in the Software without restriction,
+   including without limitation the rights to use, copy, modify, merge,
+   publish, distribute, sublicense, and/or sell copies of the Software,
+   and to permit persons to whom the Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be
+   included in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+   MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+   CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, 
+   TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE 
+   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
+
+#include <algorithm>
+
+#include "log.h"
+#include "textureManager.h"
+#include "instrumentation.h"
+#include "stb_image.h"
+
+TextureManager::Image::~Image()
+{
+    if (m_Pixels)
+    {
+        stbi_image_free(m_Pixels);
+    }
+}
+
+TextureManager::TextureManager()
+    : m_WorkersRun(true), m_CacheSize(0), m_TexturesPruneSize(MIN_TEXTURES_PRUNE_SIZE)
+{
+    uint numberOfWorkers = std::max(1u, std::min(4u, std::thread::hardware_concurrency() / 2));
+    for (uint i = 0; i < numberOfWorkers; i++)
+    {
+        m_Workers.push_back(std::thread([this]() { Worker(); }));
+    }
+}
+
+TextureManager::~TextureManager()
+{
+    {
+        std::lock_guard lock(m_Mutex);
+        m_WorkersRun = false;
+    }
+    m_WorkerWakeup.notify_all();
+    for (auto& worker : m_Workers)
+    {
+        worker.join();
+    }
+}
+
+// FNV-1a
+uint64 TextureManager::Hash(const void* data, size_t length, uint64 hash)
+{
+    const uchar* bytes = static_cast<const uchar*>(data);
+    for (size_t i = 0; i < length; i++)
+    {
+        hash = (hash ^ bytes[i]) * 0x100000001b3;
+    }
+    return hash;
+}
+
+uint64 TextureManager::GetKey(const std::string& fileName)
+{
+    const char prefix[] = "file:";
+    return Hash(fileName.data(), fileName.size(), Hash(prefix, sizeof(prefix)));
+}
+
+bool TextureManager::Load(Texture* texture, const std::string& fileName, int& width, int& height)
+{
+    int channels;
+    if (!stbi_info(fileName.c_str(), &width, &height, &channels))
+    {
+        return false;
+    }
+    return Queue(texture, GetKey(fileName), fileName, nullptr, 0);
+}
+
+bool TextureManager::Load(Texture* texture, const uchar* data, int length, int& width, int& height)
+{
+    int channels;
+    if (!stbi_info_from_memory(data, length, &width, &height, &channels))
+    {
+        return false;
+    }
+    return Queue(texture, Hash(data, length), "file in memory", data, length);
+}
+
+bool TextureManager::Queue(Texture* texture, uint64 key, const std::string& fileName, const uchar* data, int length)
+{
+    std::lock_guard lock(m_Mutex);
+
+    // a texture that is loaded again replaces its earlier request
+    m_Failed.erase(texture);
+    m_PendingUploads.erase(std::remove_if(m_PendingUploads.begin(), m_PendingUploads.end(),
+        [texture](const PendingUpload& upload) { return upload.m_Texture == texture; }), m_PendingUploads.end());
+
+    PendingUpload upload{texture, key, nullptr};
+    auto entry = m_Cache.find(key);
+    if (entry != m_Cache.end())
+    {
+        m_LRUList.splice(m_LRUList.begin(), m_LRUList, entry->second.m_LRU);
+        upload.m_Image = entry->second.m_Image;
+        m_Statistics.m_CacheHits++;
+    }
+    else if (!m_Decoding.count(key))
+    {
+        DecodeJob job{key, fileName};
+        if (data)
+        {
+            // the caller's buffer might not outlive the decode
+            job.m_Data.assign(data, data + length);
+        }
+        m_DecodeJobs.push_back(std::move(job));
+        m_Decoding.insert(key);
+        m_WorkerWakeup.notify_one();
+    }
+    m_PendingUploads.push_back(upload);
+    return true;
+}
+
+void TextureManager::Cancel(Texture* texture)
+{
+    std::lock_guard lock(m_Mutex);
+    m_Failed.erase(texture);
+    m_PendingUploads.erase(std::remove_if(m_PendingUploads.begin(), m_PendingUploads.end(),
+        [texture](const PendingUpload& upload) { return upload.m_Texture == texture; }), m_PendingUploads.end());
+}
+
+bool TextureManager::LoadFailed(const Texture* texture)
+{
+    std::lock_guard lock(m_Mutex);
+    return m_Failed.count(texture);
+}
+
+TextureManager::Statistics TextureManager::GetStatistics()
+{
+    std::lock_guard lock(m_Mutex);
+    return m_Statistics;
+}
+
+void TextureManager::Worker()
+{
+    std::unique_lock lock(m_Mutex);
+    while (true)
+    {
+        m_WorkerWakeup.wait(lock, [this]() { return !m_WorkersRun || !m_DecodeJobs.empty(); });
+        if (!m_WorkersRun)
+        {
+            break;
+        }
+        DecodeJob job = std::move(m_DecodeJobs.front());
+        m_DecodeJobs.pop_front();
+
+        lock.unlock();
+        auto image = std::make_shared<Image>();
+        Decode(job, *image);
+        lock.lock();
+
+        m_Decoding.erase(job.m_Key);
+        m_Statistics.m_Decodes++;
+        if (image->m_Pixels)
+        {
+            m_LRUList.push_front(job.m_Key);
+            m_Cache[job.m_Key] = {image, m_LRUList.begin()};
+            m_CacheSize += image->m_Width * image->m_Height * 4;
+            TrimCache();
+        }
+        for (auto& upload : m_PendingUploads)
+        {
+            if ((upload.m_Key == job.m_Key) && !upload.m_Image)
+            {
+                upload.m_Image = image;
+            }
+        }
+        m_DecodeDone.notify_all();
+    }
+}
+
+void TextureManager::Decode(DecodeJob& job, Image& image)
+{
+    PROFILE_SCOPE("TextureManager::Decode");
+    int channels;
+    stbi_set_flip_vertically_on_load_thread(true);
+    if (job.m_Data.size())
+    {
+        image.m_Pixels = stbi_load_from_memory(job.m_Data.data(), job.m_Data.size(), &image.m_Width, &image.m_Height, &channels, 4);
+    }
+    else
+    {
+        image.m_Pixels = stbi_load(job.m_FileName.c_str(), &image.m_Width, &image.m_Height, &channels, 4);
+    }
+
+    if (!image.m_Pixels)
+    {
+        LOG_CORE_ERROR("TextureManager: couldn't decode {0} ({1})", job.m_FileName, stbi_failure_reason());
+    }
+}
+
+// lock must be held
+void TextureManager::TrimCache()
+{
+    while ((m_CacheSize > CACHE_BUDGET) && (m_LRUList.size() > 1))
+    {
+        auto entry = m_Cache.find(m_LRUList.back());
+        // pending uploads keep their own reference
+        m_CacheSize -= entry->second.m_Image->m_Width * entry->second.m_Image->m_Height * 4;
+        m_Cache.erase(entry);
+        m_LRUList.pop_back();
+    }
+}
+
+// lock must be held
+void TextureManager::PruneTextures()
+{
+    if (m_Textures.size() < m_TexturesPruneSize)
+    {
+        return;
+    }
+
+    for (auto entry = m_Textures.begin(); entry != m_Textures.end();)
+    {
+        if (entry->second.expired())
+        {
+            entry = m_Textures.erase(entry);
+        }
+        else
+        {
+            entry++;
+        }
+    }
+    // amortized, the map is only walked again once it has doubled
+    m_TexturesPruneSize = std::max(MIN_TEXTURES_PRUNE_SIZE, 2 * m_Textures.size());
+}
+
+void TextureManager::Upload(PendingUpload& upload)
+{
+    Image& image = *upload.m_Image;
+    upload.m_Texture->Blit(0, 0, image.m_Width, image.m_Height, 4u, image.m_Pixels);
+}
+
+void TextureManager::Upload(std::vector<PendingUpload>& uploads)
+{
+    // textures are destroyed on the render thread only,
+    // so they can't go away while the lock is released
+    Statistics statistics;
+    std::vector<const Texture*> failed;
+    for (auto& upload : uploads)
+    {
+        if (upload.m_Image->m_Pixels)
+        {
+            Upload(upload);
+            statistics.m_Uploads++;
+            statistics.m_UploadedBytes += upload.m_Image->m_Width * upload.m_Image->m_Height * 4;
+        }
+        else
+        {
+            // the texture keeps its placeholder
+            failed.push_back(upload.m_Texture);
+        }
+    }
+
+    std::lock_guard lock(m_Mutex);
+    m_Statistics.m_Uploads += statistics.m_Uploads;
+    m_Statistics.m_UploadedBytes += statistics.m_UploadedBytes;
+    m_Statistics.m_Failures += failed.size();
+    m_Failed.insert(failed.begin(), failed.end());
+}
+
+void TextureManager::OnUpdate()
+{
+    std::vector<PendingUpload> uploads;
+    {
+        std::lock_guard lock(m_Mutex);
+        if (m_PendingUploads.empty())
+        {
+            return;
+        }
+
+        // at least one texture per frame, however large
+        size_t bytes = 0;
+        auto upload = m_PendingUploads.begin();
+        while (upload != m_PendingUploads.end())
+        {
+            if (!upload->m_Image)
+            {
+                upload++;
+                continue;
+            }
+            size_t size = upload->m_Image->m_Width * upload->m_Image->m_Height * 4;
+            if (bytes && (bytes + size > UPLOAD_BUDGET))
+            {
+                break;
+            }
+            bytes += size;
+            uploads.push_back(std::move(*upload));
+            upload = m_PendingUploads.erase(upload);
+        }
+        PROFILE_COUNTER("pending texture uploads", m_PendingUploads.size());
+    }
+    PROFILE_SCOPE("TextureManager::OnUpdate");
+    Upload(uploads);
+}
+
+void TextureManager::Flush()
+{
+    std::vector<PendingUpload> uploads;
+    {
+        std::unique_lock lock(m_Mutex);
+        m_DecodeDone.wait(lock, [this]() { return m_Decoding.empty(); });
+        uploads.swap(m_PendingUploads);
+    }
+    Upload(uploads);
+}
+
+void TextureManager::ClearCache()
+{
+    std::lock_guard lock(m_Mutex);
+    m_Cache.clear();
+    m_LRUList.clear();
+    m_CacheSize = 0;
+}
+
+std::shared_ptr<Texture> TextureManager::GetTexture(const std::string& fileName)
+{
+    uint64 key = GetKey(fileName);
+    {
+        std::lock_guard lock(m_Mutex);
+        auto entry = m_Textures.find(key);
+        if (entry != m_Textures.end())
+        {
+            if (auto texture = entry->second.lock())
+            {
+                return texture;
+            }
+        }
+    }
+
+    std::shared_ptr<Texture> texture = Texture::Create();
+    if (!texture->Init(fileName))
+    {
+        return nullptr;
+    }
+
+    std::lock_guard lock(m_Mutex);
+    m_Textures[key] = texture;
+    PruneTextures();
+    return texture;
+}
+
+std::shared_ptr<Texture> TextureManager::GetTexture(const uchar* data, int length)
+{
+    uint64 key = Hash(data, length);
+    {
+        std::lock_guard lock(m_Mutex);
+        auto entry = m_Textures.find(key);
+        if (entry != m_Textures.end())
+        {
+            if (auto texture = entry->second.lock())
+            {
+                return texture;
+            }
+        }
+    }
+
+    std::shared_ptr<Texture> texture = Texture::Create();
+    if (!texture->Init(data, length))
+    {
+        return nullptr;
+    }
+
+    std::lock_guard lock(m_Mutex);
+    m_Textures[key] = texture;
+    PruneTextures();
+    return texture;
+}
@@ -0,0 +1,155 @@
+/* Engine Copyright (c) 2021 Engine Development Team 
+   https://github.com/beaumanvienna/gfxRenderEngine
+
+   Permission is hereby granted, free of charge, to any person
+   obtaining a copy of this software and associated documentation files
+   (the "Software"), to deal in the Software without restriction,
+   including without limitation the rights to use, copy, modify, merge,
+   publish, distribute, sublicense, and/or sell copies of the Software,
+   and to permit persons to whom the Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be
+   included in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+   MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+   CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, 
+   TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE 
+   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
+
+#pragma once
+
+#include <list>
+#include <mutex>
+#include <deque>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <condition_variable>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "engine.h"
+#include "texture.h"
+
+// Decodes image files on worker threads and uploads them to their textures
+// on the render thread. Decoded images are cached by file name or by
+// content hash, so recreating a texture skips the decode. A texture reports
+// its final size right away and shows a transparent placeholder until its
+// upload. If the decode fails, the placeholder stays and LoadFailed() says so.
+class TextureManager
+{
+
+public:
+
+    struct Statistics
+    {
+        uint m_Decodes = 0;
+        uint m_Failures = 0;
+        uint m_CacheHits = 0;
+        uint m_Uploads = 0;
+        size_t m_UploadedBytes = 0;
+    };
+
+public:
+
+    TextureManager();
+    ~TextureManager();
+
+    // read the image size and queue the decode, returns false if the image header can't be read
+    bool Load(Texture* texture, const std::string& fileName, int& width, int& height);
+    bool Load(Texture* texture, const uchar* data, int length, int& width, int& height);
+    // to be called when a texture is destroyed before its upload
+    void Cancel(Texture* texture);
+    // the image of a texture that was accepted by Load() could not be decoded
+    bool LoadFailed(const Texture* texture);
+
+    // returns a texture that is still in use for the same image, or creates one
+    std::shared_ptr<Texture> GetTexture(const std::string& fileName);
+    std::shared_ptr<Texture> GetTexture(const uchar* data, int length);
+
+    // render thread: upload decoded images within the per-frame byte budget
+    void OnUpdate();
+    // render thread: wait for all decodes and upload everything
+    void Flush();
+    void ClearCache();
+
+    Statistics GetStatistics();
+
+private:
+
+    struct Image
+    {
+        ~Image();
+
+        int m_Width = 0;
+        int m_Height = 0;
+        // RGBA, allocated by stb_image
+        uchar* m_Pixels = nullptr;
+    };
+
+    struct CacheEntry
+    {
+        std::shared_ptr<Image> m_Image;
+        std::list<uint64>::iterator m_LRU;
+    };
+
+    struct DecodeJob
+    {
+        uint64 m_Key;
+        std::string m_FileName;
+        std::vector<uchar> m_Data;
+    };
+
+    struct PendingUpload
+    {
+        Texture* m_Texture;
+        uint64 m_Key;
+        std::shared_ptr<Image> m_Image;
+    };
+
+private:
+
+    static uint64 Hash(const void* data, size_t length, uint64 hash = 0xcbf29ce484222325);
+    static uint64 GetKey(const std::string& fileName);
+
+    bool Queue(Texture* texture, uint64 key, const std::string& fileName, const uchar* data, int length);
+    void Worker();
+    void Decode(DecodeJob& job, Image& image);
+    void Upload(PendingUpload& upload);
+    void Upload(std::vector<PendingUpload>& uploads);
+    void TrimCache();
+    void PruneTextures();
+
+private:
+
+    static constexpr size_t CACHE_BUDGET  = 128 * 1024 * 1024;
+    static constexpr size_t UPLOAD_BUDGET = 8 * 1024 * 1024;
+    static constexpr size_t MIN_TEXTURES_PRUNE_SIZE = 64;
+
+    std::mutex m_Mutex;
+    std::condition_variable m_WorkerWakeup;
+    std::condition_variable m_DecodeDone;
+    std::vector<std::thread> m_Workers;
+    bool m_WorkersRun;
+
+    std::deque<DecodeJob> m_DecodeJobs;
+    // keys being decoded, so that a second request waits for the first decode
+    std::unordered_set<uint64> m_Decoding;
+    std::vector<PendingUpload> m_PendingUploads;
+
+    std::unordered_map<uint64, CacheEntry> m_Cache;
+    std::list<uint64> m_LRUList;
+    size_t m_CacheSize;
+
+    std::unordered_map<uint64, std::weak_ptr<Texture>> m_Textures;
+    // expired entries are removed when the map reaches this size
+    size_t m_TexturesPruneSize;
+    std::unordered_set<const Texture*> m_Failed;
+
+    Statistics m_Statistics;
+
+};
@@ -23,6 +23,7 @@
 #include "rendererAPI.h"
 #include "textureSlotManager.h"
 #include "GLtextureSlotManager.h"
+#include "SWtextureSlotManager.h"
 
 std::unique_ptr<TextureSlotManager> TextureSlotManager::Create()
 {
@@ -33,6 +34,9 @@ std::unique_ptr<TextureSlotManager> TextureSlotManager::Create()
         case RendererAPI::OPENGL:
             textureSlotManager = std::make_unique<GLTextureSlotManager>();
             break;
+        case RendererAPI::SOFTWARE:
+            textureSlotManager = std::make_unique<SWTextureSlotManager>();
+            break;
         default:
             textureSlotManager = nullptr;
             break;
@@ -25,15 +25,43 @@
 
 #include "engine.h"
 
+// Every texture gets a virtual texture slot for its lifetime. Virtual slots
+// are bound to the (few) hardware texture units only when a texture is used,
+// the least recently used unit is evicted when all units are taken.
 class TextureSlotManager
 {
 
+public:
+
+    // number of samplers in u_Textures[] (fragmentShader.frag)
+    static constexpr uint MAX_TEXTURE_UNITS = 32;
+
+    struct Statistics
+    {
+        uint m_Binds = 0;
+        uint m_Evictions = 0;
+    };
+
 public:
 
     virtual ~TextureSlotManager() {}
 
     virtual uint GetTextureSlot() = 0;
     virtual void RemoveTextureSlot(uint slot) = 0;
+    virtual uint GetNumberOfTextureSlots() const = 0;
+
+    // binds a texture to a texture unit and makes the unit active
+    virtual uint BindTexture(uint slot, uint rendererID) = 0;
+    // binds a texture to a texture unit that stays reserved until UnpinAll(),
+    // returns -1 if no more texture units can be reserved
+    virtual int  PinTexture(uint slot, uint rendererID) = 0;
+    virtual void UnpinAll() = 0;
+    virtual void UnbindTexture(uint slot) = 0;
+    // to be called after code outside of the engine changed texture bindings
+    virtual void RestoreBindings() = 0;
+
+    virtual void EndFrame() = 0;
+    virtual const Statistics& GetStatistics() const = 0;
 
     static std::unique_ptr<TextureSlotManager> Create();
 
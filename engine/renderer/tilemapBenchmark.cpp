@@ -0,0 +1,140 @@
+/* Engine Copyright (c) 2021 Engine Development Team 
+   https://github.com/beaumanvienna/gfxRenderEngine
+
+   Permission is hereby granted, free of charge, to any person
+   obtaining a copy of this software and associated documentation files
+   (the "Software"), to deal in the Software without restriction,
+   including without limitation the rights to use, copy, modify, merge,
+   publish, distribute, sublicense, and/or sell copies of the Software,
+   and to permit persons to whom the Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be
+   included in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+   MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+   CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, 
+   TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE 
+   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
+
+#include <chrono>
+#include <vector>
+#include <algorithm>
+
+#include "tilemapBenchmark.h"
+#include "benchmarkScene.h"
+#include "renderCommand.h"
+#include "texture.h"
+#include "orthographicCamera.h"
+#include "spritesheet.h"
+#include "mapIndex.h"
+#include "tilemap.h"
+#include "matrix.h"
+
+TilemapBenchmark::TilemapBenchmark(uint frames)
+    : m_Frames(frames)
+{
+    m_Frames = std::max(m_Frames, 1u);
+}
+
+void TilemapBenchmark::Run()
+{
+    static constexpr uint TILE_SIZE = 32;
+    static constexpr uint TILE_VARIANTS = 4;
+    static constexpr float SCROLL_SPEED = 8.0f; // pixels per frame
+
+    BenchmarkScene scene("TilemapBenchmark");
+    if (!scene.IsOK())
+    {
+        return;
+    }
+    std::shared_ptr<Renderer>& renderer = scene.GetRenderer();
+    std::shared_ptr<OrthographicCamera> camera = std::make_shared<OrthographicCamera>(-960.0f, 960.0f, -540.0f, 540.0f, 1.0f, -1.0f);
+
+    // a row of tile variants
+    std::vector<uint> pixels(TILE_SIZE * TILE_VARIANTS * TILE_SIZE, 0xffffffff);
+    std::shared_ptr<Texture> texture = Texture::Create();
+    texture->Init(TILE_SIZE * TILE_VARIANTS, TILE_SIZE, pixels.data());
+    Sprite tiles(0.0f, 1.0f, 1.0f, 0.0f, TILE_SIZE * TILE_VARIANTS, TILE_SIZE, texture, "tiles");
+    SpriteSheet spritesheet;
+    spritesheet.AddSpritesheetRow(&tiles, TILE_VARIANTS);
+
+    LOG_CORE_INFO("TilemapBenchmark: {0}x{0} pixel tiles, {1} frames", TILE_SIZE, m_Frames);
+    for (uint mapSize = 64; mapSize <= 4096; mapSize *= 4)
+    {
+        MapIndex mapIndex;
+        mapIndex.Create(&spritesheet);
+        mapIndex.CreateEmptyMap(mapSize, mapSize);
+        for (uint row = 0; row < mapSize; row++)
+        {
+            for (uint column = 0; column < mapSize; column++)
+            {
+                mapIndex.SetTileIndex(column, row, (column * 7 + row * 3) % TILE_VARIANTS);
+            }
+        }
+
+        // the top left tile starts in the top left corner of the view
+        glm::vec2 origin(-960.0f + TILE_SIZE / 2, 540.0f - TILE_SIZE / 2);
+        float mapWidth = static_cast<float>(mapSize * TILE_SIZE);
+        auto scroll = [&](uint frame)
+        {
+            float x = fmodf(frame * SCROLL_SPEED, std::max(mapWidth - 1920.0f, 1.0f));
+            camera->SetPosition({x, -x, 0.0f});
+        };
+
+        // every tile, every frame; the big maps only get a few frames
+        uint64 tiles = static_cast<uint64>(mapSize) * mapSize;
+        uint perTileFrames = std::max(1u, static_cast<uint>(m_Frames * 4096ull / tiles));
+        perTileFrames = std::min(perTileFrames, m_Frames);
+        auto start = std::chrono::steady_clock::now();
+        for (uint frame = 0; frame < perTileFrames; frame++)
+        {
+            scroll(frame);
+            scene.BeginScene(camera);
+            mapIndex.BeginScene();
+            for (uint row = 0; row < mapIndex.GetRows(); row++)
+            {
+                for (uint column = 0; column < mapIndex.GetColumns(); column++)
+                {
+                    Sprite* sprite = mapIndex.GetSprite();
+                    if (sprite)
+                    {
+                        glm::vec3 translation{origin.x + column * sprite->GetWidth(), origin.y - row * sprite->GetHeight(), 0.0f};
+                        glm::mat4 position = Translate(translation) * sprite->GetScaleMatrix();
+                        renderer->Draw(sprite, position);
+                    }
+                }
+            }
+            scene.EndScene();
+        }
+        RenderCommand::Finish();
+        auto end = std::chrono::steady_clock::now();
+        std::chrono::duration<double, std::milli> perTileMilliseconds = end - start;
+
+        Tilemap tilemap;
+        tilemap.Create(&mapIndex, &spritesheet, origin);
+        uint64 quads = 0, builtChunks = 0;
+        start = std::chrono::steady_clock::now();
+        for (uint frame = 0; frame < m_Frames; frame++)
+        {
+            scroll(frame);
+            scene.BeginScene(camera);
+            tilemap.Draw(renderer);
+            scene.EndScene();
+            quads += tilemap.GetStatistics().m_Quads;
+            builtChunks += tilemap.GetStatistics().m_BuiltChunks;
+        }
+        RenderCommand::Finish();
+        end = std::chrono::steady_clock::now();
+        std::chrono::duration<double, std::milli> tilemapMilliseconds = end - start;
+
+        double perTile = perTileMilliseconds.count() / perTileFrames;
+        double chunked = tilemapMilliseconds.count() / m_Frames;
+        LOG_CORE_INFO("TilemapBenchmark: {0}x{0} tiles: per tile {1:.3f} ms/frame, tilemap {2:.3f} ms/frame ({3} quads, {4:.2f} chunk builds per frame, {5} chunks resident), speed-up {6:.1f}x",
+                      mapSize, perTile, chunked, quads / m_Frames, static_cast<double>(builtChunks) / m_Frames,
+                      tilemap.GetResidentChunks(), chunked > 0.0 ? perTile / chunked : 0.0);
+    }
+}
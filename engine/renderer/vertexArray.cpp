@@ -23,6 +23,7 @@
 #include "vertexArray.h"
 #include "rendererAPI.h"
 #include "GLvertexArray.h"
+#include "SWvertexArray.h"
 
 std::shared_ptr<VertexArray> VertexArray::Create()
 {
@@ -33,6 +34,9 @@ std::shared_ptr<VertexArray> VertexArray::Create()
         case RendererAPI::OPENGL:
             vertexArray = std::make_shared<GLVertexArray>();
             break;
+        case RendererAPI::SOFTWARE:
+            vertexArray = std::make_shared<SWVertexArray>();
+            break;
         default:
             vertexArray = nullptr;
             break;
@@ -0,0 +1,39 @@
+#version 330 core
+
+// one sprite per instance, see spriteInstances.h
+layout (location = 0)  in float a_TransformA;
+layout (location = 1)  in float a_TransformB;
+layout (location = 2)  in float a_TransformC;
+layout (location = 3)  in float a_TransformD;
+layout (location = 4)  in float a_TranslationX;
+layout (location = 5)  in float a_TranslationY;
+layout (location = 6)  in float a_TextureU1;
+layout (location = 7)  in float a_TextureV1;
+layout (location = 8)  in float a_TextureU2;
+layout (location = 9)  in float a_TextureV2;
+layout (location = 10) in float a_Depth;
+layout (location = 11) in vec4  a_Color;
+layout (location = 12) in int   a_TextureIndex;
+
+out vec2  v_TextureCoordinate;
+flat out int v_TextureIndex;
+out vec4  v_Color;
+
+uniform mat4 u_ViewProjectionMatrix;
+uniform int u_TextureUnits[8];
+
+void main()
+{
+    // triangle strip over the corners (-1, 1), (1, 1), (-1, -1), (1, -1)
+    bool right = (gl_VertexID & 1) != 0;
+    bool top   = gl_VertexID < 2;
+    vec2 corner = vec2(right ? 1.0 : -1.0, top ? 1.0 : -1.0);
+
+    vec2 position = vec2(a_TransformA, a_TransformB) * corner.x + vec2(a_TransformC, a_TransformD) * corner.y +
+                    vec2(a_TranslationX, a_TranslationY);
+    gl_Position = u_ViewProjectionMatrix * vec4(position, a_Depth, 1.0);
+
+    v_TextureCoordinate = vec2(right ? a_TextureU2 : a_TextureU1, top ? a_TextureV1 : a_TextureV2);
+    v_TextureIndex = u_TextureUnits[a_TextureIndex];
+    v_Color = a_Color;
+}
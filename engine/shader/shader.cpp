@@ -24,6 +24,7 @@
 
 #include "shader.h"
 #include "GLshader.h"
+#include "SWshader.h"
 #include "rendererAPI.h"
 
 std::shared_ptr<ShaderProgram> ShaderProgram::Create()
@@ -35,6 +36,9 @@ std::shared_ptr<ShaderProgram> ShaderProgram::Create()
         case RendererAPI::OPENGL:
             m_ShaderProgram = std::make_unique<GLShaderProgram>();
             break;
+        case RendererAPI::SOFTWARE:
+            m_ShaderProgram = std::make_unique<SWShaderProgram>();
+            break;
         default:
             m_ShaderProgram = nullptr;
             break;
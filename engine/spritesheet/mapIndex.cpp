@@ -118,6 +118,15 @@ void MapIndex::AddMap(const char* map)
     }
 }
 
+void MapIndex::CreateEmptyMap(uint columns, uint rows)
+{
+    m_Columns = columns;
+    m_Rows = rows;
+    m_CharMapSize = m_Rows * m_Columns;
+    m_CharMap.assign(m_CharMapSize, ASCII_SPACE);
+    m_IndexMap.assign(m_CharMapSize, EMPTY);
+}
+
 void MapIndex::SetIndexMap(const uint charMapStartIndex, const char id)
 {
     std::shared_ptr<TileGroup> tileGroup = m_TileGroupMap[id];
@@ -32,6 +32,10 @@
 class MapIndex
 {
 
+public:
+
+    static constexpr int EMPTY = -1;
+
 public:
 
     MapIndex();
@@ -43,6 +47,11 @@ public:
     void AddMap(const char* map);
     uint GetRows() const { return m_Rows; }
     uint GetColumns() const { return m_Columns; }
+
+    // random access to the sprite sheet indices of the tiles, EMPTY for no tile
+    void CreateEmptyMap(uint columns, uint rows);
+    int GetTileIndex(uint column, uint row) const { return m_IndexMap[column + row * m_Columns]; }
+    void SetTileIndex(uint column, uint row, int spritesheetIndex) { m_IndexMap[column + row * m_Columns] = spritesheetIndex; }
     
 private:
     
@@ -95,7 +104,6 @@ private:
 private:
 
     static constexpr uint ASCII_SPACE = ' ';
-    static constexpr int EMPTY = -1;
 
     SpriteSheet* m_Spritesheet;
     uint m_Index, m_CharMapSize;
@@ -0,0 +1,221 @@
+/* Engine Copyright (c) 2021 Engine Development Team 
+   https://github.com/beaumanvienna/gfxRenderEngine
+
+   Permission is hereby granted, free of charge, to any person
+   obtaining a copy of this software and associated documentation files
+   (the "Software"), to deal in the Software without restriction,
+   including without limitation the rights to use, copy, modify, merge,
+   publish, distribute, sublicense, and/or sell copies of the Software,
+   and to permit persons to whom the Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be
+   included in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+   MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+   CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, 
+   TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE 
+   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
+
+#include <algorithm>
+#include <cmath>
+
+#include "tilemap.h"
+
+Tilemap::Tilemap()
+    : m_MapIndex(nullptr), m_Spritesheet(nullptr),
+      m_Origin(0.0f), m_Depth(0.0f), m_Color(1.0f),
+      m_TileWidth(0.0f), m_TileHeight(0.0f),
+      m_ChunkColumns(0), m_ChunkRows(0), m_Frame(0)
+{
+}
+
+bool Tilemap::Create(MapIndex* mapIndex, SpriteSheet* spritesheet, const glm::vec2& origin, const float depth, const glm::vec4& color)
+{
+    if (!mapIndex || !spritesheet || !spritesheet->GetNumberOfSprites())
+    {
+        LOG_CORE_ERROR("bool Tilemap::Create(...): map index or sprite sheet not initialized");
+        return false;
+    }
+
+    m_MapIndex    = mapIndex;
+    m_Spritesheet = spritesheet;
+    m_Origin      = origin;
+    m_Depth       = depth;
+    m_Color       = color;
+
+    Sprite* sprite = m_Spritesheet->GetSprite(0);
+    m_TileWidth  = sprite->GetWidth();
+    m_TileHeight = sprite->GetHeight();
+
+    m_ChunkColumns = (m_MapIndex->GetColumns() + CHUNK_SIZE - 1) / CHUNK_SIZE;
+    m_ChunkRows    = (m_MapIndex->GetRows()    + CHUNK_SIZE - 1) / CHUNK_SIZE;
+    m_Chunks.clear();
+    m_Chunks.resize(m_ChunkColumns * m_ChunkRows);
+    m_ResidentChunks.clear();
+
+    return true;
+}
+
+void Tilemap::SetTile(uint column, uint row, int spritesheetIndex)
+{
+    if ((column >= m_MapIndex->GetColumns()) || (row >= m_MapIndex->GetRows()))
+    {
+        LOG_CORE_ERROR("void Tilemap::SetTile(...): tile {0}, {1} is outside of the map", column, row);
+        return;
+    }
+
+    if (m_MapIndex->GetTileIndex(column, row) != spritesheetIndex)
+    {
+        m_MapIndex->SetTileIndex(column, row, spritesheetIndex);
+        m_Chunks[column / CHUNK_SIZE + (row / CHUNK_SIZE) * m_ChunkColumns].m_Dirty = true;
+    }
+}
+
+void Tilemap::BuildChunk(uint chunkColumn, uint chunkRow)
+{
+    Chunk& chunk = m_Chunks[chunkColumn + chunkRow * m_ChunkColumns];
+    chunk.m_Verticies.clear();
+    chunk.m_Quads = 0;
+
+    uint firstColumn = chunkColumn * CHUNK_SIZE;
+    uint firstRow    = chunkRow    * CHUNK_SIZE;
+    uint lastColumn  = std::min(firstColumn + CHUNK_SIZE, m_MapIndex->GetColumns());
+    uint lastRow     = std::min(firstRow    + CHUNK_SIZE, m_MapIndex->GetRows());
+    for (uint row = firstRow; row < lastRow; row++)
+    {
+        for (uint column = firstColumn; column < lastColumn; column++)
+        {
+            int spritesheetIndex = m_MapIndex->GetTileIndex(column, row);
+            if (spritesheetIndex == MapIndex::EMPTY)
+            {
+                continue;
+            }
+
+            Sprite* sprite = m_Spritesheet->GetSprite(spritesheetIndex);
+            const glm::mat4& scaleMatrix = sprite->GetScaleMatrix();
+            float translationX = m_Origin.x + static_cast<float>(column) * m_TileWidth;
+            float translationY = m_Origin.y - static_cast<float>(row) * m_TileHeight;
+            float textureCoordinates[4][2] =
+            {
+                {sprite->m_Pos1X, sprite->m_Pos1Y},
+                {sprite->m_Pos2X, sprite->m_Pos1Y},
+                {sprite->m_Pos2X, sprite->m_Pos2Y},
+                {sprite->m_Pos1X, sprite->m_Pos2Y}
+            };
+
+            // the texture slot is filled in by Renderer::DrawQuads()
+            float textureSlot = -1.0f;
+            for (uint vertex = 0; vertex < 4; vertex++)
+            {
+                float verticies[Renderer::FLOATS_PER_VERTEX] =
+                {
+                    translationX + scaleMatrix[vertex][0], translationY + scaleMatrix[vertex][1], m_Depth,
+                    textureCoordinates[vertex][0], textureCoordinates[vertex][1], textureSlot,
+                    m_Color.r, m_Color.g, m_Color.b, m_Color.a
+                };
+                chunk.m_Verticies.insert(chunk.m_Verticies.end(), verticies, verticies + Renderer::FLOATS_PER_VERTEX);
+            }
+            chunk.m_Quads++;
+        }
+    }
+
+    chunk.m_Dirty = false;
+    if (!chunk.m_Resident)
+    {
+        chunk.m_Resident = true;
+        m_ResidentChunks.push_back(chunkColumn + chunkRow * m_ChunkColumns);
+    }
+    m_Statistics.m_BuiltChunks++;
+}
+
+void Tilemap::Draw(const std::shared_ptr<Renderer>& renderer)
+{
+    m_Statistics = Statistics();
+    if (!m_MapIndex || m_Chunks.empty())
+    {
+        return;
+    }
+    m_Frame++;
+
+    // the view of the camera in world coordinates
+    glm::mat4 inverseViewProjection = glm::inverse(renderer->GetViewProjectionMatrix());
+    float minX = INFINITY, maxX = -INFINITY, minY = INFINITY, maxY = -INFINITY;
+    const glm::vec2 corners[4] = {{-1.0f, -1.0f}, {1.0f, -1.0f}, {1.0f, 1.0f}, {-1.0f, 1.0f}};
+    for (auto& corner : corners)
+    {
+        glm::vec4 world = inverseViewProjection * glm::vec4(corner.x, corner.y, 0.0f, 1.0f);
+        minX = std::min(minX, world.x / world.w);
+        maxX = std::max(maxX, world.x / world.w);
+        minY = std::min(minY, world.y / world.w);
+        maxY = std::max(maxY, world.y / world.w);
+    }
+
+    // tiles reaching into the view, then the chunks they are in
+    float left = m_Origin.x - m_TileWidth  * 0.5f;
+    float top  = m_Origin.y + m_TileHeight * 0.5f;
+    int firstColumn = static_cast<int>(floorf((minX - left) / m_TileWidth));
+    int lastColumn  = static_cast<int>(floorf((maxX - left) / m_TileWidth));
+    int firstRow    = static_cast<int>(floorf((top - maxY) / m_TileHeight));
+    int lastRow     = static_cast<int>(floorf((top - minY) / m_TileHeight));
+
+    int columns = static_cast<int>(m_MapIndex->GetColumns());
+    int rows    = static_cast<int>(m_MapIndex->GetRows());
+    if ((lastColumn >= 0) && (firstColumn < columns) && (lastRow >= 0) && (firstRow < rows))
+    {
+        uint firstChunkColumn = std::max(firstColumn, 0) / CHUNK_SIZE;
+        uint lastChunkColumn  = std::min(lastColumn, columns - 1) / CHUNK_SIZE;
+        uint firstChunkRow    = std::max(firstRow, 0) / CHUNK_SIZE;
+        uint lastChunkRow     = std::min(lastRow, rows - 1) / CHUNK_SIZE;
+
+        std::shared_ptr<Texture> texture = m_Spritesheet->GetTexture();
+        for (uint chunkRow = firstChunkRow; chunkRow <= lastChunkRow; chunkRow++)
+        {
+            for (uint chunkColumn = firstChunkColumn; chunkColumn <= lastChunkColumn; chunkColumn++)
+            {
+                Chunk& chunk = m_Chunks[chunkColumn + chunkRow * m_ChunkColumns];
+                if (chunk.m_Dirty)
+                {
+                    BuildChunk(chunkColumn, chunkRow);
+                }
+                chunk.m_LastDrawnFrame = m_Frame;
+                if (chunk.m_Quads)
+                {
+                    renderer->DrawQuads(texture, chunk.m_Verticies.data(), chunk.m_Quads);
+                    m_Statistics.m_DrawnChunks++;
+                    m_Statistics.m_Quads += chunk.m_Quads;
+                }
+            }
+        }
+    }
+
+    if ((m_Frame % CHUNK_MAX_AGE) == 0)
+    {
+        EvictChunks();
+    }
+}
+
+void Tilemap::EvictChunks()
+{
+    for (uint index = 0; index < m_ResidentChunks.size(); )
+    {
+        Chunk& chunk = m_Chunks[m_ResidentChunks[index]];
+        if ((m_Frame - chunk.m_LastDrawnFrame) > CHUNK_MAX_AGE)
+        {
+            chunk.m_Verticies.clear();
+            chunk.m_Verticies.shrink_to_fit();
+            chunk.m_Quads = 0;
+            chunk.m_Dirty = true;
+            chunk.m_Resident = false;
+            m_ResidentChunks[index] = m_ResidentChunks.back();
+            m_ResidentChunks.pop_back();
+        }
+        else
+        {
+            index++;
+        }
+    }
+}
@@ -0,0 +1,102 @@
+/* Engine Copyright (c) 2021 Engine Development Team 
+   https://github.com/beaumanvienna/gfxRenderEngine
+
+   Permission is hereby granted, free of charge, to any person
+   obtaining a copy of this software and associated documentation files
+   (the "Software"), to deal in the Software without restriction,
+   including without limitation the rights to use, copy, modify, merge,
+   publish, distribute, sublicense, and/or sell copies of the Software,
+   and to permit persons to whom the Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be
+   included in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+   MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+   CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, 
+   TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE 
+   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "engine.h"
+#include "spritesheet.h"
+#include "mapIndex.h"
+#include "renderer.h"
+#include "glm.hpp"
+
+// Draws the tiles of a map index. Their verticies are built once per chunk of CHUNK_SIZE x CHUNK_SIZE
+// tiles and handed to the renderer as a block, instead of a transformation per tile and frame.
+// Only chunks in the view of the renderer's camera are built and drawn, a chunk is rebuilt when one
+// of its tiles is changed with SetTile(), and chunks that were out of view for CHUNK_MAX_AGE frames
+// drop their verticies, so maps can be much larger than the screen.
+// All tiles of the sprite sheet must have the same size.
+// Tiles are not clipped, Renderer::SetClipRect() is ignored.
+class Tilemap
+{
+
+public:
+
+    static constexpr uint CHUNK_SIZE = 32;
+
+    struct Statistics
+    {
+        uint m_DrawnChunks = 0;
+        uint m_BuiltChunks = 0;
+        uint m_Quads = 0;
+    };
+
+public:
+
+    Tilemap();
+
+    // origin: center of the tile in column 0, row 0; rows go down
+    bool Create(MapIndex* mapIndex, SpriteSheet* spritesheet, const glm::vec2& origin,
+                const float depth = 0.0f, const glm::vec4& color = glm::vec4(1.0f));
+    void SetTile(uint column, uint row, int spritesheetIndex);
+    void Draw(const std::shared_ptr<Renderer>& renderer);
+
+    const Statistics& GetStatistics() const { return m_Statistics; }
+    uint GetResidentChunks() const { return m_ResidentChunks.size(); }
+
+private:
+
+    struct Chunk
+    {
+        std::vector<float> m_Verticies;
+        uint m_Quads = 0;
+        uint m_LastDrawnFrame = 0;
+        bool m_Dirty = true;
+        bool m_Resident = false;
+    };
+
+private:
+
+    void BuildChunk(uint chunkColumn, uint chunkRow);
+    void EvictChunks();
+
+private:
+
+    static constexpr uint CHUNK_MAX_AGE = 120;
+
+    MapIndex* m_MapIndex;
+    SpriteSheet* m_Spritesheet;
+    glm::vec2 m_Origin;
+    float m_Depth;
+    glm::vec4 m_Color;
+    float m_TileWidth, m_TileHeight;
+
+    uint m_ChunkColumns, m_ChunkRows;
+    std::vector<Chunk> m_Chunks;
+    std::vector<uint> m_ResidentChunks;
+    uint m_Frame;
+
+    Statistics m_Statistics;
+
+};
@@ -46,6 +46,7 @@ project "engine"
         "engine/log",
         "engine/platform/",
         "engine/platform/OpenGL",
+        "engine/platform/software",
         "engine/platform/SDL",
         "engine/renderer",
         "engine/animation",
@@ -21,6 +21,7 @@
    SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
 
 #include "resources.h"
+#include "core.h"
 
 #ifndef _MSC_VER
 
@@ -60,9 +61,12 @@
             
             if (dataPtr != nullptr && fileSize)
             {
-                texture = Texture::Create();
-                texture->Init((const unsigned char*)dataPtr, fileSize);
-                texture->Bind();
+                // shared with other users of the same image
+                texture = Engine::m_TextureManager->GetTexture((const uchar*)dataPtr, fileSize);
+                if (texture)
+                {
+                    texture->Bind();
+                }
             }
             else
             {
@@ -112,9 +116,12 @@
             
             if (dataPtr != nullptr && fileSize)
             {
-                texture = Texture::Create();
-                texture->Init((const unsigned char*)dataPtr, fileSize);
-                texture->Bind();
+                // shared with other users of the same image
+                texture = Engine::m_TextureManager->GetTexture((const uchar*)dataPtr, fileSize);
+                if (texture)
+                {
+                    texture->Bind();
+                }
             }
             else
             {
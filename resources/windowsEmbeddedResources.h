@@ -14,11 +14,12 @@
 #define IDR_FRAGMENT_SHADER                 113
 #define IDR_SD_LCTRL_DB                     114
 #define IDR_WAVES                           115
+#define IDR_INSTANCED_VERTEX_SHADER         116
 
 // Next default values for new objects
 #ifdef APSTUDIO_INVOKED
     #ifndef APSTUDIO_READONLY_SYMBOLS
-        #define _APS_NEXT_RESOURCE_VALUE    116
+        #define _APS_NEXT_RESOURCE_VALUE    117
         #define _APS_NEXT_COMMAND_VALUE     40001
         #define _APS_NEXT_CONTROL_VALUE     1001
         #define _APS_NEXT_SYMED_VALUE       115